@@ -122,6 +122,10 @@ initialize_graph(jcfg_thd_t *thd, graph_info_t *gi)
         CNE_ERR_GOTO(err, "cne_graph_lookup(): graph '%s' not found\n", graph_name);
     this_stk->graph = gi->graph;
 
+    /* Route and ARP entries deleted by other threads are freed after a graph walk */
+    if (cne_graph_qsbr_add(gi->graph, this_cnet->qsbr, this_stk->idx) < 0)
+        CNE_ERR_GOTO(err, "cne_graph_qsbr_add(): graph '%s' failed\n", graph_name);
+
     free(gi->patterns);
 
     return 0;
@@ -318,7 +322,7 @@ thread_func(void *arg)
         char *s = chnl_array->arr[i]->str;
 
         if (!s || (s[0] == '\0'))
-            CNE_ERR_GOTO(err, "string is NULL or empty\n");
+            CNE_ERR_GOTO(leave, "string is NULL or empty\n");
 
         if (cinfo->flags & FWD_DEBUG_STATS)
             cne_printf("'[orange]%s[]'", s);
@@ -335,6 +339,10 @@ skip:
     while (likely(!thd->quit))
         cne_graph_walk(gi->graph);
 
+leave:
+    /* The graph is registered with the QSBR once initialized, remove it on every exit */
+    cne_graph_qsbr_del(gi->graph);
+
     return;
 err:
     if (pthread_barrier_wait(&cinfo->barrier))
@@ -117,6 +117,10 @@ initialize_graph(jcfg_thd_t *thd, graph_info_t *gi)
         CNE_ERR_GOTO(err, "cne_graph_lookup(): graph '%s' not found\n", graph_name);
     this_stk->graph = gi->graph;
 
+    /* Route and ARP entries deleted by other threads are freed after a graph walk */
+    if (cne_graph_qsbr_add(gi->graph, this_cnet->qsbr, this_stk->idx) < 0)
+        CNE_ERR_GOTO(err, "cne_graph_qsbr_add(): graph '%s' failed\n", graph_name);
+
     free(gi->patterns);
 
     return 0;
@@ -165,6 +169,8 @@ thread_func(void *arg)
     while (likely(!thd->quit))
         cne_graph_walk(gi->graph);
 
+    cne_graph_qsbr_del(gi->graph);
+
     return;
 err:
     (void)pthread_barrier_wait(&cinfo->barrier);
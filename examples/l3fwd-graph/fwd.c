@@ -121,9 +121,19 @@ add_graph_pattern(graph_info_t *gi, const char *pattern)
     return 0;
 }
 
+static const void *
+trace_data(void *obj, uint32_t *len, void *arg __cne_unused)
+{
+    pktmbuf_t *m = obj;
+
+    *len = pktmbuf_data_len(m);
+    return pktmbuf_mtod(m, const void *);
+}
+
 static int
 initialize_graph(jcfg_thd_t *thd, graph_info_t *gi)
 {
+    struct cne_graph_trace_param trace = {.sample = fwd->opts.trace, .data = trace_data};
     /* Rewrite data of src and dst ether addr */
     const char *patterns[] = {"ip4*", "pktdev_tx-*", "pkt_drop", NULL};
     jcfg_lport_t *lport;
@@ -150,6 +160,28 @@ initialize_graph(jcfg_thd_t *thd, graph_info_t *gi)
     if (!gi->graph)
         CNE_ERR_GOTO(err, "cne_graph_lookup(): graph '%s' not found\n", name);
 
+    if (fwd->opts.sample && cne_graph_stats_sample_set(gi->id, fwd->opts.sample) < 0)
+        CNE_ERR_GOTO(err, "Invalid stats sampling period %u, not a power of 2\n",
+                     fwd->opts.sample);
+
+    if (fwd->opts.trace && cne_graph_trace_enable(gi->id, &trace) < 0)
+        CNE_ERR_GOTO(err, "cne_graph_trace_enable(): graph '%s'\n", name);
+
+    /* The generic walk is kept for a topology with a loop */
+    if (fwd->opts.compile && cne_graph_compile(gi->id) < 0)
+        CNE_WARN("cne_graph_compile(): graph '%s' keeps the generic walk\n", name);
+
+    /* Streams of the nodes listed by a thread are processed by the graph of that thread */
+    if (fwd->dispatch) {
+        for (int i = 0; i < thd->node_cnt; i++)
+            if (cne_graph_dispatch_node_affinity_set(thd->node_names[i], thd->idx) < 0)
+                CNE_ERR_GOTO(err, "Unable to run node '%s' on thread '%s'\n", thd->node_names[i],
+                             thd->name);
+
+        if (cne_graph_dispatch_bind(gi->id, thd->idx) < 0)
+            CNE_ERR_GOTO(err, "cne_graph_dispatch_bind(): graph '%s' thread %u\n", name, thd->idx);
+    }
+
     return 0;
 err:
     cne_graph_destroy(gi->id);
@@ -43,9 +43,12 @@ enum {
     FWD_CLI_ENABLE  = (1 << 3), /**< Enable the CLI */
 };
 
-#define NO_METRICS_TAG "no-metrics" /**< json tag for no-metrics */
-#define NO_RESTAPI_TAG "no-restapi" /**< json tag for no-restapi */
-#define ENABLE_CLI_TAG "cli"        /**< json tag to enable/disable CLI */
+#define NO_METRICS_TAG   "no-metrics"   /**< json tag for no-metrics */
+#define NO_RESTAPI_TAG   "no-restapi"   /**< json tag for no-restapi */
+#define ENABLE_CLI_TAG   "cli"          /**< json tag to enable/disable CLI */
+#define STATS_SAMPLE_TAG "stats-sample" /**< json tag for the node cycles sampling period */
+#define TRACE_SAMPLE_TAG "trace-sample" /**< json tag for the packet trace sampling */
+#define COMPILE_TAG      "compile"      /**< json tag to compile the graph walk */
 
 struct fwd_port {
     int lport;                      /**< PKTDEV lport id */
@@ -60,6 +63,9 @@ struct app_options {
     bool no_metrics; /**< Enable metrics*/
     bool no_restapi; /**< Enable REST API*/
     bool cli;        /**< Enable Cli*/
+    uint32_t sample; /**< Sampling period of the node cycles */
+    uint32_t trace;  /**< Trace one packet out of trace, 0 to disable */
+    bool compile;    /**< Compile the walk of the graphs */
     unsigned int node_cnt;
     unsigned int node_sz;
     const char **nodes;
@@ -80,6 +86,7 @@ struct fwd_info {
     struct app_options opts;   /**< Application options*/
     pthread_barrier_t barrier; /**< Barrier for all threads */
     bool barrier_inited;
+    bool dispatch;             /**< Some graph nodes run on the thread set in the config */
     graph_info_t graph_info[16];
 };
 
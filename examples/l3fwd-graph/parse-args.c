@@ -56,6 +56,15 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
         } else if (!strcmp(obj.opt->name, ENABLE_CLI_TAG)) {
             if (obj.opt->val.type == BOOLEAN_OPT_TYPE)
                 f->opts.cli = obj.opt->val.boolean;
+        } else if (!strcmp(obj.opt->name, STATS_SAMPLE_TAG)) {
+            if (obj.opt->val.type == INTEGER_OPT_TYPE)
+                f->opts.sample = obj.opt->val.value;
+        } else if (!strcmp(obj.opt->name, TRACE_SAMPLE_TAG)) {
+            if (obj.opt->val.type == INTEGER_OPT_TYPE)
+                f->opts.trace = obj.opt->val.value;
+        } else if (!strcmp(obj.opt->name, COMPILE_TAG)) {
+            if (obj.opt->val.type == BOOLEAN_OPT_TYPE)
+                f->opts.compile = obj.opt->val.boolean;
         }
         break;
 
@@ -153,6 +162,8 @@ process_callback(jcfg_info_t *j __cne_unused, void *_obj, void *arg, int idx)
                 CNE_ERR_RET("Unable to create thread %d (%s) or type %s\n", idx, obj.thd->name,
                             obj.thd->thread_type);
         } else if (!strcasecmp("fwd", obj.thd->thread_type)) {
+            if (obj.thd->node_cnt)
+                f->dispatch = true;
             if (thread_create(obj.thd->name, thread_func, obj.thd) < 0)
                 CNE_ERR_RET("Unable to create thread %d (%s) or type %s\n", idx, obj.thd->name,
                             obj.thd->thread_type);
@@ -3,6 +3,7 @@
  */
 
 #include <stdio.h>             // for snprintf, fflush, NULL, stdout
+#include <fnmatch.h>           // for fnmatch
 #include <cne_common.h>        // for __cne_unused
 #include <cne_log.h>           // for CNE_ERR_RET, CNE_LOG_ERR
 #include <metrics.h>           // for metrics_append, metrics_register, metrics_cl...
@@ -60,6 +61,47 @@ fwd_stats(metrics_client_t *c, const char *cmd __cne_unused, const char *params
     return jcfg_lport_foreach(fwd->jinfo, handle_stats, c);
 }
 
+static int
+fwd_graph(metrics_client_t *c, const char *cmd __cne_unused, const char *params __cne_unused)
+{
+    struct cne_graph_cluster_stats_param s_param = {0};
+    struct cne_graph_cluster_stats *stats;
+    const char *pattern = "worker_*";
+    int ret;
+
+    s_param.graph_patterns    = &pattern;
+    s_param.nb_graph_patterns = 1;
+
+    /* The graphs are created by the worker threads, collect the ones running now */
+    stats = cne_graph_cluster_stats_create(&s_param);
+    if (!stats)
+        return -1;
+
+    ret = metrics_graph_stats(c, stats);
+    cne_graph_cluster_stats_destroy(stats);
+
+    return ret;
+}
+
+static int
+fwd_trace(metrics_client_t *c, const char *cmd __cne_unused, const char *params __cne_unused)
+{
+    int cnt = 0;
+
+    for (int i = 0; i < cne_graph_max_count(); i++) {
+        char *name = cne_graph_id_to_name(i);
+
+        if (!name || fnmatch("worker_*", name, 0))
+            continue;
+        if (cnt++)
+            metrics_append(c, ",");
+        if (metrics_graph_trace(c, i) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
 int
 enable_metrics(void)
 {
@@ -75,5 +117,11 @@ enable_metrics(void)
     if (metrics_register("/stats", fwd_stats) < 0)
         CNE_ERR_RET("Failed to register the metric stats\n");
 
+    if (metrics_register("/graph", fwd_graph) < 0)
+        CNE_ERR_RET("Failed to register the metric graph\n");
+
+    if (metrics_register("/trace", fwd_trace) < 0)
+        CNE_ERR_RET("Failed to register the metric trace\n");
+
     return 0;
 }
@@ -124,7 +124,9 @@ cnet_arp_delete(struct in_addr *addr)
             if (fib_info_free(fi, (uint32_t)idx) != entry)
                 CNE_WARN("Freed entry does not match\n");
 
-            cnet_arp_free(entry);
+            /* Graph threads could still be using the entry */
+            if (fib_info_defer_free(fi, entry) == 0)
+                cnet_arp_free(entry);
             return 0;
         }
     }
@@ -167,6 +169,12 @@ cnet_arp_show(void)
     return fib_info_foreach(this_cnet->arp_finfo, (fib_func_t)_arp_show, NULL);
 }
 
+static void
+arp_qsbr_free(void *obj)
+{
+    cnet_arp_free(obj);
+}
+
 int
 cnet_arp_create(struct cnet *cnet, uint32_t num_entries, uint32_t num_tbl8s)
 {
@@ -204,6 +212,9 @@ cnet_arp_create(struct cnet *cnet, uint32_t num_entries, uint32_t num_tbl8s)
 
     cnet->arp_finfo = fi;
 
+    if (cnet->qsbr && fib_info_qsbr_add(fi, cnet->qsbr, arp_qsbr_free, "arp-dq") < 0)
+        CNE_ERR_GOTO(err, "Unable to add QSBR to ARP FIB\n");
+
     cfg.objcnt    = num_entries;
     cfg.objsz     = sizeof(struct arp_entry);
     cfg.cache_sz  = 0;
@@ -26,6 +26,7 @@
 #include <pktmbuf_ptype.h>
 #include "chnl_priv.h"
 #include <cnet_chnl.h>        // for cnet_chnl_get
+#include <cnet_meta.h>        // for cnet_metadata
 #include <cnet_node_names.h>
 
 static inline void
@@ -39,6 +40,34 @@ __callback(struct pcb_entry *pcb)
     }
 }
 
+/*
+ * Add a packet to the channel receive buffer, or free it when pcb is NULL. TCP links the
+ * segments it delivers in order after this one with cnet_metadata.gro_next, a TCP mbuf
+ * without data only carries them.
+ */
+static inline void
+__append(struct pcb_entry *pcb, pktmbuf_t *mbuf)
+{
+    struct cnet_metadata *md;
+    struct chnl_buf *cb;
+    pktmbuf_t *next;
+
+    for (; mbuf; mbuf = next) {
+        md           = pktmbuf_metadata(mbuf);
+        next         = md->gro_next;
+        md->gro_next = NULL;
+
+        if (!pcb || (pcb->ip_proto == IPPROTO_TCP && pktmbuf_data_len(mbuf) == 0)) {
+            pktmbuf_free(mbuf);
+            continue;
+        }
+
+        cb = &pcb->ch->ch_rcv;
+        vec_add(cb->cb_vec, mbuf);
+        cb->cb_cc += pktmbuf_data_len(mbuf);
+    }
+}
+
 static uint16_t
 chnl_callback_node_process(struct cne_graph *graph __cne_unused, struct cne_node *node __cne_unused,
                            void **objs, uint16_t nb_objs)
@@ -46,7 +75,6 @@ chnl_callback_node_process(struct cne_graph *graph __cne_unused, struct cne_node
     pktmbuf_t *mbuf, **pkts;
     struct pcb_entry *pcb, *ppcb = NULL;
     uint16_t n_left_from;
-    struct chnl_buf *cb;
 
     pkts        = (pktmbuf_t **)objs;
     n_left_from = nb_objs;
@@ -69,7 +97,7 @@ chnl_callback_node_process(struct cne_graph *graph __cne_unused, struct cne_node
 
         pcb = mbuf->userptr;
         if (!pcb || !pcb->ch) {
-            pktmbuf_free(mbuf);
+            __append(NULL, mbuf);
             CNE_ERR("PCB or Chnl pointer is NULL\n");
             continue;
         }
@@ -80,9 +108,7 @@ chnl_callback_node_process(struct cne_graph *graph __cne_unused, struct cne_node
             ppcb = pcb;
         }
 
-        cb = &pcb->ch->ch_rcv;
-        vec_add(cb->cb_vec, mbuf);
-        cb->cb_cc += pktmbuf_data_len(mbuf);
+        __append(pcb, mbuf);
     }
 
     if (ppcb)
@@ -430,10 +430,13 @@ struct chnl *__chnl_create(int32_t dom, int32_t type, int32_t pro, struct pcb_en
  *   Caller message to be added to the output if invalid.
  * @param cb
  *   The chnl_buf structure pointer to validate.
+ * @param snd
+ *   True for a TCP send buffer, the unacked data of its mbufs is given by the
+ *   cnet_metadata snd_len and not the mbuf data length.
  * @return
  *   -1 on error or 0 on success
  */
-int chnl_validate_cb(const char *msg, struct chnl_buf *cb);
+int chnl_validate_cb(const char *msg, struct chnl_buf *cb, bool snd);
 
 /**
  * Dump out the channel structure list.
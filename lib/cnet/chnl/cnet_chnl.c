@@ -515,6 +515,14 @@ chnl_connect(int cd, struct sockaddr *sa, int namelen)
         }
 
         in_caddr_copy(&ch->ch_pcb->key.faddr, &faddr);
+        if (cnet_pcb_update(ch->ch_pcb) < 0) {
+            /* Stay bound to the local address and port */
+            in_caddr_zero(&ch->ch_pcb->key.faddr);
+            if (cnet_pcb_update(ch->ch_pcb) < 0)
+                CNE_ERR("Unable to rehash the bound PCB\n");
+            __errno_set(ENOBUFS);
+            CNE_ERR_GOTO(leave, "Unable to hash the PCB\n");
+        }
 
         if (psw && psw->funcs)
             rs = psw->funcs->connect_func(ch, name, namelen);
@@ -691,7 +699,7 @@ chnl_recv(int cd, pktmbuf_t **mbufs, size_t len)
 }
 
 static int
-sendit(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
+sendit(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs, uint16_t flags)
 {
     struct chnl *ch = ch_get(cd);
 
@@ -710,19 +718,22 @@ sendit(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
     if (nb_mbufs == 0)
         return 0;
 
-    if (sa) {
-        for (int i = 0; i < nb_mbufs; i++) {
-            struct cnet_metadata *md;
-            struct sockaddr_in *addr;
+    for (int i = 0; i < nb_mbufs; i++) {
+        struct cnet_metadata *md;
+
+        if (!mbufs[i])
+            CNE_ERR_RET_VAL(__errno_set(EFAULT), "pktmbuf entry is NULL\n");
+
+        md = pktmbuf_metadata(mbufs[i]);
+        if (!md)
+            CNE_ERR_RET_VAL(__errno_set(EFAULT), "pktmbuf metadata is NULL\n");
 
-            if (!mbufs[i])
-                CNE_ERR_RET_VAL(__errno_set(EFAULT), "pktmbuf entry is NULL\n");
+        /* Tell the protocol if the mbuf can be transmitted in place */
+        md->flags = flags;
 
-            md = pktmbuf_metadata(mbufs[i]);
-            if (!md)
-                CNE_ERR_RET_VAL(__errno_set(EFAULT), "pktmbuf metadata is NULL\n");
+        if (sa) {
+            struct sockaddr_in *addr = (struct sockaddr_in *)&sa[i];
 
-            addr = (struct sockaddr_in *)&sa[i];
             if (addr->sin_family == AF_INET) {
                 md->faddr.cin_family      = addr->sin_family;
                 md->faddr.cin_port        = addr->sin_port;
@@ -777,7 +788,13 @@ sendit(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
 int
 chnl_send(int cd, pktmbuf_t **mbufs, uint16_t nb_mbufs)
 {
-    return sendit(cd, NULL, mbufs, nb_mbufs);
+    return sendit(cd, NULL, mbufs, nb_mbufs, 0);
+}
+
+int
+chnl_send_zc(int cd, pktmbuf_t **mbufs, uint16_t nb_mbufs)
+{
+    return sendit(cd, NULL, mbufs, nb_mbufs, CNET_META_ZCOPY);
 }
 
 int
@@ -786,7 +803,7 @@ chnl_sendto(int cd, struct sockaddr *sa, pktmbuf_t **mbufs, uint16_t nb_mbufs)
     if (!sa)
         return __errno_set(EFAULT);
 
-    return sendit(cd, sa, mbufs, nb_mbufs);
+    return sendit(cd, sa, mbufs, nb_mbufs, 0);
 }
 
 /*
@@ -814,6 +831,8 @@ chnl_bind_common(struct chnl *ch, struct in_caddr *addr, int32_t len, struct pcb
     /* addr == NULL we return 0 */
     if (!addr) {
         in_caddr_zero(&ch->ch_pcb->key.laddr);
+        if (cnet_pcb_update(ch->ch_pcb) < 0)
+            return __errno_set(ENOBUFS);
         CNE_ERR_RET_VAL(0, "Address is NULL\n");
     }
 
@@ -889,7 +908,7 @@ chnl_bind_common(struct chnl *ch, struct in_caddr *addr, int32_t len, struct pcb
     /* Setup the local address */
     in_caddr_copy(&ch->ch_pcb->key.laddr, &laddr);
 
-    return 0;
+    return cnet_pcb_update(ch->ch_pcb);
 }
 
 /*
@@ -910,8 +929,9 @@ chnl_connect_common(struct chnl *ch, struct in_caddr *to, int32_t tolen __cne_un
 }
 
 int
-chnl_validate_cb(const char *msg, struct chnl_buf *cb)
+chnl_validate_cb(const char *msg, struct chnl_buf *cb, bool snd)
 {
+    struct cnet_metadata *md;
     pktmbuf_t *m;
     uint32_t tot = 0, num;
 
@@ -919,13 +939,18 @@ chnl_validate_cb(const char *msg, struct chnl_buf *cb)
     if (num == 0)
         return tot;
 
-    vec_foreach_ptr (m, cb->cb_vec)
-        tot += pktmbuf_data_len(m);
+    vec_foreach_ptr (m, cb->cb_vec) {
+        /* A segment sent in place changes the mbuf data length until it is transmitted */
+        if (snd) {
+            md = pktmbuf_metadata(m);
+            tot += md->snd_len;
+        } else
+            tot += pktmbuf_data_len(m);
+    }
 
     if (tot != cb->cb_cc) {
         cne_printf("   *** chnl_buf (%s) not valid\n", msg);
-        if (tot += cb->cb_cc)
-            cne_printf("       cb_cc %u != %u total\n", cb->cb_cc, tot);
+        cne_printf("       cb_cc %u != %u total\n", cb->cb_cc, tot);
         return -1;
     }
     return 0;
@@ -946,12 +971,12 @@ chnl_dump(const char *msg, struct chnl *ch)
                    "[cyan]%u[] cc [cyan]%d[]\n",
                    ch->ch_rcv.cb_hiwat, ch->ch_rcv.cb_lowat,
                    ch->ch_rcv.cb_vec ? vec_len(ch->ch_rcv.cb_vec) : 0, ch->ch_rcv.cb_cc);
-        chnl_validate_cb("RCV", &ch->ch_rcv);
+        chnl_validate_cb("RCV", &ch->ch_rcv, false);
         cne_printf("       SND buf hiwat [cyan]%d[] lowat [cyan]%d[] cnt "
                    "[cyan]%u[] cc [cyan]%d[]\n",
                    ch->ch_snd.cb_hiwat, ch->ch_snd.cb_lowat,
                    ch->ch_snd.cb_vec ? vec_len(ch->ch_snd.cb_vec) : 0, ch->ch_snd.cb_cc);
-        chnl_validate_cb("SND", &ch->ch_snd);
+        chnl_validate_cb("SND", &ch->ch_snd, true);
         cnet_pcb_show(ch->ch_pcb);
     }
 }
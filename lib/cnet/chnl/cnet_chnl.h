@@ -239,6 +239,27 @@ CNDP_API int chnl_recv(int cd, pktmbuf_t **mbufs, size_t len);
  */
 CNDP_API int chnl_send(int cd, pktmbuf_t **mbufs, uint16_t nb_mbufs);
 
+/**
+ * This routine transmits data to a previously connected chnl without copying it.
+ *
+ * The stack takes ownership of the mbufs and a TCP chnl transmits and retransmits the
+ * data in place, prepending the protocol headers in the mbuf headroom. The mbufs must be
+ * allocated from the lport the chnl sends on, i.e. with pktdev_buf_alloc(), and must not be
+ * touched or freed by the application after the call. When the headroom is too small for
+ * the headers the data is copied as done by chnl_send().
+ *
+ * @param cd
+ *   The channel descriptor index
+ * @param mbufs
+ *   List of pointer vectors
+ * @param nb_mbufs
+ *   Number of mbufs in the vector list.
+ *
+ * @returns
+ *   0 on success or -1 on failure, errno is set as done by chnl_send().
+ */
+CNDP_API int chnl_send_zc(int cd, pktmbuf_t **mbufs, uint16_t nb_mbufs);
+
 /**
  * @brief Send data to a channel similar to 'sendto()'
  *
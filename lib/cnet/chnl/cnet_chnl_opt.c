@@ -4,6 +4,7 @@
 
 #include <bsd/sys/time.h>
 #include <netinet/in.h>        // for IPPROTO_IP, IP_PKTINFO, IP_REC...
+#include <netinet/udp.h>       // for UDP_SEGMENT
 #include <cnet_stk.h>          // for stk_entry, per_thread_stk, this_stk
 #include <cnet_pcb.h>          // for pcb_entry
 #include "chnl_priv.h"
@@ -278,6 +279,13 @@ chnl_optval_get(const void *optval, uint32_t optlen)
  * is consequently discouraged.  This option only applies to UDP chnls.
  *
  *
+ * IPPROTO_UDP OPTIONS
+ *
+ * UDP_SEGMENT - UDP payload size of the sent datagrams ('int')
+ * This option sets the payload size of the datagrams sent on a UDP chnl. A
+ * larger buffer given to a send call is split into datagrams of this size
+ * when it is transmitted, zero disables the option.
+ *
  * IPPROTO_TCP OPTIONS
  *
  * TCP_NODELAY
@@ -392,6 +400,28 @@ chnl_set_opt(int cd, int level, int optname, const void *optval, int optlen)
 
             break;
 
+        case IPPROTO_UDP:
+            switch (optname) {
+            /* value options */
+            case UDP_SEGMENT:
+                if (ch->ch_pcb->ip_proto != IPPROTO_UDP) {
+                    rs = __errno_set(ENOPROTOOPT);
+                    break;
+                }
+                if (val > UINT16_MAX) {
+                    rs = __errno_set(EINVAL);
+                    break;
+                }
+                ch->ch_pcb->gso_size = (uint16_t)val;
+                break;
+
+            default:
+                CNE_ERR("Unknown optname %d\n", optname);
+                goto Unknown;
+            }
+
+            break;
+
         default:
             CNE_ERR("Unknown level %d\n", level);
             goto Unknown;
@@ -512,6 +542,12 @@ leave:
  * This option reports whether checksums will be calculated foroutgoing UDP
  * packets.  This option only applies to UDP chnls.
  *
+ * IPPROTO_UDP OPTIONS
+ *
+ * UDP_SEGMENT - UDP payload size of the sent datagrams ('int')
+ * This option reports the payload size of the datagrams sent on a UDP chnl,
+ * zero if the option is not set.
+ *
  * @return
  *   OK or ERROR.
  */
@@ -614,6 +650,19 @@ chnl_get_opt(int cd, int level, int optname, void *optval, socklen_t *optlen)
             }
 
             break;
+
+        case IPPROTO_UDP:
+            switch (optname) {
+            case UDP_SEGMENT:
+                resI = (int)ch->ch_pcb->gso_size;
+                break;
+
+            default:
+                goto Unknown;
+            }
+
+            break;
+
         default:
             goto Unknown;
         }
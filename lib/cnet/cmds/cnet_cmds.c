@@ -25,6 +25,7 @@
 #include <stdint.h>                // for uint16_t, uint64_t, uint8_t, int32_t
 #include <stdlib.h>                // for atoi
 #include <string.h>                // for strcmp, strerror
+#include <fnmatch.h>               // for fnmatch
 #include <cne_graph.h>             // for
 
 #include <cli.h>        // for c_cmd, cli_add_tree, cli_usage, c_alias
@@ -457,6 +458,82 @@ graph_dot_save(const char *gname)
     return 0;
 }
 
+static const void *
+graph_trace_data(void *obj, uint32_t *len, void *arg __cne_unused)
+{
+    pktmbuf_t *m = obj;
+
+    *len = pktmbuf_data_len(m);
+    return pktmbuf_mtod(m, const void *);
+}
+
+/* Apply a trace command to the graphs matching a pattern */
+static int
+graph_trace(int index, const char *pattern, const char *arg)
+{
+    struct cne_graph_trace_param prm = {0};
+    int rc, cnt = 0;
+
+    prm.sample = (index == 60) ? atoi(arg) : 0;
+    prm.data   = graph_trace_data;
+
+    for (int i = 0; i < cne_graph_max_count(); i++) {
+        char *name = cne_graph_id_to_name(i);
+
+        if (!name || fnmatch(pattern, name, 0))
+            continue;
+        cnt++;
+
+        switch (index) {
+        case 60:
+            if (cne_graph_trace_enable(i, &prm) < 0)
+                CNE_ERR_RET("[magenta]Failed to enable trace of graph [red]%s[]\n", name);
+            break;
+        case 61:
+            cne_graph_trace_disable(i);
+            break;
+        case 62:
+            cne_graph_trace_dump(NULL, i);
+            break;
+        case 63:
+            rc = cne_graph_trace_pcapng_save(i, arg);
+            if (rc < 0)
+                CNE_ERR_RET("[magenta]Failed to save trace of graph [red]%s [magenta]to [cyan]%s[]\n",
+                            name, arg);
+            cne_printf("[magenta]Saved [red]%d [magenta]packets of graph [red]%s [magenta]to "
+                       "[cyan]%s[]\n",
+                       rc, name, arg);
+            /* One graph per file */
+            return 0;
+        }
+    }
+    if (cnt == 0)
+        CNE_ERR_RET("[magenta]No graph matching [red]%s[]\n", pattern);
+
+    return 0;
+}
+
+/* Enable or disable a feature of an arc on an interface */
+static int
+graph_feature(bool enable, const char *name, const char *feature, const char *iface)
+{
+    struct cne_graph_feature_arc *arc = cne_graph_feature_arc_lookup(name);
+    int rc;
+
+    if (!arc)
+        CNE_ERR_RET("[magenta]Feature arc [red]%s [magenta]not found[]\n", name);
+
+    if (enable)
+        rc = cne_graph_feature_enable(arc, feature, atoi(iface));
+    else
+        rc = cne_graph_feature_disable(arc, feature, atoi(iface));
+    if (rc < 0)
+        CNE_ERR_RET("[magenta]Failed to %s feature [red]%s [magenta]on interface [red]%s[]\n",
+                    enable ? "enable" : "disable", feature, iface);
+
+    return 0;
+}
+
 // clang-format off
 static struct cli_map graph_map[] = {
     {10, "graph list"},
@@ -469,6 +546,13 @@ static struct cli_map graph_map[] = {
     {40, "graph stats"},
     {41, "graph stats %d"},
     {50, "graph drop"},
+    {60, "graph trace on %s %d"},
+    {61, "graph trace off %s"},
+    {62, "graph trace show %s"},
+    {63, "graph trace save %s %s"},
+    {70, "graph feature"},
+    {71, "graph feature enable %s %s %d"},
+    {72, "graph feature disable %s %s %d"},
     {-1, NULL}
     };
 // clang-format on
@@ -519,6 +603,17 @@ cmd_graph(int argc, char **argv)
         remove_pkt_drop = (remove_pkt_drop == 0) ? 1 : 0;
         cne_printf("%sShowing pkt_drop node\n", remove_pkt_drop ? "Not " : "");
         return 0;
+    case 60:
+    case 61:
+    case 62:
+    case 63:
+        return graph_trace(m->index, argv[3], (argc > 4) ? argv[4] : NULL);
+    case 70:
+        cne_graph_feature_arc_dump(NULL, NULL);
+        return 0;
+    case 71:
+    case 72:
+        return graph_feature(m->index == 71, argv[3], argv[4], argv[5]);
     default:
         return cli_cmd_error("Command invalid", "Graph", argc, argv);
     }
@@ -707,6 +802,13 @@ cmd_tcp(int argc, char **argv)
         _(tcp_rexmit);
         _(resets_sent);
         _(tcp_connect);
+        _(ooo_queued);
+        _(ooo_dropped);
+        _(sack_recovery);
+        _(sack_rexmit);
+        _(snd_zcopy);
+        _(snd_lso);
+        _(rx_gro);
         break;
     default:
         return cli_cmd_error("Command invalid", "tcp", argc, argv);
@@ -755,7 +857,7 @@ static struct cli_tree cnet_tree[] = {
     c_cmd("ip",         cmd_ip,         "Show IP interface information [link|route|neigh|stats]"),
     c_cmd("hmap",       cmd_hmap,       "dump out the hashmap data"),
     c_cmd("obj",        cmd_obj,        "objpool show command"),
-    c_cmd("graph",      cmd_graph,      "CNET Graph information [list|node|dump|dot|stats]"),
+    c_cmd("graph",      cmd_graph,      "CNET Graph information [list|node|dump|dot|stats|trace|feature]"),
     c_cmd("netlink",    cmd_netlink,    "Enable/Disable Netlink messages"),
     c_cmd("ipcksum",    cmd_ip_cksum,   "Test IP checksum"),
     c_cmd("tcp",        cmd_tcp,        "TCP information"),
@@ -22,6 +22,7 @@
 #include <cne_log.h>         // for CNE_LOG, CNE_LOG_ERR
 #include <cne_ring.h>        // for cne_ring_create
 #include <cne_hash.h>
+#include <cne_rcu_qsbr.h>        // for cne_rcu_qsbr_create, cne_rcu_qsbr_destroy
 #include <pktdev_api.h>         // for pktdev_port_count
 #include <pktdev_core.h>        // for cne_pktdev, pktdev_data
 #include <pmd_ring.h>
@@ -74,6 +75,11 @@ cnet_config_create(uint32_t num_chnls, uint32_t num_routes)
         if (cnet_drv_create(cnet) < 0)
             CNE_ERR_GOTO(leave, "Unable to create OSAL\n");
 
+        /* Route and ARP entries are freed after the stack graphs completed a walk */
+        cnet->qsbr = cne_rcu_qsbr_create(STK_VEC_COUNT);
+        if (!cnet->qsbr)
+            CNE_ERR_GOTO(leave, "Unable to create QSBR variable\n");
+
         if (cnet_route4_create(cnet, num_routes, 0) < 0)
             CNE_ERR_GOTO(leave, "Unable to create route\n");
 
@@ -114,6 +120,7 @@ cnet_stop(void)
         cnet_route4_destroy(cnet);
         cnet_arp_destroy(cnet);
         cnet_netlink_destroy(cnet);
+        cne_rcu_qsbr_destroy(cnet->qsbr);
 
         vec_free(cnet->stks);
         vec_free(cnet->drvs);
@@ -29,6 +29,7 @@ struct stk_s;
 struct drv_entry;
 struct cne_mempool;
 struct fib_info;
+struct cne_rcu_qsbr;
 
 struct cnet {
     CNE_ATOMIC(uint_fast16_t) stk_order; /**< Order of the stack initializations */
@@ -49,6 +50,8 @@ struct cnet {
     struct fib_info *arp_finfo;          /**< ARP FIB table pointer */
     struct fib_info *pcb_finfo;          /**< PCB FIB table pointer */
     struct fib_info *tcb_finfo;          /**< TCB FIB table pointer */
+    struct cne_rcu_qsbr *qsbr;           /**< QSBR variable of the stack graph threads */
+    uint32_t rt4_nhg_cnt;                /**< Number of IPv4 routes with a nexthop group */
 } __cne_cache_aligned;
 
 enum {
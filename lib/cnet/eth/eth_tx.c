@@ -6,41 +6,81 @@
 #include <pktdev.h>                  // for pktdev_tx_burst
 #include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
 #include <cne_graph_worker.h>        // for cne_node, cne_graph
-#include <pktmbuf.h>                 // for pktmbuf_t
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_free
+#include <gso.h>                     // for gso_segment, gso_needed, GSO_MAX_SEGS
 #include <stdint.h>                  // for uint16_t, uint32_t, uint64_t
 
 #include <cnet_eth.h>        // for
 
-#include "cne_common.h"        // for CNE_MAX_ETHPORTS, CNE_PRIORITY_LAST
-#include "cne_log.h"           // for CNE_VERIFY
+#include "cne_common.h"                   // for CNE_MAX_ETHPORTS, CNE_PRIORITY_LAST
+#include "cne_log.h"                      // for CNE_VERIFY
+#include "cne_branch_prediction.h"        // for likely
 
 #include <cnet_node_names.h>
 #include "eth_tx_priv.h"        // for eth_tx_node_ctx_t, ETH_TX_NEXT_MAX
 
 static struct eth_tx_node_main eth_tx_main;
 
+/* Segment the large packets from the pool of the packet */
+static const gso_ctx_t eth_tx_gso = {.pi = NULL, .gso_types = GSO_SEG_FLAGS};
+
+static inline int
+eth_tx_send(uint16_t port, pktmbuf_t **pkts, uint16_t nb_pkts)
+{
+    while (nb_pkts) {
+        int cnt;
+
+        cnt = pktdev_tx_burst(port, pkts, nb_pkts);
+        if (cnt == PKTDEV_ADMIN_STATE_DOWN)
+            return cnt;
+
+        pkts += cnt;
+        nb_pkts -= cnt;
+    }
+    return 0;
+}
+
+/* Send the packets splitting the large packets into wire sized segments in front of the port */
+static int
+eth_tx_gso_send(uint16_t port, pktmbuf_t **pkts, uint16_t nb_pkts)
+{
+    pktmbuf_t *segs[GSO_MAX_SEGS];
+    uint16_t start = 0;
+    int n;
+
+    for (uint16_t i = 0; i < nb_pkts; i++) {
+        if (likely(!gso_needed(pkts[i])))
+            continue;
+
+        if (eth_tx_send(port, &pkts[start], i - start) == PKTDEV_ADMIN_STATE_DOWN)
+            return PKTDEV_ADMIN_STATE_DOWN;
+        start = i + 1;
+
+        n = gso_segment(&eth_tx_gso, pkts[i], segs, GSO_MAX_SEGS);
+        if (n <= 0) {
+            pktmbuf_free(pkts[i]);
+            continue;
+        }
+
+        if (eth_tx_send(port, segs, n) == PKTDEV_ADMIN_STATE_DOWN)
+            return PKTDEV_ADMIN_STATE_DOWN;
+    }
+
+    return eth_tx_send(port, &pkts[start], nb_pkts - start);
+}
+
 static uint16_t
 eth_tx_node_process(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
 {
     eth_tx_node_ctx_t *ctx = (eth_tx_node_ctx_t *)node->ctx;
     uint16_t port          = ctx->port; /* Get TX port id */
-    uint16_t count         = nb_objs;
 
     CNE_SET_USED(graph);
 
-    if (nb_objs) {
-        do {
-            int cnt;
+    if (eth_tx_gso_send(port, (pktmbuf_t **)objs, nb_objs) == PKTDEV_ADMIN_STATE_DOWN)
+        return PKTDEV_ADMIN_STATE_DOWN;
 
-            cnt = pktdev_tx_burst(port, (pktmbuf_t **)objs, nb_objs);
-            if (cnt == PKTDEV_ADMIN_STATE_DOWN)
-                return cnt;
-
-            objs += cnt;
-            nb_objs -= cnt;
-        } while (nb_objs);
-    }
-    return count;
+    return nb_objs;
 }
 
 static int
@@ -17,20 +17,26 @@
 
 #include <cne_rwlock.h>
 #include <cne_fib.h>
+#include <cne_rcu_qsbr.h>
 
 struct rt4_entry;
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef void (*fib_free_t)(void *obj);
+
 typedef struct fib_info {
-    struct cne_fib *fib;  /**< fib structure */
-    void **idx2obj;       /**< Index to object array */
-    cne_rwlock_t lock;    /**< lock to protect idx2obj */
-    uint32_t objcnt;      /**< Maximum number of objects (pow2) */
-    uint32_t mask;        /**< Mask number of objects */
-    uint32_t index_shift; /**< Shift number of bits to get next index */
-    uint32_t index;       /**< Current index in idx2obj array */
+    struct cne_fib *fib;        /**< fib structure */
+    void **idx2obj;             /**< Index to object array */
+    cne_rwlock_t lock;          /**< lock to protect idx2obj */
+    uint32_t objcnt;            /**< Maximum number of objects (pow2) */
+    uint32_t mask;              /**< Mask number of objects */
+    uint32_t index_shift;       /**< Shift number of bits to get next index */
+    uint32_t index;             /**< Current index in idx2obj array */
+    struct cne_rcu_qsbr *v;     /**< QSBR variable of the graph threads or NULL */
+    struct cne_rcu_qsbr_dq *dq; /**< Deleted objects waiting for the graph threads */
+    fib_free_t free_fn;         /**< Function to free a deleted object */
 } fib_info_t;
 
 /**
@@ -130,6 +136,7 @@ static inline void
 fib_info_destroy(fib_info_t *fi)
 {
     if (fi) {
+        cne_rcu_qsbr_dq_delete(fi->dq);
         if (fi->idx2obj)
             free(fi->idx2obj);
         if (fi->fib)
@@ -179,6 +186,87 @@ fib_info_create(struct cne_fib *fib, uint32_t objcnt, uint32_t index_shift)
     return fi;
 }
 
+static inline void
+__fib_info_qsbr_free(void *p, void *data, unsigned int n __cne_unused)
+{
+    fib_info_t *fi = p;
+
+    fi->free_fn(*(void **)data);
+}
+
+/**
+ * Attach a QSBR variable to the FIB information structure, deleted objects and
+ * the FIB tbl8 groups are then freed only after the graph threads reporting to
+ * the QSBR variable completed a walk.
+ *
+ * @param fi
+ *   The FIB information structure pointer.
+ * @param v
+ *   The QSBR variable of the graph threads.
+ * @param free_fn
+ *   The function to free a deleted object.
+ * @param name
+ *   The name of the defer queue.
+ * @return
+ *   -1 on error or 0 on success
+ */
+static inline int
+fib_info_qsbr_add(fib_info_t *fi, struct cne_rcu_qsbr *v, fib_free_t free_fn, const char *name)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    struct cne_fib_rcu_config rcfg           = {0};
+
+    if (!fi || !v || !free_fn || fi->v)
+        return -1;
+
+    rcfg.v    = v;
+    rcfg.mode = CNE_FIB_QSBR_MODE_DQ;
+    if (cne_fib_rcu_qsbr_add(fi->fib, &rcfg) < 0)
+        return -1;
+
+    params.name             = name;
+    params.size             = fi->objcnt;
+    params.esize            = sizeof(void *);
+    params.max_reclaim_size = 16;
+    params.free_fn          = __fib_info_qsbr_free;
+    params.p                = fi;
+    params.v                = v;
+
+    fi->dq = cne_rcu_qsbr_dq_create(&params);
+    if (!fi->dq)
+        return -1;
+
+    fi->free_fn = free_fn;
+    fi->v       = v;
+
+    return 0;
+}
+
+/**
+ * Free a deleted object once the graph threads can no longer reference it.
+ * Must not be called from a graph thread reporting to the QSBR variable.
+ *
+ * @param fi
+ *   The FIB information structure pointer.
+ * @param obj
+ *   The object removed with fib_info_free().
+ * @return
+ *   1 if the object is freed later or 0 if the caller must free it now.
+ */
+static inline int
+fib_info_defer_free(fib_info_t *fi, void *obj)
+{
+    if (!fi || !fi->v)
+        return 0;
+
+    if (cne_rcu_qsbr_dq_enqueue(fi->dq, &obj) == 0)
+        return 1;
+
+    /* The defer queue is full, wait for the graph threads */
+    cne_rcu_qsbr_synchronize(fi->v, CNE_QSBR_THRID_INVALID);
+    return 0;
+}
+
 /**
  * Get the object pointed to by the index value in the FIB info structure
  *
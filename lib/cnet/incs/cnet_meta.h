@@ -12,14 +12,21 @@
 
 #include <cnet_ip_common.h>
 #include <cne_inet.h>
+#include <pktmbuf.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define CNET_META_ZCOPY 0x0001 /**< mbuf can be transmitted in place by the stack */
+
 struct cnet_metadata {
     struct in_caddr faddr;
     struct in_caddr laddr;
+    uint16_t snd_off;    /**< Data offset of the unacked data in a TCP send buffer mbuf */
+    uint16_t snd_len;    /**< Length of the unacked data in a TCP send buffer mbuf */
+    uint16_t flags;      /**< CNET_META_XXX flags given to the stack with the mbuf */
+    pktmbuf_t *gro_next; /**< Next TCP segment merged by tcp_gro or delivered after this one */
 
     CNE_MARKER end_metadata;
 } __cne_cache_aligned; /**< cnet_metadata should be <= 64 bytes */
@@ -33,10 +33,15 @@
 #include "cnet_ipv4.h"           // for ipv4_entry, ipv4_stats, DEFAULT_I...
 #include "cnet_protosw.h"        // for protosw_entry, cnet_ipproto_get
 #include "pktmbuf.h"             // for pktmbuf_t, pktmbuf_free
+#include "ip_frag.h"             // for ip_frag_tbl_create, ip_frag_tbl_stats_get
+#include "cne_mmap.h"            // for mmap_alloc, mmap_addr, mmap_free
+#include "cne_cycles.h"          // for cne_rdtsc
 
 static void
 __ipv4_stats_dump(stk_t *stk)
 {
+    struct ip_frag_stats fs = {0};
+
     cne_printf("[magenta]Network Stack statistics[]: [orange]%s[]\n", stk->name);
 
 #define _(stat) cne_printf("    [magenta]%-24s[]= [orange]%'ld[]\n", #stat, stk->ipv4->stats.stat)
@@ -55,6 +60,23 @@ __ipv4_stats_dump(stk_t *stk)
     _(ip_mforward_failed);
     _(ip_mlookup_failed);
     _(ip_forwarding_disabled);
+    _(ip_frag_pkts);
+    _(ip_frag_created);
+    _(ip_frag_failed);
+#undef _
+
+    if (ip_frag_tbl_stats_get(stk->ipv4->frag_tbl, &fs) < 0)
+        return;
+
+#define _(stat) cne_printf("    [magenta]%-24s[]= [orange]%'ld[]\n", "ip_reassem_" #stat, fs.stat)
+    _(reassembled);
+    _(timeout);
+    _(table_full);
+    _(invalid);
+    _(too_many);
+    _(too_big);
+    _(no_buffer);
+    _(frags_full);
 #undef _
 }
 
@@ -91,6 +113,15 @@ cnet_ipv4_dump(const char *msg, struct cne_ipv4_hdr *ip)
                be16toh(ip->total_length), ip->type_of_service);
 }
 
+/* Free the fragments of the timed out datagrams, even when no fragments are received */
+static void
+ipv4_reassem_expire(struct cne_timer *tim __cne_unused, void *arg)
+{
+    stk_t *stk = arg;
+
+    ip_frag_tbl_expire(stk->ipv4->frag_tbl, cne_rdtsc(), UINT32_MAX);
+}
+
 static int
 ipv4_create(void *_stk)
 {
@@ -101,9 +132,42 @@ ipv4_create(void *_stk)
         return -1;
 
     stk->ipv4->ip_forwarding = DEFAULT_FORWARDING_STATE;
-    stk->ipv4->reassem_ttl   = 0;
+    stk->ipv4->reassem_ttl   = IPV4_REASSEM_TTL;
+
+    /* The datagrams not fitting in the buffer of their first fragment are copied into these */
+    stk->ipv4->reassem_mm =
+        mmap_alloc(IPV4_REASSEM_MBUFS, IPV4_REASSEM_BUFSZ, MMAP_HUGEPAGE_DEFAULT);
+    if (stk->ipv4->reassem_mm == NULL)
+        goto err;
+
+    stk->ipv4->reassem_pi = pktmbuf_pool_create(mmap_addr(stk->ipv4->reassem_mm),
+                                                IPV4_REASSEM_MBUFS, IPV4_REASSEM_BUFSZ, 0, NULL);
+    if (stk->ipv4->reassem_pi == NULL)
+        goto err;
+    pktmbuf_info_name_set(stk->ipv4->reassem_pi, "ipv4_reassem");
+
+    stk->ipv4->frag_tbl = ip_frag_tbl_create(IPV4_REASSEM_ENTRIES, stk->ipv4->reassem_ttl * 1000,
+                                             IPV4_REASSEM_FRAGS, stk->ipv4->reassem_pi);
+    if (stk->ipv4->frag_tbl == NULL)
+        goto err;
+
+    cne_timer_init(&stk->ipv4->reassem_tim);
+
+    if (cne_timer_reset(&stk->ipv4->reassem_tim, (cne_get_timer_hz() / 1000) * IPV4_REASSEM_EXPIRE,
+                        PERIODICAL, cne_id(), ipv4_reassem_expire, stk) < 0) {
+        CNE_ERR("Unable to start the reassembly timer for instance %s\n", stk->name);
+        goto err;
+    }
 
     return 0;
+
+err:
+    ip_frag_tbl_destroy(stk->ipv4->frag_tbl);
+    pktmbuf_destroy(stk->ipv4->reassem_pi);
+    mmap_free(stk->ipv4->reassem_mm);
+    free(stk->ipv4);
+    stk->ipv4 = NULL;
+    return -1;
 }
 
 static int
@@ -111,6 +175,13 @@ ipv4_destroy(void *_stk)
 {
     stk_t *stk = _stk;
 
+    if (stk->ipv4) {
+        if (cne_timer_stop(&stk->ipv4->reassem_tim) < 0)
+            CNE_ERR("Unable to stop the reassembly timer for instance %s\n", stk->name);
+        ip_frag_tbl_destroy(stk->ipv4->frag_tbl);
+        pktmbuf_destroy(stk->ipv4->reassem_pi);
+        mmap_free(stk->ipv4->reassem_mm);
+    }
     free(stk->ipv4);
     stk->ipv4 = NULL;
 
@@ -13,6 +13,9 @@
 #include <net/cne_ip.h>          // for cne_ipv4_hdr
 #include <cne_inet.h>            // for _in_addr
 #include <cnet_protosw.h>        // for
+#include <cne_mmap.h>            // for mmap_t
+#include <cne_timer.h>           // for cne_timer
+#include <pktmbuf.h>             // for pktmbuf_info_t
 #include <endian.h>              // for htobe16
 #include <netinet/in.h>          // for IN_CLASSA, IN_CLASSB, IN_CLASSC, IN_CLASSD
 #include <stdint.h>              // for uint16_t, uint8_t, uint64_t, uint32_t, int...
@@ -32,6 +35,13 @@ extern "C" {
 #define TTL_DEFAULT 64 /* Default TTL value */
 #define TOS_DEFAULT 0  /* Default TOS value */
 
+#define IPV4_REASSEM_ENTRIES 1024 /* Max datagrams being reassembled per stack */
+#define IPV4_REASSEM_TTL     15   /* Reassembly timeout in seconds, see RFC 791 */
+#define IPV4_REASSEM_MBUFS   64   /* Buffers of the datagrams larger than their first fragment */
+#define IPV4_REASSEM_BUFSZ   (65536 - CNE_CACHE_LINE_SIZE) /* Largest mbuf, buf_len is 16 bits */
+#define IPV4_REASSEM_FRAGS   2048 /* Max fragments held per stack, bounds the mbufs of a flood */
+#define IPV4_REASSEM_EXPIRE  100  /* Period in milliseconds of the reassembly timeout check */
+
 #define DEFAULT_IPV4_HDR_SIZE 20
 #define IPv4_VER_LEN_VALUE    ((IPv4_VERSION << 4) | (sizeof(struct cne_ipv4_hdr) / 4))
 
@@ -39,6 +49,7 @@ struct rt4_entry;
 struct arp_entry;
 struct cne_lpm;
 struct ipfwd_info;
+struct ip_frag_tbl;
 
 struct ipv4_stats {
     uint64_t ip_ver_error;
@@ -56,17 +67,24 @@ struct ipv4_stats {
     uint64_t ip_mforward_failed;
     uint64_t ip_mlookup_failed;
     uint64_t ip_forwarding_disabled;
+    uint64_t ip_frag_pkts;
+    uint64_t ip_frag_created;
+    uint64_t ip_frag_failed;
 };
 
 struct ipv4_entry {
-    uint8_t ip_forwarding;       /**< IP forwarding is enabled */
-    uint8_t do_multicast;        /**< Allow multicast support */
-    uint16_t reassem_ttl;        /**< reassemble TTL value */
-    struct ipfwd_info *fwd_info; /**< Forwarding information */
-    struct ipv4_stats stats;     /**< simple stats for protocol */
-    iofunc_t fastpath;           /**< Fastpath function pointer */
-    iofunc_t dhcp;               /**< DHCP function pointer */
-    iofunc_t setup;              /**< IP Setup routine */
+    uint8_t ip_forwarding;        /**< IP forwarding is enabled */
+    uint8_t do_multicast;         /**< Allow multicast support */
+    uint16_t reassem_ttl;         /**< reassemble TTL value in seconds */
+    struct ipfwd_info *fwd_info;  /**< Forwarding information */
+    struct ip_frag_tbl *frag_tbl; /**< Reassembly table of the received fragments */
+    pktmbuf_info_t *reassem_pi;   /**< Pool of the datagrams larger than their first fragment */
+    mmap_t *reassem_mm;           /**< Memory of the reassembly pool */
+    struct cne_timer reassem_tim; /**< Timer freeing the timed out fragments */
+    struct ipv4_stats stats;      /**< simple stats for protocol */
+    iofunc_t fastpath;            /**< Fastpath function pointer */
+    iofunc_t dhcp;                /**< DHCP function pointer */
+    iofunc_t setup;               /**< IP Setup routine */
 } __cne_cache_aligned;
 
 #define IPv4(a, b, c, d) \
@@ -138,37 +156,6 @@ struct ipoptions {
                : IN_CLASSD((_ip)) ? 4 \
                                   : 0))
 
-/*
- * Adjust the checksum to reflect that the TTL had been decremented.
- *
- * Flip the bits on the checksum, decrement the high byte of the checksum,
- * fold in any carry, and then flip the bits back.  Rather than convert
- * the checksum to host byte order and then back to network byte order,
- * just convert the increment to network byte order.  Note: in 1's
- * complement arithmetic, subtracting by x is the same as adding the 1's
- * complement of x.  So, in 16 bit arithmetic, rather than subtracting by
- * (1<<8), we can add by (1<<8)^0xffff.  Since it's all constants, that
- * should be evaluated by the compiler at compile time.
- *
- * Doing the ^0xffff to initially flip the bits keeps the upper bits from
- * also being flipped. Using the ~ operation at the end doesn't matter,
- * because the upper bits get tossed when we assign it to the 16 bit sum
- * field, so let the compiler do whatever is fastest.
- */
-static inline void
-ipv4_adjust_cksum(struct cne_ipv4_hdr *hdr)
-{
-    int32_t cksum;
-
-    hdr->time_to_live--;
-
-    /* increment checksum high byte */
-    cksum = (int32_t)(hdr->hdr_checksum ^ 0xFFFF) + (int32_t)htobe16(((1 << 8) ^ 0xFFFF));
-
-    /* Fold the carry bit into the checksum */
-    hdr->hdr_checksum = ~(cksum + (cksum >> 16));
-}
-
 /**
  * @brief Dump the IPv4 statistics
  *
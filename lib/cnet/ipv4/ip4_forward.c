@@ -5,7 +5,7 @@
 
 #include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
 #include <cne_graph_worker.h>        // for cne_node_enqueue_x1, cne_node_nex...
-#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <net/cne_ip.h>              // for cne_ipv4_hdr, cne_ipv4_ttl_dec
 #include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod
 #include <cne_vect.h>                // for cne_xmm_t
 #include <net/cne_ether.h>           // for cne_ether_hdr
@@ -22,6 +22,7 @@
 #include <cne_prefetch.h>                 // for cne_prefetch0
 #include <cne_branch_prediction.h>        // for likely, unlikely
 #include <cne_hash.h>                     // for
+#include <cne_fib_nhg.h>                  // for cne_fib_nhg_select, cne_fib_nhg_hash_ipv4
 
 #include <cnet_const.h>        // for
 #include <cnet_stk.h>
@@ -47,6 +48,33 @@ static struct ip4_forward_node_main *ip4_forward_nm;
 
 #define IP4_FORWARD_NODE_LAST_NEXT(ctx) (((struct ip4_forward_node_ctx *)ctx)->next_index)
 
+/*
+ * Return the address to resolve with ARP, the gateway picked by the flow hash
+ * for an ECMP route or the destination address.
+ */
+static inline uint32_t
+ip4_forward_nexthop(fib_info_t *rt_fi, pktmbuf_t *m, struct cne_ipv4_hdr *hdr, uint32_t dst)
+{
+    struct rt4_entry *rt = NULL;
+    struct cne_fib_nhg *nhg;
+    uint32_t hash, gate;
+
+    if (fib_info_lookup(rt_fi, &dst, (void **)&rt, 1) <= 0)
+        return dst;
+
+    nhg = __atomic_load_n(&rt->nhg, __ATOMIC_ACQUIRE);
+    if (!nhg)
+        return dst;
+
+    hash = pktmbuf_hash(m);
+    if (hash == 0)
+        hash = cne_fib_nhg_hash_ipv4(hdr);
+
+    gate = (uint32_t)cne_fib_nhg_select(nhg, hash);
+
+    return (gate) ? gate : dst;
+}
+
 static uint16_t
 ip4_forward_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
                          uint16_t nb_objs)
@@ -62,11 +90,13 @@ ip4_forward_node_process(struct cne_graph *graph, struct cne_node *node, void **
     struct cne_ether_hdr *eth[4];
     struct arp_entry *arp[4];
     uint32_t ip4[4];
+    bool ecmp;
 
     /* Speculative next as last next */
     n_index = IP4_FORWARD_NODE_LAST_NEXT(node->ctx);
 
     fi          = cnet->arp_finfo;
+    ecmp        = __atomic_load_n(&cnet->rt4_nhg_cnt, __ATOMIC_RELAXED) > 0;
     pkts        = (pktmbuf_t **)objs;
     from        = objs;
     n_left_from = nb_objs;
@@ -108,22 +138,30 @@ ip4_forward_node_process(struct cne_graph *graph, struct cne_node *node, void **
 
         hdr    = pktmbuf_mtod(mbuf0, struct cne_ipv4_hdr *);
         ip4[0] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        if (unlikely(ecmp))
+            ip4[0] = ip4_forward_nexthop(cnet->rt4_finfo, mbuf0, hdr, ip4[0]);
+        cne_ipv4_ttl_dec(hdr);
         eth[0] = pktmbuf_adjust(mbuf0, struct cne_ether_hdr *, -mbuf0->l2_len);
 
         hdr    = pktmbuf_mtod(mbuf1, struct cne_ipv4_hdr *);
         ip4[1] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        if (unlikely(ecmp))
+            ip4[1] = ip4_forward_nexthop(cnet->rt4_finfo, mbuf1, hdr, ip4[1]);
+        cne_ipv4_ttl_dec(hdr);
         eth[1] = pktmbuf_adjust(mbuf1, struct cne_ether_hdr *, -mbuf1->l2_len);
 
         hdr    = pktmbuf_mtod(mbuf2, struct cne_ipv4_hdr *);
         ip4[2] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        if (unlikely(ecmp))
+            ip4[2] = ip4_forward_nexthop(cnet->rt4_finfo, mbuf2, hdr, ip4[2]);
+        cne_ipv4_ttl_dec(hdr);
         eth[2] = pktmbuf_adjust(mbuf2, struct cne_ether_hdr *, -mbuf2->l2_len);
 
         hdr    = pktmbuf_mtod(mbuf3, struct cne_ipv4_hdr *);
         ip4[3] = be32toh(hdr->dst_addr);
-        ipv4_adjust_cksum(hdr);
+        if (unlikely(ecmp))
+            ip4[3] = ip4_forward_nexthop(cnet->rt4_finfo, mbuf3, hdr, ip4[3]);
+        cne_ipv4_ttl_dec(hdr);
         eth[3] = pktmbuf_adjust(mbuf3, struct cne_ether_hdr *, -mbuf3->l2_len);
 
         n0 = n1 = n2 = n3 = NODE_IP4_FORWARD_ARP_REQUEST;
@@ -226,11 +264,14 @@ ip4_forward_node_process(struct cne_graph *graph, struct cne_node *node, void **
         n_left_from -= 1;
 
         hdr = pktmbuf_mtod(mbuf0, struct cne_ipv4_hdr *);
-        ipv4_adjust_cksum(hdr);
-        eth[0] = pktmbuf_adjust(mbuf0, struct cne_ether_hdr *, -mbuf0->l2_len);
 
         /* Look up the destination IP address in the arp hash table */
         ip4[0] = be32toh(hdr->dst_addr);
+        if (unlikely(ecmp))
+            ip4[0] = ip4_forward_nexthop(cnet->rt4_finfo, mbuf0, hdr, ip4[0]);
+
+        cne_ipv4_ttl_dec(hdr);
+        eth[0] = pktmbuf_adjust(mbuf0, struct cne_ether_hdr *, -mbuf0->l2_len);
 
         n0 = NODE_IP4_FORWARD_ARP_REQUEST;
         if (unlikely(fib_info_lookup(fi, ip4, (void **)arp, 1) > 0)) {
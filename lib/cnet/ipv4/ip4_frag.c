@@ -0,0 +1,75 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cnet.h>                    // for cnet_add_instance, cnet, per_thread_cnet
+#include <cnet_stk.h>                // for stk_t, this_stk
+#include <stdint.h>                  // for uint16_t
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node_enqueue, cne_node_enqueue_x1
+#include <cne_common.h>              // for __cne_unused
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_port
+#include <ip_frag.h>                 // for ip_frag_ipv4, IP_FRAG_MAX_OUT
+#include <cnet_netif.h>              // for netif, cnet_netif_from_index
+#include <cnet_ipv4.h>               // for ipv4_entry, ipv4_stats
+
+#include <cnet_node_names.h>
+#include "ip4_node_api.h"        // for ip4_frag_node_get
+#include "ip4_frag_priv.h"       // for IP4_FRAG_NEXT_PKT_DROP, IP4_FRAG_NEXT_MAX
+
+/*
+ * Fragment the packets larger than the MTU of the interface they are sent on. The ip4_output
+ * node puts the index of the interface in the port of the packet, the eth_tx node of each
+ * interface is at the same edge as from the ip4_output node.
+ */
+static uint16_t
+ip4_frag_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                      uint16_t nb_objs)
+{
+    struct ipv4_stats *stats = &this_stk->ipv4->stats;
+    pktmbuf_t *frags[IP_FRAG_MAX_OUT];
+
+    for (uint16_t i = 0; i < nb_objs; i++) {
+        pktmbuf_t *m = objs[i];
+        struct netif *nif;
+        int n;
+
+        nif = cnet_netif_from_index(pktmbuf_port(m));
+        if (!nif || (n = ip_frag_ipv4(m, nif->mtu, NULL, frags, IP_FRAG_MAX_OUT)) < 0) {
+            stats->ip_frag_failed++;
+            cne_node_enqueue_x1(graph, node, IP4_FRAG_NEXT_PKT_DROP, m);
+            continue;
+        }
+
+        if (n == 0) {
+            cne_node_enqueue_x1(graph, node, nif->netif_idx + IP4_FRAG_NEXT_MAX, m);
+            continue;
+        }
+
+        stats->ip_frag_pkts++;
+        stats->ip_frag_created += n;
+
+        cne_node_enqueue(graph, node, nif->netif_idx + IP4_FRAG_NEXT_MAX, (void **)frags, n);
+    }
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip4_frag_node = {
+    .process = ip4_frag_node_process,
+    .name    = IP4_FRAG_NODE_NAME,
+
+    .nb_edges = IP4_FRAG_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP4_FRAG_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME, /* TX output nodes go here */
+        },
+};
+
+struct cne_node_register *
+ip4_frag_node_get(void)
+{
+    return &ip4_frag_node;
+}
+
+CNE_NODE_REGISTER(ip4_frag_node);
@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __INCLUDE_IP4_FRAG_PRIV_H__
+#define __INCLUDE_IP4_FRAG_PRIV_H__
+
+/**
+ * @file ip4_frag_priv.h
+ *
+ * This API allows to do control path functions of ip4_* nodes
+ * like ip4_frag, ip4_output.
+ *
+ */
+#include <cne_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * IP4 fragmentation next nodes, the eth_tx node of each port is added after them.
+ */
+enum ip4_frag_next {
+    IP4_FRAG_NEXT_PKT_DROP, /**< Packet drop node. */
+    IP4_FRAG_NEXT_MAX,      /**< Number of next nodes of fragmentation node. */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_IP4_FRAG_PRIV_H__ */
@@ -8,18 +8,20 @@
 #include <cne_fib.h>                 // for cne_fib_create, cne_fib_add, cne_...
 #include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
 #include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue_x1
-#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <net/cne_ip.h>              // for cne_ipv4_hdr, cne_ipv4_cksum_bulk
 #include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod_offset
 #include <net/cne_ether.h>           // for cne_ether_hdr
 #include <cne_system.h>              // for cne_max_numa_nodes
 #include <errno.h>                   // for errno
 #include <netinet/in.h>              // for in_addr, INET6_ADDRSTRLEN, htonl
 #include <stddef.h>                  // for offsetof
+#include <stdbool.h>                 // for bool
 #include <stdint.h>                  // for uint16_t, uint32_t, uint8_t
 #include <string.h>                  // for memcpy, NULL
 #include <cnet_route.h>              // for
 #include <cnet_route4.h>             // for
 #include <cnet_meta.h>               // for
+#include <ip_frag.h>                 // for ip_frag_is_fragment
 
 #include <cnet_node_names.h>
 #include "ip4_node_api.h"                 // for
@@ -29,6 +31,28 @@
 #include "cne_log.h"                      // for CNE_LOG_DEBUG, CNE_LOG_ERR, CNE_INFO
 #include "cnet_fib_info.h"
 
+static struct cne_graph_feature_arc *ip4_forward_arc;
+
+/* Send a packet to forward to the first feature enabled on its interface */
+static __cne_always_inline cne_edge_t
+ip4_input_feature_next(cne_edge_t next, pktmbuf_t *m)
+{
+    if (next != CNE_NODE_IP4_INPUT_NEXT_FORWARD)
+        return next;
+
+    return cne_graph_feature_next(ip4_forward_arc, CNE_GRAPH_FEATURE_START, pktmbuf_port(m));
+}
+
+/* Send a fragment of a datagram to this host to be reassembled before the protocol node */
+static __cne_always_inline cne_edge_t
+ip4_input_frag_next(cne_edge_t next, const struct cne_ipv4_hdr *ip)
+{
+    if (next == CNE_NODE_IP4_INPUT_NEXT_PROTO && unlikely(ip_frag_is_fragment(ip)))
+        return CNE_NODE_IP4_INPUT_NEXT_REASSEMBLE;
+
+    return next;
+}
+
 static inline void
 ipv4_save_metadata(pktmbuf_t *mbuf, struct cne_ipv4_hdr *hdr)
 {
@@ -44,6 +68,8 @@ ipv4_save_metadata(pktmbuf_t *mbuf, struct cne_ipv4_hdr *hdr)
     md->laddr.cin_family      = AF_INET;
     md->laddr.cin_len         = sizeof(struct in_addr);
     md->laddr.cin_addr.s_addr = hdr->dst_addr;
+
+    md->gro_next = NULL;
 }
 
 static uint16_t
@@ -62,6 +88,8 @@ ip4_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     struct cne_ipv4_hdr *ip4[4];
     uint64_t dst[4] = {0};
     uint32_t dip[4] = {0};
+    uint16_t cksum[4];
+    bool feature;
 
     /* Speculative next */
     next_index = CNE_NODE_IP4_INPUT_NEXT_FORWARD;
@@ -71,6 +99,9 @@ ip4_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     from        = objs;
     n_left_from = nb_objs;
 
+    /* Features are looked up per packet only when enabled on an interface */
+    feature = ip4_forward_arc && cne_graph_feature_arc_enabled(ip4_forward_arc);
+
     if (n_left_from >= 4) {
         for (int i = 0; i < 4; i++)
             cne_prefetch0(pktmbuf_mtod(pkts[i], void *));
@@ -119,24 +150,23 @@ ip4_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         pktmbuf_data_len(mbuf2) = be16toh(ip4[2]->total_length);
         pktmbuf_data_len(mbuf3) = be16toh(ip4[3]->total_length);
 
+        /* Validate the four IP header checksums at the same time */
+        cne_ipv4_cksum_bulk(ip4, cksum, 4);
+
         /*
          * When the total length exceeds mbuf size, the size check/checksum below will
          * detect the invalid size/packet which will be dropped as 'dip[n]' is zero.
          */
-        if (likely(pktmbuf_data_len(mbuf0) < pktmbuf_buf_len(mbuf0)) &&
-            likely(cne_ipv4_cksum(ip4[0]) == 0))
+        if (likely(pktmbuf_data_len(mbuf0) < pktmbuf_buf_len(mbuf0)) && likely(cksum[0] == 0))
             dip[0] = be32toh(ip4[0]->dst_addr);
 
-        if (likely(pktmbuf_data_len(mbuf1) < pktmbuf_buf_len(mbuf1)) &&
-            likely(cne_ipv4_cksum(ip4[1]) == 0))
+        if (likely(pktmbuf_data_len(mbuf1) < pktmbuf_buf_len(mbuf1)) && likely(cksum[1] == 0))
             dip[1] = be32toh(ip4[1]->dst_addr);
 
-        if (likely(pktmbuf_data_len(mbuf2) < pktmbuf_buf_len(mbuf2)) &&
-            likely(cne_ipv4_cksum(ip4[2]) == 0))
+        if (likely(pktmbuf_data_len(mbuf2) < pktmbuf_buf_len(mbuf2)) && likely(cksum[2] == 0))
             dip[2] = be32toh(ip4[2]->dst_addr);
 
-        if (likely(pktmbuf_data_len(mbuf3) < pktmbuf_buf_len(mbuf3)) &&
-            likely(cne_ipv4_cksum(ip4[3]) == 0))
+        if (likely(pktmbuf_data_len(mbuf3) < pktmbuf_buf_len(mbuf3)) && likely(cksum[3] == 0))
             dip[3] = be32toh(ip4[3]->dst_addr);
 
         ipv4_save_metadata(mbuf0, ip4[0]);
@@ -153,6 +183,18 @@ ip4_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
             next3 = (dst[3] >> RT4_NEXT_INDEX_SHIFT);
         }
 
+        next0 = ip4_input_frag_next(next0, ip4[0]);
+        next1 = ip4_input_frag_next(next1, ip4[1]);
+        next2 = ip4_input_frag_next(next2, ip4[2]);
+        next3 = ip4_input_frag_next(next3, ip4[3]);
+
+        if (unlikely(feature)) {
+            next0 = ip4_input_feature_next(next0, mbuf0);
+            next1 = ip4_input_feature_next(next1, mbuf1);
+            next2 = ip4_input_feature_next(next2, mbuf2);
+            next3 = ip4_input_feature_next(next3, mbuf3);
+        }
+
         /* Enqueue four to next node */
         cne_edge_t fix_spec = (next_index ^ next0) | (next_index ^ next1) | (next_index ^ next2) |
                               (next_index ^ next3);
@@ -229,6 +271,9 @@ ip4_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
 
         if (likely(fib_info_lookup_index(fi, dip, dst, 1) > 0))
             next0 = (dst[0] >> RT4_NEXT_INDEX_SHIFT); /* Extract next node id and NH */
+        next0 = ip4_input_frag_next(next0, ip4[0]);
+        if (unlikely(feature))
+            next0 = ip4_input_feature_next(next0, mbuf0);
 
         if (unlikely(next_index ^ next0)) {
             /* Copy things successfully speculated till now */
@@ -278,10 +323,19 @@ static struct cne_node_register ip4_input_node = {
     .nb_edges = CNE_NODE_IP4_INPUT_NEXT_MAX,
     .next_nodes =
         {
-            [CNE_NODE_IP4_INPUT_NEXT_PKT_DROP] = PKT_DROP_NODE_NAME,
-            [CNE_NODE_IP4_INPUT_NEXT_FORWARD]  = IP4_FORWARD_NODE_NAME,
-            [CNE_NODE_IP4_INPUT_NEXT_PROTO]    = IP4_PROTO_NODE_NAME,
+            [CNE_NODE_IP4_INPUT_NEXT_PKT_DROP]   = PKT_DROP_NODE_NAME,
+            [CNE_NODE_IP4_INPUT_NEXT_FORWARD]    = IP4_FORWARD_NODE_NAME,
+            [CNE_NODE_IP4_INPUT_NEXT_PROTO]      = IP4_PROTO_NODE_NAME,
+            [CNE_NODE_IP4_INPUT_NEXT_REASSEMBLE] = IP4_REASSEMBLE_NODE_NAME,
         },
 };
 
 CNE_NODE_REGISTER(ip4_input_node);
+
+CNE_INIT(ip4_input_feature_arc_create)
+{
+    ip4_forward_arc = cne_graph_feature_arc_create(
+        IP4_FORWARD_FEATURE_ARC_NAME, IP4_INPUT_NODE_NAME, IP4_FORWARD_NODE_NAME, CNE_MAX_ETHPORTS);
+    if (!ip4_forward_arc)
+        CNE_ERR("Unable to create the %s feature arc\n", IP4_FORWARD_FEATURE_ARC_NAME);
+}
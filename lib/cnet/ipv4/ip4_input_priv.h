@@ -24,10 +24,11 @@ extern "C" {
  * IP4 lookup next nodes.
  */
 enum cne_node_ip4_input_next {
-    CNE_NODE_IP4_INPUT_NEXT_PKT_DROP, /**< Packet drop node. */
-    CNE_NODE_IP4_INPUT_NEXT_FORWARD,  /**< Forward node. */
-    CNE_NODE_IP4_INPUT_NEXT_PROTO,    /**< Protocol node. */
-    CNE_NODE_IP4_INPUT_NEXT_MAX,      /**< Number of next nodes of lookup node. */
+    CNE_NODE_IP4_INPUT_NEXT_PKT_DROP,   /**< Packet drop node. */
+    CNE_NODE_IP4_INPUT_NEXT_FORWARD,    /**< Forward node. */
+    CNE_NODE_IP4_INPUT_NEXT_PROTO,      /**< Protocol node. */
+    CNE_NODE_IP4_INPUT_NEXT_REASSEMBLE, /**< Reassembly node, for fragments to this host. */
+    CNE_NODE_IP4_INPUT_NEXT_MAX,        /**< Number of next nodes of lookup node. */
 };
 
 #ifdef __cplusplus
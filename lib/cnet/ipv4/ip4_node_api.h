@@ -19,6 +19,12 @@
 extern "C" {
 #endif
 
+/**
+ * Name of the feature arc from the ip4_input node to the ip4_forward node, see
+ * cne_graph_feature_arc_lookup(). The interface of a packet is its lport.
+ */
+#define IP4_FORWARD_FEATURE_ARC_NAME "ip4_forward"
+
 /**
  * Add an address to FIB table.
  *
@@ -72,6 +78,14 @@ CNDP_API struct cne_node_register *ip4_output_node_get(void);
  */
 CNDP_API int ip4_output_set_next(uint16_t port_id, uint16_t next_index);
 
+/**
+ * Get the ipv4 fragmentation node.
+ *
+ * @return
+ *   Pointer to the ipv4 fragmentation node.
+ */
+CNDP_API struct cne_node_register *ip4_frag_node_get(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,7 @@
 #include <net/cne_ip.h>              // for cne_ipv4_hdr
 #include <net/cne_udp.h>             // for cne_udp_hdr
 #include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod_offset
+#include <gso.h>                     // for gso_needed
 #include <net/cne_ether.h>           // for cne_ether_hdr
 #include <cne_system.h>              // for cne_max_numa_nodes
 #include <errno.h>                   // for errno
@@ -99,17 +100,26 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
 
         ip->hdr_checksum = cne_ipv4_cksum(ip);
 
-        /* Do the UDP/TCP checksum if enabled */
+        /*
+         * Do the UDP/TCP checksum if enabled, a packet to be segmented only gets the
+         * pseudo-header checksum as the checksum of each segment is done by GSO.
+         */
         if (pcb->ip_proto == IPPROTO_UDP) {
             if (pcb->opt_flag & UDP_CHKSUM_FLAG) {
                 struct cne_udp_hdr *udp = l4;
 
-                udp->dgram_cksum = cne_ipv4_udptcp_cksum(ip, l4);
+                if (m->ol_flags & CNE_MBUF_F_TX_UDP_SEG)
+                    udp->dgram_cksum = cne_ipv4_phdr_cksum(ip, m->ol_flags);
+                else
+                    udp->dgram_cksum = cne_ipv4_udptcp_cksum(ip, l4);
             }
         } else if (pcb->ip_proto == IPPROTO_TCP) {
             struct cne_tcp_hdr *tcp = l4;
 
-            tcp->cksum = cne_ipv4_udptcp_cksum(ip, l4);
+            if (m->ol_flags & CNE_MBUF_F_TX_TCP_SEG)
+                tcp->cksum = cne_ipv4_phdr_cksum(ip, m->ol_flags);
+            else
+                tcp->cksum = cne_ipv4_udptcp_cksum(ip, l4);
         } else
             return nxt;
 
@@ -119,6 +129,15 @@ ip4_output_header(struct cne_node *node __cne_unused, pktmbuf_t *m, uint16_t nxt
             ether_addr_copy(&arp->ha, &eth->d_addr);
 
             nxt = rt4->netif_idx + IP4_OUTPUT_NEXT_MAX;
+
+            /*
+             * A packet larger than the MTU, and not segmented by GSO, is fragmented by the
+             * ip4_frag node which finds the interface from the port of the packet.
+             */
+            if (unlikely(nif->mtu && be16toh(ip->total_length) > nif->mtu) && !gso_needed(m)) {
+                pktmbuf_port(m) = rt4->netif_idx;
+                nxt             = IP4_OUTPUT_NEXT_FRAG;
+            }
         }
     }
 
@@ -292,8 +311,9 @@ static struct cne_node_register ip4_output_node = {
     .nb_edges = IP4_OUTPUT_NEXT_MAX,
     .next_nodes =
         {
-            [IP4_OUTPUT_NEXT_PKT_DROP]    = PKT_DROP_NODE_NAME,    /* Drop packet node */
-            [IP4_OUTPUT_NEXT_ARP_REQUEST] = ARP_REQUEST_NODE_NAME, /* TX output nodes go here */
+            [IP4_OUTPUT_NEXT_PKT_DROP]    = PKT_DROP_NODE_NAME, /* Drop packet node */
+            [IP4_OUTPUT_NEXT_ARP_REQUEST] = ARP_REQUEST_NODE_NAME,
+            [IP4_OUTPUT_NEXT_FRAG]        = IP4_FRAG_NODE_NAME, /* TX output nodes go here */
         },
 };
 
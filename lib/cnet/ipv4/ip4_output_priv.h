@@ -26,6 +26,7 @@ extern "C" {
 enum cne_node_ip4_output_next {
     IP4_OUTPUT_NEXT_PKT_DROP,    /**< Packet drop node. */
     IP4_OUTPUT_NEXT_ARP_REQUEST, /**< Packet ARP request node. */
+    IP4_OUTPUT_NEXT_FRAG,        /**< Fragmentation node, for packets larger than the MTU. */
     IP4_OUTPUT_NEXT_MAX,         /**< Number of next nodes of lookup node. */
 };
 
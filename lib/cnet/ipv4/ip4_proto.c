@@ -206,7 +206,7 @@ static struct cne_node_register ip4_proto_node = {
             [CNE_NODE_IP4_INPUT_PROTO_DROP] = PKT_DROP_NODE_NAME,
             [CNE_NODE_IP4_INPUT_PROTO_UDP]  = UDP_INPUT_NODE_NAME,
 #if CNET_ENABLE_TCP
-            [CNE_NODE_IP4_INPUT_PROTO_TCP] = TCP_INPUT_NODE_NAME,
+            [CNE_NODE_IP4_INPUT_PROTO_TCP] = TCP_GRO_NODE_NAME,
 #endif
         },
 };
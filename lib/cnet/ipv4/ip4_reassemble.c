@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cnet.h>                    // for cnet_add_instance, cnet, per_thread_cnet
+#include <cnet_stk.h>                // for stk_t, this_stk
+#include <stdint.h>                  // for uint16_t, uint64_t
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node_enqueue, cne_node_next_stream_move
+#include <cne_common.h>              // for __cne_unused
+#include <cne_cycles.h>              // for cne_rdtsc
+#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod
+#include <ip_frag.h>                 // for ip_frag_reassemble
+#include <cnet_ipv4.h>               // for ipv4_entry
+
+#include <cnet_node_names.h>
+#include "ip4_reassemble_priv.h"        // for IP4_REASSEMBLE_NEXT_PROTO
+
+/*
+ * Hold the fragments of the datagrams to this host in the reassembly table of the stack and
+ * pass the reassembled datagrams to the ip4_proto node. The invalid fragments and the ones
+ * not fitting in the table are freed by the table, the table statistics count them. The
+ * timed out fragments are freed by the reassembly timer of the stack.
+ */
+static uint16_t
+ip4_reassemble_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                            uint16_t nb_objs)
+{
+    struct ip_frag_tbl *tbl = this_stk->ipv4->frag_tbl;
+    pktmbuf_t **pkts        = (pktmbuf_t **)objs;
+    uint64_t tsc            = cne_rdtsc();
+    uint16_t n              = 0;
+
+    for (uint16_t i = 0; i < nb_objs; i++) {
+        struct cne_ipv4_hdr *ip = pktmbuf_mtod(pkts[i], struct cne_ipv4_hdr *);
+        pktmbuf_t *m            = ip_frag_reassemble(tbl, pkts[i], ip, tsc);
+
+        if (m)
+            pkts[n++] = m;
+    }
+
+    if (n)
+        cne_node_enqueue(graph, node, IP4_REASSEMBLE_NEXT_PROTO, objs, n);
+
+    return nb_objs;
+}
+
+static struct cne_node_register ip4_reassemble_node_base = {
+    .process = ip4_reassemble_node_process,
+    .name    = IP4_REASSEMBLE_NODE_NAME,
+
+    .nb_edges = IP4_REASSEMBLE_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP4_REASSEMBLE_NEXT_PROTO] = IP4_PROTO_NODE_NAME,
+        },
+};
+
+CNE_NODE_REGISTER(ip4_reassemble_node_base);
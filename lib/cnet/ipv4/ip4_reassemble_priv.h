@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __INCLUDE_IP4_REASSEMBLE_PRIV_H__
+#define __INCLUDE_IP4_REASSEMBLE_PRIV_H__
+
+/**
+ * @file ip4_reassemble_priv.h
+ *
+ * This API allows to do control path functions of ip4_* nodes
+ * like ip4_reassemble, ip4_input.
+ *
+ */
+#include <cne_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum ip4_reassemble_next {
+    IP4_REASSEMBLE_NEXT_PROTO, /**< Protocol node. */
+    IP4_REASSEMBLE_NEXT_MAX,   /**< Number of next nodes of reassembly node. */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_IP4_REASSEMBLE_PRIV_H__ */
@@ -45,7 +45,8 @@ __nl_route(struct netlink_info *info, struct nl_object *obj, int action)
     struct nl_addr *nexthop = NULL, *gate = NULL;
     struct in_addr ipaddr, netmask, gateway;
     struct netif *netif;
-    int ifindex = 0, rtype;
+    int ifindex = 0, rtype, nnh;
+    uint8_t weight;
 
     if (rtnl_route_get_family(route) != AF_INET)
         return;
@@ -106,6 +107,23 @@ __nl_route(struct netlink_info *info, struct nl_object *obj, int action)
 
         if (cnet_route4_insert(netif->netif_idx, &ipaddr, &netmask, NULL, RTM_INFINITY, 0) < 0)
             CNE_RET("Unable to insert route\n");
+
+        /* A multipath route spreads the flows over the gateways of its nexthops */
+        nnh = rtnl_route_get_nnexthops(route);
+        for (int i = 0; nnh > 1 && i < nnh; i++) {
+            struct rtnl_nexthop *nh = rtnl_route_nexthop_n(route, i);
+            struct nl_addr *nh_gate = rtnl_route_nh_get_gateway(nh);
+            struct in_addr nh_gateway;
+
+            if (!nh_gate || nl_addr_get_len(nh_gate) != sizeof(nh_gateway.s_addr))
+                continue;
+            memcpy(&nh_gateway.s_addr, nl_addr_get_binary_addr(nh_gate), sizeof(nh_gateway.s_addr));
+            nh_gateway.s_addr = be32toh(nh_gateway.s_addr);
+
+            weight = rtnl_route_nh_get_weight(nh);
+            if (cnet_route4_nhg_add(&ipaddr, &netmask, &nh_gateway, weight ?: 1) < 0)
+                CNE_WARN("Unable to add multipath gateway %d\n", i);
+        }
         break;
 
     case NL_ACT_CHANGE:
@@ -24,6 +24,7 @@ cnet_eth_node_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
 {
     struct cne_node_register *ip4_forward_node;
     struct cne_node_register *ip4_output_node;
+    struct cne_node_register *ip4_frag_node;
     struct eth_tx_node_main *tx_node_data;
     uint16_t port_id;
     struct cne_node_register *tx_node;
@@ -33,6 +34,7 @@ cnet_eth_node_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
 
     ip4_forward_node = ip4_forward_node_get();
     ip4_output_node  = ip4_output_node_get();
+    ip4_frag_node    = ip4_frag_node_get();
 
     tx_node_data = eth_tx_node_data_get();
     tx_node      = eth_tx_node_get();
@@ -83,6 +85,9 @@ cnet_eth_node_config(struct pkt_eth_node_config *conf, uint16_t nb_confs)
         /* Add this tx port node as next output to ip4_output_node */
         cne_node_edge_update(ip4_output_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
 
+        /* Add this tx port node as next output to ip4_frag_node */
+        cne_node_edge_update(ip4_frag_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
+
         /* Assuming edge id is the last one alloc'ed */
         if (ip4_forward_set_next(port_id, cne_node_edge_count(ip4_forward_node->id) - 1) < 0)
             goto err;
@@ -8,19 +8,49 @@
 #include "../chnl/chnl_priv.h"
 #include <cnet_chnl.h>         // for chnl_protocol_str, chnl, AF_INET
 #include <netinet/in.h>        // for INADDR_ANY, ntohs
+#include <stddef.h>            // for offsetof
+
+#include <cne_hash.h>        // for cne_hash_create, cne_hash_lookup_bulk_data
+#ifdef CNE_MACHINE_CPUFLAG_SSE4_2
+#include <cne_hash_crc.h>        // for cne_hash_crc
+
+#define DEFAULT_HASH_FUNC cne_hash_crc
+#else
+#include <cne_jhash.h>
+
+#define DEFAULT_HASH_FUNC cne_jhash
+#endif
 
 #include "cnet_pcb.h"
 #include "cne_inet.h"        // for CIN_PORT, CIN_CADDR, CIN_F...
 
+/* Address family of the PCB keys, the PCBs of a IPv6 channel use AF_INET6 */
+static inline uint16_t
+pcb_family(struct pcb_entry *pcb)
+{
+    return (pcb->ch && pcb->ch->ch_proto) ? pcb->ch->ch_proto->domain : AF_INET;
+}
+
+static inline void
+pcb_hkey_set(struct pcb_hkey *hkey, struct pcb_key *key, uint16_t family)
+{
+    hkey->faddr  = CIN_CADDR(&key->faddr);
+    hkey->laddr  = CIN_CADDR(&key->laddr);
+    hkey->fport  = CIN_PORT(&key->faddr);
+    hkey->lport  = CIN_PORT(&key->laddr);
+    hkey->family = family;
+    hkey->pad    = 0;
+}
+
+static inline bool
+pcb_hkey_connected(struct pcb_hkey *hkey)
+{
+    return hkey->faddr != INADDR_ANY && hkey->laddr != INADDR_ANY && hkey->fport && hkey->lport;
+}
+
 /*
- * Lookup a PCB in the given list to locate the matching PCB or near matching
- * PCB. The flag value denotes if the match is EXACT or a best match. With the
- * local (laddr) and foreign address (faddr) locate the matching or best
- * matching PCB data.
- *
- * Find a matching local, foreign and port address in the PCB list given. A
- * local copy of the local and foreign address is created for the compare when
- * not doing a exact match, but looking for the best match.
+ * Number of wildcards needed for the PCB to match the key, or -1 when it does
+ * not match.
  *
  *   PCB laddr |   laddr   |  Type
  *  -----------+-----------+--------
@@ -38,63 +68,184 @@
  *
  * The following code is mostly taken from 'TCP/IP Illustrated Volume 2' p726.
  */
-static inline struct pcb_entry *
-pcb_v4_lookup(struct pcb_entry **vec, struct pcb_key *key, int32_t flag)
+static inline int
+pcb_wildcard(struct pcb_hkey *p, struct pcb_hkey *k)
 {
-    struct pcb_entry *match = NULL;
-    struct pcb_entry *pcb;
-    int wildcard, matchwild = 3;
-    uint32_t laddr, faddr;
-    uint16_t lport, fport;
+    int wildcard = 0;
 
-    lport = CIN_PORT(&key->laddr);
-    fport = CIN_PORT(&key->faddr);
-    laddr = CIN_CADDR(&key->laddr);
-    faddr = CIN_CADDR(&key->faddr);
+    if (p->lport != k->lport || p->family != k->family)
+        return -1;
 
-    vec_foreach_ptr (pcb, vec) {
-        if (CIN_PORT(&pcb->key.laddr) != lport)
-            continue;
+    if (p->laddr != INADDR_ANY) {
+        if (k->laddr == INADDR_ANY)
+            wildcard++;
+        else if (p->laddr != k->laddr)
+            return -1;
+    } else {
+        if (k->laddr != INADDR_ANY)
+            wildcard++;
+    }
+
+    if (p->faddr != INADDR_ANY) {
+        if (k->faddr == INADDR_ANY)
+            wildcard++;
+        else if (p->faddr != k->faddr || p->fport != k->fport)
+            return -1;
+    } else {
+        if (k->faddr != INADDR_ANY)
+            wildcard++;
+    }
 
-        wildcard = 0;
+    return wildcard;
+}
 
-        if (CIN_CADDR(&pcb->key.laddr) != INADDR_ANY) {
-            if (laddr == INADDR_ANY)
-                wildcard++;
-            else if (CIN_CADDR(&pcb->key.laddr) != laddr)
-                continue;
-        } else {
-            if (laddr != INADDR_ANY)
-                wildcard++;
-        }
+/* Key of the wildcard table, the local address and port of the PCB */
+static inline void
+pcb_hkey_wild(struct pcb_hkey *w, const struct pcb_hkey *k, uint32_t laddr)
+{
+    memset(w, 0, sizeof(*w));
+    w->laddr  = laddr;
+    w->lport  = k->lport;
+    w->family = k->family;
+}
 
-        if (CIN_CADDR(&pcb->key.faddr) != INADDR_ANY) {
-            if (faddr == INADDR_ANY)
-                wildcard++;
-            else if (CIN_CADDR(&pcb->key.faddr) != faddr || CIN_PORT(&pcb->key.faddr) != fport)
-                continue;
-        } else {
-            if (faddr != INADDR_ANY)
-                wildcard++;
-        }
+/* Key of the port table, the local port of the PCB */
+static inline void
+pcb_hkey_port(struct pcb_hkey *p, const struct pcb_hkey *k)
+{
+    memset(p, 0, sizeof(*p));
+    p->lport  = k->lport;
+    p->family = k->family;
+}
+
+#define PCB_LINK(pcb, off) ((struct pcb_link *)((uint8_t *)(pcb) + (off)))
+
+/*
+ * Add a PCB to the chain of PCBs of a key, the hash table holds the first PCB
+ * of the chain and the PCBs are linked by the pcb_link at offset off.
+ */
+static int
+pcb_chain_add(struct cne_hash *tbl, const struct pcb_hkey *key, struct pcb_entry *pcb, size_t off)
+{
+    struct pcb_link *l     = PCB_LINK(pcb, off);
+    struct pcb_entry *head = NULL;
+
+    if (cne_hash_lookup_data(tbl, key, (void **)&head) < 0)
+        head = NULL;
+    if (cne_hash_add_key_data(tbl, key, pcb) < 0)
+        return -1;
+
+    l->prev = NULL;
+    l->next = head;
+    if (head)
+        PCB_LINK(head, off)->prev = pcb;
+    return 0;
+}
+
+/* Remove a PCB from the chain of PCBs of a key, replacing the existing key can not fail */
+static void
+pcb_chain_del(struct cne_hash *tbl, const struct pcb_hkey *key, struct pcb_entry *pcb, size_t off)
+{
+    struct pcb_link *l = PCB_LINK(pcb, off);
+
+    if (l->next)
+        PCB_LINK(l->next, off)->prev = l->prev;
+    if (l->prev)
+        PCB_LINK(l->prev, off)->next = l->next;
+    else if (l->next)
+        cne_hash_add_key_data(tbl, key, l->next);
+    else
+        cne_hash_del_key(tbl, key);
+    l->prev = l->next = NULL;
+}
+
+/* Best match of the key in the chain of PCBs of hkey, the current best is in match */
+static inline struct pcb_entry *
+pcb_best_match(struct cne_hash *tbl, const struct pcb_hkey *hkey, size_t off, struct pcb_hkey *k,
+               int32_t flag, int *matchwild, struct pcb_entry *match)
+{
+    struct pcb_entry *pcb;
+    int wildcard;
 
-        if (wildcard && (flag & EXACT_MATCH))
+    if (cne_hash_lookup_data(tbl, hkey, (void **)&pcb) < 0)
+        return match;
+
+    for (; pcb; pcb = PCB_LINK(pcb, off)->next) {
+        wildcard = pcb_wildcard(&pcb->hkey, k);
+        if (wildcard < 0 || (wildcard && (flag & EXACT_MATCH)))
             continue;
 
-        if (wildcard < matchwild) {
-            match     = pcb;
-            matchwild = wildcard;
-            if (matchwild == 0)
+        if (wildcard < *matchwild) {
+            match      = pcb;
+            *matchwild = wildcard;
+            if (wildcard == 0)
                 break; /* Exact match */
         }
     }
     return match;
 }
 
+/*
+ * Best match of the key in the wildcard PCBs bound to the local address of
+ * the key and in the ones bound to any address, with the port of the key.
+ */
 static inline struct pcb_entry *
-pcb_v6_lookup(struct pcb_entry **vec, struct pcb_key *key, int32_t flag)
+pcb_wild_match(struct pcb_hd *hd, struct pcb_hkey *k, int32_t flag, int *matchwild)
 {
-    CNE_SET_USED(vec);
+    struct pcb_entry *match = NULL;
+    struct pcb_hkey w;
+
+    if (k->laddr != INADDR_ANY) {
+        pcb_hkey_wild(&w, k, k->laddr);
+        match = pcb_best_match(hd->wtbl, &w, offsetof(struct pcb_entry, wlink), k, flag,
+                               matchwild, NULL);
+        if (*matchwild == 0)
+            return match;
+    }
+    pcb_hkey_wild(&w, k, INADDR_ANY);
+    return pcb_best_match(hd->wtbl, &w, offsetof(struct pcb_entry, wlink), k, flag, matchwild,
+                          match);
+}
+
+/*
+ * Lookup a PCB in the given list to locate the matching PCB or near matching
+ * PCB. The flag value denotes if the match is EXACT or a best match. With the
+ * local (laddr) and foreign address (faddr) locate the matching or best
+ * matching PCB data.
+ *
+ * A connected key is an exact match in the hash table or a best match in the
+ * wildcard PCBs of its local address and port. A key without a foreign address,
+ * from bind, can match any PCB with the same local port, connected or not, the
+ * PCBs of the port are chained in the port table.
+ */
+static struct pcb_entry *
+pcb_v4_lookup(struct pcb_hd *hd, struct pcb_key *key, int32_t flag)
+{
+    struct pcb_entry *pcb;
+    int matchwild = 3;
+    struct pcb_hkey k, p;
+
+    pcb_hkey_set(&k, key, AF_INET);
+
+    if (pcb_hkey_connected(&k)) {
+        if (cne_hash_lookup_data(hd->tbl, &k, (void **)&pcb) >= 0)
+            return pcb;
+        if (flag & EXACT_MATCH)
+            return NULL;
+    } else if (k.faddr == INADDR_ANY) {
+        pcb_hkey_port(&p, &k);
+        return pcb_best_match(hd->ptbl, &p, offsetof(struct pcb_entry, plink), &k, flag,
+                              &matchwild, NULL);
+    }
+
+    return pcb_wild_match(hd, &k, flag, &matchwild);
+}
+
+/* The PCB key only holds IPv4 addresses, IPv6 channels are not supported */
+static inline struct pcb_entry *
+pcb_v6_lookup(struct pcb_hd *hd, struct pcb_key *key, int32_t flag)
+{
+    CNE_SET_USED(hd);
     CNE_SET_USED(key);
     CNE_SET_USED(flag);
 
@@ -105,9 +256,161 @@ struct pcb_entry *
 cnet_pcb_lookup(struct pcb_hd *hd, struct pcb_key *key, int32_t flag)
 {
     if (flag & IPV6_TYPE)
-        return pcb_v6_lookup(hd->vec, key, flag);
+        return pcb_v6_lookup(hd, key, flag);
     else
-        return pcb_v4_lookup(hd->vec, key, flag);
+        return pcb_v4_lookup(hd, key, flag);
+}
+
+int
+cnet_pcb_lookup_bulk(struct pcb_hd *hd, struct pcb_key **keys, uint16_t nb_keys,
+                     struct pcb_entry **pcbs, int32_t flag)
+{
+    struct pcb_hkey hkeys[CNE_HASH_LOOKUP_BULK_MAX];
+    const void *kp[CNE_HASH_LOOKUP_BULK_MAX];
+    uint64_t hits;
+    int found = 0, matchwild;
+
+    if (flag & IPV6_TYPE) {
+        memset(pcbs, 0, nb_keys * sizeof(struct pcb_entry *));
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < nb_keys; i += CNE_HASH_LOOKUP_BULK_MAX) {
+        uint16_t n = CNE_MIN(nb_keys - i, CNE_HASH_LOOKUP_BULK_MAX);
+
+        for (uint16_t j = 0; j < n; j++) {
+            pcb_hkey_set(&hkeys[j], keys[i + j], AF_INET);
+            kp[j] = &hkeys[j];
+        }
+
+        hits = 0;
+        if (cne_hash_lookup_bulk_data(hd->tbl, kp, n, &hits, (void **)&pcbs[i]) < 0)
+            hits = 0;
+
+        /* The misses are listeners, bound or not connected PCBs */
+        for (uint16_t j = 0; j < n; j++) {
+            if (hits & (1ULL << j)) {
+                found++;
+                continue;
+            }
+            matchwild   = 3;
+            pcbs[i + j] = pcb_wild_match(hd, &hkeys[j], BEST_MATCH, &matchwild);
+            if (pcbs[i + j])
+                found++;
+        }
+    }
+    return found;
+}
+
+void
+cnet_pcb_unhash(struct pcb_entry *pcb)
+{
+    struct pcb_hd *hd = pcb->hd;
+    struct pcb_hkey key;
+    struct pcb_entry *p;
+
+    if (!hd || pcb->hashed == PCB_UNHASHED)
+        return;
+
+    if (pcb->hashed == PCB_HASHED_EXACT) {
+        /* A newer PCB with the same 4-tuple may have replaced this one */
+        if (cne_hash_lookup_data(hd->tbl, &pcb->hkey, (void **)&p) >= 0 && p == pcb)
+            cne_hash_del_key(hd->tbl, &pcb->hkey);
+    } else {
+        pcb_hkey_wild(&key, &pcb->hkey, pcb->hkey.laddr);
+        pcb_chain_del(hd->wtbl, &key, pcb, offsetof(struct pcb_entry, wlink));
+    }
+    pcb_hkey_port(&key, &pcb->hkey);
+    pcb_chain_del(hd->ptbl, &key, pcb, offsetof(struct pcb_entry, plink));
+
+    pcb->hashed = PCB_UNHASHED;
+    hd->gen++;
+}
+
+int
+cnet_pcb_update(struct pcb_entry *pcb)
+{
+    struct pcb_hkey key;
+    struct pcb_hd *hd;
+
+    if (!pcb || !pcb->hd)
+        return -1;
+    hd = pcb->hd;
+
+    if (pcb->hashed)
+        cnet_pcb_unhash(pcb);
+
+    pcb_hkey_set(&pcb->hkey, &pcb->key, pcb_family(pcb));
+    if (pcb->hkey.lport == 0)
+        return 0;
+
+    pcb_hkey_port(&key, &pcb->hkey);
+    if (pcb_chain_add(hd->ptbl, &key, pcb, offsetof(struct pcb_entry, plink)) < 0)
+        CNE_ERR_RET("Unable to hash PCB, port table full\n");
+
+    if (pcb_hkey_connected(&pcb->hkey)) {
+        if (cne_hash_add_key_data(hd->tbl, &pcb->hkey, pcb) < 0) {
+            pcb_chain_del(hd->ptbl, &key, pcb, offsetof(struct pcb_entry, plink));
+            CNE_ERR_RET("Unable to hash PCB, table full\n");
+        }
+        pcb->hashed = PCB_HASHED_EXACT;
+    } else {
+        struct pcb_hkey w;
+
+        pcb_hkey_wild(&w, &pcb->hkey, pcb->hkey.laddr);
+        if (pcb_chain_add(hd->wtbl, &w, pcb, offsetof(struct pcb_entry, wlink)) < 0) {
+            pcb_chain_del(hd->ptbl, &key, pcb, offsetof(struct pcb_entry, plink));
+            CNE_ERR_RET("Unable to hash PCB, wildcard table full\n");
+        }
+        pcb->hashed = PCB_HASHED_WILD;
+    }
+    hd->gen++;
+
+    return 0;
+}
+
+static struct cne_hash *
+pcb_hash_create(const char *name, const char *sfx, uint32_t entries)
+{
+    struct cne_hash_parameters params = {0};
+    char hname[CNE_HASH_NAMESIZE];
+
+    snprintf(hname, sizeof(hname), "%s%s", name, sfx);
+
+    params.name               = hname;
+    params.entries            = entries;
+    params.key_len            = sizeof(struct pcb_hkey);
+    params.hash_func          = DEFAULT_HASH_FUNC;
+    params.hash_func_init_val = 0;
+    params.socket_id          = -1;
+    params.extra_flag         = CNE_HASH_EXTRA_FLAGS_EXT_TABLE;
+
+    return cne_hash_create(&params);
+}
+
+int
+cnet_pcb_hd_create(struct pcb_hd *hd, const char *name, uint32_t entries)
+{
+    hd->tbl  = pcb_hash_create(name, "", entries);
+    hd->wtbl = pcb_hash_create(name, "_wild", entries);
+    hd->ptbl = pcb_hash_create(name, "_port", entries);
+    if (!hd->tbl || !hd->wtbl || !hd->ptbl) {
+        cnet_pcb_hd_destroy(hd);
+        CNE_ERR_RET("Unable to create PCB hash %s\n", name);
+    }
+
+    return 0;
+}
+
+void
+cnet_pcb_hd_destroy(struct pcb_hd *hd)
+{
+    cne_hash_free(hd->tbl);
+    hd->tbl = NULL;
+    cne_hash_free(hd->wtbl);
+    hd->wtbl = NULL;
+    cne_hash_free(hd->ptbl);
+    hd->ptbl = NULL;
 }
 
 static void
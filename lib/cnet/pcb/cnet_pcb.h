@@ -15,6 +15,7 @@
 #include <string.h>          // for NULL, memset
 
 #include "cne_common.h"        // for __cne_aligned, __cne_cache_aligned
+#include "cne_hash.h"          // for cne_hash, CNE_HASH_NAMESIZE
 #include "cne_log.h"           // for CNE_LOG, CNE_LOG_DEBUG
 #include "cne_vec.h"           // for cne_vec (ptr only), vec_add_ptr, vec_alloc_ptr, vec...
 #include "cnet_const.h"        // for BEST_MATCH
@@ -30,9 +31,38 @@ struct pcb_key {
     struct in_caddr laddr; /**< local IP address */
 } __cne_aligned(sizeof(void *));
 
+/**
+ * Key of a PCB in the hash table of the connected PCBs, the addresses and
+ * ports in network order.
+ */
+struct pcb_hkey {
+    uint32_t faddr;  /**< Foreign IP address */
+    uint32_t laddr;  /**< Local IP address */
+    uint16_t fport;  /**< Foreign port */
+    uint16_t lport;  /**< Local port */
+    uint16_t family; /**< Address family of the channel */
+    uint16_t pad;    /**< Zero */
+};
+
+enum {
+    PCB_UNHASHED = 0, /**< PCB is not found by lookups, no local port */
+    PCB_HASHED_EXACT, /**< PCB is in the hash table, all addresses and ports set */
+    PCB_HASHED_WILD,  /**< PCB is in the wildcard table, a listener or a bound PCB */
+};
+
+struct pcb_entry;
+
+/** Links of a PCB in the chain of PCBs sharing a key of the wildcard or port table */
+struct pcb_link {
+    struct pcb_entry *prev; /**< Previous PCB, NULL for the PCB in the hash table */
+    struct pcb_entry *next; /**< Next PCB or NULL */
+};
+
 struct netif;
 struct chnl;
 struct tcb_entry;
+struct tcp_cc_ops;
+struct pcb_hd;
 
 struct pcb_entry {
     TAILQ_ENTRY(pcb_entry) next; /**< Pointer to the next pcb_entry in a list */
@@ -40,22 +70,58 @@ struct pcb_entry {
     struct netif *netif;         /**< Netif pointer */
     struct chnl *ch;             /**< Channel pointer */
     struct tcb_entry *tcb;       /**< TCB pointer */
+    const struct tcp_cc_ops *cc; /**< TCP congestion control of the channel, NULL for default */
     uint16_t opt_flag;           /**< Option flags */
+    uint16_t gso_size;           /**< UDP_SEGMENT payload size of a datagram, zero if not set */
     uint8_t ttl;                 /**< Time to live */
     uint8_t tos;                 /**< TOS value */
     uint8_t closed;              /**< Closed flag */
     uint8_t ip_proto;            /**< IP protocol number */
+    uint8_t hashed;              /**< PCB_UNHASHED, PCB_HASHED_EXACT or PCB_HASHED_WILD */
+    struct pcb_hd *hd;           /**< PCB list the entry was allocated from */
+    struct pcb_hkey hkey;        /**< Key the entry is hashed with */
+    struct pcb_link wlink;       /**< Chain of the wildcard PCBs with the same local address */
+    struct pcb_link plink;       /**< Chain of the PCBs with the same local port */
 } __cne_cache_aligned;
 
 struct pcb_hd {
     struct pcb_entry **vec; /**< PCB entries */
+    struct cne_hash *tbl;   /**< Connected PCBs by 4-tuple */
+    struct cne_hash *wtbl;  /**< PCBs with a wildcard address or port by local address and port */
+    struct cne_hash *ptbl;  /**< All the hashed PCBs by local port, used by bind */
+    uint32_t gen;           /**< Incremented when a PCB is hashed or unhashed */
     uint16_t local_port;    /**< Local port number i.e. IP local port ID */
 };
 
+/**
+ * Remove a PCB from the lookup tables of its PCB list.
+ *
+ * @param pcb
+ *   The PCB entry to remove, nothing is done if it is not hashed.
+ */
+CNDP_API void cnet_pcb_unhash(struct pcb_entry *pcb);
+
+/**
+ * Add a PCB to the lookup tables of its PCB list, called after its key changed.
+ *
+ * A PCB with the local and foreign addresses and ports set goes to the hash
+ * table, a PCB with a local port and a wildcard address or foreign port goes
+ * to the wildcard table, others are not found by lookups. A PCB with a local
+ * port is also chained in the port table.
+ *
+ * @param pcb
+ *   The PCB entry to add, removed first from the tables if already hashed.
+ * @return
+ *   0 on success or -1 on error, a table is full and the PCB is not hashed.
+ */
+CNDP_API int cnet_pcb_update(struct pcb_entry *pcb);
+
 static inline void
 cnet_pcb_free(struct pcb_entry *pcb)
 {
     if (pcb) {
+        if (pcb->hashed)
+            cnet_pcb_unhash(pcb);
         memset(pcb, 0, sizeof(struct pcb_entry));
         pcb->closed   = 1;
         pcb->ip_proto = -1;
@@ -73,6 +139,7 @@ cnet_pcb_alloc(struct pcb_hd *hd, uint16_t proto)
 
     pcb->closed   = 0;
     pcb->ip_proto = proto;
+    pcb->hd       = hd;
 
     vec_add(hd->vec, pcb);
 
@@ -82,14 +149,8 @@ cnet_pcb_alloc(struct pcb_hd *hd, uint16_t proto)
 static inline void
 cnet_pcb_delete(struct pcb_hd *hd, struct pcb_entry *pcb)
 {
-    struct pcb_entry *p;
-
-    vec_foreach_ptr (p, hd->vec) {
-        if (p == pcb) {
-            cnet_pcb_free(pcb);
-            break;
-        }
-    }
+    if (pcb && pcb->hd == hd)
+        cnet_pcb_free(pcb);
 }
 
 /**
@@ -124,11 +185,62 @@ cnet_pcb_delete(struct pcb_hd *hd, struct pcb_entry *pcb)
  *        Zero | non-Zero  |  Best
  *        Zero |     Zero  |  Invalid
  *
+ * A key with all its addresses and ports set is found in the hash table of the
+ * connected PCBs, on a miss the wildcard PCBs bound to its local address and to
+ * any address are searched for the best match. A key without a foreign address,
+ * used when binding a local port, is compared to all the PCBs of its port.
+ *
+ * The PCB key only holds IPv4 addresses, an IPV6_TYPE lookup returns NULL.
+ *
  * @return
  *   NULL or the matching PCB pointer.
  */
 CNDP_API struct pcb_entry *cnet_pcb_lookup(struct pcb_hd *hd, struct pcb_key *key, int32_t flags);
 
+/**
+ * Lookup the PCBs of a burst of keys, as cnet_pcb_lookup() with BEST_MATCH.
+ *
+ * The keys are looked up in the hash table of the connected PCBs in bulk, the
+ * misses in the wildcard table.
+ *
+ * @param hd
+ *   A pointer to the PCB list head.
+ * @param keys
+ *   Array of pointers to the keys, all their addresses and ports set.
+ * @param nb_keys
+ *   Number of keys.
+ * @param pcbs
+ *   Array of nb_keys entries filled with the matching PCB or NULL.
+ * @param flags
+ *   0 for IPv4 keys, IPV6_TYPE keys are not supported and find no PCB.
+ * @return
+ *   Number of keys with a matching PCB.
+ */
+CNDP_API int cnet_pcb_lookup_bulk(struct pcb_hd *hd, struct pcb_key **keys, uint16_t nb_keys,
+                                  struct pcb_entry **pcbs, int32_t flags);
+
+/**
+ * Create the lookup tables of a PCB list.
+ *
+ * @param hd
+ *   A pointer to the PCB list head.
+ * @param name
+ *   Name of the hash tables, unique per stack and protocol.
+ * @param entries
+ *   Maximum number of PCBs in each table.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cnet_pcb_hd_create(struct pcb_hd *hd, const char *name, uint32_t entries);
+
+/**
+ * Free the lookup tables of a PCB list.
+ *
+ * @param hd
+ *   A pointer to the PCB list head.
+ */
+CNDP_API void cnet_pcb_hd_destroy(struct pcb_hd *hd);
+
 /**
  * @brief Dump out the PCB information.
  *
@@ -11,6 +11,7 @@
 #include <endian.h>              // for be32toh
 #include <stdio.h>               // for printf, NULL
 #include <cne_fib.h>             // for
+#include <cne_fib_nhg.h>         // for cne_fib_nhg_create, cne_fib_nhg_member_add
 #include <ip4_node_api.h>        // for
 
 #include "cnet_fib_info.h"
@@ -45,6 +46,7 @@ cnet_route4_insert(int netdev_idx, struct in_addr *dst, struct in_addr *netmask,
         rt->netif_idx      = netdev_idx;
         rt->metric         = metric;
         rt->timo           = timo;
+        rt->nhg            = NULL;
 
         idx = fib_info_alloc(fi, rt);
         if (idx < 0)
@@ -85,7 +87,13 @@ cnet_route4_delete(struct in_addr *ipaddr)
 
         if (fib_info_free(fi, (uint32_t)nexthop) != rt)
             CNE_WARN("Freed entry does not match\n");
-        cnet_route4_free(rt);
+
+        if (rt->nhg)
+            __atomic_fetch_sub(&this_cnet->rt4_nhg_cnt, 1, __ATOMIC_RELAXED);
+
+        /* Graph threads could still be using the entry */
+        if (fib_info_defer_free(fi, rt) == 0)
+            cnet_route4_free(rt);
     }
 
     return 0;
@@ -131,6 +139,10 @@ cnet_route4_alloc(void)
 void
 cnet_route4_free_bulk(struct rt4_entry **entry, int n)
 {
+    for (int i = 0; i < n; i++) {
+        cne_fib_nhg_free(entry[i]->nhg);
+        entry[i]->nhg = NULL;
+    }
     mempool_put_bulk(this_cnet->rt4_obj, (void **)entry, n);
 }
 
@@ -140,6 +152,132 @@ cnet_route4_free(struct rt4_entry *entry)
     cnet_route4_free_bulk(&entry, 1);
 }
 
+struct route4_match {
+    struct in_addr dst;
+    struct in_addr netmask;
+    struct rt4_entry *rt;
+};
+
+static int
+route4_match(struct rt4_entry *rt, struct route4_match *m)
+{
+    if (rt->netmask.s_addr == m->netmask.s_addr &&
+        (rt->nexthop.s_addr & rt->netmask.s_addr) == (m->dst.s_addr & m->netmask.s_addr)) {
+        m->rt = rt;
+        return -1; /* Stop the walk */
+    }
+    return 0;
+}
+
+/* Find the route of a prefix, not the longest match of an address */
+static struct rt4_entry *
+route4_find(struct in_addr *dst, struct in_addr *netmask)
+{
+    struct route4_match m = {.dst = *dst, .netmask = *netmask};
+
+    fib_info_foreach(this_cnet->rt4_finfo, (fib_func_t)route4_match, &m);
+
+    return m.rt;
+}
+
+int
+cnet_route4_nhg_add(struct in_addr *dst, struct in_addr *netmask, struct in_addr *gate,
+                    uint32_t weight)
+{
+    char name[CNE_FIB_NHG_NAMESIZE];
+    struct cne_fib_nhg *nhg;
+    struct rt4_entry *rt;
+
+    if (!dst || !netmask || !gate || gate->s_addr == 0 || weight == 0)
+        CNE_ERR_RET("Invalid route or gateway\n");
+
+    rt = route4_find(dst, netmask);
+    if (!rt)
+        CNE_ERR_RET("Route not found\n");
+
+    nhg = rt->nhg;
+    if (!nhg) {
+        snprintf(name, sizeof(name), "rt4-%08x/%u", dst->s_addr, cne_prefixbits(netmask->s_addr));
+
+        /* No gateway up, the packets are forwarded as on a route without gateways */
+        nhg = cne_fib_nhg_create(name, 0, 0);
+        if (!nhg)
+            CNE_ERR_RET("Unable to create nexthop group %s\n", name);
+
+        /* The gateway of the route is the first path */
+        if (rt->gateway.s_addr && cne_fib_nhg_member_add(nhg, rt->gateway.s_addr, 1) < 0) {
+            cne_fib_nhg_free(nhg);
+            CNE_ERR_RET("Unable to add gateway to nexthop group %s\n", name);
+        }
+    }
+
+    if (cne_fib_nhg_member_add(nhg, gate->s_addr, weight) < 0) {
+        if (!rt->nhg)
+            cne_fib_nhg_free(nhg);
+        CNE_ERR_RET("Unable to add gateway to nexthop group\n");
+    }
+
+    if (!rt->nhg) {
+        __atomic_store_n(&rt->nhg, nhg, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&this_cnet->rt4_nhg_cnt, 1, __ATOMIC_RELAXED);
+    }
+
+    return 0;
+}
+
+int
+cnet_route4_nhg_del(struct in_addr *dst, struct in_addr *netmask, struct in_addr *gate)
+{
+    struct rt4_entry *rt;
+
+    if (!dst || !netmask || !gate)
+        CNE_ERR_RET("Invalid route or gateway\n");
+
+    rt = route4_find(dst, netmask);
+    if (!rt || !rt->nhg)
+        CNE_ERR_RET("ECMP route not found\n");
+
+    if (cne_fib_nhg_member_del(rt->nhg, gate->s_addr) < 0)
+        CNE_ERR_RET("Gateway not found in nexthop group\n");
+
+    return 0;
+}
+
+struct route4_gate_state {
+    struct in_addr gate;
+    bool up;
+    int count;
+};
+
+static int
+route4_gate_state(struct rt4_entry *rt, struct route4_gate_state *gs)
+{
+    if (rt->nhg && cne_fib_nhg_member_set_state(rt->nhg, gs->gate.s_addr, gs->up) == 0)
+        gs->count++;
+    return 0;
+}
+
+int
+cnet_route4_nhg_set_state(struct in_addr *gate, bool up)
+{
+    struct route4_gate_state gs = {.up = up};
+
+    if (!gate)
+        CNE_ERR_RET("Invalid gateway\n");
+    gs.gate = *gate;
+
+    if (fib_info_foreach(this_cnet->rt4_finfo, (fib_func_t)route4_gate_state, &gs) < 0)
+        return -1;
+
+    return gs.count;
+}
+
+static void
+route4_qsbr_free(void *obj)
+{
+    cnet_route4_free(obj);
+}
+
 void
 cne_route4_timer(void)
 {
@@ -189,6 +327,9 @@ cnet_route4_create(struct cnet *cnet, uint32_t num_rules, uint32_t num_tbl8s)
 
     cnet->rt4_finfo = fi;
 
+    if (cnet->qsbr && fib_info_qsbr_add(fi, cnet->qsbr, route4_qsbr_free, "rt4-dq") < 0)
+        CNE_ERR_GOTO(err, "Unable to add QSBR to route FIB\n");
+
     mcfg.objcnt   = num_rules;
     mcfg.objsz    = sizeof(struct rt4_entry);
     mcfg.cache_sz = 16;
@@ -235,6 +376,18 @@ route4_dump(struct rt4_entry *rt, void *arg __cne_unused)
                inet_ntop4(ip3, sizeof(ip3), &gate, NULL) ?: "Invalid IP", rt->metric, rt->timo,
                netif->ifname);
 
+    if (rt->nhg) {
+        for (int i = 0; i < rt->nhg->nb_members; i++) {
+            struct cne_fib_nhg_member *m = &rt->nhg->members[i];
+
+            gate.s_addr = htobe32((uint32_t)m->next_hop);
+            cne_printf("    [magenta]ECMP Gateway [orange]%-17s [magenta]Weight [cyan]%u "
+                       "[magenta]Buckets [cyan]%u %s[]\n",
+                       inet_ntop4(ip3, sizeof(ip3), &gate, NULL) ?: "Invalid IP", m->weight,
+                       m->nb_buckets, m->up ? "[green]up" : "[red]down");
+        }
+    }
+
     return 0;
 }
 
@@ -12,6 +12,7 @@
 
 #include <net/ethernet.h>        // for ether_addr
 #include <stdint.h>              // for uint16_t, uint8_t, uint32_t
+#include <stdbool.h>             // for bool
 #include <sys/queue.h>           // for TAILQ_ENTRY
 
 #include "cne_common.h"        // for __cne_cache_aligned
@@ -21,6 +22,7 @@
 #include "cnet_route.h"
 
 struct netif;
+struct cne_fib_nhg;
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -37,6 +39,7 @@ struct rt4_entry {
     uint16_t netif_idx;     /**< Netif index value */
     uint16_t timo;          /**< Timeout value */
     uint16_t metric;        /**< Metric value */
+    struct cne_fib_nhg *nhg; /**< Gateways of an ECMP route or NULL */
 } __cne_cache_aligned;
 
 /**
@@ -152,6 +155,57 @@ CNDP_API int cnet_route4_insert(int netif_idx, struct in_addr *dst, struct in_ad
  */
 CNDP_API int cnet_route4_delete(struct in_addr *ipaddr);
 
+/**
+ * @brief Add a gateway to an IPv4 route, the route becomes an ECMP route.
+ *
+ * The forward node spreads the flows of the route over its gateways with a hash
+ * of the packet 5-tuple, the packets of a flow always use the same gateway. The
+ * route must have been added with cnet_route4_insert().
+ *
+ * @param dst
+ *   The destination IPv4 address of the route.
+ * @param netmask
+ *   The destination IPv4 netmask of the route.
+ * @param gate
+ *   The IPv4 gateway address to add.
+ * @param weight
+ *   Relative weight of the gateway, greater than 0.
+ * @return
+ *   -1 on error or 0 on success.
+ */
+CNDP_API int cnet_route4_nhg_add(struct in_addr *dst, struct in_addr *netmask,
+                                 struct in_addr *gate, uint32_t weight);
+
+/**
+ * @brief Remove a gateway from an ECMP IPv4 route.
+ *
+ * @param dst
+ *   The destination IPv4 address of the route.
+ * @param netmask
+ *   The destination IPv4 netmask of the route.
+ * @param gate
+ *   The IPv4 gateway address to remove.
+ * @return
+ *   -1 on error or 0 on success.
+ */
+CNDP_API int cnet_route4_nhg_del(struct in_addr *dst, struct in_addr *netmask,
+                                 struct in_addr *gate);
+
+/**
+ * @brief Mark a gateway up or down in all the ECMP IPv4 routes using it.
+ *
+ * The flows of a gateway going down move to the other gateways of each route,
+ * the flows of the other gateways keep their path.
+ *
+ * @param gate
+ *   The IPv4 gateway address.
+ * @param up
+ *   True to mark the gateway up, false to mark it down.
+ * @return
+ *   -1 on error or the number of routes updated.
+ */
+CNDP_API int cnet_route4_nhg_set_state(struct in_addr *gate, bool up);
+
 /**
  * @brief Get a bulk of route entries using the nexthop index values.
  *
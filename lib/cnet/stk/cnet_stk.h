@@ -75,6 +75,9 @@ enum {
     TCP_TIMEOUT_ENABLED    = 0x00000001, /**< Enable TCP Timeouts */
     RFC1323_TSTAMP_ENABLED = 0x00004000, /**< Enable RFC1323 Timestamp */
     RFC1323_SCALE_ENABLED  = 0x00008000, /**< Enable RFC1323 window scaling */
+    RFC2018_SACK_ENABLED   = 0x00010000, /**< Enable RFC2018 Selective Acknowledgment */
+    TCP_LSO_ENABLED        = 0x00020000, /**< Enable TCP large send using GSO */
+    TCP_GRO_ENABLED        = 0x00040000, /**< Enable merging received TCP segments */
 };
 
 static inline uint64_t
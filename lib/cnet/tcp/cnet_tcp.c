@@ -46,8 +46,10 @@
 #include <cnet_ip_common.h>        // for ip_info
 #include <cnet_meta.h>             // for cnet_metadata
 #include <cnet_tcp_chnl.h>         // for cnet_drop_acked_data, cnet_tcp_chnl_scal...
+#include <gso.h>                   // for GSO_MAX_SEGS
 #include <endian.h>                // for be16toh, htobe32, htobe16, be32toh
 #include <errno.h>                 // for errno, ECONNREFUSED, ECONNRESET, ETIMEDOUT
+#include <inttypes.h>              // for PRIu64
 #include <netinet/in.h>            // for ntohs, IPPROTO_TCP, IN_CLASSD, ntohl
 #include <pthread.h>               // for pthread_cond_signal, pthread_cond_wait
 #include <stdlib.h>                // for free, calloc, rand
@@ -70,6 +72,10 @@
 #include <cnet_fib_info.h>
 #include <cnet_node_names.h>
 #include <tcp_input_priv.h>
+#include <tcp_gro_priv.h>
+#include <tcp_snd_priv.h>
+#include <tcp_sack_priv.h>
+#include <tcp_reass_priv.h>
 #include <tcp_output_priv.h>
 #include <cne_mutex_helper.h>
 
@@ -83,7 +89,8 @@ static int tcp_destroy(void *_stk);
 static int tcb_cleanup(struct tcb_entry *tcb);
 static void tcp_update_acked_data(struct seg_entry *seg, struct tcb_entry *tcb);
 static int32_t tcp_send_options(struct tcb_entry *tcb, uint8_t *sp, uint8_t flags_n);
-static int tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp);
+static int tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp, bool sack, bool lso,
+                    bool gro);
 
 const char *tcb_in_states[] = TCP_INPUT_STATES;
 
@@ -108,6 +115,7 @@ static inline void
 free_seg(struct seg_entry *seg)
 {
     if (seg) {
+        tcp_gro_free(seg->gro); /* Merged segments not taken by the receive buffer */
         memset(seg, 0, sizeof(struct seg_entry));
         mempool_put(this_stk->seg_objs, (void *)seg);
     }
@@ -227,35 +235,6 @@ cnet_tcp_dump(const char *msg, struct cne_tcp_hdr *tcp)
                be16toh(tcp->rx_win), be16toh(tcp->cksum), be16toh(tcp->tcp_urp));
 }
 
-/*
- * Set the congestion window for slow-start given the valid <tcb>, by looking at
- * the tcb->pcb->faddr and determine the connection is for a local subnet. When
- * the connection is on the local subnet, the code will select a larger
- * congestion window value else it picks the senders max segment size.
- */
-static inline void
-tcp_set_CWND(struct tcb_entry *tcb)
-{
-    /*
-     * Setup for slow-start congestion window size.
-     *
-     * For a local address we have a large cwnd value else one segment.
-     *
-     * RFC2581: pg 4
-     * We note that a non-standard, experimental TCP extension allows that a
-     * TCP MAY use a large initial window (IW), as define in the equation 1
-     * [AFP98].
-     *
-     *      IW = min( 4 * SMSS, max( 2 * SMSS, 4380 bytes))     [1]
-     */
-    tcb->snd_cwnd = tcb->max_mss;
-    if (tcb->pcb != NULL) {
-        if (cnet_netif_match_subnet(&tcb->pcb->key.faddr.cin_addr))
-            tcb->snd_cwnd =
-                CNE_MIN((4 * tcb->max_mss), CNE_MAX((2 * tcb->max_mss), TCP_INITIAL_CWND));
-    }
-}
-
 /*
  * Set the correct Sender MSS value for the connection into the struct tcb.max_mss
  * variable.
@@ -313,6 +292,9 @@ cnet_tcb_new(struct pcb_entry *pcb)
     tcb->tflags = (stk->gflags & RFC1323_SCALE_ENABLED) != 0 ? TCBF_REQ_SCALE : 0;
     tcb->tflags |= (stk->gflags & RFC1323_TSTAMP_ENABLED) != 0 ? TCBF_REQ_TSTAMP : 0;
 
+    /* Enable RFC2018 (TCP Selective Acknowledgment Options), if requested. */
+    tcb->tflags |= (stk->gflags & RFC2018_SACK_ENABLED) != 0 ? TCBF_REQ_SACK : 0;
+
     tcb->srtt   = TCP_SRTTBASE_TV;
     tcb->rttvar = stk->tcp->default_RTT * (TCP_SLOWHZ << TCP_RTTVAR_SHIFT);
     tcb->rttmin = TCP_MIN_TV;
@@ -322,17 +304,15 @@ cnet_tcb_new(struct pcb_entry *pcb)
     /* Set our MSS to the normal large value and peers value to minimum. */
     tcp_set_MSS(tcb, TCP_MAX_MSS);
 
-    tcp_set_CWND(tcb);
-
-    /* Normally set to TCP_MAXWIN as per RFC2001 */
-    tcb->snd_ssthresh = tcb->snd_cwnd << 1;
-
     /* Link the PCB and TCB together */
     tcb->pcb   = pcb;
     pcb->tcb   = tcb;
     tcb->tcp   = stk->tcp;
     tcb->netif = pcb->netif;
 
+    /* Use the algorithm set with the TCP_CONGESTION option before the TCB existed */
+    tcp_cc_select(tcb, (pcb->cc) ? pcb->cc : tcp_cc_find(TCP_CC_DEFAULT));
+
     /* Set the new send ISS value. */
     tcp_send_seq_set(tcb, 7);
 
@@ -408,11 +388,21 @@ tcp_send_segment(struct tcb_entry *tcb, struct seg_entry *seg)
 
         /* Use the interface attached to the route for the source address */
         pcb->key.laddr.cin_addr.s_addr = htobe32(nif->ip4_addrs[k].ip.s_addr);
+        if (cnet_pcb_update(pcb) < 0) {
+            /* Keep the PCB reachable with the wildcard address, the next send retries */
+            pcb->key.laddr.cin_addr.s_addr = 0;
+            if (cnet_pcb_update(pcb) < 0)
+                CNE_ERR("Unable to rehash the PCB\n");
+            pktmbuf_free(mbuf);
+            CNE_ERR_RET("Unable to hash the PCB\n");
+        }
     }
 
     /* Clear the send Ack Now bit, if an ACK is present. */
-    if (is_set(seg->flags, TCP_ACK))
+    if (is_set(seg->flags, TCP_ACK)) {
         tcb->tflags &= ~(TCBF_ACK_NOW | TCBF_DELAYED_ACK);
+        tcp_timer_stop(tcb, TCPT_DELACK);
+    }
 
     /* Always clear the force tx and need output flags. */
     tcb->tflags &= ~TCBF_FORCE_TX;
@@ -457,51 +447,31 @@ tcp_set_persist(struct tcb_entry *tcb)
     int32_t t = (tcb->srtt + (tcb->rttvar << 2));
 
     /* Divide by 500 ms to get the correct persist timer value. */
-    tcb->timers[TCPT_PERSIST] = tcp_range_set(((t * tcp_backoff[tcb->rxtshift]) / 500) >> 3,
-                                              TCP_PERSMIN_TV, TCP_PERSMAX_TV);
+    tcp_timer_set(tcb, TCPT_PERSIST,
+                  tcp_range_set(((t * tcp_backoff[tcb->rxtshift]) / 500) >> 3, TCP_PERSMIN_TV,
+                                TCP_PERSMAX_TV));
 
     if (tcb->rxtshift < TCP_MAXRXTSHIFT)
         tcb->rxtshift++;
 }
 
-/* skip to the offset in the list and copy the data to the buffer. */
-static int
-tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
+/*
+ * Large send, return the length of data to copy into the mbuf when more than one segment of
+ * <segsz> bytes is ready to send. The packet is split into segments by GSO in front of the
+ * port, the length is trimmed to whole segments unless all the <avail> data fits.
+ */
+static inline int32_t
+tcp_lso_len(pktmbuf_t *m, int32_t avail, int32_t segsz, uint16_t optlen)
 {
-    pktmbuf_t *m;
-    uint32_t total = 0, cnt;
-    int i          = 0;
-
-    if (!stk_lock())
-        CNE_ERR_RET("Unable to acquire mutex\n");
-
-    m = vec_at_index(cb->cb_vec, i++);
+    int32_t len = CNE_MIN(avail, (int32_t)pktmbuf_tailroom(m));
 
-    /* skip to the offset location */
-    while (m && off) {
-        cnt = pktmbuf_data_len(m);
-
-        if (off < cnt)
-            break;
-
-        off -= cnt;
-        m = vec_at_index(cb->cb_vec, i++);
-    }
+    len = CNE_MIN(len, GSO_MAX_SEGS * segsz);
+    len = CNE_MIN(len, (int32_t)(UINT16_MAX - sizeof(struct cne_ipv4_hdr) -
+                                 sizeof(struct cne_tcp_hdr) - optlen));
+    if (len < avail)
+        len -= len % segsz;
 
-    while (m && len > 0) {
-        cnt = CNE_MIN(pktmbuf_data_len(m) - off, (uint32_t)len);
-
-        memcpy(buf, pktmbuf_mtod_offset(m, char *, off), cnt);
-
-        total += cnt;
-        len -= cnt;
-        buf += cnt;
-        off = 0;
-        m   = vec_at_index(cb->cb_vec, i++);
-    }
-
-    stk_unlock();
-    return total;
+    return CNE_MAX(len, segsz);
 }
 
 /*
@@ -547,7 +517,7 @@ tcp_output(struct tcb_entry *tcb)
          * in [AFP98] defines RW = min(IW, cwnd), with the definition of IW
          * adjusted per equation (1) above.
          */
-        if (tcb->idle >= tcb->rxtcur)
+        if (tcb_idle(tcb) >= (uint32_t)tcb->rxtcur)
             tcb->snd_cwnd =
                 CNE_MIN((4 * tcb->max_mss), CNE_MAX((2 * tcb->max_mss), TCP_INITIAL_CWND));
 #endif /* CNET_TCP_FAST_REXMIT */
@@ -557,7 +527,7 @@ tcp_output(struct tcb_entry *tcb)
         struct seg_entry tx_seg;
         struct seg_entry *seg = &tx_seg;
         uint32_t off;
-        int32_t len;
+        int32_t len, avail, segsz;
         uint32_t win;
         seq_t prev_rcv_adv;
 
@@ -593,8 +563,8 @@ tcp_output(struct tcb_entry *tcb)
                     win = 1; /* Send at least one byte */
                 } else {
                     /* Turn off the persistent timer */
-                    tcb->timers[TCPT_PERSIST] = 0;
-                    tcb->rxtshift             = 0;
+                    tcp_timer_stop(tcb, TCPT_PERSIST);
+                    tcb->rxtshift = 0;
                 }
             }
 
@@ -633,11 +603,14 @@ tcp_output(struct tcb_entry *tcb)
 
                 if (win == 0) {
                     /* When win is zero, we are done doing retransmits. */
-                    tcb->timers[TCPT_REXMT] = 0;
-                    tcb->snd_nxt            = tcb->snd_una;
+                    tcp_timer_stop(tcb, TCPT_REXMT);
+                    tcb->snd_nxt = tcb->snd_una;
                 }
             }
 
+            /* Data ready to send, used by large send */
+            avail = len;
+
             if (len > tcb->max_mss) {
                 CNE_DEBUG("len [cyan]%d[] > [cyan]%d[] max_mss, vec_len([orange]%d[])\n", len,
                           tcb->max_mss, vec_len(ch->ch_snd.cb_vec));
@@ -765,38 +738,70 @@ tcp_output(struct tcb_entry *tcb)
 
         /* Create the options and obtain the options length */
         seg->optlen = tcp_send_options(tcb, seg->opts, seg->flags);
+        segsz       = tcb->max_mss - seg->optlen;
 
-        if (len > (tcb->max_mss - seg->optlen)) {
-            len      = tcb->max_mss - seg->optlen;
+        if (len > segsz) {
+            len      = segsz;
             sendalot = true;
 
             /* Turn off the FIN if it is set */
             seg->flags &= ~TCP_FIN;
         }
 
-        if (pktdev_buf_alloc(seg->lport, &seg->mbuf, 1) <= 0) {
-            CNE_WARN("pktmbuf allocation from lport %d failed id %d\n", seg->lport, cne_id());
-            return -1;
+        if (len) {
+            uint16_t hdrlen = sizeof(struct cne_ether_hdr) + sizeof(struct cne_ipv4_hdr) +
+                              sizeof(struct cne_tcp_hdr) + seg->optlen;
+            int32_t mlen    = len;
+
+            /* Send the data from the send buffer mbuf when possible, else copy it */
+            seg->mbuf = tcp_mbuf_ref(&ch->ch_snd, off, &mlen, hdrlen);
+            if (seg->mbuf && mlen < len) {
+                len      = mlen;
+                sendalot = true;
+
+                /* Turn off the FIN if it is set */
+                seg->flags &= ~TCP_FIN;
+            }
         }
 
-        seg->mbuf->userptr = tcb->pcb;
+        if (seg->mbuf) {
+            INC_TCP_STAT(snd_zcopy);
+            CNE_DEBUG("Send [orange]%4d[] bytes in place from the send buffer\n", len);
+        } else {
+            if (pktdev_buf_alloc(seg->lport, &seg->mbuf, 1) <= 0) {
+                CNE_WARN("pktmbuf allocation from lport %d failed id %d\n", seg->lport, cne_id());
+                return -1;
+            }
 
-        /* move the starting offset to account for headers */
-        pktmbuf_data_off(seg->mbuf) += sizeof(struct cne_tcp_hdr) + seg->optlen +
-                                       sizeof(struct cne_ipv4_hdr) + sizeof(struct ether_addr);
+            /* move the starting offset to account for headers */
+            pktmbuf_data_off(seg->mbuf) += sizeof(struct cne_tcp_hdr) + seg->optlen +
+                                           sizeof(struct cne_ipv4_hdr) + sizeof(struct ether_addr);
 
-        /* Make sure the headers are zero */
-        memset(pktmbuf_mtod(seg->mbuf, char *), 0,
-               sizeof(struct cne_tcp_hdr) + seg->optlen + sizeof(struct cne_ipv4_hdr) +
-                   sizeof(struct ether_addr));
+            /* Make sure the headers are zero */
+            memset(pktmbuf_mtod(seg->mbuf, char *), 0,
+                   sizeof(struct cne_tcp_hdr) + seg->optlen + sizeof(struct cne_ipv4_hdr) +
+                       sizeof(struct ether_addr));
 
-        if (len) {
-            len = tcp_mbuf_copydata(&ch->ch_snd, off, len, pktmbuf_mtod(seg->mbuf, char *));
+            if (len) {
+                if (len == segsz && avail > len && is_set(this_stk->gflags, TCP_LSO_ENABLED))
+                    len = tcp_lso_len(seg->mbuf, avail, segsz, seg->optlen);
 
-            pktmbuf_append(seg->mbuf, len); /* Update length */
-            CNE_DEBUG("Add [orange]%4d[] bytes to the packet buffer\n", len);
+                len = tcp_mbuf_copydata(&ch->ch_snd, off, len, pktmbuf_mtod(seg->mbuf, char *));
+
+                pktmbuf_append(seg->mbuf, len); /* Update length */
+                CNE_DEBUG("Add [orange]%4d[] bytes to the packet buffer\n", len);
+
+                /* Let GSO split the packet into segsz segments before it is transmitted */
+                if (len > segsz) {
+                    seg->mbuf->ol_flags |= CNE_MBUF_F_TX_TCP_SEG | CNE_MBUF_F_TX_IPV4;
+                    seg->mbuf->tso_segsz = segsz;
+                    INC_TCP_STAT(snd_lso);
+                }
+            }
         }
 
+        seg->mbuf->userptr = tcb->pcb;
+
         /* Make sure if sending a FIN does not advertise a new sequence number */
         if (is_set(seg->flags, TCP_FIN) && is_set(tcb->tflags, TCBF_SENT_FIN) &&
             (tcb->snd_nxt == tcb->snd_max)) {
@@ -863,10 +868,10 @@ tcp_output(struct tcb_entry *tcb)
             }
 
             if ((tcb->timers[TCPT_REXMT] == 0) && (tcb->snd_nxt != tcb->snd_una)) {
-                tcb->timers[TCPT_REXMT] = tcb->rxtcur;
+                tcp_timer_set(tcb, TCPT_REXMT, tcb->rxtcur);
                 if (tcb->timers[TCPT_PERSIST] != 0) {
-                    tcb->timers[TCPT_PERSIST] = 0;
-                    tcb->rxtshift             = 0;
+                    tcp_timer_stop(tcb, TCPT_PERSIST);
+                    tcb->rxtshift = 0;
                 }
             }
         } else if (seqGT(tcb->snd_nxt + len, tcb->snd_max))
@@ -1148,10 +1153,35 @@ tcp_do_options(struct seg_entry *seg, uint8_t *opts)
             if ((opts[1] + opts) > opt_end)
                 return -1;
 
-            if (opts[1] == TCP_OPT_SACK_LEN)
+            /* Only grab the SACK permitted option on a SYN packet */
+            if ((opts[1] == TCP_OPT_SACK_LEN) && is_set(seg->flags, TCP_SYN))
                 seg->sflags |= SEG_SACK_PERMIT;
             break;
 
+        case TCP_OPT_SACK:
+            if ((opts[1] + opts) > opt_end)
+                return -1;
+
+            /* The blocks are only used when the ACK is valid RFC2018 pg 3 */
+            if (((opts[1] - 2) % TCP_OPT_SACK_BLK) || is_clr(seg->flags, TCP_ACK))
+                break;
+
+            seg->nb_sacks = 0;
+            for (int i = 2; i < opts[1] && seg->nb_sacks < TCP_MAX_SACK; i += TCP_OPT_SACK_BLK) {
+                struct tcp_sack_blk *blk = &seg->sacks[seg->nb_sacks];
+
+                memcpy(&blk->start, &opts[i], sizeof(seq_t));
+                memcpy(&blk->end, &opts[i + 4], sizeof(seq_t));
+                blk->start = ntohl(blk->start);
+                blk->end   = ntohl(blk->end);
+
+                if (seqLT(blk->start, blk->end))
+                    seg->nb_sacks++;
+            }
+            if (seg->nb_sacks)
+                seg->sflags |= SEG_SACK_PRESENT;
+            break;
+
         case TCP_OPT_TSTAMP:
             if ((opts[1] + opts) > opt_end)
                 CNE_ERR_RET("Option Length Invalid opts %u\n", *opts);
@@ -1285,7 +1315,7 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
                   tcb_in_states[TCPS_SYN_RCVD]);
 
         /* Start up the TIMER for SYN_RCVD state */
-        tcb->timers[TCPT_KEEP] = TCP_KEEP_INIT_TV;
+        tcp_timer_set(tcb, TCPT_KEEP, TCP_KEEP_INIT_TV);
         break;
 
     case TCPS_ESTABLISHED:
@@ -1315,8 +1345,8 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
             }
         }
 
-        tcb->idle              = 0;
-        tcb->timers[TCPT_KEEP] = tcb->tcp->keep_idle;
+        tcb_idle_reset(tcb);
+        tcp_timer_set(tcb, TCPT_KEEP, tcb->tcp->keep_idle);
 
         if ((tcb->tflags & (TCBF_RCVD_SCALE | TCBF_REQ_SCALE)) ==
             (TCBF_RCVD_SCALE | TCBF_REQ_SCALE)) {
@@ -1337,7 +1367,7 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
          * the TIME_WAIT timeout.
          */
         tcb_kill_timers(tcb);
-        tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+        tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
         break;
 
     case TCPS_TIME_WAIT:
@@ -1351,7 +1381,7 @@ tcp_do_state_change(struct pcb_entry *pcb, int32_t new_state)
          * the TIME_WAIT timeout.
          */
         tcb_kill_timers(tcb);
-        tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+        tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
         break;
 
     default:
@@ -1499,7 +1529,8 @@ static inline void
 tcp_do_process_options(struct tcb_entry *tcb, struct seg_entry *seg, struct chnl *ch)
 {
     /* skip a few tests if none of the bits are set */
-    if (is_set(seg->sflags, (SEG_TS_PRESENT | SEG_WS_PRESENT | SEG_MSS_PRESENT))) {
+    if (is_set(seg->sflags,
+               (SEG_TS_PRESENT | SEG_WS_PRESENT | SEG_MSS_PRESENT | SEG_SACK_PERMIT))) {
         /* When the Timestamp is present and the SYN bit grab the TS value */
         if (is_set(seg->sflags, SEG_TS_PRESENT)) {
             tcb->tflags |= TCBF_RCVD_TSTAMP;
@@ -1515,7 +1546,9 @@ tcp_do_process_options(struct tcb_entry *tcb, struct seg_entry *seg, struct chnl
         if (is_set(seg->sflags, SEG_MSS_PRESENT))
             tcp_set_MSS(tcb, seg->mss);
 
-        /* Need to look into supporting SACK_PERMIT support */
+        /* SACK is used only when both sides sent the SACK permitted option */
+        if (is_set(seg->sflags, SEG_SACK_PERMIT) && is_set(tcb->tflags, TCBF_REQ_SACK))
+            tcb->tflags |= TCBF_SACK_PERMIT;
     }
 
     /* Compute proper scaling value from buffer space */
@@ -1602,6 +1635,11 @@ do_passive_open(struct seg_entry *seg)
     /* Add the pkt information to the new pcb */
     in_caddr_copy(&nch->ch_pcb->key.faddr, &md->faddr);
     in_caddr_copy(&nch->ch_pcb->key.laddr, &md->laddr);
+    if (cnet_pcb_update(nch->ch_pcb) < 0) {
+        chnl_cleanup(nch);
+        tcp_drop_with_reset(tcb->netif, seg, NULL);
+        CNE_NULL_RET("Unable to hash the PCB of the new connection\n");
+    }
 
     /* Retain part of the options */
     nch->ch_options  = ppcb->ch->ch_options & ((1 << SO_DONTROUTE) | (1 << SO_KEEPALIVE));
@@ -1622,6 +1660,9 @@ do_passive_open(struct seg_entry *seg)
 
     tcp_do_process_options(tcb, seg, nch);
 
+    /* Use the congestion control of the listener */
+    tcp_cc_select(tcb, ppcb->tcb->cc);
+
     /* Setup this TCB as having a parent PCB */
     tcb->ppcb = ppcb;
 
@@ -1636,7 +1677,7 @@ do_passive_open(struct seg_entry *seg)
     tcb->snd_wnd = seg->wnd << tcb->snd_scale;
 
     tcp_do_state_change(nch->ch_pcb, TCPS_SYN_RCVD); /* Move to SYN_RCVD */
-    tcb->timers[TCPT_KEEP] = TCP_KEEP_INIT_TV;
+    tcp_timer_set(tcb, TCPT_KEEP, TCP_KEEP_INIT_TV);
 
     /* Tell the new TCB to send a SYN_ACK */
     tcb->tflags |= TCBF_ACK_NOW;
@@ -1718,7 +1759,7 @@ tcb_cleanup(struct tcb_entry *tcb)
     CNE_DEBUG("Half Open queue is clean, reassemble %p, %d\n", tcb->reassemble,
               vec_len(tcb->reassemble));
 
-    pktmbuf_free_bulk(tcb->reassemble, vec_len(tcb->reassemble));
+    tcp_reass_flush(tcb);
 
     /* TCB should be disconnected and ready to be freed */
     vec_free(tcb->reassemble);
@@ -1831,122 +1872,35 @@ do_segment_listen(struct seg_entry *seg)
 }
 
 /*
- * Handle the TCP reassemble queue for the given packet <seg->p_pkt>.
+ * The segment <seg->mbuf> starts at RCV.NXT and holds the segments merged into it by the
+ * tcp_gro node. Strip the IPv4 and TCP headers of the merged segments and leave them
+ * linked behind it, the chnl_callback node adds them to the channel receive buffer in order.
  */
-static uint8_t
-tcp_reassemble(struct seg_entry *seg)
+static int
+tcp_gro_append(struct seg_entry *seg, struct tcb_entry *tcb)
 {
-#ifdef ENABLE_TCP_REASSEMBLE
-    pktmbuf_t *mbuf       = seg->mbuf;
-    struct pcb_entry *pcb = seg->pcb;
-    struct tcb_entry *tcb = pcb->tcb;
-    struct tcp_ipv4 *tip  = seg->ip;
+    struct cnet_metadata *md = pktmbuf_metadata(seg->mbuf);
     struct cne_tcp_hdr *tcp;
-    uint8_t flags = 0;
-    pktmbuf_t *m, *p;
-    struct tcp_ipv4 *t;
-    int32_t i;
-
-    if (mbuf == NULL)
-        goto handoff;
-
-    tip->tcp.sent_seq = seg->seq; /* Already in host order */
-    tip->ip.len       = seg->len; /* Already in host order */
-
-    /* Find the segment after this one. */
-    p = NULL;
-    STAILQ_FOREACH (m, &tcb->reassemble, stq_next) {
-        t = pktmbuf_mtod(m, struct tcp_ipv4 *);
-
-        if (seqGT(t->tcp.sent_seq, tip->tcp.sent_seq))
-            break;
-        p = m;
-    }
-
-    /* verify we are not pointing to the head of the circular list */
-    if (!p) {
-        t = pktmbuf_mtod(p, struct tcb_ipv4 *);
-
-        i = t->tcp.sent_seq + t->ip.len - tip->tcp.sent_seq;
-
-        /* when positive we have to trim the incoming segment at the front */
-        if (i > 0) {
-            /* Duplicate data, return after freeing packet */
-            if (i > tip->ip.len) {
-                pktmbuf_free(mbuf);
-                seg->mbuf = NULL;
-                return flags;
-            }
-
-            /* Remove data from the front of the segment */
-            pktmbuf_adj_offset(mbuf, i);
-            tip->ip.len -= i;
-            tip->tcp.sent_seq += i;
-        }
-    }
-
-    while (m != STAILQ_FIRST(&tcb->reassemble)) { /* not at head of list */
-        i = (tip->tcp.sent_seq + tip->ip.len) - t->tcp.sent_seq;
-
-        /* When i less then or equal to zero, segment is after this one. */
-        if (i <= 0)
-            break;
-
-        /* When i is positive and less then current segment length, must trim */
-        if (i < t->ip.len) {
-            t->tcp.sent_seq += i;
-            t->ip.len -= i;
+    pktmbuf_t *m;
 
-            pktmbuf_append(m, i);
+    tcb->rcv_nxt += pktmbuf_data_len(seg->mbuf);
+    md->gro_next = seg->gro;
+    seg->gro     = NULL;
+    seg->mbuf    = NULL; /* Consumed the packet */
 
-            /* segment fits in the list and no more trimming is required */
-            break;
-        }
+    for (m = md->gro_next; m; m = md->gro_next) {
+        tcp = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, m->l3_len);
+        pktmbuf_adj_offset(m, m->l3_len + ((tcp->data_off & 0xF0) >> 2));
 
-        /* new segment is larger then current segment, which must be freed */
-        t = (tcpip_t *)clist_next(t);
-
-        p = reass_pkt((tcpip_t *)t->ip.node.p_back);
-        clist_remove(t->ip.node.p_back);
-        pktmbuf_free(m);
+        tcb->rcv_nxt += pktmbuf_data_len(m);
+        md = pktmbuf_metadata(m);
     }
 
-    clist_insert(&tip->ip.node, t->ip.node.p_back);
-
-handoff:
-    if (tcb->state < TCPS_SYN_RCVD)
-        return flags;
-
-    tip = (tcpip_t *)clist_next(hd);
-
-    if (clist_empty(hd) || (tip->tcp.seq != tcb->rcv_nxt))
-        return flags;
-
-    if ((tcb->state == TCPS_SYN_RCVD) && tip->ip.len)
-        return flags;
-
-    do {
-        flags = tip->tcp.flags & TCP_FIN;
-
-        clist_remove(tip);
-
-        p = reass_pkt(tip);
-
-        tip = (tcpip_t *)clist_next(tip);
-
-        /* Update rcv_nxt for the total amount of data sent to the user */
-        tcb->rcv_nxt += pcb->data_rcv(pcb, p);
-    } while ((tip != hd) && (tip->tcp.seq == tcb->rcv_nxt));
-
-    return flags;
-#else
-    CNE_SET_USED(seg);
-    return seg->flags;
-#endif
+    return TCP_INPUT_NEXT_CHNL_RECV;
 }
 
 static inline int
-_process_data(struct seg_entry *seg, struct tcb_entry *tcb __cne_unused)
+_process_data(struct seg_entry *seg, struct tcb_entry *tcb)
 {
     int rc = TCP_INPUT_NEXT_PKT_DROP;
 
@@ -1974,6 +1928,9 @@ _process_data(struct seg_entry *seg, struct tcb_entry *tcb __cne_unused)
     if (seg->mbuf) {
         int len = pktmbuf_data_len(seg->mbuf);
 
+        if (seg->gro)
+            return tcp_gro_append(seg, tcb);
+
         if (len) {
             /* Update the rcv_nxt with the number of bytes consumed */
             tcb->rcv_nxt += len;
@@ -2005,16 +1962,26 @@ do_process_data(struct seg_entry *seg)
 
         rc = _process_data(seg, tcb);
 
-        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK))
+        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK)) {
             tcb->tflags |= TCBF_DELAYED_ACK;
-        else {
+            tcp_timer_set(tcb, TCPT_DELACK, 1);
+        } else {
             tcb->tflags |= TCBF_ACK_NOW;
             cnet_tcp_output(tcb);
         }
     } else {
-        /* TODO: set return value for the reassembled segment */
-        seg->flags = tcp_reassemble(seg);
+        if (seg->mbuf && pktmbuf_data_len(seg->mbuf) && (tcb->state == TCPS_ESTABLISHED)) {
+            if (seg->seq == tcb->rcv_nxt)
+                rc = tcp_reass_handoff(seg, tcb);
+            else {
+                rc = tcp_reassemble(seg, tcb);
 
+                /* The FIN of an out of order segment is taken when it is retransmitted */
+                seg->flags &= ~TCP_FIN;
+            }
+        }
+
+        /* Send an ACK for RCV.NXT, a duplicate ACK when the segment is out of order */
         tcb->tflags |= TCBF_ACK_NOW;
         cnet_tcp_output(tcb);
     }
@@ -2108,7 +2075,7 @@ do_segment_syn_sent(struct seg_entry *seg)
     if (is_set(seg->flags, TCP_SYN) && (acceptable || is_clr(seg->flags, TCP_ACK))) {
         tcp_do_process_options(tcb, seg, seg->pcb->ch);
 
-        tcb->timers[TCPT_REXMT] = 0;
+        tcp_timer_stop(tcb, TCPT_REXMT);
 
         /* RCV.NXT = SEG.SEQ + 1 */
         tcb->rcv_adv = tcb->rcv_nxt = seg->seq + 1;
@@ -2129,7 +2096,7 @@ do_segment_syn_sent(struct seg_entry *seg)
             tcb->snd_wnd = seg->wnd << tcb->snd_scale;
             tcb->snd_wl1 = seg->seq - 1;
 
-            tcp_set_CWND(tcb);
+            tcb->cc->init(tcb);
         } else
             tcp_do_state_change(seg->pcb, TCPS_SYN_RCVD);
 
@@ -2241,40 +2208,6 @@ tcp_calculate_RTT(struct tcb_entry *tcb, int16_t rtt)
     return 0;
 }
 
-/*
- * Update the congestion window value in the TCB structure. When cwnd < then
- * ssthresh then we are in slow start. If greater then or equal to ssthresh
- * then we are in congestion avoidance.
- *
- * RFC2581: pg 4
- * During slow start, a TCP increments cwnd by at most SMSS bytes for
- * each ACK received that acknowledges new data. Slow start ends when
- * cwnd exceeds ssthresh (or, optionally, when it reaches it, as noted
- * above) or when congestion is observed.
- *
- * During congestion avoidance, cwnd is incremented by 1 full-sized
- * segment per round-trip time (RTT). Congestion avoidance continues
- * until congestion is detected. One formula commonly used to update
- * cwnd during congestion avoidance is given in equation 2:
- *       cwnd += SMSS*SMSS/cwnd (2)
- */
-static void
-tcp_update_cwnd(struct tcb_entry *tcb)
-{
-    uint32_t cwnd = tcb->snd_cwnd;
-    uint32_t incr = tcb->max_mss;
-
-    /*
-     * When cwnd is <= to ssthresh, we are in slow-start else
-     * congestion avoidance.
-     */
-    if (cwnd > tcb->snd_ssthresh)
-        incr = incr * incr / cwnd; /* cwnd += SMSS*SMSS/cwnd (2) */
-
-    /* Increase the cwnd by SMSS value unless in congestion avoidance */
-    tcb->snd_cwnd = CNE_MIN((int)(cwnd + incr), TCP_MAXWIN << tcb->snd_scale);
-}
-
 /*
  * Update the segment information values in the TCB structure.
  */
@@ -2302,6 +2235,58 @@ tcb_segment_update(struct seg_entry *seg, struct tcb_entry *tcb)
     tcb->tflags |= TCBF_FORCE_TX;
 }
 
+/*
+ * Send in SACK recovery, RFC6675 pg 8-9. Retransmit the holes of the scoreboard and
+ * then new data while the data in flight leaves room in the congestion window. When
+ * <force> is set on entering the recovery one segment is always retransmitted.
+ */
+static void
+tcp_sack_output(struct tcb_entry *tcb, bool force)
+{
+    uint32_t cwnd = tcb->snd_cwnd;
+    seq_t onxt    = tcb->snd_nxt;
+    int32_t room  = (int32_t)(cwnd - tcp_sack_pipe(tcb));
+    seq_t start, end;
+
+    for (;;) {
+        if (!tcp_sack_nexthole(tcb, &start, &end)) {
+            if (!force)
+                break;
+            /* Nothing SACKed yet, retransmit the first segment */
+            start = tcb->snd_una;
+            end   = tcb->snd_max;
+        }
+        if (!force && room < tcb->max_mss)
+            break;
+        force = false;
+
+        if ((end - start) > tcb->max_mss)
+            end = start + tcb->max_mss;
+
+        /* Let tcp_output() send from the hole up to its end */
+        tcb->snd_nxt  = start;
+        tcb->snd_cwnd = end - tcb->snd_una;
+        cnet_tcp_output(tcb);
+
+        if (tcb->snd_nxt == start)
+            break;
+        ADD_TCP_STAT(sack_rexmit, tcb->snd_nxt - start);
+        tcb->sack_high_rxt = tcb->snd_nxt;
+        room -= tcb->snd_nxt - start;
+    }
+
+    /* Send new data with the room left */
+    tcb->snd_nxt = tcb->snd_max;
+    if (room >= tcb->max_mss) {
+        tcb->snd_cwnd = (tcb->snd_max - tcb->snd_una) + room;
+        cnet_tcp_output(tcb);
+    }
+
+    tcb->snd_cwnd = cwnd;
+    if (seqGT(onxt, tcb->snd_nxt))
+        tcb->snd_nxt = onxt;
+}
+
 /*
  * Handle the Syn Received state of the given segment or TCB.
  */
@@ -2312,6 +2297,7 @@ do_segment_others(struct seg_entry *seg)
     struct chnl *ch       = seg->pcb->ch;
     int32_t trim, rc = TCP_INPUT_NEXT_PKT_DROP;
     bool acceptable;
+    seq_t una;
 
     /* RFC793 - p70
      *
@@ -2531,6 +2517,8 @@ do_segment_others(struct seg_entry *seg)
         return TCP_INPUT_NEXT_PKT_DROP;
     }
 
+    una = tcb->snd_una;
+
     /* Did we get our FIN acked and did we send a FIN ? */
     tcb->tflags |= (((seg->ack - tcb->snd_una) > ch->ch_snd.cb_cc) && (tcb->tflags & TCBF_SENT_FIN))
                        ? TCBF_OUR_FIN_ACKED
@@ -2620,6 +2608,9 @@ do_segment_others(struct seg_entry *seg)
          *     SND.UNA =< SEG.ACK =< SND.NXT.
          */
     case TCPS_ESTABLISHED:
+        if (is_set(tcb->tflags, TCBF_SACK_PERMIT))
+            tcp_sack_update(tcb, seg);
+
         /*
          * If the ACK is a duplicate (SEG.ACK =< SND.UNA), ignore it or
          * process as a fast retransmit.
@@ -2629,6 +2620,15 @@ do_segment_others(struct seg_entry *seg)
                 if ((tcb->timers[TCPT_REXMT] == 0) || (seg->ack != tcb->snd_una))
                     tcb->dupacks = 0;
 
+                /* RFC6675: pg 9
+                 * In recovery each duplicate ACK may send holes or new data.
+                 */
+                else if (is_set(tcb->tflags, TCBF_SACK_RECOVERY)) {
+                    tcb->dupacks++;
+                    tcp_sack_output(tcb, false);
+                    return TCP_INPUT_NEXT_PKT_DROP;
+                }
+
                 /* RFC2581: pg 6
                  * 1. When the third duplicate ACK is received, set ssthresh to
                  *    no more than the value given in equation 3.
@@ -2637,16 +2637,28 @@ do_segment_others(struct seg_entry *seg)
                  */
                 else if (++tcb->dupacks == TCP_RETRANSMIT_THRESHOLD) {
                     uint32_t onxt = tcb->snd_max;
-                    uint32_t win  = CNE_MIN(tcb->snd_wnd, tcb->snd_cwnd) / 2 / tcb->max_mss;
 
-                    if (win < 2)
-                        win = 2;
-                    /* Equation (3): ssthresh = max (FlightSize / 2, 2*SMSS) */
-                    tcb->snd_ssthresh       = win * tcb->max_mss;
-                    tcb->timers[TCPT_REXMT] = 0;
-                    tcb->rtt                = 0;
-                    tcb->snd_nxt            = seg->ack;
-                    tcb->snd_cwnd           = tcb->max_mss;
+                    tcb->cc->on_loss(tcb);
+                    tcp_timer_stop(tcb, TCPT_REXMT);
+                    tcb->rtt = 0;
+
+                    /* RFC6675: pg 8-9
+                     * Enter the recovery and retransmit only the data not SACKed
+                     * by the peer, cwnd = ssthresh.
+                     */
+                    if (is_set(tcb->tflags, TCBF_SACK_PERMIT)) {
+                        tcb->tflags |= TCBF_SACK_RECOVERY;
+                        tcb->snd_recover   = onxt;
+                        tcb->sack_high_rxt = tcb->snd_una;
+                        tcb->snd_cwnd      = tcb->snd_ssthresh;
+                        INC_TCP_STAT(sack_recovery);
+
+                        tcp_sack_output(tcb, true);
+                        return TCP_INPUT_NEXT_PKT_DROP;
+                    }
+
+                    tcb->snd_nxt  = seg->ack;
+                    tcb->snd_cwnd = tcb->max_mss;
 
                     cnet_tcp_output(tcb);
                     /*
@@ -2723,6 +2735,16 @@ do_segment_others(struct seg_entry *seg)
          */
         tcp_update_acked_data(seg, tcb);
 
+        /* RFC6675: pg 9
+         * A partial ACK continues the recovery and a full ACK ends it.
+         */
+        if (is_set(tcb->tflags, TCBF_SACK_RECOVERY)) {
+            if (seqLT(tcb->snd_una, tcb->snd_recover))
+                tcp_sack_output(tcb, false);
+            else
+                tcb->tflags &= ~TCBF_SACK_RECOVERY;
+        }
+
         /* FALLTHRU */
     default:
         break;
@@ -2793,12 +2815,13 @@ do_segment_others(struct seg_entry *seg)
      * reset the retransmit timer to the current RTO value.
      */
     if (seg->ack == tcb->snd_max)
-        tcb->timers[TCPT_REXMT] = 0;
+        tcp_timer_stop(tcb, TCPT_REXMT);
     else if (tcb->timers[TCPT_PERSIST] == 0)
-        tcb->timers[TCPT_REXMT] = tcb->rxtcur;
+        tcp_timer_set(tcb, TCPT_REXMT, tcb->rxtcur);
 
-    /* Update the congestion window for this connection. */
-    tcp_update_cwnd(tcb);
+    /* Update the congestion window for the new data acked, not grown in recovery. */
+    if (seqGT(tcb->snd_una, una) && is_clr(tcb->tflags, TCBF_SACK_RECOVERY))
+        tcb->cc->on_ack(tcb, tcb->snd_una - una);
 
     /* Sixth, check the URG bit */
     CNE_DEBUG("Check RFC 793 [orange]URG[] bit\n");
@@ -2933,7 +2956,7 @@ do_segment_others(struct seg_entry *seg)
         case TCPS_FIN_WAIT_2:
             CNE_DEBUG("FIN bit set in [orange]FIN Wait 2[]\n");
             tcp_do_state_change(tcb->pcb, TCPS_TIME_WAIT);
-            tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+            tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
             break;
 
         /*
@@ -2942,7 +2965,7 @@ do_segment_others(struct seg_entry *seg)
          */
         case TCPS_TIME_WAIT:
             CNE_DEBUG("FIN bit set in [orange]Time Wait[]\n");
-            tcb->timers[TCPT_2MSL] = 2 * TCP_MSL_TV;
+            tcp_timer_set(tcb, TCPT_2MSL, 2 * TCP_MSL_TV);
             break;
 
         /*
@@ -3125,9 +3148,9 @@ tcp_header_prediction(struct seg_entry *seg, struct tcb_entry *tcb)
             tcb->snd_una = seg->ack;
 
             if (tcb->snd_una == tcb->snd_max)
-                tcb->timers[TCPT_REXMT] = 0;
+                tcp_timer_stop(tcb, TCPT_REXMT);
             else if (tcb->timers[TCPT_PERSIST] == 0)
-                tcb->timers[TCPT_REXMT] = tcb->rxtcur;
+                tcp_timer_set(tcb, TCPT_REXMT, tcb->rxtcur);
 
             /* Allow the users to put more data in send buffer */
             if (cb_space(&ch->ch_snd) >= ch->ch_snd.cb_lowat) {
@@ -3154,9 +3177,10 @@ tcp_header_prediction(struct seg_entry *seg, struct tcb_entry *tcb)
 
         rc = _process_data(seg, tcb);
 
-        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK))
+        if (is_clr(tcb->tflags, TCBF_DELAYED_ACK)) {
             tcb->tflags |= TCBF_DELAYED_ACK;
-        else {
+            tcp_timer_set(tcb, TCPT_DELACK, 1);
+        } else {
             tcb->tflags |= TCBF_ACK_NOW;
             cnet_tcp_output(tcb);
         }
@@ -3191,6 +3215,7 @@ tcp_strip_ip_options(pktmbuf_t *mbuf)
 int
 cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
 {
+    struct cnet_metadata *md = pktmbuf_metadata(mbuf);
     struct cne_ipv4_hdr *ip;
     struct cne_tcp_hdr *tcp;
     uint8_t *opts         = NULL;
@@ -3200,6 +3225,10 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
     struct tcb_entry *tcb      = NULL;
     uint8_t tcp_syn_fin_cnt[4] = {0, 1, 1, 2};
 
+    /* Segments merged by tcp_gro are split up unless the merged segment is taken whole */
+    if (unlikely(md && md->gro_next) && !tcp_gro_whole(pcb, mbuf))
+        return tcp_gro_split(pcb, mbuf, cnet_tcp_input);
+
     if (!(this_cnet->flags & CNET_TCP_ENABLED))
         CNE_ERR_GOTO(free_seg, "TCP is not enabled\n");
 
@@ -3217,6 +3246,12 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
     seg->mbuf = mbuf;
     seg->pcb  = pcb;
 
+    /* Hold the merged segments, freed with the seg unless given to the receive buffer */
+    if (md) {
+        seg->gro     = md->gro_next;
+        md->gro_next = NULL;
+    }
+
     /* Grab the IP and TCP header pointers */
     ip = pktmbuf_mtod(mbuf, struct cne_ipv4_hdr *);
 
@@ -3302,8 +3337,8 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
         CNE_ERR_GOTO(free_seg, "[orange]TCB is Closed[]\n");
 
     /* Process the packet for the given TCP state */
-    tcb->idle              = 0;
-    tcb->timers[TCPT_KEEP] = tcb->tcp->keep_idle;
+    tcb_idle_reset(tcb);
+    tcp_timer_set(tcb, TCPT_KEEP, tcb->tcp->keep_idle);
 
     /* Scale the window value if not a SYN segment */
     if (is_clr(seg->flags, TCP_SYN))
@@ -3329,10 +3364,11 @@ cnet_tcp_input(struct pcb_entry *pcb, pktmbuf_t *mbuf)
     if ((tcb->state == TCPS_ESTABLISHED) && ((seg->flags & HDR_PREDIC) == TCP_ACK) &&
         (is_clr(seg->sflags, SEG_TS_PRESENT) || tstampGEQ(seg->ts_val, tcb->ts_recent)) &&
         (seg->seq == tcb->rcv_nxt) && (seg->wnd && (seg->wnd == tcb->snd_wnd)) &&
-        (tcb->snd_nxt == tcb->snd_max)) {
-        if (tcp_header_prediction(seg, tcb)) {
+        (tcb->snd_nxt == tcb->snd_max) && is_clr(seg->sflags, SEG_SACK_PRESENT) &&
+        (tcb->snd_numsacks == 0) && is_clr(tcb->tflags, TCBF_SACK_RECOVERY)) {
+        rc = tcp_header_prediction(seg, tcb);
+        if (rc != TCP_INPUT_NEXT_PKT_DROP) {
             CNE_DEBUG("Header prediction [orange]Good[]\n");
-            rc = TCP_INPUT_NEXT_CHNL_RECV;
             goto free_seg;
         }
     }
@@ -3369,58 +3405,6 @@ free_seg:
     return rc;
 }
 
-/*
- * Process the fast timeout for TCP, which processes a fast retransmit.
- */
-static inline void
-tcp_fast_retransmit_timo(stk_t *stk)
-{
-    struct pcb_hd *hd = &stk->tcp->tcp_hd;
-    struct pcb_entry *p;
-
-    if (!hd)
-        return;
-
-    /* TCP fast timer to process retransmits. */
-    vec_foreach_ptr (p, hd->vec) {
-        struct tcb_entry *t = p->tcb;
-        if (t && is_set(t->tflags, TCBF_NEED_FAST_REXMT)) {
-            t->total_retrans++;
-            t->tflags &= ~TCBF_NEED_FAST_REXMT;
-            cnet_tcp_output(t);
-        }
-    }
-}
-
-/*
- * Process the fast timeout for TCP, which is used for delayed ACKs.
- */
-static inline void
-tcp_fast_timo(void *arg)
-{
-    stk_t *stk        = (stk_t *)arg;
-    struct pcb_hd *hd = &stk->tcp->tcp_hd;
-    struct pcb_entry *p;
-
-    if (!hd)
-        CNE_RET("tcp_hd is NULL\n");
-
-    /* TCP fast timer to process Delayed ACKs. */
-    vec_foreach_ptr (p, hd->vec) {
-        struct tcb_entry *t = p->tcb;
-
-        if (t && is_set(t->tflags, TCBF_DELAYED_ACK)) {
-            t->tflags &= ~TCBF_DELAYED_ACK;
-            t->tflags |= TCBF_ACK_NOW;
-
-            INC_TCP_STAT(delayed_ack);
-
-            /* ACK flag is cleared in tcp output */
-            cnet_tcp_output(t);
-        }
-    }
-}
-
 /*
  * Process the TCP timers for the slow timeouts or the state machine for
  * the timers and TCP.
@@ -3431,13 +3415,12 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
     struct tcb_entry *t = p->tcb; /* tcb pointer will be valid from the caller */
     stk_t *stk          = this_stk;
     int32_t rexmt;
-    uint32_t win;
     bool state = false;
 
     switch (tmr) {
     case TCPT_2MSL:
-        if ((t->state != TCPS_TIME_WAIT) && (t->idle <= stk->tcp->max_idle))
-            t->timers[tmr] = stk->tcp->keep_intvl;
+        if ((t->state != TCPS_TIME_WAIT) && (tcb_idle(t) <= (uint32_t)stk->tcp->max_idle))
+            tcp_timer_set(t, tmr, stk->tcp->keep_intvl);
         else {
             tcp_do_state_change(p, TCPS_CLOSED);
             state = true;
@@ -3466,17 +3449,17 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
         }
 
         if (is_set(p->opt_flag, SO_KEEPALIVE) && (t->state <= TCPS_CLOSE_WAIT)) {
-            if (t->idle >= (stk->tcp->keep_idle + stk->tcp->max_idle)) {
-                CNE_DEBUG("Idle %d < %d\n", t->idle, stk->tcp->keep_idle + stk->tcp->max_idle);
+            if (tcb_idle(t) >= (uint32_t)(stk->tcp->keep_idle + stk->tcp->max_idle)) {
+                CNE_DEBUG("Idle %u < %d\n", tcb_idle(t), stk->tcp->keep_idle + stk->tcp->max_idle);
                 goto dropit;
             }
 
             CNE_DEBUG("[orange]Keepalive!![]\n");
             tcp_do_response(t->netif, p, NULL, t->snd_nxt - 1, t->rcv_nxt - 1, TCP_ACK);
 
-            t->timers[tmr] = stk->tcp->keep_intvl;
+            tcp_timer_set(t, tmr, stk->tcp->keep_intvl);
         } else
-            t->timers[tmr] = stk->tcp->keep_idle;
+            tcp_timer_set(t, tmr, stk->tcp->keep_idle);
 
         break;
     dropit:
@@ -3501,26 +3484,36 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
         t->rxtcur = tcp_range_set(rexmt, t->rttmin, TCP_REXMTMAX_TV);
 
         /* Restart the retransmit timer */
-        t->timers[TCPT_REXMT] = t->rxtcur;
+        tcp_timer_set(t, TCPT_REXMT, t->rxtcur);
 
         /* Reset snd_nxt to force a retransmit of data */
         t->snd_nxt = t->snd_una;
         t->rtt     = 0;
 
-        win = CNE_MIN(t->snd_wnd, t->snd_cwnd) / 2 / t->max_mss;
+        t->cc->on_rto(t);
+        t->dupacks = 0;
 
-        if (win < 2)
-            win = 2;
-
-        t->snd_cwnd     = t->max_mss;
-        t->snd_ssthresh = win * t->max_mss;
-        t->dupacks      = 0;
+        /* RFC2018: pg 6, forget the SACKed data after a retransmit timeout */
+        t->snd_numsacks = 0;
+        t->tflags &= ~TCBF_SACK_RECOVERY;
 
         /* Set the ACK now bit to force a retransmit. */
         t->tflags |= TCBF_ACK_NOW;
         cnet_tcp_output(p->tcb);
         break;
 
+    case TCPT_DELACK:
+        if (is_set(t->tflags, TCBF_DELAYED_ACK)) {
+            t->tflags &= ~TCBF_DELAYED_ACK;
+            t->tflags |= TCBF_ACK_NOW;
+
+            INC_TCP_STAT(delayed_ack);
+
+            /* ACK flag is cleared in tcp output */
+            cnet_tcp_output(t);
+        }
+        break;
+
     default:
         break;
     }
@@ -3529,62 +3522,96 @@ tcp_process_timer(struct pcb_entry *p, int32_t tmr)
 }
 
 /*
- * Process the slow timeouts for the TCP state machine.
+ * Called by the timing wheel for each TCB timer expiring on the current tick.
  */
-static inline void
-tcp_slow_timo(stk_t *stk)
+static void
+tcp_timer_expire(struct tcp_tmr *tmr __cne_unused, void *arg, uint16_t id)
 {
-    struct pcb_hd *hd = &stk->tcp->tcp_hd;
-    struct pcb_entry *p;
-    int32_t j;
+    struct tcb_entry *t = arg;
 
-    stk->tcp->max_idle = stk->tcp->keep_cnt * stk->tcp->keep_intvl;
-
-    /* TCP slow timer */
-    vec_foreach_ptr (p, hd->vec) {
-        struct tcb_entry *t = p->tcb;
-
-        if (!t)
-            continue;
+    t->timers[id] = 0;
 
-        if (t->state == TCPS_CLOSED || t->state == TCPS_LISTEN)
-            continue;
+    if (!t->pcb || t->state == TCPS_CLOSED || t->state == TCPS_LISTEN)
+        return;
 
-        for (j = 0; j < TCP_NTIMERS; j++) {
-            if ((t->timers[j] > 0) && (--t->timers[j] == 0))
-                if (tcp_process_timer(p, j)) {
-                    t = NULL;
-                    break;
-                }
-        }
+    tcp_process_timer(t->pcb, id);
+}
 
-        /* measure the current idle time */
-        if (t)
-            t->idle++;
-    }
+/*
+ * Process the slow timeout, the TCB timers are on the timing wheel and only the
+ * per stack values are updated here.
+ */
+static inline void
+tcp_slow_timo(stk_t *stk)
+{
+    stk->tcp->max_idle = stk->tcp->keep_cnt * stk->tcp->keep_intvl;
 
     stk->tcp->snd_ISS += (TCP_ISSINCR / TCP_SLOWHZ); /* Increment iss */
     stk->tcp_now++;
 }
 
 /*
- * Timeout every XXms to be able to have a fast and slow timer of 200ms/500ms.
+ * Timeout every MS_PER_TICK to turn the timing wheel, which expires only the TCB
+ * timers due on this tick.
  */
 static void
 _process_timers(struct cne_timer *tim __cne_unused, void *arg)
 {
     stk_t *stk = arg;
 
-    if (!(stk->ticks % (TCP_REXMT_TIMEOUT_MS / MS_PER_TICK)))
-        tcp_fast_retransmit_timo(stk);
+    stk->ticks++;
 
-    if (!(stk->ticks % (TCP_FAST_TIMEOUT_MS / MS_PER_TICK)))
-        tcp_fast_timo(stk);
+    tcp_wheel_tick(&stk->tcp->wheel, tcp_timer_expire);
 
     if (!(stk->ticks % (TCP_SLOW_TIMEOUT_MS / MS_PER_TICK)))
         tcp_slow_timo(stk);
 }
 
+/*
+ * Fill <blks> with up to <max> SACK blocks describing the reassembly queue. The
+ * first block holds the last segment queued and the others follow in sequence
+ * order, RFC2018 pg 5. Returns the number of blocks.
+ */
+static int
+tcp_sack_blocks(struct tcb_entry *tcb, struct tcp_sack_blk *blks, int max)
+{
+    struct tcp_reass *q = tcb->reassemble;
+    uint32_t nb         = vec_len(q);
+    bool found          = false;
+    int n               = 1; /* blks[0] is kept for the last segment queued */
+    uint32_t i, j;
+
+    if (max > TCP_MAX_SACK)
+        max = TCP_MAX_SACK;
+    if (nb == 0 || max <= 0)
+        return 0;
+
+    for (i = 0; i < nb; i = j) {
+        seq_t start = q[i].seq;
+        seq_t end   = q[i].seq + q[i].len;
+
+        /* Contiguous queued segments make a single block */
+        for (j = i + 1; j < nb && q[j].seq == end; j++)
+            end += q[j].len;
+
+        if (!found && seqLEQ(start, tcb->rcv_lastsack) && seqLT(tcb->rcv_lastsack, end)) {
+            blks[0].start = start;
+            blks[0].end   = end;
+            found         = true;
+        } else if (n < max) {
+            blks[n].start = start;
+            blks[n].end   = end;
+            n++;
+        }
+    }
+
+    if (!found) {
+        memmove(&blks[0], &blks[1], (n - 1) * sizeof(struct tcp_sack_blk));
+        n--;
+    }
+    return n;
+}
+
 /*
  * Add the MSS option and other options for the send packet.
  */
@@ -3626,6 +3653,19 @@ tcp_send_options(struct tcb_entry *tcb, uint8_t *opts, uint8_t flags_n)
             *p++ = TCP_OPT_NOP;
             optlen += 4;
         }
+
+        /*
+         * Add the SACK permitted option on the initial SYN or when the peer sent it
+         * in its SYN, RFC2018 pg 2.
+         */
+        if (is_set(tcb->tflags, TCBF_REQ_SACK) &&
+            (is_clr(flags_n, TCP_ACK) || is_set(tcb->tflags, TCBF_SACK_PERMIT))) {
+            *p++ = TCP_OPT_NOP;
+            *p++ = TCP_OPT_NOP;
+            *p++ = TCP_OPT_SACK_OK;
+            *p++ = TCP_OPT_SACK_LEN;
+            optlen += 4;
+        }
     }
 
     CNE_DEBUG("tcb state [orange]%s[]\n", tcb_print_flags(tcb->tflags));
@@ -3640,10 +3680,31 @@ tcp_send_options(struct tcb_entry *tcb, uint8_t *opts, uint8_t flags_n)
                         TCP_OPT_TSTAMP_LEN);
         *lp++ = htobe32(tcp_now);
         *lp++ = htobe32(tcb->ts_recent);
+        p = (uint8_t *)lp;
         optlen += 12;
     } else
         CNE_DEBUG("TCP options not added\n");
 
+    /* Report the out of order data held in the reassembly queue, RFC2018 pg 3 */
+    if (is_set(tcb->tflags, TCBF_SACK_PERMIT) && is_clr(flags_n, SYN_RST) &&
+        vec_len(tcb->reassemble)) {
+        struct tcp_sack_blk blks[TCP_MAX_SACK];
+        int n;
+
+        n = tcp_sack_blocks(tcb, blks, (TCP_MAX_OPTIONS - optlen - 4) / TCP_OPT_SACK_BLK);
+        if (n > 0) {
+            uint32_t *lp = (uint32_t *)p;
+
+            *lp++ = htobe32((TCP_OPT_NOP << 24) | (TCP_OPT_NOP << 16) | (TCP_OPT_SACK << 8) |
+                            (2 + (n * TCP_OPT_SACK_BLK)));
+            for (int i = 0; i < n; i++) {
+                *lp++ = htobe32(blks[i].start);
+                *lp++ = htobe32(blks[i].end);
+            }
+            optlen += 4 + (n * TCP_OPT_SACK_BLK);
+        }
+    }
+
     return optlen; /* Length of options */
 }
 
@@ -3718,8 +3779,8 @@ cnet_tcp_connect(struct pcb_entry *pcb)
 
     chnl_state_set(pcb->ch, _ISCONNECTING);
 
-    tcb->state             = TCPS_SYN_SENT;
-    tcb->timers[TCPT_KEEP] = TCP_KEEP_INIT_TV;
+    tcb->state = TCPS_SYN_SENT;
+    tcp_timer_set(tcb, TCPT_KEEP, TCP_KEEP_INIT_TV);
 
     /* Set the new send ISS value. */
     tcp_send_seq_set(tcb, 7);
@@ -3807,6 +3868,7 @@ cnet_tcb_list(stk_t *stk, struct tcb_entry *tcb)
             t->snd_max, t->snd_wnd, t->snd_ssthresh, t->snd_cwnd, t->max_sndwnd);
         cne_printf("   Rcv: wnd %u nxt %u urp %u irs %u adv %u bsize %u sst %u\n", t->rcv_wnd,
                    t->rcv_nxt, t->rcv_urp, t->rcv_irs, t->rcv_adv, t->rcv_bsize, t->rcv_ssthresh);
+        cne_printf("   CC: %s pacing %" PRIu64 " bytes/s\n", t->cc->name, t->cc->pacing_rate(t));
         cne_printf("   Flags: [orange]%s[]\n", tcb_print_flags(t->tflags));
     }
 }
@@ -3825,11 +3887,12 @@ cnet_tcb_dump(void)
  * Main entry point to initialize the TCP protocol.
  */
 static int
-tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
+tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp, bool sack, bool lso, bool gro)
 {
     stk_t *stk                = this_stk;
     struct mempool_cfg cfg    = {0};
     struct protosw_entry *psw = NULL;
+    char name[CNE_HASH_NAMESIZE];
 
     stk->tcp_stats = calloc(1, sizeof(tcp_stats_t));
     if (!stk->tcp_stats)
@@ -3852,6 +3915,9 @@ tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
 
     stk->gflags |= (TCP_TIMEOUT_ENABLED | (wscale ? RFC1323_SCALE_ENABLED : 0));
     stk->gflags |= (t_stamp ? RFC1323_TSTAMP_ENABLED : 0);
+    stk->gflags |= (sack ? RFC2018_SACK_ENABLED : 0);
+    stk->gflags |= (lso ? TCP_LSO_ENABLED : 0);
+    stk->gflags |= (gro ? TCP_GRO_ENABLED : 0);
 
     stk->tcp->rcv_size    = MAX_TCP_RCV_SIZE;
     stk->tcp->snd_size    = MAX_TCP_SND_SIZE;
@@ -3864,10 +3930,16 @@ tcp_init(int32_t n_tcb_entries, bool wscale, bool t_stamp)
     stk->tcp->snd_ISS     = (uint32_t)rand();
     stk->tcp_now          = (uint32_t)cne_rdtsc();
 
+    tcp_wheel_init(&stk->tcp->wheel);
+
     stk->tcp->tcp_hd.vec = vec_alloc(stk->tcp->tcp_hd.vec, TCP_VEC_PCB_COUNT);
     CNE_ASSERT(stk->tcp->tcp_hd.vec != NULL);
     stk->tcp->tcp_hd.local_port = _IPPORT_RESERVED;
 
+    snprintf(name, sizeof(name), "tcp_pcb_%s", stk->name);
+    if (cnet_pcb_hd_create(&stk->tcp->tcp_hd, name, CNET_NUM_CHANNELS) < 0)
+        goto cleanup;
+
     cfg.objcnt    = CNET_NUM_TCBS;
     cfg.objsz     = sizeof(struct seg_entry);
     cfg.cache_sz  = 64;
@@ -3912,7 +3984,7 @@ cleanup:
 static int
 tcp_create(void *stk __cne_unused)
 {
-    return tcp_init(CNET_NUM_TCBS, 1, 1);
+    return tcp_init(CNET_NUM_TCBS, 1, 1, 1, 1, 1);
 }
 
 static int
@@ -3921,6 +3993,8 @@ tcp_destroy(void *_stk __cne_unused)
     stk_t *stk = _stk;
 
     free(stk->tcp_stats);
+    if (stk->tcp)
+        cnet_pcb_hd_destroy(&stk->tcp->tcp_hd);
     free(stk->tcp);
     free(stk->tcbs);
 
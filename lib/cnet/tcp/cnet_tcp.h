@@ -55,6 +55,8 @@
 #include "cnet_const.h"        // for bool_t
 #include "cnet_pcb.h"          // for pcb_entry (ptr only), pcb_hd
 #include "cnet_stk.h"          // for per_thread_stk, stk_entry, this_stk
+#include "cnet_tcp_wheel.h"    // for tcp_wheel, tcp_tmr, tcp_wheel_add, tcp_wheel_del
+#include "cnet_tcp_cc.h"       // for tcp_cc_ops, TCP_CC_PRIV_SIZE
 #include "cnet_tcp.h"          // for tcb_entry (ptr only)
 #include "mempool.h"           // for mempool_get, mempool_put
 #include "pktmbuf.h"           // for pktmbuf_t
@@ -62,7 +64,7 @@
 extern "C" {
 #endif
 
-#define CNET_TCP_REASSEMBLE_COUNT 256
+#define CNET_TCP_REASSEMBLE_COUNT 256 /**< Max out of order segments held by a TCB */
 #define CNET_TCP_BACKLOG_COUNT    128
 #define CNET_TCP_HALF_OPEN_COUNT  128
 
@@ -210,7 +212,16 @@ enum {
 #define TCP_OPT_MSS_LEN    4
 #define TCP_OPT_WSOPT_LEN  3
 #define TCP_OPT_TSTAMP_LEN 10
-#define TCP_MAX_OPTIONS    32
+#define TCP_OPT_SACK_BLK   8  /**< Length of one SACK block in a SACK option */
+#define TCP_MAX_OPTIONS    40
+#define TCP_MAX_SACK       4  /**< Max SACK blocks in a SACK option */
+#define TCP_SACK_BLKS      16 /**< Max SACKed blocks held by the send scoreboard */
+
+/* A block of data received out of order, [start, end) */
+struct tcp_sack_blk {
+    seq_t start; /**< First sequence number of the block */
+    seq_t end;   /**< Sequence number following the last byte of the block */
+};
 
 /* Few default values */
 #ifdef TCP_MSS
@@ -296,39 +307,44 @@ enum {
     TCPT_PERSIST,   /**< Persist timer index */
     TCPT_KEEP,      /**< Keepalive or Connection Established timer */
     TCPT_2MSL,      /**< 2 x Max Segment Life or FIN Wait 2 timer */
+    TCPT_DELACK,    /**< Delayed ACK timer, in fast timeout ticks */
     TCP_NTIMERS     /**< Number of timers in tcb_t.timers */
 };
 
 /* Current Segment information in host order. */
 struct seg_entry {
     TAILQ_ENTRY(seg_entry) entry;
-    pktmbuf_t *mbuf;               /**< Current Packet pointer */
-    struct pcb_entry *pcb;         /**< PCB attached to this segment */
-    uint8_t flags;                 /**< Current TCP flags tcp_hd.flags */
-    uint8_t offset;                /**< Current Segment offset in bytes */
-    uint16_t mss;                  /**< MSS option value when present */
-    uint16_t urp;                  /**< Current Segment urgent pointer */
-    uint16_t len;                  /**< Current Segment length */
-    uint16_t iplen;                /**< Total length of the IP Data */
-    uint16_t sflags;               /**< Segment flags */
-    uint16_t lport;                /**< lport id */
-    uint32_t wnd;                  /**< Current Segment Window */
-    seq_t seq;                     /**< Current Segment sequence */
-    seq_t ack;                     /**< Current Segment acknowledge */
-    uint32_t ts_val;               /**< Timestamp value */
-    uint32_t ts_ecr;               /**< Timestamp ecr */
-    void *ip;                      /**< IPv4/v6 header start. */
-    uint8_t req_scale;             /**< Requested send scale */
-    uint8_t optlen;                /**< TCP Options length */
-    uint8_t opts[TCP_MAX_OPTIONS]; /**< TCP Option bytes */
+    pktmbuf_t *mbuf;                         /**< Current Packet pointer */
+    pktmbuf_t *gro;                          /**< Segments merged into mbuf by tcp_gro */
+    struct pcb_entry *pcb;                   /**< PCB attached to this segment */
+    uint8_t flags;                           /**< Current TCP flags tcp_hd.flags */
+    uint8_t offset;                          /**< Current Segment offset in bytes */
+    uint16_t mss;                            /**< MSS option value when present */
+    uint16_t urp;                            /**< Current Segment urgent pointer */
+    uint16_t len;                            /**< Current Segment length */
+    uint16_t iplen;                          /**< Total length of the IP Data */
+    uint16_t sflags;                         /**< Segment flags */
+    uint16_t lport;                          /**< lport id */
+    uint32_t wnd;                            /**< Current Segment Window */
+    seq_t seq;                               /**< Current Segment sequence */
+    seq_t ack;                               /**< Current Segment acknowledge */
+    uint32_t ts_val;                         /**< Timestamp value */
+    uint32_t ts_ecr;                         /**< Timestamp ecr */
+    void *ip;                                /**< IPv4/v6 header start. */
+    uint8_t req_scale;                       /**< Requested send scale */
+    uint8_t optlen;                          /**< TCP Options length */
+    uint8_t opts[TCP_MAX_OPTIONS];           /**< TCP Option bytes */
+    uint8_t nb_sacks;                        /**< Number of SACK blocks in sacks[] */
+    struct tcp_sack_blk sacks[TCP_MAX_SACK]; /**< SACK blocks of the SACK option */
 };
 
 /* seg_entry.sflags bit definitions */
 enum {
-    SEG_TS_PRESENT  = 0x8000, /**< Timestamp is present */
-    SEG_MSS_PRESENT = 0x4000, /**< MSS option is present */
-    SEG_WS_PRESENT  = 0x2000, /**< Window Scale present */
-    SEG_SACK_PERMIT = 0x1000  /**< SACK permission flag, which is not supported at this time. */
+    SEG_TS_PRESENT   = 0x8000, /**< Timestamp is present */
+    SEG_MSS_PRESENT  = 0x4000, /**< MSS option is present */
+    SEG_WS_PRESENT   = 0x2000, /**< Window Scale present */
+    SEG_SACK_PERMIT  = 0x1000, /**< SACK permitted option is present */
+    SEG_SACK_PRESENT = 0x0800  /**< SACK option is present */
 };
 
 enum {
@@ -345,11 +361,19 @@ struct tcp_q {
     atomic_uint_least32_t cnt;    /**< Number of entries in the list */
 };
 
+/* Out of order segment held in the reassembly queue of a TCB */
+struct tcp_reass {
+    seq_t seq;       /**< Sequence number of the first data byte */
+    uint32_t len;    /**< Number of data bytes in the mbuf */
+    pktmbuf_t *mbuf; /**< Packet holding the data */
+};
+
 /* TCP Transmission Control Block */
 struct tcb_entry {
     TAILQ_ENTRY(tcb_entry) entry; /**< Pointer to the next free tcb_entry structure */
 
-    pktmbuf_t **reassemble;
+    struct tcp_reass *reassemble; /**< Out of order segments sorted by sequence number */
+    uint32_t reass_bytes;         /**< Number of data bytes in the reassembly queue */
     struct tcp_q backlog_q;   /**< Backlog queue of connections */
     struct tcp_q half_open_q; /**< Half open queue of connections */
 
@@ -364,6 +388,7 @@ struct tcb_entry {
     uint16_t max_mss;  /**< Maximum Segment Size */
 
     int16_t timers[TCP_NTIMERS] __cne_aligned(8); /**< TCP timers */
+    struct tcp_tmr tmrs[TCP_NTIMERS];             /**< Timing wheel entries of the timers */
     int32_t qLimit;                               /**< backlog limit for (3 * qLimit)/2 */
 
     /* RFC1323 variables */
@@ -402,13 +427,24 @@ struct tcb_entry {
     seq_t rttseq;        /**< Round Trip Time Sequence number */
     seq_t total_retrans; /**< Total retransmits */
     int16_t rtt;         /**< RTT in milli-seconds */
-    int16_t srtt;        /**< Smoothed Round Trip Time in microseconds */
+    int16_t srtt;        /**< Smoothed Round Trip Time in slow timer ticks x 8 */
     int16_t rttvar;      /**< Smoothed mean deviation estimator in ticks */
     int16_t dupacks;     /**< Received ACKs */
     int16_t rxtcur;      /**< Retransmission timeout */
     uint16_t rttmin;     /**< Minimum value for retransmission timeout */
     int16_t rxtshift;    /**< index into tcp_backoff[] array */
-    uint16_t idle;       /**< TCP Idle counter */
+    uint32_t idle_start; /**< Slow timeout tick the TCB went idle */
+
+    /* RFC2018 Selective Acknowledgment variables */
+    struct tcp_sack_blk snd_sacks[TCP_SACK_BLKS]; /**< Scoreboard, SACKed blocks above snd_una */
+    uint8_t snd_numsacks;                         /**< Number of blocks in snd_sacks[] */
+    seq_t snd_recover;                            /**< snd_max when SACK recovery started */
+    seq_t sack_high_rxt;                          /**< Highest sequence retransmitted in recovery */
+    seq_t rcv_lastsack;                           /**< Sequence of the last segment queued */
+
+    /* Congestion control */
+    const struct tcp_cc_ops *cc;                           /**< Congestion control algorithm */
+    uint64_t cc_priv[TCP_CC_PRIV_SIZE / sizeof(uint64_t)]; /**< State of the algorithm */
 };
 
 /* tcb_entry.tflags values */
@@ -431,15 +467,15 @@ enum {
 
     TCBF_ACK_NOW         = 0x00010000, /**< ACK Now */
     TCBF_SENT_FIN        = 0x00020000, /**< FIN has been sent */
-    TCBF_SACK_PERMIT     = 0x00040000, /**< SACK Permit is not supported, look at SEG_SACK_PERMIT */
+    TCBF_SACK_PERMIT     = 0x00040000, /**< SACK permitted by both sides */
     TCBF_RCVD_TSTAMP     = 0x00080000, /**< Received Timestamp in SYN */
 
     TCBF_NODELAY         = 0x00001000, /**< don't delay packets */
     TCBF_NAGLE_CREDIT    = 0x00002000, /**< Nagle credit flag */
     TCBF_OUR_FIN_ACKED   = 0x00004000, /**< Our FIN has been acked */
-    TCBF_FREE_BIT_4      = 0x00008000,
+    TCBF_REQ_SACK        = 0x00008000, /**< Requested SACK permitted option */
 
-    TCBF_FREE_BIT_5      = 0x00000100,
+    TCBF_SACK_RECOVERY   = 0x00000100, /**< In SACK based loss recovery */
     TCBF_NEED_FAST_REXMT = 0x00000200, /**< Need a fast Retransmit */
     TCBF_NOPUSH          = 0x00000400, /**< no push */
     TCBF_NOOPT           = 0x00000800, /**< don't use TCP options */
@@ -467,7 +503,7 @@ enum {
         "SENT_FIN",         \
         "ACK_NOW",          \
                             \
-        "Free_4",           \
+        "REQ_SACK",         \
         "OUR_FIN_ACKED",    \
         "NAGLE_CREDIT",     \
         "NO_DELAY",         \
@@ -475,7 +511,7 @@ enum {
         "NOOPT",            \
         "NOPUSH",           \
         "NeedFastRexmt",    \
-        "Free_5",           \
+        "SackRecovery",     \
         NULL                \
     }
 // clang-format on
@@ -494,9 +530,10 @@ struct tcp_entry {
     int32_t keep_cnt;   /**< TCP Keep Count */
     int32_t max_idle;   /**< TCP Max Idle */
     uint16_t pad0;
-    uint16_t default_MSS; /**< Default MSS value */
-    int32_t default_RTT;  /**< Default Round Trip Time */
-    struct pcb_hd tcp_hd; /**< PCB header information */
+    uint16_t default_MSS;   /**< Default MSS value */
+    int32_t default_RTT;    /**< Default Round Trip Time */
+    struct pcb_hd tcp_hd;   /**< PCB header information */
+    struct tcp_wheel wheel; /**< Timing wheel of the TCB timers */
 };
 
 /**
@@ -528,6 +565,13 @@ typedef struct tcp_stats {
     uint64_t S_tcp_rexmit;     /**< TCP retransmission count */
     uint64_t S_resets_sent;    /**< TCP resets count */
     uint64_t S_tcp_connect;    /**< TCP connections count */
+    uint64_t S_ooo_queued;     /**< TCP out of order bytes queued for reassembly */
+    uint64_t S_ooo_dropped;    /**< TCP out of order bytes dropped or trimmed */
+    uint64_t S_sack_recovery;  /**< TCP SACK loss recovery count */
+    uint64_t S_sack_rexmit;    /**< TCP bytes retransmitted from the SACK scoreboard */
+    uint64_t S_snd_zcopy;      /**< TCP segments sent in place from the send buffer */
+    uint64_t S_snd_lso;        /**< TCP large packets sent to be segmented by GSO */
+    uint64_t S_rx_gro;         /**< TCP segments merged into an earlier segment by tcp_gro */
 } tcp_stats_t;
 
 #define INC_TCP_STAT(x)               \
@@ -535,6 +579,11 @@ typedef struct tcp_stats {
         this_stk->tcp_stats->S_##x++; \
     } while (/*CONSTCOND*/ 0)
 
+#define ADD_TCP_STAT(x, n)                 \
+    do {                                   \
+        this_stk->tcp_stats->S_##x += (n); \
+    } while (/*CONSTCOND*/ 0)
+
 static inline void
 tcp_send_seq_set(struct tcb_entry *tcb, int x)
 {
@@ -551,12 +600,83 @@ tcp_range_set(int val, int tvmin, int tvmax)
     return (uint16_t)((val < tvmin) ? tvmin : (val > tvmax) ? tvmax : val);
 }
 
+#define TCP_SND_REFCNT 2 /**< References the send buffer holds on each of its mbufs */
+
+/**
+ * Test if a segment transmitted in place from a send buffer mbuf is still being sent, the
+ * data offset and length of the mbuf then describe the segment and not the unacked data.
+ */
+static inline bool
+tcp_snd_busy(pktmbuf_t *m)
+{
+    return pktmbuf_refcnt_read(m) > TCP_SND_REFCNT;
+}
+
+/**
+ * Select the congestion control algorithm of a TCB. The algorithm state is reset and a
+ * TCB not connected yet also gets the initial window of the algorithm.
+ */
+static inline void
+tcp_cc_select(struct tcb_entry *tcb, const struct tcp_cc_ops *cc)
+{
+    tcb->cc = cc;
+    memset(tcb->cc_priv, 0, sizeof(tcb->cc_priv));
+    if (tcb->state < TCPS_ESTABLISHED)
+        cc->init(tcb);
+}
+
+/**
+ * Stop a TCB timer.
+ */
+static inline void
+tcp_timer_stop(struct tcb_entry *tcb, int tmr)
+{
+    tcb->timers[tmr] = 0;
+    tcp_wheel_del(&this_stk->tcp->wheel, &tcb->tmrs[tmr]);
+}
+
+/**
+ * Arm a TCB timer to expire in val slow timeout ticks, or fast timeout ticks for TCPT_DELACK.
+ * A value of zero stops the timer.
+ */
+static inline void
+tcp_timer_set(struct tcb_entry *tcb, int tmr, int val)
+{
+    uint64_t ms = (tmr == TCPT_DELACK) ? TCP_FAST_TIMEOUT_MS : TCP_SLOW_TIMEOUT_MS;
+
+    if (val <= 0) {
+        tcp_timer_stop(tcb, tmr);
+        return;
+    }
+
+    tcb->timers[tmr] = (int16_t)val;
+    tcp_wheel_add(&this_stk->tcp->wheel, &tcb->tmrs[tmr], ((uint64_t)val * ms) / MS_PER_TICK, tcb,
+                  tmr);
+}
+
 static inline void
 tcb_kill_timers(struct tcb_entry *tcb)
 {
-    uint64_t *p = (uint64_t *)(uintptr_t)tcb->timers;
+    for (int i = 0; i < TCP_NTIMERS; i++)
+        tcp_timer_stop(tcb, i);
+}
 
-    p[0] = 0;
+/**
+ * Number of slow timeout ticks the TCB has been idle.
+ */
+static inline uint32_t
+tcb_idle(struct tcb_entry *tcb)
+{
+    return this_stk->tcp_now - tcb->idle_start;
+}
+
+/**
+ * Restart the idle time of the TCB.
+ */
+static inline void
+tcb_idle_reset(struct tcb_entry *tcb)
+{
+    tcb->idle_start = this_stk->tcp_now;
 }
 
 /**
@@ -582,6 +702,7 @@ tcb_alloc(void)
         bit_set(stk->tcbs, idx);
         stk_unlock();
     }
+    tcb_idle_reset(tcb);
 
     return tcb;
 }
@@ -592,6 +713,8 @@ tcb_free(struct tcb_entry *tcb)
     stk_t *stk = this_stk;
 
     if (tcb) {
+        tcb_kill_timers(tcb);
+
         if (stk_lock()) {
             int idx = mempool_obj_index(stk->tcb_objs, tcb);
 
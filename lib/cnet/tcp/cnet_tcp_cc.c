@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+/* cnet_tcp_cc.c - TCP congestion control algorithms and the NewReno algorithm. */
+
+#include <stddef.h>            // for NULL
+#include <stdint.h>            // for uint32_t, uint64_t
+#include <string.h>            // for strncmp
+#include <cne_common.h>        // for CNE_MIN, CNE_MAX, CNE_DIM
+#include <cnet_netif.h>        // for cnet_netif_match_subnet
+
+#include "cnet_tcp.h"           // for tcb_entry, TCP_INITIAL_CWND, TCP_MAXWIN
+#include "cnet_tcp_cc.h"        // for tcp_cc_ops
+
+static const struct tcp_cc_ops *tcp_cc_algos[] = {&tcp_cc_reno, &tcp_cc_cubic};
+
+const struct tcp_cc_ops *
+tcp_cc_find(const char *name)
+{
+    if (!name)
+        return NULL;
+
+    for (int i = 0; i < (int)CNE_DIM(tcp_cc_algos); i++)
+        if (!strncmp(tcp_cc_algos[i]->name, name, TCP_CC_NAME_MAX))
+            return tcp_cc_algos[i];
+
+    return NULL;
+}
+
+uint64_t
+tcp_cc_pacing_rate(struct tcb_entry *tcb)
+{
+    /* The smoothed RTT is in slow timer ticks scaled by TCP_RTT_SCALE */
+    uint64_t srtt = ((uint64_t)tcb->srtt * TCP_SLOW_TIMEOUT_MS) >> TCP_RTT_SHIFT;
+
+    if (srtt == 0)
+        return 0;
+
+    /* Twice the window per RTT in slow start to keep growing, 1.2 times after */
+    if (tcb->snd_cwnd < tcb->snd_ssthresh)
+        return ((uint64_t)tcb->snd_cwnd * 2 * 1000) / srtt;
+    return ((uint64_t)tcb->snd_cwnd * 12 * 100) / srtt;
+}
+
+/*
+ * Set the congestion window for slow-start given the valid <tcb>, by looking at
+ * the tcb->pcb->faddr and determine the connection is for a local subnet. When
+ * the connection is on the local subnet, the code will select a larger
+ * congestion window value else it picks the senders max segment size.
+ */
+static void
+reno_init(struct tcb_entry *tcb)
+{
+    /*
+     * Setup for slow-start congestion window size.
+     *
+     * For a local address we have a large cwnd value else one segment.
+     *
+     * RFC2581: pg 4
+     * We note that a non-standard, experimental TCP extension allows that a
+     * TCP MAY use a large initial window (IW), as define in the equation 1
+     * [AFP98].
+     *
+     *      IW = min( 4 * SMSS, max( 2 * SMSS, 4380 bytes))     [1]
+     */
+    tcb->snd_cwnd = tcb->max_mss;
+    if (tcb->pcb != NULL) {
+        if (cnet_netif_match_subnet(&tcb->pcb->key.faddr.cin_addr))
+            tcb->snd_cwnd =
+                CNE_MIN((4 * tcb->max_mss), CNE_MAX((2 * tcb->max_mss), TCP_INITIAL_CWND));
+    }
+
+    /* Normally set to TCP_MAXWIN as per RFC2001 */
+    tcb->snd_ssthresh = tcb->snd_cwnd << 1;
+}
+
+/*
+ * Update the congestion window value in the TCB structure. When cwnd < then
+ * ssthresh then we are in slow start. If greater then or equal to ssthresh
+ * then we are in congestion avoidance.
+ *
+ * RFC2581: pg 4
+ * During slow start, a TCP increments cwnd by at most SMSS bytes for
+ * each ACK received that acknowledges new data. Slow start ends when
+ * cwnd exceeds ssthresh (or, optionally, when it reaches it, as noted
+ * above) or when congestion is observed.
+ *
+ * During congestion avoidance, cwnd is incremented by 1 full-sized
+ * segment per round-trip time (RTT). Congestion avoidance continues
+ * until congestion is detected. One formula commonly used to update
+ * cwnd during congestion avoidance is given in equation 2:
+ *       cwnd += SMSS*SMSS/cwnd (2)
+ */
+static void
+reno_on_ack(struct tcb_entry *tcb, uint32_t acked)
+{
+    uint32_t cwnd = tcb->snd_cwnd;
+    uint32_t incr = CNE_MIN(acked, (uint32_t)tcb->max_mss);
+
+    /*
+     * When cwnd is <= to ssthresh, we are in slow-start else
+     * congestion avoidance.
+     */
+    if (cwnd > tcb->snd_ssthresh)
+        incr = tcb->max_mss * tcb->max_mss / cwnd; /* cwnd += SMSS*SMSS/cwnd (2) */
+
+    /* Increase the cwnd by SMSS value unless in congestion avoidance */
+    tcb->snd_cwnd = CNE_MIN((int)(cwnd + incr), TCP_MAXWIN << tcb->snd_scale);
+}
+
+/* RFC2581: pg 6
+ * 1. When the third duplicate ACK is received, set ssthresh to
+ *    no more than the value given in equation 3.
+ *
+ *     ssthresh = max (FlightSize / 2, 2*SMSS) (3)
+ */
+static void
+reno_on_loss(struct tcb_entry *tcb)
+{
+    uint32_t win = CNE_MIN(tcb->snd_wnd, tcb->snd_cwnd) / 2 / tcb->max_mss;
+
+    if (win < 2)
+        win = 2;
+    tcb->snd_ssthresh = win * tcb->max_mss;
+}
+
+/* RFC2581: pg 5
+ * When a TCP sender detects segment loss using the retransmission timer, the
+ * value of ssthresh MUST be set to no more than the value given in equation 3
+ * and cwnd MUST be set to no more than the loss window, which equals 1 segment.
+ */
+static void
+reno_on_rto(struct tcb_entry *tcb)
+{
+    reno_on_loss(tcb);
+    tcb->snd_cwnd = tcb->max_mss;
+}
+
+const struct tcp_cc_ops tcp_cc_reno = {
+    .name        = "reno",
+    .init        = reno_init,
+    .on_ack      = reno_on_ack,
+    .on_loss     = reno_on_loss,
+    .on_rto      = reno_on_rto,
+    .pacing_rate = tcp_cc_pacing_rate,
+};
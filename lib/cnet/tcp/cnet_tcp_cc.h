@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_TCP_CC_H
+#define __CNET_TCP_CC_H
+
+/**
+ * @file
+ * CNET TCP congestion control.
+ *
+ * A congestion control algorithm is a table of functions called by the TCP state machine on
+ * the congestion events of a TCB. Each TCB points at the algorithm it uses, selected per channel
+ * with the TCP_CONGESTION channel option, and keeps the algorithm state in tcb_entry.cc_priv.
+ * The loss recovery itself (fast retransmit, SACK recovery, RTO) stays in the state machine,
+ * the algorithm only sets snd_cwnd and snd_ssthresh.
+ */
+
+#include <stdint.h>           // for uint64_t, uint32_t
+#include <cne_common.h>       // for CNDP_API
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_CC_NAME_MAX  16     /**< Max length of an algorithm name with the null */
+#define TCP_CC_PRIV_SIZE 64     /**< Bytes of algorithm state held in a TCB */
+#define TCP_CC_DEFAULT   "reno" /**< Algorithm of a new TCB */
+
+struct tcb_entry;
+
+struct tcp_cc_ops {
+    const char *name; /**< Name given to the TCP_CONGESTION channel option */
+
+    /** Set the initial cwnd and ssthresh and clear the algorithm state */
+    void (*init)(struct tcb_entry *tcb);
+
+    /** New data was acknowledged outside of loss recovery, grow cwnd */
+    void (*on_ack)(struct tcb_entry *tcb, uint32_t acked);
+
+    /** Duplicate ACKs detected a loss, set ssthresh before the fast retransmit */
+    void (*on_loss)(struct tcb_entry *tcb);
+
+    /** The retransmit timer expired, set ssthresh and cwnd */
+    void (*on_rto)(struct tcb_entry *tcb);
+
+    /** Rate in bytes per second the data should be sent at, zero when unknown */
+    uint64_t (*pacing_rate)(struct tcb_entry *tcb);
+};
+
+extern const struct tcp_cc_ops tcp_cc_reno;  /**< NewReno, RFC5681 and RFC6582 */
+extern const struct tcp_cc_ops tcp_cc_cubic; /**< CUBIC, RFC8312 */
+
+/**
+ * Find a congestion control algorithm by name.
+ *
+ * @param name
+ *   The name of the algorithm, i.e. "reno" or "cubic".
+ * @return
+ *   The algorithm or NULL if not found.
+ */
+CNDP_API const struct tcp_cc_ops *tcp_cc_find(const char *name);
+
+/**
+ * Pacing rate from the congestion window and the smoothed RTT of the TCB, which is the rate
+ * of the algorithms not pacing on their own model.
+ *
+ * @param tcb
+ *   The TCB pointer.
+ * @return
+ *   The rate in bytes per second or zero when no RTT was measured yet.
+ */
+CNDP_API uint64_t tcp_cc_pacing_rate(struct tcb_entry *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_TCP_CC_H */
@@ -19,9 +19,10 @@
 #include <cnet_tcp.h>         // for tcb_entry, tcp_entry, cnet_tcb_new, tcp_a...
 #include <cnet_tcp_chnl.h>
 #include <cnet_chnl_opt.h>        // for cnet_chnl_opt_add, chnl_optval_get, chnl_...
+#include <cnet_meta.h>            // for cnet_metadata
 #include <errno.h>                // for ENOPROTOOPT, EINVAL, EFAULT, ENOBUFS, EIS...
 #include <netinet/in.h>           // for IPPROTO_TCP
-#include <string.h>               // for NULL, memcpy, size_t
+#include <string.h>               // for NULL, memcpy, size_t, strlen
 #include <sys/socket.h>           // for linger, MSG_DONTWAIT, SOL_SOCKET
 #include <sys/types.h>            // for ssize_t
 #include <pktdev.h>
@@ -54,13 +55,15 @@ cnet_drop_acked_data(struct chnl_buf *cb, int32_t acked)
 
     /* For the number of bytes acked we need to adjust the resend queue */
     for (idx = 0; acked > 0 && idx < len; idx++) {
+        struct cnet_metadata *md;
         pktmbuf_t *m;
         int32_t size;
 
         /* get the pointer to the packet on the send queue */
-        m = vec_at_index(cb->cb_vec, idx);
+        m  = vec_at_index(cb->cb_vec, idx);
+        md = pktmbuf_metadata(m);
 
-        size = pktmbuf_data_len(m);
+        size = md->snd_len;
         if (size == 0) {
             CNE_WARN("[magenta]mbuf [orange]%p [magenta]length is [orange]Zero[] @ [cyan]%d[]\n",
                      (void *)m, idx);
@@ -69,19 +72,22 @@ cnet_drop_acked_data(struct chnl_buf *cb, int32_t acked)
 
         size = CNE_MIN(size, acked);
 
-        if (pktmbuf_adj_offset(m, size) == NULL) {
-            CNE_ERR("Acked data %d > %d size of mbuf\n", acked, size);
-            break;
+        md->snd_off += size;
+        md->snd_len -= size;
+
+        /* A segment sent in place still owns the mbuf offsets until it is transmitted */
+        if (!tcp_snd_busy(m)) {
+            pktmbuf_data_off(m) = md->snd_off;
+            pktmbuf_data_len(m) = md->snd_len;
         }
-        CNE_DEBUG("Acked %d bytes, data offset %d, data len %d\n", size, pktmbuf_data_off(m),
-                  pktmbuf_data_len(m));
+        CNE_DEBUG("Acked %d bytes, data offset %d, data len %d\n", size, md->snd_off, md->snd_len);
 
         /* Adjust size to the amount acked */
         cb->cb_cc -= size;
         acked -= size;
 
         /* When data length becomes zero we can free this mbuf */
-        if (pktmbuf_data_len(m) == 0) {
+        if (md->snd_len == 0) {
             pktmbuf_refcnt_update(m, -1);
             free_cnt++;
         }
@@ -295,7 +301,8 @@ tcp_chnl_recv(struct chnl *ch, pktmbuf_t **mbufs, int nb_mbufs)
  * to be held waiting for ACKs to removed or adjusted based on ACKed data.
  *
  * This routine will enqueue the packets to the 'chnl_send' node to be passed to the
- * TCP output node.
+ * TCP output node. The data of mbufs sent with chnl_send_zc() is transmitted in place from
+ * the send buffer, else it is copied into a new mbuf for each segment.
  */
 static int
 tcp_chnl_send(struct chnl *ch, pktmbuf_t **mbufs, uint16_t nb_mbufs)
@@ -375,6 +382,9 @@ tcp_chnl_close(struct chnl *ch)
 static int
 tcp_chnl_opt_set(struct chnl *ch, int level, int optname, const void *optval, uint32_t optlen)
 {
+    char name[TCP_CC_NAME_MAX] = {0};
+    const struct tcp_cc_ops *cc;
+    struct tcb_entry *tcb;
     uint32_t val;
 
     if (!ch || ch->ch_proto->proto != IPPROTO_TCP)
@@ -404,6 +414,20 @@ tcp_chnl_opt_set(struct chnl *ch, int level, int optname, const void *optval, ui
         case TCBF_NOPUSH:
             setsockoptBit(ch->ch_pcb->opt_flag, TCP_NOPUSH_FLAG, val);
             break;
+        case TCP_CONGESTION:
+            if (!optval || optlen == 0)
+                return __errno_set(EINVAL);
+            memcpy(name, optval, CNE_MIN(optlen, sizeof(name) - 1));
+
+            cc = tcp_cc_find(name);
+            if (!cc)
+                return __errno_set(ENOENT);
+
+            /* Selected when the TCB is created, or now for an existing TCB */
+            ch->ch_pcb->cc = cc;
+            if ((tcb = ch->ch_pcb->tcb) != NULL)
+                tcp_cc_select(tcb, cc);
+            break;
         default:
             return __errno_set(ENOPROTOOPT);
         }
@@ -423,6 +447,7 @@ tcp_chnl_opt_get(struct chnl *ch, int level, int optname, void *optval, uint32_t
     void *resP           = (void *)opt;
     int *resI            = (int *)opt;
     struct tcp_info tcpi = {0};
+    const struct tcp_cc_ops *cc;
     struct tcb_entry *tcb;
     uint32_t len;
 
@@ -465,8 +490,10 @@ tcp_chnl_opt_get(struct chnl *ch, int level, int optname, void *optval, uint32_t
             *resI = ch->ch_pcb->opt_flag & TCP_NOPUSH_FLAG;
             break;
         case TCP_CONGESTION:
-            resP = (void *)(uintptr_t) "reno";
-            len  = 5;
+            tcb  = ch->ch_pcb->tcb;
+            cc   = (tcb) ? tcb->cc : ch->ch_pcb->cc;
+            resP = (void *)(uintptr_t)(cc ? cc->name : TCP_CC_DEFAULT);
+            len  = CNE_MIN(*optlen, (uint32_t)strlen(resP) + 1);
             break;
         case TCP_INFO:
             resP = (void *)&tcpi;
@@ -0,0 +1,132 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+/* cnet_tcp_cubic.c - CUBIC TCP congestion control, RFC8312. */
+
+#include <stdint.h>            // for uint64_t, uint32_t
+#include <string.h>            // for memset
+#include <cne_common.h>        // for CNE_MIN, CNE_MAX, CNE_BUILD_BUG_ON
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_system.h>        // for cne_get_timer_hz
+
+#include "cnet_tcp.h"           // for tcb_entry, TCP_MAXWIN
+#include "cnet_tcp_cc.h"        // for tcp_cc_ops, tcp_cc_reno
+#include "tcp_cubic_priv.h"     // for cubic, cubic_k, cubic_w, cubic_w_est_incr
+
+static inline struct cubic *
+cubic_get(struct tcb_entry *tcb)
+{
+    CNE_BUILD_BUG_ON(sizeof(struct cubic) > sizeof(tcb->cc_priv));
+
+    return (struct cubic *)tcb->cc_priv;
+}
+
+static inline uint64_t
+cubic_now(void)
+{
+    uint64_t hz = cne_get_timer_hz() / 1000;
+
+    return cne_rdtsc() / ((hz == 0) ? 1 : hz);
+}
+
+static void
+cubic_init(struct tcb_entry *tcb)
+{
+    memset(tcb->cc_priv, 0, sizeof(tcb->cc_priv));
+
+    /* Same initial window and slow start as Reno */
+    tcp_cc_reno.init(tcb);
+}
+
+/* Start a congestion avoidance epoch, W(t) grows from cwnd back to W_max in K milli-seconds */
+static void
+cubic_epoch(struct cubic *cu, struct tcb_entry *tcb)
+{
+    cu->epoch = cubic_now();
+    cu->w_est = tcb->snd_cwnd;
+
+    if (tcb->snd_cwnd < cu->w_max) {
+        cu->k      = cubic_k(cu->w_max, tcb->snd_cwnd, tcb->max_mss);
+        cu->origin = cu->w_max;
+    } else {
+        cu->k      = 0;
+        cu->origin = tcb->snd_cwnd;
+    }
+}
+
+/*
+ * RFC8312 pg 6-8, in congestion avoidance the window follows
+ *
+ *     W_cubic(t) = C * (t - K)^3 + W_max               (1)
+ *
+ * unless a Reno flow would have a larger window, the TCP friendly region.
+ */
+static void
+cubic_on_ack(struct tcb_entry *tcb, uint32_t acked)
+{
+    struct cubic *cu = cubic_get(tcb);
+    uint32_t cwnd    = tcb->snd_cwnd;
+    uint64_t target;
+
+    if (cwnd < tcb->snd_ssthresh) {
+        tcp_cc_reno.on_ack(tcb, acked);
+        return;
+    }
+
+    if (cu->epoch == 0)
+        cubic_epoch(cu, tcb);
+
+    target = cubic_w(cu->origin, cu->k, cubic_now() - cu->epoch, tcb->max_mss);
+
+    cu->w_est += cubic_w_est_incr(acked, tcb->max_mss, cwnd);
+    if (target < cu->w_est)
+        target = cu->w_est;
+
+    /* cwnd += (target - cwnd) / cwnd per segment acked, RFC8312 pg 8 */
+    if (target > cwnd)
+        tcb->snd_cwnd = CNE_MIN((uint64_t)cwnd + ((target - cwnd) * acked) / cwnd,
+                                (uint64_t)TCP_MAXWIN << tcb->snd_scale);
+}
+
+/*
+ * RFC8312 pg 9-10, on a loss the window is reduced by beta_cubic and with fast
+ * convergence W_max is lowered further when the previous W_max was not reached.
+ *
+ *     ssthresh = max(cwnd * beta_cubic, 2 * SMSS)
+ */
+static void
+cubic_on_loss(struct tcb_entry *tcb)
+{
+    struct cubic *cu = cubic_get(tcb);
+    uint32_t cwnd    = tcb->snd_cwnd;
+
+    cu->epoch = 0;
+
+    if (cwnd < cu->w_last_max)
+        cu->w_max = (uint32_t)(((uint64_t)cwnd * ((1 << CUBIC_SHIFT) + CUBIC_BETA)) >>
+                               (CUBIC_SHIFT + 1));
+    else
+        cu->w_max = cwnd;
+    cu->w_last_max = cwnd;
+
+    tcb->snd_ssthresh = CNE_MAX((uint32_t)(((uint64_t)cwnd * CUBIC_BETA) >> CUBIC_SHIFT),
+                                (uint32_t)(2 * tcb->max_mss));
+}
+
+/* RFC8312 pg 10, a timeout reduces as a loss and restarts from one segment */
+static void
+cubic_on_rto(struct tcb_entry *tcb)
+{
+    cubic_on_loss(tcb);
+    tcb->snd_cwnd = tcb->max_mss;
+}
+
+const struct tcp_cc_ops tcp_cc_cubic = {
+    .name        = "cubic",
+    .init        = cubic_init,
+    .on_ack      = cubic_on_ack,
+    .on_loss     = cubic_on_loss,
+    .on_rto      = cubic_on_rto,
+    .pacing_rate = tcp_cc_pacing_rate,
+};
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+/* cnet_tcp_wheel.c - Hierarchical timing wheel for the TCP timers. */
+
+#include <sys/queue.h>                    // for LIST_INSERT_HEAD, LIST_REMOVE, LIST_FIRST
+#include <stddef.h>                       // for NULL
+#include <stdint.h>                       // for uint64_t, uint32_t, uint16_t
+#include <cne_branch_prediction.h>        // for unlikely
+
+#include "cnet_tcp_wheel.h"
+
+/* Put a timer in the slot of its expire tick, the expire tick is not before now */
+static inline void
+wheel_insert(struct tcp_wheel *w, struct tcp_tmr *tmr)
+{
+    uint64_t delta = tmr->expire - w->now;
+    uint32_t level = 0;
+
+    while (level < (TCP_WHEEL_LEVELS - 1) && (delta >> (TCP_WHEEL_BITS * (level + 1))))
+        level++;
+
+    LIST_INSERT_HEAD(&w->slots[level][(tmr->expire >> (TCP_WHEEL_BITS * level)) & TCP_WHEEL_MASK],
+                     tmr, next);
+}
+
+void
+tcp_wheel_init(struct tcp_wheel *w)
+{
+    w->now   = 0;
+    w->count = 0;
+    for (int l = 0; l < TCP_WHEEL_LEVELS; l++)
+        for (int s = 0; s < (int)TCP_WHEEL_SLOTS; s++)
+            LIST_INIT(&w->slots[l][s]);
+}
+
+void
+tcp_wheel_add(struct tcp_wheel *w, struct tcp_tmr *tmr, uint64_t ticks, void *arg, uint16_t id)
+{
+    tcp_wheel_del(w, tmr);
+
+    if (ticks == 0)
+        ticks = 1;
+    else if (ticks > TCP_WHEEL_MAX)
+        ticks = TCP_WHEEL_MAX;
+
+    tmr->expire = w->now + ticks;
+    tmr->arg    = arg;
+    tmr->id     = id;
+
+    wheel_insert(w, tmr);
+    w->count++;
+}
+
+void
+tcp_wheel_del(struct tcp_wheel *w, struct tcp_tmr *tmr)
+{
+    if (!tcp_wheel_pending(tmr))
+        return;
+
+    LIST_REMOVE(tmr, next);
+    tmr->expire = 0;
+    w->count--;
+}
+
+void
+tcp_wheel_tick(struct tcp_wheel *w, tcp_wheel_fn fn)
+{
+    struct tcp_tmr_list *slot;
+    struct tcp_tmr *tmr;
+
+    w->now++;
+
+    /* Move the timers of the higher levels down when their slot comes up */
+    for (uint32_t level = 1; level < TCP_WHEEL_LEVELS; level++) {
+        if (w->now & ((1ULL << (TCP_WHEEL_BITS * level)) - 1))
+            break;
+
+        slot = &w->slots[level][(w->now >> (TCP_WHEEL_BITS * level)) & TCP_WHEEL_MASK];
+        while ((tmr = LIST_FIRST(slot)) != NULL) {
+            LIST_REMOVE(tmr, next);
+            wheel_insert(w, tmr);
+        }
+    }
+
+    if (unlikely(w->count == 0))
+        return;
+
+    slot = &w->slots[0][w->now & TCP_WHEEL_MASK];
+    while ((tmr = LIST_FIRST(slot)) != NULL) {
+        LIST_REMOVE(tmr, next);
+        tmr->expire = 0;
+        w->count--;
+
+        fn(tmr, tmr->arg, tmr->id);
+    }
+}
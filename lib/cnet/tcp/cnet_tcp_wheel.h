@@ -0,0 +1,116 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __CNET_TCP_WHEEL_H
+#define __CNET_TCP_WHEEL_H
+
+/**
+ * @file
+ * CNET TCP hierarchical timing wheel.
+ *
+ * The wheel has TCP_WHEEL_LEVELS levels of TCP_WHEEL_SLOTS slots. A timer expiring within
+ * TCP_WHEEL_SLOTS ticks sits in a slot of level 0, later timers sit in a higher level and are
+ * cascaded down as the wheel turns. Adding, stopping and expiring a timer is O(1) and a tick only
+ * touches the timers of one slot, whatever the number of armed timers.
+ */
+
+#include <sys/queue.h>        // for LIST_ENTRY, LIST_HEAD
+#include <stdint.h>           // for uint64_t, uint32_t, uint16_t
+#include <cne_common.h>       // for CNDP_API
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TCP_WHEEL_BITS   6                         /**< Number of bits of a slot index */
+#define TCP_WHEEL_SLOTS  (1U << TCP_WHEEL_BITS)    /**< Number of slots of a level */
+#define TCP_WHEEL_MASK   (TCP_WHEEL_SLOTS - 1)     /**< Slot index mask */
+#define TCP_WHEEL_LEVELS 4                         /**< Number of levels */
+#define TCP_WHEEL_MAX    ((1ULL << (TCP_WHEEL_BITS * TCP_WHEEL_LEVELS)) - 1) /**< Max ticks */
+
+struct tcp_tmr {
+    LIST_ENTRY(tcp_tmr) next; /**< Next timer in the same slot */
+    uint64_t expire;          /**< Tick the timer expires on, zero when stopped */
+    void *arg;                /**< Argument of the expire function */
+    uint16_t id;              /**< Timer id given to the expire function */
+};
+
+LIST_HEAD(tcp_tmr_list, tcp_tmr);
+
+struct tcp_wheel {
+    uint64_t now;                                                /**< Current tick */
+    uint32_t count;                                              /**< Number of armed timers */
+    struct tcp_tmr_list slots[TCP_WHEEL_LEVELS][TCP_WHEEL_SLOTS]; /**< Timer lists */
+};
+
+/**
+ * Function called for each timer expiring on a tick, the timer is already stopped and can be
+ * armed again from the function.
+ */
+typedef void (*tcp_wheel_fn)(struct tcp_tmr *tmr, void *arg, uint16_t id);
+
+/**
+ * Initialize an empty timing wheel.
+ *
+ * @param w
+ *   The timing wheel pointer.
+ */
+CNDP_API void tcp_wheel_init(struct tcp_wheel *w);
+
+/**
+ * Arm a timer on the wheel, a timer already armed is moved to the new expire tick.
+ *
+ * @param w
+ *   The timing wheel pointer.
+ * @param tmr
+ *   The timer to arm.
+ * @param ticks
+ *   Number of ticks from now the timer expires in, clamped to [1, TCP_WHEEL_MAX].
+ * @param arg
+ *   Argument given to the expire function.
+ * @param id
+ *   Timer id given to the expire function.
+ */
+CNDP_API void tcp_wheel_add(struct tcp_wheel *w, struct tcp_tmr *tmr, uint64_t ticks, void *arg,
+                            uint16_t id);
+
+/**
+ * Stop a timer, nothing is done if the timer is not armed.
+ *
+ * @param w
+ *   The timing wheel pointer.
+ * @param tmr
+ *   The timer to stop.
+ */
+CNDP_API void tcp_wheel_del(struct tcp_wheel *w, struct tcp_tmr *tmr);
+
+/**
+ * Turn the wheel by one tick and call the function for each timer expiring on the new tick.
+ *
+ * @param w
+ *   The timing wheel pointer.
+ * @param fn
+ *   The function to call for each expired timer.
+ */
+CNDP_API void tcp_wheel_tick(struct tcp_wheel *w, tcp_wheel_fn fn);
+
+/**
+ * Test if a timer is armed.
+ *
+ * @param tmr
+ *   The timer to test.
+ * @return
+ *   Non-zero if the timer is armed.
+ */
+static inline int
+tcp_wheel_pending(const struct tcp_tmr *tmr)
+{
+    return tmr->expire != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CNET_TCP_WHEEL_H */
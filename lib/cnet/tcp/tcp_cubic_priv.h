@@ -0,0 +1,100 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+#ifndef __INCLUDE_TCP_CUBIC_PRIV_H__
+#define __INCLUDE_TCP_CUBIC_PRIV_H__
+
+#include <stdint.h>            // for uint64_t, uint32_t, uint16_t
+#include <cne_common.h>        // for CNE_MIN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * RFC8312 constants, beta_cubic = 0.7 and C = 0.4. The TCP friendly increase
+ * alpha_aimd = 3 * (1 - beta_cubic) / (1 + beta_cubic) is 0.529.
+ */
+#define CUBIC_SHIFT     10         /**< Fixed point shift of beta_cubic and alpha_aimd */
+#define CUBIC_BETA      717        /**< beta_cubic << CUBIC_SHIFT */
+#define CUBIC_ALPHA     542        /**< alpha_aimd << CUBIC_SHIFT */
+#define CUBIC_C_NUM     4          /**< C = CUBIC_C_NUM / CUBIC_C_DEN */
+#define CUBIC_C_DEN     10         /**< C = CUBIC_C_NUM / CUBIC_C_DEN */
+#define CUBIC_MAX_DELTA (1U << 17) /**< Max milli-seconds from K used by W(t) */
+
+/* CUBIC state held in tcb_entry.cc_priv */
+struct cubic {
+    uint64_t epoch;      /**< Milli-seconds the congestion avoidance started, zero if not */
+    uint32_t w_max;      /**< Window before the last reduction in bytes */
+    uint32_t w_last_max; /**< w_max of the reduction before, for fast convergence */
+    uint32_t k;          /**< Milli-seconds W(t) takes to reach origin */
+    uint32_t origin;     /**< Window W(t) plateaus at in bytes */
+    uint32_t w_est;      /**< Window of a Reno flow in the same conditions in bytes */
+};
+
+/* Integer cube root, bit by bit */
+static inline uint32_t
+cubic_cbrt(uint64_t a)
+{
+    uint64_t y = 0;
+
+    for (int s = 63; s >= 0; s -= 3) {
+        uint64_t b;
+
+        y <<= 1;
+        b = 3 * y * (y + 1) + 1;
+        if ((a >> s) >= b) {
+            a -= b << s;
+            y++;
+        }
+    }
+    return (uint32_t)y;
+}
+
+/*
+ * Milli-seconds W(t) takes to grow from cwnd back to W_max, RFC8312 pg 6 equation 2.
+ *
+ *     K = cubic_root(W_max * (1 - beta_cubic) / C)
+ */
+static inline uint32_t
+cubic_k(uint32_t w_max, uint32_t cwnd, uint16_t mss)
+{
+    /* Milli-segments to grow, times 1e6 to take the root in milli-seconds */
+    uint64_t mseg = ((uint64_t)(w_max - cwnd) * 1000) / mss;
+
+    return cubic_cbrt((mseg * CUBIC_C_DEN * 1000000) / CUBIC_C_NUM);
+}
+
+/*
+ * Window in bytes t milli-seconds into the epoch, RFC8312 pg 6 equation 1.
+ *
+ *     W_cubic(t) = C * (t - K)^3 + W_max
+ */
+static inline uint64_t
+cubic_w(uint32_t origin, uint32_t k, uint64_t t, uint16_t mss)
+{
+    uint64_t d, off;
+
+    d = (t > k) ? t - k : k - t;
+    d = CNE_MIN(d, (uint64_t)CUBIC_MAX_DELTA);
+
+    /* C * d^3 in milli-segments, d in milli-seconds, then in bytes */
+    off = (((CUBIC_C_NUM * d * d * d) / (CUBIC_C_DEN * 1000000)) * mss) / 1000;
+
+    if (t < k)
+        return (off < origin) ? origin - off : 0;
+    return origin + off;
+}
+
+/* Bytes W_est grows by, alpha_aimd * segments acked / cwnd, RFC8312 pg 7 equation 4 */
+static inline uint32_t
+cubic_w_est_incr(uint32_t acked, uint16_t mss, uint32_t cwnd)
+{
+    return (uint32_t)(((uint64_t)CUBIC_ALPHA * acked * mss / cwnd) >> CUBIC_SHIFT);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_TCP_CUBIC_PRIV_H__ */
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cnet.h>              // for cnet_add_instance, cnet, per_thread_cnet
+#include <cnet_stk.h>          // for stk_t, this_stk, TCP_GRO_ENABLED
+#include <cnet_const.h>        // for is_clr
+#include <stdbool.h>           // for bool, false, true
+#include <stdint.h>            // for uint16_t, uint32_t
+
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node_enqueue, cne_node_next_stream_move
+#include <cne_common.h>              // for __cne_unused
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod
+
+#include <cnet_node_names.h>
+#include "tcp_gro_priv.h"        // for tcp_gro_flow, tcp_gro_merge, tcp_gro_flush
+
+/*
+ * Merge the in order data segments of a flow received in the same burst into one segment,
+ * to process them with a single PCB lookup and pass through the TCP state machine. The
+ * following segments are chained to the first one with the cnet_metadata.gro_next pointer
+ * and removed from the burst.
+ */
+static uint16_t
+tcp_gro_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                     uint16_t nb_objs)
+{
+    struct tcp_gro_flow flows[TCP_GRO_MAX_FLOWS];
+    pktmbuf_t **pkts  = (pktmbuf_t **)objs;
+    uint16_t nb_flows = 0, n = 0;
+
+    /* Nothing to merge, pass the burst to tcp_input as is */
+    if (is_clr(this_stk->gflags, TCP_GRO_ENABLED) || nb_objs < 2) {
+        cne_node_next_stream_move(graph, node, TCP_GRO_NEXT_TCP_INPUT);
+        return nb_objs;
+    }
+
+    for (uint16_t i = 0; i < nb_objs; i++) {
+        if (likely((i + 4) < nb_objs))
+            cne_prefetch0(pktmbuf_mtod(pkts[i + 4], void *));
+
+        if (!tcp_gro_merge(flows, &nb_flows, pkts[i]))
+            pkts[n++] = pkts[i];
+    }
+
+    /* Flush the flows still being merged at the end of the burst */
+    while (nb_flows)
+        tcp_gro_flush(flows, &nb_flows, &flows[0]);
+
+    if (n == nb_objs)
+        cne_node_next_stream_move(graph, node, TCP_GRO_NEXT_TCP_INPUT);
+    else
+        cne_node_enqueue(graph, node, TCP_GRO_NEXT_TCP_INPUT, objs, n);
+
+    return nb_objs;
+}
+
+static struct cne_node_register tcp_gro_node_base = {
+    .process = tcp_gro_node_process,
+    .name    = TCP_GRO_NODE_NAME,
+
+    .nb_edges = TCP_GRO_NEXT_MAX,
+    .next_nodes =
+        {
+            [TCP_GRO_NEXT_TCP_INPUT] = TCP_INPUT_NODE_NAME,
+        },
+};
+
+CNE_NODE_REGISTER(tcp_gro_node_base);
@@ -0,0 +1,304 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+#ifndef __INCLUDE_TCP_GRO_PRIV_H__
+#define __INCLUDE_TCP_GRO_PRIV_H__
+
+#include <endian.h>         // for be16toh, be32toh, htobe16
+#include <stdbool.h>        // for bool, false, true
+#include <stdint.h>         // for uint16_t, uint32_t
+#include <string.h>         // for memcpy, memcmp
+#include <cne_common.h>
+#include <cne_log.h>
+#include <cne_vec.h>
+#include <pktmbuf.h>
+#include <net/cne_ip.h>
+#include <net/cne_tcp.h>
+#include <cnet_stk.h>
+#include <cnet_meta.h>
+#include <cnet_pcb.h>
+#include <cnet_tcp.h>
+#include <chnl_priv.h>
+#include <tcp_input_priv.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum tcp_gro_next_nodes {
+    TCP_GRO_NEXT_TCP_INPUT,
+    TCP_GRO_NEXT_MAX,
+};
+
+#define TCP_GRO_MAX_FLOWS 8          /**< Flows being merged at the same time in a burst */
+#define TCP_GRO_MAX_LEN   UINT16_MAX /**< Max IPv4 total length of a merged segment */
+
+/* Function processing a TCP segment, cnet_tcp_input() */
+typedef int (*tcp_gro_input_fn)(struct pcb_entry *pcb, pktmbuf_t *mbuf);
+
+/*
+ * A segment merged by tcp_gro is the first mbuf of the flow, its IPv4 total length covers
+ * the payload of the segments chained to it with cnet_metadata.gro_next. The following
+ * segments are untouched and still start with their IPv4 header.
+ *
+ * Detach the segments following <m> and restore the IPv4 header of <m> to its own length.
+ * Returns the first following segment, the rest of the chain is still linked to it.
+ */
+static inline pktmbuf_t *
+tcp_gro_unchain(pktmbuf_t *m)
+{
+    struct cnet_metadata *md = pktmbuf_metadata(m);
+    struct cne_ipv4_hdr *ip  = pktmbuf_mtod(m, struct cne_ipv4_hdr *);
+    pktmbuf_t *next;
+
+    if (!md || !md->gro_next)
+        return NULL;
+
+    next         = md->gro_next;
+    md->gro_next = NULL;
+
+    if (be16toh(ip->total_length) != pktmbuf_data_len(m)) {
+        cne_be16_t len = htobe16(pktmbuf_data_len(m));
+
+        ip->hdr_checksum = cne_cksum_adjust16(ip->hdr_checksum, ip->total_length, len);
+        ip->total_length = len;
+    }
+
+    return next;
+}
+
+/* Free a chain of segments linked by cnet_metadata.gro_next */
+static inline void
+tcp_gro_free(pktmbuf_t *m)
+{
+    while (m) {
+        struct cnet_metadata *md = pktmbuf_metadata(m);
+        pktmbuf_t *next          = md->gro_next;
+
+        md->gro_next = NULL;
+        pktmbuf_free(m);
+        m = next;
+    }
+}
+
+/* A flow being merged in the current burst */
+struct tcp_gro_flow {
+    uint32_t src_addr; /* IPv4 source address in network order */
+    uint32_t dst_addr; /* IPv4 destination address in network order */
+    uint32_t ports;    /* TCP source and destination ports as found in the header */
+    uint32_t next_seq; /* Sequence number of the next in order segment */
+    uint16_t tot_len;  /* IPv4 total length of the merged segment */
+    pktmbuf_t *head;   /* Segment the following segments are merged into */
+    pktmbuf_t *tail;   /* Last segment merged into the head */
+};
+
+/* Stop merging into flow <f> and set the merged length in the IPv4 header of the head */
+static inline void
+tcp_gro_flush(struct tcp_gro_flow *flows, uint16_t *nb_flows, struct tcp_gro_flow *f)
+{
+    struct cne_ipv4_hdr *ip = pktmbuf_mtod(f->head, struct cne_ipv4_hdr *);
+
+    if (f->tail != f->head) {
+        cne_be16_t len = htobe16(f->tot_len);
+
+        ip->hdr_checksum = cne_cksum_adjust16(ip->hdr_checksum, ip->total_length, len);
+        ip->total_length = len;
+    }
+
+    *f = flows[--(*nb_flows)];
+}
+
+/*
+ * The segment can only be merged when the headers match the head of the flow, except for
+ * the sequence number, PSH flag and IPv4 fields updated per packet. The TCP options must be
+ * identical, as the timestamps of the segments sent in the same millisecond are.
+ */
+static inline bool
+tcp_gro_same(pktmbuf_t *head, struct cne_ipv4_hdr *ip, struct cne_tcp_hdr *tcp, uint16_t hlen)
+{
+    struct cne_ipv4_hdr *hip = pktmbuf_mtod(head, struct cne_ipv4_hdr *);
+    struct cne_tcp_hdr *htcp = (struct cne_tcp_hdr *)(hip + 1);
+
+    return (hip->type_of_service == ip->type_of_service) &&
+           (hip->time_to_live == ip->time_to_live) && (htcp->recv_ack == tcp->recv_ack) &&
+           (htcp->rx_win == tcp->rx_win) && (htcp->data_off == tcp->data_off) &&
+           (memcmp(&htcp[1], &tcp[1], hlen - sizeof(struct cne_tcp_hdr)) == 0);
+}
+
+/*
+ * Merge the segment <m> into the segment held for its flow in this burst, or start a flow
+ * with it. Any segment of the flow which can not be merged flushes the flow, to keep the
+ * segments in order. Returns true when <m> was chained to an earlier segment.
+ */
+static inline bool
+tcp_gro_merge(struct tcp_gro_flow *flows, uint16_t *nb_flows, pktmbuf_t *m)
+{
+    struct cne_ipv4_hdr *ip = pktmbuf_mtod(m, struct cne_ipv4_hdr *);
+    struct cne_tcp_hdr *tcp = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, m->l3_len);
+    struct tcp_gro_flow *f  = NULL;
+    uint16_t tot_len, hlen, plen = 0;
+    uint32_t ports;
+    bool ok;
+
+    memcpy(&ports, &tcp->src_port, sizeof(ports));
+
+    for (uint16_t i = 0; i < *nb_flows; i++) {
+        if (flows[i].ports == ports && flows[i].src_addr == ip->src_addr &&
+            flows[i].dst_addr == ip->dst_addr) {
+            f = &flows[i];
+            break;
+        }
+    }
+
+    /* Only segments with data and no IPv4 options, fragmentation or Ethernet padding */
+    tot_len = be16toh(ip->total_length);
+    hlen    = (tcp->data_off & 0xF0) >> 2;
+
+    ok = (ip->version_ihl == CNE_IPV4_VHL_DEF) && (tot_len == pktmbuf_data_len(m)) &&
+         !(ip->fragment_offset & htobe16(CNE_IPV4_HDR_MF_FLAG | CNE_IPV4_HDR_OFFSET_MASK)) &&
+         (hlen >= sizeof(struct cne_tcp_hdr)) && (tot_len > (sizeof(struct cne_ipv4_hdr) + hlen));
+    if (ok)
+        plen = tot_len - sizeof(struct cne_ipv4_hdr) - hlen;
+
+    if (f) {
+        /* Chain an in order segment with the same headers, a PSH ends the merged segment */
+        if (ok && (be32toh(tcp->sent_seq) == f->next_seq) &&
+            ((tcp->tcp_flags & ~TCP_PSH_FLAG) == TCP_ACK_FLAG) &&
+            ((f->tot_len + plen) <= TCP_GRO_MAX_LEN) && tcp_gro_same(f->head, ip, tcp, hlen) &&
+            (cne_ipv4_udptcp_cksum_verify(ip, tcp) == 0)) {
+            struct cnet_metadata *md = pktmbuf_metadata(f->tail);
+
+            md->gro_next = m;
+            f->tail      = m;
+            f->tot_len += plen;
+            f->next_seq += plen;
+            INC_TCP_STAT(rx_gro);
+
+            if (tcp->tcp_flags & TCP_PSH_FLAG)
+                tcp_gro_flush(flows, nb_flows, f);
+            return true;
+        }
+
+        /* An out of order segment or one with other flags ends the merged segment */
+        tcp_gro_flush(flows, nb_flows, f);
+    }
+
+    /* Start a flow with a segment holding only an ACK, when the flow table has room */
+    if (!ok || (tcp->tcp_flags != TCP_ACK_FLAG) || (*nb_flows >= TCP_GRO_MAX_FLOWS))
+        return false;
+
+    /* The checksum is verified once here, the merged segment can not be verified later */
+    if (cne_ipv4_udptcp_cksum_verify(ip, tcp))
+        return false;
+    m->ol_flags |= CNE_MBUF_F_RX_L4_CKSUM_GOOD;
+
+    f           = &flows[(*nb_flows)++];
+    f->src_addr = ip->src_addr;
+    f->dst_addr = ip->dst_addr;
+    f->ports    = ports;
+    f->next_seq = be32toh(tcp->sent_seq) + plen;
+    f->tot_len  = tot_len;
+    f->head     = m;
+    f->tail     = m;
+
+    return false;
+}
+
+/*
+ * A segment merged by the tcp_gro node is processed whole when it is the next data in
+ * sequence of an established connection and fits the receive window and buffer, then
+ * the merged data never needs to be trimmed or queued for reassembly.
+ */
+static inline bool
+tcp_gro_whole(struct pcb_entry *pcb, pktmbuf_t *mbuf)
+{
+    struct cne_ipv4_hdr *ip = pktmbuf_mtod(mbuf, struct cne_ipv4_hdr *);
+    struct cne_tcp_hdr *tcp = pktmbuf_mtod_offset(mbuf, struct cne_tcp_hdr *, mbuf->l3_len);
+    struct tcb_entry *tcb;
+    uint32_t len;
+
+    if (!pcb || !pcb->ch || (tcb = pcb->tcb) == NULL || (tcb->state != TCPS_ESTABLISHED) ||
+        vec_len(tcb->reassemble))
+        return false;
+
+    len = be16toh(ip->total_length) - mbuf->l3_len - ((tcp->data_off & 0xF0) >> 2);
+
+    return (be32toh(tcp->sent_seq) == tcb->rcv_nxt) && (len <= tcb->rcv_wnd) &&
+           (len <= cb_space(&pcb->ch->ch_rcv));
+}
+
+/*
+ * Process the segments merged by the tcp_gro node one at a time with <input>, which is
+ * cnet_tcp_input() outside of the tests. The segments with data for the channel are linked in order with cnet_metadata.gro_next and go to the chnl_recv
+ * node behind the first segment. When the first segment has no data for the channel, its
+ * data is trimmed and it only carries the segments following it.
+ */
+static inline int
+tcp_gro_split(struct pcb_entry *pcb, pktmbuf_t *mbuf, tcp_gro_input_fn input)
+{
+    struct cnet_metadata *md = pktmbuf_metadata(mbuf), *tmd = NULL;
+    struct pcb_hd *hd        = &this_stk->tcp->tcp_hd;
+    uint32_t gen             = hd->gen;
+    pktmbuf_t *head = mbuf, *first = NULL, *next;
+    struct in_caddr faddr, laddr;
+    int rc, head_rc = TCP_INPUT_CONSUMED;
+
+    /* The addresses of the first segment are set by tcp_input, it may be freed first */
+    in_caddr_copy(&faddr, &md->faddr);
+    in_caddr_copy(&laddr, &md->laddr);
+
+    for (; mbuf; mbuf = next) {
+        next = tcp_gro_unchain(mbuf);
+
+        /* A segment closed the connection, the sender retransmits the rest */
+        if (hd->gen != gen) {
+            pktmbuf_free(mbuf);
+            continue;
+        }
+
+        md = pktmbuf_metadata(mbuf);
+        in_caddr_copy(&md->faddr, &faddr);
+        in_caddr_copy(&md->laddr, &laddr);
+        mbuf->userptr = pcb;
+
+        rc = input(pcb, mbuf);
+        if (rc == TCP_INPUT_NEXT_CHNL_RECV && pcb->ch) {
+            if (tmd)
+                tmd->gro_next = mbuf;
+            else
+                first = mbuf;
+
+            /* The segment may carry the reassembled data handed off with it */
+            for (tmd = md; tmd->gro_next; tmd = pktmbuf_metadata(tmd->gro_next))
+                ;
+        } else if (rc == TCP_INPUT_NEXT_CHNL_RECV) {
+            tcp_gro_free(mbuf);
+            rc = TCP_INPUT_CONSUMED;
+        } else if (rc != TCP_INPUT_CONSUMED && mbuf != head)
+            pktmbuf_free(mbuf);
+
+        if (mbuf == head)
+            head_rc = rc;
+    }
+
+    if (!first || first == head)
+        return (first) ? TCP_INPUT_NEXT_CHNL_RECV : head_rc;
+
+    /* A first segment queued for reassembly is only followed by queued segments */
+    if (head_rc == TCP_INPUT_CONSUMED) {
+        tcp_gro_free(first);
+        CNE_ERR_RET_VAL(TCP_INPUT_CONSUMED, "In order data behind a queued segment\n");
+    }
+
+    pktmbuf_trim(head, pktmbuf_data_len(head));
+    md           = pktmbuf_metadata(head);
+    md->gro_next = first;
+
+    return TCP_INPUT_NEXT_CHNL_RECV;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_TCP_GRO_PRIV_H__ */
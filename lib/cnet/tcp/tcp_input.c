@@ -12,6 +12,7 @@
 #include <cnet_netif.h>           // for netif, cnet_ipv4_compare
 #include <netinet/in.h>           // for ntohs
 #include <stddef.h>               // for NULL
+#include <string.h>               // for memset
 
 #include <cne_graph.h>               // for
 #include <cne_graph_worker.h>        // for
@@ -29,21 +30,30 @@
 
 #include <cnet_node_names.h>
 #include "tcp_input_priv.h"
+#include "tcp_gro_priv.h"
 
-/* The TCP/IP Pseudo header */
-typedef struct tcpip4_s {
-    struct cne_ipv4_hdr ip4; /* IPv4 header */
-    struct cne_tcp_hdr tcp;  /* TCP header */
-} __cne_packed tcpip4_t;
+/* Send the segments merged by tcp_gro to the next node one at a time, in order */
+static inline uint16_t
+tcp_input_unchain(struct cne_graph *graph, struct cne_node *node, pktmbuf_t *m, cne_edge_t next)
+{
+    pktmbuf_t *n;
+
+    for (; m; m = n) {
+        n = tcp_gro_unchain(m);
+        cne_node_enqueue_x1(graph, node, next, m);
+    }
+
+    return TCP_INPUT_CONSUMED;
+}
 
 static inline uint16_t
-tcp_input_lookup(struct cne_node *node, pktmbuf_t *m, struct pcb_hd *hd)
+tcp_input_lookup(struct cne_graph *graph, struct cne_node *node, pktmbuf_t *m, struct pcb_hd *hd,
+                 struct pcb_key *key, struct pcb_entry *pcb, uint32_t gen)
 {
     struct cnet *cnet = this_cnet;
     tcpip4_t *tip;
-    struct pcb_key key = {0};
-    struct pcb_entry *pcb;
     struct cnet_metadata *md;
+    cne_edge_t next;
 
     md = pktmbuf_metadata(m);
     if (!md)
@@ -51,37 +61,47 @@ tcp_input_lookup(struct cne_node *node, pktmbuf_t *m, struct pcb_hd *hd)
 
     tip = pktmbuf_mtod(m, struct tcpip4_s *);
 
-    /* Convert this into AVX instructions */
-    in_caddr_update(&key.faddr, AF_INET, sizeof(struct in_addr), tip->tcp.src_port);
-    key.faddr.cin_addr.s_addr = tip->ip4.src_addr;
-    in_caddr_update(&key.laddr, AF_INET, sizeof(struct in_addr), tip->tcp.dst_port);
-    key.laddr.cin_addr.s_addr = tip->ip4.dst_addr;
-
     md->faddr.cin_port = be16toh(tip->tcp.src_port);
     md->laddr.cin_port = be16toh(tip->tcp.dst_port);
 
-    /* Create a 4x PCB lookup routine */
-    pcb = cnet_pcb_lookup(hd, &key, BEST_MATCH);
+    pcb = tcp_input_pcb(hd, key, pcb, gen);
     if (likely(pcb)) {
         int rc = TCP_INPUT_NEXT_PKT_DROP;
 
-        if (cne_ipv4_udptcp_cksum_verify(&tip->ip4, &tip->tcp))
+        /* The checksum of a segment merged by tcp_gro has been verified */
+        if (!(m->ol_flags & CNE_MBUF_F_RX_L4_CKSUM_GOOD) &&
+            cne_ipv4_udptcp_cksum_verify(&tip->ip4, &tip->tcp))
             return rc;
 
         m->userptr = pcb;
-        in_caddr_copy(&md->faddr, &key.faddr); /* Save the foreign address */
-        in_caddr_copy(&md->laddr, &key.laddr); /* Save the local address */
+        in_caddr_copy(&md->faddr, &key->faddr); /* Save the foreign address */
+        in_caddr_copy(&md->laddr, &key->laddr); /* Save the local address */
 
         /* returns one of the TCP_INPUT_NEXT_* values */
         rc = cnet_tcp_input(pcb, m);
 
-        CNE_DEBUG("cnet_tcp_input() returned [orange]%s[]\n", node->nodes[rc]->name);
+        CNE_DEBUG("cnet_tcp_input() returned [orange]%s[]\n",
+                  (rc < TCP_INPUT_NEXT_MAX) ? node->nodes[rc]->name : "consumed");
 
         return rc;
     }
 
     CNE_DEBUG("PCB lookup failed (%s)\n", (cnet->flags & CNET_PUNT_ENABLED) ? "Punt" : "Drop");
-    return (cnet->flags & CNET_PUNT_ENABLED) ? TCP_INPUT_NEXT_PKT_PUNT : TCP_INPUT_NEXT_PKT_DROP;
+    next = (cnet->flags & CNET_PUNT_ENABLED) ? TCP_INPUT_NEXT_PKT_PUNT : TCP_INPUT_NEXT_PKT_DROP;
+
+    /* The kernel gets the segments as received */
+    if (unlikely(md->gro_next))
+        return tcp_input_unchain(graph, node, m, next);
+
+    return next;
+}
+
+/* Enqueue a packet to the next node, unless TCP kept it */
+static __cne_always_inline void
+tcp_input_enqueue_x1(struct cne_graph *graph, struct cne_node *node, cne_edge_t next, void *obj)
+{
+    if (likely(next != TCP_INPUT_CONSUMED))
+        cne_node_enqueue_x1(graph, node, next, obj);
 }
 
 static uint16_t
@@ -93,8 +113,12 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     void **to_next, **from;
     struct pcb_hd *hd  = &this_stk->tcp->tcp_hd;
     uint16_t last_spec = 0;
+    struct pcb_key keys[CNE_HASH_LOOKUP_BULK_MAX];
+    struct pcb_entry *pcbs[CNE_HASH_LOOKUP_BULK_MAX];
+    uint16_t bulk = 0, nb_bulk = 0;
     uint16_t n_left_from;
     uint16_t held = 0;
+    uint32_t gen = 0;
 
     next_index = TCP_INPUT_NEXT_CHNL_RECV;
 
@@ -126,6 +150,13 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
             cne_prefetch0(pktmbuf_mtod_offset(pkts[7], void *, pkts[7]->l2_len));
         }
 
+        /* Lookup the PCBs of the next packets in bulk */
+        if (bulk == nb_bulk) {
+            nb_bulk = CNE_MIN(n_left_from, CNE_HASH_LOOKUP_BULK_MAX);
+            gen     = tcp_input_bulk_lookup(hd, pkts, nb_bulk, keys, pcbs);
+            bulk    = 0;
+        }
+
         mbuf0 = pkts[0];
         mbuf1 = pkts[1];
         mbuf2 = pkts[2];
@@ -134,10 +165,11 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         pkts += 4;
         n_left_from -= 4;
 
-        next0 = tcp_input_lookup(node, mbuf0, hd);
-        next1 = tcp_input_lookup(node, mbuf1, hd);
-        next2 = tcp_input_lookup(node, mbuf2, hd);
-        next3 = tcp_input_lookup(node, mbuf3, hd);
+        next0 = tcp_input_lookup(graph, node, mbuf0, hd, &keys[bulk], pcbs[bulk], gen);
+        next1 = tcp_input_lookup(graph, node, mbuf1, hd, &keys[bulk + 1], pcbs[bulk + 1], gen);
+        next2 = tcp_input_lookup(graph, node, mbuf2, hd, &keys[bulk + 2], pcbs[bulk + 2], gen);
+        next3 = tcp_input_lookup(graph, node, mbuf3, hd, &keys[bulk + 3], pcbs[bulk + 3], gen);
+        bulk += 4;
 
         /* Enqueue four to next node */
         cne_edge_t fix_spec = (next_index ^ next0) | (next_index ^ next1) | (next_index ^ next2) |
@@ -157,7 +189,7 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
                 to_next++;
                 held++;
             } else
-                cne_node_enqueue_x1(graph, node, next0, from[0]);
+                tcp_input_enqueue_x1(graph, node, next0, from[0]);
 
             /* Next1 */
             if (next_index == next1) {
@@ -165,7 +197,7 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
                 to_next++;
                 held++;
             } else
-                cne_node_enqueue_x1(graph, node, next1, from[1]);
+                tcp_input_enqueue_x1(graph, node, next1, from[1]);
 
             /* Next2 */
             if (next_index == next2) {
@@ -173,7 +205,7 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
                 to_next++;
                 held++;
             } else
-                cne_node_enqueue_x1(graph, node, next2, from[2]);
+                tcp_input_enqueue_x1(graph, node, next2, from[2]);
 
             /* Next3 */
             if (next_index == next3) {
@@ -181,7 +213,7 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
                 to_next++;
                 held++;
             } else
-                cne_node_enqueue_x1(graph, node, next3, from[3]);
+                tcp_input_enqueue_x1(graph, node, next3, from[3]);
 
             from += 4;
 
@@ -190,12 +222,19 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     }
 
     while (n_left_from > 0) {
+        if (bulk == nb_bulk) {
+            nb_bulk = CNE_MIN(n_left_from, CNE_HASH_LOOKUP_BULK_MAX);
+            gen     = tcp_input_bulk_lookup(hd, pkts, nb_bulk, keys, pcbs);
+            bulk    = 0;
+        }
+
         mbuf0 = pkts[0];
 
         pkts += 1;
         n_left_from -= 1;
 
-        next0 = tcp_input_lookup(node, mbuf0, hd);
+        next0 = tcp_input_lookup(graph, node, mbuf0, hd, &keys[bulk], pcbs[bulk], gen);
+        bulk++;
 
         if (unlikely(next_index ^ next0)) {
             /* Copy things successfully speculated till now */
@@ -205,7 +244,7 @@ tcp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
             held += last_spec;
             last_spec = 0;
 
-            cne_node_enqueue_x1(graph, node, next0, from[0]);
+            tcp_input_enqueue_x1(graph, node, next0, from[0]);
             from += 1;
         } else
             last_spec += 1;
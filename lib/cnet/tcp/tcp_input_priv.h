@@ -4,7 +4,16 @@
 #ifndef __INCLUDE_TCP_INPUT_PRIV_H__
 #define __INCLUDE_TCP_INPUT_PRIV_H__
 
+#include <stdint.h>        // for uint16_t, uint32_t
+#include <string.h>        // for memset
 #include <cne_common.h>
+#include <cne_branch_prediction.h>
+#include <cne_hash.h>
+#include <cne_inet.h>
+#include <pktmbuf.h>
+#include <net/cne_ip.h>
+#include <net/cne_tcp.h>
+#include <cnet_pcb.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +29,52 @@ enum tcp_input_next_nodes {
 /** Use TCP_INPUT_NEXT_MAX to call tcp_output in the cnet_tcp_input() */
 #define TCP_CHECK_OUTPUT_AND_DROP TCP_INPUT_NEXT_MAX
 
+/** Returned by cnet_tcp_input() when TCP kept the mbuf, e.g. for reassembly */
+#define TCP_INPUT_CONSUMED (TCP_INPUT_NEXT_MAX + 1)
+
+/* The TCP/IP Pseudo header */
+typedef struct tcpip4_s {
+    struct cne_ipv4_hdr ip4; /* IPv4 header */
+    struct cne_tcp_hdr tcp;  /* TCP header */
+} __cne_packed tcpip4_t;
+
+/* Build the PCB keys of the packets and look them up in bulk, returns the PCB generation */
+static inline uint32_t
+tcp_input_bulk_lookup(struct pcb_hd *hd, pktmbuf_t **pkts, uint16_t nb_pkts, struct pcb_key *keys,
+                      struct pcb_entry **pcbs)
+{
+    struct pcb_key *kp[CNE_HASH_LOOKUP_BULK_MAX];
+    tcpip4_t *tip;
+
+    for (uint16_t i = 0; i < nb_pkts; i++) {
+        tip = pktmbuf_mtod(pkts[i], struct tcpip4_s *);
+
+        memset(&keys[i], 0, sizeof(struct pcb_key));
+        in_caddr_update(&keys[i].faddr, AF_INET, sizeof(struct in_addr), tip->tcp.src_port);
+        keys[i].faddr.cin_addr.s_addr = tip->ip4.src_addr;
+        in_caddr_update(&keys[i].laddr, AF_INET, sizeof(struct in_addr), tip->tcp.dst_port);
+        keys[i].laddr.cin_addr.s_addr = tip->ip4.dst_addr;
+        kp[i] = &keys[i];
+    }
+
+    cnet_pcb_lookup_bulk(hd, kp, nb_pkts, pcbs, 0);
+
+    return hd->gen;
+}
+
+/*
+ * The PCB found for a segment by tcp_input_bulk_lookup() with the generation <gen>. The key
+ * is looked up again when an earlier segment of the burst opened or closed a connection.
+ */
+static inline struct pcb_entry *
+tcp_input_pcb(struct pcb_hd *hd, struct pcb_key *key, struct pcb_entry *pcb, uint32_t gen)
+{
+    if (unlikely(hd->gen != gen))
+        cnet_pcb_lookup_bulk(hd, &key, 1, &pcb, 0);
+
+    return pcb;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@
 #include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_data_len
 #include <pktmbuf_ptype.h>
 #include <cnet_tcp.h>
+#include <cnet_meta.h>               // for cnet_metadata
 
 #include <cnet_node_names.h>
 #include "tcp_output_priv.h"
@@ -34,10 +35,15 @@
 static inline void
 tcp_enqueue(pktmbuf_t *m, struct pcb_entry *pcb)
 {
+    struct cnet_metadata *md = pktmbuf_metadata(m);
     struct chnl_buf *cb;
 
     cb = &pcb->ch->ch_snd;
 
+    /* The unacked data is tracked in the metadata, the mbuf offsets change when sent in place */
+    md->snd_off = pktmbuf_data_off(m);
+    md->snd_len = pktmbuf_data_len(m);
+
     vec_add(cb->cb_vec, m);
     cb->cb_cc += pktmbuf_data_len(m);
 
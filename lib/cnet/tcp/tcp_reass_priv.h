@@ -0,0 +1,191 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+#ifndef __INCLUDE_TCP_REASS_PRIV_H__
+#define __INCLUDE_TCP_REASS_PRIV_H__
+
+#include <stdint.h>        // for uint32_t, int32_t
+#include <string.h>        // for memmove
+#include <cne_common.h>
+#include <cne_vec.h>
+#include <pktmbuf.h>
+#include <cnet_stk.h>
+#include <cnet_meta.h>
+#include <cnet_pcb.h>
+#include <cnet_tcp.h>
+#include <chnl_priv.h>
+#include <tcp_input_priv.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Free the segments of the reassembly queue.
+ */
+static inline void
+tcp_reass_flush(struct tcb_entry *tcb)
+{
+    struct tcp_reass *r;
+
+    vec_foreach (r, tcb->reassemble)
+        pktmbuf_free(r->mbuf);
+    vec_set_len(tcb->reassemble, 0);
+    tcb->reass_bytes = 0;
+}
+
+/*
+ * Queue the out of order segment <seg->mbuf> in the reassembly queue, which is kept
+ * sorted by sequence number without overlaps. Data already received or held by the
+ * queue is trimmed from the segment and queued segments it covers are replaced.
+ */
+static inline int
+tcp_reassemble(struct seg_entry *seg, struct tcb_entry *tcb)
+{
+    struct chnl_buf *cb = &seg->pcb->ch->ch_rcv;
+    struct tcp_reass *q = tcb->reassemble;
+    pktmbuf_t *mbuf     = seg->mbuf;
+    uint32_t nb         = vec_len(q);
+    seq_t seq           = seg->seq;
+    uint32_t lo, hi, n, len;
+    int32_t i;
+
+    len = pktmbuf_data_len(mbuf);
+
+    /* Hold no more segments or data than the receive buffer can take */
+    if ((nb >= CNET_TCP_REASSEMBLE_COUNT) || ((cb->cb_cc + tcb->reass_bytes + len) > cb->cb_hiwat))
+        goto drop;
+
+    /* Trim the data already received */
+    i = tcb->rcv_nxt - seq;
+    if (i > 0) {
+        if (i >= (int32_t)len)
+            goto drop;
+        pktmbuf_adj_offset(mbuf, i);
+        ADD_TCP_STAT(ooo_dropped, i);
+        seq += i;
+        len -= i;
+    }
+
+    /* Find the first queued segment starting after this one */
+    lo = 0;
+    hi = nb;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+
+        if (seqGT(q[mid].seq, seq))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    /* Trim the front of the segment overlapping the previous one */
+    if (lo > 0) {
+        struct tcp_reass *r = &q[lo - 1];
+
+        i = (r->seq + r->len) - seq;
+        if (i > 0) {
+            if (i >= (int32_t)len)
+                goto drop;
+            pktmbuf_adj_offset(mbuf, i);
+            ADD_TCP_STAT(ooo_dropped, i);
+            seq += i;
+            len -= i;
+        }
+    }
+
+    /* Free the following segments covered by this one and trim a partial overlap */
+    for (n = lo; n < nb; n++) {
+        struct tcp_reass *r = &q[n];
+
+        i = (seq + len) - r->seq;
+        if (i <= 0)
+            break;
+        if (i < (int32_t)r->len) {
+            /* Only possible when both start at the same sequence and nothing was freed */
+            if (i >= (int32_t)len)
+                goto drop;
+            pktmbuf_trim(mbuf, i);
+            ADD_TCP_STAT(ooo_dropped, i);
+            len -= i;
+            break;
+        }
+        ADD_TCP_STAT(ooo_dropped, r->len);
+        tcb->reass_bytes -= r->len;
+        pktmbuf_free(r->mbuf);
+    }
+
+    /* Replace the covered segments [lo, n) with this one */
+    if (n == lo) {
+        vec_inc_len(q);
+        memmove(&q[lo + 1], &q[lo], (nb - lo) * sizeof(struct tcp_reass));
+    } else if (n > lo + 1) {
+        memmove(&q[lo + 1], &q[n], (nb - n) * sizeof(struct tcp_reass));
+        vec_set_len(q, nb - (n - lo) + 1);
+    }
+    q[lo].seq  = seq;
+    q[lo].len  = len;
+    q[lo].mbuf = mbuf;
+
+    tcb->reass_bytes += len;
+    tcb->rcv_lastsack = seq;
+    ADD_TCP_STAT(ooo_queued, len);
+
+    seg->mbuf = NULL; /* Consumed the packet */
+    return TCP_INPUT_CONSUMED;
+
+drop:
+    ADD_TCP_STAT(ooo_dropped, len);
+    return TCP_INPUT_NEXT_PKT_DROP;
+}
+
+/*
+ * The segment <seg->mbuf> starts at RCV.NXT and fills the hole in front of the
+ * reassembly queue. Link the queued segments now in sequence behind it with
+ * cnet_metadata.gro_next, the chnl_callback node adds them to the channel receive
+ * buffer in order, after the segments of the burst already sent to the channel.
+ */
+static inline int
+tcp_reass_handoff(struct seg_entry *seg, struct tcb_entry *tcb)
+{
+    struct cnet_metadata *md = pktmbuf_metadata(seg->mbuf);
+    struct tcp_reass *r;
+    uint32_t n = 0;
+    int32_t i;
+
+    tcb->rcv_nxt += pktmbuf_data_len(seg->mbuf);
+    seg->mbuf = NULL; /* Consumed the packet */
+
+    vec_foreach (r, tcb->reassemble) {
+        if (seqGT(r->seq, tcb->rcv_nxt))
+            break;
+        n++;
+        tcb->reass_bytes -= r->len;
+
+        /* The new segment may overlap the front of a queued one */
+        i = tcb->rcv_nxt - r->seq;
+        if (i >= (int32_t)r->len) {
+            ADD_TCP_STAT(ooo_dropped, r->len);
+            pktmbuf_free(r->mbuf);
+            continue;
+        }
+        if (i > 0) {
+            pktmbuf_adj_offset(r->mbuf, i);
+            ADD_TCP_STAT(ooo_dropped, i);
+            r->len -= i;
+        }
+
+        tcb->rcv_nxt += r->len;
+        md->gro_next = r->mbuf;
+        md           = pktmbuf_metadata(r->mbuf);
+    }
+    vec_remove(tcb->reassemble, n);
+
+    return TCP_INPUT_NEXT_CHNL_RECV;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_TCP_REASS_PRIV_H__ */
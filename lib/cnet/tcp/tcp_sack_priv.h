@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+#ifndef __INCLUDE_TCP_SACK_PRIV_H__
+#define __INCLUDE_TCP_SACK_PRIV_H__
+
+#include <stdbool.h>        // for bool
+#include <stdint.h>         // for uint32_t
+#include <string.h>         // for memmove
+#include <cnet_tcp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The send scoreboard of RFC6675 is tcb->snd_sacks[], the blocks SACKed by the peer above
+ * snd_una, sorted by sequence number without overlaps.
+ */
+
+/*
+ * Merge the block <blk> into the send scoreboard, which is kept sorted by sequence
+ * number without overlaps. A full scoreboard forgets its highest block, the data of
+ * a forgotten block is only retransmitted again.
+ */
+static inline void
+tcp_sack_insert(struct tcb_entry *tcb, struct tcp_sack_blk *blk)
+{
+    struct tcp_sack_blk *sb = tcb->snd_sacks;
+    int n                   = tcb->snd_numsacks;
+    int lo, hi;
+
+    /* Find the first block ending at or after the new one */
+    for (lo = 0; lo < n && seqLT(sb[lo].end, blk->start); lo++)
+        ;
+
+    /* Blocks [lo, hi) overlap or touch the new block and are merged in it */
+    for (hi = lo; hi < n && seqLEQ(sb[hi].start, blk->end); hi++) {
+        if (seqLT(sb[hi].start, blk->start))
+            blk->start = sb[hi].start;
+        if (seqGT(sb[hi].end, blk->end))
+            blk->end = sb[hi].end;
+    }
+
+    if (hi == lo) {
+        if (n == TCP_SACK_BLKS) {
+            if (lo == n)
+                return;
+            n--;
+        }
+        memmove(&sb[lo + 1], &sb[lo], (n - lo) * sizeof(struct tcp_sack_blk));
+        n++;
+    } else if (hi > lo + 1) {
+        memmove(&sb[lo + 1], &sb[hi], (n - hi) * sizeof(struct tcp_sack_blk));
+        n -= hi - lo - 1;
+    }
+    sb[lo]            = *blk;
+    tcb->snd_numsacks = n;
+}
+
+/*
+ * Update the send scoreboard from the segment, drop the blocks below the cumulative
+ * ACK and add the SACK blocks of the segment, RFC6675 pg 6 Update().
+ */
+static inline void
+tcp_sack_update(struct tcb_entry *tcb, struct seg_entry *seg)
+{
+    struct tcp_sack_blk *sb = tcb->snd_sacks;
+    seq_t ack               = seqLT(seg->ack, tcb->snd_una) ? tcb->snd_una : seg->ack;
+    int i, n = 0;
+
+    if (seqGT(ack, tcb->snd_max))
+        return;
+
+    for (i = 0; i < tcb->snd_numsacks; i++) {
+        if (seqLEQ(sb[i].end, ack))
+            continue;
+        sb[n] = sb[i];
+        if (seqLT(sb[n].start, ack))
+            sb[n].start = ack;
+        n++;
+    }
+    tcb->snd_numsacks = n;
+
+    for (i = 0; i < seg->nb_sacks; i++) {
+        struct tcp_sack_blk blk = seg->sacks[i];
+
+        /* Ignore the blocks already acknowledged or above the data sent */
+        if (seqLEQ(blk.end, ack) || seqGT(blk.end, tcb->snd_max))
+            continue;
+        if (seqLT(blk.start, ack))
+            blk.start = ack;
+
+        tcp_sack_insert(tcb, &blk);
+    }
+}
+
+/*
+ * Find the next hole to retransmit in SACK recovery, the first data not SACKed and
+ * not retransmitted yet below a SACKed block, RFC6675 pg 7 NextSeg().
+ */
+static inline bool
+tcp_sack_nexthole(struct tcb_entry *tcb, seq_t *start, seq_t *end)
+{
+    seq_t seq = seqGT(tcb->sack_high_rxt, tcb->snd_una) ? tcb->sack_high_rxt : tcb->snd_una;
+
+    for (int i = 0; i < tcb->snd_numsacks; i++) {
+        struct tcp_sack_blk *sb = &tcb->snd_sacks[i];
+
+        if (seqLT(seq, sb->start)) {
+            *start = seq;
+            *end   = sb->start;
+            return true;
+        }
+        if (seqLT(seq, sb->end))
+            seq = sb->end;
+    }
+    return false;
+}
+
+/*
+ * Estimate the data in flight, the SACKed data and the holes below a SACKed block
+ * have left the network unless retransmitted, RFC6675 pg 7 SetPipe().
+ */
+static inline uint32_t
+tcp_sack_pipe(struct tcb_entry *tcb)
+{
+    uint32_t pipe = tcb->snd_max - tcb->snd_una;
+    seq_t rxt     = seqGT(tcb->sack_high_rxt, tcb->snd_una) ? tcb->sack_high_rxt : tcb->snd_una;
+    seq_t seq     = tcb->snd_una;
+
+    for (int i = 0; i < tcb->snd_numsacks; i++) {
+        struct tcp_sack_blk *sb = &tcb->snd_sacks[i];
+
+        pipe -= sb->end - sb->start;
+        if (seqLT(rxt, sb->start))
+            pipe -= sb->start - (seqGT(rxt, seq) ? rxt : seq);
+        seq = sb->end;
+    }
+    return pipe;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_TCP_SACK_PRIV_H__ */
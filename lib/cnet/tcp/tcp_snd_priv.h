@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+#ifndef __INCLUDE_TCP_SND_PRIV_H__
+#define __INCLUDE_TCP_SND_PRIV_H__
+
+#include <string.h>        // for memcpy
+#include <cne_common.h>
+#include <cne_vec.h>
+#include <pktmbuf.h>
+#include <cnet_const.h>
+#include <cnet_meta.h>
+#include <cnet_tcp.h>
+#include <chnl_priv.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The unacked data of each mbuf of a TCP send buffer is at cnet_metadata.snd_off and
+ * snd_len, the mbuf data offset and length describe the segment while it is sent in place.
+ */
+
+/*
+ * Skip to the offset in the send buffer and copy the unacked data to the buffer. The send
+ * buffer is only changed by the stack thread, which runs the output, so no lock is needed.
+ */
+static inline int
+tcp_mbuf_copydata(struct chnl_buf *cb, uint32_t off, uint32_t len, char *buf)
+{
+    struct cnet_metadata *md = NULL;
+    uint32_t total = 0, cnt;
+    int i, n = vec_len(cb->cb_vec);
+
+    /* skip to the offset location */
+    for (i = 0; i < n; i++) {
+        md = pktmbuf_metadata(vec_at_index(cb->cb_vec, i));
+
+        if (off < md->snd_len)
+            break;
+
+        off -= md->snd_len;
+    }
+
+    for (; i < n && len > 0; i++) {
+        pktmbuf_t *m = vec_at_index(cb->cb_vec, i);
+
+        md  = pktmbuf_metadata(m);
+        cnt = CNE_MIN(md->snd_len - off, len);
+
+        memcpy(buf, (char *)pktmbuf_buf_addr(m) + md->snd_off + off, cnt);
+
+        total += cnt;
+        len -= cnt;
+        buf += cnt;
+        off = 0;
+    }
+
+    return total;
+}
+
+/*
+ * Reference the send buffer mbuf holding the data at the offset to transmit the data in place,
+ * the headers are prepended in the mbuf headroom. Only the data at the start of the unacked
+ * data of an mbuf given with chnl_send_zc() is sent in place, as the headers overwrite what is
+ * before it, and the length is trimmed to the end of the mbuf. Returns NULL if the data must be
+ * copied or the mbuf is still being transmitted by a previous segment.
+ */
+static inline pktmbuf_t *
+tcp_mbuf_ref(struct chnl_buf *cb, uint32_t off, int32_t *len, uint16_t hdrlen)
+{
+    struct cnet_metadata *md = NULL;
+    pktmbuf_t *m             = NULL;
+    int n                    = vec_len(cb->cb_vec);
+
+    for (int i = 0; i < n; i++) {
+        m  = vec_at_index(cb->cb_vec, i);
+        md = pktmbuf_metadata(m);
+
+        if (off < md->snd_len)
+            break;
+
+        off -= md->snd_len;
+        m = NULL;
+    }
+
+    if (!m || off || !is_set(md->flags, CNET_META_ZCOPY) || tcp_snd_busy(m))
+        return NULL;
+
+    /* The metadata can be held at the start of the headroom */
+    if (md->snd_off < (hdrlen + sizeof(struct cnet_metadata)))
+        return NULL;
+
+    *len = CNE_MIN(*len, (int32_t)md->snd_len);
+
+    pktmbuf_refcnt_update(m, 1);
+    pktmbuf_data_off(m) = md->snd_off;
+    pktmbuf_data_len(m) = *len;
+    m->ol_flags         = 0;
+    m->tx_offload       = 0;
+
+    return m;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_TCP_SND_PRIV_H__ */
@@ -34,6 +34,7 @@ udp_create(void *_stk)
 {
     stk_t *stk = _stk;
     struct protosw_entry *psw;
+    char name[CNE_HASH_NAMESIZE];
 
     stk->udp = calloc(1, sizeof(struct udp_entry));
     if (stk->udp == NULL) {
@@ -51,6 +52,13 @@ udp_create(void *_stk)
     stk->udp->snd_size          = MAX_UDP_SND_SIZE;
     stk->udp->udp_hd.local_port = _IPPORT_RESERVED;
 
+    snprintf(name, sizeof(name), "udp_pcb_%s", stk->name);
+    if (cnet_pcb_hd_create(&stk->udp->udp_hd, name, CNET_NUM_CHANNELS) < 0) {
+        free(stk->udp);
+        stk->udp = NULL;
+        return -1;
+    }
+
     return 0;
 }
 
@@ -66,6 +74,7 @@ udp_destroy(void *_stk)
             free(p);
         vec_free(stk->udp->udp_hd.vec);
         stk->udp->udp_hd.vec = NULL;
+        cnet_pcb_hd_destroy(&stk->udp->udp_hd);
         free(stk->udp);
         stk->udp = NULL;
     }
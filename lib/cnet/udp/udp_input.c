@@ -12,13 +12,14 @@
 #include <cnet_netif.h>           // for netif, cnet_ipv4_compare
 #include <netinet/in.h>           // for ntohs
 #include <stddef.h>               // for NULL
+#include <string.h>               // for memset
 
 #include "../chnl/chnl_priv.h"
 #include <cnet_chnl.h>
 #include <cne_graph.h>               // for
 #include <cne_graph_worker.h>        // for
 #include <cne_common.h>              // for __cne_unused
-#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <net/cne_ip.h>              // for cne_ipv4_hdr, cne_ipv4_udptcp_cksum_verify
 #include <net/cne_udp.h>
 #include <cne_log.h>          // for CNE_LOG, CNE_LOG_DEBUG
 #include <cnet_ipv4.h>        // for IPv4_VER_LEN_VALUE
@@ -38,13 +39,34 @@ typedef struct udpip4_s {
     struct cne_udp_hdr udp;  /* UDP header */
 } __cne_packed udpip4_t;
 
+/* Build the PCB keys of the packets and look them up in bulk */
+static inline void
+udp_input_bulk_lookup(struct pcb_hd *hd, pktmbuf_t **pkts, uint16_t nb_pkts, struct pcb_key *keys,
+                      struct pcb_entry **pcbs)
+{
+    struct pcb_key *kp[CNE_HASH_LOOKUP_BULK_MAX];
+    udpip4_t *uip;
+
+    for (uint16_t i = 0; i < nb_pkts; i++) {
+        /* Assume we point to the L3 header here */
+        uip = pktmbuf_mtod(pkts[i], struct udpip4_s *);
+
+        memset(&keys[i], 0, sizeof(struct pcb_key));
+        in_caddr_update(&keys[i].faddr, AF_INET, sizeof(struct in_caddr), uip->udp.src_port);
+        keys[i].faddr.cin_addr.s_addr = uip->ip4.src_addr;
+        in_caddr_update(&keys[i].laddr, AF_INET, sizeof(struct in_caddr), uip->udp.dst_port);
+        keys[i].laddr.cin_addr.s_addr = uip->ip4.dst_addr;
+        kp[i] = &keys[i];
+    }
+
+    cnet_pcb_lookup_bulk(hd, kp, nb_pkts, pcbs, 0);
+}
+
 static inline uint16_t
-udp_input_lookup(pktmbuf_t *m, struct pcb_hd *hd)
+udp_input_lookup(pktmbuf_t *m, struct pcb_key *key, struct pcb_entry *pcb)
 {
     struct cnet *cnet = this_cnet;
     udpip4_t *uip;
-    struct pcb_key key = {0};
-    struct pcb_entry *pcb;
     struct cnet_metadata *md;
 
     md = pktmbuf_metadata(m);
@@ -54,25 +76,19 @@ udp_input_lookup(pktmbuf_t *m, struct pcb_hd *hd)
     /* Assume we point to the L3 header here */
     uip = pktmbuf_mtod(m, struct udpip4_s *);
 
-    /* Convert this into AVX instructions */
-    in_caddr_update(&key.faddr, AF_INET, sizeof(struct in_caddr), uip->udp.src_port);
-    key.faddr.cin_addr.s_addr = uip->ip4.src_addr;
-    in_caddr_update(&key.laddr, AF_INET, sizeof(struct in_caddr), uip->udp.dst_port);
-    key.laddr.cin_addr.s_addr = uip->ip4.dst_addr;
-
     md->faddr.cin_port = be16toh(uip->udp.src_port);
     md->laddr.cin_port = be16toh(uip->udp.dst_port);
 
-    /* Create a 4x PCB lookup routine */
-    pcb = cnet_pcb_lookup(hd, &key, BEST_MATCH);
     if (likely(pcb)) {
-        if ((pcb->opt_flag & UDP_CHKSUM_FLAG) && uip->udp.dgram_cksum) {
-            if (cne_ipv4_udptcp_cksum_verify(&uip->ip4, &uip->udp))
-                return UDP_INPUT_NEXT_PKT_DROP;
-        }
+        /*
+         * A datagram with a bad checksum is dropped even when the channel does not send
+         * checksums (RFC 1122 4.1.3.4), only a zero checksum means the sender did not set it.
+         */
+        if (uip->udp.dgram_cksum && cne_ipv4_udptcp_cksum_verify(&uip->ip4, &uip->udp))
+            return UDP_INPUT_NEXT_PKT_DROP;
         m->userptr = pcb;
-        in_caddr_copy(&md->faddr, &key.faddr); /* Save the foreign address */
-        in_caddr_copy(&md->laddr, &key.laddr); /* Save the local address */
+        in_caddr_copy(&md->faddr, &key->faddr); /* Save the foreign address */
+        in_caddr_copy(&md->laddr, &key->laddr); /* Save the local address */
 
         /* skip to the Payload by skipping the L3 + L4 headers */
         pktmbuf_adj_offset(m, m->l3_len + m->l4_len);
@@ -94,6 +110,9 @@ udp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     void **to_next, **from;
     struct pcb_hd *hd  = &this_stk->udp->udp_hd;
     uint16_t last_spec = 0;
+    struct pcb_key keys[CNE_HASH_LOOKUP_BULK_MAX];
+    struct pcb_entry *pcbs[CNE_HASH_LOOKUP_BULK_MAX];
+    uint16_t bulk = 0, nb_bulk = 0;
     uint16_t n_left_from;
     uint16_t held = 0;
 
@@ -127,6 +146,13 @@ udp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
             cne_prefetch0(pktmbuf_mtod_offset(pkts[7], void *, pkts[7]->l2_len));
         }
 
+        /* Lookup the PCBs of the next packets in bulk */
+        if (bulk == nb_bulk) {
+            nb_bulk = CNE_MIN(n_left_from, CNE_HASH_LOOKUP_BULK_MAX);
+            udp_input_bulk_lookup(hd, pkts, nb_bulk, keys, pcbs);
+            bulk = 0;
+        }
+
         mbuf0 = pkts[0];
         mbuf1 = pkts[1];
         mbuf2 = pkts[2];
@@ -135,10 +161,11 @@ udp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
         pkts += 4;
         n_left_from -= 4;
 
-        next0 = udp_input_lookup(mbuf0, hd);
-        next1 = udp_input_lookup(mbuf1, hd);
-        next2 = udp_input_lookup(mbuf2, hd);
-        next3 = udp_input_lookup(mbuf3, hd);
+        next0 = udp_input_lookup(mbuf0, &keys[bulk], pcbs[bulk]);
+        next1 = udp_input_lookup(mbuf1, &keys[bulk + 1], pcbs[bulk + 1]);
+        next2 = udp_input_lookup(mbuf2, &keys[bulk + 2], pcbs[bulk + 2]);
+        next3 = udp_input_lookup(mbuf3, &keys[bulk + 3], pcbs[bulk + 3]);
+        bulk += 4;
 
         /* Enqueue four to next node */
         cne_edge_t fix_spec = (next_index ^ next0) | (next_index ^ next1) | (next_index ^ next2) |
@@ -191,12 +218,19 @@ udp_input_node_process(struct cne_graph *graph, struct cne_node *node, void **ob
     }
 
     while (n_left_from > 0) {
+        if (bulk == nb_bulk) {
+            nb_bulk = CNE_MIN(n_left_from, CNE_HASH_LOOKUP_BULK_MAX);
+            udp_input_bulk_lookup(hd, pkts, nb_bulk, keys, pcbs);
+            bulk = 0;
+        }
+
         mbuf0 = pkts[0];
 
         pkts += 1;
         n_left_from -= 1;
 
-        next0 = udp_input_lookup(mbuf0, hd);
+        next0 = udp_input_lookup(mbuf0, &keys[bulk], pcbs[bulk]);
+        bulk++;
 
         if (unlikely(next_index ^ next0)) {
             /* Copy things successfully speculated till now */
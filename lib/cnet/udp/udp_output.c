@@ -25,7 +25,9 @@
 #include <pktmbuf.h>          // for pktmbuf_t, pktmbuf_data_len
 #include <pktmbuf_ptype.h>
 #include <cnet_udp.h>
+#include <cnet_pcb.h>         // for pcb_entry
 #include <cnet_meta.h>
+#include <gso.h>              // for GSO_MAX_SEGS
 
 #include <cnet_node_names.h>
 #include "udp_output_priv.h"
@@ -33,6 +35,7 @@
 static inline uint16_t
 udp_output_header(pktmbuf_t *m, uint16_t nxt)
 {
+    struct pcb_entry *pcb = m->userptr;
     struct cne_udp_hdr *udp;
     struct cnet_metadata *md;
     int16_t len;
@@ -43,8 +46,17 @@ udp_output_header(pktmbuf_t *m, uint16_t nxt)
 
     /* Build the UDP header */
     len           = sizeof(struct cne_udp_hdr);
-    m->l4_len     = len;
     m->tx_offload = 0;
+    m->l4_len     = len;
+
+    /* Send a datagram larger than UDP_SEGMENT as gso_size datagrams, GSO splits it on transmit */
+    if (pcb && pcb->gso_size && pktmbuf_data_len(m) > pcb->gso_size) {
+        if (pktmbuf_data_len(m) > (pcb->gso_size * GSO_MAX_SEGS))
+            return UDP_OUTPUT_NEXT_PKT_DROP;
+
+        m->ol_flags |= CNE_MBUF_F_TX_UDP_SEG | CNE_MBUF_F_TX_IPV4;
+        m->tso_segsz = pcb->gso_size;
+    }
 
     udp = pktmbuf_adjust(m, struct cne_udp_hdr *, -len);
     if (!udp)
@@ -52,6 +64,7 @@ udp_output_header(pktmbuf_t *m, uint16_t nxt)
     udp->dgram_len   = htobe16(pktmbuf_data_len(m));
     udp->dst_port    = CIN_PORT(&md->faddr);
     udp->src_port    = CIN_PORT(&md->laddr);
+    /* Zero until ip4_output sums the pseudo-header with the datagram, or no checksum */
     udp->dgram_cksum = 0;
 
     nxt = UDP_OUTPUT_NEXT_IP4_OUTPUT;
@@ -0,0 +1,146 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint16_t, uint32_t, uint64_t
+#include <string.h>              // for memcpy
+#include <netinet/in.h>          // for IPPROTO_TCP, IPPROTO_UDP
+#include <cne_common.h>          // for CNE_MIN
+#include <cne_log.h>             // for CNE_ERR_RET
+#include <pktmbuf.h>             // for pktmbuf_t, pktmbuf_alloc_bulk, pktmbuf_free
+#include <net/cne_ip.h>          // for cne_ipv4_hdr, cne_cksum_adjust16
+#include <net/cne_tcp.h>         // for cne_tcp_hdr, TCP_FIN_FLAG, TCP_PSH_FLAG
+#include <net/cne_udp.h>         // for cne_udp_hdr
+
+#include "gso.h"
+
+/*
+ * Update the headers of segment <idx> holding <len> bytes of payload found at <off> in the
+ * payload of the large packet, the headers are a copy of the large packet headers.
+ */
+static int
+gso_update(pktmbuf_t *m, uint16_t idx, uint32_t off, uint16_t len, bool last)
+{
+    struct cne_ipv4_hdr *ip = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+    void *l4                = (char *)ip + m->l3_len;
+    uint64_t l4_cksum       = m->ol_flags & CNE_MBUF_F_TX_L4_MASK;
+    uint16_t old_len, old_id;
+
+    old_len = ip->total_length;
+    old_id  = ip->packet_id;
+
+    ip->total_length = htobe16(m->l3_len + m->l4_len + len);
+    ip->packet_id    = htobe16(be16toh(old_id) + idx);
+
+    if (m->ol_flags & CNE_MBUF_F_TX_IP_CKSUM)
+        ip->hdr_checksum = 0;
+    else {
+        ip->hdr_checksum = cne_cksum_adjust16(ip->hdr_checksum, old_len, ip->total_length);
+        ip->hdr_checksum = cne_cksum_adjust16(ip->hdr_checksum, old_id, ip->packet_id);
+    }
+
+    if (ip->next_proto_id == IPPROTO_TCP) {
+        struct cne_tcp_hdr *tcp = l4;
+
+        tcp->sent_seq = htobe32(be32toh(tcp->sent_seq) + off);
+
+        /* FIN and PSH are only in the last segment and CWR only in the first one */
+        if (!last)
+            tcp->tcp_flags &= ~(TCP_FIN_FLAG | TCP_PSH_FLAG);
+        if (idx)
+            tcp->tcp_flags &= ~TCP_CWR_FLAG;
+
+        tcp->cksum = 0;
+        if (l4_cksum)
+            tcp->cksum = cne_ipv4_phdr_cksum(ip, 0);
+        else
+            tcp->cksum = cne_ipv4_udptcp_cksum(ip, tcp);
+    } else if (ip->next_proto_id == IPPROTO_UDP) {
+        struct cne_udp_hdr *udp = l4;
+
+        udp->dgram_len = htobe16(m->l4_len + len);
+
+        /* A zero checksum means no checksum is sent */
+        if (udp->dgram_cksum) {
+            udp->dgram_cksum = 0;
+            if (l4_cksum)
+                udp->dgram_cksum = cne_ipv4_phdr_cksum(ip, 0);
+            else
+                udp->dgram_cksum = cne_ipv4_udptcp_cksum(ip, udp);
+        }
+    } else
+        CNE_ERR_RET("IP protocol %d can not be segmented\n", ip->next_proto_id);
+
+    m->ol_flags &= ~GSO_SEG_FLAGS;
+    m->tso_segsz = 0;
+
+    return 0;
+}
+
+int
+gso_segment(const gso_ctx_t *ctx, pktmbuf_t *pkt, pktmbuf_t **segs, uint16_t nb_segs)
+{
+    pktmbuf_info_t *pi;
+    uint32_t hdr_len, pay_len, off;
+    uint16_t segsz, n;
+
+    if (!ctx || !pkt || !segs || nb_segs == 0)
+        CNE_ERR_RET("invalid arguments\n");
+
+    if ((pkt->ol_flags & ctx->gso_types) == 0)
+        return 0;
+
+    if ((pkt->ol_flags & CNE_MBUF_F_TX_IPV4) == 0)
+        CNE_ERR_RET("Only IPv4 packets can be segmented\n");
+
+    hdr_len = pkt->l2_len + pkt->l3_len + pkt->l4_len;
+    segsz   = pkt->tso_segsz;
+    if (segsz == 0 || pkt->l4_len == 0 || pktmbuf_data_len(pkt) < hdr_len)
+        CNE_ERR_RET("Invalid tso_segsz %u or header lengths\n", segsz);
+
+    pay_len = pktmbuf_data_len(pkt) - hdr_len;
+    n       = (pay_len + segsz - 1) / segsz;
+
+    /* Only the headers need to be updated when the payload fits in one segment */
+    if (n <= 1) {
+        if (gso_update(pkt, 0, 0, pay_len, true) < 0)
+            return -1;
+        segs[0] = pkt;
+        return 1;
+    }
+
+    if (n > nb_segs)
+        CNE_ERR_RET("%u segments needed, only %u available\n", n, nb_segs);
+
+    pi = (ctx->pi) ? ctx->pi : pkt->pooldata;
+    if (pktmbuf_alloc_bulk(pi, segs, n) <= 0)
+        CNE_ERR_RET("Unable to allocate %u segments\n", n);
+
+    for (uint16_t i = 0; i < n; i++) {
+        pktmbuf_t *m = segs[i];
+        uint16_t len;
+
+        off = i * segsz;
+        len = CNE_MIN(pay_len - off, (uint32_t)segsz);
+
+        memcpy(pktmbuf_mtod(m, char *), pktmbuf_mtod(pkt, char *), hdr_len);
+        memcpy(pktmbuf_mtod_offset(m, char *, hdr_len),
+               pktmbuf_mtod_offset(pkt, char *, hdr_len + off), len);
+
+        pktmbuf_data_len(m) = hdr_len + len;
+        pktmbuf_port(m)     = pktmbuf_port(pkt);
+        m->packet_type      = pkt->packet_type;
+        m->userptr          = pkt->userptr;
+        m->tx_offload       = pkt->tx_offload;
+        m->ol_flags         = pkt->ol_flags;
+
+        if (gso_update(m, i, off, len, i == (n - 1)) < 0) {
+            pktmbuf_free_bulk(segs, n);
+            return -1;
+        }
+    }
+
+    pktmbuf_free(pkt);
+
+    return n;
+}
@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation.
+ */
+
+#ifndef __GSO_H
+#define __GSO_H
+
+/**
+ * @file
+ * Generic Segmentation Offload (GSO) routines.
+ *
+ * A large TCP or UDP over IPv4 packet is built once with a single set of headers and the
+ * CNE_MBUF_F_TX_TCP_SEG or CNE_MBUF_F_TX_UDP_SEG flag set in the mbuf ol_flags. The l2_len,
+ * l3_len, l4_len and tso_segsz fields of the mbuf tx_offload describe the headers and the
+ * payload size of each segment. Just before transmit the packet is split into wire sized
+ * segments, the headers are copied from the large packet and only the fields that change
+ * per segment are updated.
+ *
+ * The L4 checksum of the large packet is not used, it can hold the pseudo-header checksum
+ * from cne_ipv4_phdr_cksum() a NIC doing the segmentation expects, except a UDP checksum of
+ * zero means the datagrams are sent without a checksum.
+ */
+
+#include <stdint.h>            // for uint16_t, uint64_t
+#include <stdbool.h>           // for bool
+#include <cne_common.h>        // for CNDP_API
+#include <pktmbuf.h>           // for pktmbuf_t, pktmbuf_info_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GSO_MAX_SEGS 64 /**< Max number of segments created from one packet */
+
+/** The ol_flags requesting a segmentation */
+#define GSO_SEG_FLAGS (CNE_MBUF_F_TX_TCP_SEG | CNE_MBUF_F_TX_UDP_SEG)
+
+/**
+ * GSO context used to segment the packets.
+ */
+typedef struct gso_ctx {
+    pktmbuf_info_t *pi; /**< Pool for the segments, NULL to use the pool of the packet */
+    uint64_t gso_types; /**< GSO_SEG_FLAGS to segment, others are sent as is */
+} gso_ctx_t;
+
+/**
+ * Test if the packet needs to be segmented before it is transmitted.
+ *
+ * @param m
+ *   The packet to test
+ * @return
+ *   true if the packet has a segmentation flag set or false if not.
+ */
+static inline bool
+gso_needed(const pktmbuf_t *m)
+{
+    return (m->ol_flags & GSO_SEG_FLAGS) != 0;
+}
+
+/**
+ * Segment a TCP or UDP over IPv4 packet into wire sized packets.
+ *
+ * Each segment holds at most tso_segsz bytes of payload. The TCP sequence number, flags and
+ * checksum, the UDP length and checksum and the IPv4 total length, packet ID and header
+ * checksum are updated for each segment. The IPv4 header checksum is updated incrementally
+ * from the checksum of the large packet. When CNE_MBUF_F_TX_IP_CKSUM, CNE_MBUF_F_TX_TCP_CKSUM
+ * or CNE_MBUF_F_TX_UDP_CKSUM is set in the packet ol_flags the checksum is left to the NIC and
+ * the flag is kept in each segment.
+ *
+ * On success the input packet is consumed, it is freed or returned as the only segment when
+ * the payload fits in one segment.
+ *
+ * @param ctx
+ *   The GSO context pointer
+ * @param pkt
+ *   The packet to segment, the packet must be a single mbuf.
+ * @param segs
+ *   The array to return the segments in.
+ * @param nb_segs
+ *   The number of entries in the segs array.
+ * @return
+ *   The number of segments in the segs array, 0 if the packet does not need to be segmented
+ *   or -1 on error and the packet is not freed.
+ */
+CNDP_API int gso_segment(const gso_ctx_t *ctx, pktmbuf_t *pkt, pktmbuf_t **segs,
+                         uint16_t nb_segs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GSO_H */
@@ -13,6 +13,7 @@
 #include <cne_branch_prediction.h>        // for likely, unlikely
 #include <cne_ring.h>                     // for cne_ring_t
 #include <cne_rwlock.h>                   // for cne_rwlock_write_unlock, cne_rwlo...
+#include <cne_rcu_qsbr.h>                 // for cne_rcu_qsbr_dq_create, cne_rcu_q...
 #include <bsd/string.h>                   // for strlcpy
 #include <emmintrin.h>                    // for _mm_cmpeq_epi16, _mm_load_si128
 #include <stdlib.h>                       // for free, calloc
@@ -333,6 +334,11 @@ cne_hash_free(struct cne_hash *h)
     if (h == NULL)
         return;
 
+    /* Wait for the readers of the deleted keys still in the defer queue */
+    if (h->dq && cne_rcu_qsbr_dq_delete(h->dq) < 0)
+        CNE_WARN("Hash %s defer queue delete failed\n", h->name);
+    free(h->hash_rcu_cfg);
+
     if (h->writer_takes_lock)
         free(h->readwrite_lock);
     cne_ring_free(h->free_slots);
@@ -420,6 +426,12 @@ cne_hash_reset(struct cne_hash *h)
 
     __hash_rw_writer_lock(h);
 
+    /* Free the deleted entries still in their grace period before the rings are reset */
+    if (h->dq) {
+        cne_rcu_qsbr_synchronize(h->hash_rcu_cfg->v, CNE_QSBR_THRID_INVALID);
+        cne_rcu_qsbr_dq_reclaim(h->dq, ~0U, NULL, NULL, NULL);
+    }
+
     memset(h->buckets, 0, h->num_buckets * sizeof(struct cne_hash_bucket));
     memset(h->key_store, 0, h->key_entry_size * (h->entries + 1));
     *h->tbl_chng_cnt = 0;
@@ -714,8 +726,14 @@ alloc_slot(const struct cne_hash *h)
 {
     uint32_t slot_id;
 
-    if (cne_ring_dequeue_elem(h->free_slots, &slot_id, sizeof(uint32_t)) != 0)
-        return EMPTY_SLOT;
+    if (cne_ring_dequeue_elem(h->free_slots, &slot_id, sizeof(uint32_t)) != 0) {
+        /* Deleted keys may be waiting for the readers, try to reclaim them */
+        if (h->dq == NULL ||
+            cne_rcu_qsbr_dq_reclaim(h->dq, h->hash_rcu_cfg->max_reclaim_size, NULL, NULL, NULL) <
+                0 ||
+            cne_ring_dequeue_elem(h->free_slots, &slot_id, sizeof(uint32_t)) != 0)
+            return EMPTY_SLOT;
+    }
 
     return slot_id;
 }
@@ -853,7 +871,10 @@ __cne_hash_add_key_with_hash(const struct cne_hash *h, const void *key, hash_sig
      */
     if (cne_ring_dequeue_elem(h->free_ext_bkts, &ext_bkt_id, sizeof(uint32_t)) != 0 ||
         ext_bkt_id == 0) {
-        cne_ring_dequeue_elem(h->free_ext_bkts, &ext_bkt_id, sizeof(uint32_t));
+        /* Deleted keys may hold empty buckets waiting for the readers */
+        if (h->dq && cne_rcu_qsbr_dq_reclaim(h->dq, h->hash_rcu_cfg->max_reclaim_size, NULL,
+                                             NULL, NULL) == 0)
+            cne_ring_dequeue_elem(h->free_ext_bkts, &ext_bkt_id, sizeof(uint32_t));
         if (ext_bkt_id == 0) {
             ret = -ENOSPC;
             goto failure;
@@ -1133,6 +1154,77 @@ remove_entry(const struct cne_hash *h, struct cne_hash_bucket *bkt, unsigned int
         CNE_ERR("%s: could not enqueue free slots in global ring\n", __func__);
 }
 
+/* Free the key index and the empty extendable bucket of a deleted key, called
+ * by the defer queue once the readers are done with the entry.
+ */
+static void
+__hash_rcu_qsbr_free_resource(void *p, void *e, unsigned int n __cne_unused)
+{
+    struct cne_hash *h                          = (struct cne_hash *)p;
+    struct __cne_hash_rcu_dq_entry rcu_dq_entry = *((struct __cne_hash_rcu_dq_entry *)e);
+    struct cne_hash_key *k, *keys = h->key_store;
+
+    if (h->hash_rcu_cfg->free_key_data_func) {
+        k = (struct cne_hash_key *)((char *)keys + rcu_dq_entry.key_idx * h->key_entry_size);
+        h->hash_rcu_cfg->free_key_data_func(h->hash_rcu_cfg->key_data_ptr, k->pdata);
+    }
+
+    /* Recycle empty ext bkt to free list */
+    if (h->ext_table_support && rcu_dq_entry.ext_bkt_idx != EMPTY_SLOT)
+        cne_ring_enqueue_elem(h->free_ext_bkts, &rcu_dq_entry.ext_bkt_idx, sizeof(uint32_t));
+
+    /* Return key index to free slot ring */
+    free_slot(h, rcu_dq_entry.key_idx);
+}
+
+int
+cne_hash_rcu_qsbr_add(struct cne_hash *h, struct cne_hash_rcu_config *cfg)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    struct cne_hash_rcu_config *hash_rcu_cfg;
+    char rcu_dq_name[CNE_RCU_QSBR_NAMESIZE];
+
+    if (h == NULL || cfg == NULL || cfg->v == NULL)
+        return -EINVAL;
+
+    if (h->hash_rcu_cfg)
+        return -EEXIST;
+
+    hash_rcu_cfg = calloc(1, sizeof(struct cne_hash_rcu_config));
+    if (hash_rcu_cfg == NULL)
+        CNE_ERR_RET_VAL(-ENOMEM, "memory allocation failed\n");
+
+    *hash_rcu_cfg = *cfg;
+    if (hash_rcu_cfg->max_reclaim_size == 0)
+        hash_rcu_cfg->max_reclaim_size = CNE_HASH_RCU_DQ_RECLAIM_MAX;
+
+    if (cfg->mode == CNE_HASH_QSBR_MODE_DQ) {
+        /* Init QSBR defer queue. */
+        snprintf(rcu_dq_name, sizeof(rcu_dq_name), "HASH_RCU_%s", h->name);
+        params.name                  = rcu_dq_name;
+        params.size                  = (cfg->dq_size) ? cfg->dq_size : h->entries;
+        params.trigger_reclaim_limit = cfg->trigger_reclaim_limit;
+        params.max_reclaim_size      = hash_rcu_cfg->max_reclaim_size;
+        params.esize                 = sizeof(struct __cne_hash_rcu_dq_entry);
+        params.free_fn               = __hash_rcu_qsbr_free_resource;
+        params.p                     = h;
+        params.v                     = cfg->v;
+
+        h->dq = cne_rcu_qsbr_dq_create(&params);
+        if (h->dq == NULL) {
+            free(hash_rcu_cfg);
+            CNE_ERR_RET_VAL(-ENOMEM, "HASH defer queue creation failed\n");
+        }
+    } else if (cfg->mode != CNE_HASH_QSBR_MODE_SYNC) {
+        free(hash_rcu_cfg);
+        return -EINVAL;
+    }
+
+    h->hash_rcu_cfg = hash_rcu_cfg;
+
+    return 0;
+}
+
 /* Compact the linked list by moving key from last entry in linked list to the
  * empty slot.
  */
@@ -1189,9 +1281,10 @@ search_and_remove(const struct cne_hash *h, const void *key, struct cne_hash_buc
             if (cne_hash_cmp_eq(key, k->key, h) == 0) {
                 bkt->sig_current[i] = NULL_SIGNATURE;
                 /* Free the key store index if
-                 * no_free_on_del is disabled.
+                 * no_free_on_del is disabled and
+                 * RCU QSBR is not used.
                  */
-                if (!h->no_free_on_del)
+                if (!h->no_free_on_del && !h->hash_rcu_cfg)
                     remove_entry(h, bkt, i);
 
                 __atomic_store_n(&bkt->key_idx[i], EMPTY_SLOT, __ATOMIC_RELEASE);
@@ -1218,6 +1311,7 @@ __cne_hash_del_key_with_hash(const struct cne_hash *h, const void *key, hash_sig
     int32_t ret, i;
     uint16_t short_sig;
     uint32_t index = EMPTY_SLOT;
+    struct __cne_hash_rcu_dq_entry rcu_dq_entry;
 
     short_sig       = get_short_sig(sig);
     prim_bucket_idx = get_prim_bucket_index(h, sig);
@@ -1269,9 +1363,12 @@ return_bkt:
         prev_bkt->next = NULL;
         index          = last_bkt - h->buckets_ext + 1;
         /* Recycle the empty bkt if
-         * no_free_on_del is disabled.
+         * no_free_on_del is disabled and
+         * RCU QSBR is not used.
          */
-        if (h->no_free_on_del) {
+        if (h->hash_rcu_cfg) {
+            /* Freed with the key index after the grace period */
+        } else if (h->no_free_on_del) {
             /* Store index of an empty ext bkt to be recycled
              * on calling cne_hash_del_xxx APIs.
              * When lock free read-write concurrency is enabled,
@@ -1280,11 +1377,25 @@ return_bkt:
              * Hence freeing of the ext bkt is piggy-backed to
              * freeing of the key index.
              */
+            if (h->ext_bkt_to_free)
+                h->ext_bkt_to_free[ret] = index;
         } else
             cne_ring_enqueue_elem(h->free_ext_bkts, &index, sizeof(uint32_t));
     }
 
 return_key:
+    /* Using internal RCU QSBR */
+    if (h->hash_rcu_cfg) {
+        /* Key index where key is stored, adding the first dummy index */
+        rcu_dq_entry.key_idx     = ret + 1;
+        rcu_dq_entry.ext_bkt_idx = index;
+        if (h->dq == NULL) {
+            /* Wait for the readers if using CNE_HASH_QSBR_MODE_SYNC */
+            cne_rcu_qsbr_synchronize(h->hash_rcu_cfg->v, CNE_QSBR_THRID_INVALID);
+            __hash_rcu_qsbr_free_resource((void *)((uintptr_t)h), &rcu_dq_entry, 1);
+        } else if (cne_rcu_qsbr_dq_enqueue(h->dq, &rcu_dq_entry) != 0)
+            CNE_ERR("Failed to push QSBR FIFO\n");
+    }
     __hash_rw_writer_unlock(h);
     return ret;
 }
@@ -193,8 +193,16 @@ struct cne_hash {
     uint32_t *ext_bkt_to_free;
     uint32_t *tbl_chng_cnt;
     /**< Indicates if the hash table changed from last read. */
+    struct cne_hash_rcu_config *hash_rcu_cfg; /**< HASH RCU QSBR configuration structure */
+    struct cne_rcu_qsbr_dq *dq;               /**< RCU QSBR defer queue. */
 } __cne_cache_aligned;
 
+/* Entry of the RCU QSBR defer queue */
+struct __cne_hash_rcu_dq_entry {
+    uint32_t key_idx;     /**< Key index to free */
+    uint32_t ext_bkt_idx; /**< Extendable bucket index to free or EMPTY_SLOT */
+};
+
 struct queue_node {
     struct cne_hash_bucket *bkt; /* Current bucket on the bfs search */
     uint32_t cur_bkt_idx;
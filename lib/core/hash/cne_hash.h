@@ -17,6 +17,8 @@
 extern "C" {
 #endif
 
+struct cne_rcu_qsbr;
+
 /** Maximum size of hash table that can be created. */
 #define CNE_HASH_ENTRIES_MAX (1 << 30)
 
@@ -77,6 +79,31 @@ struct cne_hash_parameters {
     uint8_t extra_flag;          /**< Indicate if additional parameters are present. */
 };
 
+/** HASH RCU QSBR integration modes. */
+enum cne_hash_qsbr_mode {
+    CNE_HASH_QSBR_MODE_DQ = 0, /**< Free the deleted entries through a defer queue */
+    CNE_HASH_QSBR_MODE_SYNC    /**< Wait for the readers on every delete, no defer queue */
+};
+
+/** Default max number of entries freed on a defer queue reclaim */
+#define CNE_HASH_RCU_DQ_RECLAIM_MAX 16
+
+/** Type of function called to free the application data of a deleted key. */
+typedef void (*cne_hash_free_key_data)(void *p, void *key_data);
+
+/** HASH RCU QSBR configuration structure. */
+struct cne_hash_rcu_config {
+    struct cne_rcu_qsbr *v;         /**< RCU QSBR variable used by the readers. */
+    enum cne_hash_qsbr_mode mode;   /**< Mode of the RCU QSBR integration. */
+    uint32_t dq_size;               /**< Defer queue size, 0 for the number of entries. */
+    uint32_t trigger_reclaim_limit; /**< Reclaim on delete above this many pending entries. */
+    uint32_t max_reclaim_size;
+    /**< Max entries freed on reclaim, 0 for CNE_HASH_RCU_DQ_RECLAIM_MAX. */
+    void *key_data_ptr; /**< Pointer passed to free_key_data_func. */
+    cne_hash_free_key_data free_key_data_func;
+    /**< Function to free the application data of a deleted key, can be NULL. */
+};
+
 /** @internal A hash table structure. */
 struct cne_hash;
 
@@ -275,7 +302,8 @@ int32_t cne_hash_add_key_with_hash(const struct cne_hash *h, const void *key, ha
  * additionally to free the index associated with the key.
  * cne_hash_free_key_with_position API should be called after all
  * the readers have stopped referencing the entry corresponding to
- * this key. RCU mechanisms could be used to determine such a state.
+ * this key. RCU mechanisms could be used to determine such a state,
+ * cne_hash_rcu_qsbr_add() lets the library free the index once it is safe.
  *
  * @param h
  *   Hash table to remove the key from.
@@ -579,6 +607,22 @@ int cne_hash_lookup_bulk(const struct cne_hash *h, const void **keys, uint32_t n
  */
 int32_t cne_hash_iterate(const struct cne_hash *h, const void **key, void **data, uint32_t *next);
 
+/**
+ * Associate an RCU QSBR variable with a hash table using lock free read/write
+ * concurrency. The key index and the extendable bucket of a deleted key are then
+ * freed by the library once the readers reported a quiescent state, the
+ * application does not call cne_hash_free_key_with_position().
+ *
+ * @param h
+ *   The hash table object to associate the RCU QSBR variable with.
+ * @param cfg
+ *   RCU QSBR configuration.
+ * @return
+ *   0 on success or -EINVAL on invalid parameters, -EEXIST if a variable is
+ *   already associated and -ENOMEM on allocation failure.
+ */
+int cne_hash_rcu_qsbr_add(struct cne_hash *h, struct cne_hash_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,221 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint32_t, uint64_t, uint8_t
+#include <stdbool.h>             // for bool, false
+#include <stdlib.h>              // for calloc, free
+#include <string.h>              // for memcpy
+#include <cne_common.h>          // for CNE_MIN
+#include <cne_log.h>             // for CNE_NULL_RET
+#include <cne_cpuflags.h>        // for cne_cpu_get_flag_enabled, CNE_CPUFLAG_...
+#include <cne_vect.h>            // for cne_vect_get_max_simd_bitwidth
+
+#include "cne_thash.h"
+#include "thash_private.h"
+
+/* Return bit number 'bit' of the key, bit 0 is the MSB of the first key byte */
+static inline uint32_t
+key_bit(const uint8_t *key, uint32_t bit)
+{
+    return (key[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/* Return the 32-bit window of the key starting at bit number 'bit' */
+static inline uint32_t
+key_window(const uint8_t *key, uint32_t bit)
+{
+    const uint8_t *k = &key[bit >> 3];
+    uint64_t v;
+
+    v = ((uint64_t)k[0] << 32) | ((uint64_t)k[1] << 24) | ((uint64_t)k[2] << 16) |
+        ((uint64_t)k[3] << 8) | (uint64_t)k[4];
+
+    return (uint32_t)(v >> (8 - (bit & 7)));
+}
+
+/*
+ * Build the byte lookup table, entry [p][b] is the partial hash of byte value b
+ * located at tuple offset p. The hash of a tuple is the XOR of one entry per byte.
+ */
+static void
+thash_tbl_init(struct cne_thash_ctx *ctx)
+{
+    for (uint32_t p = 0; p < ctx->max_len; p++) {
+        uint32_t *tbl = &ctx->tbl[p * 256];
+
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t v = 0;
+
+            for (uint32_t k = 0; k < 8; k++)
+                if (b & (0x80 >> k))
+                    v ^= key_window(ctx->key, (p * 8) + k);
+            tbl[b] = v;
+        }
+    }
+}
+
+/*
+ * Build the GF(2) affine matrices. For tuple byte p and hash byte j row m of the
+ * matrix produces bit (7 - m) of the hash byte and column t selects input bit t.
+ */
+static void
+thash_mtrx_init(struct cne_thash_ctx *ctx)
+{
+    for (uint32_t p = 0; p < ctx->max_len; p++) {
+        for (uint32_t j = 0; j < THASH_MTRX_PER_BYTE; j++) {
+            uint64_t m = 0;
+
+            for (uint32_t row = 0; row < 8; row++)
+                for (uint32_t t = 0; t < 8; t++)
+                    m |= (uint64_t)key_bit(ctx->key, (p * 8) + (7 - t) + (j * 8) + row)
+                         << ((row * 8) + t);
+
+            ctx->mtrx[(p * THASH_MTRX_PER_BYTE) + j] = m;
+        }
+    }
+}
+
+static inline uint32_t
+thash_scalar(const struct cne_thash_ctx *ctx, const uint8_t *tuple, uint32_t len)
+{
+    const uint32_t *tbl = ctx->tbl;
+    uint32_t h          = 0;
+
+    for (uint32_t p = 0; p < len; p++, tbl += 256)
+        h ^= tbl[tuple[p]];
+
+    return h;
+}
+
+void
+thash_bulk_scalar(const struct cne_thash_ctx *ctx, const uint8_t *tuples[], uint32_t len,
+                  uint32_t hashes[], uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++)
+        hashes[i] = thash_scalar(ctx, tuples[i], len);
+}
+
+static bool
+thash_gfni_supported(void)
+{
+#ifdef CC_THASH_GFNI_SUPPORT
+    return (cne_cpu_get_flag_enabled(CNE_CPUFLAG_GFNI) > 0) &&
+           (cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX512F) > 0) &&
+           (cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX512BW) > 0) &&
+           (cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX512VL) > 0) &&
+           (cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX512VBMI) > 0) &&
+           (cne_vect_get_max_simd_bitwidth() >= CNE_VECT_SIMD_512);
+#else
+    return false;
+#endif
+}
+
+static bool
+thash_avx2_supported(void)
+{
+#ifdef CC_THASH_AVX2_SUPPORT
+    return (cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX2) > 0) &&
+           (cne_vect_get_max_simd_bitwidth() >= CNE_VECT_SIMD_256);
+#else
+    return false;
+#endif
+}
+
+static thash_bulk_fn_t
+thash_get_bulk_fn(enum cne_thash_impl *impl)
+{
+    switch (*impl) {
+    case CNE_THASH_IMPL_DEFAULT:
+        if (thash_gfni_supported()) {
+            *impl = CNE_THASH_IMPL_GFNI;
+            return thash_get_bulk_fn(impl);
+        }
+        if (thash_avx2_supported()) {
+            *impl = CNE_THASH_IMPL_AVX2;
+            return thash_get_bulk_fn(impl);
+        }
+        *impl = CNE_THASH_IMPL_SCALAR;
+        return thash_bulk_scalar;
+    case CNE_THASH_IMPL_SCALAR:
+        return thash_bulk_scalar;
+    case CNE_THASH_IMPL_AVX2:
+#ifdef CC_THASH_AVX2_SUPPORT
+        if (thash_avx2_supported())
+            return thash_bulk_avx2;
+#endif
+        return NULL;
+    case CNE_THASH_IMPL_GFNI:
+#ifdef CC_THASH_GFNI_SUPPORT
+        if (thash_gfni_supported())
+            return thash_bulk_gfni;
+#endif
+        return NULL;
+    default:
+        return NULL;
+    }
+}
+
+struct cne_thash_ctx *
+cne_thash_create(const uint8_t *rss_key, uint32_t key_len, enum cne_thash_impl impl)
+{
+    struct cne_thash_ctx *ctx;
+    thash_bulk_fn_t fn;
+
+    if (!rss_key || key_len < 8 || key_len > CNE_THASH_KEY_LEN_MAX)
+        CNE_NULL_RET("Invalid RSS key or key length %u\n", key_len);
+
+    fn = thash_get_bulk_fn(&impl);
+    if (!fn)
+        CNE_NULL_RET("Toeplitz hash implementation %d not supported\n", impl);
+
+    ctx = calloc(1, sizeof(struct cne_thash_ctx));
+    if (!ctx)
+        CNE_NULL_RET("Unable to allocate Toeplitz hash context\n");
+
+    ctx->tbl = calloc(1, (key_len - 4) * 256 * sizeof(uint32_t));
+    if (!ctx->tbl) {
+        free(ctx);
+        CNE_NULL_RET("Unable to allocate Toeplitz hash table\n");
+    }
+
+    memcpy(ctx->key, rss_key, key_len);
+    ctx->key_len = key_len;
+    ctx->max_len = key_len - 4;
+    ctx->impl    = impl;
+    ctx->bulk_fn = fn;
+
+    thash_tbl_init(ctx);
+    thash_mtrx_init(ctx);
+
+    return ctx;
+}
+
+void
+cne_thash_free(struct cne_thash_ctx *ctx)
+{
+    if (ctx) {
+        free(ctx->tbl);
+        free(ctx);
+    }
+}
+
+enum cne_thash_impl
+cne_thash_impl_get(const struct cne_thash_ctx *ctx)
+{
+    return ctx->impl;
+}
+
+uint32_t
+cne_thash(const struct cne_thash_ctx *ctx, const uint8_t *tuple, uint32_t len)
+{
+    /* The vector implementations only pay off across several tuples */
+    return thash_scalar(ctx, tuple, CNE_MIN(len, ctx->max_len));
+}
+
+void
+cne_thash_bulk(const struct cne_thash_ctx *ctx, const uint8_t *tuples[], uint32_t len,
+               uint32_t hashes[], uint32_t num)
+{
+    ctx->bulk_fn(ctx, tuples, CNE_MIN(len, ctx->max_len), hashes, num);
+}
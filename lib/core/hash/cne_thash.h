@@ -190,6 +190,93 @@ cne_softrss_be(uint32_t *input_tuple, uint32_t input_len, const uint8_t *rss_key
     return ret;
 }
 
+/** Maximum RSS key length in bytes supported by cne_thash_create() */
+#define CNE_THASH_KEY_LEN_MAX 52
+
+/** Maximum tuple length in bytes, the key must be 4 bytes longer than the tuple */
+#define CNE_THASH_TUPLE_LEN_MAX (CNE_THASH_KEY_LEN_MAX - 4)
+
+/** Toeplitz hash implementations usable by a cne_thash context */
+enum cne_thash_impl {
+    CNE_THASH_IMPL_DEFAULT, /**< Select the best implementation for the CPU */
+    CNE_THASH_IMPL_SCALAR,  /**< Byte at a time table lookup */
+    CNE_THASH_IMPL_AVX2,    /**< AVX2 gather of table lookups, 8 tuples in parallel */
+    CNE_THASH_IMPL_GFNI,    /**< GFNI/AVX512 affine transforms, 8 tuples in parallel */
+};
+
+struct cne_thash_ctx;
+
+/**
+ * Create a Toeplitz hash context for the given RSS key.
+ *
+ * The context holds a precomputed copy of the key in the formats needed by the
+ * vector implementations, which removes the bit serial loop of cne_softrss().
+ * Tuples passed to the context functions are byte arrays in network byte order,
+ * the same layout a NIC hashes. A tuple built for cne_softrss() produces the same
+ * hash once each of its 32-bit words is converted with htobe32().
+ *
+ * @param rss_key
+ *   Pointer to the RSS key in the original (NIC) format.
+ * @param key_len
+ *   Length of the RSS key in bytes, between 8 and CNE_THASH_KEY_LEN_MAX.
+ * @param impl
+ *   Implementation to use, CNE_THASH_IMPL_DEFAULT selects the fastest one
+ *   supported by the CPU and the max SIMD bitwidth.
+ * @return
+ *   Pointer to the context or NULL on error, e.g. the implementation is not supported.
+ */
+CNDP_API struct cne_thash_ctx *cne_thash_create(const uint8_t *rss_key, uint32_t key_len,
+                                                enum cne_thash_impl impl);
+
+/**
+ * Free a Toeplitz hash context.
+ *
+ * @param ctx
+ *   Pointer to the context, can be NULL.
+ */
+CNDP_API void cne_thash_free(struct cne_thash_ctx *ctx);
+
+/**
+ * Return the implementation used by the context.
+ *
+ * @param ctx
+ *   Pointer to the context.
+ * @return
+ *   The implementation selected when the context was created.
+ */
+CNDP_API enum cne_thash_impl cne_thash_impl_get(const struct cne_thash_ctx *ctx);
+
+/**
+ * Compute the Toeplitz hash of a single tuple.
+ *
+ * @param ctx
+ *   Pointer to the context.
+ * @param tuple
+ *   Pointer to the tuple in network byte order.
+ * @param len
+ *   Length of the tuple in bytes, must not exceed key_len - 4.
+ * @return
+ *   Calculated hash value.
+ */
+CNDP_API uint32_t cne_thash(const struct cne_thash_ctx *ctx, const uint8_t *tuple, uint32_t len);
+
+/**
+ * Compute the Toeplitz hash of a number of tuples of the same length.
+ *
+ * @param ctx
+ *   Pointer to the context.
+ * @param tuples
+ *   Array of pointers to tuples in network byte order.
+ * @param len
+ *   Length of each tuple in bytes, must not exceed key_len - 4.
+ * @param hashes
+ *   Array to store the calculated hash values.
+ * @param num
+ *   Number of tuples to hash.
+ */
+CNDP_API void cne_thash_bulk(const struct cne_thash_ctx *ctx, const uint8_t *tuples[],
+                             uint32_t len, uint32_t hashes[], uint32_t num);
+
 #ifdef __cplusplus
 }
 #endif
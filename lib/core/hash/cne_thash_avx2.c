@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <immintrin.h>        // for __m256i, _mm256_i32gather_epi32, ...
+#include <stdint.h>           // for uint32_t, uint8_t
+#include <string.h>           // for memcpy
+
+#include "cne_common.h"        // for __cne_always_inline
+#include "thash_private.h"
+
+#define THASH_AVX2_LANES 8
+
+static __cne_always_inline uint32_t
+load32(const uint8_t *p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/*
+ * Hash eight tuples in parallel, each lane gathers the partial hash for its
+ * tuple byte from the lookup table and XORs it into the lane accumulator.
+ */
+static __cne_always_inline __m256i
+thash_avx2_x8(const uint32_t *tbl, const uint8_t *const t[THASH_AVX2_LANES], uint32_t len)
+{
+    const __m256i byte_msk = _mm256_set1_epi32(0xff);
+    __m256i acc            = _mm256_setzero_si256();
+    __m256i words, idx;
+    uint32_t p = 0;
+
+    /* Full 4 byte chunks, one unaligned load per tuple feeds four gathers */
+    for (; (p + 4) <= len; p += 4) {
+        words = _mm256_set_epi32(load32(t[7] + p), load32(t[6] + p), load32(t[5] + p),
+                                 load32(t[4] + p), load32(t[3] + p), load32(t[2] + p),
+                                 load32(t[1] + p), load32(t[0] + p));
+
+        for (uint32_t b = 0; b < 4; b++) {
+            idx   = _mm256_and_si256(words, byte_msk);
+            idx   = _mm256_add_epi32(idx, _mm256_set1_epi32((p + b) * 256));
+            acc   = _mm256_xor_si256(acc, _mm256_i32gather_epi32((const int *)tbl, idx, 4));
+            words = _mm256_srli_epi32(words, 8);
+        }
+    }
+
+    for (; p < len; p++) {
+        idx = _mm256_set_epi32(t[7][p], t[6][p], t[5][p], t[4][p], t[3][p], t[2][p], t[1][p],
+                               t[0][p]);
+        idx = _mm256_add_epi32(idx, _mm256_set1_epi32(p * 256));
+        acc = _mm256_xor_si256(acc, _mm256_i32gather_epi32((const int *)tbl, idx, 4));
+    }
+
+    return acc;
+}
+
+void
+thash_bulk_avx2(const struct cne_thash_ctx *ctx, const uint8_t *tuples[], uint32_t len,
+                uint32_t hashes[], uint32_t num)
+{
+    uint32_t i;
+
+    for (i = 0; (i + THASH_AVX2_LANES) <= num; i += THASH_AVX2_LANES)
+        _mm256_storeu_si256((__m256i *)&hashes[i], thash_avx2_x8(ctx->tbl, &tuples[i], len));
+
+    if (i < num)
+        thash_bulk_scalar(ctx, &tuples[i], len, &hashes[i], num - i);
+}
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <immintrin.h>        // for __m512i, _mm512_gf2p8affine_epi64_epi8, ...
+#include <stdint.h>           // for uint32_t, uint64_t, uint8_t
+#include <string.h>           // for memcpy
+
+#include "cne_common.h"                   // for __cne_always_inline
+#include "cne_branch_prediction.h"        // for likely
+#include "thash_private.h"
+
+#define THASH_GFNI_LANES 8
+
+/* Load up to 8 tuple bytes, without reading past the end of the tuple */
+static __cne_always_inline uint64_t
+load64(const uint8_t *p, uint32_t n)
+{
+    uint64_t v = 0;
+
+    if (likely(n == sizeof(v)))
+        memcpy(&v, p, sizeof(v));
+    else
+        v = (uint64_t)_mm_cvtsi128_si64(_mm_maskz_loadu_epi8((__mmask16)((1 << n) - 1), p));
+
+    return v;
+}
+
+/*
+ * The eight tuples are processed eight bytes at a time. One 64-bit load per tuple
+ * gives a vector where qword k holds bytes [p, p + 8) of tuple k, which is
+ * transposed so that qword n holds byte p + n of all eight tuples. Each qword is
+ * then broadcast into four lanes and multiplied by the four matrices of its byte
+ * offset, the affine result in lane j being hash byte j of every tuple.
+ */
+static __cne_always_inline void
+thash_gfni_x8(const uint64_t *mtrx, const uint8_t *const t[THASH_GFNI_LANES], uint32_t len,
+              uint32_t *hashes)
+{
+    /* byte (8 * n) + k of the result is byte (8 * k) + n of the source */
+    const __m512i transpose = _mm512_set_epi8(
+        63, 55, 47, 39, 31, 23, 15, 7, 62, 54, 46, 38, 30, 22, 14, 6, 61, 53, 45, 37, 29, 21, 13, 5,
+        60, 52, 44, 36, 28, 20, 12, 4, 59, 51, 43, 35, 27, 19, 11, 3, 58, 50, 42, 34, 26, 18, 10, 2,
+        57, 49, 41, 33, 25, 17, 9, 1, 56, 48, 40, 32, 24, 16, 8, 0);
+    /* gather hash byte j of tuple k from lane j into the little endian dword k */
+    const __m512i to_dwords = _mm512_set_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 7, 15, 23, 31, 6, 14, 22, 30, 5, 13, 21, 29, 4, 12, 20, 28, 3, 11, 19, 27, 2, 10, 18, 26,
+        1, 9, 17, 25, 0, 8, 16, 24);
+    const __m512i two = _mm512_set1_epi64(2);
+    __m512i acc       = _mm512_setzero_si512();
+    __m512i bytes, sel, vals;
+
+    for (uint32_t p = 0; p < len; p += 8) {
+        uint32_t n = CNE_MIN(len - p, 8U);
+
+        bytes = _mm512_set_epi64(load64(t[7] + p, n), load64(t[6] + p, n), load64(t[5] + p, n),
+                                 load64(t[4] + p, n), load64(t[3] + p, n), load64(t[2] + p, n),
+                                 load64(t[1] + p, n), load64(t[0] + p, n));
+        bytes = _mm512_permutexvar_epi8(transpose, bytes);
+
+        /* qword selector, lanes 0-3 take byte p + i and lanes 4-7 byte p + i + 1 */
+        sel = _mm512_set_epi64(1, 1, 1, 1, 0, 0, 0, 0);
+        for (uint32_t i = 0; i < n; i += 2) {
+            vals = _mm512_gf2p8affine_epi64_epi8(
+                _mm512_permutexvar_epi64(sel, bytes),
+                _mm512_loadu_si512(&mtrx[(p + i) * THASH_MTRX_PER_BYTE]), 0);
+            acc = _mm512_xor_si512(acc, vals);
+            sel = _mm512_add_epi64(sel, two);
+        }
+    }
+
+    /* fold the odd byte lanes onto the even byte lanes */
+    acc = _mm512_xor_si512(acc, _mm512_shuffle_i64x2(acc, acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm512_permutexvar_epi8(to_dwords, acc);
+
+    _mm256_storeu_si256((__m256i *)hashes, _mm512_castsi512_si256(acc));
+}
+
+void
+thash_bulk_gfni(const struct cne_thash_ctx *ctx, const uint8_t *tuples[], uint32_t len,
+                uint32_t hashes[], uint32_t num)
+{
+    uint32_t i;
+
+    for (i = 0; (i + THASH_GFNI_LANES) <= num; i += THASH_GFNI_LANES)
+        thash_gfni_x8(ctx->mtrx, &tuples[i], len, &hashes[i]);
+
+    if (i < num)
+        thash_bulk_scalar(ctx, &tuples[i], len, &hashes[i], num - i);
+}
@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _THASH_PRIVATE_H_
+#define _THASH_PRIVATE_H_
+
+/**
+ * @file
+ *
+ * Internal definitions shared by the scalar, AVX2 and GFNI Toeplitz hash
+ * implementations.
+ */
+
+#include <stdint.h>        // for uint32_t, uint64_t, uint8_t
+#include <cne_common.h>        // for __cne_aligned
+
+#include "cne_thash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of 8x8 bit matrices needed per tuple byte, one per hash output byte */
+#define THASH_MTRX_PER_BYTE 4
+
+typedef void (*thash_bulk_fn_t)(const struct cne_thash_ctx *ctx, const uint8_t *tuples[],
+                                uint32_t len, uint32_t hashes[], uint32_t num);
+
+struct cne_thash_ctx {
+    enum cne_thash_impl impl; /**< Implementation selected at create time */
+    thash_bulk_fn_t bulk_fn;  /**< Bulk hash function for the implementation */
+    uint32_t key_len;         /**< Length of the RSS key in bytes */
+    uint32_t max_len;         /**< Maximum tuple length in bytes (key_len - 4) */
+    uint32_t *tbl;            /**< max_len * 256 byte lookup table of partial hashes */
+    /**
+     * GF(2) affine matrices, THASH_MTRX_PER_BYTE per tuple byte. The matrix for
+     * tuple byte p and hash byte j (j = 0 is the most significant byte) is at
+     * index (p * THASH_MTRX_PER_BYTE) + j. The GFNI code loads the matrices of
+     * two bytes at a time, the extra zero entries cover an odd tuple length.
+     */
+    uint64_t mtrx[(CNE_THASH_TUPLE_LEN_MAX + 2) * THASH_MTRX_PER_BYTE] __cne_aligned(64);
+    uint8_t key[CNE_THASH_KEY_LEN_MAX]; /**< Copy of the original RSS key */
+};
+
+/**
+ * Scalar bulk hash using the per byte lookup table.
+ */
+void thash_bulk_scalar(const struct cne_thash_ctx *ctx, const uint8_t *tuples[], uint32_t len,
+                       uint32_t hashes[], uint32_t num);
+
+#ifdef CC_THASH_AVX2_SUPPORT
+/**
+ * AVX2 bulk hash, eight tuples at a time using gathers from the lookup table.
+ */
+void thash_bulk_avx2(const struct cne_thash_ctx *ctx, const uint8_t *tuples[], uint32_t len,
+                     uint32_t hashes[], uint32_t num);
+#endif
+
+#ifdef CC_THASH_GFNI_SUPPORT
+/**
+ * GFNI/AVX512 bulk hash, eight tuples at a time using GF(2) affine transforms.
+ */
+void thash_bulk_gfni(const struct cne_thash_ctx *ctx, const uint8_t *tuples[], uint32_t len,
+                     uint32_t hashes[], uint32_t num);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _THASH_PRIVATE_H_ */
@@ -0,0 +1,638 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>              // for uint16_t, uint32_t, uint64_t
+#include <stdlib.h>              // for calloc, aligned_alloc, free
+#include <string.h>              // for memcpy, memset
+#include <netinet/ip.h>          // for IPOPT_EOL, IPOPT_NOP, IPOPT_COPIED
+#include <cne_common.h>          // for CNE_MIN, cne_align32pow2, cne_fls_u64
+#include <cne_cycles.h>          // for cne_rdtsc
+#include <cne_jhash.h>           // for cne_jhash_3words
+#include <cne_log.h>             // for CNE_ERR_RET, CNE_NULL_RET
+#include <cne_system.h>          // for cne_get_timer_hz
+#include <pktmbuf.h>             // for pktmbuf_t, pktmbuf_alloc, pktmbuf_metadata
+#include <pktmbuf_ptype.h>       // for CNE_PTYPE_L4_MASK, CNE_PTYPE_L4_UDP, CNE_PTYPE_L4_TCP
+#include <net/cne_ip.h>          // for cne_ipv4_hdr, cne_ipv4_cksum
+#include <net/cne_udp.h>         // for cne_udp_hdr
+#include <net/cne_tcp.h>         // for cne_tcp_hdr
+#include <net/cne_sctp.h>        // for cne_sctp_hdr
+
+#include "ip_frag.h"
+
+/* Key of a datagram being reassembled, the addresses and ID are in network order */
+struct ip_frag_key {
+    uint32_t src_addr;
+    uint32_t dst_addr;
+    uint16_t id;
+    uint8_t proto;
+    uint8_t valid;
+};
+
+/* The keys and timeouts of a bucket are in one cache line, the fragments are kept apart */
+struct ip_frag_bucket {
+    struct ip_frag_key key[IP_FRAG_BUCKET_ENTRIES];
+    uint32_t expire[IP_FRAG_BUCKET_ENTRIES]; /* Tick the datagram times out */
+} __cne_cache_aligned;
+
+/* A fragment held in the table */
+struct ip_frag_piece {
+    uint16_t ofs;    /* Offset of the payload in the datagram */
+    uint16_t len;    /* Length of the payload */
+    uint16_t ip_off; /* Offset of the IPv4 header in the mbuf */
+    uint16_t hlen;   /* Length of the IPv4 header */
+    pktmbuf_t *m;
+};
+
+/* The fragments of a datagram */
+struct ip_frag_entry {
+    uint16_t total_len; /* Payload length of the datagram, 0 until the last fragment is held */
+    uint16_t recv_len;  /* Payload length of the fragments held */
+    uint16_t nb_frags;  /* Number of fragments held */
+    struct ip_frag_piece frags[IP_FRAG_MAX_FRAGS];
+};
+
+struct ip_frag_tbl {
+    struct ip_frag_bucket *buckets; /* Buckets of IP_FRAG_BUCKET_ENTRIES keys */
+    struct ip_frag_entry *entries;  /* Fragments of each key of each bucket */
+    uint32_t bucket_mask;           /* Number of buckets - 1 */
+    uint32_t seed;                  /* Hash seed, to not let a sender choose the bucket */
+    uint32_t timeout;               /* Timeout of a datagram in ticks */
+    uint32_t shift;                 /* Shift of the TSC value giving the ticks */
+    uint32_t cursor;                /* Next bucket looked at by ip_frag_tbl_expire() */
+    uint32_t nb_frags;              /* Number of fragments held */
+    uint32_t max_frags;             /* Max number of fragments held */
+    pktmbuf_info_t *pi;             /* Pool of the datagrams larger than their first fragment */
+    struct ip_frag_stats stats;     /* Reassembly statistics */
+};
+
+/* A tick is the largest power of 2 number of TSC cycles in a millisecond */
+static inline uint32_t
+ip_frag_now(const ip_frag_tbl_t *tbl, uint64_t tsc)
+{
+    return (uint32_t)(tsc >> tbl->shift);
+}
+
+static inline bool
+ip_frag_expired(uint32_t now, uint32_t expire)
+{
+    return (int32_t)(now - expire) >= 0;
+}
+
+/* Copy the options with the copied flag set, returns the copied length padded to 4 bytes */
+static uint16_t
+ip_frag_copy_opts(uint8_t *dst, const uint8_t *opts, uint16_t len)
+{
+    uint16_t i = 0, n = 0;
+
+    while (i < len && opts[i] != IPOPT_EOL) {
+        uint8_t olen;
+
+        if (opts[i] == IPOPT_NOP) {
+            i++;
+            continue;
+        }
+
+        if ((i + 1) >= len)
+            break;
+        olen = opts[i + 1];
+        if (olen < 2 || (i + olen) > len)
+            break;
+
+        if (IPOPT_COPIED(opts[i])) {
+            memcpy(&dst[n], &opts[i], olen);
+            n += olen;
+        }
+        i += olen;
+    }
+
+    while (n & 3)
+        dst[n++] = IPOPT_EOL;
+
+    return n;
+}
+
+int
+ip_frag_ipv4(pktmbuf_t *pkt, uint16_t mtu, pktmbuf_info_t *pi, pktmbuf_t **frags,
+             uint16_t nb_frags)
+{
+    uint8_t hdr[CNE_IPV4_HDR_IHL_MASK * CNE_IPV4_IHL_MULTIPLIER];
+    uint16_t hlen, hlen2, tot_len, flags, first_sz, frag_sz, pay_len, off, n;
+    struct cne_ipv4_hdr *ip;
+
+    if (!pkt || !frags || nb_frags == 0)
+        CNE_ERR_RET("invalid arguments\n");
+
+    ip      = pktmbuf_mtod_offset(pkt, struct cne_ipv4_hdr *, pkt->l2_len);
+    hlen    = cne_ipv4_hdr_len(ip);
+    tot_len = be16toh(ip->total_length);
+    if (hlen < sizeof(struct cne_ipv4_hdr) || tot_len < hlen ||
+        (pkt->l2_len + tot_len) > pktmbuf_data_len(pkt))
+        CNE_ERR_RET("Invalid IPv4 header or total length %u\n", tot_len);
+
+    if (tot_len <= mtu)
+        return 0;
+
+    flags = be16toh(ip->fragment_offset);
+    if (flags & CNE_IPV4_HDR_DF_FLAG)
+        CNE_ERR_RET("Packet with the DF flag set can not be fragmented\n");
+
+    if (pkt->ol_flags & (CNE_MBUF_F_TX_L4_MASK | CNE_MBUF_F_TX_TCP_SEG | CNE_MBUF_F_TX_UDP_SEG))
+        CNE_ERR_RET("Packet with L4 checksum or segmentation offloads can not be fragmented\n");
+
+    /* The following fragments only hold the options with the copied flag */
+    memcpy(hdr, ip, sizeof(struct cne_ipv4_hdr));
+    hlen2 = sizeof(struct cne_ipv4_hdr) + ip_frag_copy_opts(&hdr[sizeof(struct cne_ipv4_hdr)],
+                                                            (const uint8_t *)(ip + 1),
+                                                            hlen - sizeof(struct cne_ipv4_hdr));
+
+    /* The payload of every fragment but the last one is a multiple of 8 bytes */
+    if (mtu < (hlen + CNE_IPV4_HDR_OFFSET_UNITS))
+        CNE_ERR_RET("MTU %u is too small for the IPv4 header\n", mtu);
+
+    pay_len  = tot_len - hlen;
+    first_sz = (mtu - hlen) & ~(CNE_IPV4_HDR_OFFSET_UNITS - 1);
+    frag_sz  = (mtu - hlen2) & ~(CNE_IPV4_HDR_OFFSET_UNITS - 1);
+    n        = 1 + ((pay_len - first_sz) + frag_sz - 1) / frag_sz;
+
+    if (n > nb_frags)
+        CNE_ERR_RET("%u fragments needed, only %u available\n", n, nb_frags);
+
+    pi = (pi) ? pi : pkt->pooldata;
+    if (pktmbuf_alloc_bulk(pi, frags, n) <= 0)
+        CNE_ERR_RET("Unable to allocate %u fragments\n", n);
+
+    if (pktmbuf_tailroom(frags[0]) < (pkt->l2_len + mtu)) {
+        pktmbuf_free_bulk(frags, n);
+        CNE_ERR_RET("Buffer too small for the MTU %u\n", mtu);
+    }
+
+    off = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        pktmbuf_t *m            = frags[i];
+        const void *h           = (i == 0) ? (const void *)ip : (const void *)hdr;
+        uint16_t hl             = (i == 0) ? hlen : hlen2;
+        uint16_t len            = CNE_MIN(pay_len - off, (i == 0) ? first_sz : frag_sz);
+        struct cne_ipv4_hdr *fi = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, pkt->l2_len);
+        uint16_t fo;
+
+        memcpy(pktmbuf_mtod(m, char *), pktmbuf_mtod(pkt, char *), pkt->l2_len);
+        memcpy(fi, h, hl);
+        memcpy((char *)fi + hl, (char *)ip + hlen + off, len);
+
+        /* The last fragment keeps the MF flag of a packet which is already a fragment */
+        fo = (flags & CNE_IPV4_HDR_OFFSET_MASK) + (off / CNE_IPV4_HDR_OFFSET_UNITS);
+        if ((off + len) < pay_len || (flags & CNE_IPV4_HDR_MF_FLAG))
+            fo |= CNE_IPV4_HDR_MF_FLAG;
+
+        fi->version_ihl     = (ip->version_ihl & ~CNE_IPV4_HDR_IHL_MASK) |
+                          (hl / CNE_IPV4_IHL_MULTIPLIER);
+        fi->total_length    = htobe16(hl + len);
+        fi->fragment_offset = htobe16(fo);
+        fi->hdr_checksum    = 0;
+        if (!(pkt->ol_flags & CNE_MBUF_F_TX_IP_CKSUM))
+            fi->hdr_checksum = cne_ipv4_cksum(fi);
+
+        pktmbuf_data_len(m) = pkt->l2_len + hl + len;
+        pktmbuf_port(m)     = pktmbuf_port(pkt);
+        m->packet_type      = pkt->packet_type;
+        m->userptr          = pkt->userptr;
+        m->tx_offload       = pkt->tx_offload;
+        m->ol_flags         = pkt->ol_flags;
+        m->l3_len           = hl;
+
+        off += len;
+    }
+
+    pktmbuf_free(pkt);
+
+    return n;
+}
+
+ip_frag_tbl_t *
+ip_frag_tbl_create(uint32_t nb_entries, uint32_t timeout_ms, uint32_t max_frags,
+                   pktmbuf_info_t *pi)
+{
+    ip_frag_tbl_t *tbl;
+    uint32_t nb_buckets;
+    uint64_t hz;
+
+    if (nb_entries == 0 || timeout_ms == 0)
+        CNE_NULL_RET("invalid arguments\n");
+
+    nb_buckets = cne_align32pow2((nb_entries + IP_FRAG_BUCKET_ENTRIES - 1) /
+                                 IP_FRAG_BUCKET_ENTRIES);
+
+    tbl = calloc(1, sizeof(ip_frag_tbl_t));
+    if (!tbl)
+        CNE_NULL_RET("Unable to allocate the reassembly table\n");
+
+    tbl->buckets = aligned_alloc(CNE_CACHE_LINE_SIZE, nb_buckets * sizeof(struct ip_frag_bucket));
+    tbl->entries = calloc(nb_buckets * IP_FRAG_BUCKET_ENTRIES, sizeof(struct ip_frag_entry));
+    if (!tbl->buckets || !tbl->entries) {
+        ip_frag_tbl_destroy(tbl);
+        CNE_NULL_RET("Unable to allocate %u reassembly buckets\n", nb_buckets);
+    }
+    memset(tbl->buckets, 0, nb_buckets * sizeof(struct ip_frag_bucket));
+
+    if (max_frags == 0)
+        max_frags = nb_buckets * IP_FRAG_BUCKET_ENTRIES * IP_FRAG_MAX_FRAGS;
+
+    hz = cne_get_timer_hz() / 1000;
+
+    tbl->bucket_mask = nb_buckets - 1;
+    tbl->seed        = (uint32_t)cne_rdtsc();
+    tbl->shift       = (hz > 1) ? cne_fls_u64(hz) - 1 : 0;
+    tbl->timeout     = (uint32_t)(((uint64_t)timeout_ms * hz) >> tbl->shift);
+    tbl->max_frags   = max_frags;
+    tbl->pi          = pi;
+
+    return tbl;
+}
+
+/* Free the fragments of a datagram and release its key */
+static void
+ip_frag_drop(ip_frag_tbl_t *tbl, struct ip_frag_entry *e)
+{
+    uint32_t slot = e - tbl->entries;
+
+    tbl->nb_frags -= e->nb_frags;
+    for (uint16_t i = 0; i < e->nb_frags; i++)
+        pktmbuf_free(e->frags[i].m);
+
+    e->total_len = 0;
+    e->recv_len  = 0;
+    e->nb_frags  = 0;
+
+    tbl->buckets[slot / IP_FRAG_BUCKET_ENTRIES].key[slot % IP_FRAG_BUCKET_ENTRIES].valid = 0;
+}
+
+void
+ip_frag_tbl_destroy(ip_frag_tbl_t *tbl)
+{
+    if (!tbl)
+        return;
+
+    if (tbl->buckets && tbl->entries) {
+        for (uint32_t i = 0; i < (tbl->bucket_mask + 1) * IP_FRAG_BUCKET_ENTRIES; i++)
+            ip_frag_drop(tbl, &tbl->entries[i]);
+    }
+
+    free(tbl->buckets);
+    free(tbl->entries);
+    free(tbl);
+}
+
+/*
+ * Find the datagram of a fragment or take a free key in its bucket. A datagram timed out is
+ * dropped and its key reused, returns NULL when the bucket is full.
+ */
+static struct ip_frag_entry *
+ip_frag_lookup(ip_frag_tbl_t *tbl, const struct ip_frag_key *key, uint32_t now)
+{
+    uint32_t idx;
+    struct ip_frag_bucket *b;
+    struct ip_frag_entry *e;
+    int slot = -1, stale = -1;
+
+    idx = cne_jhash_3words(key->src_addr, key->dst_addr, ((uint32_t)key->proto << 16) | key->id,
+                           tbl->seed) &
+          tbl->bucket_mask;
+    b = &tbl->buckets[idx];
+    e = &tbl->entries[idx * IP_FRAG_BUCKET_ENTRIES];
+
+    for (int i = 0; i < IP_FRAG_BUCKET_ENTRIES; i++) {
+        const struct ip_frag_key *k = &b->key[i];
+
+        if (!k->valid) {
+            if (slot < 0)
+                slot = i;
+            continue;
+        }
+
+        if (k->src_addr == key->src_addr && k->dst_addr == key->dst_addr && k->id == key->id &&
+            k->proto == key->proto) {
+            if (!ip_frag_expired(now, b->expire[i]))
+                return &e[i];
+
+            /* The fragments held are too old, start the datagram again */
+            tbl->stats.timeout++;
+            ip_frag_drop(tbl, &e[i]);
+            slot = i;
+            break;
+        }
+
+        if (stale < 0 && ip_frag_expired(now, b->expire[i]))
+            stale = i;
+    }
+
+    if (slot < 0) {
+        if (stale < 0) {
+            tbl->stats.table_full++;
+            return NULL;
+        }
+        tbl->stats.timeout++;
+        ip_frag_drop(tbl, &e[stale]);
+        slot = stale;
+    }
+
+    b->key[slot]    = *key;
+    b->expire[slot] = now + tbl->timeout;
+
+    return &e[slot];
+}
+
+/*
+ * The packet type of a fragment has CNE_PTYPE_L4_FRAG and a zero l4_len, set the L4 type and
+ * header length of the datagram like cne_get_ptype() does for a packet which is not a fragment.
+ */
+static void
+ip_frag_l4_parse(pktmbuf_t *m, struct cne_ipv4_hdr *ip, uint16_t l4_off)
+{
+    uint32_t ptype  = m->packet_type & ~CNE_PTYPE_L4_MASK;
+    uint16_t l4_len = 0;
+
+    switch (ip->next_proto_id) {
+    case IPPROTO_UDP:
+        ptype |= CNE_PTYPE_L4_UDP;
+        l4_len = sizeof(struct cne_udp_hdr);
+        break;
+    case IPPROTO_TCP:
+        ptype |= CNE_PTYPE_L4_TCP;
+        l4_len = (pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, l4_off)->data_off & 0xf0) >> 2;
+        break;
+    case IPPROTO_SCTP:
+        ptype |= CNE_PTYPE_L4_SCTP;
+        l4_len = sizeof(struct cne_sctp_hdr);
+        break;
+    default:
+        break;
+    }
+
+    m->packet_type = ptype;
+    m->l3_len      = cne_ipv4_hdr_len(ip);
+    m->l4_len      = l4_len;
+}
+
+/*
+ * Allocate a buffer of the reassembly pool for a datagram of len bytes not fitting in the
+ * buffer of its first fragment, the buffer gets the headroom, headers and metadata of the
+ * first fragment.
+ */
+static pktmbuf_t *
+ip_frag_alloc(ip_frag_tbl_t *tbl, pktmbuf_t *first, uint16_t hdr_len, uint32_t len)
+{
+    pktmbuf_t *m;
+
+    if (!tbl->pi) {
+        tbl->stats.too_big++;
+        return NULL;
+    }
+
+    m = pktmbuf_alloc(tbl->pi);
+    if (!m) {
+        tbl->stats.no_buffer++;
+        return NULL;
+    }
+
+    if ((pktmbuf_data_off(first) + len) > pktmbuf_buf_len(m)) {
+        pktmbuf_free(m);
+        tbl->stats.too_big++;
+        return NULL;
+    }
+
+    /* The headroom holds the metadata unless the pools have external metadata */
+    pktmbuf_data_off(m) = pktmbuf_data_off(first);
+    memcpy(pktmbuf_buf_addr(m), pktmbuf_buf_addr(first), pktmbuf_data_off(first) + hdr_len);
+    if (pktmbuf_metadata(m) != pktmbuf_buf_addr(m) ||
+        pktmbuf_metadata(first) != pktmbuf_buf_addr(first))
+        memcpy(pktmbuf_metadata(m), pktmbuf_metadata(first),
+               CNE_MIN(pktmbuf_metadata_bufsz(m), pktmbuf_metadata_bufsz(first)));
+
+    pktmbuf_port(m) = pktmbuf_port(first);
+    m->packet_type  = first->packet_type;
+    m->hash         = first->hash;
+    m->userptr      = first->userptr;
+    m->tx_offload   = first->tx_offload;
+    m->ol_flags     = first->ol_flags;
+
+    return m;
+}
+
+/*
+ * Copy the payload of the fragments into the first one and make it the datagram, or into a
+ * buffer of the reassembly pool when the datagram does not fit in the first fragment.
+ */
+static pktmbuf_t *
+ip_frag_complete(ip_frag_tbl_t *tbl, struct ip_frag_entry *e)
+{
+    struct ip_frag_piece *first = NULL;
+    struct cne_ipv4_hdr *ip;
+    pktmbuf_t *head;
+    uint16_t data_off;
+
+    for (uint16_t i = 0; i < e->nb_frags; i++) {
+        if (e->frags[i].ofs == 0) {
+            first = &e->frags[i];
+            break;
+        }
+    }
+    if (!first)
+        goto drop;
+
+    head     = first->m;
+    data_off = first->ip_off + first->hlen;
+
+    if ((first->hlen + e->total_len) > CNE_IPV4_MAX_PKT_LEN) {
+        tbl->stats.too_big++;
+        goto drop;
+    }
+
+    if ((data_off + e->total_len) > (pktmbuf_buf_len(head) - pktmbuf_data_off(head))) {
+        head = ip_frag_alloc(tbl, first->m, data_off, data_off + e->total_len);
+        if (!head)
+            goto drop;
+    }
+
+    for (uint16_t i = 0; i < e->nb_frags; i++) {
+        struct ip_frag_piece *p = &e->frags[i];
+
+        if (p->m == head)
+            continue;
+
+        memcpy(pktmbuf_mtod_offset(head, char *, data_off + p->ofs),
+               pktmbuf_mtod_offset(p->m, char *, p->ip_off + p->hlen), p->len);
+        pktmbuf_free(p->m);
+    }
+    tbl->nb_frags -= e->nb_frags;
+
+    ip = pktmbuf_mtod_offset(head, struct cne_ipv4_hdr *, first->ip_off);
+
+    ip->total_length = htobe16(first->hlen + e->total_len);
+    ip->fragment_offset &= htobe16(CNE_IPV4_HDR_DF_FLAG);
+    ip->hdr_checksum    = 0;
+    ip->hdr_checksum    = cne_ipv4_cksum(ip);
+    pktmbuf_data_len(head) = data_off + e->total_len;
+
+    ip_frag_l4_parse(head, ip, data_off);
+
+    /* The fragments are now owned by the datagram, only release the key */
+    e->nb_frags = 0;
+    ip_frag_drop(tbl, e);
+    tbl->stats.reassembled++;
+
+    return head;
+
+drop:
+    ip_frag_drop(tbl, e);
+    return NULL;
+}
+
+pktmbuf_t *
+ip_frag_reassemble(ip_frag_tbl_t *tbl, pktmbuf_t *m, struct cne_ipv4_hdr *ip, uint64_t tsc)
+{
+    struct ip_frag_key key;
+    struct ip_frag_entry *e;
+    struct ip_frag_piece *p;
+    uint16_t flags, ofs, len, end, hlen, tot_len, ip_off;
+    bool last;
+
+    if (!tbl || !m || !ip)
+        CNE_NULL_RET("invalid arguments\n");
+
+    if (!ip_frag_is_fragment(ip))
+        return m;
+
+    flags   = be16toh(ip->fragment_offset);
+    hlen    = cne_ipv4_hdr_len(ip);
+    tot_len = be16toh(ip->total_length);
+    ip_off  = (char *)ip - pktmbuf_mtod(m, char *);
+    ofs     = (flags & CNE_IPV4_HDR_OFFSET_MASK) * CNE_IPV4_HDR_OFFSET_UNITS;
+    last    = !(flags & CNE_IPV4_HDR_MF_FLAG);
+
+    /* A fragment with data in the mbuf, all but the last one a multiple of 8 bytes */
+    if (hlen < sizeof(struct cne_ipv4_hdr) || tot_len <= hlen ||
+        (ip_off + tot_len) > pktmbuf_data_len(m))
+        goto invalid;
+
+    len = tot_len - hlen;
+    if ((!last && (len & (CNE_IPV4_HDR_OFFSET_UNITS - 1))) ||
+        (ofs + len) > (CNE_IPV4_MAX_PKT_LEN - sizeof(struct cne_ipv4_hdr)))
+        goto invalid;
+    end = ofs + len;
+
+    key.src_addr = ip->src_addr;
+    key.dst_addr = ip->dst_addr;
+    key.id       = ip->packet_id;
+    key.proto    = ip->next_proto_id;
+    key.valid    = 1;
+
+    e = ip_frag_lookup(tbl, &key, ip_frag_now(tbl, tsc));
+    if (!e) {
+        pktmbuf_free(m);
+        return NULL;
+    }
+
+    /* Past the end of the datagram or a last fragment with a different end */
+    if (e->total_len && (end > e->total_len || (last && end != e->total_len)))
+        goto invalid_datagram;
+
+    for (uint16_t i = 0; i < e->nb_frags; i++) {
+        p = &e->frags[i];
+
+        if (last && (p->ofs + p->len) > end)
+            goto invalid_datagram;
+
+        /* A duplicate is dropped, any other overlap drops the datagram */
+        if (ofs < (p->ofs + p->len) && p->ofs < end) {
+            if (ofs != p->ofs || len != p->len)
+                goto invalid_datagram;
+            goto invalid;
+        }
+    }
+
+    if (e->nb_frags >= IP_FRAG_MAX_FRAGS) {
+        tbl->stats.too_many++;
+        pktmbuf_free(m);
+        ip_frag_drop(tbl, e);
+        return NULL;
+    }
+
+    /* A full table only takes a fragment completing its datagram, which frees fragments */
+    if (tbl->nb_frags >= tbl->max_frags && (e->recv_len + len) != ((last) ? end : e->total_len)) {
+        tbl->stats.frags_full++;
+        pktmbuf_free(m);
+        if (e->nb_frags == 0)
+            ip_frag_drop(tbl, e);
+        return NULL;
+    }
+
+    p         = &e->frags[e->nb_frags++];
+    p->ofs    = ofs;
+    p->len    = len;
+    p->ip_off = ip_off;
+    p->hlen   = hlen;
+    p->m      = m;
+    tbl->nb_frags++;
+
+    e->recv_len += len;
+    if (last)
+        e->total_len = end;
+
+    /* Complete when the fragments, which do not overlap, cover the whole datagram */
+    if (e->total_len && e->recv_len == e->total_len)
+        return ip_frag_complete(tbl, e);
+
+    return NULL;
+
+invalid_datagram:
+    ip_frag_drop(tbl, e);
+invalid:
+    tbl->stats.invalid++;
+    pktmbuf_free(m);
+    return NULL;
+}
+
+uint32_t
+ip_frag_tbl_expire(ip_frag_tbl_t *tbl, uint64_t tsc, uint32_t nb_buckets)
+{
+    uint32_t now, n = 0;
+
+    if (!tbl)
+        return 0;
+
+    now        = ip_frag_now(tbl, tsc);
+    nb_buckets = CNE_MIN(nb_buckets, tbl->bucket_mask + 1);
+
+    while (nb_buckets--) {
+        struct ip_frag_bucket *b = &tbl->buckets[tbl->cursor];
+
+        for (int i = 0; i < IP_FRAG_BUCKET_ENTRIES; i++) {
+            if (b->key[i].valid && ip_frag_expired(now, b->expire[i])) {
+                ip_frag_drop(tbl, &tbl->entries[tbl->cursor * IP_FRAG_BUCKET_ENTRIES + i]);
+                n++;
+            }
+        }
+        tbl->cursor = (tbl->cursor + 1) & tbl->bucket_mask;
+    }
+    tbl->stats.timeout += n;
+
+    return n;
+}
+
+uint32_t
+ip_frag_tbl_nb_frags(ip_frag_tbl_t *tbl)
+{
+    return (tbl) ? tbl->nb_frags : 0;
+}
+
+int
+ip_frag_tbl_stats_get(ip_frag_tbl_t *tbl, struct ip_frag_stats *stats)
+{
+    if (!tbl || !stats)
+        CNE_ERR_RET("invalid arguments\n");
+
+    *stats = tbl->stats;
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation.
+ */
+
+#ifndef __IP_FRAG_H
+#define __IP_FRAG_H
+
+/**
+ * @file
+ * IPv4 fragmentation and reassembly routines.
+ *
+ * A packet larger than the MTU of the interface it is sent on is split into fragments, each
+ * fragment is a new mbuf holding a copy of the L2 header, the IPv4 header and part of the
+ * payload.
+ *
+ * Received fragments are held in a reassembly table until all the fragments of the datagram
+ * are received or the datagram times out. The table is bounded, it holds a fixed number of
+ * datagrams, at most IP_FRAG_MAX_FRAGS fragments per datagram and at most the max number of
+ * fragments it was created with, so a flood of fragments can not hold more mbufs than that.
+ * The datagrams are hashed with a random seed into cache line sized buckets of
+ * IP_FRAG_BUCKET_ENTRIES keys, a fragment of a new datagram is dropped when its bucket is full
+ * of datagrams not yet timed out. The timed out datagrams are only freed when a fragment hashed
+ * to their bucket is received or ip_frag_tbl_expire() is called, the user of the table calls it
+ * periodically to free the fragments held when no fragments are received.
+ *
+ * The fragments are copied into the first fragment of the datagram when the datagram fits in
+ * its buffer, a larger datagram is copied into a buffer of the reassembly pool given to the
+ * table. The pool buffers are single mbufs, a datagram must fit in one of them. The table is
+ * not thread safe, it is used by the thread which created it.
+ */
+
+#include <stdint.h>            // for uint16_t, uint32_t, uint64_t
+#include <stdbool.h>           // for bool
+#include <cne_common.h>        // for CNDP_API
+#include <pktmbuf.h>           // for pktmbuf_t, pktmbuf_info_t
+#include <net/cne_ip.h>        // for cne_ipv4_hdr, CNE_IPV4_HDR_MF_FLAG
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IP_FRAG_MAX_FRAGS      8  /**< Max number of fragments held for a datagram */
+#define IP_FRAG_BUCKET_ENTRIES 4  /**< Number of datagrams in a bucket of the table */
+#define IP_FRAG_MAX_OUT        64 /**< Max number of fragments created from one packet */
+
+/**
+ * Reassembly table statistics.
+ */
+struct ip_frag_stats {
+    uint64_t reassembled; /**< Datagrams reassembled */
+    uint64_t timeout;     /**< Datagrams dropped as not complete before the timeout */
+    uint64_t table_full;  /**< Fragments dropped as the bucket of the datagram is full */
+    uint64_t invalid;     /**< Fragments dropped as invalid, duplicate or overlapping */
+    uint64_t too_many;    /**< Datagrams dropped with more than IP_FRAG_MAX_FRAGS fragments */
+    uint64_t too_big;     /**< Datagrams dropped as larger than the reassembly buffers */
+    uint64_t no_buffer;   /**< Datagrams dropped as the reassembly pool is empty */
+    uint64_t frags_full;  /**< Fragments dropped as the table holds its max number of fragments */
+};
+
+typedef struct ip_frag_tbl ip_frag_tbl_t; /**< Opaque reassembly table */
+
+/**
+ * Test if an IPv4 packet is a fragment.
+ *
+ * @param ip
+ *   The IPv4 header of the packet.
+ * @return
+ *   true if the packet has the MF flag or a fragment offset set, false if not.
+ */
+static inline bool
+ip_frag_is_fragment(const struct cne_ipv4_hdr *ip)
+{
+    return (ip->fragment_offset & htobe16(CNE_IPV4_HDR_MF_FLAG | CNE_IPV4_HDR_OFFSET_MASK)) != 0;
+}
+
+/**
+ * Fragment an IPv4 packet into packets of at most mtu bytes of IPv4 header and payload.
+ *
+ * The IPv4 header is found at l2_len bytes in the packet, the l2_len bytes in front of it
+ * are copied into each fragment. The first fragment keeps all the IPv4 options and the
+ * following fragments only the options with the copied flag set. The fragment offset and
+ * MF flag of a packet which is already a fragment are kept in the fragments. The IPv4
+ * header checksum of each fragment is computed, unless CNE_MBUF_F_TX_IP_CKSUM is set in
+ * the packet ol_flags to leave it to the NIC.
+ *
+ * On success the input packet is freed.
+ *
+ * @param pkt
+ *   The packet to fragment, the packet must be a single mbuf without the DF flag set.
+ * @param mtu
+ *   The max number of bytes of IPv4 header and payload in a fragment.
+ * @param pi
+ *   The pool to allocate the fragments from, NULL to use the pool of the packet.
+ * @param frags
+ *   The array to return the fragments in.
+ * @param nb_frags
+ *   The number of entries in the frags array.
+ * @return
+ *   The number of fragments in the frags array, 0 if the packet fits in the MTU or -1 on
+ *   error and the packet is not freed.
+ */
+CNDP_API int ip_frag_ipv4(pktmbuf_t *pkt, uint16_t mtu, pktmbuf_info_t *pi, pktmbuf_t **frags,
+                          uint16_t nb_frags);
+
+/**
+ * Create a reassembly table.
+ *
+ * @param nb_entries
+ *   The max number of datagrams being reassembled, rounded up to a power of 2 number of
+ *   buckets of IP_FRAG_BUCKET_ENTRIES datagrams.
+ * @param timeout_ms
+ *   The max time in milliseconds between the first fragment of a datagram and the fragment
+ *   completing it.
+ * @param max_frags
+ *   The max number of fragments held in the table, 0 for nb_entries * IP_FRAG_MAX_FRAGS. When
+ *   the table holds max_frags fragments a new fragment is dropped, unless it completes its
+ *   datagram.
+ * @param pi
+ *   The pool of the buffers for the datagrams larger than the buffer of their first fragment,
+ *   NULL to drop these datagrams.
+ * @return
+ *   The reassembly table pointer or NULL on error.
+ */
+CNDP_API ip_frag_tbl_t *ip_frag_tbl_create(uint32_t nb_entries, uint32_t timeout_ms,
+                                           uint32_t max_frags, pktmbuf_info_t *pi);
+
+/**
+ * Destroy a reassembly table and free the fragments it holds.
+ *
+ * @param tbl
+ *   The reassembly table pointer, can be NULL.
+ */
+CNDP_API void ip_frag_tbl_destroy(ip_frag_tbl_t *tbl);
+
+/**
+ * Add a fragment to the reassembly table.
+ *
+ * The fragment is consumed, it is held in the table, freed when invalid or returned as part
+ * of the reassembled datagram. The reassembled datagram is the mbuf of the first fragment or,
+ * when it does not fit in it, a buffer of the reassembly pool holding a copy of the headroom,
+ * metadata and headers of the first fragment. Its data length, IPv4 total length, fragment
+ * offset and header checksum are updated. The L4 packet type, l3_len and l4_len of the mbuf
+ * are set from the IPv4 and L4 headers.
+ *
+ * @param tbl
+ *   The reassembly table pointer
+ * @param m
+ *   The fragment, its data length must cover the IPv4 total length.
+ * @param ip
+ *   The IPv4 header in the fragment.
+ * @param tsc
+ *   The current TSC value, see cne_rdtsc().
+ * @return
+ *   The reassembled datagram or NULL if the datagram is not complete or was dropped. A packet
+ *   which is not a fragment is returned as is.
+ */
+CNDP_API pktmbuf_t *ip_frag_reassemble(ip_frag_tbl_t *tbl, pktmbuf_t *m, struct cne_ipv4_hdr *ip,
+                                       uint64_t tsc);
+
+/**
+ * Free the fragments of the timed out datagrams in a part of the table.
+ *
+ * Timed out datagrams are also dropped when a fragment hashed to their bucket is added,
+ * calling this routine frees the mbufs of the datagrams no longer receiving fragments. It is
+ * called periodically, not only when fragments are received.
+ *
+ * @param tbl
+ *   The reassembly table pointer
+ * @param tsc
+ *   The current TSC value, see cne_rdtsc().
+ * @param nb_buckets
+ *   The number of buckets to look at, starting after the last bucket of the previous call,
+ *   UINT32_MAX to look at the whole table.
+ * @return
+ *   The number of datagrams dropped.
+ */
+CNDP_API uint32_t ip_frag_tbl_expire(ip_frag_tbl_t *tbl, uint64_t tsc, uint32_t nb_buckets);
+
+/**
+ * Get the number of fragments held in a reassembly table.
+ *
+ * @param tbl
+ *   The reassembly table pointer
+ * @return
+ *   The number of fragments held.
+ */
+CNDP_API uint32_t ip_frag_tbl_nb_frags(ip_frag_tbl_t *tbl);
+
+/**
+ * Get the statistics of a reassembly table.
+ *
+ * @param tbl
+ *   The reassembly table pointer
+ * @param stats
+ *   The structure to copy the statistics into.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int ip_frag_tbl_stats_get(ip_frag_tbl_t *tbl, struct ip_frag_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IP_FRAG_H */
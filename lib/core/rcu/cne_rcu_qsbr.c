@@ -0,0 +1,370 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2018-2020 Arm Limited
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>               // for fprintf, stdout, snprintf
+#include <stdint.h>              // for uint64_t, uint32_t, UINT64_MAX
+#include <inttypes.h>            // for PRIu64
+#include <stdlib.h>              // for calloc, aligned_alloc, free
+#include <string.h>              // for memcpy, memset
+#include <cne_common.h>          // for CNE_ALIGN_CEIL, cne_align32pow2
+#include <cne_log.h>             // for CNE_NULL_RET, CNE_ERR_RET
+#include <cne_pause.h>           // for cne_pause
+#include <cne_spinlock.h>        // for cne_spinlock_lock, cne_spinlock_unlock
+#include <cne_ring_api.h>        // for cne_ring_create, cne_ring_enqueue_elem
+
+#include "cne_rcu_qsbr.h"
+
+/* Number of thread IDs in one element of the registered thread bitmap */
+#define QSBR_THRID_ELEM_BITS 64
+
+struct cne_rcu_qsbr_dq {
+    struct cne_rcu_qsbr *v;               /**< QSBR variable used by the queue */
+    cne_ring_t *r;                        /**< Ring of [token, element] entries */
+    cne_spinlock_t lock;                  /**< Serializes the queue, unless MT unsafe */
+    uint32_t flags;                       /**< CNE_RCU_QSBR_DQ_* flags */
+    uint32_t size;                        /**< Number of elements the queue can hold */
+    uint32_t esize;                       /**< Size of an element */
+    uint32_t entry_size;                  /**< Size of a ring entry, token included */
+    uint32_t trigger_reclaim_limit;       /**< Reclaim on enqueue above this many elements */
+    uint32_t max_reclaim_size;            /**< Max elements reclaimed on enqueue */
+    cne_rcu_qsbr_free_resource_t free_fn; /**< Function to free the elements */
+    void *p;                              /**< Opaque pointer passed to free_fn */
+    uint32_t held;                        /**< The head entry was dequeued but not freed */
+    uint64_t *head;                       /**< Head entry of the queue, when held is set */
+    uint64_t *tmp;                        /**< Entry built by cne_rcu_qsbr_dq_enqueue() */
+};
+
+struct cne_rcu_qsbr *
+cne_rcu_qsbr_create(uint32_t max_threads)
+{
+    struct cne_rcu_qsbr *v;
+    uint32_t num_elems;
+    size_t sz;
+
+    if (max_threads == 0)
+        CNE_NULL_RET("Invalid max_threads %u\n", max_threads);
+
+    num_elems = CNE_ALIGN_CEIL(max_threads, QSBR_THRID_ELEM_BITS) / QSBR_THRID_ELEM_BITS;
+
+    sz = sizeof(struct cne_rcu_qsbr) + (sizeof(struct cne_rcu_qsbr_cnt) * max_threads);
+
+    v = aligned_alloc(CNE_CACHE_LINE_SIZE,
+                      CNE_ALIGN_CEIL(sz + (num_elems * sizeof(uint64_t)), CNE_CACHE_LINE_SIZE));
+    if (!v)
+        CNE_NULL_RET("Unable to allocate QSBR variable\n");
+    memset(v, 0, sz + (num_elems * sizeof(uint64_t)));
+
+    v->max_threads   = max_threads;
+    v->num_elems     = num_elems;
+    v->reg_thread_id = (uint64_t *)((uint8_t *)v + sz);
+    v->token         = CNE_QSBR_CNT_INIT;
+    v->acked_token   = CNE_QSBR_CNT_INIT - 1;
+
+    return v;
+}
+
+void
+cne_rcu_qsbr_destroy(struct cne_rcu_qsbr *v)
+{
+    free(v);
+}
+
+int
+cne_rcu_qsbr_thread_register(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    uint64_t bit, old;
+
+    if (!v || thread_id >= v->max_threads)
+        CNE_ERR_RET("Invalid QSBR variable or thread ID %u\n", thread_id);
+
+    bit = 1ULL << (thread_id % QSBR_THRID_ELEM_BITS);
+
+    old = __atomic_fetch_or(&v->reg_thread_id[thread_id / QSBR_THRID_ELEM_BITS], bit,
+                            __ATOMIC_RELAXED);
+    if (!(old & bit))
+        __atomic_fetch_add(&v->num_threads, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+int
+cne_rcu_qsbr_thread_unregister(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    uint64_t bit, old;
+
+    if (!v || thread_id >= v->max_threads)
+        CNE_ERR_RET("Invalid QSBR variable or thread ID %u\n", thread_id);
+
+    bit = 1ULL << (thread_id % QSBR_THRID_ELEM_BITS);
+
+    /* The counter updates of the thread must be done before it leaves the bitmap */
+    old = __atomic_fetch_and(&v->reg_thread_id[thread_id / QSBR_THRID_ELEM_BITS], ~bit,
+                             __ATOMIC_RELEASE);
+    if (old & bit)
+        __atomic_fetch_sub(&v->num_threads, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+int
+__cne_rcu_qsbr_check_all(struct cne_rcu_qsbr *v, uint64_t t, bool wait)
+{
+    uint64_t acked = UINT64_MAX;
+
+    for (uint32_t i = 0; i < v->num_elems; i++) {
+        uint64_t bmap = __atomic_load_n(&v->reg_thread_id[i], __ATOMIC_ACQUIRE);
+
+        while (bmap) {
+            uint32_t id = (i * QSBR_THRID_ELEM_BITS) + __builtin_ctzll(bmap);
+            uint64_t c  = __atomic_load_n(&v->qsbr_cnt[id].cnt, __ATOMIC_ACQUIRE);
+
+            if (unlikely(c != CNE_QSBR_CNT_THR_OFFLINE && c < t)) {
+                if (!wait)
+                    return 0;
+                cne_pause();
+
+                /* The thread could have unregistered while waiting */
+                bmap = __atomic_load_n(&v->reg_thread_id[i], __ATOMIC_ACQUIRE) &
+                       ~((1ULL << (id % QSBR_THRID_ELEM_BITS)) - 1);
+                continue;
+            }
+
+            /* Offline threads do not limit the acknowledged token */
+            if (c != CNE_QSBR_CNT_THR_OFFLINE && c < acked)
+                acked = c;
+
+            bmap &= ~(1ULL << (id % QSBR_THRID_ELEM_BITS));
+        }
+    }
+
+    /* All the threads are offline, every token up to t is acknowledged */
+    if (acked == UINT64_MAX)
+        acked = t;
+
+    if (acked > __atomic_load_n(&v->acked_token, __ATOMIC_RELAXED))
+        __atomic_store_n(&v->acked_token, acked, __ATOMIC_RELEASE);
+
+    return 1;
+}
+
+void
+cne_rcu_qsbr_synchronize(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    uint64_t t;
+
+    t = cne_rcu_qsbr_start(v);
+
+    /* The caller is a reader, it cannot hold references while it waits */
+    if (thread_id != CNE_QSBR_THRID_INVALID)
+        cne_rcu_qsbr_quiescent(v, thread_id);
+
+    cne_rcu_qsbr_check(v, t, true);
+}
+
+void
+cne_rcu_qsbr_dump(FILE *f, struct cne_rcu_qsbr *v)
+{
+    if (!f)
+        f = stdout;
+
+    if (!v) {
+        fprintf(f, "QSBR variable is NULL\n");
+        return;
+    }
+
+    fprintf(f, "QSBR variable %p\n", v);
+    fprintf(f, "  Max threads   = %u\n", v->max_threads);
+    fprintf(f, "  Num threads   = %u\n", __atomic_load_n(&v->num_threads, __ATOMIC_ACQUIRE));
+    fprintf(f, "  Token         = %" PRIu64 "\n", __atomic_load_n(&v->token, __ATOMIC_ACQUIRE));
+    fprintf(f, "  Least acked   = %" PRIu64 "\n",
+            __atomic_load_n(&v->acked_token, __ATOMIC_ACQUIRE));
+    fprintf(f, "  Thread counters:\n");
+
+    for (uint32_t i = 0; i < v->num_elems; i++) {
+        uint64_t bmap = __atomic_load_n(&v->reg_thread_id[i], __ATOMIC_ACQUIRE);
+
+        while (bmap) {
+            uint32_t id = (i * QSBR_THRID_ELEM_BITS) + __builtin_ctzll(bmap);
+
+            fprintf(f, "    %3u: %" PRIu64 "\n", id,
+                    __atomic_load_n(&v->qsbr_cnt[id].cnt, __ATOMIC_ACQUIRE));
+            bmap &= bmap - 1;
+        }
+    }
+}
+
+static inline void
+dq_lock(struct cne_rcu_qsbr_dq *dq)
+{
+    if (!(dq->flags & CNE_RCU_QSBR_DQ_MT_UNSAFE))
+        cne_spinlock_lock(&dq->lock);
+}
+
+static inline void
+dq_unlock(struct cne_rcu_qsbr_dq *dq)
+{
+    if (!(dq->flags & CNE_RCU_QSBR_DQ_MT_UNSAFE))
+        cne_spinlock_unlock(&dq->lock);
+}
+
+/*
+ * Free up to n entries in FIFO order, stopping at the first entry still in its
+ * grace period. The ring has no peek operation, so the head entry is kept in
+ * dq->head until it can be freed. Called with the queue locked.
+ */
+static unsigned int
+dq_reclaim(struct cne_rcu_qsbr_dq *dq, unsigned int n)
+{
+    unsigned int cnt = 0;
+
+    while (cnt < n) {
+        if (!dq->held) {
+            if (cne_ring_dequeue_elem(dq->r, dq->head, dq->entry_size) != 0)
+                break;
+            dq->held = 1;
+        }
+
+        if (cne_rcu_qsbr_check(dq->v, dq->head[0], false) != 1)
+            break;
+
+        dq->free_fn(dq->p, &dq->head[1], 1);
+        dq->held = 0;
+        cnt++;
+    }
+
+    return cnt;
+}
+
+static inline unsigned int
+dq_pending(struct cne_rcu_qsbr_dq *dq)
+{
+    return cne_ring_count(dq->r) + dq->held;
+}
+
+struct cne_rcu_qsbr_dq *
+cne_rcu_qsbr_dq_create(const struct cne_rcu_qsbr_dq_parameters *params)
+{
+    struct cne_rcu_qsbr_dq *dq;
+    char name[CNE_RCU_QSBR_NAMESIZE];
+
+    if (!params || !params->v || !params->free_fn || params->size == 0 || params->esize == 0 ||
+        (params->esize % 4) != 0 || params->max_reclaim_size == 0)
+        CNE_NULL_RET("Invalid defer queue parameters\n");
+
+    dq = calloc(1, sizeof(struct cne_rcu_qsbr_dq));
+    if (!dq)
+        CNE_NULL_RET("Unable to allocate defer queue\n");
+
+    dq->v                     = params->v;
+    dq->flags                 = params->flags;
+    dq->size                  = params->size;
+    dq->esize                 = params->esize;
+    dq->entry_size            = CNE_ALIGN_CEIL(sizeof(uint64_t) + params->esize, sizeof(uint64_t));
+    dq->trigger_reclaim_limit = params->trigger_reclaim_limit;
+    dq->max_reclaim_size      = params->max_reclaim_size;
+    dq->free_fn               = params->free_fn;
+    dq->p                     = params->p;
+    cne_spinlock_init(&dq->lock);
+
+    dq->head = calloc(2, dq->entry_size);
+    if (!dq->head)
+        CNE_ERR_GOTO(err, "Unable to allocate defer queue entries\n");
+    dq->tmp = (uint64_t *)((uint8_t *)dq->head + dq->entry_size);
+
+    snprintf(name, sizeof(name), "DQ_%s", (params->name) ? params->name : "");
+
+    /* The usable size of a ring is one less than its count */
+    dq->r = cne_ring_create(name, dq->entry_size, cne_align32pow2(params->size + 1),
+                            RING_F_SP_ENQ | RING_F_SC_DEQ);
+    if (!dq->r)
+        CNE_ERR_GOTO(err, "Unable to create defer queue ring %s\n", name);
+
+    return dq;
+err:
+    free(dq->head);
+    free(dq);
+    return NULL;
+}
+
+int
+cne_rcu_qsbr_dq_enqueue(struct cne_rcu_qsbr_dq *dq, void *e)
+{
+    if (!dq || !e)
+        CNE_ERR_RET("Invalid defer queue or element\n");
+
+    dq_lock(dq);
+
+    if (dq_pending(dq) >= dq->trigger_reclaim_limit)
+        dq_reclaim(dq, dq->max_reclaim_size);
+
+    /* Queue is full, free what is possible and check once more */
+    if (dq_pending(dq) >= dq->size) {
+        dq_reclaim(dq, dq->max_reclaim_size);
+        if (dq_pending(dq) >= dq->size) {
+            dq_unlock(dq);
+            CNE_ERR_RET("Defer queue is full\n");
+        }
+    }
+
+    /* Start the grace period after the caller removed the element */
+    dq->tmp[0] = cne_rcu_qsbr_start(dq->v);
+    memcpy(&dq->tmp[1], e, dq->esize);
+
+    /* The ring holds at least size entries, this cannot fail */
+    cne_ring_enqueue_elem(dq->r, dq->tmp, dq->entry_size);
+
+    dq_unlock(dq);
+
+    return 0;
+}
+
+int
+cne_rcu_qsbr_dq_reclaim(struct cne_rcu_qsbr_dq *dq, unsigned int n, unsigned int *freed,
+                        unsigned int *pending, unsigned int *available)
+{
+    unsigned int cnt;
+
+    if (!dq || n == 0)
+        CNE_ERR_RET("Invalid defer queue or reclaim count\n");
+
+    dq_lock(dq);
+
+    cnt = dq_reclaim(dq, n);
+
+    if (freed)
+        *freed = cnt;
+    if (pending)
+        *pending = dq_pending(dq);
+    if (available)
+        *available = dq->size - dq_pending(dq);
+
+    dq_unlock(dq);
+
+    return 0;
+}
+
+int
+cne_rcu_qsbr_dq_delete(struct cne_rcu_qsbr_dq *dq)
+{
+    unsigned int pending;
+
+    if (!dq)
+        return 0;
+
+    /* Wait for the readers until every element was given back with free_fn */
+    for (;;) {
+        if (cne_rcu_qsbr_dq_reclaim(dq, ~0U, NULL, &pending, NULL) < 0)
+            return -1;
+        if (pending == 0)
+            break;
+        cne_rcu_qsbr_synchronize(dq->v, CNE_QSBR_THRID_INVALID);
+    }
+
+    cne_ring_free(dq->r);
+    free(dq->head);
+    free(dq);
+
+    return 0;
+}
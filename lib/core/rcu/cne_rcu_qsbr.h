@@ -0,0 +1,328 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2018-2020 Arm Limited
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_RCU_QSBR_H_
+#define _CNE_RCU_QSBR_H_
+
+/**
+ * @file
+ * CNE Quiescent State Based Reclamation (QSBR)
+ *
+ * Lock-free data structures, e.g. a FIB or a hash table using lock free read/write
+ * concurrency, let readers run without taking a lock while a writer updates the
+ * structure. The writer can unlink an element, but it must not free or reuse the
+ * memory until every reader that could hold a reference has stopped using it.
+ *
+ * With QSBR each reader thread reports a quiescent state, a point where it does
+ * not hold any reference to the shared data, e.g. once per graph walk iteration.
+ * The writer takes a token after unlinking the element and the memory can be
+ * freed once all registered and online readers have reported a quiescent state
+ * after the token was taken. The defer queue (cne_rcu_qsbr_dq_*) keeps the
+ * unlinked elements with their token and frees them in batches, so the writer
+ * does not have to wait for the readers.
+ */
+
+#include <stdio.h>          // for FILE
+#include <stdint.h>         // for uint64_t, uint32_t
+#include <stdbool.h>        // for bool
+#include <cne_common.h>
+#include <cne_branch_prediction.h>        // for likely
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_RCU_QSBR_NAMESIZE 32 /**< Max size of a defer queue name */
+
+/** Thread ID used to tell cne_rcu_qsbr_synchronize() the caller is not a reader */
+#define CNE_QSBR_THRID_INVALID 0xffffffff
+
+#define CNE_QSBR_CNT_THR_OFFLINE 0 /**< Counter value of an offline reader thread */
+#define CNE_QSBR_CNT_INIT        1 /**< Initial value of the token */
+
+/**
+ * @internal
+ * Quiescent state counter of a reader thread, one cache line per thread.
+ */
+struct cne_rcu_qsbr_cnt {
+    uint64_t cnt; /**< Last token acknowledged, CNE_QSBR_CNT_THR_OFFLINE when offline */
+} __cne_cache_aligned;
+
+/**
+ * @internal
+ * QSBR variable, the reader counters and the bitmap of registered thread IDs
+ * are allocated in the same memory block.
+ */
+struct cne_rcu_qsbr {
+    uint64_t token __cne_cache_aligned; /**< Counter incremented by cne_rcu_qsbr_start() */
+    uint64_t acked_token;   /**< Least token acknowledged by all the threads in the last check */
+    uint32_t max_threads;   /**< Maximum number of reader threads */
+    uint32_t num_threads;   /**< Number of reader threads currently registered */
+    uint32_t num_elems;     /**< Number of uint64_t elements in the thread ID bitmap */
+    uint64_t *reg_thread_id; /**< Bitmap of registered thread IDs */
+    struct cne_rcu_qsbr_cnt qsbr_cnt[0] __cne_cache_aligned; /**< Reader counters */
+};
+
+/**
+ * Create a QSBR variable.
+ *
+ * @param max_threads
+ *   Maximum number of reader threads that can report quiescent states.
+ * @return
+ *   Pointer to the QSBR variable or NULL on error.
+ */
+CNDP_API struct cne_rcu_qsbr *cne_rcu_qsbr_create(uint32_t max_threads);
+
+/**
+ * Free a QSBR variable.
+ *
+ * @param v
+ *   Pointer to the QSBR variable, can be NULL.
+ */
+CNDP_API void cne_rcu_qsbr_destroy(struct cne_rcu_qsbr *v);
+
+/**
+ * Register a reader thread to report its quiescent state. The thread is
+ * registered in the offline state, call cne_rcu_qsbr_thread_online() before it
+ * starts to access the shared data.
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @param thread_id
+ *   Reader thread ID, less than the max_threads value given at create time.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cne_rcu_qsbr_thread_register(struct cne_rcu_qsbr *v, unsigned int thread_id);
+
+/**
+ * Unregister a reader thread, the thread must be offline.
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @param thread_id
+ *   Reader thread ID.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cne_rcu_qsbr_thread_unregister(struct cne_rcu_qsbr *v, unsigned int thread_id);
+
+/**
+ * Mark a registered reader thread online, the writer waits for online threads
+ * to report a quiescent state. Must be called by the reader thread itself.
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @param thread_id
+ *   Reader thread ID.
+ */
+static inline void
+cne_rcu_qsbr_thread_online(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    uint64_t t;
+
+    /* Copy the current token, the thread has seen every update done before it */
+    t = __atomic_load_n(&v->token, __ATOMIC_RELAXED);
+    __atomic_store_n(&v->qsbr_cnt[thread_id].cnt, t, __ATOMIC_RELAXED);
+
+    /* The counter must be visible before the reader loads any shared data */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * Mark a reader thread offline, e.g. before it blocks. The writer does not wait
+ * for offline threads. Must be called by the reader thread itself.
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @param thread_id
+ *   Reader thread ID.
+ */
+static inline void
+cne_rcu_qsbr_thread_offline(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    /* The loads of shared data must complete before the thread goes offline */
+    __atomic_store_n(&v->qsbr_cnt[thread_id].cnt, CNE_QSBR_CNT_THR_OFFLINE, __ATOMIC_RELEASE);
+}
+
+/**
+ * Report a quiescent state, the reader does not hold any reference to shared
+ * data at this point. Must be called by the reader thread itself.
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @param thread_id
+ *   Reader thread ID.
+ */
+static inline void
+cne_rcu_qsbr_quiescent(struct cne_rcu_qsbr *v, unsigned int thread_id)
+{
+    uint64_t t;
+
+    t = __atomic_load_n(&v->token, __ATOMIC_ACQUIRE);
+
+    /* Avoid writing the shared cache line when nothing changed */
+    if (t != __atomic_load_n(&v->qsbr_cnt[thread_id].cnt, __ATOMIC_RELAXED))
+        __atomic_store_n(&v->qsbr_cnt[thread_id].cnt, t, __ATOMIC_RELEASE);
+}
+
+/**
+ * Start a grace period, called by the writer after removing the references to
+ * an element from the shared data.
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @return
+ *   Token to pass to cne_rcu_qsbr_check().
+ */
+static inline uint64_t
+cne_rcu_qsbr_start(struct cne_rcu_qsbr *v)
+{
+    return __atomic_add_fetch(&v->token, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @internal
+ * Scan the counters of the registered threads, used by cne_rcu_qsbr_check().
+ */
+CNDP_API int __cne_rcu_qsbr_check_all(struct cne_rcu_qsbr *v, uint64_t t, bool wait);
+
+/**
+ * Check if all the online reader threads reported a quiescent state after the
+ * token was taken with cne_rcu_qsbr_start().
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @param t
+ *   Token returned by cne_rcu_qsbr_start().
+ * @param wait
+ *   Wait for the readers when true, otherwise return immediately.
+ * @return
+ *   1 if the grace period is over and 0 if it is not.
+ */
+static inline int
+cne_rcu_qsbr_check(struct cne_rcu_qsbr *v, uint64_t t, bool wait)
+{
+    /* Another check already found all the readers past this token */
+    if (likely(t <= __atomic_load_n(&v->acked_token, __ATOMIC_ACQUIRE)))
+        return 1;
+
+    return __cne_rcu_qsbr_check_all(v, t, wait);
+}
+
+/**
+ * Wait until all the online reader threads reported a quiescent state, the
+ * writer can free the memory of the removed elements on return.
+ *
+ * @param v
+ *   Pointer to the QSBR variable.
+ * @param thread_id
+ *   Reader thread ID of the caller, when the caller is also a registered reader,
+ *   or CNE_QSBR_THRID_INVALID.
+ */
+CNDP_API void cne_rcu_qsbr_synchronize(struct cne_rcu_qsbr *v, unsigned int thread_id);
+
+/**
+ * Dump the state of the QSBR variable.
+ *
+ * @param f
+ *   File pointer or NULL for stdout.
+ * @param v
+ *   Pointer to the QSBR variable.
+ */
+CNDP_API void cne_rcu_qsbr_dump(FILE *f, struct cne_rcu_qsbr *v);
+
+/**
+ * Function called by the defer queue to free the resources of deleted elements.
+ *
+ * @param p
+ *   The opaque pointer given in the defer queue parameters.
+ * @param e
+ *   Pointer to the first element, elements are esize bytes apart.
+ * @param n
+ *   Number of elements to free.
+ */
+typedef void (*cne_rcu_qsbr_free_resource_t)(void *p, void *e, unsigned int n);
+
+/** The caller serializes all the defer queue calls, no internal lock is taken */
+#define CNE_RCU_QSBR_DQ_MT_UNSAFE (1 << 0)
+
+/** Defer queue parameters */
+struct cne_rcu_qsbr_dq_parameters {
+    const char *name;                     /**< Name of the defer queue */
+    uint32_t flags;                       /**< CNE_RCU_QSBR_DQ_* flags */
+    uint32_t size;                        /**< Number of elements the queue can hold */
+    uint32_t esize;                       /**< Size of an element, a multiple of 4 bytes */
+    uint32_t trigger_reclaim_limit;       /**< Reclaim on enqueue above this many elements */
+    uint32_t max_reclaim_size;            /**< Max elements reclaimed on enqueue */
+    cne_rcu_qsbr_free_resource_t free_fn; /**< Function to free the elements */
+    void *p;                              /**< Opaque pointer passed to free_fn */
+    struct cne_rcu_qsbr *v;               /**< QSBR variable used by the queue */
+};
+
+struct cne_rcu_qsbr_dq;
+
+/**
+ * Create a defer queue.
+ *
+ * @param params
+ *   The defer queue parameters.
+ * @return
+ *   Pointer to the defer queue or NULL on error.
+ */
+CNDP_API struct cne_rcu_qsbr_dq *
+cne_rcu_qsbr_dq_create(const struct cne_rcu_qsbr_dq_parameters *params);
+
+/**
+ * Enqueue an element removed from the shared data, the element is freed with
+ * free_fn once the readers reported a quiescent state. Elements are reclaimed
+ * first when the queue holds more than trigger_reclaim_limit elements or is full.
+ *
+ * @param dq
+ *   Pointer to the defer queue.
+ * @param e
+ *   Pointer to the element, esize bytes are copied.
+ * @return
+ *   0 on success or -1 if the queue is full.
+ */
+CNDP_API int cne_rcu_qsbr_dq_enqueue(struct cne_rcu_qsbr_dq *dq, void *e);
+
+/**
+ * Free the elements whose grace period is over, without waiting for the readers.
+ *
+ * @param dq
+ *   Pointer to the defer queue.
+ * @param n
+ *   Maximum number of elements to free.
+ * @param freed
+ *   Number of elements freed, can be NULL.
+ * @param pending
+ *   Number of elements still in the queue, can be NULL.
+ * @param available
+ *   Number of free entries in the queue, can be NULL.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cne_rcu_qsbr_dq_reclaim(struct cne_rcu_qsbr_dq *dq, unsigned int n,
+                                     unsigned int *freed, unsigned int *pending,
+                                     unsigned int *available);
+
+/**
+ * Delete a defer queue, after freeing all its elements with free_fn. The call
+ * waits for the grace period of the elements still in the queue, like
+ * cne_rcu_qsbr_synchronize() it must not be called by an online reader thread.
+ *
+ * @param dq
+ *   Pointer to the defer queue, can be NULL.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cne_rcu_qsbr_dq_delete(struct cne_rcu_qsbr_dq *dq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_RCU_QSBR_H_ */
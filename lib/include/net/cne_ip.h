@@ -16,9 +16,13 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <sys/types.h>
 #include <netinet/in.h>
 #include <netinet/ip.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #include <cne_byteorder.h>
 #include <pktmbuf.h>
@@ -114,6 +118,84 @@ cne_ipv4_hdr_len(const struct cne_ipv4_hdr *ipv4_hdr)
     return (uint8_t)((ipv4_hdr->version_ihl & CNE_IPV4_HDR_IHL_MASK) * CNE_IPV4_IHL_MULTIPLIER);
 }
 
+#if defined(__AVX512F__)
+#define CNE_CKSUM_VEC_SIZE 64 /**< Bytes summed per vector by __cne_raw_cksum_vec() */
+#elif defined(__AVX2__)
+#define CNE_CKSUM_VEC_SIZE 32 /**< Bytes summed per vector by __cne_raw_cksum_vec() */
+#endif
+
+#ifdef CNE_CKSUM_VEC_SIZE
+/** Vectors summed before the 32 bit lanes are folded, each vector adds up to 0x1fffe a lane */
+#define CNE_CKSUM_VEC_BLOCK 16384
+
+/**
+ * @internal Calculate a sum of all words in a buffer of a multiple of CNE_CKSUM_VEC_SIZE bytes
+ * with AVX2 or AVX-512 instructions. Helper routine for __cne_raw_cksum().
+ *
+ * The words are zero extended to 32 bit lanes and added, the lanes are folded into the
+ * sum every CNE_CKSUM_VEC_BLOCK vectors. The one's complement sum does not depend on the
+ * order the words are added in, the result is the same as the scalar loop.
+ *
+ * @param buf
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer, a multiple of CNE_CKSUM_VEC_SIZE.
+ * @param sum
+ *   Initial value of the sum.
+ * @return
+ *   sum += Sum of all words in the buffer.
+ */
+static inline uint32_t
+__cne_raw_cksum_vec(const void *buf, size_t len, uint32_t sum)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+    uint64_t sum64   = sum;
+
+    while (len) {
+        size_t n = len / CNE_CKSUM_VEC_SIZE;
+
+        if (n > CNE_CKSUM_VEC_BLOCK)
+            n = CNE_CKSUM_VEC_BLOCK;
+        len -= n * CNE_CKSUM_VEC_SIZE;
+
+#if defined(__AVX512F__)
+        const __m512i mask = _mm512_set1_epi32(0xffff);
+        __m512i acc        = _mm512_setzero_si512();
+
+        for (; n; n--, p += CNE_CKSUM_VEC_SIZE) {
+            __m512i v = _mm512_loadu_si512((const void *)p);
+
+            acc = _mm512_add_epi32(acc, _mm512_and_si512(v, mask));
+            acc = _mm512_add_epi32(acc, _mm512_srli_epi32(v, 16));
+        }
+        acc = _mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(acc)),
+                               _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(acc, 1)));
+        sum64 += (uint64_t)_mm512_reduce_add_epi64(acc);
+#else
+        const __m256i mask = _mm256_set1_epi32(0xffff);
+        __m256i acc        = _mm256_setzero_si256();
+
+        for (; n; n--, p += CNE_CKSUM_VEC_SIZE) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)p);
+
+            acc = _mm256_add_epi32(acc, _mm256_and_si256(v, mask));
+            acc = _mm256_add_epi32(acc, _mm256_srli_epi32(v, 16));
+        }
+        acc = _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(acc)),
+                               _mm256_cvtepu32_epi64(_mm256_extracti128_si256(acc, 1)));
+        sum64 += (uint64_t)_mm256_extract_epi64(acc, 0) + (uint64_t)_mm256_extract_epi64(acc, 1) +
+                 (uint64_t)_mm256_extract_epi64(acc, 2) + (uint64_t)_mm256_extract_epi64(acc, 3);
+#endif
+    }
+
+    /* 2^32 is 1 in one's complement arithmetic, fold the carries back into 32 bits */
+    sum64 = (sum64 & 0xffffffff) + (sum64 >> 32);
+    sum64 = (sum64 & 0xffffffff) + (sum64 >> 32);
+
+    return (uint32_t)sum64;
+}
+#endif /* CNE_CKSUM_VEC_SIZE */
+
 /**
  * @internal Calculate a sum of all words in the buffer.
  * Helper routine for the cne_raw_cksum().
@@ -135,6 +217,17 @@ __cne_raw_cksum(const void *buf, size_t len, uint32_t sum)
     typedef uint16_t __attribute__((__may_alias__)) u16_p;
     const u16_p *u16_buf = (const u16_p *)ptr;
 
+#ifdef CNE_CKSUM_VEC_SIZE
+    /* Sum the bulk of a large buffer with SIMD, the IPv4 and pseudo headers stay scalar */
+    if (len >= CNE_CKSUM_VEC_SIZE) {
+        size_t vlen = len & ~((size_t)CNE_CKSUM_VEC_SIZE - 1);
+
+        sum = __cne_raw_cksum_vec(buf, vlen, sum);
+        u16_buf += vlen / sizeof(*u16_buf);
+        len -= vlen;
+    }
+#endif
+
     while (len >= (sizeof(*u16_buf) * 4)) {
         sum += u16_buf[0];
         sum += u16_buf[1];
@@ -231,6 +324,73 @@ cne_ipv4_cksum(const struct cne_ipv4_hdr *ipv4_hdr)
     return (uint16_t)~cksum;
 }
 
+/**
+ * Process the IPv4 checksum of a burst of IPv4 headers.
+ *
+ * Each result is the value cne_ipv4_cksum() returns for the header. With a zero checksum
+ * field it is the checksum to set in the header, with the received checksum it is 0 when
+ * the header is valid. With AVX2 the headers without options are summed four at a time.
+ *
+ * @param ipv4_hdrs
+ *   Array of pointers to the contiguous IPv4 headers.
+ * @param cksums
+ *   Array receiving the complemented checksum of each header.
+ * @param nb_hdrs
+ *   Number of headers in the burst.
+ */
+static inline void
+cne_ipv4_cksum_bulk(struct cne_ipv4_hdr *const ipv4_hdrs[], uint16_t cksums[], uint16_t nb_hdrs)
+{
+    uint16_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i mask  = _mm256_set1_epi32(0xffff);
+    const __m128i mask4 = _mm256_castsi256_si128(mask);
+
+    for (; (i + 4) <= nb_hdrs; i += 4) {
+        struct cne_ipv4_hdr *const *h = &ipv4_hdrs[i];
+        __m256i a, b;
+        __m128i s, t;
+
+        /* A group with IPv4 options is done one header at a time */
+        if (((h[0]->version_ihl ^ CNE_IPV4_MIN_IHL) | (h[1]->version_ihl ^ CNE_IPV4_MIN_IHL) |
+             (h[2]->version_ihl ^ CNE_IPV4_MIN_IHL) | (h[3]->version_ihl ^ CNE_IPV4_MIN_IHL)) &
+            CNE_IPV4_HDR_IHL_MASK) {
+            for (int j = 0; j < 4; j++)
+                cksums[i + j] = cne_ipv4_cksum(h[j]);
+            continue;
+        }
+
+        /* The first 16 bytes of headers 0 and 2 in the low lanes, of 1 and 3 in the high lanes */
+        a = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)h[0])),
+                                    _mm_loadu_si128((const __m128i *)h[1]), 1);
+        b = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)h[2])),
+                                    _mm_loadu_si128((const __m128i *)h[3]), 1);
+        a = _mm256_add_epi32(_mm256_and_si256(a, mask), _mm256_srli_epi32(a, 16));
+        b = _mm256_add_epi32(_mm256_and_si256(b, mask), _mm256_srli_epi32(b, 16));
+
+        /* Add the four lanes of each header, giving the sums of headers 0, 2 and 1, 3 */
+        a = _mm256_hadd_epi32(a, b);
+        a = _mm256_hadd_epi32(a, a);
+        s = _mm_unpacklo_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+
+        /* Add the last 4 bytes of the headers, the destination addresses */
+        t = _mm_set_epi32((int)h[3]->dst_addr, (int)h[2]->dst_addr, (int)h[1]->dst_addr,
+                          (int)h[0]->dst_addr);
+        s = _mm_add_epi32(s, _mm_add_epi32(_mm_and_si128(t, mask4), _mm_srli_epi32(t, 16)));
+
+        /* Reduce to 16 bits and complement */
+        s = _mm_add_epi32(_mm_and_si128(s, mask4), _mm_srli_epi32(s, 16));
+        s = _mm_add_epi32(_mm_and_si128(s, mask4), _mm_srli_epi32(s, 16));
+        s = _mm_xor_si128(s, mask4);
+        _mm_storel_epi64((__m128i *)&cksums[i], _mm_packus_epi32(s, s));
+    }
+#endif
+
+    for (; i < nb_hdrs; i++)
+        cksums[i] = cne_ipv4_cksum(ipv4_hdrs[i]);
+}
+
 /**
  * Process the pseudo-header checksum of an IPv4 header.
  *
@@ -365,6 +525,126 @@ cne_ipv4_udptcp_cksum_verify(const struct cne_ipv4_hdr *ipv4_hdr, const void *l4
     return 0;
 }
 
+/**
+ * Update a one's complement checksum when a 16 bit word of the data it covers changes,
+ * RFC 1624 eqn. 3: HC' = ~(~HC + ~m + m').
+ *
+ * The values are used as found in the packet, the byte order does not matter as long as
+ * the checksum and the words are in the same byte order.
+ *
+ * @param cksum
+ *   The checksum as found in the packet.
+ * @param old_val
+ *   The old value of the word.
+ * @param new_val
+ *   The new value of the word.
+ * @return
+ *   The updated checksum.
+ */
+static inline uint16_t
+cne_cksum_adjust16(uint16_t cksum, uint16_t old_val, uint16_t new_val)
+{
+    uint32_t sum = (uint16_t)~cksum + (uint16_t)~old_val + new_val;
+
+    return (uint16_t)~__cne_raw_cksum_reduce(sum);
+}
+
+/**
+ * Update a one's complement checksum when a 32 bit value of the data it covers changes,
+ * like an IPv4 address, RFC 1624 eqn. 3.
+ *
+ * @param cksum
+ *   The checksum as found in the packet.
+ * @param old_val
+ *   The old value as found in the packet.
+ * @param new_val
+ *   The new value as found in the packet.
+ * @return
+ *   The updated checksum.
+ */
+static inline uint16_t
+cne_cksum_adjust32(uint16_t cksum, uint32_t old_val, uint32_t new_val)
+{
+    uint32_t sum = (uint16_t)~cksum;
+
+    sum += (uint16_t)~old_val + (uint16_t)~(old_val >> 16);
+    sum += (new_val & 0xffff) + (new_val >> 16);
+
+    return (uint16_t)~__cne_raw_cksum_reduce(sum);
+}
+
+/**
+ * Update an IPv4 header checksum for a decrement of the TTL, RFC 1624.
+ *
+ * The TTL is the high byte of a 16 bit word in network order, decrementing it subtracts
+ * 0x0100 from the word, which is adding ~0x0100 in one's complement arithmetic.
+ *
+ * @param cksum
+ *   The IPv4 header checksum as found in the packet.
+ * @return
+ *   The checksum of the header with the TTL decremented.
+ */
+static inline uint16_t
+cne_ipv4_cksum_ttl_dec(uint16_t cksum)
+{
+    uint32_t sum = (uint16_t)~cksum + htobe16(0x0100 ^ 0xffff);
+
+    return (uint16_t)~__cne_raw_cksum_reduce(sum);
+}
+
+/**
+ * Decrement the TTL of a forwarded IPv4 packet and update the header checksum, RFC 1624.
+ * The caller checks the TTL is not already 0 or 1.
+ *
+ * @param ipv4_hdr
+ *   The pointer to the contiguous IPv4 header.
+ */
+static inline void
+cne_ipv4_ttl_dec(struct cne_ipv4_hdr *ipv4_hdr)
+{
+    ipv4_hdr->time_to_live--;
+    ipv4_hdr->hdr_checksum = cne_ipv4_cksum_ttl_dec(ipv4_hdr->hdr_checksum);
+}
+
+/**
+ * Rewrite the source or destination address of an IPv4 packet, as done by NAT, and update
+ * the IPv4 header checksum and the TCP or UDP checksum of the pseudo-header, RFC 1624.
+ *
+ * A UDP checksum of 0 means the datagram has no checksum, it is left as is. A UDP checksum
+ * updated to 0 is sent as 0xffff, as done by cne_ipv4_udptcp_cksum().
+ *
+ * @param ipv4_hdr
+ *   The pointer to the contiguous IPv4 header.
+ * @param l4_cksum
+ *   The pointer to the TCP or UDP checksum of the packet, NULL when it has none.
+ * @param src
+ *   Rewrite the source address when true, else the destination address.
+ * @param addr
+ *   The new address in network byte order.
+ */
+static inline void
+cne_ipv4_addr_rewrite(struct cne_ipv4_hdr *ipv4_hdr, cne_be16_t *l4_cksum, bool src,
+                      cne_be32_t addr)
+{
+    cne_be32_t *field = (src) ? &ipv4_hdr->src_addr : &ipv4_hdr->dst_addr;
+    cne_be32_t old    = *field;
+
+    ipv4_hdr->hdr_checksum = cne_cksum_adjust32(ipv4_hdr->hdr_checksum, old, addr);
+    *field                 = addr;
+
+    if (!l4_cksum)
+        return;
+
+    if (ipv4_hdr->next_proto_id == IPPROTO_UDP) {
+        if (*l4_cksum == 0)
+            return;
+        *l4_cksum = cne_cksum_adjust32(*l4_cksum, old, addr);
+        if (*l4_cksum == 0)
+            *l4_cksum = 0xffff;
+    } else
+        *l4_cksum = cne_cksum_adjust32(*l4_cksum, old, addr);
+}
+
 /**
  * IPv6 Header
  */
@@ -392,6 +392,9 @@ _object_free(jcfg_hdr_t *hdr)
         free(((jcfg_thd_t *)hdr)->group_name);
         free(((jcfg_thd_t *)hdr)->lport_names);
         free(((jcfg_thd_t *)hdr)->lports);
+        for (int i = 0; i < ((jcfg_thd_t *)hdr)->node_cnt; i++)
+            free(((jcfg_thd_t *)hdr)->node_names[i]);
+        free(((jcfg_thd_t *)hdr)->node_names);
         break;
     case JCFG_USER_TYPE:
         break;
@@ -211,6 +211,8 @@ typedef struct jcfg_thd {
     uint16_t idx;              /**< Thread index value */
     char **lport_names;        /**< List of lport names */
     jcfg_lport_t **lports;     /**< The lports attached to this configuration */
+    uint16_t node_cnt;         /**< Number of graph nodes run by the thread */
+    char **node_names;         /**< List of graph node names */
     int tid;                   /**< System Thread id value */
     volatile uint16_t quit;    /**< Set to non-zero to force thread to quit */
     volatile uint16_t pause;   /**< Set to non-zero to pause thread */
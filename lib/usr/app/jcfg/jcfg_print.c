@@ -113,6 +113,12 @@ __print_thread(jcfg_hdr_t *hdr, obj_value_t *val __cne_unused)
     for (int i = 0; i < thd->lport_cnt; i++)
         cne_printf("'[magenta]%s[]' ", thd->lport_names[i]);
 
+    if (thd->node_cnt) {
+        cne_printf("] [green]nodes[]: [ ");
+        for (int i = 0; i < thd->node_cnt; i++)
+            cne_printf("'[magenta]%s[]' ", thd->node_names[i]);
+    }
+
     cne_printf("] ([yellow]%s[])\n", thd->desc);
 }
 
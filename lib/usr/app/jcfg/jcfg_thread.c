@@ -83,6 +83,23 @@ _thd(struct json_object *obj, int flags, struct json_object *parent __cne_unused
                 thd->lport_names[thd->lport_cnt++] = strdup(json_object_get_string(val));
             }
             thd->lports = calloc(thd->lport_sz, sizeof(void *));
+        } else if (!strcasecmp(key, "nodes")) {
+            int arrlen = json_object_array_length(obj);
+            char **names;
+
+            names = realloc(thd->node_names, (thd->node_cnt + arrlen) * sizeof(char *));
+            if (!names)
+                CNE_ERR_RET_VAL(JSON_C_VISIT_RETURN_ERROR, "Unable to allocate node names\n");
+            thd->node_names = names;
+
+            for (int i = 0; i < arrlen; i++) {
+                struct json_object *val = json_object_array_get_idx(obj, i);
+
+                if (!json_object_is_type(val, json_type_string))
+                    CNE_ERR_RET_VAL(JSON_C_VISIT_RETURN_ERROR, "Node name of %s is invalid\n",
+                                    thd->name);
+                thd->node_names[thd->node_cnt++] = strdup(json_object_get_string(val));
+            }
         }
     } else
         ret = JSON_C_VISIT_RETURN_ERROR;
@@ -136,6 +153,11 @@ _thd_obj(struct json_object *obj, int flags, struct json_object *parent __cne_un
                                thd->name, thd->group_name, thd->lport_cnt);
                     for (int i = 0; i < thd->lport_cnt; i++)
                         cne_printf("'[magenta]%s[]' ", thd->lport_names[i]);
+                    if (thd->node_cnt) {
+                        cne_printf("], [green]nodes[] [ ");
+                        for (int i = 0; i < thd->node_cnt; i++)
+                            cne_printf("'[magenta]%s[]' ", thd->node_names[i]);
+                    }
                     cne_printf("], [green]desc[]:'[yellow]%s[]'\n", thd->desc);
                 }
             } else
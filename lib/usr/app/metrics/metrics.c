@@ -2,9 +2,11 @@
  * Copyright (c) 2020-2023 Intel Corporation
  */
 
-#include <stdio.h>        // for NULL
-#include <errno.h>        // for ENODEV, errno
+#include <stdio.h>           // for NULL
+#include <errno.h>           // for ENODEV, errno
+#include <inttypes.h>        // for PRIu64
 #include <pthread.h>
+#include <stdlib.h>          // for calloc, free
 
 #include <cne_mutex_helper.h>
 #include "metrics.h"
@@ -142,6 +144,78 @@ metrics_port_stats(metrics_client_t *c, char *name, lport_stats_t *s)
     return 0;
 }
 
+static void
+metrics_hist(metrics_client_t *c, const char *name, const char *hist, const uint64_t *v, int cnt)
+{
+    metrics_append(c, ",\"%s_%s\":[", name, hist);
+    for (int i = 0; i < cnt; i++)
+        metrics_append(c, "%s%" PRIu64, i ? "," : "", v[i]);
+    metrics_append(c, "]");
+}
+
+int
+metrics_graph_stats(metrics_client_t *c, struct cne_graph_cluster_stats *stats)
+{
+    const struct cne_graph_cluster_node_stats *s;
+    int cnt;
+
+    if (!c || !stats)
+        return -1;
+
+    cne_graph_cluster_stats_get(stats, true);
+
+    cnt = cne_graph_stats_node_count(stats);
+    for (int i = 0; i < cnt; i++) {
+        s = cne_graph_stats_node_get(stats, i);
+
+        metrics_append(c, "%s\"%s_calls\":%" PRIu64, i ? "," : "", s->name, s->calls);
+        metrics_append(c, ",\"%s_objs\":%" PRIu64, s->name, s->objs);
+        metrics_append(c, ",\"%s_realloc_count\":%" PRIu64, s->name, s->realloc_count);
+        metrics_append(c, ",\"%s_cycles\":%" PRIu64, s->name, s->cycles);
+        metrics_append(c, ",\"%s_sampled_calls\":%" PRIu64, s->name, s->sampled_calls);
+        metrics_append(c, ",\"%s_sampled_objs\":%" PRIu64, s->name, s->sampled_objs);
+        metrics_append(c, ",\"%s_cpo_p50\":%" PRIu64, s->name,
+                       cne_graph_stats_cpo_percentile(s, 50));
+        metrics_append(c, ",\"%s_cpo_p99\":%" PRIu64, s->name,
+                       cne_graph_stats_cpo_percentile(s, 99));
+        metrics_hist(c, s->name, "cpo_hist", s->cpo_hist, CNE_GRAPH_STATS_CPO_BUCKETS);
+        metrics_hist(c, s->name, "burst_hist", s->burst_hist, CNE_GRAPH_STATS_BURST_BUCKETS);
+    }
+
+    return 0;
+}
+
+int
+metrics_graph_trace(metrics_client_t *c, cne_graph_t id)
+{
+    struct cne_graph_trace_rec *recs;
+    const char *name;
+    int n;
+
+    if (!c || !(name = cne_graph_id_to_name(id)))
+        return -1;
+
+    recs = calloc(CNE_GRAPH_TRACE_RECS, sizeof(*recs));
+    if (!recs)
+        return -1;
+
+    n = cne_graph_trace_get(id, recs, CNE_GRAPH_TRACE_RECS);
+    if (n < 0) {
+        free(recs);
+        return -1;
+    }
+
+    metrics_append(c, "\"%s_trace\":[", name);
+    for (int i = 0; i < n; i++)
+        metrics_append(c, "%s{\"pkt\":%u,\"node\":\"%s\",\"edge\":%d,\"tsc\":%" PRIu64 "}",
+                       i ? "," : "", recs[i].pkt, cne_node_id_to_name(recs[i].node),
+                       recs[i].edge == CNE_EDGE_ID_INVALID ? -1 : recs[i].edge, recs[i].tsc);
+    metrics_append(c, "]");
+    free(recs);
+
+    return 0;
+}
+
 CNE_INIT_PRIO(metrics_constructor, INIT)
 {
     if (cne_mutex_create(&metrics_mutex, PTHREAD_MUTEX_RECURSIVE) < 0)
@@ -15,6 +15,7 @@
 
 #include <cne_common.h>        // for CNDP_API
 #include <cne_lport.h>
+#include <cne_graph.h>        // for cne_graph_cluster_stats
 #include <uds.h>        // for uds_client_t, uds_info_t
 
 #ifdef __cplusplus
@@ -110,6 +111,38 @@ CNDP_API const char *metrics_params(metrics_client_t *client);
  */
 CNDP_API int metrics_port_stats(metrics_client_t *c, char *name, lport_stats_t *s);
 
+/**
+ * Add the node statistics of a graph cluster to the metrics buffer
+ *
+ * The stats are aggregated with cne_graph_cluster_stats_get(), each value is
+ * prefixed by the node name and the cycles per object and burst size
+ * histograms of the sampled calls are added as arrays.
+ *
+ * @param c
+ *   The metric_client_t structure pointer
+ * @param stats
+ *   The graph cluster stats returned by cne_graph_cluster_stats_create()
+ * @return
+ *   -1 on error, 0 on success
+ */
+CNDP_API int metrics_graph_stats(metrics_client_t *c, struct cne_graph_cluster_stats *stats);
+
+/**
+ * Add the trace ring of a graph to the metrics buffer
+ *
+ * The hops recorded by cne_graph_trace_enable() are added, oldest first, as an
+ * array of objects with the packet trace id, the node name, the edge taken by
+ * the packet to get to the node (-1 for a source node) and the TSC.
+ *
+ * @param c
+ *   The metric_client_t structure pointer
+ * @param id
+ *   The graph id
+ * @return
+ *   -1 on error, 0 on success
+ */
+CNDP_API int metrics_graph_trace(metrics_client_t *c, cne_graph_t id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -185,11 +185,17 @@ struct cne_acl_ctx {
     void *mem;
     size_t mem_sz;
     struct cne_acl_config config; /* copy of build config. */
+    uint64_t build_cycles;        /* duration of the last build. */
+    size_t build_mem_sz;          /* temporary memory used by the last build. */
 };
 
+struct acl_wrk_pool;
+
 int cne_acl_gen(struct cne_acl_ctx *ctx, struct cne_acl_trie *trie,
                 struct cne_acl_bld_trie *node_bld_trie, uint32_t num_tries, uint32_t num_categories,
-                uint32_t data_index_sz, size_t max_size);
+                uint32_t data_index_sz, size_t max_size, struct acl_wrk_pool *wp);
+
+int acl_check_rule(const struct cne_acl_rule_data *rd);
 
 typedef int (*cne_acl_classify_t)(const struct cne_acl_ctx *, const uint8_t **, uint32_t *,
                                   uint32_t, uint32_t);
@@ -7,14 +7,16 @@
 #include <setjmp.h>        // for sigsetjmp
 #include <stddef.h>        // for offsetof
 #include <stdint.h>        // for uint32_t, uint8_t, int32_t, UINT8_MAX, uint64_t
-#include <stdlib.h>        // for free
+#include <stdlib.h>        // for free, calloc
 #include <string.h>        // for NULL, memset, memcpy, size_t, memmove
 
 #include <cne_acl.h>        // for cne_acl_config, cne_acl_field_def, cne_acl_f...
 
 #include "tb_mem.h"            // for tb_alloc, tb_mem_pool, tb_free_pool
 #include "acl.h"               // for cne_acl_node, cne_acl_ptr_set, cne_acl_trie
+#include "acl_wrk.h"           // for acl_wrk_create, acl_wrk_submit, acl_wrk_wait
 #include "cne_common.h"        // for CNE_DIM, CNE_LEN2MASK, typeof
+#include "cne_cycles.h"        // for cne_rdtsc
 #include "cne_log.h"           // for CNE_LOG, CNE_LOG_ERR, CNE_LOG_DEBUG
 
 #define ACL_POOL_ALIGN     8
@@ -94,6 +96,18 @@ struct acl_build_context {
     /* memory free lists for nodes and blocks used for node ptrs */
     struct acl_mem_block blocks[MEM_BLOCK_NUM];
     struct cne_acl_node *node_free_list;
+
+    /* workers rebuilding the tries after a split, NULL to build them in place */
+    struct acl_wrk_pool *wrk;
+    struct acl_build_job *jobs[CNE_ACL_MAX_TRIES];
+};
+
+/* Rebuild of a trie after a split, with its own build context and memory */
+struct acl_build_job {
+    struct acl_build_context ctx;
+    struct cne_acl_build_rule *rules;
+    uint32_t n;
+    int32_t rc;
 };
 
 static int acl_merge_trie(struct acl_build_context *context, struct cne_acl_node *node_a,
@@ -1262,6 +1276,123 @@ build_one_trie(struct acl_build_context *context,
     return last;
 }
 
+static void
+acl_build_job_run(void *arg)
+{
+    struct cne_acl_build_rule *rule_sets[CNE_ACL_MAX_TRIES] = {NULL};
+    struct acl_build_job *job         = arg;
+    struct acl_build_context *context = &job->ctx;
+    struct cne_acl_build_rule *rule;
+    struct cne_acl_config *config;
+
+    job->rc = sigsetjmp(context->pool.fail, 0);
+    if (job->rc != 0)
+        return;
+
+    /* The rules of the set are only used by this job, give them a private config */
+    config = acl_build_alloc(context, 1, sizeof(*config));
+    memcpy(config, job->rules->config, sizeof(*config));
+    for (rule = job->rules; rule != NULL; rule = rule->next)
+        rule->config = config;
+
+    rule_sets[job->n] = job->rules;
+    if (build_one_trie(context, rule_sets, job->n, INT32_MAX) != NULL ||
+        context->bld_tries[job->n].trie == NULL)
+        job->rc = -ENOMEM;
+}
+
+/*
+ * Queue the rebuild of a trie to the workers, the next trie is built by the
+ * caller at the same time.
+ */
+static int
+acl_build_job_submit(struct acl_build_context *context, struct cne_acl_build_rule *rules,
+                     uint32_t n)
+{
+    struct acl_build_job *job;
+
+    job = calloc(1, sizeof(*job));
+    if (job == NULL)
+        return -ENOMEM;
+
+    job->ctx.acx            = context->acx;
+    job->ctx.cfg            = context->cfg;
+    job->ctx.node_max       = context->node_max;
+    job->ctx.category_mask  = context->category_mask;
+    job->ctx.pool.alignment = ACL_POOL_ALIGN;
+    job->ctx.pool.min_alloc = ACL_POOL_ALLOC_MIN;
+    job->rules              = rules;
+    job->n                  = n;
+
+    context->jobs[n] = job;
+    acl_wrk_submit(context->wrk, acl_build_job_run, job);
+
+    return 0;
+}
+
+/*
+ * Wait for the workers and move the rebuilt tries into the build context,
+ * in the trie order.
+ */
+static int
+acl_build_jobs_finish(struct acl_build_context *context)
+{
+    struct acl_build_job *job;
+    uint32_t n;
+    int32_t rc = 0;
+
+    acl_wrk_wait(context->wrk);
+
+    for (n = 0; n < CNE_DIM(context->jobs); n++) {
+        job = context->jobs[n];
+        if (job == NULL)
+            continue;
+        if (job->rc != 0) {
+            CNE_ERR("Build of %u-th trie failed\n", n);
+            rc = job->rc;
+            continue;
+        }
+
+        context->tries[n] = job->ctx.tries[n];
+        memcpy(context->data_indexes[n], job->ctx.data_indexes[n],
+               sizeof(context->data_indexes[n]));
+        context->tries[n].data_index = context->data_indexes[n];
+        context->bld_tries[n]        = job->ctx.bld_tries[n];
+        context->num_nodes += job->ctx.num_nodes;
+    }
+
+    return rc;
+}
+
+/* Free the memory of the jobs, the tries they built are not used anymore */
+static void
+acl_build_jobs_free(struct acl_build_context *context)
+{
+    uint32_t n;
+
+    acl_wrk_wait(context->wrk);
+
+    for (n = 0; n < CNE_DIM(context->jobs); n++) {
+        if (context->jobs[n] != NULL) {
+            tb_free_pool(&context->jobs[n]->ctx.pool);
+            free(context->jobs[n]);
+            context->jobs[n] = NULL;
+        }
+    }
+}
+
+static size_t
+acl_build_mem(const struct acl_build_context *context)
+{
+    size_t sz = context->pool.alloc;
+
+    for (uint32_t n = 0; n < CNE_DIM(context->jobs); n++)
+        if (context->jobs[n] != NULL)
+            sz += context->jobs[n]->ctx.pool.alloc;
+
+    return sz;
+}
+
 static int
 acl_build_tries(struct acl_build_context *context, struct cne_acl_build_rule *head)
 {
@@ -1317,13 +1448,19 @@ acl_build_tries(struct acl_build_context *context, struct cne_acl_build_rule *he
          * Rebuild the trie for the reduced rule-set.
          * Don't try to split it any further.
          */
+        if (context->wrk != NULL) {
+            if (acl_build_job_submit(context, rule_sets[n], n) != 0)
+                CNE_ERR_RET_VAL(-ENOMEM, "Build of %u-th trie failed\n", n);
+            continue;
+        }
+
         last = build_one_trie(context, rule_sets, n, INT32_MAX);
         if (context->bld_tries[n].trie == NULL || last != NULL)
             CNE_ERR_RET_VAL(-ENOMEM, "Build of %u-th trie failed\n", n);
     }
 
     context->num_tries = num_tries;
-    return 0;
+    return acl_build_jobs_finish(context);
 }
 
 static void
@@ -1336,7 +1473,7 @@ acl_build_log(const struct acl_build_context *ctx)
             "node limit for tree split: %u\n"
             "nodes created: %u\n"
             "memory consumed: %zu\n",
-            ctx->acx->name, ctx->node_max, ctx->num_nodes, ctx->pool.alloc);
+            ctx->acx->name, ctx->node_max, ctx->num_nodes, acl_build_mem(ctx));
 
     for (n = 0; n < CNE_DIM(ctx->tries); n++) {
         if (ctx->tries[n].count != 0)
@@ -1409,7 +1546,7 @@ acl_set_data_indexes(struct cne_acl_ctx *ctx)
  */
 static int
 acl_bld(struct acl_build_context *bcx, struct cne_acl_ctx *ctx, const struct cne_acl_config *cfg,
-        uint32_t node_max)
+        uint32_t node_max, struct acl_wrk_pool *wrk)
 {
     int32_t rc;
 
@@ -1421,6 +1558,7 @@ acl_bld(struct acl_build_context *bcx, struct cne_acl_ctx *ctx, const struct cne
     bcx->cfg            = *cfg;
     bcx->category_mask  = CNE_LEN2MASK(bcx->cfg.num_categories, typeof(bcx->category_mask));
     bcx->node_max       = node_max;
+    bcx->wrk            = wrk;
 
     rc = sigsetjmp(bcx->pool.fail, 0);
 
@@ -1484,15 +1622,22 @@ cne_acl_build(struct cne_acl_ctx *ctx, const struct cne_acl_config *cfg)
 {
     int32_t rc;
     uint32_t n;
-    size_t max_size;
+    size_t max_size, mem_sz = 0;
+    uint64_t start;
     struct acl_build_context bcx;
+    struct acl_wrk_pool *wrk;
 
     rc = acl_check_bld_param(ctx, cfg);
     if (rc != 0)
         return rc;
 
+    start = cne_rdtsc();
+
     acl_build_reset(ctx);
 
+    /* Without workers the tries are built on the calling thread */
+    wrk = acl_wrk_create(cfg->num_workers);
+
     if (cfg->max_size == 0) {
         n        = NODE_MIN;
         max_size = SIZE_MAX;
@@ -1504,13 +1649,13 @@ cne_acl_build(struct cne_acl_ctx *ctx, const struct cne_acl_config *cfg)
     for (rc = -ERANGE; n >= NODE_MIN && rc == -ERANGE; n /= 2) {
 
         /* perform build phase. */
-        rc = acl_bld(&bcx, ctx, cfg, n);
+        rc = acl_bld(&bcx, ctx, cfg, n, wrk);
 
         if (rc == 0) {
             /* allocate and fill run-time  structures. */
             rc = cne_acl_gen(ctx, bcx.tries, bcx.bld_tries, bcx.num_tries, bcx.cfg.num_categories,
                              CNE_ACL_MAX_FIELDS * CNE_DIM(bcx.tries) * sizeof(ctx->data_indexes[0]),
-                             max_size);
+                             max_size, wrk);
             if (rc == 0) {
                 /* set data indexes. */
                 acl_set_data_indexes(ctx);
@@ -1521,10 +1666,19 @@ cne_acl_build(struct cne_acl_ctx *ctx, const struct cne_acl_config *cfg)
         }
 
         acl_build_log(&bcx);
+        mem_sz = CNE_MAX(mem_sz, acl_build_mem(&bcx));
 
         /* cleanup after build. */
+        acl_build_jobs_free(&bcx);
         tb_free_pool(&bcx.pool);
     }
 
+    acl_wrk_free(wrk);
+
+    if (rc == 0) {
+        ctx->build_cycles = cne_rdtsc() - start;
+        ctx->build_mem_sz = mem_sz;
+    }
+
     return rc;
 }
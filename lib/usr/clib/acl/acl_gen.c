@@ -10,6 +10,7 @@
 
 #include "cne_acl.h"           // IWYU pragma: keep
 #include "acl.h"               // for cne_acl_node, cne_acl_ptr_set, cne_acl_ctx
+#include "acl_wrk.h"           // for acl_wrk_submit, acl_wrk_wait
 #include "cne_common.h"        // for CNE_DIM, CNE_ALIGN, CNE_CACHE_LINE_SIZE
 #include "cne_log.h"           // for CNE_LOG, CNE_LOG_DEBUG, CNE_LOG_ERR
 #include "cne_vect.h"          // for XMM_SIZE
@@ -40,6 +41,16 @@ struct cne_acl_indices {
     int32_t match_start;
 };
 
+/* A trie counted and generated on its own, possibly by a build worker */
+struct acl_gen_trie {
+    struct cne_acl_node *root;
+    uint64_t *node_array;
+    uint64_t no_match;
+    int num_categories;
+    struct acl_node_counters counts;
+    struct cne_acl_indices indices;
+};
+
 static void
 acl_gen_log_stats(const struct cne_acl_ctx *ctx, const struct acl_node_counters *counts,
                   const struct cne_acl_indices *indices, size_t max_size)
@@ -397,10 +408,30 @@ acl_gen_node(struct cne_acl_node *node, uint64_t *node_array, uint64_t no_match,
     }
 }
 
+static void
+acl_count_trie(void *arg)
+{
+    struct acl_gen_trie *gt = arg;
+
+    acl_count_trie_types(&gt->counts, gt->root, gt->no_match, 1);
+}
+
+static void
+acl_gen_trie(void *arg)
+{
+    struct acl_gen_trie *gt = arg;
+
+    acl_gen_node(gt->root, gt->node_array, gt->no_match, &gt->indices, gt->num_categories);
+}
+
+/*
+ * Count the nodes of each trie and give each trie its own range of indices
+ * for each node type. The ranges follow the trie order so the layout is the
+ * same as generating the tries one after the other.
+ */
 static void
 acl_calc_counts_indices(struct acl_node_counters *counts, struct cne_acl_indices *indices,
-                        struct cne_acl_bld_trie *node_bld_trie, uint32_t num_tries,
-                        uint64_t no_match)
+                        struct acl_gen_trie *gt, uint32_t num_tries, struct acl_wrk_pool *wp)
 {
     uint32_t n;
 
@@ -408,8 +439,17 @@ acl_calc_counts_indices(struct acl_node_counters *counts, struct cne_acl_indices
     memset(counts, 0, sizeof(*counts));
 
     /* Get stats on nodes */
+    for (n = 0; n < num_tries; n++)
+        acl_wrk_submit(wp, acl_count_trie, &gt[n]);
+    acl_wrk_wait(wp);
+
     for (n = 0; n < num_tries; n++) {
-        acl_count_trie_types(counts, node_bld_trie[n].trie, no_match, 1);
+        counts->match += gt[n].counts.match;
+        counts->single += gt[n].counts.single;
+        counts->quad += gt[n].counts.quad;
+        counts->quad_vectors += gt[n].counts.quad_vectors;
+        counts->dfa += gt[n].counts.dfa;
+        counts->dfa_gr64 += gt[n].counts.dfa_gr64;
     }
 
     indices->dfa_index    = CNE_ACL_DFA_SIZE + 1;
@@ -418,6 +458,15 @@ acl_calc_counts_indices(struct acl_node_counters *counts, struct cne_acl_indices
     indices->match_start  = indices->single_index + counts->single + 1;
     indices->match_start  = CNE_ALIGN(indices->match_start, (XMM_SIZE / sizeof(uint64_t)));
     indices->match_index  = 1;
+
+    for (n = 0; n < num_tries; n++) {
+        gt[n].indices = *indices;
+
+        indices->dfa_index += gt[n].counts.dfa_gr64 * CNE_ACL_DFA_GR64_SIZE;
+        indices->quad_index += gt[n].counts.quad_vectors;
+        indices->single_index += gt[n].counts.single;
+        indices->match_index += gt[n].counts.match;
+    }
 }
 
 /*
@@ -426,7 +475,7 @@ acl_calc_counts_indices(struct acl_node_counters *counts, struct cne_acl_indices
 int
 cne_acl_gen(struct cne_acl_ctx *ctx, struct cne_acl_trie *trie,
             struct cne_acl_bld_trie *node_bld_trie, uint32_t num_tries, uint32_t num_categories,
-            uint32_t data_index_sz, size_t max_size)
+            uint32_t data_index_sz, size_t max_size, struct acl_wrk_pool *wp)
 {
     void *mem;
     size_t total_size;
@@ -435,11 +484,19 @@ cne_acl_gen(struct cne_acl_ctx *ctx, struct cne_acl_trie *trie,
     struct cne_acl_match_results *match;
     struct acl_node_counters counts;
     struct cne_acl_indices indices;
+    struct acl_gen_trie gt[CNE_ACL_MAX_TRIES];
 
     no_match = CNE_ACL_NODE_MATCH;
 
+    memset(gt, 0, sizeof(gt));
+    for (n = 0; n < num_tries; n++) {
+        gt[n].root           = node_bld_trie[n].trie;
+        gt[n].no_match       = no_match;
+        gt[n].num_categories = num_categories;
+    }
+
     /* Fill counts and indices arrays from the nodes. */
-    acl_calc_counts_indices(&counts, &indices, node_bld_trie, num_tries, no_match);
+    acl_calc_counts_indices(&counts, &indices, gt, num_tries, wp);
 
     /* Allocate runtime memory (align to cache boundary) */
     total_size = CNE_ALIGN(data_index_sz, CNE_CACHE_LINE_SIZE) +
@@ -477,9 +534,12 @@ cne_acl_gen(struct cne_acl_ctx *ctx, struct cne_acl_trie *trie,
     memset(match, 0, sizeof(*match));
 
     for (n = 0; n < num_tries; n++) {
+        gt[n].node_array = node_array;
+        acl_wrk_submit(wp, acl_gen_trie, &gt[n]);
+    }
+    acl_wrk_wait(wp);
 
-        acl_gen_node(node_bld_trie[n].trie, node_array, no_match, &indices, num_categories);
-
+    for (n = 0; n < num_tries; n++) {
         if (node_bld_trie[n].trie->node_index == no_match)
             trie[n].root_index = 0;
         else
@@ -0,0 +1,651 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <bsd/string.h>          // for strlcpy
+#include <errno.h>               // for EINVAL, ENOMEM, EEXIST, ENOENT
+#include <pthread.h>             // for pthread_mutex_lock, pthread_cond_wait
+#include <stdbool.h>             // for bool, true, false
+#include <stdio.h>               // for snprintf
+#include <stdlib.h>              // for calloc, free, qsort, bsearch
+#include <string.h>              // for memcpy, memset
+#include <cne_rcu_qsbr.h>        // for cne_rcu_qsbr_synchronize
+#include <cne_hash.h>            // for cne_hash_create, cne_hash_lookup_data
+#include <cne_jhash.h>           // for cne_jhash
+
+#include "cne_acl.h"
+#include "acl.h"            // for cne_acl_ctx, acl_check_rule
+#include "cne_log.h"        // for CNE_ERR, CNE_NULL_RET
+
+/* Number of inputs searched at once in the overlay context */
+#define ACL_UPD_BURST 64
+
+/* Priority of a rule, the arrays are sorted by userdata */
+struct acl_upd_prio {
+    uint32_t userdata;
+    int32_t priority;
+};
+
+/* Context built from all the rules, shared by the generations until replaced */
+struct acl_upd_main {
+    struct cne_acl_ctx *ctx; /* NULL when there is no rule */
+    struct acl_upd_prio *prio;
+    uint32_t num;
+};
+
+/* Contexts seen by the classify threads */
+struct acl_upd_gen {
+    struct acl_upd_main *main;
+    struct cne_acl_ctx *overlay; /* NULL when the overlay is empty */
+    struct acl_upd_prio *ov_prio;
+    uint32_t num_ov;
+    bool free_main; /* The main context was replaced when the generation retired */
+    struct acl_upd_gen *next;
+};
+
+/* State of a rule in the rule list */
+struct acl_upd_ent {
+    uint64_t seq; /* Update which added the rule */
+    bool overlay; /* Rule built in the overlay context */
+};
+
+struct cne_acl_upd {
+    struct acl_upd_gen *gen; /* Published generation */
+    char name[CNE_ACL_NAMESIZE];
+    struct cne_acl_config cfg;
+    struct cne_rcu_qsbr *v;
+    void *rules;
+    struct acl_upd_ent *ents;
+    struct cne_hash *idx; /* Index of the rules by userdata */
+    uint32_t rule_sz;
+    uint32_t max_rules;
+    uint32_t num_rules;
+    uint32_t max_overlay;
+    uint32_t num_overlay;
+    uint64_t seq;     /* Sequence number of the last update */
+    bool dirty;       /* Rules changed since the last build started */
+    bool building;    /* Build in progress */
+    bool stop;        /* Builder thread must exit */
+    int build_err;    /* Error of the last build */
+    struct acl_upd_gen *retired; /* Generations waiting for the readers */
+    pthread_mutex_t lock;
+    pthread_cond_t cond; /* Wakes up the builder */
+    pthread_cond_t done; /* Signaled when a build is over */
+    pthread_t builder;
+};
+
+static inline struct cne_acl_rule *
+acl_upd_rule(struct cne_acl_upd *upd, uint32_t idx)
+{
+    return (struct cne_acl_rule *)((uint8_t *)upd->rules + (size_t)idx * upd->rule_sz);
+}
+
+static int
+acl_upd_prio_cmp(const void *a, const void *b)
+{
+    const struct acl_upd_prio *pa = a, *pb = b;
+
+    return (pa->userdata > pb->userdata) - (pa->userdata < pb->userdata);
+}
+
+static inline int32_t
+acl_upd_prio_find(const struct acl_upd_prio *prio, uint32_t num, uint32_t userdata)
+{
+    uint32_t lo = 0, hi = num, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (prio[mid].userdata == userdata)
+            return prio[mid].priority;
+        if (prio[mid].userdata < userdata)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return CNE_ACL_MIN_PRIORITY - 1;
+}
+
+static int
+acl_upd_find(struct cne_acl_upd *upd, uint32_t userdata)
+{
+    void *data;
+
+    if (cne_hash_lookup_data(upd->idx, &userdata, &data) < 0)
+        return -ENOENT;
+    return (int)(uintptr_t)data;
+}
+
+/* Index the rule at idx by its userdata, an indexed userdata gets the new index */
+static inline int
+acl_upd_index(struct cne_acl_upd *upd, uint32_t idx)
+{
+    return cne_hash_add_key_data(upd->idx, &acl_upd_rule(upd, idx)->data.userdata,
+                                 (void *)(uintptr_t)idx);
+}
+
+/* Remove the rules from first to the end of the list, called with the lock held */
+static void
+acl_upd_drop(struct cne_acl_upd *upd, uint32_t first)
+{
+    for (uint32_t i = first; i < upd->num_rules; i++) {
+        cne_hash_del_key(upd->idx, &acl_upd_rule(upd, i)->data.userdata);
+        if (upd->ents[i].overlay)
+            upd->num_overlay--;
+    }
+    upd->num_rules = first;
+}
+
+static int
+acl_upd_u32_cmp(const void *a, const void *b)
+{
+    uint32_t ua = *(const uint32_t *)a, ub = *(const uint32_t *)b;
+
+    return (ua > ub) - (ua < ub);
+}
+
+static struct cne_acl_ctx *
+acl_upd_ctx_create(struct cne_acl_upd *upd, const char *sfx, uint32_t num)
+{
+    char name[CNE_ACL_NAMESIZE];
+    struct cne_acl_param prm = {
+        .name         = name,
+        .rule_size    = upd->rule_sz,
+        .max_rule_num = num,
+    };
+
+    snprintf(name, sizeof(name), "%s_%s", upd->name, sfx);
+
+    return cne_acl_create(&prm);
+}
+
+static void
+acl_upd_main_free(struct acl_upd_main *main)
+{
+    if (main) {
+        cne_acl_free(main->ctx);
+        free(main->prio);
+        free(main);
+    }
+}
+
+static void
+acl_upd_gen_free(struct acl_upd_gen *gen)
+{
+    if (gen) {
+        if (gen->free_main)
+            acl_upd_main_free(gen->main);
+        cne_acl_free(gen->overlay);
+        free(gen->ov_prio);
+        free(gen);
+    }
+}
+
+/*
+ * Publish a generation with the main context and an overlay built from the
+ * overlay rules added after min_seq. Called with the lock held.
+ */
+static int
+acl_upd_publish(struct cne_acl_upd *upd, struct acl_upd_main *main, uint64_t min_seq)
+{
+    struct acl_upd_gen *gen, *old = upd->gen;
+    struct acl_upd_ent *ent;
+    uint32_t i, n = 0;
+    int rc = -ENOMEM;
+
+    gen = calloc(1, sizeof(struct acl_upd_gen));
+    if (!gen)
+        return -ENOMEM;
+    gen->main = main;
+
+    for (i = 0; i < upd->num_rules; i++) {
+        ent = &upd->ents[i];
+        if (ent->overlay && ent->seq > min_seq)
+            n++;
+    }
+
+    if (n) {
+        gen->overlay = acl_upd_ctx_create(upd, "ov", n);
+        gen->ov_prio = calloc(n, sizeof(struct acl_upd_prio));
+        if (!gen->overlay || !gen->ov_prio)
+            CNE_ERR_GOTO(err, "Unable to allocate overlay of ACL %s\n", upd->name);
+
+        for (i = 0; i < upd->num_rules; i++) {
+            struct cne_acl_rule *r = acl_upd_rule(upd, i);
+
+            ent = &upd->ents[i];
+            if (!ent->overlay || ent->seq <= min_seq)
+                continue;
+            rc = cne_acl_add_rules(gen->overlay, r, 1);
+            if (rc < 0)
+                CNE_ERR_GOTO(err, "Unable to add rule %u to overlay of ACL %s\n",
+                             r->data.userdata, upd->name);
+            gen->ov_prio[gen->num_ov].userdata   = r->data.userdata;
+            gen->ov_prio[gen->num_ov++].priority = r->data.priority;
+        }
+        qsort(gen->ov_prio, n, sizeof(struct acl_upd_prio), acl_upd_prio_cmp);
+
+        rc = cne_acl_build(gen->overlay, &upd->cfg);
+        if (rc < 0)
+            CNE_ERR_GOTO(err, "Unable to build overlay of ACL %s: %d\n", upd->name, rc);
+    }
+
+    if (old) {
+        old->free_main = (old->main != main);
+        old->next      = upd->retired;
+        upd->retired   = old;
+    }
+    __atomic_store_n(&upd->gen, gen, __ATOMIC_RELEASE);
+
+    return 0;
+err:
+    acl_upd_gen_free(gen);
+    return rc;
+}
+
+/*
+ * Free the retired generations once the classify threads stopped using them,
+ * called by the builder with the lock held.
+ */
+static void
+acl_upd_reclaim(struct cne_acl_upd *upd)
+{
+    struct acl_upd_gen *gen = upd->retired, *next;
+
+    if (!gen)
+        return;
+    upd->retired = NULL;
+
+    pthread_mutex_unlock(&upd->lock);
+
+    cne_rcu_qsbr_synchronize(upd->v, CNE_QSBR_THRID_INVALID);
+    for (; gen; gen = next) {
+        next = gen->next;
+        acl_upd_gen_free(gen);
+    }
+
+    pthread_mutex_lock(&upd->lock);
+}
+
+/* Copy all the rules in a new main context, called with the lock held */
+static struct acl_upd_main *
+acl_upd_main_snapshot(struct cne_acl_upd *upd)
+{
+    struct acl_upd_main *main;
+
+    main = calloc(1, sizeof(struct acl_upd_main));
+    if (!main)
+        return NULL;
+
+    if (upd->num_rules == 0)
+        return main;
+
+    main->ctx  = acl_upd_ctx_create(upd, "main", upd->num_rules);
+    main->prio = calloc(upd->num_rules, sizeof(struct acl_upd_prio));
+    if (!main->ctx || !main->prio || cne_acl_add_rules(main->ctx, upd->rules, upd->num_rules) < 0) {
+        acl_upd_main_free(main);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < upd->num_rules; i++) {
+        main->prio[i].userdata = acl_upd_rule(upd, i)->data.userdata;
+        main->prio[i].priority = acl_upd_rule(upd, i)->data.priority;
+    }
+    main->num = upd->num_rules;
+
+    return main;
+}
+
+static int
+acl_upd_main_build(struct cne_acl_upd *upd, struct acl_upd_main *main)
+{
+    if (!main->ctx)
+        return 0;
+
+    qsort(main->prio, main->num, sizeof(struct acl_upd_prio), acl_upd_prio_cmp);
+
+    return cne_acl_build(main->ctx, &upd->cfg);
+}
+
+static void *
+acl_upd_builder(void *arg)
+{
+    struct cne_acl_upd *upd = arg;
+    struct acl_upd_main *main;
+    uint64_t seq;
+    int rc;
+
+    pthread_mutex_lock(&upd->lock);
+    for (;;) {
+        acl_upd_reclaim(upd);
+        if (upd->stop)
+            break;
+        if (!upd->dirty) {
+            pthread_cond_wait(&upd->cond, &upd->lock);
+            continue;
+        }
+
+        upd->dirty    = false;
+        upd->building = true;
+        seq           = upd->seq;
+        main          = acl_upd_main_snapshot(upd);
+
+        /* Updates continue in the overlay during the build */
+        pthread_mutex_unlock(&upd->lock);
+        rc = main ? acl_upd_main_build(upd, main) : -ENOMEM;
+        pthread_mutex_lock(&upd->lock);
+
+        if (rc == 0)
+            rc = acl_upd_publish(upd, main, seq);
+        if (rc == 0) {
+            /* The rules of the snapshot are in the main context now */
+            for (uint32_t i = 0; i < upd->num_rules; i++) {
+                struct acl_upd_ent *ent = &upd->ents[i];
+
+                if (ent->overlay && ent->seq <= seq) {
+                    ent->overlay = false;
+                    upd->num_overlay--;
+                }
+            }
+        } else {
+            CNE_ERR("Build of ACL %s failed: %d\n", upd->name, rc);
+            acl_upd_main_free(main);
+        }
+
+        upd->build_err = rc;
+        upd->building  = false;
+        pthread_cond_broadcast(&upd->done);
+    }
+    pthread_mutex_unlock(&upd->lock);
+
+    return NULL;
+}
+
+struct cne_acl_upd *
+cne_acl_upd_create(const struct cne_acl_upd_param *param)
+{
+    struct cne_hash_parameters hp = {0};
+    char name[CNE_HASH_NAMESIZE];
+    struct cne_acl_upd *upd;
+    struct acl_upd_main *main;
+
+    if (!param || !param->name || !param->cfg || !param->v || param->rule_size == 0 ||
+        param->max_rule_num == 0)
+        CNE_NULL_RET("Invalid updatable ACL parameters\n");
+
+    upd = calloc(1, sizeof(struct cne_acl_upd));
+    if (!upd)
+        CNE_NULL_RET("Unable to allocate ACL %s\n", param->name);
+
+    strlcpy(upd->name, param->name, sizeof(upd->name));
+    upd->cfg         = *param->cfg;
+    upd->v           = param->v;
+    upd->rule_sz     = param->rule_size;
+    upd->max_rules   = param->max_rule_num;
+    upd->max_overlay = param->max_overlay_rules ? param->max_overlay_rules
+                                                : CNE_ACL_UPD_OVERLAY_RULES;
+
+    snprintf(name, sizeof(name), "%s_idx", upd->name);
+    hp.name       = name;
+    hp.entries    = upd->max_rules;
+    hp.key_len    = sizeof(uint32_t);
+    hp.hash_func  = cne_jhash;
+    hp.socket_id  = -1;
+    hp.extra_flag = CNE_HASH_EXTRA_FLAGS_EXT_TABLE;
+
+    upd->rules = calloc(upd->max_rules, upd->rule_sz);
+    upd->ents  = calloc(upd->max_rules, sizeof(struct acl_upd_ent));
+    upd->idx   = cne_hash_create(&hp);
+    main       = calloc(1, sizeof(struct acl_upd_main));
+    if (!upd->rules || !upd->ents || !upd->idx || !main || acl_upd_publish(upd, main, 0) < 0) {
+        free(main);
+        goto err;
+    }
+
+    pthread_mutex_init(&upd->lock, NULL);
+    pthread_cond_init(&upd->cond, NULL);
+    pthread_cond_init(&upd->done, NULL);
+
+    if (pthread_create(&upd->builder, NULL, acl_upd_builder, upd) != 0) {
+        pthread_cond_destroy(&upd->done);
+        pthread_cond_destroy(&upd->cond);
+        pthread_mutex_destroy(&upd->lock);
+        upd->gen->free_main = true;
+        acl_upd_gen_free(upd->gen);
+        CNE_ERR_GOTO(err, "Unable to start the builder of ACL %s\n", upd->name);
+    }
+
+    return upd;
+err:
+    cne_hash_free(upd->idx);
+    free(upd->rules);
+    free(upd->ents);
+    free(upd);
+    return NULL;
+}
+
+void
+cne_acl_upd_free(struct cne_acl_upd *upd)
+{
+    struct acl_upd_gen *gen, *next;
+
+    if (!upd)
+        return;
+
+    pthread_mutex_lock(&upd->lock);
+    upd->stop = true;
+    pthread_cond_signal(&upd->cond);
+    pthread_mutex_unlock(&upd->lock);
+    pthread_join(upd->builder, NULL);
+
+    for (gen = upd->retired; gen; gen = next) {
+        next = gen->next;
+        acl_upd_gen_free(gen);
+    }
+    upd->gen->free_main = true;
+    acl_upd_gen_free(upd->gen);
+
+    pthread_cond_destroy(&upd->done);
+    pthread_cond_destroy(&upd->cond);
+    pthread_mutex_destroy(&upd->lock);
+    cne_hash_free(upd->idx);
+    free(upd->rules);
+    free(upd->ents);
+    free(upd);
+}
+
+/*
+ * Check the update can be applied as a whole, called with the lock held. The added and
+ * deleted userdata are sorted to find the duplicates and the replaced rules.
+ */
+static int
+acl_upd_check(struct cne_acl_upd *upd, const struct cne_acl_rule *add, uint32_t num_add,
+              const uint32_t *del, uint32_t num_del)
+{
+    const struct cne_acl_rule *r;
+    uint32_t *ids, *dels, i;
+    int rc = -EINVAL;
+
+    ids = malloc(((size_t)num_add + num_del + 1) * sizeof(uint32_t));
+    if (!ids)
+        return -ENOMEM;
+    dels = ids + num_add;
+
+    memcpy(dels, del, (size_t)num_del * sizeof(uint32_t));
+    qsort(dels, num_del, sizeof(uint32_t), acl_upd_u32_cmp);
+    for (i = 0; i < num_del; i++) {
+        if (i && dels[i] == dels[i - 1])
+            CNE_ERR_GOTO(out, "ACL %s: rule %u deleted twice\n", upd->name, dels[i]);
+        if (acl_upd_find(upd, dels[i]) < 0) {
+            rc = -ENOENT;
+            CNE_ERR_GOTO(out, "ACL %s: rule %u not found\n", upd->name, dels[i]);
+        }
+    }
+
+    for (i = 0; i < num_add; i++) {
+        r = (const struct cne_acl_rule *)((uintptr_t)add + i * upd->rule_sz);
+
+        if (r->data.userdata == 0 || acl_check_rule(&r->data) < 0)
+            CNE_ERR_GOTO(out, "ACL %s: rule #%u is invalid\n", upd->name, i + 1);
+        ids[i] = r->data.userdata;
+    }
+
+    rc = -EEXIST;
+    qsort(ids, num_add, sizeof(uint32_t), acl_upd_u32_cmp);
+    for (i = 0; i < num_add; i++) {
+        if (i && ids[i] == ids[i - 1])
+            CNE_ERR_GOTO(out, "ACL %s: rule %u added twice\n", upd->name, ids[i]);
+
+        /* Replacing an existing rule needs to delete it first */
+        if (acl_upd_find(upd, ids[i]) >= 0 &&
+            !bsearch(&ids[i], dels, num_del, sizeof(uint32_t), acl_upd_u32_cmp))
+            CNE_ERR_GOTO(out, "ACL %s: rule %u already exists\n", upd->name, ids[i]);
+    }
+
+    /* The deleted rules are all distinct and in the list */
+    if (num_add > upd->max_rules || upd->num_rules - num_del > upd->max_rules - num_add)
+        rc = -ENOMEM;
+    else
+        rc = 0;
+
+out:
+    free(ids);
+    return rc;
+}
+
+int
+cne_acl_update(struct cne_acl_upd *upd, const struct cne_acl_rule *add, uint32_t num_add,
+               const uint32_t *del, uint32_t num_del)
+{
+    struct acl_upd_ent *ent;
+    uint32_t i, first;
+    bool overlay, changed = false;
+    int idx, rc;
+
+    if (!upd || (num_add && !add) || (num_del && !del))
+        return -EINVAL;
+
+    pthread_mutex_lock(&upd->lock);
+
+    rc = acl_upd_check(upd, add, num_add, del, num_del);
+    if (rc < 0)
+        goto out;
+
+    upd->seq++;
+
+    for (i = 0; i < num_del; i++) {
+        idx = acl_upd_find(upd, del[i]);
+        cne_hash_del_key(upd->idx, &del[i]);
+
+        if (upd->ents[idx].overlay) {
+            upd->num_overlay--;
+            changed = true;
+        }
+
+        /* Move the last rule in the free slot, updating the existing key can not fail */
+        upd->num_rules--;
+        if ((uint32_t)idx != upd->num_rules) {
+            memcpy(acl_upd_rule(upd, idx), acl_upd_rule(upd, upd->num_rules), upd->rule_sz);
+            upd->ents[idx] = upd->ents[upd->num_rules];
+            acl_upd_index(upd, idx);
+        }
+    }
+
+    /* Too many rules for the overlay wait for the background build */
+    overlay = (upd->num_overlay + num_add <= upd->max_overlay);
+    first   = upd->num_rules;
+
+    memcpy(acl_upd_rule(upd, first), add, (size_t)num_add * upd->rule_sz);
+    for (i = first; i < first + num_add; i++) {
+        ent          = &upd->ents[i];
+        ent->seq     = upd->seq;
+        ent->overlay = overlay;
+
+        upd->num_rules++;
+        if (overlay)
+            upd->num_overlay++;
+        rc = acl_upd_index(upd, i);
+        if (rc < 0) {
+            CNE_ERR("ACL %s: unable to index rule %u\n", upd->name,
+                    acl_upd_rule(upd, i)->data.userdata);
+            break;
+        }
+    }
+    if (overlay && num_add)
+        changed = true;
+
+    if (rc == 0 && changed) {
+        rc = acl_upd_publish(upd, upd->gen->main, 0);
+        if (!overlay || !num_add)
+            rc = 0;
+    }
+
+    /* Drop the added rules, the deletes are applied by the build */
+    if (rc < 0)
+        acl_upd_drop(upd, first);
+
+    upd->dirty = true;
+    pthread_cond_signal(&upd->cond);
+out:
+    pthread_mutex_unlock(&upd->lock);
+
+    return rc;
+}
+
+int
+cne_acl_upd_sync(struct cne_acl_upd *upd)
+{
+    int rc;
+
+    if (!upd)
+        return -EINVAL;
+
+    pthread_mutex_lock(&upd->lock);
+    while (upd->dirty || upd->building)
+        pthread_cond_wait(&upd->done, &upd->lock);
+    rc = upd->build_err;
+    pthread_mutex_unlock(&upd->lock);
+
+    return rc;
+}
+
+int
+cne_acl_upd_classify(struct cne_acl_upd *upd, const uint8_t **data, uint32_t *results,
+                     uint32_t num, uint32_t categories)
+{
+    uint32_t ov[ACL_UPD_BURST * CNE_ACL_MAX_CATEGORIES];
+    const struct acl_upd_gen *gen;
+    uint32_t i, j, n;
+    int rc = 0;
+
+    if (!upd || categories > CNE_ACL_MAX_CATEGORIES)
+        return -EINVAL;
+
+    gen = __atomic_load_n(&upd->gen, __ATOMIC_ACQUIRE);
+
+    if (gen->main->ctx)
+        rc = cne_acl_classify(gen->main->ctx, data, results, num, categories);
+    else
+        memset(results, 0, (size_t)num * categories * sizeof(uint32_t));
+    if (rc < 0 || !gen->overlay)
+        return rc;
+
+    /* A match of the overlay wins unless the main match has a higher priority */
+    for (i = 0; i < num; i += n) {
+        n  = CNE_MIN(num - i, (uint32_t)ACL_UPD_BURST);
+        rc = cne_acl_classify(gen->overlay, &data[i], ov, n, categories);
+        if (rc < 0)
+            return rc;
+
+        for (j = 0; j < n * categories; j++) {
+            uint32_t *res = &results[i * categories + j];
+
+            if (ov[j] == 0)
+                continue;
+            if (*res == 0 || acl_upd_prio_find(gen->ov_prio, gen->num_ov, ov[j]) >=
+                                 acl_upd_prio_find(gen->main->prio, gen->main->num, *res))
+                *res = ov[j];
+        }
+    }
+
+    return 0;
+}
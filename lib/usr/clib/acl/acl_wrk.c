@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <pthread.h>        // for pthread_create, pthread_join, pthread_mutex_lock
+#include <stdbool.h>        // for bool, true, false
+#include <stdlib.h>         // for calloc, free
+
+#include "acl_wrk.h"
+#include "cne_acl.h"
+#include "acl.h"            // for CNE_ACL_MAX_TRIES
+#include "cne_log.h"        // for CNE_ERR
+
+/* At most one job per trie is queued at a time */
+#define ACL_WRK_MAX_JOBS CNE_ACL_MAX_TRIES
+
+struct acl_wrk_job {
+    acl_wrk_fn_t fn;
+    void *arg;
+};
+
+struct acl_wrk_pool {
+    pthread_mutex_t lock;
+    pthread_cond_t cond; /* Job queued or stop requested */
+    pthread_cond_t idle; /* All the jobs completed */
+    struct acl_wrk_job jobs[ACL_WRK_MAX_JOBS];
+    uint32_t head;
+    uint32_t num_queued;
+    uint32_t num_pending; /* Jobs queued or running */
+    bool stop;
+    uint32_t num_threads;
+    pthread_t threads[CNE_ACL_MAX_TRIES];
+};
+
+/* Run one queued job, called with the lock held */
+static void
+acl_wrk_run_one(struct acl_wrk_pool *wp)
+{
+    struct acl_wrk_job job = wp->jobs[wp->head];
+
+    wp->head = (wp->head + 1) % ACL_WRK_MAX_JOBS;
+    wp->num_queued--;
+
+    pthread_mutex_unlock(&wp->lock);
+    job.fn(job.arg);
+    pthread_mutex_lock(&wp->lock);
+
+    if (--wp->num_pending == 0)
+        pthread_cond_broadcast(&wp->idle);
+}
+
+static void *
+acl_wrk_thread(void *arg)
+{
+    struct acl_wrk_pool *wp = arg;
+
+    pthread_mutex_lock(&wp->lock);
+    while (!wp->stop) {
+        if (wp->num_queued)
+            acl_wrk_run_one(wp);
+        else
+            pthread_cond_wait(&wp->cond, &wp->lock);
+    }
+    pthread_mutex_unlock(&wp->lock);
+
+    return NULL;
+}
+
+struct acl_wrk_pool *
+acl_wrk_create(uint32_t num_workers)
+{
+    struct acl_wrk_pool *wp;
+
+    if (num_workers < 2)
+        return NULL;
+    if (num_workers > CNE_ACL_MAX_TRIES)
+        num_workers = CNE_ACL_MAX_TRIES;
+
+    wp = calloc(1, sizeof(struct acl_wrk_pool));
+    if (!wp)
+        return NULL;
+
+    pthread_mutex_init(&wp->lock, NULL);
+    pthread_cond_init(&wp->cond, NULL);
+    pthread_cond_init(&wp->idle, NULL);
+
+    for (; wp->num_threads < num_workers - 1; wp->num_threads++) {
+        if (pthread_create(&wp->threads[wp->num_threads], NULL, acl_wrk_thread, wp) != 0) {
+            CNE_ERR("Unable to start ACL build worker %u\n", wp->num_threads);
+            break;
+        }
+    }
+
+    /* Fewer workers only slow the build down */
+    if (wp->num_threads == 0) {
+        acl_wrk_free(wp);
+        return NULL;
+    }
+
+    return wp;
+}
+
+void
+acl_wrk_free(struct acl_wrk_pool *wp)
+{
+    if (!wp)
+        return;
+
+    pthread_mutex_lock(&wp->lock);
+    wp->stop = true;
+    pthread_cond_broadcast(&wp->cond);
+    pthread_mutex_unlock(&wp->lock);
+
+    for (uint32_t i = 0; i < wp->num_threads; i++)
+        pthread_join(wp->threads[i], NULL);
+
+    pthread_cond_destroy(&wp->idle);
+    pthread_cond_destroy(&wp->cond);
+    pthread_mutex_destroy(&wp->lock);
+    free(wp);
+}
+
+void
+acl_wrk_submit(struct acl_wrk_pool *wp, acl_wrk_fn_t fn, void *arg)
+{
+    if (wp) {
+        pthread_mutex_lock(&wp->lock);
+        if (wp->num_queued < ACL_WRK_MAX_JOBS) {
+            wp->jobs[(wp->head + wp->num_queued++) % ACL_WRK_MAX_JOBS] =
+                (struct acl_wrk_job){fn, arg};
+            wp->num_pending++;
+            pthread_cond_signal(&wp->cond);
+            pthread_mutex_unlock(&wp->lock);
+            return;
+        }
+        pthread_mutex_unlock(&wp->lock);
+    }
+
+    fn(arg);
+}
+
+void
+acl_wrk_wait(struct acl_wrk_pool *wp)
+{
+    if (!wp)
+        return;
+
+    pthread_mutex_lock(&wp->lock);
+    while (wp->num_queued)
+        acl_wrk_run_one(wp);
+    while (wp->num_pending)
+        pthread_cond_wait(&wp->idle, &wp->lock);
+    pthread_mutex_unlock(&wp->lock);
+}
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _ACL_WRK_H_
+#define _ACL_WRK_H_
+
+/**
+ * @file
+ *
+ * ACL build worker pool.
+ * Runs the independent per trie steps of a build on several threads, the
+ * caller of acl_wrk_wait() runs queued jobs too. Without a pool (NULL) the
+ * jobs run on the calling thread when they are submitted.
+ */
+
+#include <stdint.h>        // for uint32_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct acl_wrk_pool;
+
+typedef void (*acl_wrk_fn_t)(void *arg);
+
+/**
+ * Create a worker pool, num_workers - 1 threads are started.
+ *
+ * @param num_workers
+ *   Number of threads running the jobs, including the caller of acl_wrk_wait().
+ * @return
+ *   Pointer to the pool or NULL when num_workers is less than 2 or on error.
+ */
+struct acl_wrk_pool *acl_wrk_create(uint32_t num_workers);
+
+/**
+ * Stop the threads and free the pool, can be NULL.
+ */
+void acl_wrk_free(struct acl_wrk_pool *wp);
+
+/**
+ * Queue a job, it runs right away on the calling thread when the pool is NULL
+ * or its queue is full.
+ */
+void acl_wrk_submit(struct acl_wrk_pool *wp, acl_wrk_fn_t fn, void *arg);
+
+/**
+ * Run the queued jobs and wait for all the submitted jobs to complete.
+ */
+void acl_wrk_wait(struct acl_wrk_pool *wp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ACL_WRK_H_ */
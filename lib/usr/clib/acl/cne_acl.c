@@ -14,7 +14,9 @@
 #include "cne_cpuflags.h"            // for cne_cpu_get_flag_enabled, CNE_CPUFLAG_...
 #include "cne_log.h"                 // for CNE_LOG_ERR, CNE_ERR_GOTO, CNE_ERR_RET...
 #include "cne_build_config.h"        // for CNE_ARCH_X86
+#include "cne_cycles.h"              // for MS_PER_S
 #include "cne_stdio.h"               // for cne_printf
+#include "cne_system.h"              // for cne_get_timer_hz
 
 #ifndef CC_AVX512_SUPPORT
 /*
@@ -190,7 +192,7 @@ acl_add_rules(struct cne_acl_ctx *ctx, const void *rules, uint32_t num)
     return 0;
 }
 
-static int
+int
 acl_check_rule(const struct cne_acl_rule_data *rd)
 {
     if ((CNE_LEN2MASK(CNE_ACL_MAX_CATEGORIES, typeof(rd->category_mask)) & rd->category_mask) ==
@@ -268,4 +270,8 @@ cne_acl_dump(const struct cne_acl_ctx *ctx)
     cne_printf("  num_rules=%" PRIu32 "\n", ctx->num_rules);
     cne_printf("  num_categories=%" PRIu32 "\n", ctx->num_categories);
     cne_printf("  num_tries=%" PRIu32 "\n", ctx->num_tries);
+    cne_printf("  num_workers=%" PRIu32 "\n", ctx->config.num_workers);
+    cne_printf("  mem_size=%zu\n", ctx->mem_sz);
+    cne_printf("  build_mem_size=%zu\n", ctx->build_mem_sz);
+    cne_printf("  build_time=%.3f ms\n", (double)ctx->build_cycles * MS_PER_S / cne_get_timer_hz());
 }
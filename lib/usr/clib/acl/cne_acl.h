@@ -20,6 +20,8 @@
 #include "cne_vect.h"          // for XMM_SIZE
 
 struct cne_acl_ctx;
+struct cne_acl_upd;
+struct cne_rcu_qsbr;
 
 #ifdef __cplusplus
 extern "C" {
@@ -71,6 +73,8 @@ struct cne_acl_config {
     /**< array of field definitions. */
     size_t max_size;
     /**< max memory limit for internal run-time structures. */
+    uint32_t num_workers;
+    /**< number of threads building the tries, 0 or 1 to build on the calling thread. */
 };
 
 /**
@@ -323,6 +327,105 @@ extern int cne_acl_classify_alg(const struct cne_acl_ctx *ctx, const uint8_t **d
  */
 extern int cne_acl_set_ctx_classify(struct cne_acl_ctx *ctx, enum cne_acl_classify_alg alg);
 
+/** Default max number of rules in the overlay context of an updatable ACL. */
+#define CNE_ACL_UPD_OVERLAY_RULES 256
+
+/**
+ * Parameters used when creating an updatable ACL.
+ */
+struct cne_acl_upd_param {
+    const char *name;                 /**< Name of the ACL. */
+    uint32_t rule_size;               /**< Size of each rule. */
+    uint32_t max_rule_num;            /**< Maximum number of rules. */
+    uint32_t max_overlay_rules;       /**< 0 for CNE_ACL_UPD_OVERLAY_RULES. */
+    const struct cne_acl_config *cfg; /**< Build configuration of the contexts. */
+    struct cne_rcu_qsbr *v;           /**< QSBR variable of the classify threads. */
+};
+
+/**
+ * Create an updatable ACL.
+ *
+ * An updatable ACL keeps the list of rules and applies add/delete deltas
+ * without stopping the classification. A background thread rebuilds a context
+ * from all the rules after each update and publishes it atomically, the old
+ * contexts are freed once the classify threads reported a quiescent state on
+ * the QSBR variable.
+ *
+ * A rebuild of a large rule set takes time, the rules added by an update are
+ * also built right away in a small overlay context searched after the main one,
+ * so they match within milliseconds. Deleted rules stop matching once the
+ * rebuilt context is published, cne_acl_upd_sync() waits for it.
+ *
+ * The userdata of a rule identifies it and must be unique and not 0.
+ *
+ * @param param
+ *   Parameters used to create the updatable ACL.
+ * @return
+ *   Pointer to the updatable ACL or NULL on error.
+ */
+struct cne_acl_upd *cne_acl_upd_create(const struct cne_acl_upd_param *param);
+
+/**
+ * Free an updatable ACL, no classify must be in progress.
+ * @param upd
+ *   Updatable ACL to free, can be NULL.
+ */
+void cne_acl_upd_free(struct cne_acl_upd *upd);
+
+/**
+ * Add and delete rules of an updatable ACL.
+ * The deletes are applied first, a rule can be replaced by deleting and adding
+ * its userdata in the same call. This function is not multi-thread safe.
+ * @param upd
+ *   Updatable ACL.
+ * @param add
+ *   Array of rules to add, in the format and size given at create time.
+ * @param num_add
+ *   Number of rules to add.
+ * @param del
+ *   Array of userdata of the rules to delete.
+ * @param num_del
+ *   Number of rules to delete.
+ * @return
+ *   - -EINVAL if the parameters or a rule are invalid.
+ *   - -EEXIST if a rule to add has the userdata of another rule.
+ *   - -ENOENT if a rule to delete is not found.
+ *   - -ENOMEM if there is no space for the rules or the overlay build failed,
+ *     the rules to add are not added.
+ *   - Zero if operation completed successfully.
+ */
+int cne_acl_update(struct cne_acl_upd *upd, const struct cne_acl_rule *add, uint32_t num_add,
+                   const uint32_t *del, uint32_t num_del);
+
+/**
+ * Wait for the background build of all the updates to be published.
+ * @param upd
+ *   Updatable ACL.
+ * @return
+ *   Zero on success or the error code of the last build.
+ */
+int cne_acl_upd_sync(struct cne_acl_upd *upd);
+
+/**
+ * Search the rules of an updatable ACL, see cne_acl_classify().
+ * The caller must be a reader thread of the QSBR variable.
+ * @param upd
+ *   Updatable ACL to search with.
+ * @param data
+ *   Array of pointers to input data buffers to perform search.
+ * @param results
+ *   Array of search results, *categories* results per each input data buffer.
+ * @param num
+ *   Number of elements in the input data buffers array.
+ * @param categories
+ *   Number of maximum possible matches for each input buffer.
+ * @return
+ *   zero on successful completion.
+ *   -EINVAL for incorrect arguments.
+ */
+int cne_acl_upd_classify(struct cne_acl_upd *upd, const uint8_t **data, uint32_t *results,
+                         uint32_t num, uint32_t categories);
+
 /**
  * Dump an ACL context structure to the console.
  *
@@ -0,0 +1,362 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>                    // for snprintf
+#include <stdint.h>                   // for uint16_t, uint32_t, uint8_t
+#include <stdlib.h>                   // for calloc, free
+#include <string.h>                   // for memcpy, memset
+#include <netinet/in.h>               // for IPPROTO_TCP, IPPROTO_UDP, IPPROTO_SCTP
+#include <bsd/string.h>               // for strlcpy
+#include <cne_common.h>               // for CNE_MIN, cne_is_power_of_2, __cne_cache_aligned
+#include <cne_log.h>                  // for CNE_NULL_RET, CNE_ERR_RET
+#include <cne_branch_prediction.h>    // for likely, unlikely
+#include <cne_thash.h>                // for cne_thash_ctx, cne_thash_bulk
+#include <cne_ring_api.h>             // for cne_ring_create, cne_ring_enqueue_burst
+#include <net/cne_ether.h>            // for cne_ether_hdr, cne_vlan_hdr
+#include <net/cne_ip.h>               // for cne_ipv4_hdr, cne_ipv6_hdr
+
+#include "cne_distributor.h"
+
+/* Default 40 byte RSS key used by most NICs */
+static const uint8_t default_rss_key[] = {
+    0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2, 0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3,
+    0x8f, 0xb0, 0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4, 0x77, 0xcb, 0x2d, 0xa3,
+    0x80, 0x30, 0xf2, 0x0c, 0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+/* Tuple lengths in bytes, source and destination addresses followed by the ports */
+#define V4_L3_LEN 8
+#define V4_L4_LEN 12
+#define V6_L3_LEN 32
+#define V6_L4_LEN 36
+
+enum { TUPLE_V4_L3, TUPLE_V4_L4, TUPLE_V6_L3, TUPLE_V6_L4, TUPLE_TYPES, TUPLE_NONE = TUPLE_TYPES };
+
+static const uint32_t tuple_len[TUPLE_TYPES] = {V4_L3_LEN, V4_L4_LEN, V6_L3_LEN, V6_L4_LEN};
+
+struct distributor_worker {
+    cne_ring_t *ring;  /**< Ring between the distributor and the worker */
+    uint64_t enqueued; /**< Updated by the distributor thread */
+    uint64_t full;     /**< Updated by the distributor thread */
+    uint64_t dequeued __cne_cache_aligned; /**< Updated by the worker thread */
+} __cne_cache_aligned;
+
+struct cne_distributor {
+    char name[CNE_DISTRIBUTOR_NAMESIZE]; /**< Name of the distributor */
+    struct cne_thash_ctx *thash;         /**< Toeplitz hash context */
+    uint32_t flags;                      /**< CNE_DISTRIBUTOR_F_* flags */
+    uint16_t num_workers;                /**< Number of workers */
+    uint16_t reta[CNE_DISTRIBUTOR_RETA_SIZE]; /**< Hash to worker redirection table */
+    struct distributor_worker workers[CNE_DISTRIBUTOR_MAX_WORKERS];
+};
+
+static inline bool
+has_ports(uint8_t proto)
+{
+    return proto == IPPROTO_TCP || proto == IPPROTO_UDP || proto == IPPROTO_SCTP;
+}
+
+/*
+ * Extract the hash tuple of a packet in network byte order, returns the tuple
+ * type or TUPLE_NONE when the packet is not IPv4 or IPv6.
+ */
+static inline int
+distributor_tuple(pktmbuf_t *m, uint8_t *tuple, bool l3_only)
+{
+    struct cne_ether_hdr *eth = pktmbuf_mtod(m, struct cne_ether_hdr *);
+    uint16_t ether_type       = eth->ether_type;
+    uint32_t off              = sizeof(struct cne_ether_hdr);
+    uint32_t len              = pktmbuf_data_len(m);
+
+    /* Skip up to two VLAN tags */
+    for (int i = 0; i < 2; i++) {
+        struct cne_vlan_hdr *vh;
+
+        if (ether_type != htobe16(CNE_ETHER_TYPE_VLAN) &&
+            ether_type != htobe16(CNE_ETHER_TYPE_QINQ))
+            break;
+        if (len < off + sizeof(struct cne_vlan_hdr))
+            return TUPLE_NONE;
+        vh         = pktmbuf_mtod_offset(m, struct cne_vlan_hdr *, off);
+        ether_type = vh->eth_proto;
+        off += sizeof(struct cne_vlan_hdr);
+    }
+
+    if (likely(ether_type == htobe16(CNE_ETHER_TYPE_IPV4))) {
+        struct cne_ipv4_hdr *ip4;
+        uint32_t hlen;
+
+        if (len < off + sizeof(struct cne_ipv4_hdr))
+            return TUPLE_NONE;
+        ip4 = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, off);
+        memcpy(tuple, &ip4->src_addr, V4_L3_LEN);
+
+        /* Fragments do not carry ports after the first one, keep them together */
+        hlen = cne_ipv4_hdr_len(ip4);
+        if (l3_only || !has_ports(ip4->next_proto_id) ||
+            (ip4->fragment_offset & htobe16(CNE_IPV4_HDR_MF_FLAG | CNE_IPV4_HDR_OFFSET_MASK)) ||
+            len < off + hlen + sizeof(uint32_t))
+            return TUPLE_V4_L3;
+        memcpy(&tuple[V4_L3_LEN], pktmbuf_mtod_offset(m, uint8_t *, off + hlen), sizeof(uint32_t));
+        return TUPLE_V4_L4;
+    } else if (ether_type == htobe16(CNE_ETHER_TYPE_IPV6)) {
+        struct cne_ipv6_hdr *ip6;
+
+        if (len < off + sizeof(struct cne_ipv6_hdr))
+            return TUPLE_NONE;
+        ip6 = pktmbuf_mtod_offset(m, struct cne_ipv6_hdr *, off);
+        memcpy(tuple, ip6->src_addr, V6_L3_LEN);
+
+        off += sizeof(struct cne_ipv6_hdr);
+        if (l3_only || !has_ports(ip6->proto) || len < off + sizeof(uint32_t))
+            return TUPLE_V6_L3;
+        memcpy(&tuple[V6_L3_LEN], pktmbuf_mtod_offset(m, uint8_t *, off), sizeof(uint32_t));
+        return TUPLE_V6_L4;
+    }
+
+    return TUPLE_NONE;
+}
+
+/* Compute the hash of up to CNE_DISTRIBUTOR_DEFAULT_BURST packets */
+static inline void
+distributor_hash(struct cne_distributor *d, pktmbuf_t **pkts, uint16_t nb_pkts)
+{
+    uint8_t tuples[CNE_DISTRIBUTOR_DEFAULT_BURST][V6_L4_LEN];
+    const uint8_t *tptr[TUPLE_TYPES][CNE_DISTRIBUTOR_DEFAULT_BURST];
+    uint16_t tidx[TUPLE_TYPES][CNE_DISTRIBUTOR_DEFAULT_BURST];
+    uint32_t hashes[CNE_DISTRIBUTOR_DEFAULT_BURST];
+    uint16_t cnt[TUPLE_TYPES] = {0};
+    bool l3_only              = (d->flags & CNE_DISTRIBUTOR_F_L3_ONLY) != 0;
+    bool mbuf_hash            = (d->flags & CNE_DISTRIBUTOR_F_USE_MBUF_HASH) != 0;
+
+    for (uint16_t i = 0; i < nb_pkts; i++) {
+        int type;
+
+        if (mbuf_hash && pktmbuf_hash(pkts[i]) != 0)
+            continue;
+
+        type = distributor_tuple(pkts[i], tuples[i], l3_only);
+        if (unlikely(type == TUPLE_NONE)) {
+            pktmbuf_hash(pkts[i]) = 0;
+            continue;
+        }
+        tptr[type][cnt[type]]   = tuples[i];
+        tidx[type][cnt[type]++] = i;
+    }
+
+    /* Hash all tuples of the same length together to use the bulk functions */
+    for (int t = 0; t < TUPLE_TYPES; t++) {
+        if (cnt[t] == 0)
+            continue;
+
+        cne_thash_bulk(d->thash, tptr[t], tuple_len[t], hashes, cnt[t]);
+
+        for (uint16_t i = 0; i < cnt[t]; i++)
+            pktmbuf_hash(pkts[tidx[t][i]]) = hashes[i];
+    }
+}
+
+uint16_t
+cne_distributor_process(struct cne_distributor *d, pktmbuf_t **pkts, uint16_t nb_pkts)
+{
+    pktmbuf_t *sorted[CNE_DISTRIBUTOR_DEFAULT_BURST];
+    uint16_t wid[CNE_DISTRIBUTOR_DEFAULT_BURST];
+    uint16_t start[CNE_DISTRIBUTOR_MAX_WORKERS + 1];
+    uint16_t nb_failed = 0;
+
+    if (unlikely(!d || !pkts))
+        return 0;
+
+    for (uint32_t base = 0; base < nb_pkts; base += CNE_DISTRIBUTOR_DEFAULT_BURST) {
+        uint16_t n = CNE_MIN(nb_pkts - base, (uint32_t)CNE_DISTRIBUTOR_DEFAULT_BURST);
+
+        distributor_hash(d, &pkts[base], n);
+
+        /* Counting sort of the packets by worker, keeping the order of each flow */
+        memset(start, 0, (d->num_workers + 1) * sizeof(uint16_t));
+        for (uint16_t i = 0; i < n; i++) {
+            wid[i] = d->reta[pktmbuf_hash(pkts[base + i]) & (CNE_DISTRIBUTOR_RETA_SIZE - 1)];
+            start[wid[i] + 1]++;
+        }
+        for (uint16_t w = 0; w < d->num_workers; w++)
+            start[w + 1] += start[w];
+        for (uint16_t i = 0; i < n; i++)
+            sorted[start[wid[i]]++] = pkts[base + i];
+
+        /* start[w] is now the end of worker w packets and the start of worker w + 1 */
+        for (uint16_t w = 0, first = 0; w < d->num_workers; first = start[w++]) {
+            struct distributor_worker *wrk = &d->workers[w];
+            uint16_t cnt                   = start[w] - first;
+            uint16_t enq;
+
+            if (cnt == 0)
+                continue;
+
+            enq = cne_ring_enqueue_burst(wrk->ring, (void *const *)&sorted[first], cnt, NULL);
+            wrk->enqueued += enq;
+
+            /*
+             * Failed packets are collected at the front of the array, which
+             * never overtakes the packets still to be processed.
+             */
+            if (unlikely(enq < cnt)) {
+                wrk->full += cnt - enq;
+                memcpy(&pkts[nb_failed], &sorted[first + enq], (cnt - enq) * sizeof(pktmbuf_t *));
+                nb_failed += cnt - enq;
+            }
+        }
+    }
+
+    if (unlikely(nb_failed))
+        memmove(&pkts[nb_pkts - nb_failed], pkts, nb_failed * sizeof(pktmbuf_t *));
+
+    return nb_pkts - nb_failed;
+}
+
+uint16_t
+cne_distributor_dequeue(struct cne_distributor *d, uint16_t worker, pktmbuf_t **pkts,
+                        uint16_t nb_pkts)
+{
+    struct distributor_worker *wrk;
+    uint16_t n;
+
+    if (unlikely(!d || worker >= d->num_workers))
+        return 0;
+
+    wrk = &d->workers[worker];
+    n   = cne_ring_dequeue_burst(wrk->ring, (void **)pkts, nb_pkts, NULL);
+    wrk->dequeued += n;
+
+    return n;
+}
+
+uint16_t
+cne_distributor_worker_get(struct cne_distributor *d, uint32_t hash)
+{
+    return d->reta[hash & (CNE_DISTRIBUTOR_RETA_SIZE - 1)];
+}
+
+int
+cne_distributor_reta_update(struct cne_distributor *d, const uint16_t *reta)
+{
+    if (!d || !reta)
+        CNE_ERR_RET("Invalid distributor or redirection table\n");
+
+    for (int i = 0; i < CNE_DISTRIBUTOR_RETA_SIZE; i++)
+        if (reta[i] >= d->num_workers)
+            CNE_ERR_RET("Redirection table entry %d worker %u out of range\n", i, reta[i]);
+
+    memcpy(d->reta, reta, sizeof(d->reta));
+
+    return 0;
+}
+
+cne_ring_t *
+cne_distributor_ring(struct cne_distributor *d, uint16_t worker)
+{
+    if (!d || worker >= d->num_workers)
+        return NULL;
+
+    return d->workers[worker].ring;
+}
+
+int
+cne_distributor_stats_get(struct cne_distributor *d, uint16_t worker,
+                          struct cne_distributor_stats *stats)
+{
+    struct distributor_worker *wrk;
+
+    if (!d || worker >= d->num_workers || !stats)
+        return -1;
+
+    wrk             = &d->workers[worker];
+    stats->enqueued = wrk->enqueued;
+    stats->dequeued = wrk->dequeued;
+    stats->full     = wrk->full;
+
+    return 0;
+}
+
+void
+cne_distributor_destroy(struct cne_distributor *d)
+{
+    pktmbuf_t *pkts[CNE_DISTRIBUTOR_DEFAULT_BURST];
+
+    if (!d)
+        return;
+
+    for (uint16_t w = 0; w < d->num_workers; w++) {
+        cne_ring_t *r = d->workers[w].ring;
+        unsigned int n;
+
+        if (!r)
+            continue;
+
+        while ((n = cne_ring_dequeue_burst(r, (void **)pkts, cne_countof(pkts), NULL)) > 0)
+            pktmbuf_free_bulk(pkts, n);
+        cne_ring_free(r);
+    }
+
+    cne_thash_free(d->thash);
+    free(d);
+}
+
+struct cne_distributor *
+cne_distributor_create(const struct cne_distributor_cfg *cfg)
+{
+    struct cne_distributor *d;
+    char rname[CNE_RING_NAMESIZE];
+    uint32_t ring_size;
+
+    if (!cfg || !cfg->name)
+        CNE_NULL_RET("Invalid distributor configuration\n");
+
+    if (cfg->num_workers == 0 || cfg->num_workers > CNE_DISTRIBUTOR_MAX_WORKERS)
+        CNE_NULL_RET("Number of workers %u must be 1 to %d\n", cfg->num_workers,
+                     CNE_DISTRIBUTOR_MAX_WORKERS);
+
+    ring_size = (cfg->ring_size) ? cfg->ring_size : CNE_DISTRIBUTOR_RING_SIZE;
+    if (!cne_is_power_of_2(ring_size))
+        CNE_NULL_RET("Ring size %u is not a power of 2\n", ring_size);
+
+    d = calloc(1, sizeof(struct cne_distributor));
+    if (!d)
+        CNE_NULL_RET("Unable to allocate distributor %s\n", cfg->name);
+
+    strlcpy(d->name, cfg->name, sizeof(d->name));
+    d->flags       = cfg->flags;
+    d->num_workers = cfg->num_workers;
+
+    if (cfg->rss_key)
+        d->thash = cne_thash_create(cfg->rss_key, cfg->key_len, CNE_THASH_IMPL_DEFAULT);
+    else
+        d->thash =
+            cne_thash_create(default_rss_key, sizeof(default_rss_key), CNE_THASH_IMPL_DEFAULT);
+    if (!d->thash)
+        goto err;
+
+    /* The key must cover the longest tuple unless only L3 tuples are hashed */
+    if (cfg->rss_key && cfg->key_len < V6_L4_LEN + 4 && !(cfg->flags & CNE_DISTRIBUTOR_F_L3_ONLY)) {
+        CNE_ERR("RSS key length %u too short for IPv6 5-tuples\n", cfg->key_len);
+        goto err;
+    }
+
+    for (int i = 0; i < CNE_DISTRIBUTOR_RETA_SIZE; i++)
+        d->reta[i] = i % d->num_workers;
+
+    for (uint16_t w = 0; w < d->num_workers; w++) {
+        snprintf(rname, sizeof(rname), "%s-%u", d->name, w);
+
+        d->workers[w].ring = cne_ring_create(rname, 0, ring_size, RING_F_SP_ENQ | RING_F_SC_DEQ);
+        if (!d->workers[w].ring) {
+            CNE_ERR("Unable to create ring %s\n", rname);
+            goto err;
+        }
+    }
+
+    return d;
+err:
+    cne_distributor_destroy(d);
+    return NULL;
+}
@@ -0,0 +1,175 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_DISTRIBUTOR_H_
+#define _CNE_DISTRIBUTOR_H_
+
+/**
+ * @file
+ * CNE Flow Distributor
+ *
+ * Software RSS for lports without hardware RSS, e.g. AF_PACKET, tap and memif,
+ * or to spread the traffic of a single queue NIC over several cores. A single
+ * RX thread calls cne_distributor_process() with a burst of packets, the
+ * Toeplitz hash of the IPv4/IPv6 5-tuple selects a worker through a redirection
+ * table and the packet is enqueued on that worker's ring. Packets of the same
+ * flow always reach the same worker, as long as the redirection table is not
+ * changed. Workers pull their packets with cne_distributor_dequeue().
+ */
+
+#include <stdint.h>        // for uint16_t, uint32_t, uint64_t, uint8_t
+#include <cne_common.h>
+#include <cne_ring.h>
+#include <pktmbuf.h>        // for pktmbuf_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_DISTRIBUTOR_NAMESIZE     32   /**< Max size of the distributor name */
+#define CNE_DISTRIBUTOR_MAX_WORKERS  64   /**< Max number of worker rings */
+#define CNE_DISTRIBUTOR_RETA_SIZE    512  /**< Number of redirection table entries */
+#define CNE_DISTRIBUTOR_RING_SIZE    1024 /**< Default worker ring size */
+#define CNE_DISTRIBUTOR_DEFAULT_BURST 64  /**< Packets hashed per internal batch */
+
+/** Hash only the IP addresses, e.g. when fragments of a flow must stay together */
+#define CNE_DISTRIBUTOR_F_L3_ONLY (1 << 0)
+/** Use pktmbuf_hash() when it is non-zero instead of computing the hash */
+#define CNE_DISTRIBUTOR_F_USE_MBUF_HASH (1 << 1)
+
+/** Distributor configuration */
+struct cne_distributor_cfg {
+    const char *name;       /**< Name of the distributor, used to name the rings */
+    uint16_t num_workers;   /**< Number of workers, 1 to CNE_DISTRIBUTOR_MAX_WORKERS */
+    uint32_t ring_size;     /**< Entries per worker ring, power of 2 or 0 for default */
+    const uint8_t *rss_key; /**< RSS key or NULL to use the default 40 byte key */
+    uint32_t key_len;       /**< Length of the RSS key in bytes */
+    uint32_t flags;         /**< CNE_DISTRIBUTOR_F_* flags */
+};
+
+/** Per worker statistics */
+struct cne_distributor_stats {
+    uint64_t enqueued; /**< Packets enqueued on the worker ring */
+    uint64_t dequeued; /**< Packets dequeued by the worker */
+    uint64_t full;     /**< Packets not enqueued because the ring was full */
+};
+
+struct cne_distributor;
+
+/**
+ * Create a flow distributor.
+ *
+ * @param cfg
+ *   The distributor configuration.
+ * @return
+ *   Pointer to the distributor or NULL on error.
+ */
+CNDP_API struct cne_distributor *cne_distributor_create(const struct cne_distributor_cfg *cfg);
+
+/**
+ * Destroy a flow distributor, packets still in the worker rings are freed.
+ *
+ * @param d
+ *   Pointer to the distributor, can be NULL.
+ */
+CNDP_API void cne_distributor_destroy(struct cne_distributor *d);
+
+/**
+ * Hash a burst of packets and enqueue them on the worker rings, must only be
+ * called from a single thread.
+ *
+ * The computed hash is stored in pktmbuf_hash() of every packet. Packets that
+ * could not be enqueued because the worker ring was full are moved to the end
+ * of the array, starting at the returned index, for the caller to free or retry.
+ *
+ * @param d
+ *   Pointer to the distributor.
+ * @param pkts
+ *   Array of packets to distribute.
+ * @param nb_pkts
+ *   Number of packets in the array.
+ * @return
+ *   Number of packets enqueued on worker rings.
+ */
+CNDP_API uint16_t cne_distributor_process(struct cne_distributor *d, pktmbuf_t **pkts,
+                                          uint16_t nb_pkts);
+
+/**
+ * Dequeue packets distributed to a worker, must only be called from the thread
+ * owning the worker.
+ *
+ * @param d
+ *   Pointer to the distributor.
+ * @param worker
+ *   Worker index, less than cfg->num_workers.
+ * @param pkts
+ *   Array to hold the dequeued packets.
+ * @param nb_pkts
+ *   Maximum number of packets to dequeue.
+ * @return
+ *   Number of packets dequeued.
+ */
+CNDP_API uint16_t cne_distributor_dequeue(struct cne_distributor *d, uint16_t worker,
+                                          pktmbuf_t **pkts, uint16_t nb_pkts);
+
+/**
+ * Return the worker index selected for a hash value.
+ *
+ * @param d
+ *   Pointer to the distributor.
+ * @param hash
+ *   Hash value returned in pktmbuf_hash().
+ * @return
+ *   Worker index.
+ */
+CNDP_API uint16_t cne_distributor_worker_get(struct cne_distributor *d, uint32_t hash);
+
+/**
+ * Update the redirection table, used to rebalance flows between workers.
+ *
+ * Flows whose redirection table entry changes move to the new worker, packets
+ * of those flows already queued on the old worker ring are not reordered with
+ * respect to each other but can be processed in parallel with new ones.
+ *
+ * @param d
+ *   Pointer to the distributor.
+ * @param reta
+ *   Array of CNE_DISTRIBUTOR_RETA_SIZE worker indexes.
+ * @return
+ *   0 on success or -1 on error, e.g. a worker index is out of range.
+ */
+CNDP_API int cne_distributor_reta_update(struct cne_distributor *d, const uint16_t *reta);
+
+/**
+ * Return the ring of a worker, e.g. to be polled by an idle manager.
+ *
+ * @param d
+ *   Pointer to the distributor.
+ * @param worker
+ *   Worker index.
+ * @return
+ *   Pointer to the ring or NULL on error.
+ */
+CNDP_API cne_ring_t *cne_distributor_ring(struct cne_distributor *d, uint16_t worker);
+
+/**
+ * Get the statistics of a worker.
+ *
+ * @param d
+ *   Pointer to the distributor.
+ * @param worker
+ *   Worker index.
+ * @param stats
+ *   Location to store the statistics.
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cne_distributor_stats_get(struct cne_distributor *d, uint16_t worker,
+                                       struct cne_distributor_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_DISTRIBUTOR_H_ */
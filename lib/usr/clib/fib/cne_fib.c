@@ -8,8 +8,9 @@
 #include <cne_log.h>           // for CNE_LOG_ERR, CNE_ERR_GOTO, CNE_NULL_RET
 #include <cne_rib.h>           // for cne_rib_free, cne_rib_conf, cne_rib_create
 #include <cne_fib.h>
+#include <cne_rcu_qsbr.h>        // for cne_rcu_qsbr_synchronize
 #include <bsd/string.h>        // for strlcpy
-#include <errno.h>             // for EINVAL, ENOENT
+#include <errno.h>             // for EINVAL, ENOENT, ENOMEM
 #include <stdlib.h>            // for NULL, free, calloc
 
 #include "dir24_8.h"        // for dir24_8_get_lookup_fn, dir24_8_create, dir24...
@@ -27,6 +28,8 @@ struct cne_fib {
     cne_fib_lookup_fn_t lookup; /**< fib lookup function */
     cne_fib_modify_fn_t modify; /**< modify fib datastruct */
     uint64_t def_nh;
+    struct cne_fib_conf conf;           /**< Configuration, used to build a shadow FIB */
+    struct cne_fib_rcu_config *rcu_cfg; /**< RCU QSBR configuration or NULL */
 };
 
 static void
@@ -108,10 +111,91 @@ cne_fib_delete(struct cne_fib *fib, uint32_t ip, uint8_t depth)
     return fib->modify(fib, ip, depth, 0, CNE_FIB_DEL);
 }
 
+int
+cne_fib_add_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n)
+{
+    uint32_t i;
+    int ret;
+
+    if ((fib == NULL) || (fib->modify == NULL) || (routes == NULL && n != 0))
+        return -EINVAL;
+
+    if (fib->type == CNE_FIB_DIR24_8)
+        return dir24_8_modify_bulk(fib, routes, n, CNE_FIB_ADD);
+
+    for (i = 0; i < n; i++) {
+        ret = cne_fib_add(fib, routes[i].ip, routes[i].depth, routes[i].next_hop);
+        if (ret != 0)
+            return ret;
+    }
+    return 0;
+}
+
+int
+cne_fib_delete_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n)
+{
+    uint32_t i;
+    int ret;
+
+    if ((fib == NULL) || (fib->modify == NULL) || (routes == NULL && n != 0))
+        return -EINVAL;
+
+    if (fib->type == CNE_FIB_DIR24_8)
+        return dir24_8_modify_bulk(fib, routes, n, CNE_FIB_DEL);
+
+    for (i = 0; i < n; i++) {
+        ret = cne_fib_delete(fib, routes[i].ip, routes[i].depth);
+        if (ret != 0 && ret != -ENOENT)
+            return ret;
+    }
+    return 0;
+}
+
+int
+cne_fib_replace(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n)
+{
+    struct cne_fib *shadow;
+    struct cne_rib *rib;
+    void *dp;
+    int ret;
+
+    if ((fib == NULL) || (routes == NULL && n != 0) || (fib->type != CNE_FIB_DIR24_8))
+        return -EINVAL;
+
+    shadow = cne_fib_create(fib->name, &fib->conf);
+    if (shadow == NULL)
+        return -ENOMEM;
+
+    if (fib->rcu_cfg) {
+        ret = cne_fib_rcu_qsbr_add(shadow, fib->rcu_cfg);
+        if (ret != 0)
+            goto out;
+    }
+
+    ret = cne_fib_add_bulk(shadow, routes, n);
+    if (ret != 0)
+        goto out;
+
+    /* Lookups load fib->dp once per burst, they use either the old or the new tables */
+    dp = fib->dp;
+    __atomic_store_n(&fib->dp, shadow->dp, __ATOMIC_RELEASE);
+    shadow->dp = dp;
+
+    rib         = fib->rib;
+    fib->rib    = shadow->rib;
+    shadow->rib = rib;
+
+    if (fib->rcu_cfg)
+        cne_rcu_qsbr_synchronize(fib->rcu_cfg->v, CNE_QSBR_THRID_INVALID);
+out:
+    cne_fib_free(shadow);
+    return ret;
+}
+
 int
 cne_fib_lookup_bulk(struct cne_fib *fib, uint32_t *ips, uint64_t *next_hops, int n)
 {
-    fib->lookup(fib->dp, ips, next_hops, n);
+    fib->lookup(__atomic_load_n(&fib->dp, __ATOMIC_ACQUIRE), ips, next_hops, n);
     return 0;
 }
 
@@ -146,6 +230,7 @@ cne_fib_create(const char *name, struct cne_fib_conf *conf)
     fib->rib    = rib;
     fib->type   = conf->type;
     fib->def_nh = conf->default_nh;
+    fib->conf   = *conf;
     ret         = init_dataplane(fib, conf);
     if (ret < 0)
         CNE_ERR_GOTO(free_fib,
@@ -187,6 +272,7 @@ cne_fib_free(struct cne_fib *fib)
 
     free_dataplane(fib);
     cne_rib_free(fib->rib);
+    free(fib->rcu_cfg);
     free(fib);
 }
 
@@ -202,6 +288,35 @@ cne_fib_get_rib(struct cne_fib *fib)
     return (fib == NULL) ? NULL : fib->rib;
 }
 
+int
+cne_fib_rcu_qsbr_add(struct cne_fib *fib, struct cne_fib_rcu_config *cfg)
+{
+    struct cne_fib_rcu_config *rcu_cfg;
+    int ret;
+
+    if (fib == NULL || cfg == NULL)
+        return -EINVAL;
+
+    switch (fib->type) {
+    case CNE_FIB_DIR24_8:
+        /* Keep a copy for the shadow FIB built by cne_fib_replace() */
+        rcu_cfg = calloc(1, sizeof(*rcu_cfg));
+        if (rcu_cfg == NULL)
+            return -ENOMEM;
+
+        ret = dir24_8_rcu_qsbr_add(fib->dp, cfg, fib->name);
+        if (ret != 0) {
+            free(rcu_cfg);
+            return ret;
+        }
+        *rcu_cfg     = *cfg;
+        fib->rcu_cfg = rcu_cfg;
+        return 0;
+    default:
+        return -EINVAL;
+    }
+}
+
 int
 cne_fib_select_lookup(struct cne_fib *fib, enum cne_fib_lookup_type type)
 {
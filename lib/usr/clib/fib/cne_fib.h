@@ -24,6 +24,7 @@ extern "C" {
 
 struct cne_fib;
 struct cne_rib;
+struct cne_rcu_qsbr;
 
 /** Maximum depth value possible for IPv4 FIB. */
 #define CNE_FIB_MAXDEPTH 32
@@ -69,8 +70,10 @@ enum cne_fib_lookup_type {
     /**<
      * Unified lookup function for all next hop sizes
      */
-    CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512
+    CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512,
     /**< Vector implementation using AVX512 */
+    CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2
+    /**< Vector implementation using AVX2 gathers, 8 addresses at a time */
 };
 
 /** FIB configuration structure */
@@ -87,6 +90,28 @@ struct cne_fib_conf {
     };
 };
 
+/** Route entry of the bulk programming API */
+struct cne_fib_route {
+    uint32_t ip;       /**< IPv4 prefix address, bits past depth are ignored */
+    uint8_t depth;     /**< Prefix length */
+    uint64_t next_hop; /**< Next hop, unused on delete */
+};
+
+/** FIB RCU QSBR integration modes */
+enum cne_fib_qsbr_mode {
+    CNE_FIB_QSBR_MODE_DQ = 0, /**< Free the tbl8 groups through a defer queue */
+    CNE_FIB_QSBR_MODE_SYNC    /**< Wait for the readers on every tbl8 group free */
+};
+
+/** FIB RCU QSBR configuration structure */
+struct cne_fib_rcu_config {
+    struct cne_rcu_qsbr *v;      /**< RCU QSBR variable used by the lookup threads */
+    enum cne_fib_qsbr_mode mode; /**< Mode of the RCU QSBR integration */
+    uint32_t dq_size;            /**< Defer queue size, 0 for the number of tbl8 groups */
+    uint32_t reclaim_thd;        /**< Reclaim on delete above this many pending groups */
+    uint32_t reclaim_max;        /**< Max groups freed on reclaim, 0 for the default */
+};
+
 /**
  * Create a FIB structure using the configuration specified.
  *
@@ -139,6 +164,65 @@ int cne_fib_add(struct cne_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_h
  */
 int cne_fib_delete(struct cne_fib *fib, uint32_t ip, uint8_t depth);
 
+/**
+ * Add a set of routes to the FIB.
+ *
+ * The routes are sorted and inserted in the RIB first, then the range of every
+ * changed prefix is written once to the dataplane tables, instead of rewriting
+ * the tables on each route as cne_fib_add() does. Meant to load a full table at
+ * startup or to apply a routing protocol update. When a prefix is given more than
+ * once the last entry wins.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param routes
+ *   Array of routes to add
+ * @param n
+ *   Number of routes in the array
+ * @return
+ *   0 on success, negative value otherwise. On error the routes added before the
+ *   failure stay in the FIB.
+ */
+int cne_fib_add_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n);
+
+/**
+ * Delete a set of routes from the FIB, the next_hop of the routes is not used.
+ * Routes not in the FIB are ignored.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param routes
+ *   Array of routes to delete
+ * @param n
+ *   Number of routes in the array
+ * @return
+ *   0 on success, negative value otherwise
+ */
+int cne_fib_delete_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n);
+
+/**
+ * Replace the content of the FIB with a new set of routes.
+ *
+ * A shadow FIB with the same configuration is built from the routes and swapped
+ * with the current tables in one step, lookups see either the old or the new
+ * table and never a partly updated one. The old tables are freed on return.
+ *
+ * With an RCU QSBR variable added by cne_fib_rcu_qsbr_add() the call waits for
+ * the lookup threads to report a quiescent state before freeing the old tables,
+ * otherwise the caller must make sure no lookup is in progress. Only supported
+ * by the DIR24_8 FIB, twice the table memory is needed during the call.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param routes
+ *   Array of routes of the new table
+ * @param n
+ *   Number of routes in the array
+ * @return
+ *   0 on success, negative value otherwise. On error the FIB is unchanged.
+ */
+int cne_fib_replace(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n);
+
 /**
  * Lookup multiple IP addresses in the FIB.
  *
@@ -193,6 +277,26 @@ struct cne_rib *cne_fib_get_rib(struct cne_fib *fib);
  */
 int cne_fib_select_lookup(struct cne_fib *fib, enum cne_fib_lookup_type type);
 
+/**
+ * Associate an RCU QSBR variable with the FIB. A tbl8 group released by a route
+ * delete is only reused once the lookup threads reported a quiescent state, so
+ * routes can be changed while other threads do lookups without a lock.
+ *
+ * Lookups must be done by threads registered with the QSBR variable, the graph
+ * walk reports the quiescent state when cne_graph_qsbr_add() is used.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   0 on success
+ *   -EINVAL on invalid parameters or FIB type
+ *   -EEXIST if a QSBR variable is already associated
+ *   -ENOMEM on allocation failure
+ */
+int cne_fib_rcu_qsbr_add(struct cne_fib *fib, struct cne_fib_rcu_config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,9 +10,10 @@
 #include "private_fib6.h"        // for CNE_FIB6_IPV6_ADDR_SIZE, CNE_FIB6_TRIE
 #include <cne_fib6.h>
 #include <bsd/string.h>        // for strlcpy
-#include <errno.h>             // for EINVAL, ENOENT
+#include <errno.h>             // for EINVAL, ENOENT, ENOMEM
 #include <stdio.h>             // for NULL, snprintf
-#include <stdlib.h>            // for free, calloc
+#include <stdlib.h>            // for free, calloc, qsort
+#include <string.h>            // for memcpy
 
 #include "trie.h"        // for trie_get_lookup_fn, trie_create, trie_free
 
@@ -116,6 +117,92 @@ cne_fib6_delete(struct cne_fib6 *fib, const uint8_t ip[CNE_FIB6_IPV6_ADDR_SIZE],
     return fib->modify(fib, ip, depth, 0, CNE_FIB6_DEL);
 }
 
+/* Order the routes by decreasing depth then address, bits past depth are ignored */
+static int
+fib6_prefix_cmp(const struct cne_fib6_route *r1, const struct cne_fib6_route *r2)
+{
+    uint8_t msk;
+    int i;
+
+    if (r1->depth != r2->depth)
+        return (int)r2->depth - (int)r1->depth;
+
+    for (i = 0; i < CNE_FIB6_IPV6_ADDR_SIZE; i++) {
+        msk = get_msk_part(r1->depth, i);
+        if ((r1->ip[i] & msk) != (r2->ip[i] & msk))
+            return (int)(r1->ip[i] & msk) - (int)(r2->ip[i] & msk);
+    }
+    return 0;
+}
+
+static int
+fib6_route_cmp(const void *p1, const void *p2)
+{
+    const struct cne_fib6_route *r1 = *(const struct cne_fib6_route *const *)p1;
+    const struct cne_fib6_route *r2 = *(const struct cne_fib6_route *const *)p2;
+    int ret;
+
+    /* the same prefix keeps the array order */
+    ret = fib6_prefix_cmp(r1, r2);
+    if (ret == 0)
+        ret = (r1 < r2) ? -1 : (r1 > r2);
+    return ret;
+}
+
+int
+cne_fib6_add_bulk(struct cne_fib6 *fib, const struct cne_fib6_route *routes, uint32_t n)
+{
+    const struct cne_fib6_route **sorted;
+    struct cne_rib6_route *rib_routes;
+    uint32_t i;
+    int ret = 0;
+
+    if ((fib == NULL) || (fib->modify == NULL) || (routes == NULL && n != 0))
+        return -EINVAL;
+
+    for (i = 0; i < n; i++)
+        if (routes[i].depth > CNE_FIB6_MAXDEPTH)
+            return -EINVAL;
+
+    if (n == 0)
+        return 0;
+
+    /* The RIB is the FIB of the dummy type */
+    if (fib->type == CNE_FIB6_DUMMY) {
+        rib_routes = calloc(n, sizeof(struct cne_rib6_route));
+        if (rib_routes == NULL)
+            return -ENOMEM;
+        for (i = 0; i < n; i++) {
+            memcpy(rib_routes[i].ip, routes[i].ip, CNE_FIB6_IPV6_ADDR_SIZE);
+            rib_routes[i].depth    = routes[i].depth;
+            rib_routes[i].next_hop = routes[i].next_hop;
+        }
+        ret = cne_rib6_insert_bulk(fib->rib, rib_routes, n);
+        free(rib_routes);
+        return ret;
+    }
+
+    sorted = calloc(n, sizeof(struct cne_fib6_route *));
+    if (sorted == NULL)
+        return -ENOMEM;
+
+    for (i = 0; i < n; i++)
+        sorted[i] = &routes[i];
+    qsort(sorted, n, sizeof(struct cne_fib6_route *), fib6_route_cmp);
+
+    for (i = 0; i < n; i++) {
+        /* only the last entry of a prefix is written */
+        if (i + 1 < n && fib6_prefix_cmp(sorted[i], sorted[i + 1]) == 0)
+            continue;
+        ret = fib->modify(fib, sorted[i]->ip, sorted[i]->depth, sorted[i]->next_hop, CNE_FIB6_ADD);
+        if (ret != 0)
+            break;
+    }
+    free(sorted);
+
+    return ret;
+}
+
 int
 cne_fib6_lookup_bulk(struct cne_fib6 *fib, uint8_t ips[][CNE_FIB6_IPV6_ADDR_SIZE],
                      uint64_t *next_hops, int n)
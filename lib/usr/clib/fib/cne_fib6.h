@@ -43,7 +43,9 @@ enum cne_fib6_lookup_type {
     CNE_FIB6_LOOKUP_DEFAULT,
     /**< Selects the best implementation based on the max AVX bitwidth */
     CNE_FIB6_LOOKUP_TRIE_SCALAR,       /**< Scalar lookup function implementation*/
-    CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX512 /**< Vector implementation using AVX512 */
+    CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX512, /**< Vector implementation using AVX512 */
+    CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX2
+    /**< Vector implementation using AVX2 gathers, 16 addresses at a time */
 };
 
 /** FIB configuration structure */
@@ -60,6 +62,13 @@ struct cne_fib6_conf {
     };
 };
 
+/** Route entry of cne_fib6_add_bulk() */
+struct cne_fib6_route {
+    uint8_t ip[CNE_FIB6_IPV6_ADDR_SIZE]; /**< IPv6 prefix address */
+    uint8_t depth;                       /**< Prefix length */
+    uint64_t next_hop;                   /**< Next hop of the prefix */
+};
+
 /**
  * Create FIB
  *
@@ -113,6 +122,27 @@ int cne_fib6_add(struct cne_fib6 *fib, const uint8_t ip[CNE_FIB6_IPV6_ADDR_SIZE]
  */
 int cne_fib6_delete(struct cne_fib6 *fib, const uint8_t ip[CNE_FIB6_IPV6_ADDR_SIZE], uint8_t depth);
 
+/**
+ * Add a set of routes to the FIB.
+ *
+ * The routes are added from the most to the least specific prefix, a prefix
+ * only writes the parts of its range not covered by more specifics, so every
+ * table entry is written once instead of once per covering prefix. Meant to load
+ * a full table at startup, when a prefix is given more than once only the last
+ * entry is written.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param routes
+ *   Array of routes to add
+ * @param n
+ *   Number of routes in the array
+ * @return
+ *   0 on success, negative value otherwise. On error the routes added before the
+ *   failure stay in the FIB.
+ */
+int cne_fib6_add_bulk(struct cne_fib6 *fib, const struct cne_fib6_route *routes, uint32_t n);
+
 /**
  * Lookup multiple IP addresses in the FIB.
  *
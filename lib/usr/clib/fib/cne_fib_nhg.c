@@ -0,0 +1,266 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>             // for fprintf, FILE
+#include <stdint.h>            // for uint64_t, uint32_t, uint16_t
+#include <stdbool.h>           // for bool, true, false
+#include <stdlib.h>            // for calloc, free
+#include <inttypes.h>          // for PRIx64
+#include <errno.h>             // for EINVAL, ENOENT, ENOSPC
+#include <bsd/string.h>        // for strlcpy
+#include <cne_common.h>        // for cne_is_power_of_2
+#include <cne_log.h>           // for CNE_NULL_RET
+
+#include "cne_fib_nhg.h"
+
+/* Owner of a bucket not assigned to any member */
+#define NHG_NO_OWNER 0xffff
+
+static int
+nhg_member_find(struct cne_fib_nhg *nhg, uint64_t next_hop)
+{
+    for (int i = 0; i < nhg->nb_members; i++)
+        if (nhg->members[i].next_hop == next_hop)
+            return i;
+    return -ENOENT;
+}
+
+/*
+ * Number of buckets each member should own, proportional to the weight of the
+ * members up. The buckets left by the rounding go to the largest remainders.
+ */
+static uint32_t
+nhg_quota(struct cne_fib_nhg *nhg, uint32_t *quota)
+{
+    uint64_t rem[CNE_FIB_NHG_MAX_MEMBERS];
+    uint64_t total = 0;
+    uint32_t used  = 0;
+    int i;
+
+    for (i = 0; i < nhg->nb_members; i++)
+        if (nhg->members[i].up)
+            total += nhg->members[i].weight;
+
+    for (i = 0; i < nhg->nb_members; i++) {
+        quota[i] = 0;
+        rem[i]   = 0;
+        if (!nhg->members[i].up)
+            continue;
+        quota[i] = ((uint64_t)nhg->nb_buckets * nhg->members[i].weight) / total;
+        rem[i]   = ((uint64_t)nhg->nb_buckets * nhg->members[i].weight) % total;
+        used += quota[i];
+    }
+
+    while (total && used < nhg->nb_buckets) {
+        int best = -1;
+
+        for (i = 0; i < nhg->nb_members; i++)
+            if (nhg->members[i].up && (best < 0 || rem[i] > rem[best]))
+                best = i;
+        quota[best]++;
+        rem[best] = 0;
+        used++;
+    }
+
+    return (uint32_t)total;
+}
+
+static inline void
+nhg_bucket_set(struct cne_fib_nhg *nhg, uint32_t b, uint16_t owner, uint64_t next_hop)
+{
+    nhg->owner[b] = owner;
+    __atomic_store_n(&nhg->buckets[b], next_hop, __ATOMIC_RELAXED);
+}
+
+/*
+ * Move the minimum number of buckets to match the quotas, a bucket only moves
+ * when its owner is down, removed or owns more buckets than its quota.
+ */
+static void
+nhg_rebalance(struct cne_fib_nhg *nhg)
+{
+    uint32_t quota[CNE_FIB_NHG_MAX_MEMBERS];
+    uint32_t b;
+    uint16_t o;
+    int m = 0;
+
+    if (nhg_quota(nhg, quota) == 0) {
+        for (b = 0; b < nhg->nb_buckets; b++)
+            nhg_bucket_set(nhg, b, NHG_NO_OWNER, nhg->default_nh);
+        for (m = 0; m < nhg->nb_members; m++)
+            nhg->members[m].nb_buckets = 0;
+        return;
+    }
+
+    /* Release the buckets above the quota of their owner */
+    for (b = 0; b < nhg->nb_buckets; b++) {
+        o = nhg->owner[b];
+        if (o == NHG_NO_OWNER)
+            continue;
+        if (nhg->members[o].nb_buckets > quota[o]) {
+            nhg->members[o].nb_buckets--;
+            nhg->owner[b] = NHG_NO_OWNER;
+        }
+    }
+
+    /* Hand the released buckets to the members below their quota */
+    for (b = 0; b < nhg->nb_buckets; b++) {
+        if (nhg->owner[b] != NHG_NO_OWNER)
+            continue;
+        while (nhg->members[m].nb_buckets >= quota[m])
+            m++;
+        nhg->members[m].nb_buckets++;
+        nhg_bucket_set(nhg, b, m, nhg->members[m].next_hop);
+    }
+}
+
+struct cne_fib_nhg *
+cne_fib_nhg_create(const char *name, uint32_t nb_buckets, uint64_t default_nh)
+{
+    struct cne_fib_nhg *nhg;
+
+    if (nb_buckets == 0)
+        nb_buckets = CNE_FIB_NHG_BUCKETS;
+
+    if (!name || !cne_is_power_of_2(nb_buckets) || nb_buckets < CNE_FIB_NHG_MAX_MEMBERS ||
+        nb_buckets > CNE_FIB_NHG_MAX_BUCKETS)
+        CNE_NULL_RET("Invalid nexthop group name or number of buckets %u\n", nb_buckets);
+
+    nhg = calloc(1, sizeof(struct cne_fib_nhg));
+    if (!nhg)
+        CNE_NULL_RET("Unable to allocate nexthop group %s\n", name);
+
+    nhg->buckets = calloc(nb_buckets, sizeof(uint64_t));
+    nhg->owner   = calloc(nb_buckets, sizeof(uint16_t));
+    if (!nhg->buckets || !nhg->owner) {
+        cne_fib_nhg_free(nhg);
+        CNE_NULL_RET("Unable to allocate buckets of nexthop group %s\n", name);
+    }
+
+    strlcpy(nhg->name, name, sizeof(nhg->name));
+    nhg->nb_buckets  = nb_buckets;
+    nhg->bucket_mask = nb_buckets - 1;
+    nhg->default_nh  = default_nh;
+
+    nhg_rebalance(nhg);
+
+    return nhg;
+}
+
+void
+cne_fib_nhg_free(struct cne_fib_nhg *nhg)
+{
+    if (nhg) {
+        free(nhg->buckets);
+        free(nhg->owner);
+        free(nhg);
+    }
+}
+
+int
+cne_fib_nhg_member_add(struct cne_fib_nhg *nhg, uint64_t next_hop, uint32_t weight)
+{
+    int idx;
+
+    if (!nhg || weight == 0)
+        return -EINVAL;
+
+    idx = nhg_member_find(nhg, next_hop);
+    if (idx < 0) {
+        if (nhg->nb_members >= CNE_FIB_NHG_MAX_MEMBERS)
+            return -ENOSPC;
+        idx = nhg->nb_members++;
+
+        nhg->members[idx].next_hop   = next_hop;
+        nhg->members[idx].nb_buckets = 0;
+        nhg->members[idx].up         = true;
+    }
+    nhg->members[idx].weight = weight;
+
+    nhg_rebalance(nhg);
+
+    return 0;
+}
+
+int
+cne_fib_nhg_member_del(struct cne_fib_nhg *nhg, uint64_t next_hop)
+{
+    uint16_t last;
+    uint32_t b;
+    int idx;
+
+    if (!nhg)
+        return -EINVAL;
+
+    idx = nhg_member_find(nhg, next_hop);
+    if (idx < 0)
+        return idx;
+
+    /* Move the last member into the free slot, its buckets follow it */
+    last = --nhg->nb_members;
+    for (b = 0; b < nhg->nb_buckets; b++) {
+        if (nhg->owner[b] == idx)
+            nhg->owner[b] = NHG_NO_OWNER;
+        else if (nhg->owner[b] == last)
+            nhg->owner[b] = idx;
+    }
+    nhg->members[idx] = nhg->members[last];
+
+    nhg_rebalance(nhg);
+
+    return 0;
+}
+
+int
+cne_fib_nhg_member_set_state(struct cne_fib_nhg *nhg, uint64_t next_hop, bool up)
+{
+    uint32_t b;
+    int idx;
+
+    if (!nhg)
+        return -EINVAL;
+
+    idx = nhg_member_find(nhg, next_hop);
+    if (idx < 0)
+        return idx;
+
+    if (nhg->members[idx].up == up)
+        return 0;
+    nhg->members[idx].up = up;
+
+    if (!up) {
+        for (b = 0; b < nhg->nb_buckets; b++)
+            if (nhg->owner[b] == idx)
+                nhg->owner[b] = NHG_NO_OWNER;
+        nhg->members[idx].nb_buckets = 0;
+    }
+
+    nhg_rebalance(nhg);
+
+    return 0;
+}
+
+void
+cne_fib_nhg_dump(FILE *f, struct cne_fib_nhg *nhg)
+{
+    if (!f)
+        f = stdout;
+
+    if (!nhg) {
+        fprintf(f, "Nexthop group is NULL\n");
+        return;
+    }
+
+    fprintf(f, "Nexthop group %s\n", nhg->name);
+    fprintf(f, "  Buckets       = %u\n", nhg->nb_buckets);
+    fprintf(f, "  Default NH    = 0x%" PRIx64 "\n", nhg->default_nh);
+    fprintf(f, "  Members       = %u\n", nhg->nb_members);
+
+    for (int i = 0; i < nhg->nb_members; i++) {
+        struct cne_fib_nhg_member *m = &nhg->members[i];
+
+        fprintf(f, "    NH 0x%-10" PRIx64 " weight %5u buckets %5u %s\n", m->next_hop, m->weight,
+                m->nb_buckets, m->up ? "up" : "down");
+    }
+}
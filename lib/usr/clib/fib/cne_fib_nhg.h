@@ -0,0 +1,194 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CNE_FIB_NHG_H_
+#define _CNE_FIB_NHG_H_
+
+/**
+ * @file
+ *
+ * CNE FIB nexthop groups.
+ *
+ * A nexthop group spreads the traffic of a prefix over several equal cost paths
+ * (ECMP). The FIB entry of the prefix refers to the group, how the reference is
+ * encoded in the FIB next hop value is up to the user, and the group selects one
+ * member next hop from a hash of the packet flow.
+ *
+ * The flow hash indexes a table of buckets, each bucket holds the next hop of
+ * one member and the number of buckets given to a member is proportional to its
+ * weight. When a member goes down only its own buckets are handed to the other
+ * members, and when it comes back up it only takes buckets from members above
+ * their share, so the flows of the other members keep their path.
+ *
+ * The control functions must be serialized by the caller, cne_fib_nhg_select()
+ * can be called at the same time from any number of threads.
+ */
+
+#include <stdio.h>          // for FILE
+#include <stdint.h>         // for uint64_t, uint32_t, uint16_t
+#include <stdbool.h>        // for bool
+#include <netinet/in.h>     // for IPPROTO_TCP, IPPROTO_UDP
+#include <cne_common.h>
+#include <cne_jhash.h>        // for cne_jhash_3words
+#include <net/cne_ip.h>       // for cne_ipv4_hdr
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CNE_FIB_NHG_NAMESIZE    32   /**< Max size of a nexthop group name */
+#define CNE_FIB_NHG_MAX_MEMBERS 64   /**< Max number of members in a group */
+#define CNE_FIB_NHG_BUCKETS     512  /**< Default number of buckets */
+#define CNE_FIB_NHG_MAX_BUCKETS 65536 /**< Max number of buckets */
+#define CNE_FIB_NHG_HASH_SEED   0x5eed1e55 /**< Seed of the IPv4 flow hash */
+
+/** Nexthop group member */
+struct cne_fib_nhg_member {
+    uint64_t next_hop;   /**< Next hop returned for the flows of this member */
+    uint32_t weight;     /**< Relative weight of the member */
+    uint32_t nb_buckets; /**< Number of buckets owned by the member */
+    bool up;             /**< Member can be selected */
+};
+
+/** Nexthop group, the buckets are the only field used on the lookup path */
+struct cne_fib_nhg {
+    uint64_t *buckets;    /**< Next hop of each bucket */
+    uint32_t bucket_mask; /**< Number of buckets minus one */
+    uint32_t nb_buckets;  /**< Number of buckets, a power of 2 */
+    uint64_t default_nh;  /**< Next hop returned when no member is up */
+    uint16_t *owner;      /**< Member index owning each bucket */
+    uint16_t nb_members;  /**< Number of members */
+    char name[CNE_FIB_NHG_NAMESIZE];                       /**< Name of the group */
+    struct cne_fib_nhg_member members[CNE_FIB_NHG_MAX_MEMBERS]; /**< Group members */
+};
+
+/**
+ * Create a nexthop group.
+ *
+ * @param name
+ *   Name of the group.
+ * @param nb_buckets
+ *   Number of buckets, a power of 2 between CNE_FIB_NHG_MAX_MEMBERS and
+ *   CNE_FIB_NHG_MAX_BUCKETS, or 0 for CNE_FIB_NHG_BUCKETS. More buckets give a
+ *   closer match of the weights.
+ * @param default_nh
+ *   Next hop returned when the group has no member up, e.g. a drop next hop.
+ * @return
+ *   Pointer to the group or NULL on error.
+ */
+struct cne_fib_nhg *cne_fib_nhg_create(const char *name, uint32_t nb_buckets,
+                                       uint64_t default_nh);
+
+/**
+ * Free a nexthop group.
+ *
+ * @param nhg
+ *   Pointer to the group, can be NULL.
+ */
+void cne_fib_nhg_free(struct cne_fib_nhg *nhg);
+
+/**
+ * Add a member to the group in the up state, or change the weight of a member.
+ *
+ * @param nhg
+ *   Pointer to the group.
+ * @param next_hop
+ *   Next hop of the member.
+ * @param weight
+ *   Relative weight of the member, greater than 0.
+ * @return
+ *   0 on success, -EINVAL on invalid parameters or -ENOSPC if the group is full.
+ */
+int cne_fib_nhg_member_add(struct cne_fib_nhg *nhg, uint64_t next_hop, uint32_t weight);
+
+/**
+ * Remove a member from the group.
+ *
+ * @param nhg
+ *   Pointer to the group.
+ * @param next_hop
+ *   Next hop of the member.
+ * @return
+ *   0 on success, -EINVAL on invalid parameters or -ENOENT if not a member.
+ */
+int cne_fib_nhg_member_del(struct cne_fib_nhg *nhg, uint64_t next_hop);
+
+/**
+ * Mark a member up or down, e.g. when the link or the neighbor of the next hop
+ * changes state. Only the buckets of the member are moved.
+ *
+ * @param nhg
+ *   Pointer to the group.
+ * @param next_hop
+ *   Next hop of the member.
+ * @param up
+ *   True to mark the member up, false to mark it down.
+ * @return
+ *   0 on success, -EINVAL on invalid parameters or -ENOENT if not a member.
+ */
+int cne_fib_nhg_member_set_state(struct cne_fib_nhg *nhg, uint64_t next_hop, bool up);
+
+/**
+ * Dump the members and the bucket distribution of the group.
+ *
+ * @param f
+ *   File pointer or NULL for stdout.
+ * @param nhg
+ *   Pointer to the group.
+ */
+void cne_fib_nhg_dump(FILE *f, struct cne_fib_nhg *nhg);
+
+/**
+ * Select the next hop of a flow.
+ *
+ * The low bits of the RSS hash select the RX queue, all the flows of a queue
+ * have the same low bits. The high bits are folded into the low bits before
+ * masking, so the flows of each queue are spread over all the buckets.
+ *
+ * @param nhg
+ *   Pointer to the group.
+ * @param hash
+ *   Hash of the packet flow, e.g. pktmbuf_hash() or cne_fib_nhg_hash_ipv4().
+ * @return
+ *   Next hop of the member owning the flow, or the default next hop of the group.
+ */
+static inline uint64_t
+cne_fib_nhg_select(const struct cne_fib_nhg *nhg, uint32_t hash)
+{
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+
+    return __atomic_load_n(&nhg->buckets[hash & nhg->bucket_mask], __ATOMIC_RELAXED);
+}
+
+/**
+ * Hash the flow of an IPv4 packet, the addresses, the protocol and the TCP or
+ * UDP ports when the packet is not a fragment.
+ *
+ * @param ip
+ *   Pointer to the IPv4 header, the L4 header must follow in the same buffer.
+ * @return
+ *   The flow hash value.
+ */
+static inline uint32_t
+cne_fib_nhg_hash_ipv4(const struct cne_ipv4_hdr *ip)
+{
+    uint32_t l4 = ip->next_proto_id;
+
+    if ((ip->next_proto_id == IPPROTO_TCP || ip->next_proto_id == IPPROTO_UDP) &&
+        !(ip->fragment_offset & htobe16(CNE_IPV4_HDR_MF_FLAG | CNE_IPV4_HDR_OFFSET_MASK))) {
+        const uint8_t *l4_hdr = (const uint8_t *)ip + ((ip->version_ihl & CNE_IPV4_HDR_IHL_MASK) *
+                                                       CNE_IPV4_IHL_MULTIPLIER);
+
+        l4 ^= *(const uint32_t *)l4_hdr; /* Source and destination ports */
+    }
+
+    return cne_jhash_3words(ip->src_addr, ip->dst_addr, l4, CNE_FIB_NHG_HASH_SEED);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CNE_FIB_NHG_H_ */
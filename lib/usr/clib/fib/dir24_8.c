@@ -4,12 +4,16 @@
  */
 
 #include <stdint.h>         // for uint64_t, uint32_t, uint8_t, uint16_t, UINT64_MAX
-#include <stdlib.h>         // for free, calloc
+#include <stdlib.h>         // for free, calloc, qsort, realloc
+#include <stdbool.h>        // for bool, false, true
 #include <stdio.h>          // for NULL
+#include <string.h>         // for memset
 #include <cne_log.h>        // for CNE_ASSERT
 #include <cne_rib.h>        // for cne_rib_get_nh, cne_rib_get_nxt, cne_rib_depth_...
 #include <cne_fib.h>        // for cne_fib_conf, cne_fib_conf::(anonymous union)::...
 #include <errno.h>          // for ENOSPC, EINVAL, ENOENT
+#include <cne_cpuflags.h>        // for cne_cpu_get_flag_enabled, CNE_CPUFLAG_AVX2
+#include <cne_vect.h>            // for cne_vect_get_max_simd_bitwidth
 
 #include "dir24_8.h"
 
@@ -22,8 +26,17 @@ struct cne_rib;
 
 #endif /* CC_DIR24_8_AVX512_SUPPORT */
 
+#ifdef CC_DIR24_8_AVX2_SUPPORT
+
+#include "dir24_8_avx2.h"
+
+#endif /* CC_DIR24_8_AVX2_SUPPORT */
+
 #define DIR24_8_NAMESIZE 64
 
+/* Default max number of tbl8 groups freed on a defer queue reclaim */
+#define DIR24_8_RCU_DQ_RECLAIM_MAX 16
+
 #define ROUNDUP(x, y) CNE_ALIGN_CEIL(x, (1 << (32 - y)))
 
 static inline cne_fib_lookup_fn_t
@@ -86,6 +99,32 @@ get_vector_fn(enum cne_fib_dir24_8_nh_sz nh_sz)
     return NULL;
 }
 
+static inline cne_fib_lookup_fn_t
+get_vector_avx2_fn(enum cne_fib_dir24_8_nh_sz nh_sz)
+{
+#ifdef CC_DIR24_8_AVX2_SUPPORT
+    if ((cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX2) <= 0) ||
+        (cne_vect_get_max_simd_bitwidth() < CNE_VECT_SIMD_256))
+        return NULL;
+
+    switch (nh_sz) {
+    case CNE_FIB_DIR24_8_1B:
+        return cne_dir24_8_avx2_lookup_bulk_1b;
+    case CNE_FIB_DIR24_8_2B:
+        return cne_dir24_8_avx2_lookup_bulk_2b;
+    case CNE_FIB_DIR24_8_4B:
+        return cne_dir24_8_avx2_lookup_bulk_4b;
+    case CNE_FIB_DIR24_8_8B:
+        return cne_dir24_8_avx2_lookup_bulk_8b;
+    default:
+        return NULL;
+    }
+#else
+    CNE_SET_USED(nh_sz);
+#endif
+    return NULL;
+}
+
 cne_fib_lookup_fn_t
 dir24_8_get_lookup_fn(void *p, enum cne_fib_lookup_type type)
 {
@@ -107,8 +146,12 @@ dir24_8_get_lookup_fn(void *p, enum cne_fib_lookup_type type)
         return dir24_8_lookup_bulk_uni;
     case CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512:
         return get_vector_fn(nh_sz);
+    case CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2:
+        return get_vector_avx2_fn(nh_sz);
     case CNE_FIB_LOOKUP_DEFAULT:
         ret_fn = get_vector_fn(nh_sz);
+        if (ret_fn == NULL)
+            ret_fn = get_vector_avx2_fn(nh_sz);
         return (ret_fn != NULL) ? ret_fn : get_scalar_fn(nh_sz);
     default:
         return NULL;
@@ -147,7 +190,7 @@ write_to_fib(void *ptr, uint64_t val, enum cne_fib_dir24_8_nh_sz size, int n)
 }
 
 static int
-tbl8_get_idx(struct dir24_8_tbl *dp)
+__tbl8_get_idx(struct dir24_8_tbl *dp)
 {
     uint32_t i;
     int bit_idx;
@@ -164,12 +207,46 @@ tbl8_get_idx(struct dir24_8_tbl *dp)
     return -ENOSPC;
 }
 
+static int
+tbl8_get_idx(struct dir24_8_tbl *dp)
+{
+    int idx;
+
+    idx = __tbl8_get_idx(dp);
+
+    /* Released groups may be waiting for the readers, try to reclaim them */
+    if (idx == -ENOSPC && dp->dq != NULL &&
+        cne_rcu_qsbr_dq_reclaim(dp->dq, DIR24_8_RCU_DQ_RECLAIM_MAX, NULL, NULL, NULL) == 0)
+        idx = __tbl8_get_idx(dp);
+
+    return idx;
+}
+
 static inline void
 tbl8_free_idx(struct dir24_8_tbl *dp, int idx)
 {
     dp->tbl8_idxes[idx >> BITMAP_SLAB_BIT_SIZE_LOG2] &= ~(1ULL << (idx & BITMAP_SLAB_BITMASK));
 }
 
+static void
+tbl8_cleanup_and_free(struct dir24_8_tbl *dp, uint64_t tbl8_idx)
+{
+    uint8_t *ptr = (uint8_t *)dp->tbl8 + ((tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT) << dp->nh_sz);
+
+    memset(ptr, 0, DIR24_8_TBL8_GRP_NUM_ENT << dp->nh_sz);
+    tbl8_free_idx(dp, tbl8_idx);
+    dp->cur_tbl8s--;
+}
+
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __cne_unused)
+{
+    struct dir24_8_tbl *dp = p;
+    uint64_t tbl8_idx      = *(uint64_t *)data;
+
+    tbl8_cleanup_and_free(dp, tbl8_idx);
+}
+
 static int
 tbl8_alloc(struct dir24_8_tbl *dp, uint64_t nh)
 {
@@ -186,6 +263,25 @@ tbl8_alloc(struct dir24_8_tbl *dp, uint64_t nh)
     return tbl8_idx;
 }
 
+/*
+ * The group is no longer referenced by tbl24, but a reader could still be
+ * using it, it is cleared and reused only after the readers are done.
+ */
+static void
+tbl8_release(struct dir24_8_tbl *dp, uint64_t tbl8_idx)
+{
+    if (dp->v == NULL) {
+        tbl8_cleanup_and_free(dp, tbl8_idx);
+    } else if (dp->rcu_mode == CNE_FIB_QSBR_MODE_SYNC) {
+        cne_rcu_qsbr_synchronize(dp->v, CNE_QSBR_THRID_INVALID);
+        tbl8_cleanup_and_free(dp, tbl8_idx);
+    } else if (cne_rcu_qsbr_dq_enqueue(dp->dq, &tbl8_idx) != 0) {
+        /* Defer queue is full, wait for the readers instead */
+        cne_rcu_qsbr_synchronize(dp->v, CNE_QSBR_THRID_INVALID);
+        tbl8_cleanup_and_free(dp, tbl8_idx);
+    }
+}
+
 static void
 tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 {
@@ -205,8 +301,6 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint8_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr8[i] = 0;
         break;
     case CNE_FIB_DIR24_8_2B:
         ptr16 = &((uint16_t *)dp->tbl8)[tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT];
@@ -216,8 +310,6 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint16_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr16[i] = 0;
         break;
     case CNE_FIB_DIR24_8_4B:
         ptr32 = &((uint32_t *)dp->tbl8)[tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT];
@@ -227,8 +319,6 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint32_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr32[i] = 0;
         break;
     case CNE_FIB_DIR24_8_8B:
         ptr64 = &((uint64_t *)dp->tbl8)[tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT];
@@ -238,12 +328,10 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
                 return;
         }
         ((uint64_t *)dp->tbl24)[ip >> 8] = nh & ~DIR24_8_EXT_ENT;
-        for (i = 0; i < DIR24_8_TBL8_GRP_NUM_ENT; i++)
-            ptr64[i] = 0;
         break;
     }
-    tbl8_free_idx(dp, tbl8_idx);
-    dp->cur_tbl8s--;
+
+    tbl8_release(dp, tbl8_idx);
 }
 
 static int
@@ -452,6 +540,296 @@ dir24_8_modify(struct cne_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_ho
     return -EINVAL;
 }
 
+/* Route of a bulk request, idx keeps the request order for duplicates */
+struct bulk_route {
+    uint32_t ip;
+    uint8_t depth;
+    uint8_t changed;
+    uint32_t idx;
+    uint64_t nh;
+};
+
+/* Open prefix of the range sweep, end is exclusive and can be 1 << 32 */
+struct bulk_range {
+    uint64_t end;
+    uint64_t nh;
+};
+
+/* Leaf range waiting to be installed, merged with the next one on the same next hop */
+struct bulk_install {
+    struct dir24_8_tbl *dp;
+    uint64_t ledge;
+    uint64_t redge;
+    uint64_t nh;
+};
+
+static int
+bulk_route_cmp(const void *a, const void *b)
+{
+    const struct bulk_route *r1 = a;
+    const struct bulk_route *r2 = b;
+
+    if (r1->ip != r2->ip)
+        return (r1->ip < r2->ip) ? -1 : 1;
+    if (r1->depth != r2->depth)
+        return (r1->depth < r2->depth) ? -1 : 1;
+    if (r1->idx != r2->idx)
+        return (r1->idx < r2->idx) ? -1 : 1;
+    return 0;
+}
+
+/*
+ * Release the tbl8 groups of the full /24 blocks in [ledge, redge), the range is
+ * rewritten with a single next hop and install_to_fib() overwrites those tbl24
+ * entries without looking at them.
+ */
+static void
+tbl24_release_tbl8(struct dir24_8_tbl *dp, uint64_t ledge, uint64_t redge, uint64_t nh)
+{
+    uint64_t ip, tbl24_tmp;
+
+    for (ip = CNE_ALIGN_CEIL(ledge, 1ULL << 8); ip + (1ULL << 8) <= redge; ip += 1ULL << 8) {
+        tbl24_tmp = get_tbl24(dp, (uint32_t)ip, dp->nh_sz);
+        if ((tbl24_tmp & DIR24_8_EXT_ENT) != DIR24_8_EXT_ENT)
+            continue;
+        write_to_fib(get_tbl24_p(dp, (uint32_t)ip, dp->nh_sz), nh << 1, dp->nh_sz, 1);
+        tbl8_release(dp, tbl24_tmp >> 1);
+    }
+}
+
+static int
+bulk_install_flush(struct bulk_install *bi)
+{
+    if (bi->ledge == bi->redge)
+        return 0;
+
+    tbl24_release_tbl8(bi->dp, bi->ledge, bi->redge, bi->nh);
+
+    /* install_to_fib() takes (0, 0) as the full address space */
+    return install_to_fib(bi->dp, (uint32_t)bi->ledge, (uint32_t)bi->redge, bi->nh);
+}
+
+static int
+bulk_install_add(struct bulk_install *bi, uint64_t ledge, uint64_t redge, uint64_t nh)
+{
+    int ret;
+
+    if (ledge == redge)
+        return 0;
+
+    if (bi->redge == ledge && bi->nh == nh) {
+        bi->redge = redge;
+        return 0;
+    }
+
+    ret = bulk_install_flush(bi);
+    if (ret != 0)
+        return ret;
+
+    bi->ledge = ledge;
+    bi->redge = redge;
+    bi->nh    = nh;
+    return 0;
+}
+
+/* Next hop used by ip/depth when the prefix itself is not in the RIB */
+static uint64_t
+bulk_parent_nh(struct dir24_8_tbl *dp, struct cne_rib *rib, uint32_t ip, uint8_t depth)
+{
+    struct cne_rib_node *node;
+    uint64_t nh;
+
+    while (depth-- > 0) {
+        node = cne_rib_lookup_exact(rib, ip & cne_rib_depth_to_mask(depth), depth);
+        if (node != NULL) {
+            cne_rib_get_nh(node, &nh);
+            return nh;
+        }
+    }
+    return dp->def_nh;
+}
+
+/*
+ * Rewrite the range of ip/depth from the RIB in a single pass, the more specific
+ * routes are sorted and every leaf range is written once with its final next hop.
+ */
+static int
+bulk_rebuild(struct dir24_8_tbl *dp, struct cne_rib *rib, uint32_t ip, uint8_t depth)
+{
+    struct bulk_range stack[CNE_FIB_MAXDEPTH + 1];
+    struct bulk_install bi = {.dp = dp};
+    struct bulk_route *sub = NULL, *tmp_sub;
+    struct cne_rib_node *node;
+    uint32_t nb_sub = 0, sz_sub = 0, i;
+    uint64_t cur, end;
+    int top = 0, ret;
+
+    node = cne_rib_lookup_exact(rib, ip, depth);
+    if (node != NULL)
+        cne_rib_get_nh(node, &stack[0].nh);
+    else
+        stack[0].nh = bulk_parent_nh(dp, rib, ip, depth);
+    stack[0].end = (uint64_t)ip + (1ULL << (32 - depth));
+
+    node = NULL;
+    while ((node = cne_rib_get_nxt(rib, ip, depth, node, CNE_RIB_GET_NXT_ALL)) != NULL) {
+        if (nb_sub == sz_sub) {
+            sz_sub  = (sz_sub == 0) ? 64 : sz_sub * 2;
+            tmp_sub = realloc(sub, sz_sub * sizeof(*sub));
+            if (tmp_sub == NULL) {
+                free(sub);
+                return -ENOMEM;
+            }
+            sub = tmp_sub;
+        }
+        cne_rib_get_ip(node, &sub[nb_sub].ip);
+        cne_rib_get_depth(node, &sub[nb_sub].depth);
+        cne_rib_get_nh(node, &sub[nb_sub].nh);
+        sub[nb_sub].idx = nb_sub;
+        nb_sub++;
+    }
+    if (nb_sub > 1)
+        qsort(sub, nb_sub, sizeof(*sub), bulk_route_cmp);
+
+    /* A prefix only starts after its covering prefix, in sorted order it is nested */
+    cur = ip;
+    for (i = 0; i < nb_sub; i++) {
+        while (stack[top].end <= sub[i].ip) {
+            ret = bulk_install_add(&bi, cur, stack[top].end, stack[top].nh);
+            if (ret != 0)
+                goto out;
+            cur = stack[top--].end;
+        }
+        ret = bulk_install_add(&bi, cur, sub[i].ip, stack[top].nh);
+        if (ret != 0)
+            goto out;
+        cur = sub[i].ip;
+        end = (uint64_t)sub[i].ip + (1ULL << (32 - sub[i].depth));
+
+        stack[++top].end = end;
+        stack[top].nh    = sub[i].nh;
+    }
+    while (top >= 0) {
+        ret = bulk_install_add(&bi, cur, stack[top].end, stack[top].nh);
+        if (ret != 0)
+            goto out;
+        cur = stack[top--].end;
+    }
+    ret = bulk_install_flush(&bi);
+out:
+    free(sub);
+    return ret;
+}
+
+int
+dir24_8_modify_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n, int op)
+{
+    struct dir24_8_tbl *dp;
+    struct cne_rib *rib;
+    struct cne_rib_node *node, *tmp;
+    struct bulk_route *br;
+    uint32_t i, last_ip = 0;
+    uint8_t last_depth = 0;
+    uint64_t node_nh;
+    bool have_last = false;
+    int ret = 0, err;
+
+    if ((fib == NULL) || (routes == NULL && n != 0) || (op != CNE_FIB_ADD && op != CNE_FIB_DEL))
+        return -EINVAL;
+    if (n == 0)
+        return 0;
+
+    dp  = cne_fib_get_dp(fib);
+    rib = cne_fib_get_rib(fib);
+    CNE_ASSERT((dp != NULL) && (rib != NULL));
+
+    for (i = 0; i < n; i++) {
+        if ((routes[i].depth > CNE_FIB_MAXDEPTH) ||
+            ((op == CNE_FIB_ADD) && (routes[i].next_hop > get_max_nh(dp->nh_sz))))
+            return -EINVAL;
+    }
+
+    br = calloc(n, sizeof(*br));
+    if (br == NULL)
+        return -ENOMEM;
+
+    for (i = 0; i < n; i++) {
+        br[i].ip    = routes[i].ip & cne_rib_depth_to_mask(routes[i].depth);
+        br[i].depth = routes[i].depth;
+        br[i].nh    = routes[i].next_hop;
+        br[i].idx   = i;
+    }
+    qsort(br, n, sizeof(*br), bulk_route_cmp);
+
+    /* Update the RIB first, the last entry of a duplicated prefix wins */
+    for (i = 0; i < n; i++) {
+        if ((i + 1 < n) && (br[i + 1].ip == br[i].ip) && (br[i + 1].depth == br[i].depth))
+            continue;
+
+        node = cne_rib_lookup_exact(rib, br[i].ip, br[i].depth);
+        if (op == CNE_FIB_ADD) {
+            if (node != NULL) {
+                cne_rib_get_nh(node, &node_nh);
+                if (node_nh != br[i].nh) {
+                    cne_rib_set_nh(node, br[i].nh);
+                    br[i].changed = 1;
+                }
+                continue;
+            }
+            tmp = NULL;
+            if (br[i].depth > 24) {
+                tmp = cne_rib_get_nxt(rib, br[i].ip, 24, NULL, CNE_RIB_GET_NXT_COVER);
+                if ((tmp == NULL) && (dp->rsvd_tbl8s >= dp->number_tbl8s)) {
+                    ret = -ENOSPC;
+                    break;
+                }
+            }
+            node = cne_rib_insert(rib, br[i].ip, br[i].depth);
+            if (node == NULL) {
+                ret = -ENOSPC;
+                break;
+            }
+            cne_rib_set_nh(node, br[i].nh);
+            if ((br[i].depth > 24) && (tmp == NULL))
+                dp->rsvd_tbl8s++;
+        } else {
+            if (node == NULL)
+                continue;
+            cne_rib_remove(rib, br[i].ip, br[i].depth);
+            if (br[i].depth > 24) {
+                tmp = cne_rib_get_nxt(rib, br[i].ip, 24, NULL, CNE_RIB_GET_NXT_COVER);
+                if (tmp == NULL)
+                    dp->rsvd_tbl8s--;
+            }
+        }
+        br[i].changed = 1;
+    }
+
+    /*
+     * Rebuild every changed prefix not covered by one already rebuilt, in sorted
+     * order a covering prefix comes before all the prefixes it covers.
+     */
+    for (i = 0; i < n; i++) {
+        if (!br[i].changed)
+            continue;
+        if (have_last && (br[i].depth >= last_depth) &&
+            ((br[i].ip & cne_rib_depth_to_mask(last_depth)) == last_ip))
+            continue;
+
+        err = bulk_rebuild(dp, rib, br[i].ip, br[i].depth);
+        if (err != 0) {
+            ret = err;
+            break;
+        }
+        last_ip    = br[i].ip;
+        last_depth = br[i].depth;
+        have_last  = true;
+    }
+
+    free(br);
+    return ret;
+}
+
 void *
 dir24_8_create(struct cne_fib_conf *fib_conf)
 {
@@ -503,7 +881,54 @@ dir24_8_free(void *p)
 {
     struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
 
+    cne_rcu_qsbr_dq_delete(dp->dq);
     free(dp->tbl8_idxes);
     free(dp->tbl8);
     free(dp);
 }
+
+int
+dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct cne_fib_rcu_config *cfg, const char *name)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    char rcu_dq_name[CNE_RCU_QSBR_NAMESIZE];
+
+    if (dp == NULL || cfg == NULL || cfg->v == NULL)
+        return -EINVAL;
+
+    if (dp->v != NULL)
+        return -EEXIST;
+
+    switch (cfg->mode) {
+    case CNE_FIB_QSBR_MODE_DQ:
+        /* Init QSBR defer queue. */
+        snprintf(rcu_dq_name, sizeof(rcu_dq_name), "FIB_RCU_%s", name);
+        params.name                  = rcu_dq_name;
+        params.size                  = cfg->dq_size ? cfg->dq_size : dp->number_tbl8s;
+        params.trigger_reclaim_limit = cfg->reclaim_thd;
+        params.max_reclaim_size      = cfg->reclaim_max ? cfg->reclaim_max
+                                                        : DIR24_8_RCU_DQ_RECLAIM_MAX;
+        params.esize                 = sizeof(uint64_t);
+        params.free_fn               = __rcu_qsbr_free_resource;
+        params.p                     = dp;
+        params.v                     = cfg->v;
+
+        /* Route updates are serialized by the caller, no lock is needed */
+        params.flags = CNE_RCU_QSBR_DQ_MT_UNSAFE;
+
+        dp->dq = cne_rcu_qsbr_dq_create(&params);
+        if (dp->dq == NULL)
+            CNE_ERR_RET_VAL(-ENOMEM, "FIB defer queue creation failed\n");
+        break;
+    case CNE_FIB_QSBR_MODE_SYNC:
+        /* No other things to do. */
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    dp->rcu_mode = cfg->mode;
+    dp->v        = cfg->v;
+
+    return 0;
+}
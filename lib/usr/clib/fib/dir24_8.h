@@ -8,6 +8,7 @@
 
 #include <cne_prefetch.h>                 // for cne_prefetch0
 #include <cne_branch_prediction.h>        // for unlikely
+#include <cne_rcu_qsbr.h>                 // for cne_rcu_qsbr, cne_rcu_qsbr_dq
 #include <stdint.h>                       // for uint32_t, uint64_t, uint8_t, uint...
 
 #include "cne_common.h"        // for CNE_MIN, __cne_cache_aligned
@@ -41,6 +42,9 @@ struct dir24_8_tbl {
     uint64_t def_nh;                  /**< Default next hop */
     uint64_t *tbl8;                   /**< tbl8 table. */
     uint64_t *tbl8_idxes;             /**< bitmap containing free tbl8 idxes*/
+    struct cne_rcu_qsbr *v;           /**< RCU QSBR variable or NULL */
+    enum cne_fib_qsbr_mode rcu_mode;  /**< Blocking or defer queue mode */
+    struct cne_rcu_qsbr_dq *dq;       /**< RCU QSBR defer queue of tbl8 groups */
     /* tbl24 table. */
     __extension__ uint64_t tbl24[0] __cne_cache_aligned;
 };
@@ -243,6 +247,12 @@ cne_fib_lookup_fn_t dir24_8_get_lookup_fn(void *p, enum cne_fib_lookup_type type
 
 int dir24_8_modify(struct cne_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_hop, int op);
 
+int dir24_8_modify_bulk(struct cne_fib *fib, const struct cne_fib_route *routes, uint32_t n,
+                        int op);
+
+int dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct cne_fib_rcu_config *cfg,
+                         const char *name);
+
 #ifdef __cplusplus
 }
 #endif
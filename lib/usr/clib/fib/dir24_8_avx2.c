@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <immintrin.h>        // for __m256i, _mm256_i32gather_epi32, _mm256_mask_i32ga...
+
+#include "dir24_8.h"        // for dir24_8_tbl, dir24_8_lookup_bulk_1b, dir24_8...
+#include "dir24_8_avx2.h"
+#include "cne_common.h"        // for __cne_always_inline
+
+/*
+ * Lookup 8 addresses for 1, 2 and 4 byte next hops. The tbl24 entries are
+ * gathered with a 32-bit load at the entry offset and masked down to the entry
+ * size, entries with the extended bit set are resolved with a masked gather from
+ * tbl8, all other lanes keep the tbl24 value.
+ */
+static __cne_always_inline void
+dir24_8_avx2_lookup_x8(void *p, const uint32_t *ips, uint64_t *next_hops, int size)
+{
+    struct dir24_8_tbl *dp   = (struct dir24_8_tbl *)p;
+    const __m256i zero       = _mm256_setzero_si256();
+    const __m256i lsb        = _mm256_set1_epi32(1);
+    const __m256i lsbyte_msk = _mm256_set1_epi32(0xff);
+    __m256i ip_vec, idxes, res, ext, res_msk;
+
+    /* used to mask gather values if size is 1/2 (8/16 bit next hops) */
+    if (size == sizeof(uint8_t))
+        res_msk = _mm256_set1_epi32(UINT8_MAX);
+    else if (size == sizeof(uint16_t))
+        res_msk = _mm256_set1_epi32(UINT16_MAX);
+    else
+        res_msk = _mm256_set1_epi32(-1);
+
+    ip_vec = _mm256_loadu_si256((const __m256i *)ips);
+    /* mask 24 most significant bits */
+    idxes = _mm256_srli_epi32(ip_vec, 8);
+
+    /**
+     * lookup in tbl24
+     * Put it inside branch to make compiler happy with -O0
+     */
+    if (size == sizeof(uint8_t))
+        res = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes, 1);
+    else if (size == sizeof(uint16_t))
+        res = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes, 2);
+    else
+        res = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes, 4);
+    res = _mm256_and_si256(res, res_msk);
+
+    /* get extended entries indexes */
+    ext = _mm256_cmpeq_epi32(_mm256_and_si256(res, lsb), lsb);
+
+    if (!_mm256_testz_si256(ext, ext)) {
+        idxes = _mm256_srli_epi32(res, 1);
+        idxes = _mm256_slli_epi32(idxes, 8);
+        idxes = _mm256_add_epi32(idxes, _mm256_and_si256(ip_vec, lsbyte_msk));
+        if (size == sizeof(uint8_t))
+            idxes = _mm256_mask_i32gather_epi32(zero, (const int *)dp->tbl8, idxes, ext, 1);
+        else if (size == sizeof(uint16_t))
+            idxes = _mm256_mask_i32gather_epi32(zero, (const int *)dp->tbl8, idxes, ext, 2);
+        else
+            idxes = _mm256_mask_i32gather_epi32(zero, (const int *)dp->tbl8, idxes, ext, 4);
+        idxes = _mm256_and_si256(idxes, res_msk);
+
+        res = _mm256_blendv_epi8(res, idxes, ext);
+    }
+
+    res = _mm256_srli_epi32(res, 1);
+    _mm256_storeu_si256((__m256i *)next_hops,
+                        _mm256_cvtepu32_epi64(_mm256_castsi256_si128(res)));
+    _mm256_storeu_si256((__m256i *)(next_hops + 4),
+                        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(res, 1)));
+}
+
+/* Lookup 4 addresses for 8 byte next hops */
+static __cne_always_inline void
+dir24_8_avx2_lookup_x4_8b(void *p, const uint32_t *ips, uint64_t *next_hops)
+{
+    struct dir24_8_tbl *dp   = (struct dir24_8_tbl *)p;
+    const __m256i zero       = _mm256_setzero_si256();
+    const __m256i lsb        = _mm256_set1_epi64x(1);
+    const __m128i lsbyte_msk = _mm_set1_epi32(0xff);
+    __m256i res, idxes, ext;
+    __m128i ip_vec;
+
+    ip_vec = _mm_loadu_si128((const __m128i *)ips);
+
+    /* lookup in tbl24 */
+    res = _mm256_i32gather_epi64((const long long *)dp->tbl24, _mm_srli_epi32(ip_vec, 8), 8);
+
+    /* get extended entries indexes */
+    ext = _mm256_cmpeq_epi64(_mm256_and_si256(res, lsb), lsb);
+
+    if (!_mm256_testz_si256(ext, ext)) {
+        idxes = _mm256_srli_epi64(res, 1);
+        idxes = _mm256_slli_epi64(idxes, 8);
+        idxes = _mm256_add_epi64(idxes,
+                                 _mm256_cvtepu32_epi64(_mm_and_si128(ip_vec, lsbyte_msk)));
+        idxes = _mm256_mask_i64gather_epi64(zero, (const long long *)dp->tbl8, idxes, ext, 8);
+
+        res = _mm256_blendv_epi8(res, idxes, ext);
+    }
+
+    res = _mm256_srli_epi64(res, 1);
+    _mm256_storeu_si256((__m256i *)next_hops, res);
+}
+
+void
+cne_dir24_8_avx2_lookup_bulk_1b(void *p, const uint32_t *ips, uint64_t *next_hops,
+                                const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 8); i++)
+        dir24_8_avx2_lookup_x8(p, ips + i * 8, next_hops + i * 8, sizeof(uint8_t));
+
+    dir24_8_lookup_bulk_1b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
+
+void
+cne_dir24_8_avx2_lookup_bulk_2b(void *p, const uint32_t *ips, uint64_t *next_hops,
+                                const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 8); i++)
+        dir24_8_avx2_lookup_x8(p, ips + i * 8, next_hops + i * 8, sizeof(uint16_t));
+
+    dir24_8_lookup_bulk_2b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
+
+void
+cne_dir24_8_avx2_lookup_bulk_4b(void *p, const uint32_t *ips, uint64_t *next_hops,
+                                const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 8); i++)
+        dir24_8_avx2_lookup_x8(p, ips + i * 8, next_hops + i * 8, sizeof(uint32_t));
+
+    dir24_8_lookup_bulk_4b(p, ips + i * 8, next_hops + i * 8, n - i * 8);
+}
+
+void
+cne_dir24_8_avx2_lookup_bulk_8b(void *p, const uint32_t *ips, uint64_t *next_hops,
+                                const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 4); i++)
+        dir24_8_avx2_lookup_x4_8b(p, ips + i * 4, next_hops + i * 4);
+
+    dir24_8_lookup_bulk_8b(p, ips + i * 4, next_hops + i * 4, n - i * 4);
+}
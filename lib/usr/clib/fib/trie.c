@@ -4,6 +4,7 @@
  */
 
 #include <stdint.h>              // for uint8_t, uint64_t, uint32_t, uint...
+#include <stdbool.h>             // for bool, false, true
 #include <stdlib.h>              // for free, calloc
 #include <stdio.h>               // for NULL
 #include <cne_log.h>             // for CNE_ASSERT
@@ -11,6 +12,8 @@
 #include "private_fib6.h"        // for CNE_FIB6_IPV6_ADDR_SIZE, cne_fib6...
 #include <cne_fib6.h>            // for cne_fib6_conf, cne_fib6_conf::(an...
 #include <errno.h>               // for EINVAL, ENOSPC, ENOENT
+#include <cne_cpuflags.h>        // for cne_cpu_get_flag_enabled, CNE_CPUFLAG_AVX2
+#include <cne_vect.h>            // for cne_vect_get_max_simd_bitwidth
 
 #include "trie.h"
 #include "cne_branch_prediction.h"        // for unlikely
@@ -24,6 +27,12 @@ struct cne_rib6;
 
 #endif /* CC_TRIE_AVX512_SUPPORT */
 
+#ifdef CC_TRIE_AVX2_SUPPORT
+
+#include "trie_avx2.h"
+
+#endif /* CC_TRIE_AVX2_SUPPORT */
+
 #define TRIE_NAMESIZE 64
 
 enum edge { LEDGE, REDGE };
@@ -66,6 +75,30 @@ get_vector_fn(enum cne_fib_trie_nh_sz nh_sz)
     return NULL;
 }
 
+static inline cne_fib6_lookup_fn_t
+get_vector_avx2_fn(enum cne_fib_trie_nh_sz nh_sz)
+{
+#ifdef CC_TRIE_AVX2_SUPPORT
+    if ((cne_cpu_get_flag_enabled(CNE_CPUFLAG_AVX2) <= 0) ||
+        (cne_vect_get_max_simd_bitwidth() < CNE_VECT_SIMD_256))
+        return NULL;
+
+    switch (nh_sz) {
+    case CNE_FIB6_TRIE_2B:
+        return cne_trie_avx2_lookup_bulk_2b;
+    case CNE_FIB6_TRIE_4B:
+        return cne_trie_avx2_lookup_bulk_4b;
+    case CNE_FIB6_TRIE_8B:
+        return cne_trie_avx2_lookup_bulk_8b;
+    default:
+        return NULL;
+    }
+#else
+    CNE_SET_USED(nh_sz);
+#endif
+    return NULL;
+}
+
 cne_fib6_lookup_fn_t
 trie_get_lookup_fn(void *p, enum cne_fib6_lookup_type type)
 {
@@ -83,8 +116,12 @@ trie_get_lookup_fn(void *p, enum cne_fib6_lookup_type type)
         return get_scalar_fn(nh_sz);
     case CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX512:
         return get_vector_fn(nh_sz);
+    case CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX2:
+        return get_vector_avx2_fn(nh_sz);
     case CNE_FIB6_LOOKUP_DEFAULT:
         ret_fn = get_vector_fn(nh_sz);
+        if (ret_fn == NULL)
+            ret_fn = get_vector_avx2_fn(nh_sz);
         return (ret_fn != NULL) ? ret_fn : get_scalar_fn(nh_sz);
     default:
         return NULL;
@@ -442,6 +479,7 @@ modify_dp(struct cne_trie_tbl *dp, struct cne_rib6 *rib, const uint8_t ip[CNE_FI
     struct cne_rib6_node *tmp = NULL;
     uint8_t ledge[CNE_FIB6_IPV6_ADDR_SIZE];
     uint8_t redge[CNE_FIB6_IPV6_ADDR_SIZE];
+    bool advanced = false;
     int ret;
     uint8_t tmp_depth;
 
@@ -456,6 +494,7 @@ modify_dp(struct cne_trie_tbl *dp, struct cne_rib6 *rib, const uint8_t ip[CNE_FI
             if (tmp_depth == depth)
                 continue;
             cne_rib6_get_ip(tmp, redge);
+            advanced = true;
             if (cne_rib6_is_equal(ledge, redge)) {
                 get_nxt_net(ledge, tmp_depth);
                 continue;
@@ -468,7 +507,11 @@ modify_dp(struct cne_trie_tbl *dp, struct cne_rib6 *rib, const uint8_t ip[CNE_FI
         } else {
             cne_rib6_copy_addr(redge, ip);
             get_nxt_net(redge, depth);
-            if (cne_rib6_is_equal(ledge, redge))
+            /*
+             * The next net of the default route wraps around to ip, the whole
+             * range is left to install unless ledge wrapped past the last subnet
+             */
+            if (cne_rib6_is_equal(ledge, redge) && (depth != 0 || advanced))
                 break;
             ret = install_to_dp(dp, ledge, redge, next_hop);
             if (ret != 0)
@@ -0,0 +1,267 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <immintrin.h>        // for __m256i, _mm256_i32gather_epi32, _mm256_mask_i32ga...
+
+#include "private_fib6.h"        // for CNE_FIB6_IPV6_ADDR_SIZE
+#include "trie.h"                // for cne_trie_tbl, cne_trie_lookup_bulk_2b, cne...
+#include "trie_avx2.h"
+#include "cne_common.h"        // for __cne_always_inline
+
+/*
+ * Transpose 8 addresses into four vectors of 4 byte chunks, lane i of chunk[k]
+ * holds bytes 4k to 4k + 3 of ips[i].
+ */
+static __cne_always_inline void
+transpose_x8(uint8_t ips[8][CNE_FIB6_IPV6_ADDR_SIZE], __m256i chunk[4])
+{
+    __m256i r0, r1, r2, r3, t0, t1, t2, t3;
+
+    r0 = _mm256_loadu2_m128i((const __m128i *)ips[4], (const __m128i *)ips[0]);
+    r1 = _mm256_loadu2_m128i((const __m128i *)ips[5], (const __m128i *)ips[1]);
+    r2 = _mm256_loadu2_m128i((const __m128i *)ips[6], (const __m128i *)ips[2]);
+    r3 = _mm256_loadu2_m128i((const __m128i *)ips[7], (const __m128i *)ips[3]);
+
+    t0 = _mm256_unpacklo_epi32(r0, r1);
+    t1 = _mm256_unpackhi_epi32(r0, r1);
+    t2 = _mm256_unpacklo_epi32(r2, r3);
+    t3 = _mm256_unpackhi_epi32(r2, r3);
+
+    chunk[0] = _mm256_unpacklo_epi64(t0, t2);
+    chunk[1] = _mm256_unpackhi_epi64(t0, t2);
+    chunk[2] = _mm256_unpacklo_epi64(t1, t3);
+    chunk[3] = _mm256_unpackhi_epi64(t1, t3);
+}
+
+/* Transpose 4 addresses into two vectors of 8 byte chunks */
+static __cne_always_inline void
+transpose_x4(uint8_t ips[4][CNE_FIB6_IPV6_ADDR_SIZE], __m256i chunk[2])
+{
+    __m256i r0, r1;
+
+    r0 = _mm256_loadu2_m128i((const __m128i *)ips[2], (const __m128i *)ips[0]);
+    r1 = _mm256_loadu2_m128i((const __m128i *)ips[3], (const __m128i *)ips[1]);
+
+    chunk[0] = _mm256_unpacklo_epi64(r0, r1);
+    chunk[1] = _mm256_unpackhi_epi64(r0, r1);
+}
+
+/* Byte 'byte' of the addresses in 32-bit lanes */
+static __cne_always_inline __m256i
+get_byte_x8(const __m256i chunk[4], int byte)
+{
+    const __m256i lsbyte_msk = _mm256_set1_epi32(0xff);
+
+    return _mm256_and_si256(_mm256_srl_epi32(chunk[byte >> 2], _mm_cvtsi32_si128((byte & 3) * 8)),
+                            lsbyte_msk);
+}
+
+/* Byte 'byte' of the addresses in 64-bit lanes */
+static __cne_always_inline __m256i
+get_byte_x4(const __m256i chunk[2], int byte)
+{
+    const __m256i lsbyte_msk = _mm256_set1_epi64x(0xff);
+
+    return _mm256_and_si256(_mm256_srl_epi64(chunk[byte >> 3], _mm_cvtsi32_si128((byte & 7) * 8)),
+                            lsbyte_msk);
+}
+
+/*
+ * Walk one trie level for the lanes still pointing to a tbl8 group. Lanes
+ * leaving the walk keep their value in res, lanes going further down keep the
+ * extended value until the next level.
+ */
+static __cne_always_inline __m256i
+trie_avx2_level_x8(struct cne_trie_tbl *dp, __m256i *res, __m256i ext, __m256i bytes, int size)
+{
+    const __m256i zero    = _mm256_setzero_si256();
+    const __m256i lsb     = _mm256_set1_epi32(1);
+    const __m256i res_msk = _mm256_set1_epi32(UINT16_MAX);
+    __m256i idxes, val;
+
+    idxes = _mm256_slli_epi32(_mm256_srli_epi32(*res, 1), 8);
+    idxes = _mm256_add_epi32(idxes, bytes);
+
+    if (size == sizeof(uint16_t)) {
+        val = _mm256_mask_i32gather_epi32(zero, (const int *)dp->tbl8, idxes, ext, 2);
+        val = _mm256_and_si256(val, res_msk);
+    } else
+        val = _mm256_mask_i32gather_epi32(zero, (const int *)dp->tbl8, idxes, ext, 4);
+
+    *res = _mm256_blendv_epi8(*res, val, ext);
+
+    return _mm256_cmpeq_epi32(_mm256_and_si256(val, lsb), lsb);
+}
+
+static __cne_always_inline void
+trie_avx2_store_x8(__m256i res, uint64_t *next_hops)
+{
+    /* get rid of the extended bit and widen the next hops to 64 bits */
+    res = _mm256_srli_epi32(res, 1);
+    _mm256_storeu_si256((__m256i *)next_hops, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(res)));
+    _mm256_storeu_si256((__m256i *)(next_hops + 4),
+                        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(res, 1)));
+}
+
+/*
+ * Lookup 16 addresses for 2 and 4 byte next hops, as two groups of 8 so the
+ * tbl8 gathers of one group overlap with the memory accesses of the other.
+ * All the lanes walk the levels in step, a lane still extended at level i
+ * always indexes its tbl8 group with byte i of its address.
+ */
+static __cne_always_inline void
+trie_avx2_lookup_x8x2(void *p, uint8_t ips[16][CNE_FIB6_IPV6_ADDR_SIZE], uint64_t *next_hops,
+                      int size)
+{
+    struct cne_trie_tbl *dp = (struct cne_trie_tbl *)p;
+    const __m256i lsb       = _mm256_set1_epi32(1);
+    const __m256i res_msk   = _mm256_set1_epi32(UINT16_MAX);
+    /* get_tbl24_idx() for every first 4 byte chunk */
+    const __m256i bswap = _mm256_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1,
+                                           2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1);
+    __m256i chunk_1[4], chunk_2[4];
+    __m256i idxes_1, res_1, ext_1;
+    __m256i idxes_2, res_2, ext_2;
+    int i = 3;
+
+    transpose_x8(ips, chunk_1);
+    transpose_x8(ips + 8, chunk_2);
+
+    idxes_1 = _mm256_shuffle_epi8(chunk_1[0], bswap);
+    idxes_2 = _mm256_shuffle_epi8(chunk_2[0], bswap);
+
+    /**
+     * lookup in tbl24
+     * Put it inside branch to make compiler happy with -O0
+     */
+    if (size == sizeof(uint16_t)) {
+        res_1 = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes_1, 2);
+        res_2 = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes_2, 2);
+        res_1 = _mm256_and_si256(res_1, res_msk);
+        res_2 = _mm256_and_si256(res_2, res_msk);
+    } else {
+        res_1 = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes_1, 4);
+        res_2 = _mm256_i32gather_epi32((const int *)dp->tbl24, idxes_2, 4);
+    }
+
+    /* get extended entries indexes */
+    ext_1 = _mm256_cmpeq_epi32(_mm256_and_si256(res_1, lsb), lsb);
+    ext_2 = _mm256_cmpeq_epi32(_mm256_and_si256(res_2, lsb), lsb);
+
+    /* traverse down the trie */
+    while (i < CNE_FIB6_IPV6_ADDR_SIZE) {
+        int more_1 = !_mm256_testz_si256(ext_1, ext_1);
+        int more_2 = !_mm256_testz_si256(ext_2, ext_2);
+
+        if (!more_1 && !more_2)
+            break;
+        if (more_1)
+            ext_1 = trie_avx2_level_x8(dp, &res_1, ext_1, get_byte_x8(chunk_1, i), size);
+        if (more_2)
+            ext_2 = trie_avx2_level_x8(dp, &res_2, ext_2, get_byte_x8(chunk_2, i), size);
+        i++;
+    }
+
+    trie_avx2_store_x8(res_1, next_hops);
+    trie_avx2_store_x8(res_2, next_hops + 8);
+}
+
+/* Walk one trie level for 8 byte next hops, see trie_avx2_level_x8() */
+static __cne_always_inline __m256i
+trie_avx2_level_x4_8b(struct cne_trie_tbl *dp, __m256i *res, __m256i ext, __m256i bytes)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lsb  = _mm256_set1_epi64x(1);
+    __m256i idxes, val;
+
+    idxes = _mm256_slli_epi64(_mm256_srli_epi64(*res, 1), 8);
+    idxes = _mm256_add_epi64(idxes, bytes);
+
+    val = _mm256_mask_i64gather_epi64(zero, (const long long *)dp->tbl8, idxes, ext, 8);
+
+    *res = _mm256_blendv_epi8(*res, val, ext);
+
+    return _mm256_cmpeq_epi64(_mm256_and_si256(val, lsb), lsb);
+}
+
+/* Lookup 8 addresses for 8 byte next hops, as two groups of 4 */
+static __cne_always_inline void
+trie_avx2_lookup_x4x2_8b(void *p, uint8_t ips[8][CNE_FIB6_IPV6_ADDR_SIZE], uint64_t *next_hops)
+{
+    struct cne_trie_tbl *dp = (struct cne_trie_tbl *)p;
+    const __m256i lsb       = _mm256_set1_epi64x(1);
+    const __m256i bswap     = _mm256_setr_epi8(2, 1, 0, -1, -1, -1, -1, -1, 10, 9, 8, -1, -1, -1,
+                                               -1, -1, 2, 1, 0, -1, -1, -1, -1, -1, 10, 9, 8, -1,
+                                               -1, -1, -1, -1);
+    __m256i chunk_1[2], chunk_2[2];
+    __m256i idxes_1, res_1, ext_1;
+    __m256i idxes_2, res_2, ext_2;
+    int i = 3;
+
+    transpose_x4(ips, chunk_1);
+    transpose_x4(ips + 4, chunk_2);
+
+    idxes_1 = _mm256_shuffle_epi8(chunk_1[0], bswap);
+    idxes_2 = _mm256_shuffle_epi8(chunk_2[0], bswap);
+
+    /* lookup in tbl24 */
+    res_1 = _mm256_i64gather_epi64((const long long *)dp->tbl24, idxes_1, 8);
+    res_2 = _mm256_i64gather_epi64((const long long *)dp->tbl24, idxes_2, 8);
+
+    /* get extended entries indexes */
+    ext_1 = _mm256_cmpeq_epi64(_mm256_and_si256(res_1, lsb), lsb);
+    ext_2 = _mm256_cmpeq_epi64(_mm256_and_si256(res_2, lsb), lsb);
+
+    /* traverse down the trie */
+    while (i < CNE_FIB6_IPV6_ADDR_SIZE) {
+        int more_1 = !_mm256_testz_si256(ext_1, ext_1);
+        int more_2 = !_mm256_testz_si256(ext_2, ext_2);
+
+        if (!more_1 && !more_2)
+            break;
+        if (more_1)
+            ext_1 = trie_avx2_level_x4_8b(dp, &res_1, ext_1, get_byte_x4(chunk_1, i));
+        if (more_2)
+            ext_2 = trie_avx2_level_x4_8b(dp, &res_2, ext_2, get_byte_x4(chunk_2, i));
+        i++;
+    }
+
+    _mm256_storeu_si256((__m256i *)next_hops, _mm256_srli_epi64(res_1, 1));
+    _mm256_storeu_si256((__m256i *)(next_hops + 4), _mm256_srli_epi64(res_2, 1));
+}
+
+void
+cne_trie_avx2_lookup_bulk_2b(void *p, uint8_t ips[][CNE_FIB6_IPV6_ADDR_SIZE], uint64_t *next_hops,
+                             const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 16); i++)
+        trie_avx2_lookup_x8x2(p, (uint8_t(*)[16]) & ips[i * 16][0], next_hops + i * 16,
+                              sizeof(uint16_t));
+
+    cne_trie_lookup_bulk_2b(p, (uint8_t(*)[16]) & ips[i * 16][0], next_hops + i * 16, n - i * 16);
+}
+
+void
+cne_trie_avx2_lookup_bulk_4b(void *p, uint8_t ips[][CNE_FIB6_IPV6_ADDR_SIZE], uint64_t *next_hops,
+                             const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 16); i++)
+        trie_avx2_lookup_x8x2(p, (uint8_t(*)[16]) & ips[i * 16][0], next_hops + i * 16,
+                              sizeof(uint32_t));
+
+    cne_trie_lookup_bulk_4b(p, (uint8_t(*)[16]) & ips[i * 16][0], next_hops + i * 16, n - i * 16);
+}
+
+void
+cne_trie_avx2_lookup_bulk_8b(void *p, uint8_t ips[][CNE_FIB6_IPV6_ADDR_SIZE], uint64_t *next_hops,
+                             const unsigned int n)
+{
+    uint32_t i;
+    for (i = 0; i < (n / 8); i++)
+        trie_avx2_lookup_x4x2_8b(p, (uint8_t(*)[16]) & ips[i * 8][0], next_hops + i * 8);
+
+    cne_trie_lookup_bulk_8b(p, (uint8_t(*)[16]) & ips[i * 8][0], next_hops + i * 8, n - i * 8);
+}
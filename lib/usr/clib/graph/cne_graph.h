@@ -64,11 +64,31 @@ typedef uint16_t cne_graph_t;     /**< Graph id type. */
 #error "Unsupported burst size"
 #endif
 
+/**
+ * Buckets of the cycles per object histogram of a node, bucket 0 counts the
+ * calls below 2 cycles per object, bucket i the calls in [2^i, 2^(i+1)) and the
+ * last bucket all the calls above.
+ */
+#define CNE_GRAPH_STATS_CPO_BUCKETS 16
+
+/**
+ * Buckets of the burst size histogram of a node, bucket 0 counts the calls
+ * with no object, bucket i the calls with [2^(i-1), 2^i) objects and the last
+ * bucket all the calls above.
+ */
+#define CNE_GRAPH_STATS_BURST_BUCKETS (CNE_GRAPH_BURST_SIZE_LOG2 + 2)
+
+#define CNE_GRAPH_STATS_SAMPLE_PERIOD 1 /**< Default sampling period of the node cycles. */
+
 /* Forward declaration */
 struct cne_node;                     /**< Node object */
 struct cne_graph;                    /**< Graph object */
 struct cne_graph_cluster_stats;      /**< Stats for Cluster of graphs */
 struct cne_graph_cluster_node_stats; /**< Node stats within cluster of graphs */
+struct cne_rcu_qsbr;                 /**< RCU QSBR variable */
+struct cne_ring;                     /**< Work queue of a dispatch worker */
+struct cne_graph_trace;              /**< Packet tracer of a graph */
+struct cne_graph_feature_arc;        /**< Features between two nodes */
 
 /**
  * Node process function.
@@ -177,6 +197,14 @@ struct cne_graph_cluster_node_stats {
 
     uint64_t realloc_count; /**< Realloc count. */
 
+    uint64_t sampled_calls;      /**< Current number of calls with cycles accounted. */
+    uint64_t sampled_objs;       /**< Current number of objs of the sampled calls. */
+    uint64_t prev_sampled_calls; /**< Previous number of sampled calls. */
+    uint64_t prev_sampled_objs;  /**< Previous number of objs of the sampled calls. */
+
+    uint64_t cpo_hist[CNE_GRAPH_STATS_CPO_BUCKETS];     /**< Sampled calls by cycles per obj. */
+    uint64_t burst_hist[CNE_GRAPH_STATS_BURST_BUCKETS]; /**< Sampled calls by number of objs. */
+
     cne_node_t id;                /**< Node identifier of stats. */
     uint64_t hz;                  /**< Cycles per seconds. */
     char name[CNE_NODE_NAMESIZE]; /**< Name of the node. */
@@ -210,6 +238,67 @@ CNDP_API cne_graph_t cne_graph_create(const char *name, const char **patterns);
  */
 CNDP_API int cne_graph_destroy(cne_graph_t id);
 
+/**
+ * Reconfigure a graph while its worker keeps walking it.
+ *
+ * A new memory reel is built from the nodes of the graph, with their current
+ * edges and the nodes matching the patterns. The init() of the nodes new to
+ * the graph is called, the state of the other nodes (context and statistics)
+ * is moved to the new reel by the worker at the start of its next walk. No
+ * stream is in flight between two walks, so no object is dropped.
+ *
+ * The graph pointer held by the worker stays valid, its walks continue on the
+ * new reel. The node pointers taken from the graph and the cluster statistics
+ * created on it must be looked up again. Nodes can not be removed and graphs
+ * bound to a dispatch worker can not be reconfigured. A packet tracer of the
+ * graph is disabled.
+ *
+ * @param id
+ *   id of the graph to reconfigure.
+ * @param patterns
+ *   Patterns of the nodes added to the graph, NULL terminated. NULL to only
+ *   pick the edges added to the nodes of the graph and their new next nodes.
+ *
+ * @return
+ *   0 on success, -EBUSY if the graph is bound to a dispatch worker, <0 on
+ *   other errors.
+ *
+ * @see cne_node_edge_update(), cne_node_clone()
+ */
+CNDP_API int cne_graph_reconfigure(cne_graph_t id, const char **patterns);
+
+/**
+ * Compile the walk of a graph with a fixed topology.
+ *
+ * The nodes of the graph are sorted in topological order, the source nodes
+ * first. cne_graph_walk() then visits each node with pending objects once in
+ * that order, with no pending stream list to fill and read. A graph with a
+ * loop between its nodes keeps the generic walk on the circular buffer, as do
+ * the walks of a traced graph or of a graph bound to a dispatch worker.
+ *
+ * The graph stays compiled after cne_graph_reconfigure() if its new topology
+ * allows it. The walk order is freed with the graph.
+ *
+ * @param id
+ *   id of the graph to compile.
+ *
+ * @return
+ *   0 on success, -ENOTSUP if the graph has a loop, -EBUSY if the graph is
+ *   bound to a dispatch worker, <0 on other errors.
+ */
+CNDP_API int cne_graph_compile(cne_graph_t id);
+
+/**
+ * Check if the walk of a graph is compiled.
+ *
+ * @param id
+ *   id of the graph.
+ *
+ * @return
+ *   true if cne_graph_compile() succeeded on the current topology of the graph.
+ */
+CNDP_API bool cne_graph_is_compiled(cne_graph_t id);
+
 /**
  * Get graph id from graph name.
  *
@@ -295,6 +384,101 @@ CNDP_API cne_graph_t cne_graph_max_count(void);
  */
 CNDP_API struct cne_graph *cne_graph_lookup(const char *name);
 
+/**
+ * Report the quiescent state of the worker thread walking the graph.
+ *
+ * The thread is registered and marked online in the QSBR variable and
+ * cne_graph_walk() reports a quiescent state after each walk, so writers of
+ * lock-free tables used by the nodes can free the entries they removed once
+ * every graph completed a walk. Must be called from the worker thread.
+ *
+ * @param graph
+ *   Graph pointer returned from cne_graph_lookup().
+ * @param v
+ *   RCU QSBR variable.
+ * @param thread_id
+ *   Thread ID of the worker in the QSBR variable.
+ *
+ * @return
+ *   0 on success, -1 otherwise.
+ *
+ * @see cne_graph_qsbr_del()
+ */
+CNDP_API int cne_graph_qsbr_add(struct cne_graph *graph, struct cne_rcu_qsbr *v,
+                                uint32_t thread_id);
+
+/**
+ * Stop reporting the quiescent state of the worker thread, the thread is marked
+ * offline and unregistered from the QSBR variable. Must be called from the
+ * worker thread before it stops walking the graph.
+ *
+ * @param graph
+ *   Graph pointer returned from cne_graph_lookup().
+ *
+ * @return
+ *   0 on success, -1 otherwise.
+ */
+CNDP_API int cne_graph_qsbr_del(struct cne_graph *graph);
+
+#define CNE_GRAPH_DISPATCH_ANY     -1  /**< Node processed by any graph walking it. */
+#define CNE_GRAPH_DISPATCH_WQ_SIZE 256 /**< Streams a graph has in flight to the workers. */
+
+/**
+ * Run a node on a dispatch worker.
+ *
+ * In the dispatch model every worker thread walks its own graph created with
+ * the same nodes and bound to a worker id with cne_graph_dispatch_bind(). The
+ * streams a graph has pending for a node affinitized to another worker are
+ * copied in a lock-free work queue of the worker graph and processed by its
+ * next walk, so a node with shared state (a table, a reassembly context) is
+ * run by a single core while the other nodes scale over the workers. When the
+ * work queue is full the objects are processed by the local graph.
+ *
+ * The affinity of a node applies to the graphs bound before and after the call.
+ *
+ * @param name
+ *   Name of the node, a clone has its own affinity.
+ * @param worker
+ *   Worker id of the node, CNE_GRAPH_DISPATCH_ANY to process it in every graph.
+ *
+ * @return
+ *   0 on success, -EINVAL for an invalid worker id or -ENOENT if the node does
+ *   not exist.
+ */
+CNDP_API int cne_graph_dispatch_node_affinity_set(const char *name, int worker);
+
+/**
+ * Bind a graph to a dispatch worker.
+ *
+ * The graph gets a work queue for the streams dispatched to it by the other
+ * workers and starts dispatching the streams of the nodes affinitized to the
+ * other bound workers. The graph must contain a source node, otherwise it is
+ * never walked past its work queue. Call before the worker starts walking it.
+ *
+ * @param id
+ *   Graph id.
+ * @param worker
+ *   Worker id of the graph, at most one graph per worker.
+ *
+ * @return
+ *   0 on success, -EINVAL for an invalid graph or worker id, -EEXIST if the
+ *   graph or the worker is already bound or -ENOMEM.
+ */
+CNDP_API int cne_graph_dispatch_bind(cne_graph_t id, int worker);
+
+/**
+ * Unbind a graph from its dispatch worker, the nodes affinitized to the worker
+ * are processed locally by the other graphs again. No graph may be walking and
+ * the work queue is drained, cne_graph_destroy() unbinds the graph.
+ *
+ * @param id
+ *   Graph id.
+ *
+ * @return
+ *   0 on success, -EINVAL for an invalid graph id.
+ */
+CNDP_API int cne_graph_dispatch_unbind(cne_graph_t id);
+
 /**
  * Dump the graph information to file.
  *
@@ -419,6 +603,298 @@ CNDP_API void cne_graph_cluster_stats_reset(struct cne_graph_cluster_stats *stat
  */
 CNDP_API int cne_graph_stats_node_count(struct cne_graph_cluster_stats *stat);
 
+/**
+ * Get the stats of a node of the cluster, aggregated by the last call to
+ * cne_graph_cluster_stats_get().
+ *
+ * @param stat
+ *   Valid cluster stats pointer.
+ * @param idx
+ *   Index of the node in the cluster, less than cne_graph_stats_node_count().
+ * @return
+ *   Node cluster stats or NULL if the index is invalid.
+ */
+CNDP_API const struct cne_graph_cluster_node_stats *
+cne_graph_stats_node_get(struct cne_graph_cluster_stats *stat, int idx);
+
+/**
+ * Estimate a percentile of the cycles per object of a node from its histogram.
+ *
+ * @param stat
+ *   Node cluster stats.
+ * @param pct
+ *   Percentile in the range (0, 100].
+ * @return
+ *   Upper bound of the cycles per object of the bucket holding the percentile,
+ *   0 when no call was sampled.
+ */
+CNDP_API uint64_t cne_graph_stats_cpo_percentile(const struct cne_graph_cluster_node_stats *stat,
+                                                 double pct);
+
+/**
+ * Set the sampling period of the cycles accounting of a graph.
+ *
+ * Reading the TSC around each node visit costs more than most nodes, so the
+ * walk only accounts the cycles of one visit of a node every period visits and
+ * adds them to the cycles per object and burst size histograms. The calls and
+ * objects of a node are counted on every visit. A period of 1 accounts every
+ * visit, the default is CNE_GRAPH_STATS_SAMPLE_PERIOD.
+ *
+ * @param id
+ *   Graph id.
+ * @param period
+ *   Sampling period, a power of 2.
+ * @return
+ *   0 on success, -EINVAL for an invalid graph id or period.
+ */
+CNDP_API int cne_graph_stats_sample_set(cne_graph_t id, uint32_t period);
+
+#define CNE_GRAPH_TRACE_RECS    4096 /**< Default number of hops in the trace ring of a graph. */
+#define CNE_GRAPH_TRACE_PKTS    256  /**< Packets of a graph whose data is kept for pcapng. */
+#define CNE_GRAPH_TRACE_SNAPLEN 128  /**< Bytes of a traced packet kept for pcapng. */
+
+/**
+ * Select the objects to trace.
+ *
+ * @param obj
+ *   Object enqueued by a source node.
+ * @param arg
+ *   Argument of the trace parameters.
+ * @return
+ *   true to trace the object.
+ */
+typedef bool (*cne_graph_trace_filter_t)(void *obj, void *arg);
+
+/**
+ * Get the packet data of a traced object.
+ *
+ * @param obj
+ *   Object selected for tracing.
+ * @param len
+ *   Set to the length of the packet.
+ * @param arg
+ *   Argument of the trace parameters.
+ * @return
+ *   Pointer to the start of the packet, NULL if it has no data.
+ */
+typedef const void *(*cne_graph_trace_data_t)(void *obj, uint32_t *len, void *arg);
+
+/**
+ * Parameters of the packet tracer of a graph.
+ */
+struct cne_graph_trace_param {
+    uint32_t sample;                 /**< Trace one in sample objects passing the filter. */
+    uint32_t nb_recs;                /**< Hops in the trace ring, a power of 2, 0 for default. */
+    cne_graph_trace_filter_t filter; /**< Objects to trace, NULL for all. */
+    cne_graph_trace_data_t data;     /**< Packet data of an object, NULL for none. */
+    void *arg;                       /**< Argument of the callbacks. */
+};
+
+/**
+ * A hop of a traced packet.
+ */
+struct cne_graph_trace_rec {
+    uint64_t tsc;    /**< TSC when the node got the packet. */
+    uint32_t pkt;    /**< Trace id of the packet, starting at 1. */
+    cne_node_t node; /**< Node id. */
+    cne_edge_t edge; /**< Edge of the previous node, CNE_EDGE_ID_INVALID for the source. */
+};
+
+/**
+ * Enable the packet tracer of a graph.
+ *
+ * The objects enqueued by the source nodes of the graph, which pass the filter
+ * and are sampled one in sample, get a trace id. Each node visited by a traced
+ * object then writes a hop in the trace ring of the graph, overwriting the
+ * oldest hops when full. The trace stops when the object reaches a node without
+ * edges. Objects are matched by pointer, so a node must not replace the object
+ * of a traced packet.
+ *
+ * When no tracer is enabled the graph walk only tests a pointer. A later call
+ * restarts the trace in a new ring, the old ring is freed once the walker
+ * reported a quiescent state, see cne_graph_qsbr_add(), or when the graph is
+ * destroyed.
+ *
+ * @param id
+ *   Graph id.
+ * @param prm
+ *   Trace parameters.
+ * @return
+ *   0 on success, -EINVAL for invalid parameters or -ENOMEM.
+ */
+CNDP_API int cne_graph_trace_enable(cne_graph_t id, const struct cne_graph_trace_param *prm);
+
+/**
+ * Disable the packet tracer of a graph, the trace is kept for the dump functions.
+ *
+ * @param id
+ *   Graph id.
+ * @return
+ *   0 on success, -EINVAL for an invalid graph id.
+ */
+CNDP_API int cne_graph_trace_disable(cne_graph_t id);
+
+/**
+ * Copy the hops of the trace ring of a graph, oldest first. Can be called while
+ * the graph is walking.
+ *
+ * @param id
+ *   Graph id.
+ * @param recs
+ *   Array receiving the hops.
+ * @param nb
+ *   Size of the array, the last nb hops are returned.
+ * @return
+ *   Number of hops copied, negative on error.
+ */
+CNDP_API int cne_graph_trace_get(cne_graph_t id, struct cne_graph_trace_rec *recs, uint32_t nb);
+
+/**
+ * Dump the path of the packets in the trace ring of a graph.
+ *
+ * @param f
+ *   File pointer to dump the trace, NULL for stdout.
+ * @param id
+ *   Graph id.
+ */
+CNDP_API void cne_graph_trace_dump(FILE *f, cne_graph_t id);
+
+/**
+ * Save the packets traced by a graph in a pcapng file.
+ *
+ * Each packet whose data is still kept is written as an Ethernet frame with a
+ * comment giving the nodes it went through, the edge taken to each of them and
+ * the cycles from the source node.
+ *
+ * @param id
+ *   Graph id.
+ * @param filename
+ *   Name of the pcapng file.
+ * @return
+ *   Number of packets written, negative on error.
+ */
+CNDP_API int cne_graph_trace_pcapng_save(cne_graph_t id, const char *filename);
+
+#define CNE_GRAPH_FEATURE_MAX   64 /**< Features of an arc, one bit of the interface bitmap each. */
+#define CNE_GRAPH_FEATURE_START -1 /**< Position of the start node of an arc. */
+
+/**
+ * Create a feature arc.
+ *
+ * A feature arc is a named insertion point between a start node and an end
+ * node, e.g. ip4_input and ip4_forward. Feature nodes added to the arc can be
+ * enabled and disabled per interface while the graphs are walking. The start
+ * node and each feature node send a packet to the next feature enabled on its
+ * interface with cne_graph_feature_next(), or to the end node when there is
+ * none. The nodes are looked up by name when the first feature is added.
+ *
+ * @param name
+ *   Name of the arc.
+ * @param start
+ *   Name of the node starting the arc.
+ * @param end
+ *   Name of the node ending the arc.
+ * @param max_ifaces
+ *   Number of interfaces of the arc, the interface ids go from 0 to max_ifaces - 1.
+ * @return
+ *   Pointer to the arc on success, NULL otherwise and errno is set.
+ */
+CNDP_API struct cne_graph_feature_arc *cne_graph_feature_arc_create(const char *name,
+                                                                   const char *start,
+                                                                   const char *end,
+                                                                   uint16_t max_ifaces);
+
+/**
+ * Find a feature arc by name.
+ *
+ * @param name
+ *   Name of the arc.
+ * @return
+ *   Pointer to the arc, NULL if not found.
+ */
+CNDP_API struct cne_graph_feature_arc *cne_graph_feature_arc_lookup(const char *name);
+
+/**
+ * Destroy a feature arc, the edges added to the nodes are kept. No graph using
+ * the arc may be walking.
+ *
+ * @param arc
+ *   Pointer to the arc.
+ */
+CNDP_API void cne_graph_feature_arc_destroy(struct cne_graph_feature_arc *arc);
+
+/**
+ * Add a feature node to an arc.
+ *
+ * The features run in the order they are added. The edges from the start node
+ * and the other features of the arc to the feature node and from the feature
+ * node to the end node are added, so it must be called before the graphs are
+ * created and the graphs must contain all the nodes of the arc.
+ *
+ * @param arc
+ *   Pointer to the arc.
+ * @param name
+ *   Name of the feature node.
+ * @return
+ *   Position of the feature in the arc, negative on error.
+ */
+CNDP_API int cne_graph_feature_add(struct cne_graph_feature_arc *arc, const char *name);
+
+/**
+ * Get the position of a feature in an arc, for the feature node to give to
+ * cne_graph_feature_next().
+ *
+ * @param arc
+ *   Pointer to the arc.
+ * @param name
+ *   Name of the feature node.
+ * @return
+ *   Position of the feature, negative if not found.
+ */
+CNDP_API int cne_graph_feature_lookup(const struct cne_graph_feature_arc *arc, const char *name);
+
+/**
+ * Enable a feature of an arc on an interface, the graph walks send the next
+ * packets of the interface to the feature.
+ *
+ * @param arc
+ *   Pointer to the arc.
+ * @param name
+ *   Name of the feature node.
+ * @param iface
+ *   Interface id.
+ * @return
+ *   0 on success, -EINVAL for an invalid interface or -ENOENT for an unknown feature.
+ */
+CNDP_API int cne_graph_feature_enable(struct cne_graph_feature_arc *arc, const char *name,
+                                      uint16_t iface);
+
+/**
+ * Disable a feature of an arc on an interface. The packets of the interface
+ * already sent to the feature are still processed by it.
+ *
+ * @param arc
+ *   Pointer to the arc.
+ * @param name
+ *   Name of the feature node.
+ * @param iface
+ *   Interface id.
+ * @return
+ *   0 on success, -EINVAL for an invalid interface or -ENOENT for an unknown feature.
+ */
+CNDP_API int cne_graph_feature_disable(struct cne_graph_feature_arc *arc, const char *name,
+                                       uint16_t iface);
+
+/**
+ * Dump the features of an arc and the interfaces they are enabled on.
+ *
+ * @param f
+ *   File pointer to dump the arc, NULL for stdout.
+ * @param arc
+ *   Pointer to the arc, NULL for all the arcs.
+ */
+CNDP_API void cne_graph_feature_arc_dump(FILE *f, struct cne_graph_feature_arc *arc);
+
 /**
  * Structure defines the node registration parameters.
  *
@@ -12,12 +12,14 @@
  * process, enqueue and move streams of objects to the next nodes.
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include <cne_common.h>
 #include <cne_cycles.h>
 #include <cne_prefetch.h>
 #include <cne_branch_prediction.h>
 #include <cne_log.h>
+#include <cne_rcu_qsbr.h>
 
 #include "cne_graph.h"
 
@@ -38,6 +40,18 @@ struct cne_graph {
     cne_graph_off_t *cir_start;    /**< Pointer to circular buffer. */
     cne_graph_off_t nodes_start;   /**< Offset at which node memory starts. */
     cne_graph_t id;                /**< Graph identifier. */
+    uint32_t qsbr_thread_id;       /**< Thread ID of the walker in qsbr. */
+    struct cne_rcu_qsbr *qsbr;     /**< QSBR variable, quiescent after each walk. */
+    int32_t worker;                /**< Dispatch worker of the graph, -1 if not bound. */
+    struct cne_ring *wq;           /**< Streams dispatched to this graph, NULL if not bound. */
+    struct cne_ring *wq_free;      /**< Free dispatch streams of this graph. */
+    uint32_t sample_mask;          /**< Sampling period of the node cycles minus 1. */
+    struct cne_graph_trace *trace; /**< Packet tracer, NULL when disabled. */
+    struct cne_graph *live;        /**< Reel replacing this one, NULL if not reconfigured. */
+    struct cne_graph *prev;        /**< Reel whose node state is moved here on the next walk. */
+    struct cne_node **compiled;    /**< Nodes in walk order, NULL if not compiled. */
+    cne_node_t nb_compiled;        /**< Number of nodes in the compiled walk. */
+    cne_node_t nb_compiled_src;    /**< Source nodes at the start of the compiled walk. */
     char name[CNE_GRAPH_NAMESIZE]; /**< Name of the graph. */
     uint64_t fence;                /**< Fence. */
 } __cne_cache_aligned;
@@ -58,6 +72,11 @@ struct cne_node {
 
     char parent[CNE_NODE_NAMESIZE]; /**< Parent node name. */
     char name[CNE_NODE_NAMESIZE];   /**< Name of the node. */
+    struct cne_node *dispatch;      /**< Node in the graph of its dispatch worker, or NULL. */
+    uint64_t sampled_calls;         /**< Calls with cycles accounted. */
+    uint64_t sampled_objs;          /**< Objects of the calls with cycles accounted. */
+    uint64_t cpo_hist[CNE_GRAPH_STATS_CPO_BUCKETS];     /**< Sampled calls by cycles per obj. */
+    uint64_t burst_hist[CNE_GRAPH_STATS_BURST_BUCKETS]; /**< Sampled calls by number of objs. */
 
     /* Fast path area */
 #define CNE_NODE_CTX_SZ 16
@@ -112,9 +131,191 @@ void __cne_node_stream_alloc(struct cne_graph *graph, struct cne_node *node);
 void __cne_node_stream_alloc_size(struct cne_graph *graph, struct cne_node *node,
                                   uint16_t req_size);
 
+/**
+ * @internal
+ *
+ * Move the pending objects of a node to the graph of the node's dispatch worker.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object, node->dispatch is not NULL.
+ *
+ * @return
+ *   true if all the objects were dispatched, false if the work queue of the
+ *   worker is full and the objects left in the node must be processed here.
+ */
+bool __cne_graph_dispatch_node(struct cne_graph *graph, struct cne_node *node);
+
+/**
+ * @internal
+ *
+ * Add the streams dispatched to the graph by the other workers to the inputs
+ * of their nodes.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+void __cne_graph_dispatch_wq_process(struct cne_graph *graph);
+
+/**
+ * @internal
+ *
+ * Record a hop for the traced objects pending in a node before it is processed,
+ * for a source node remember the objects pending in its next nodes.
+ *
+ * @param trace
+ *   Packet tracer of the graph.
+ * @param node
+ *   Pointer to the node object.
+ * @param src
+ *   true if the node is a source node.
+ */
+void __cne_graph_trace_pre(struct cne_graph_trace *trace, struct cne_node *node, bool src);
+
+/**
+ * @internal
+ *
+ * Select the objects a source node enqueued to its next nodes for tracing.
+ *
+ * @param trace
+ *   Packet tracer of the graph.
+ * @param node
+ *   Pointer to the source node object.
+ */
+void __cne_graph_trace_post(struct cne_graph_trace *trace, struct cne_node *node);
+
+/**
+ * @internal
+ *
+ * Get the reel a reconfigured graph is walked on and move the state of its
+ * nodes to the reels it was not walked on yet.
+ *
+ * @param graph
+ *   Pointer to the graph object passed to cne_graph_walk().
+ *
+ * @return
+ *   Pointer to the current reel of the graph.
+ */
+struct cne_graph *__cne_graph_live_get(struct cne_graph *graph);
+
+/**
+ * @internal
+ *
+ * Account the cycles of a sampled node visit.
+ *
+ * @param node
+ *   Pointer to the node object.
+ * @param cycles
+ *   Cycles spent in the process function.
+ * @param nb_objs
+ *   Number of objects processed.
+ */
+static __cne_always_inline void
+__cne_node_stats_sample(struct cne_node *node, uint64_t cycles, uint16_t nb_objs)
+{
+    uint64_t cpo = cycles / (nb_objs ? nb_objs : 1);
+    int b;
+
+    node->total_cycles += cycles;
+    node->sampled_calls++;
+    node->sampled_objs += nb_objs;
+
+    b = cpo > 1 ? 63 - __builtin_clzll(cpo) : 0;
+    node->cpo_hist[CNE_MIN(b, CNE_GRAPH_STATS_CPO_BUCKETS - 1)]++;
+    b = nb_objs ? 32 - __builtin_clz(nb_objs) : 0;
+    node->burst_hist[CNE_MIN(b, CNE_GRAPH_STATS_BURST_BUCKETS - 1)]++;
+}
+
+/**
+ * @internal
+ *
+ * Call the process function of a node and collect its stats.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ * @param objs
+ *   Objects pending in the node.
+ */
+static __cne_always_inline void
+__cne_node_process(struct cne_graph *graph, struct cne_node *node, void **objs)
+{
+    uint64_t start;
+    uint16_t rc;
+
+    if (cne_graph_has_stats_feature()) {
+        /* Only the sampled visits pay for reading the TSC */
+        if ((node->total_calls & graph->sample_mask) == 0) {
+            start = cne_rdtsc();
+            rc    = node->process(graph, node, objs, node->idx);
+            __cne_node_stats_sample(node, cne_rdtsc() - start, rc);
+        } else
+            rc = node->process(graph, node, objs, node->idx);
+        node->total_calls++;
+        node->total_objs += rc;
+    } else
+        node->process(graph, node, objs, node->idx);
+}
+
+/**
+ * @internal
+ *
+ * Walk a graph compiled with cne_graph_compile().
+ *
+ * The nodes are visited once in topological order, the source nodes first, so
+ * a node is processed after all the nodes enqueuing to it. The nodes without
+ * pending objects are skipped and the pending streams of the reel are ignored.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+static __cne_always_inline void
+__cne_graph_walk_compiled(struct cne_graph *graph)
+{
+    struct cne_node **nodes = graph->compiled;
+    const cne_node_t nb_src = graph->nb_compiled_src;
+    const cne_node_t nb     = graph->nb_compiled;
+    struct cne_node *node;
+    cne_node_t i;
+
+    for (i = 0; i < nb_src; i++) {
+        node = nodes[i];
+        CNE_ASSERT(node->fence == CNE_GRAPH_FENCE);
+        __cne_node_process(graph, node, node->objs);
+        node->idx = 0;
+    }
+
+    for (; i < nb; i++) {
+        node = nodes[i];
+        CNE_ASSERT(node->fence == CNE_GRAPH_FENCE);
+        if (node->idx == 0)
+            continue;
+        cne_prefetch0(node->objs);
+        __cne_node_process(graph, node, node->objs);
+        node->idx = 0;
+    }
+
+    /* The enqueues still fill the reel, no walk reads it */
+    graph->tail = 0;
+}
+
 /**
  * Perform graph walk on the circular buffer and invoke the process function
- * of the nodes and collect the stats.
+ * of the nodes and collect the stats, the cycles are sampled as set by
+ * cne_graph_stats_sample_set(). When a QSBR variable was added with
+ * cne_graph_qsbr_add() a quiescent state is reported at the end of the walk.
+ *
+ * When the graph is bound to a dispatch worker with cne_graph_dispatch_bind(),
+ * the streams sent by the other workers are walked first and the streams of
+ * the nodes affinitized to another worker are handed over to its graph.
+ *
+ * The hops of the packets traced with cne_graph_trace_enable() are recorded
+ * around the process function of the nodes.
+ *
+ * A graph compiled with cne_graph_compile() visits its nodes in a fixed order
+ * instead of walking the reel, unless it is traced or bound to a worker.
  *
  * @param graph
  *   Graph pointer returned from cne_graph_lookup function.
@@ -124,14 +325,29 @@ void __cne_node_stream_alloc_size(struct cne_graph *graph, struct cne_node *node
 static inline void
 cne_graph_walk(struct cne_graph *graph)
 {
-    const cne_graph_off_t *cir_start = graph->cir_start;
-    const cne_node_t mask            = graph->cir_mask;
-    uint32_t head                    = graph->head;
+    const cne_graph_off_t *cir_start;
+    struct cne_graph_trace *trace;
     struct cne_node *node;
-    uint64_t start;
-    uint16_t rc;
+    struct cne_ring *wq;
+    cne_node_t mask;
+    uint32_t head;
     void **objs;
 
+    /* The graph was reconfigured, the walk continues on its current reel */
+    if (unlikely(graph->live != NULL))
+        graph = __cne_graph_live_get(graph);
+
+    cir_start = graph->cir_start;
+    mask      = graph->cir_mask;
+    head      = graph->head;
+    wq        = graph->wq;
+    trace     = graph->trace;
+
+    if (likely(graph->compiled != NULL) && trace == NULL && wq == NULL) {
+        __cne_graph_walk_compiled(graph);
+        goto done;
+    }
+
     /*
      * Walk on the source node(s) ((cir_start - head) -> cir_start) and then
      * on the pending streams (cir_start -> (cir_start + mask) -> cir_start)
@@ -147,24 +363,39 @@ cne_graph_walk(struct cne_graph *graph)
      *	|     |
      *	+-----+ <= cir_start + mask
      */
+    if (wq)
+        __cne_graph_dispatch_wq_process(graph);
+
     while (likely(head != graph->tail)) {
         node = CNE_PTR_ADD(graph, cir_start[(int32_t)head++]);
         CNE_ASSERT(node->fence == CNE_GRAPH_FENCE);
+
+        /* The node runs on another worker, unless its work queue is full */
+        if (wq && node->dispatch && __cne_graph_dispatch_node(graph, node)) {
+            node->idx = 0;
+            head      = likely((int32_t)head > 0) ? head & mask : head;
+            continue;
+        }
         objs = node->objs;
         cne_prefetch0(objs);
 
-        if (cne_graph_has_stats_feature()) {
-            start = cne_rdtsc();
-            rc    = node->process(graph, node, objs, node->idx);
-            node->total_cycles += cne_rdtsc() - start;
-            node->total_calls++;
-            node->total_objs += rc;
-        } else
-            node->process(graph, node, objs, node->idx);
+        /* Source nodes are walked while head is not positive */
+        if (unlikely(trace != NULL))
+            __cne_graph_trace_pre(trace, node, (int32_t)head <= 0);
+
+        __cne_node_process(graph, node, objs);
+
+        if (unlikely(trace != NULL) && (int32_t)head <= 0)
+            __cne_graph_trace_post(trace, node);
         node->idx = 0;
         head      = likely((int32_t)head > 0) ? head & mask : head;
     }
     graph->tail = 0;
+
+done:
+    /* No node holds a reference to shared data between two walks */
+    if (graph->qsbr)
+        cne_rcu_qsbr_quiescent(graph->qsbr, graph->qsbr_thread_id);
 }
 
 /* Fast path helper functions */
@@ -538,6 +769,71 @@ cne_node_next_stream_move(struct cne_graph *graph, struct cne_node *src, cne_edg
         cne_node_enqueue(graph, src, next, src->objs, src->idx);
 }
 
+/**
+ * @internal
+ *
+ * Data structure to hold a feature arc.
+ */
+struct cne_graph_feature_arc {
+    uint32_t nb_enabled;   /**< Interfaces with a feature enabled. */
+    uint16_t max_ifaces;   /**< Number of interfaces. */
+    uint16_t nb_features;  /**< Number of features. */
+    uint64_t *ifaces;      /**< Bitmap of the features enabled on each interface. */
+    struct cne_graph_feature_arc *next; /**< Next arc in the list. */
+    /** Edges of the start node (row 0) and of the features to the features and
+     * to the end node (column CNE_GRAPH_FEATURE_MAX).
+     */
+    cne_edge_t edges[CNE_GRAPH_FEATURE_MAX + 1][CNE_GRAPH_FEATURE_MAX + 1];
+    char name[CNE_GRAPH_NAMESIZE];                         /**< Name of the arc. */
+    char start[CNE_NODE_NAMESIZE];                         /**< Name of the start node. */
+    char end[CNE_NODE_NAMESIZE];                           /**< Name of the end node. */
+    char features[CNE_GRAPH_FEATURE_MAX][CNE_NODE_NAMESIZE]; /**< Names of the features. */
+};
+
+/**
+ * Check if a feature is enabled on any interface of an arc. The start node of
+ * the arc tests it once per burst, so a disabled arc costs nothing per object.
+ *
+ * @param arc
+ *   Pointer to the arc.
+ *
+ * @return
+ *   true if a feature is enabled.
+ */
+static __cne_always_inline bool
+cne_graph_feature_arc_enabled(const struct cne_graph_feature_arc *arc)
+{
+    return __atomic_load_n(&arc->nb_enabled, __ATOMIC_RELAXED) != 0;
+}
+
+/**
+ * Get the edge to the next feature enabled on the interface of an object, or
+ * to the end node of the arc if none.
+ *
+ * @param arc
+ *   Pointer to the arc.
+ * @param feature
+ *   Position of the calling feature node, CNE_GRAPH_FEATURE_START for the
+ *   start node.
+ * @param iface
+ *   Interface of the object.
+ *
+ * @return
+ *   Edge of the calling node to enqueue the object to.
+ */
+static __cne_always_inline cne_edge_t
+cne_graph_feature_next(const struct cne_graph_feature_arc *arc, int feature, uint16_t iface)
+{
+    uint64_t bits = 0;
+
+    if (likely(iface < arc->max_ifaces))
+        bits = __atomic_load_n(&arc->ifaces[iface], __ATOMIC_RELAXED);
+    if (feature != CNE_GRAPH_FEATURE_START)
+        bits &= ~1ULL << feature;
+
+    return arc->edges[feature + 1][bits ? __builtin_ctzll(bits) : CNE_GRAPH_FEATURE_MAX];
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -220,72 +220,130 @@ cne_graph_lookup(const char *name)
     return (g) ? g->graph : NULL;
 }
 
-cne_graph_t
-cne_graph_create(const char *name, const char **patterns)
+int
+cne_graph_qsbr_add(struct cne_graph *graph, struct cne_rcu_qsbr *v, uint32_t thread_id)
 {
-    cne_node_t src_node_count;
-    struct graph *graph;
-    const char *pattern;
+    if (graph == NULL || v == NULL)
+        CNE_ERR_RET("Invalid graph or QSBR variable\n");
 
-    graph_spinlock_lock();
+    /* The walks of a reconfigured graph report on its current reel */
+    while (graph->live)
+        graph = graph->live;
 
-    /* Check arguments sanity */
-    if (patterns == NULL)
-        SET_ERR_JMP(EINVAL, fail, "Node list is NULL");
+    if (graph->qsbr)
+        CNE_ERR_RET("Graph %s already has a QSBR variable\n", graph->name);
 
-    if (name == NULL)
-        SET_ERR_JMP(EINVAL, fail, "Graph name should not be NULL");
+    if (cne_rcu_qsbr_thread_register(v, thread_id) < 0)
+        CNE_ERR_RET("Unable to register graph %s thread %u\n", graph->name, thread_id);
+    cne_rcu_qsbr_thread_online(v, thread_id);
 
-    /* Check for existence of duplicate graph */
-    STAILQ_FOREACH (graph, &graph_list, next)
-        if (strncmp(name, graph->name, CNE_GRAPH_NAMESIZE) == 0)
-            SET_ERR_JMP(EEXIST, fail, "Found duplicate graph %s", name);
+    graph->qsbr_thread_id = thread_id;
+    graph->qsbr           = v;
+
+    return 0;
+}
+
+int
+cne_graph_qsbr_del(struct cne_graph *graph)
+{
+    struct cne_rcu_qsbr *v;
 
-    /* Create graph object */
-    graph = calloc(1, sizeof(*graph));
     if (graph == NULL)
-        SET_ERR_JMP(ENOMEM, fail, "Failed to calloc graph object");
+        CNE_ERR_RET("Invalid graph\n");
 
-    /* Initialize the graph object */
-    STAILQ_INIT(&graph->node_list);
-    if (strlcpy(graph->name, name, CNE_GRAPH_NAMESIZE) == 0)
-        SET_ERR_JMP(E2BIG, free, "Name too big=%s", name);
+    while (graph->live)
+        graph = graph->live;
+
+    v = graph->qsbr;
+    if (v == NULL)
+        return 0;
+
+    graph->qsbr = NULL;
+    cne_rcu_qsbr_thread_offline(v, graph->qsbr_thread_id);
+    cne_rcu_qsbr_thread_unregister(v, graph->qsbr_thread_id);
+
+    return 0;
+}
+
+/* Expand the patterns, add the next nodes and check the topology of a graph */
+static int
+graph_nodes_expand(struct graph *graph, const char **patterns)
+{
+    cne_node_t src_node_count;
+    const char *pattern;
 
     /* Expand node pattern and add the nodes to the graph */
-    for (uint16_t i = 0; (pattern = patterns[i]) != NULL; i++) {
+    for (uint16_t i = 0; patterns && (pattern = patterns[i]) != NULL; i++) {
         if (expand_pattern_to_node(graph, pattern))
-            goto graph_cleanup;
+            return -errno;
     }
 
     /* Go over all the nodes edges and add them to the graph */
     if (graph_node_edges_add(graph))
-        goto graph_cleanup;
+        return -errno;
 
     /* Update adjacency list of all nodes in the graph */
     if (graph_adjacency_list_update(graph))
-        goto graph_cleanup;
+        return -errno;
 
     /* Make sure at least a source node present in the graph */
     src_node_count = graph_src_nodes_count(graph);
     if (src_node_count == 0)
-        goto graph_cleanup;
+        return -errno;
 
     /* Make sure no node is pointing to source node */
     if (graph_node_has_edge_to_src_node(graph))
-        goto graph_cleanup;
+        return -errno;
 
     /* Don't allow node has loop to self */
     if (graph_node_has_loop_edge(graph))
-        goto graph_cleanup;
+        return -errno;
 
     /* Do BFS from src nodes on the graph to find isolated nodes */
     if (graph_has_isolated_node(graph))
-        goto graph_cleanup;
+        return -errno;
 
-    /* Initialize graph object */
     graph->src_node_count = src_node_count;
     graph->node_count     = graph_nodes_count(graph);
-    graph->id             = graph_id;
+
+    return 0;
+}
+
+cne_graph_t
+cne_graph_create(const char *name, const char **patterns)
+{
+    struct graph *graph;
+
+    graph_spinlock_lock();
+
+    /* Check arguments sanity */
+    if (patterns == NULL)
+        SET_ERR_JMP(EINVAL, fail, "Node list is NULL");
+
+    if (name == NULL)
+        SET_ERR_JMP(EINVAL, fail, "Graph name should not be NULL");
+
+    /* Check for existence of duplicate graph */
+    STAILQ_FOREACH (graph, &graph_list, next)
+        if (strncmp(name, graph->name, CNE_GRAPH_NAMESIZE) == 0)
+            SET_ERR_JMP(EEXIST, fail, "Found duplicate graph %s", name);
+
+    /* Create graph object */
+    graph = calloc(1, sizeof(*graph));
+    if (graph == NULL)
+        SET_ERR_JMP(ENOMEM, fail, "Failed to calloc graph object");
+
+    /* Initialize the graph object */
+    STAILQ_INIT(&graph->node_list);
+    if (strlcpy(graph->name, name, CNE_GRAPH_NAMESIZE) == 0)
+        SET_ERR_JMP(E2BIG, free, "Name too big=%s", name);
+
+    /* Add the nodes and check the topology of the graph */
+    if (graph_nodes_expand(graph, patterns))
+        goto graph_cleanup;
+
+    /* Initialize graph object */
+    graph->id = graph_id;
 
     /* Allocate the Graph fast path memory and populate the data */
     if (graph_fp_mem_create(graph))
@@ -329,6 +387,11 @@ cne_graph_destroy(cne_graph_t id)
     while (graph != NULL) {
         tmp = STAILQ_NEXT(graph, next);
         if (graph->id == id) {
+            /* The worker is stopped, move the node state it did not pick */
+            if (graph->nb_retired)
+                __cne_graph_live_get(graph->retired[0]);
+            graph_dispatch_unbind(graph);
+            graph_trace_free(graph);
             /* Call fini() of the all the nodes in the graph */
             graph_node_fini(graph);
             /* Destroy graph fast path memory */
@@ -350,6 +413,154 @@ done:
     return rc;
 }
 
+/* Move the state of the nodes of a reel to the reel replacing it */
+static void
+graph_live_nodes_move(struct cne_graph *from, struct cne_graph *to)
+{
+    struct cne_node *node, *prev;
+    cne_graph_off_t off;
+    cne_node_t count;
+
+    cne_graph_foreach_node(count, off, to, node)
+    {
+        prev = graph_node_name_to_ptr(from, node->name);
+        if (prev == NULL)
+            continue;
+
+        memcpy(node->ctx, prev->ctx, CNE_NODE_CTX_SZ);
+        node->total_cycles  = prev->total_cycles;
+        node->total_calls   = prev->total_calls;
+        node->total_objs    = prev->total_objs;
+        node->sampled_calls = prev->sampled_calls;
+        node->sampled_objs  = prev->sampled_objs;
+        memcpy(node->cpo_hist, prev->cpo_hist, sizeof(node->cpo_hist));
+        memcpy(node->burst_hist, prev->burst_hist, sizeof(node->burst_hist));
+    }
+}
+
+struct cne_graph *
+__cne_graph_live_get(struct cne_graph *graph)
+{
+    struct cne_graph *reel = graph, *next;
+
+    while ((next = __atomic_load_n(&reel->live, __ATOMIC_ACQUIRE)) != NULL) {
+        if (next->prev == reel) {
+            graph_live_nodes_move(reel, next);
+            next->prev = NULL;
+        }
+        reel = next;
+    }
+
+    /* The next walks go to the current reel directly */
+    if (graph != reel && graph->live != reel)
+        graph->live = reel;
+
+    return reel;
+}
+
+int
+cne_graph_reconfigure(cne_graph_t id, const char **patterns)
+{
+    struct graph *graph, *tmp = NULL;
+    struct cne_graph *old, *new, **retired;
+    struct graph_node *graph_node;
+    struct cne_node *node;
+    cne_graph_off_t off;
+    cne_node_t count;
+    struct node *n;
+    int rc;
+
+    graph_spinlock_lock();
+
+    STAILQ_FOREACH (graph, &graph_list, next)
+        if (graph->id == id)
+            break;
+    if (graph == NULL)
+        SET_ERR_JMP(EINVAL, fail, "Graph %u not found", id);
+    old = graph->graph;
+    if (old->wq)
+        SET_ERR_JMP(EBUSY, fail, "Graph %s is bound to worker %d", graph->name, old->worker);
+
+    tmp = calloc(1, sizeof(*tmp));
+    if (tmp == NULL)
+        SET_ERR_JMP(ENOMEM, fail, "Failed to calloc graph object");
+    STAILQ_INIT(&tmp->node_list);
+    memcpy(tmp->name, graph->name, CNE_GRAPH_NAMESIZE);
+    tmp->id = graph->id;
+
+    /* The nodes are found by name, adding edges reallocates them */
+    cne_graph_foreach_node(count, off, old, node)
+    {
+        n = node_from_name(node->name);
+        if (n == NULL)
+            SET_ERR_JMP(ENOENT, graph_cleanup, "Node %s not found", node->name);
+        if (graph_node_add(tmp, n))
+            goto graph_cleanup;
+    }
+
+    if (graph_nodes_expand(tmp, patterns))
+        goto graph_cleanup;
+
+    retired = realloc(graph->retired, (graph->nb_retired + 1) * sizeof(*retired));
+    if (retired == NULL)
+        SET_ERR_JMP(ENOMEM, graph_cleanup, "Failed to realloc retired reels");
+    graph->retired = retired;
+
+    if (graph_fp_mem_create(tmp))
+        goto graph_cleanup;
+    new = tmp->graph;
+
+    /* Only the nodes new to the graph are initialized */
+    STAILQ_FOREACH (graph_node, &tmp->node_list, next) {
+        n = graph_node->node;
+        if (n->init == NULL || graph_node_name_to_ptr(old, n->name))
+            continue;
+        rc = n->init(new, graph_node_name_to_ptr(new, n->name));
+        if (rc)
+            SET_ERR_JMP(-rc, graph_mem_destroy, "Node %s init() failed", n->name);
+    }
+
+    new->qsbr           = old->qsbr;
+    new->qsbr_thread_id = old->qsbr_thread_id;
+    new->sample_mask    = old->sample_mask;
+    new->prev           = old;
+
+    /* A new loop makes the graph fall back to the generic walk */
+    if (old->compiled)
+        graph_compile(tmp);
+
+    /* The tracer is sized for the edges of the old reel */
+    __atomic_store_n(&old->trace, NULL, __ATOMIC_RELEASE);
+
+    /* The worker moves the node state and continues on the new reel */
+    __atomic_store_n(&old->live, new, __ATOMIC_RELEASE);
+
+    graph->retired[graph->nb_retired++] = old;
+    graph->graph                        = new;
+    graph->nodes_start                  = tmp->nodes_start;
+    graph->src_node_count               = tmp->src_node_count;
+    graph->node_count                   = tmp->node_count;
+    graph->cir_start                    = tmp->cir_start;
+    graph->cir_mask                     = tmp->cir_mask;
+    graph->mem_sz                       = tmp->mem_sz;
+    graph_cleanup(graph);
+    STAILQ_CONCAT(&graph->node_list, &tmp->node_list);
+    free(tmp);
+
+    graph_spinlock_unlock();
+    return 0;
+graph_mem_destroy:
+    graph_fp_mem_destroy(tmp);
+    free(tmp->graph);
+graph_cleanup:
+    graph_cleanup(tmp);
+fail:
+    rc = -errno;
+    free(tmp);
+    graph_spinlock_unlock();
+    return rc;
+}
+
 cne_graph_t
 cne_graph_from_name(const char *name)
 {
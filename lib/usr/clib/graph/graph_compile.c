@@ -0,0 +1,132 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <errno.h>             // for EINVAL, EBUSY, ENOMEM, ENOTSUP
+#include <stdbool.h>           // for bool, false
+#include <stdint.h>            // for int32_t, uint32_t
+#include <stdlib.h>            // for calloc, free
+#include <sys/queue.h>         // for STAILQ_FOREACH
+#include <cne_common.h>        // for CNE_PTR_ADD
+#include <cne_log.h>           // for CNE_ERR_RET_VAL
+
+#include "graph_private.h"           // for graph, graph_spinlock_lock, SET_ERR_JMP
+#include "cne_graph.h"               // for cne_graph_t, cne_graph_foreach_node
+#include "cne_graph_worker.h"        // for cne_graph, cne_node
+
+/* Position of a node in the nodes of the reel */
+static cne_node_t
+graph_compile_index(struct cne_node **nodes, cne_node_t nb, const struct cne_node *node)
+{
+    cne_node_t i;
+
+    for (i = 0; i < nb; i++)
+        if (nodes[i] == node)
+            break;
+    return i;
+}
+
+int
+graph_compile(struct graph *_graph)
+{
+    struct cne_graph *graph = _graph->graph;
+    const cne_node_t nb     = graph->nb_nodes;
+    struct cne_node **nodes = NULL, **order = NULL, *node;
+    cne_node_t count, head = 0, tail = 0, i;
+    uint32_t *indeg = NULL;
+    cne_graph_off_t off;
+    int32_t src;
+    cne_edge_t e;
+
+    if (graph->compiled)
+        return 0;
+
+    nodes = calloc(nb, sizeof(*nodes));
+    order = calloc(nb, sizeof(*order));
+    indeg = calloc(nb, sizeof(*indeg));
+    if (!nodes || !order || !indeg)
+        SET_ERR_JMP(ENOMEM, fail, "Failed to allocate the walk of graph %s", graph->name);
+
+    i = 0;
+    cne_graph_foreach_node(count, off, graph, node) nodes[i++] = node;
+
+    for (i = 0; i < nb; i++)
+        for (e = 0; e < nodes[i]->nb_edges; e++)
+            indeg[graph_compile_index(nodes, nb, nodes[i]->nodes[e])]++;
+
+    /* The source nodes come first, in the order of the reel */
+    for (src = (int32_t)graph->head; src < 0; src++)
+        order[tail++] = CNE_PTR_ADD(graph, graph->cir_start[src]);
+
+    /* A node is walked once all the nodes with an edge to it were */
+    while (head < tail) {
+        node = order[head++];
+        for (e = 0; e < node->nb_edges; e++) {
+            i = graph_compile_index(nodes, nb, node->nodes[e]);
+            if (--indeg[i] == 0)
+                order[tail++] = nodes[i];
+        }
+    }
+
+    /* Nodes on a loop never get ready, they need the reel */
+    if (tail != nb)
+        SET_ERR_JMP(ENOTSUP, fail, "Graph %s has a loop, not compiled", graph->name);
+
+    graph->nb_compiled     = nb;
+    graph->nb_compiled_src = (cne_node_t)-(int32_t)graph->head;
+    __atomic_store_n(&graph->compiled, order, __ATOMIC_RELEASE);
+
+    free(nodes);
+    free(indeg);
+    return 0;
+fail:
+    free(nodes);
+    free(order);
+    free(indeg);
+    return -errno;
+}
+
+int
+cne_graph_compile(cne_graph_t id)
+{
+    struct graph *graph;
+    int rc;
+
+    graph_spinlock_lock();
+
+    STAILQ_FOREACH (graph, graph_list_head_get(), next)
+        if (graph->id == id)
+            break;
+    if (!graph) {
+        graph_spinlock_unlock();
+        CNE_ERR_RET_VAL(-EINVAL, "Graph %u not found\n", id);
+    }
+    if (graph->graph->wq) {
+        graph_spinlock_unlock();
+        CNE_ERR_RET_VAL(-EBUSY, "Graph %s is bound to worker %d\n", graph->name,
+                        graph->graph->worker);
+    }
+
+    rc = graph_compile(graph);
+
+    graph_spinlock_unlock();
+    return rc;
+}
+
+bool
+cne_graph_is_compiled(cne_graph_t id)
+{
+    struct graph *graph;
+    bool compiled = false;
+
+    graph_spinlock_lock();
+
+    STAILQ_FOREACH (graph, graph_list_head_get(), next)
+        if (graph->id == id) {
+            compiled = graph->graph->compiled != NULL;
+            break;
+        }
+
+    graph_spinlock_unlock();
+    return compiled;
+}
@@ -33,6 +33,7 @@ graph_dump(FILE *f, struct graph *g)
     cne_fprintf(f, "  mem_sz=%zu\n", g->mem_sz);
     cne_fprintf(f, "  node_count=%" PRIu32 "\n", g->node_count);
     cne_fprintf(f, "  src_node_count=%" PRIu32 "\n", g->src_node_count);
+    cne_fprintf(f, "  worker=%" PRId32 "\n", g->graph->worker);
 
     STAILQ_FOREACH (graph_node, &g->node_list, next)
         cne_fprintf(f, "     node[%d] <%s>\n", i++, graph_node->node->name);
@@ -87,6 +88,7 @@ cne_graph_obj_dump(FILE *f, struct cne_graph *g, bool all)
     cne_fprintf(f, "  fence=0x%" PRIx64 "\n", g->fence);
     cne_fprintf(f, "  nodes_start=0x%" PRIx32 "\n", g->nodes_start);
     cne_fprintf(f, "  cir_start=%p\n", g->cir_start);
+    cne_fprintf(f, "  worker=%" PRId32 "\n", g->worker);
 
     cne_graph_foreach_node(count, off, g, n)
     {
@@ -104,6 +106,8 @@ cne_graph_obj_dump(FILE *f, struct cne_graph *g, bool all)
         cne_fprintf(f, "       idx=%d\n", n->idx);
         cne_fprintf(f, "       total_objs=%" PRId64 "\n", n->total_objs);
         cne_fprintf(f, "       total_calls=%" PRId64 "\n", n->total_calls);
+        if (n->dispatch)
+            cne_fprintf(f, "       dispatch=%p\n", n->dispatch);
         for (i = 0; i < n->nb_edges; i++)
             cne_fprintf(f, "          edge[%d] <%s>\n", i, n->nodes[i]->name);
     }
@@ -0,0 +1,255 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <errno.h>             // for EINVAL, EEXIST, ENOENT, ENOMEM
+#include <stdbool.h>           // for bool, true, false
+#include <stdio.h>             // for snprintf
+#include <stdlib.h>            // for calloc, free
+#include <string.h>            // for memcpy, memmove
+#include <sys/queue.h>         // for STAILQ_FOREACH
+#include <cne_common.h>        // for CNE_MIN, CNE_PTR_SUB, __cne_cache_aligned
+#include <cne_ring_api.h>       // for cne_ring_create, cne_ring_enqueue, cne_ring_dequeue
+
+#include "graph_private.h"           // for graph, graph_node, node, graph_spinlock_lock
+#include "cne_graph.h"               // for CNE_GRAPH_DISPATCH_ANY, CNE_GRAPH_DISPATCH_WQ_SIZE
+#include "cne_graph_worker.h"        // for cne_graph, cne_node, cne_node_add_objects_to_input
+
+/* Streams taken from the work queue in one walk */
+#define GRAPH_DISPATCH_WQ_BURST 32
+
+/* Objects of a node sent to the graph of its dispatch worker */
+struct graph_dispatch_stream {
+    struct cne_node *node; /* Node in the destination graph */
+    struct cne_ring *home; /* Free ring of the sending graph */
+    uint16_t nb_objs;
+    void *objs[CNE_GRAPH_BURST_SIZE];
+} __cne_cache_aligned;
+
+bool
+__cne_graph_dispatch_node(struct cne_graph *graph, struct cne_node *node)
+{
+    struct cne_node *dst        = __atomic_load_n(&node->dispatch, __ATOMIC_ACQUIRE);
+    struct cne_graph *dst_graph = CNE_PTR_SUB(dst, dst->off);
+    struct graph_dispatch_stream *s;
+    uint16_t done = 0, n;
+
+    while (done < node->idx) {
+        if (cne_ring_dequeue(graph->wq_free, (void **)&s) < 0)
+            break;
+
+        n          = CNE_MIN(node->idx - done, CNE_GRAPH_BURST_SIZE);
+        s->node    = dst;
+        s->home    = graph->wq_free;
+        s->nb_objs = n;
+        memcpy(s->objs, &node->objs[done], n * sizeof(void *));
+
+        if (cne_ring_enqueue(dst_graph->wq, s) < 0) {
+            cne_ring_enqueue(graph->wq_free, s);
+            break;
+        }
+        done += n;
+    }
+
+    if (done == node->idx)
+        return true;
+
+    /* Work queue full, the objects left are processed by this graph */
+    memmove(node->objs, &node->objs[done], (node->idx - done) * sizeof(void *));
+    node->idx -= done;
+
+    return false;
+}
+
+void
+__cne_graph_dispatch_wq_process(struct cne_graph *graph)
+{
+    struct graph_dispatch_stream *s[GRAPH_DISPATCH_WQ_BURST];
+    unsigned int i, n;
+
+    n = cne_ring_dequeue_burst(graph->wq, (void **)s, GRAPH_DISPATCH_WQ_BURST, NULL);
+    for (i = 0; i < n; i++) {
+        cne_node_add_objects_to_input(graph, s[i]->node, s[i]->objs, s[i]->nb_objs);
+        cne_ring_enqueue(s[i]->home, s[i]);
+    }
+}
+
+static struct graph *
+graph_dispatch_find(int worker)
+{
+    struct graph *g;
+
+    STAILQ_FOREACH (g, graph_list_head_get(), next)
+        if (g->graph->wq && g->graph->worker == worker)
+            return g;
+
+    return NULL;
+}
+
+/* Point the nodes of the bound graphs to their dispatch worker, lock held */
+static void
+graph_dispatch_update(void)
+{
+    struct graph_node *graph_node;
+    struct cne_node *n, *dst;
+    struct graph *g, *dg;
+    struct node *node;
+
+    STAILQ_FOREACH (g, graph_list_head_get(), next) {
+        if (!g->graph->wq)
+            continue;
+
+        STAILQ_FOREACH (graph_node, &g->node_list, next) {
+            node = graph_node->node;
+            n    = graph_node_name_to_ptr(g->graph, node->name);
+            dst  = NULL;
+
+            if (node->worker != CNE_GRAPH_DISPATCH_ANY && node->worker != g->graph->worker) {
+                dg = graph_dispatch_find(node->worker);
+                if (dg)
+                    dst = graph_node_name_to_ptr(dg->graph, node->name);
+            }
+            __atomic_store_n(&n->dispatch, dst, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/* Hand the streams of a work queue to the nodes of its graph, no graph walking */
+static void
+graph_dispatch_drain(struct cne_graph *graph)
+{
+    while (cne_ring_count(graph->wq))
+        __cne_graph_dispatch_wq_process(graph);
+}
+
+int
+cne_graph_dispatch_node_affinity_set(const char *name, int worker)
+{
+    struct node *node;
+    int rc = 0;
+
+    if (!name || worker < CNE_GRAPH_DISPATCH_ANY)
+        return -EINVAL;
+
+    graph_spinlock_lock();
+
+    node = node_from_name(name);
+    if (!node)
+        SET_ERR_JMP(ENOENT, fail, "Node %s not found", name);
+
+    node->worker = worker;
+    graph_dispatch_update();
+
+    graph_spinlock_unlock();
+    return 0;
+fail:
+    rc = -errno;
+    graph_spinlock_unlock();
+    return rc;
+}
+
+int
+cne_graph_dispatch_bind(cne_graph_t id, int worker)
+{
+    struct graph_dispatch_stream *mem = NULL;
+    struct cne_ring *wq = NULL, *wq_free = NULL;
+    char name[CNE_GRAPH_NAMESIZE];
+    struct graph *graph;
+    int rc;
+
+    if (worker < 0)
+        return -EINVAL;
+
+    graph_spinlock_lock();
+
+    STAILQ_FOREACH (graph, graph_list_head_get(), next)
+        if (graph->id == id)
+            break;
+    if (!graph)
+        SET_ERR_JMP(EINVAL, fail, "Graph %u not found", id);
+    if (graph->graph->wq)
+        SET_ERR_JMP(EEXIST, fail, "Graph %s already bound to worker %d", graph->name,
+                    graph->graph->worker);
+    if (graph_dispatch_find(worker))
+        SET_ERR_JMP(EEXIST, fail, "Worker %d already has a graph", worker);
+
+    /* Streams come from every other worker, the sender falls back when full */
+    snprintf(name, sizeof(name), "gd_wq_%u", id);
+    wq = cne_ring_create(name, 0, CNE_GRAPH_DISPATCH_WQ_SIZE, RING_F_SC_DEQ | RING_F_EXACT_SZ);
+    snprintf(name, sizeof(name), "gd_free_%u", id);
+    wq_free =
+        cne_ring_create(name, 0, CNE_GRAPH_DISPATCH_WQ_SIZE, RING_F_SC_DEQ | RING_F_EXACT_SZ);
+    mem = calloc(CNE_GRAPH_DISPATCH_WQ_SIZE, sizeof(struct graph_dispatch_stream));
+    if (!wq || !wq_free || !mem)
+        SET_ERR_JMP(ENOMEM, fail, "Unable to allocate dispatch work queue of graph %s",
+                    graph->name);
+
+    for (int i = 0; i < CNE_GRAPH_DISPATCH_WQ_SIZE; i++)
+        cne_ring_enqueue(wq_free, &mem[i]);
+
+    graph->dispatch_mem   = mem;
+    graph->graph->worker  = worker;
+    graph->graph->wq_free = wq_free;
+    graph->graph->wq      = wq;
+    graph_dispatch_update();
+
+    graph_spinlock_unlock();
+    return 0;
+fail:
+    rc = -errno;
+    cne_ring_free(wq);
+    cne_ring_free(wq_free);
+    free(mem);
+    graph_spinlock_unlock();
+    return rc;
+}
+
+void
+graph_dispatch_unbind(struct graph *graph)
+{
+    struct cne_graph *g = graph->graph;
+    struct graph_node *graph_node;
+    struct graph *other;
+
+    if (!g->wq)
+        return;
+
+    /* Take back the streams of the graph queued to the other workers */
+    STAILQ_FOREACH (other, graph_list_head_get(), next)
+        if (other->graph->wq)
+            graph_dispatch_drain(other->graph);
+
+    STAILQ_FOREACH (graph_node, &graph->node_list, next)
+        graph_node_name_to_ptr(g, graph_node->node->name)->dispatch = NULL;
+
+    cne_ring_free(g->wq);
+    cne_ring_free(g->wq_free);
+    free(graph->dispatch_mem);
+    graph->dispatch_mem = NULL;
+    g->wq               = NULL;
+    g->wq_free          = NULL;
+    g->worker           = CNE_GRAPH_DISPATCH_ANY;
+
+    graph_dispatch_update();
+}
+
+int
+cne_graph_dispatch_unbind(cne_graph_t id)
+{
+    struct graph *graph;
+
+    graph_spinlock_lock();
+
+    STAILQ_FOREACH (graph, graph_list_head_get(), next)
+        if (graph->id == id)
+            break;
+    if (!graph) {
+        graph_spinlock_unlock();
+        CNE_ERR_RET_VAL(-EINVAL, "Graph %u not found\n", id);
+    }
+
+    graph_dispatch_unbind(graph);
+
+    graph_spinlock_unlock();
+    return 0;
+}
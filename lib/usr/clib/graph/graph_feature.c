@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <errno.h>             // for EINVAL, EEXIST, ENOENT, ENOMEM, ENOSPC
+#include <stdbool.h>           // for bool, true, false
+#include <stdio.h>             // for FILE, fprintf
+#include <stdlib.h>            // for calloc, free
+#include <string.h>            // for strcmp, memset
+#include <bsd/string.h>        // for strlcpy
+#include <cne_log.h>           // for CNE_ERR_RET_VAL, CNE_NULL_RET
+
+#include "graph_private.h"           // for graph_spinlock_lock, graph_spinlock_unlock
+#include "cne_graph.h"               // for CNE_GRAPH_FEATURE_MAX, cne_node_from_name
+#include "cne_graph_worker.h"        // for cne_graph_feature_arc
+
+static struct cne_graph_feature_arc *arc_list;
+
+/* Edge of a node to the node named to, added when missing */
+static cne_edge_t
+graph_feature_edge(cne_node_t id, const char *to)
+{
+    cne_edge_t nb = cne_node_edge_count(id), e;
+    char **names;
+
+    if (nb == CNE_EDGE_ID_INVALID)
+        return CNE_EDGE_ID_INVALID;
+
+    names = calloc(nb + 1, sizeof(char *));
+    if (!names)
+        return CNE_EDGE_ID_INVALID;
+    cne_node_edge_get(id, names);
+    for (e = 0; e < nb; e++)
+        if (!strcmp(names[e], to))
+            break;
+    free(names);
+
+    if (e == nb && cne_node_edge_update(id, CNE_EDGE_ID_INVALID, &to, 1) != 1)
+        return CNE_EDGE_ID_INVALID;
+
+    return e;
+}
+
+struct cne_graph_feature_arc *
+cne_graph_feature_arc_create(const char *name, const char *start, const char *end,
+                             uint16_t max_ifaces)
+{
+    struct cne_graph_feature_arc *arc = NULL;
+
+    if (!name || !start || !end || max_ifaces == 0) {
+        errno = EINVAL;
+        CNE_NULL_RET("Invalid feature arc parameters\n");
+    }
+
+    graph_spinlock_lock();
+
+    for (arc = arc_list; arc; arc = arc->next)
+        if (!strcmp(arc->name, name))
+            SET_ERR_JMP(EEXIST, fail, "Feature arc %s already exists", name);
+
+    arc = calloc(1, sizeof(*arc));
+    if (!arc)
+        SET_ERR_JMP(ENOMEM, fail, "Unable to allocate feature arc %s", name);
+    arc->ifaces = calloc(max_ifaces, sizeof(uint64_t));
+    if (!arc->ifaces)
+        SET_ERR_JMP(ENOMEM, fail, "Unable to allocate feature arc %s", name);
+
+    if (strlcpy(arc->name, name, sizeof(arc->name)) >= sizeof(arc->name) ||
+        strlcpy(arc->start, start, sizeof(arc->start)) >= sizeof(arc->start) ||
+        strlcpy(arc->end, end, sizeof(arc->end)) >= sizeof(arc->end))
+        SET_ERR_JMP(E2BIG, fail, "Feature arc %s name too long", name);
+
+    memset(arc->edges, 0xff, sizeof(arc->edges)); /* CNE_EDGE_ID_INVALID */
+    arc->max_ifaces = max_ifaces;
+    arc->next       = arc_list;
+    arc_list        = arc;
+
+    graph_spinlock_unlock();
+    return arc;
+fail:
+    if (arc)
+        free(arc->ifaces);
+    free(arc);
+    graph_spinlock_unlock();
+    return NULL;
+}
+
+struct cne_graph_feature_arc *
+cne_graph_feature_arc_lookup(const char *name)
+{
+    struct cne_graph_feature_arc *arc;
+
+    if (!name)
+        return NULL;
+
+    graph_spinlock_lock();
+    for (arc = arc_list; arc; arc = arc->next)
+        if (!strcmp(arc->name, name))
+            break;
+    graph_spinlock_unlock();
+
+    return arc;
+}
+
+void
+cne_graph_feature_arc_destroy(struct cne_graph_feature_arc *arc)
+{
+    struct cne_graph_feature_arc **p;
+
+    if (!arc)
+        return;
+
+    graph_spinlock_lock();
+    for (p = &arc_list; *p; p = &(*p)->next) {
+        if (*p == arc) {
+            *p = arc->next;
+            break;
+        }
+    }
+    graph_spinlock_unlock();
+
+    free(arc->ifaces);
+    free(arc);
+}
+
+int
+cne_graph_feature_lookup(const struct cne_graph_feature_arc *arc, const char *name)
+{
+    if (!arc || !name)
+        return -EINVAL;
+
+    for (int f = 0; f < arc->nb_features; f++)
+        if (!strcmp(arc->features[f], name))
+            return f;
+
+    return -ENOENT;
+}
+
+int
+cne_graph_feature_add(struct cne_graph_feature_arc *arc, const char *name)
+{
+    cne_node_t start, id;
+    bool ok;
+    int f;
+
+    if (!arc || !name)
+        return -EINVAL;
+    if (cne_graph_feature_lookup(arc, name) >= 0)
+        CNE_ERR_RET_VAL(-EEXIST, "Feature %s already in arc %s\n", name, arc->name);
+    if (arc->nb_features >= CNE_GRAPH_FEATURE_MAX)
+        CNE_ERR_RET_VAL(-ENOSPC, "Feature arc %s is full\n", arc->name);
+
+    start = cne_node_from_name(arc->start);
+    id    = cne_node_from_name(name);
+    if (start == CNE_NODE_ID_INVALID || id == CNE_NODE_ID_INVALID ||
+        cne_node_from_name(arc->end) == CNE_NODE_ID_INVALID)
+        CNE_ERR_RET_VAL(-ENOENT, "Nodes of feature %s in arc %s not found\n", name, arc->name);
+
+    /* The start node and the features before it can jump to the feature */
+    f                                        = arc->nb_features;
+    arc->edges[0][CNE_GRAPH_FEATURE_MAX]     = graph_feature_edge(start, arc->end);
+    arc->edges[0][f]                         = graph_feature_edge(start, name);
+    arc->edges[f + 1][CNE_GRAPH_FEATURE_MAX] = graph_feature_edge(id, arc->end);
+
+    ok = arc->edges[0][CNE_GRAPH_FEATURE_MAX] != CNE_EDGE_ID_INVALID &&
+         arc->edges[0][f] != CNE_EDGE_ID_INVALID &&
+         arc->edges[f + 1][CNE_GRAPH_FEATURE_MAX] != CNE_EDGE_ID_INVALID;
+    for (int g = 0; g < f; g++) {
+        arc->edges[g + 1][f] = graph_feature_edge(cne_node_from_name(arc->features[g]), name);
+        ok                   = ok && arc->edges[g + 1][f] != CNE_EDGE_ID_INVALID;
+    }
+    if (!ok)
+        CNE_ERR_RET_VAL(-ENOMEM, "Unable to add the edges of feature %s\n", name);
+
+    strlcpy(arc->features[f], name, sizeof(arc->features[f]));
+    arc->nb_features++;
+
+    return f;
+}
+
+static int
+graph_feature_set(struct cne_graph_feature_arc *arc, const char *name, uint16_t iface, bool on)
+{
+    uint64_t bits, new;
+    int f;
+
+    if (!arc || iface >= arc->max_ifaces)
+        return -EINVAL;
+    f = cne_graph_feature_lookup(arc, name);
+    if (f < 0)
+        return -ENOENT;
+
+    graph_spinlock_lock();
+
+    bits = arc->ifaces[iface];
+    new  = on ? bits | (1ULL << f) : bits & ~(1ULL << f);
+    __atomic_store_n(&arc->ifaces[iface], new, __ATOMIC_RELEASE);
+
+    /* The walks test the arc before the interface bitmaps */
+    if (!bits && new)
+        __atomic_store_n(&arc->nb_enabled, arc->nb_enabled + 1, __ATOMIC_RELEASE);
+    else if (bits && !new)
+        __atomic_store_n(&arc->nb_enabled, arc->nb_enabled - 1, __ATOMIC_RELEASE);
+
+    graph_spinlock_unlock();
+
+    return 0;
+}
+
+int
+cne_graph_feature_enable(struct cne_graph_feature_arc *arc, const char *name, uint16_t iface)
+{
+    return graph_feature_set(arc, name, iface, true);
+}
+
+int
+cne_graph_feature_disable(struct cne_graph_feature_arc *arc, const char *name, uint16_t iface)
+{
+    return graph_feature_set(arc, name, iface, false);
+}
+
+static void
+graph_feature_arc_dump(FILE *f, struct cne_graph_feature_arc *arc)
+{
+    fprintf(f, "feature arc <%s> %s -> %s, %u features, enabled on %u interfaces\n", arc->name,
+            arc->start, arc->end, arc->nb_features, arc->nb_enabled);
+
+    for (int i = 0; i < arc->nb_features; i++) {
+        fprintf(f, "  %2d %-32s ifaces:", i, arc->features[i]);
+        for (uint16_t j = 0; j < arc->max_ifaces; j++)
+            if (arc->ifaces[j] & (1ULL << i))
+                fprintf(f, " %u", j);
+        fprintf(f, "\n");
+    }
+}
+
+void
+cne_graph_feature_arc_dump(FILE *f, struct cne_graph_feature_arc *arc)
+{
+    struct cne_graph_feature_arc *a;
+
+    if (!f)
+        f = stdout;
+
+    graph_spinlock_lock();
+    for (a = arc_list; a; a = a->next)
+        if (!arc || a == arc)
+            graph_feature_arc_dump(f, a);
+    graph_spinlock_unlock();
+}
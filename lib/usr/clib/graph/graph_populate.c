@@ -61,6 +61,8 @@ graph_header_popluate(struct graph *_graph)
     graph->cir_start   = CNE_PTR_ADD(graph, _graph->cir_start);
     graph->nodes_start = _graph->nodes_start;
     graph->id          = _graph->id;
+    graph->worker      = CNE_GRAPH_DISPATCH_ANY;
+    graph->sample_mask = CNE_GRAPH_STATS_SAMPLE_PERIOD - 1;
     memcpy(graph->name, _graph->name, CNE_GRAPH_NAMESIZE);
     graph->fence = CNE_GRAPH_FENCE;
 }
@@ -228,11 +230,22 @@ graph_nodes_mem_destroy(struct cne_graph *graph)
         return;
 
     cne_graph_foreach_node(count, off, graph, node) free(node->objs);
+    free(graph->compiled);
 }
 
 int
 graph_fp_mem_destroy(struct graph *graph)
 {
     graph_nodes_mem_destroy(graph->graph);
+
+    /* No worker walks the reels replaced by a reconfiguration any more */
+    for (uint16_t i = 0; i < graph->nb_retired; i++) {
+        graph_nodes_mem_destroy(graph->retired[i]);
+        free(graph->retired[i]);
+    }
+    free(graph->retired);
+    graph->retired    = NULL;
+    graph->nb_retired = 0;
+
     return 0;
 }
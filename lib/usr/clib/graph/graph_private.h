@@ -51,6 +51,7 @@ struct node {
     cne_node_t id;                        /**< Allocated identifier for the node. */
     cne_node_t parent_id;                 /**< Parent node identifier. */
     cne_edge_t nb_edges;                  /**< Number of edges from this node. */
+    int worker;                           /**< Dispatch worker, CNE_GRAPH_DISPATCH_ANY if none. */
     char next_nodes[][CNE_NODE_NAMESIZE]; /**< Names of next nodes. */
 };
 
@@ -82,6 +83,10 @@ struct graph {
     uint32_t cir_mask;             /**< Circular buffer mask for wrap around. */
     cne_graph_t id;                /**< Graph identifier. */
     size_t mem_sz;                 /**< Memory size of the graph. */
+    void *dispatch_mem;            /**< Streams of the dispatch work queues. */
+    struct cne_graph_trace *trace; /**< Packet tracer, kept when disabled. */
+    struct cne_graph **retired;    /**< Reels replaced by a reconfiguration. */
+    uint16_t nb_retired;           /**< Number of retired reels. */
     STAILQ_HEAD(gnode_list, graph_node) node_list; /**< Nodes in a graph. */
 };
 
@@ -302,6 +307,45 @@ struct cne_node *graph_node_id_to_ptr(const struct cne_graph *graph, cne_node_t
  */
 struct cne_node *graph_node_name_to_ptr(const struct cne_graph *graph, const char *node_name);
 
+/* Compile functions */
+
+/**
+ * @internal
+ *
+ * Sort the nodes of the graph reel in walk order, called with the graph lock held.
+ *
+ * @param graph
+ *   Pointer to the internal graph object.
+ *
+ * @return
+ *   0 on success, -ENOTSUP if the graph has a loop, <0 on other errors.
+ */
+int graph_compile(struct graph *graph);
+
+/* Dispatch functions */
+
+/**
+ * @internal
+ *
+ * Unbind a graph from its dispatch worker, called with the graph lock held.
+ *
+ * @param graph
+ *   Pointer to the internal graph object.
+ */
+void graph_dispatch_unbind(struct graph *graph);
+
+/* Trace functions */
+
+/**
+ * @internal
+ *
+ * Disable and free the packet tracer of a graph, called with the graph lock held.
+ *
+ * @param graph
+ *   Pointer to the internal graph object.
+ */
+void graph_trace_free(struct graph *graph);
+
 /* Debug functions */
 
 /**
@@ -51,15 +51,16 @@ struct cne_graph_cluster_stats {
 
 #define border()                                                      \
     cne_printf("[yellow]+------------------+---------------+--------" \
-               "-------+--------+--------+----------+------------+[]\n")
+               "-------+--------+--------+----------+------------+----------+[]\n")
 
 static inline void
 print_banner(void)
 {
     border();
     cne_printf("[yellow]|[green]%-18s[yellow]|[green]%15s[yellow]|[green]%15s[yellow]|[green]%"
-               "8s[yellow]|[green]%8s[yellow]|[green]%10s[yellow]|[green]%12s[yellow]|[]\n",
-               "Node", "Calls", "Objects", "Realloc", "Objs/c", "KObjs/c", "Cycles/c");
+               "8s[yellow]|[green]%8s[yellow]|[green]%10s[yellow]|[green]%12s[yellow]|[green]%"
+               "10s[yellow]|[]\n",
+               "Node", "Calls", "Objects", "Realloc", "Objs/c", "KObjs/c", "Cycles/c", "p99 Cyc/o");
     border();
 }
 
@@ -72,20 +73,22 @@ print_node(const struct cne_graph_cluster_node_stats *stat)
     const uint64_t cycles     = stat->cycles;
     const uint64_t calls      = stat->calls;
     const uint64_t objs       = stat->objs;
-    uint64_t call_delta;
+    uint64_t call_delta, sampled_delta;
 
     call_delta      = calls - prev_calls;
+    sampled_delta   = stat->sampled_calls - stat->prev_sampled_calls;
     objs_per_call   = call_delta ? (double)((objs - prev_objs) / call_delta) : 0;
-    cycles_per_call = call_delta ? (double)((cycles - stat->prev_cycles) / call_delta) : 0;
+    cycles_per_call = sampled_delta ? (double)((cycles - stat->prev_cycles) / sampled_delta) : 0;
     ts_per_hz       = (double)((stat->ts - stat->prev_ts) / stat->hz);
     objs_per_sec    = ts_per_hz ? (objs - prev_objs) / ts_per_hz : 0;
     objs_per_sec /= 1000;
 
     cne_printf("[yellow]|[magenta]%-18s[yellow]|[cyan]%'15" PRIu64 "[yellow]|[cyan]%'15" PRIu64
                "[yellow]|[cyan]%'8" PRIu64
-               "[yellow]|[cyan]%'8.1f[yellow]|[orange]%'10.1f[yellow]|[orange]%'12.1f[yellow]|[]\n",
+               "[yellow]|[cyan]%'8.1f[yellow]|[orange]%'10.1f[yellow]|[orange]%'12.1f[yellow]|[orange]%'"
+               "10" PRIu64 "[yellow]|[]\n",
                stat->name, calls, objs, stat->realloc_count, objs_per_call, objs_per_sec,
-               cycles_per_call);
+               cycles_per_call, cne_graph_stats_cpo_percentile(stat, 99));
 }
 
 static int
@@ -324,9 +327,14 @@ static inline void
 cluster_node_arregate_stats(struct cluster_node *cluster)
 {
     uint64_t calls = 0, cycles = 0, objs = 0, realloc_count = 0;
+    uint64_t sampled_calls = 0, sampled_objs = 0;
     struct cne_graph_cluster_node_stats *stat = &cluster->stat;
     struct cne_node *node;
     cne_node_t count;
+    int i;
+
+    memset(stat->cpo_hist, 0, sizeof(stat->cpo_hist));
+    memset(stat->burst_hist, 0, sizeof(stat->burst_hist));
 
     for (count = 0; count < cluster->nb_nodes; count++) {
         node = cluster->nodes[count];
@@ -335,6 +343,13 @@ cluster_node_arregate_stats(struct cluster_node *cluster)
         objs += node->total_objs;
         cycles += node->total_cycles;
         realloc_count += node->realloc_count;
+        sampled_calls += node->sampled_calls;
+        sampled_objs += node->sampled_objs;
+
+        for (i = 0; i < CNE_GRAPH_STATS_CPO_BUCKETS; i++)
+            stat->cpo_hist[i] += node->cpo_hist[i];
+        for (i = 0; i < CNE_GRAPH_STATS_BURST_BUCKETS; i++)
+            stat->burst_hist[i] += node->burst_hist[i];
     }
 
     stat->calls         = calls;
@@ -342,6 +357,8 @@ cluster_node_arregate_stats(struct cluster_node *cluster)
     stat->cycles        = cycles;
     stat->ts            = cne_rdtsc();
     stat->realloc_count = realloc_count;
+    stat->sampled_calls = sampled_calls;
+    stat->sampled_objs  = sampled_objs;
 }
 
 static inline void
@@ -353,6 +370,9 @@ cluster_node_store_prev_stats(struct cluster_node *cluster)
     stat->prev_calls  = stat->calls;
     stat->prev_objs   = stat->objs;
     stat->prev_cycles = stat->cycles;
+
+    stat->prev_sampled_calls = stat->sampled_calls;
+    stat->prev_sampled_objs  = stat->sampled_objs;
 }
 
 void
@@ -381,6 +401,72 @@ cne_graph_stats_node_count(struct cne_graph_cluster_stats *stat)
     return (stat) ? (int)stat->max_nodes : -1;
 }
 
+const struct cne_graph_cluster_node_stats *
+cne_graph_stats_node_get(struct cne_graph_cluster_stats *stat, int idx)
+{
+    struct cluster_node *cluster;
+
+    if (!stat || idx < 0 || idx >= (int)stat->max_nodes)
+        return NULL;
+
+    cluster = CNE_PTR_ADD(stat->clusters, (size_t)idx * stat->cluster_node_size);
+
+    return &cluster->stat;
+}
+
+uint64_t
+cne_graph_stats_cpo_percentile(const struct cne_graph_cluster_node_stats *stat, double pct)
+{
+    uint64_t total = 0, sum = 0, target;
+    int i;
+
+    if (!stat || pct <= 0 || pct > 100)
+        return 0;
+
+    for (i = 0; i < CNE_GRAPH_STATS_CPO_BUCKETS; i++)
+        total += stat->cpo_hist[i];
+    if (total == 0)
+        return 0;
+
+    target = (uint64_t)((double)total * pct / 100);
+    if (target == 0)
+        target = 1;
+
+    for (i = 0; i < CNE_GRAPH_STATS_CPO_BUCKETS - 1; i++) {
+        sum += stat->cpo_hist[i];
+        if (sum >= target)
+            break;
+    }
+
+    /* The last bucket has no upper bound, return where it starts */
+    if (i == CNE_GRAPH_STATS_CPO_BUCKETS - 1)
+        return 1ULL << i;
+
+    return (2ULL << i) - 1;
+}
+
+int
+cne_graph_stats_sample_set(cne_graph_t id, uint32_t period)
+{
+    struct graph *graph;
+    int rc = -EINVAL;
+
+    if (period == 0 || !cne_is_power_of_2(period))
+        return -EINVAL;
+
+    graph_spinlock_lock();
+    STAILQ_FOREACH (graph, graph_list_head_get(), next) {
+        if (graph->id == id) {
+            graph->graph->sample_mask = period - 1;
+            rc                        = 0;
+            break;
+        }
+    }
+    graph_spinlock_unlock();
+
+    return rc;
+}
+
 void
 cne_graph_cluster_stats_reset(struct cne_graph_cluster_stats *stat)
 {
@@ -401,6 +487,14 @@ cne_graph_cluster_stats_reset(struct cne_graph_cluster_stats *stat)
         node->prev_objs     = 0;
         node->prev_cycles   = 0;
         node->realloc_count = 0;
-        cluster             = CNE_PTR_ADD(cluster, stat->cluster_node_size);
+
+        node->sampled_calls      = 0;
+        node->sampled_objs       = 0;
+        node->prev_sampled_calls = 0;
+        node->prev_sampled_objs  = 0;
+        memset(node->cpo_hist, 0, sizeof(node->cpo_hist));
+        memset(node->burst_hist, 0, sizeof(node->burst_hist));
+
+        cluster = CNE_PTR_ADD(cluster, stat->cluster_node_size);
     }
 }
@@ -0,0 +1,536 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <errno.h>             // for EINVAL, ENOMEM, ENOENT, errno
+#include <inttypes.h>          // for PRIu64
+#include <stdbool.h>           // for bool, true, false
+#include <stdio.h>             // for FILE, fopen, fwrite, fprintf
+#include <stdlib.h>            // for calloc, realloc, free, qsort
+#include <string.h>            // for memset, memcpy, strlen
+#include <time.h>              // for clock_gettime, timespec
+#include <sys/queue.h>         // for STAILQ_FOREACH
+#include <cne_common.h>        // for CNE_MIN, CNE_ALIGN_CEIL, cne_is_power_of_2
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_system.h>        // for cne_get_timer_hz
+
+#include "graph_private.h"           // for graph, graph_node, graph_spinlock_lock
+#include "cne_graph.h"               // for cne_graph_trace_param, cne_graph_trace_rec
+#include "cne_graph_worker.h"        // for cne_graph, cne_node
+
+/* Traced objects in flight in a graph, a power of 2 */
+#define GRAPH_TRACE_OBJS_LOG2 10
+#define GRAPH_TRACE_OBJS      (1 << GRAPH_TRACE_OBJS_LOG2)
+
+/* Longest comment of a packet in the pcapng file */
+#define GRAPH_TRACE_COMMENT_SZ 1024
+
+/* pcapng block types, options and link type */
+#define PCAPNG_SHB          0x0A0D0D0A
+#define PCAPNG_IDB          0x00000001
+#define PCAPNG_EPB          0x00000006
+#define PCAPNG_MAGIC        0x1A2B3C4D
+#define PCAPNG_OPT_COMMENT  1
+#define PCAPNG_OPT_TSRESOL  9
+#define PCAPNG_LINK_ETHER   1
+#define PCAPNG_EPB_HDR_SIZE 20
+
+/* Object of a traced packet and the node which enqueued it */
+struct graph_trace_obj {
+    void *obj;
+    struct cne_node *prev;
+    uint32_t pkt;
+};
+
+/* Data of a traced packet */
+struct graph_trace_pkt {
+    uint32_t pkt;
+    uint32_t len;
+    uint32_t caplen;
+    uint8_t data[CNE_GRAPH_TRACE_SNAPLEN];
+};
+
+struct cne_graph_trace {
+    struct cne_graph_trace_param prm;
+    uint32_t count;      /* Objects which passed the filter */
+    uint32_t last_pkt;   /* Last trace id given */
+    uint64_t head;       /* Hops written to the ring */
+    uint32_t mask;       /* Hops in the ring minus 1 */
+    uint64_t tsc0;       /* TSC at enable time */
+    uint64_t ns0;        /* Wall clock of tsc0 in ns */
+    uint16_t *snap;      /* Objects pending in the next nodes of a source node */
+    uint32_t nb_snap;    /* Entries in snap, the edges of a node plus one */
+    struct cne_graph_trace *retired; /* Replaced traces, freed with the graph */
+    struct graph_trace_obj objs[GRAPH_TRACE_OBJS];
+    struct graph_trace_pkt pkts[CNE_GRAPH_TRACE_PKTS];
+    struct cne_graph_trace_rec recs[];
+};
+
+static inline struct graph_trace_obj *
+graph_trace_obj(struct cne_graph_trace *trace, void *obj)
+{
+    uint64_t h = ((uintptr_t)obj >> 6) * 0x9E3779B97F4A7C15ULL;
+
+    return &trace->objs[h >> (64 - GRAPH_TRACE_OBJS_LOG2)];
+}
+
+static inline void
+graph_trace_rec(struct cne_graph_trace *trace, uint32_t pkt, cne_node_t node, cne_edge_t edge,
+                uint64_t tsc)
+{
+    struct cne_graph_trace_rec *rec = &trace->recs[trace->head & trace->mask];
+
+    rec->tsc  = tsc;
+    rec->pkt  = pkt;
+    rec->node = node;
+    rec->edge = edge;
+
+    /* Readers copy the hops up to head */
+    __atomic_store_n(&trace->head, trace->head + 1, __ATOMIC_RELEASE);
+}
+
+void
+__cne_graph_trace_pre(struct cne_graph_trace *trace, struct cne_node *node, bool src)
+{
+    struct graph_trace_obj *o;
+    uint64_t tsc = 0;
+    cne_edge_t e;
+
+    if (src) {
+        for (e = 0; e < node->nb_edges; e++)
+            trace->snap[e] = node->nodes[e]->idx;
+        return;
+    }
+
+    for (uint16_t i = 0; i < node->idx; i++) {
+        o = graph_trace_obj(trace, node->objs[i]);
+        if (o->obj != node->objs[i])
+            continue;
+
+        for (e = 0; e < o->prev->nb_edges; e++)
+            if (o->prev->nodes[e] == node)
+                break;
+        if (tsc == 0)
+            tsc = cne_rdtsc();
+        graph_trace_rec(trace, o->pkt, node->id,
+                        e < o->prev->nb_edges ? e : CNE_EDGE_ID_INVALID, tsc);
+
+        /* The path of the packet ends in a node without edges */
+        o->prev = node;
+        if (node->nb_edges == 0)
+            o->obj = NULL;
+    }
+}
+
+void
+__cne_graph_trace_post(struct cne_graph_trace *trace, struct cne_node *node)
+{
+    const struct cne_graph_trace_param *prm = &trace->prm;
+    struct graph_trace_pkt *p;
+    struct graph_trace_obj *o;
+    struct cne_node *next;
+    uint64_t tsc = 0;
+    const void *data;
+    void *obj;
+
+    for (cne_edge_t e = 0; e < node->nb_edges; e++) {
+        next = node->nodes[e];
+
+        for (uint16_t i = trace->snap[e]; i < next->idx; i++) {
+            obj = next->objs[i];
+            o   = graph_trace_obj(trace, obj);
+
+            /* The object of a packet whose trace was lost is reused */
+            if (o->obj == obj)
+                o->obj = NULL;
+
+            if (prm->filter && !prm->filter(obj, prm->arg))
+                continue;
+            if (trace->count++ % prm->sample)
+                continue;
+
+            if (tsc == 0)
+                tsc = cne_rdtsc();
+            o->obj  = obj;
+            o->prev = node;
+            o->pkt  = ++trace->last_pkt;
+            graph_trace_rec(trace, o->pkt, node->id, CNE_EDGE_ID_INVALID, tsc);
+
+            p      = &trace->pkts[o->pkt & (CNE_GRAPH_TRACE_PKTS - 1)];
+            p->pkt = 0;
+            if (prm->data && (data = prm->data(obj, &p->len, prm->arg)) != NULL) {
+                p->caplen = CNE_MIN(p->len, (uint32_t)CNE_GRAPH_TRACE_SNAPLEN);
+                memcpy(p->data, data, p->caplen);
+                __atomic_store_n(&p->pkt, o->pkt, __ATOMIC_RELEASE);
+            }
+        }
+    }
+}
+
+static struct graph *
+graph_trace_find(cne_graph_t id)
+{
+    struct graph *graph;
+
+    STAILQ_FOREACH (graph, graph_list_head_get(), next)
+        if (graph->id == id)
+            return graph;
+
+    return NULL;
+}
+
+static void
+graph_trace_destroy(struct cne_graph_trace *trace)
+{
+    struct cne_graph_trace *next;
+
+    for (; trace; trace = next) {
+        next = trace->retired;
+        free(trace->snap);
+        free(trace);
+    }
+}
+
+int
+cne_graph_trace_enable(cne_graph_t id, const struct cne_graph_trace_param *prm)
+{
+    struct cne_graph_trace *trace = NULL, *old;
+    struct graph_node *graph_node;
+    cne_edge_t max_edges = 0;
+    uint32_t nb_recs;
+    struct timespec ts;
+    struct graph *graph;
+    int rc;
+
+    if (!prm)
+        return -EINVAL;
+    nb_recs = prm->nb_recs ? prm->nb_recs : CNE_GRAPH_TRACE_RECS;
+    if (!cne_is_power_of_2(nb_recs))
+        return -EINVAL;
+
+    graph_spinlock_lock();
+
+    graph = graph_trace_find(id);
+    if (!graph)
+        SET_ERR_JMP(EINVAL, fail, "Graph %u not found", id);
+
+    STAILQ_FOREACH (graph_node, &graph->node_list, next)
+        max_edges = CNE_MAX(max_edges, graph_node->node->nb_edges);
+
+    /* A restart uses a new trace, the walker may still use the old one */
+    trace = calloc(1, sizeof(*trace) + nb_recs * sizeof(struct cne_graph_trace_rec));
+    if (!trace)
+        SET_ERR_JMP(ENOMEM, fail, "Unable to allocate trace of graph %s", graph->name);
+    trace->snap = calloc(max_edges + 1, sizeof(uint16_t));
+    if (!trace->snap) {
+        free(trace);
+        SET_ERR_JMP(ENOMEM, fail, "Unable to allocate trace of graph %s", graph->name);
+    }
+    trace->nb_snap = max_edges + 1;
+    trace->mask    = nb_recs - 1;
+
+    old = graph->trace;
+    if (old) {
+        __atomic_store_n(&graph->graph->trace, NULL, __ATOMIC_RELEASE);
+        if (graph->graph->qsbr) {
+            cne_rcu_qsbr_synchronize(graph->graph->qsbr, CNE_QSBR_THRID_INVALID);
+            trace->retired = old->retired;
+            old->retired   = NULL;
+            graph_trace_destroy(old);
+        } else {
+            /* Without QSBR the walker is only known to be done when the graph is destroyed */
+            trace->retired = old;
+        }
+    }
+    graph->trace = trace;
+
+    trace->prm = *prm;
+    if (trace->prm.sample == 0)
+        trace->prm.sample = 1;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    trace->tsc0 = cne_rdtsc();
+    trace->ns0  = (uint64_t)ts.tv_sec * NS_PER_S + ts.tv_nsec;
+
+    __atomic_store_n(&graph->graph->trace, trace, __ATOMIC_RELEASE);
+
+    graph_spinlock_unlock();
+    return 0;
+fail:
+    rc = -errno;
+    graph_spinlock_unlock();
+    return rc;
+}
+
+int
+cne_graph_trace_disable(cne_graph_t id)
+{
+    struct graph *graph;
+    int rc = -EINVAL;
+
+    graph_spinlock_lock();
+    graph = graph_trace_find(id);
+    if (graph) {
+        __atomic_store_n(&graph->graph->trace, NULL, __ATOMIC_RELEASE);
+        rc = 0;
+    }
+    graph_spinlock_unlock();
+
+    return rc;
+}
+
+void
+graph_trace_free(struct graph *graph)
+{
+    if (!graph->trace)
+        return;
+
+    graph->graph->trace = NULL;
+    graph_trace_destroy(graph->trace);
+    graph->trace = NULL;
+}
+
+/* Copy the last nb hops of a trace ring, called with the graph lock held */
+static uint32_t
+graph_trace_copy(struct cne_graph_trace *trace, struct cne_graph_trace_rec *recs, uint32_t nb)
+{
+    uint64_t head, start, end, lost;
+    uint32_t n;
+
+    head  = __atomic_load_n(&trace->head, __ATOMIC_ACQUIRE);
+    n     = CNE_MIN(nb, (uint64_t)CNE_MIN(head, (uint64_t)trace->mask + 1));
+    start = head - n;
+
+    for (uint32_t i = 0; i < n; i++)
+        recs[i] = trace->recs[(start + i) & trace->mask];
+
+    /* Drop the hops the walker overwrote while they were copied */
+    end = __atomic_load_n(&trace->head, __ATOMIC_ACQUIRE);
+    if (end - start > (uint64_t)trace->mask + 1) {
+        lost = end - start - trace->mask - 1;
+        if (lost >= n)
+            return 0;
+        memmove(recs, &recs[lost], (n - lost) * sizeof(*recs));
+        n -= lost;
+    }
+
+    return n;
+}
+
+int
+cne_graph_trace_get(cne_graph_t id, struct cne_graph_trace_rec *recs, uint32_t nb)
+{
+    struct graph *graph;
+    int rc = -EINVAL;
+
+    if (!recs)
+        return -EINVAL;
+
+    graph_spinlock_lock();
+    graph = graph_trace_find(id);
+    if (graph)
+        rc = graph->trace ? (int)graph_trace_copy(graph->trace, recs, nb) : 0;
+    graph_spinlock_unlock();
+
+    return rc;
+}
+
+static int
+graph_trace_rec_cmp(const void *a, const void *b)
+{
+    const struct cne_graph_trace_rec *ra = a, *rb = b;
+
+    if (ra->pkt != rb->pkt)
+        return ra->pkt < rb->pkt ? -1 : 1;
+    if (ra->tsc != rb->tsc)
+        return ra->tsc < rb->tsc ? -1 : 1;
+    return 0;
+}
+
+/* Copy the hops of a trace ring grouped by packet, called with the graph lock held */
+static struct cne_graph_trace_rec *
+graph_trace_sorted(struct cne_graph_trace *trace, uint32_t *nb)
+{
+    struct cne_graph_trace_rec *recs;
+
+    recs = calloc(trace->mask + 1, sizeof(*recs));
+    if (!recs)
+        return NULL;
+
+    *nb = graph_trace_copy(trace, recs, trace->mask + 1);
+    qsort(recs, *nb, sizeof(*recs), graph_trace_rec_cmp);
+
+    return recs;
+}
+
+/* Write the path of the packet of recs[0] and return its number of hops */
+static uint32_t
+graph_trace_path(const struct cne_graph_trace_rec *recs, uint32_t nb, char *buf, size_t sz)
+{
+    uint32_t i;
+    size_t len;
+
+    len = snprintf(buf, sz, "%s", cne_node_id_to_name(recs[0].node));
+    for (i = 1; i < nb && recs[i].pkt == recs[0].pkt; i++) {
+        if (len >= sz)
+            continue;
+        if (recs[i].edge == CNE_EDGE_ID_INVALID)
+            len += snprintf(buf + len, sz - len, " -> %s", cne_node_id_to_name(recs[i].node));
+        else
+            len += snprintf(buf + len, sz - len, " -%u-> %s", recs[i].edge,
+                            cne_node_id_to_name(recs[i].node));
+        if (len < sz)
+            len += snprintf(buf + len, sz - len, " (+%" PRIu64 ")", recs[i].tsc - recs[0].tsc);
+    }
+
+    return i;
+}
+
+void
+cne_graph_trace_dump(FILE *f, cne_graph_t id)
+{
+    struct cne_graph_trace_rec *recs;
+    char path[GRAPH_TRACE_COMMENT_SZ];
+    struct graph *graph;
+    uint32_t nb, i;
+
+    if (!f)
+        f = stdout;
+
+    graph_spinlock_lock();
+
+    graph = graph_trace_find(id);
+    if (!graph || !graph->trace)
+        goto done;
+
+    recs = graph_trace_sorted(graph->trace, &nb);
+    if (!recs)
+        goto done;
+
+    fprintf(f, "graph <%s> trace %s, %u hops, %u packets traced\n", graph->name,
+            graph->graph->trace ? "on" : "off", nb, graph->trace->last_pkt);
+    for (i = 0; i < nb;) {
+        fprintf(f, "  pkt %-8u", recs[i].pkt);
+        i += graph_trace_path(&recs[i], nb - i, path, sizeof(path));
+        fprintf(f, " %s\n", path);
+    }
+    free(recs);
+done:
+    graph_spinlock_unlock();
+}
+
+static int
+graph_pcapng_block(FILE *f, uint32_t type, const void *body, uint32_t len, uint16_t opt,
+                   const void *val, uint16_t vlen)
+{
+    static const uint8_t pad[4];
+    uint32_t total, blen, olen;
+    uint16_t hdr[2];
+
+    blen  = CNE_ALIGN_CEIL(len, 4);
+    olen  = opt ? 4 + CNE_ALIGN_CEIL(vlen, 4) + 4 : 0;
+    total = 12 + blen + olen;
+
+    if (fwrite(&type, 4, 1, f) != 1 || fwrite(&total, 4, 1, f) != 1 ||
+        fwrite(body, 1, len, f) != len || fwrite(pad, 1, blen - len, f) != blen - len)
+        return -1;
+
+    if (opt) {
+        hdr[0] = opt;
+        hdr[1] = vlen;
+        olen = CNE_ALIGN_CEIL(vlen, 4) - vlen;
+        if (fwrite(hdr, sizeof(hdr), 1, f) != 1 || fwrite(val, 1, vlen, f) != vlen ||
+            fwrite(pad, 1, olen, f) != olen || fwrite(pad, 4, 1, f) != 1)
+            return -1;
+    }
+
+    return fwrite(&total, 4, 1, f) == 1 ? 0 : -1;
+}
+
+static int
+graph_pcapng_header(FILE *f)
+{
+    /* Byte order magic, version 1.0 and unknown section length */
+    const uint32_t shb[4] = {PCAPNG_MAGIC, 1, UINT32_MAX, UINT32_MAX};
+    const uint32_t idb[2] = {PCAPNG_LINK_ETHER, CNE_GRAPH_TRACE_SNAPLEN};
+    const uint8_t tsresol = 9; /* Timestamps in ns */
+
+    if (graph_pcapng_block(f, PCAPNG_SHB, shb, sizeof(shb), 0, NULL, 0) < 0 ||
+        graph_pcapng_block(f, PCAPNG_IDB, idb, sizeof(idb), PCAPNG_OPT_TSRESOL, &tsresol, 1) < 0)
+        return -1;
+
+    return 0;
+}
+
+int
+cne_graph_trace_pcapng_save(cne_graph_t id, const char *filename)
+{
+    uint8_t epb[PCAPNG_EPB_HDR_SIZE + CNE_GRAPH_TRACE_SNAPLEN];
+    struct cne_graph_trace_rec *recs = NULL;
+    char path[GRAPH_TRACE_COMMENT_SZ];
+    struct cne_graph_trace *trace;
+    struct graph_trace_pkt *p;
+    uint64_t hz, ns;
+    uint32_t nb, i, n, hdr[5];
+    struct graph *graph;
+    FILE *f = NULL;
+    int rc, cnt = 0;
+
+    if (!filename)
+        return -EINVAL;
+
+    graph_spinlock_lock();
+
+    graph = graph_trace_find(id);
+    if (!graph)
+        SET_ERR_JMP(EINVAL, fail, "Graph %u not found", id);
+    trace = graph->trace;
+    if (!trace)
+        SET_ERR_JMP(ENOENT, fail, "Graph %s has no trace", graph->name);
+
+    recs = graph_trace_sorted(trace, &nb);
+    if (!recs)
+        SET_ERR_JMP(ENOMEM, fail, "Unable to copy the trace of graph %s", graph->name);
+
+    f = fopen(filename, "w");
+    if (!f || graph_pcapng_header(f) < 0)
+        SET_ERR_JMP(EIO, fail, "Unable to write %s", filename);
+
+    hz = cne_get_timer_hz();
+    for (i = 0; i < nb; i += n) {
+        n = graph_trace_path(&recs[i], nb - i, path, sizeof(path));
+
+        /* Packets without data or whose data was reused by a newer packet */
+        p = &trace->pkts[recs[i].pkt & (CNE_GRAPH_TRACE_PKTS - 1)];
+        if (__atomic_load_n(&p->pkt, __ATOMIC_ACQUIRE) != recs[i].pkt)
+            continue;
+
+        ns = trace->ns0;
+        if (hz && recs[i].tsc > trace->tsc0)
+            ns += (uint64_t)((double)(recs[i].tsc - trace->tsc0) * NS_PER_S / hz);
+
+        hdr[0] = 0; /* Interface id */
+        hdr[1] = ns >> 32;
+        hdr[2] = (uint32_t)ns;
+        hdr[3] = p->caplen;
+        hdr[4] = p->len;
+        memcpy(epb, hdr, sizeof(hdr));
+        memcpy(&epb[PCAPNG_EPB_HDR_SIZE], p->data, p->caplen);
+
+        if (graph_pcapng_block(f, PCAPNG_EPB, epb, PCAPNG_EPB_HDR_SIZE + p->caplen,
+                               PCAPNG_OPT_COMMENT, path, strlen(path)) < 0)
+            SET_ERR_JMP(EIO, fail, "Unable to write %s", filename);
+        cnt++;
+    }
+
+    free(recs);
+    rc = fclose(f);
+    graph_spinlock_unlock();
+    return rc ? -EIO : cnt;
+fail:
+    rc = -errno;
+    free(recs);
+    if (f)
+        fclose(f);
+    graph_spinlock_unlock();
+    return rc;
+}
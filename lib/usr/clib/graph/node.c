@@ -103,6 +103,7 @@ __cne_node_register(const struct cne_node_register *reg)
     node->fini      = reg->fini;
     node->nb_edges  = reg->nb_edges;
     node->parent_id = reg->parent_id;
+    node->worker    = CNE_GRAPH_DISPATCH_ANY;
     for (i = 0; i < reg->nb_edges; i++) {
         if (strlcpy(node->next_nodes[i], reg->next_nodes[i], CNE_NODE_NAMESIZE) == 0) {
             errno = E2BIG;
@@ -0,0 +1,351 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cne_acl.h>                 // for cne_acl_classify, cne_acl_build, cne_acl_...
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue_x1
+#include <cne_rcu_qsbr.h>            // for cne_rcu_qsbr_synchronize
+#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <net/cne_ether.h>           // for cne_ether_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod_offset
+#include <endian.h>                  // for htobe16
+#include <errno.h>                   // for EINVAL, ENOMEM
+#include <netinet/in.h>              // for IPPROTO_TCP, IPPROTO_UDP, IPPROTO_SCTP
+#include <stddef.h>                  // for offsetof
+#include <stdint.h>                  // for uint16_t, uint32_t, uint8_t
+#include <stdio.h>                   // for snprintf
+#include <stdlib.h>                  // for calloc, free
+#include <string.h>                  // for memcpy, NULL
+
+#include "node_acl_api.h"                 // for CNE_NODE_IP4_ACL_NEXT_IP4_LOOKUP
+#include "node_private.h"                 // for node_err, node_dbg
+#include "cne_branch_prediction.h"        // for likely, unlikely
+#include "cne_common.h"                   // for CNE_BUILD_BUG_ON, CNE_MIN
+#include "cne_prefetch.h"                 // for cne_prefetch0
+
+/* Input of the classify, the fields of a packet in network byte order */
+struct ip4_acl_tuple {
+    uint8_t proto;
+    uint8_t pad[3];
+    uint32_t src_addr;
+    uint32_t dst_addr;
+    union {
+        struct {
+            uint16_t src_port;
+            uint16_t dst_port;
+        };
+        uint32_t ports;
+    };
+};
+
+// clang-format off
+static const struct cne_acl_field_def ip4_acl_defs[CNE_NODE_IP4_ACL_FIELD_NUM] = {
+    {
+        .type        = CNE_ACL_FIELD_TYPE_BITMASK,
+        .size        = sizeof(uint8_t),
+        .field_index = CNE_NODE_IP4_ACL_FIELD_PROTO,
+        .input_index = CNE_NODE_IP4_ACL_FIELD_PROTO,
+        .offset      = offsetof(struct ip4_acl_tuple, proto),
+    },
+    {
+        .type        = CNE_ACL_FIELD_TYPE_MASK,
+        .size        = sizeof(uint32_t),
+        .field_index = CNE_NODE_IP4_ACL_FIELD_SRC,
+        .input_index = CNE_NODE_IP4_ACL_FIELD_SRC,
+        .offset      = offsetof(struct ip4_acl_tuple, src_addr),
+    },
+    {
+        .type        = CNE_ACL_FIELD_TYPE_MASK,
+        .size        = sizeof(uint32_t),
+        .field_index = CNE_NODE_IP4_ACL_FIELD_DST,
+        .input_index = CNE_NODE_IP4_ACL_FIELD_DST,
+        .offset      = offsetof(struct ip4_acl_tuple, dst_addr),
+    },
+    {
+        .type        = CNE_ACL_FIELD_TYPE_RANGE,
+        .size        = sizeof(uint16_t),
+        .field_index = CNE_NODE_IP4_ACL_FIELD_SRC_PORT,
+        .input_index = CNE_NODE_IP4_ACL_FIELD_SRC_PORT,
+        .offset      = offsetof(struct ip4_acl_tuple, src_port),
+    },
+    {
+        /* both ports are read in the same 4 bytes */
+        .type        = CNE_ACL_FIELD_TYPE_RANGE,
+        .size        = sizeof(uint16_t),
+        .field_index = CNE_NODE_IP4_ACL_FIELD_DST_PORT,
+        .input_index = CNE_NODE_IP4_ACL_FIELD_SRC_PORT,
+        .offset      = offsetof(struct ip4_acl_tuple, dst_port),
+    },
+};
+// clang-format on
+
+/* IP4 ACL global data struct */
+struct ip4_acl_node_main {
+    struct cne_acl_ctx *acx; /**< Current ACL context, NULL without rules */
+    struct cne_rcu_qsbr *v;  /**< QSBR variable of the walkers */
+    uint16_t default_next;   /**< Edge of the packets not matching any rule */
+    uint32_t gen;            /**< Number of contexts built */
+};
+
+/* Per node classify input and output */
+struct ip4_acl_node_data {
+    struct ip4_acl_tuple tuples[CNE_GRAPH_BURST_SIZE];
+    const uint8_t *data[CNE_GRAPH_BURST_SIZE];
+    uint32_t results[CNE_GRAPH_BURST_SIZE];
+};
+
+struct ip4_acl_node_ctx {
+    struct ip4_acl_node_data *nd; /**< Classify buffers */
+};
+
+static struct ip4_acl_node_main ip4_acl_nm = {
+    .default_next = CNE_NODE_IP4_ACL_NEXT_IP4_LOOKUP,
+};
+
+#define IP4_ACL_NODE_DATA(ctx) (((struct ip4_acl_node_ctx *)ctx)->nd)
+
+static __cne_always_inline void
+ip4_acl_extract(pktmbuf_t *mbuf, struct ip4_acl_tuple *t)
+{
+    struct cne_ipv4_hdr *ip;
+    const uint8_t *l4;
+
+    ip = pktmbuf_mtod_offset(mbuf, struct cne_ipv4_hdr *, sizeof(struct cne_ether_hdr));
+
+    t->proto    = ip->next_proto_id;
+    t->src_addr = ip->src_addr;
+    t->dst_addr = ip->dst_addr;
+
+    /* Only the first fragment holds the L4 header */
+    if ((ip->next_proto_id == IPPROTO_TCP || ip->next_proto_id == IPPROTO_UDP ||
+         ip->next_proto_id == IPPROTO_SCTP) &&
+        !(ip->fragment_offset & htobe16(CNE_IPV4_HDR_OFFSET_MASK))) {
+        l4 = (const uint8_t *)ip +
+             (ip->version_ihl & CNE_IPV4_HDR_IHL_MASK) * CNE_IPV4_IHL_MULTIPLIER;
+        memcpy(&t->ports, l4, sizeof(t->ports));
+    } else
+        t->ports = 0;
+}
+
+static uint16_t
+ip4_acl_node_process(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    struct ip4_acl_node_data *nd = IP4_ACL_NODE_DATA(node->ctx);
+    const struct cne_acl_ctx *acx;
+    pktmbuf_t **pkts = (pktmbuf_t **)objs;
+    cne_edge_t next_index, next0, def_next;
+    void **to_next, **from;
+    uint16_t last_spec = 0;
+    uint16_t held      = 0;
+    uint16_t i, j, n;
+
+    acx        = __atomic_load_n(&ip4_acl_nm.acx, __ATOMIC_ACQUIRE);
+    def_next   = __atomic_load_n(&ip4_acl_nm.default_next, __ATOMIC_RELAXED);
+    next_index = def_next;
+
+    /* Without rules all the packets take the default edge */
+    if (unlikely(acx == NULL)) {
+        cne_node_next_stream_move(graph, node, next_index);
+        return nb_objs;
+    }
+
+    from = objs;
+
+    /* Get stream for the speculated next node */
+    to_next = cne_node_next_stream_get(graph, node, next_index, nb_objs);
+
+    for (i = 0; i < nb_objs; i += n) {
+        n = CNE_MIN(nb_objs - i, CNE_GRAPH_BURST_SIZE);
+
+        for (j = 0; j < n && j < 4; j++)
+            cne_prefetch0(pktmbuf_mtod_offset(pkts[i + j], void *, sizeof(struct cne_ether_hdr)));
+
+        /* Gather the fields of the packets in the layout of the ACL */
+        for (j = 0; j < n; j++) {
+            if (likely(j + 4 < n))
+                cne_prefetch0(
+                    pktmbuf_mtod_offset(pkts[i + j + 4], void *, sizeof(struct cne_ether_hdr)));
+            ip4_acl_extract(pkts[i + j], &nd->tuples[j]);
+        }
+
+        /* One classify for the whole burst */
+        if (unlikely(cne_acl_classify(acx, nd->data, nd->results, n, 1) != 0))
+            memset(nd->results, 0, n * sizeof(nd->results[0]));
+
+        for (j = 0; j < n; j++) {
+            next0 = likely(nd->results[j]) ? nd->results[j] - 1 : def_next;
+
+            if (unlikely(next_index ^ next0)) {
+                /* Copy things successfully speculated till now */
+                memcpy(to_next, from, last_spec * sizeof(from[0]));
+                from += last_spec;
+                to_next += last_spec;
+                held += last_spec;
+                last_spec = 0;
+
+                cne_node_enqueue_x1(graph, node, next0, from[0]);
+                from += 1;
+            } else
+                last_spec += 1;
+        }
+    }
+
+    /* !!! Home run !!! */
+    if (likely(last_spec == nb_objs)) {
+        cne_node_next_stream_move(graph, node, next_index);
+        return nb_objs;
+    }
+
+    held += last_spec;
+
+    /* Copy things successfully speculated till now */
+    memcpy(to_next, from, last_spec * sizeof(from[0]));
+    cne_node_next_stream_put(graph, node, next_index, held);
+
+    return nb_objs;
+}
+
+static int
+ip4_acl_rules_check(const struct cne_node_ip4_acl_rule *rules, uint32_t num)
+{
+    cne_edge_t nb_edges;
+
+    nb_edges = cne_node_edge_count(cne_node_from_name("ip4_acl"));
+    if (nb_edges == CNE_EDGE_ID_INVALID)
+        return -EINVAL;
+
+    for (uint32_t i = 0; i < num; i++) {
+        if (rules[i].data.userdata == 0 || rules[i].data.userdata > nb_edges ||
+            !(rules[i].data.category_mask & 1)) {
+            node_err("ip4_acl", "Rule %u has an invalid edge %u or category mask 0x%x", i,
+                     rules[i].data.userdata, rules[i].data.category_mask);
+            return -EINVAL;
+        }
+    }
+
+    return 0;
+}
+
+int
+cne_node_ip4_acl_rules_set(const struct cne_node_ip4_acl_rule *rules, uint32_t num)
+{
+    struct cne_acl_param param = {0};
+    struct cne_acl_config cfg  = {0};
+    struct cne_acl_ctx *acx    = NULL;
+    char name[CNE_ACL_NAMESIZE];
+    int rc;
+
+    if (num && !rules)
+        return -EINVAL;
+
+    rc = ip4_acl_rules_check(rules, num);
+    if (rc)
+        return rc;
+
+    if (num) {
+        snprintf(name, sizeof(name), "ip4_acl%u", ip4_acl_nm.gen++);
+        param.name         = name;
+        param.rule_size    = sizeof(struct cne_node_ip4_acl_rule);
+        param.max_rule_num = num;
+
+        acx = cne_acl_create(&param);
+        if (!acx)
+            return -ENOMEM;
+
+        cfg.num_categories = 1;
+        cfg.num_fields     = CNE_NODE_IP4_ACL_FIELD_NUM;
+        memcpy(cfg.defs, ip4_acl_defs, sizeof(ip4_acl_defs));
+
+        rc = cne_acl_add_rules(acx, (const struct cne_acl_rule *)rules, num);
+        if (rc == 0)
+            rc = cne_acl_build(acx, &cfg);
+        if (rc) {
+            node_err("ip4_acl", "Unable to build %u rules, rc=%d", num, rc);
+            cne_acl_free(acx);
+            return rc;
+        }
+    }
+
+    /* The walkers pick the new context on their next burst */
+    acx = __atomic_exchange_n(&ip4_acl_nm.acx, acx, __ATOMIC_ACQ_REL);
+
+    if (acx) {
+        if (ip4_acl_nm.v)
+            cne_rcu_qsbr_synchronize(ip4_acl_nm.v, CNE_QSBR_THRID_INVALID);
+        cne_acl_free(acx);
+    }
+
+    node_dbg("ip4_acl", "ACL: %u rules set", num);
+
+    return 0;
+}
+
+int
+cne_node_ip4_acl_default_set(uint16_t next)
+{
+    if (next >= cne_node_edge_count(cne_node_from_name("ip4_acl")))
+        return -EINVAL;
+
+    __atomic_store_n(&ip4_acl_nm.default_next, next, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+int
+cne_node_ip4_acl_qsbr_add(struct cne_rcu_qsbr *v)
+{
+    ip4_acl_nm.v = v;
+
+    return 0;
+}
+
+static int
+ip4_acl_node_init(const struct cne_graph *graph, struct cne_node *node)
+{
+    struct ip4_acl_node_data *nd;
+
+    CNE_SET_USED(graph);
+    CNE_BUILD_BUG_ON(sizeof(struct ip4_acl_node_ctx) > CNE_NODE_CTX_SZ);
+
+    nd = calloc(1, sizeof(*nd));
+    if (!nd) {
+        node_err("ip4_acl", "Unable to allocate classify buffers");
+        return -ENOMEM;
+    }
+
+    for (int i = 0; i < CNE_GRAPH_BURST_SIZE; i++)
+        nd->data[i] = (const uint8_t *)&nd->tuples[i];
+
+    IP4_ACL_NODE_DATA(node->ctx) = nd;
+
+    node_dbg("ip4_acl", "Initialized ip4_acl node");
+
+    return 0;
+}
+
+static void
+ip4_acl_node_fini(const struct cne_graph *graph, struct cne_node *node)
+{
+    CNE_SET_USED(graph);
+
+    free(IP4_ACL_NODE_DATA(node->ctx));
+    IP4_ACL_NODE_DATA(node->ctx) = NULL;
+}
+
+static struct cne_node_register ip4_acl_node = {
+    .process = ip4_acl_node_process,
+    .name    = "ip4_acl",
+
+    .init = ip4_acl_node_init,
+    .fini = ip4_acl_node_fini,
+
+    .nb_edges = CNE_NODE_IP4_ACL_NEXT_MAX,
+    .next_nodes =
+        {
+            [CNE_NODE_IP4_ACL_NEXT_PKT_DROP]   = "pkt_drop",
+            [CNE_NODE_IP4_ACL_NEXT_IP4_LOOKUP] = "ip4_lookup",
+        },
+};
+
+CNE_NODE_REGISTER(ip4_acl_node);
@@ -0,0 +1,111 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
+#include <cne_graph_worker.h>        // for cne_node_enqueue, cne_node_enqueue_x1
+#include <net/cne_ether.h>           // for cne_ether_hdr
+#include <pktmbuf.h>                 // for pktmbuf_t
+#include <ip_frag.h>                 // for ip_frag_ipv4, IP_FRAG_MAX_OUT
+#include <errno.h>                   // for EINVAL
+#include <stdbool.h>                 // for true, bool
+#include <stddef.h>                  // for offsetof
+#include <stdint.h>                  // for uint16_t
+
+#include "ip4_frag_priv.h"           // for ip4_frag_node_main, IP4_FRAG_NEXT_PKT_DROP
+#include "ip4_rewrite_priv.h"        // for ip4_rewrite_node_data_get, ip4_rewrite_nh_header
+#include "node_private.h"            // for node_mbuf_priv1, node_dbg
+#include "cne_common.h"              // for CNE_BUILD_BUG_ON, CNE_SET_USED
+#include "cne_log.h"                 // for CNE_LOG_DEBUG
+
+struct ip4_frag_node_ctx {
+    /* Dynamic offset to mbuf priv1 */
+    int mbuf_priv1_off;
+};
+
+static struct ip4_frag_node_main ip4_frag_nm;
+
+#define IP4_FRAG_NODE_PRIV1_OFF(ctx) (((struct ip4_frag_node_ctx *)ctx)->mbuf_priv1_off)
+
+/*
+ * Fragment the packets ip4_rewrite found larger than the MTU of the next hop port and send
+ * the fragments to the Tx node of the port. The Ethernet header written by ip4_rewrite is
+ * copied into each fragment. Packets with the DF flag set or without enough mbufs for the
+ * fragments are dropped.
+ */
+static uint16_t
+ip4_frag_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
+                      uint16_t nb_objs)
+{
+    struct ip4_rewrite_node_main *rw = ip4_rewrite_node_data_get();
+    const int dyn                    = IP4_FRAG_NODE_PRIV1_OFF(node->ctx);
+    pktmbuf_t **pkts                 = (pktmbuf_t **)objs;
+    pktmbuf_t *frags[IP_FRAG_MAX_OUT];
+
+    for (uint16_t i = 0; i < nb_objs; i++) {
+        pktmbuf_t *mbuf = pkts[i];
+        uint16_t nh     = node_mbuf_priv1(mbuf, dyn)->nh;
+        uint16_t next   = ip4_frag_nm.next_index[rw->nh_port[nh]];
+        int n;
+
+        mbuf->l2_len = sizeof(struct cne_ether_hdr);
+
+        n = ip_frag_ipv4(mbuf, rw->nh[nh].mtu, NULL, frags, IP_FRAG_MAX_OUT);
+        if (n > 0)
+            cne_node_enqueue(graph, node, next, (void **)frags, n);
+        else
+            cne_node_enqueue_x1(graph, node, (n == 0) ? next : IP4_FRAG_NEXT_PKT_DROP, mbuf);
+    }
+
+    return nb_objs;
+}
+
+static int
+ip4_frag_node_init(const struct cne_graph *graph, struct cne_node *node)
+{
+    static bool init_once;
+
+    CNE_SET_USED(graph);
+    CNE_BUILD_BUG_ON(sizeof(struct ip4_frag_node_ctx) > CNE_NODE_CTX_SZ);
+
+    if (!init_once) {
+        node_mbuf_priv1_dynfield_offset = offsetof(pktmbuf_t, udata64);
+        init_once                       = true;
+    }
+    IP4_FRAG_NODE_PRIV1_OFF(node->ctx) = node_mbuf_priv1_dynfield_offset;
+
+    node_dbg("ip4_frag", "Initialized ip4_frag node");
+
+    return 0;
+}
+
+int
+ip4_frag_set_next(uint16_t port_id, uint16_t next_index)
+{
+    if (port_id >= CNE_MAX_ETHPORTS)
+        return -EINVAL;
+
+    ip4_frag_nm.next_index[port_id] = next_index;
+
+    return 0;
+}
+
+static struct cne_node_register ip4_frag_node = {
+    .process = ip4_frag_node_process,
+    .name    = "ip4_frag",
+    /* Default edge i.e '0' is pkt drop, the Tx nodes are added per port */
+    .nb_edges = IP4_FRAG_NEXT_MAX,
+    .next_nodes =
+        {
+            [IP4_FRAG_NEXT_PKT_DROP] = "pkt_drop",
+        },
+    .init = ip4_frag_node_init,
+};
+
+struct cne_node_register *
+ip4_frag_node_get(void)
+{
+    return &ip4_frag_node;
+}
+
+CNE_NODE_REGISTER(ip4_frag_node);
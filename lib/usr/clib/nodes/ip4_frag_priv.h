@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+#ifndef __INCLUDE_IP4_FRAG_PRIV_H__
+#define __INCLUDE_IP4_FRAG_PRIV_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <cne_common.h>
+
+/**
+ * @internal
+ *
+ * ip4_frag next nodes, the per port Tx nodes follow.
+ */
+enum ip4_frag_next_nodes {
+    IP4_FRAG_NEXT_PKT_DROP,
+    IP4_FRAG_NEXT_MAX,
+};
+
+/**
+ * @internal
+ *
+ * Ipv4 fragmentation node main data structure.
+ */
+struct ip4_frag_node_main {
+    uint16_t next_index[CNE_MAX_ETHPORTS];
+    /**< Next index of each configured port. */
+};
+
+/**
+ * @internal
+ *
+ * Get the ipv4 fragmentation node.
+ *
+ * @return
+ *   Pointer to the ipv4 fragmentation node.
+ */
+struct cne_node_register *ip4_frag_node_get(void);
+
+/**
+ * @internal
+ *
+ * Set the Edge index of a given port_id.
+ *
+ * @param port_id
+ *   Ethernet port identifier.
+ * @param next_index
+ *   Edge index of the Given Tx node.
+ */
+int ip4_frag_set_next(uint16_t port_id, uint16_t next_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_IP4_FRAG_PRIV_H__ */
@@ -6,6 +6,7 @@
 #include <arpa/inet.h>               // for inet_ntop
 #include <sys/socket.h>              // for AF_INET
 #include <cne_fib.h>                 // for cne_fib_create, cne_fib_add, cne_...
+#include <cne_fib_nhg.h>             // for cne_fib_nhg_select, cne_fib_nhg_hash_ipv4
 #include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
 #include <cne_graph_worker.h>        // for cne_node, cne_node_enqueue_x1
 #include <net/cne_ip.h>              // for cne_ipv4_hdr
@@ -14,8 +15,10 @@
 #include <cne_system.h>              // for cne_max_numa_nodes
 #include <errno.h>                   // for errno
 #include <netinet/in.h>              // for in_addr, INET6_ADDRSTRLEN, htonl
+#include <stdbool.h>                 // for bool
 #include <stddef.h>                  // for offsetof
 #include <stdint.h>                  // for uint16_t, uint32_t, uint8_t
+#include <stdio.h>                   // for snprintf
 #include <string.h>                  // for memcpy, NULL
 
 #include "node_ip4_api.h"                 // for CNE_NODE_IP4_LOOKUP_NEXT_PKT_DROP
@@ -27,9 +30,13 @@
 #define IPV4_L3FWD_FIB_MAX_RULES    1024
 #define IPV4_L3FWD_FIB_NUMBER_TBL8S (1 << 8)
 
+/* FIB next hop value referring to a nexthop group, the group id is in the low 16 bits */
+#define IP4_LOOKUP_NHG_FLAG (1ULL << 24)
+
 /* IP4 Lookup global data struct */
 struct ip4_lookup_node_main {
     struct cne_fib *fib_tbl[8];
+    struct cne_fib_nhg *nhg[CNE_NODE_IP4_LOOKUP_NHG_MAX]; /**< Nexthop groups */
 };
 
 struct ip4_lookup_node_ctx {
@@ -45,6 +52,25 @@ static struct ip4_lookup_node_main ip4_lookup_nm;
 
 #define IP4_LOOKUP_NODE_PRIV1_OFF(ctx) (((struct ip4_lookup_node_ctx *)ctx)->mbuf_priv1_off)
 
+/* Replace a nexthop group reference by the next hop of the packet flow */
+static __cne_always_inline uint64_t
+ip4_lookup_nhg_resolve(pktmbuf_t *mbuf, uint64_t next_hop)
+{
+    struct cne_ipv4_hdr *ipv4_hdr;
+    uint32_t hash;
+
+    if (likely(!(next_hop & IP4_LOOKUP_NHG_FLAG)))
+        return next_hop;
+
+    hash = pktmbuf_hash(mbuf);
+    if (hash == 0) {
+        ipv4_hdr = pktmbuf_mtod_offset(mbuf, struct cne_ipv4_hdr *, sizeof(struct cne_ether_hdr));
+        hash     = cne_fib_nhg_hash_ipv4(ipv4_hdr);
+    }
+
+    return cne_fib_nhg_select(ip4_lookup_nm.nhg[next_hop & 0xFFFF], hash);
+}
+
 static uint16_t
 ip4_lookup_node_process_vec(struct cne_graph *graph, struct cne_node *node, void **objs,
                             uint16_t nb_objs)
@@ -140,6 +166,14 @@ ip4_lookup_node_process_vec(struct cne_graph *graph, struct cne_node *node, void
         /* Perform FIB lookup to get NH and next node */
         cne_fib_lookup_bulk(fib, dip, dst, 4);
 
+        /* Pick the member of the nexthop group routes from the flow hash */
+        if (unlikely((dst[0] | dst[1] | dst[2] | dst[3]) & IP4_LOOKUP_NHG_FLAG)) {
+            dst[0] = ip4_lookup_nhg_resolve(mbuf0, dst[0]);
+            dst[1] = ip4_lookup_nhg_resolve(mbuf1, dst[1]);
+            dst[2] = ip4_lookup_nhg_resolve(mbuf2, dst[2]);
+            dst[3] = ip4_lookup_nhg_resolve(mbuf3, dst[3]);
+        }
+
         /* Extract next node id and NH */
         node_mbuf_priv1(mbuf0, dyn)->nh = dst[0] & 0xFFFF;
         next0                           = (dst[0] >> 16);
@@ -221,7 +255,7 @@ ip4_lookup_node_process_vec(struct cne_graph *graph, struct cne_node *node, void
 
         ip       = ntohl(ipv4_hdr->dst_addr);
         rc       = cne_fib_lookup_bulk(fib, &ip, &next_hop, 1);
-        next_hop = (rc == 0) ? next_hop : drop_nh;
+        next_hop = (rc == 0) ? ip4_lookup_nhg_resolve(mbuf0, next_hop) : drop_nh;
 
         node_mbuf_priv1(mbuf0, dyn)->nh = next_hop & 0xFFFF;
         next0                           = (next_hop >> 16);
@@ -288,6 +322,89 @@ cne_node_ip4_route_add(uint32_t ip, uint8_t depth, uint16_t next_hop,
     return 0;
 }
 
+int
+cne_node_ip4_route_add_nhg(uint32_t ip, uint8_t depth, uint16_t nhg_id)
+{
+    char abuf[INET6_ADDRSTRLEN] = {0};
+    struct in_addr in;
+    uint8_t socket;
+    int ret;
+
+    if (nhg_id >= CNE_NODE_IP4_LOOKUP_NHG_MAX || !ip4_lookup_nm.nhg[nhg_id])
+        return -EINVAL;
+
+    in.s_addr = htonl(ip);
+    inet_ntop(AF_INET, &in, abuf, sizeof(abuf));
+
+    node_dbg("ip4_lookup", "FIB: Adding route %s / %d nexthop group %u", abuf, depth, nhg_id);
+
+    for (socket = 0; socket < cne_max_numa_nodes(); socket++) {
+        if (!ip4_lookup_nm.fib_tbl[socket])
+            continue;
+
+        ret = cne_fib_add(ip4_lookup_nm.fib_tbl[socket], ip, depth, IP4_LOOKUP_NHG_FLAG | nhg_id);
+        if (ret < 0) {
+            node_err("ip4_lookup",
+                     "Unable to add entry %s / %d nexthop group %u to FIB table on sock %d, "
+                     "rc=%d\n",
+                     abuf, depth, nhg_id, socket, ret);
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+/* Members are stored with the same encoding as the FIB next hop values */
+static inline uint64_t
+ip4_lookup_nhg_member_nh(uint16_t next_hop, enum cne_node_ip4_lookup_next next_node)
+{
+    return ((next_node << 16) | next_hop) & ((1ull << 24) - 1);
+}
+
+int
+cne_node_ip4_nhg_member_add(uint16_t nhg_id, uint16_t next_hop,
+                            enum cne_node_ip4_lookup_next next_node, uint32_t weight)
+{
+    char name[CNE_FIB_NHG_NAMESIZE];
+
+    if (nhg_id >= CNE_NODE_IP4_LOOKUP_NHG_MAX)
+        return -EINVAL;
+
+    if (!ip4_lookup_nm.nhg[nhg_id]) {
+        snprintf(name, sizeof(name), "ip4_lookup_nhg%u", nhg_id);
+        ip4_lookup_nm.nhg[nhg_id] = cne_fib_nhg_create(
+            name, 0, ((uint64_t)CNE_NODE_IP4_LOOKUP_NEXT_PKT_DROP) << 16);
+        if (!ip4_lookup_nm.nhg[nhg_id])
+            return -ENOMEM;
+    }
+
+    return cne_fib_nhg_member_add(ip4_lookup_nm.nhg[nhg_id],
+                                  ip4_lookup_nhg_member_nh(next_hop, next_node), weight);
+}
+
+int
+cne_node_ip4_nhg_member_del(uint16_t nhg_id, uint16_t next_hop,
+                            enum cne_node_ip4_lookup_next next_node)
+{
+    if (nhg_id >= CNE_NODE_IP4_LOOKUP_NHG_MAX || !ip4_lookup_nm.nhg[nhg_id])
+        return -EINVAL;
+
+    return cne_fib_nhg_member_del(ip4_lookup_nm.nhg[nhg_id],
+                                  ip4_lookup_nhg_member_nh(next_hop, next_node));
+}
+
+int
+cne_node_ip4_nhg_member_set_state(uint16_t nhg_id, uint16_t next_hop,
+                                  enum cne_node_ip4_lookup_next next_node, bool up)
+{
+    if (nhg_id >= CNE_NODE_IP4_LOOKUP_NHG_MAX || !ip4_lookup_nm.nhg[nhg_id])
+        return -EINVAL;
+
+    return cne_fib_nhg_member_set_state(ip4_lookup_nm.nhg[nhg_id],
+                                        ip4_lookup_nhg_member_nh(next_hop, next_node), up);
+}
+
 static int
 setup_fib(struct ip4_lookup_node_main *nm, int socket)
 {
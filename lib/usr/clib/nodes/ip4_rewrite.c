@@ -4,7 +4,7 @@
 
 #include <cne_graph.h>               // for cne_node_register, CNE_NODE_REGISTER
 #include <cne_graph_worker.h>        // for cne_node_enqueue_x1, cne_node_nex...
-#include <net/cne_ip.h>              // for cne_ipv4_hdr
+#include <net/cne_ip.h>              // for cne_ipv4_hdr, cne_ipv4_cksum_ttl_dec
 #include <pktmbuf.h>                 // for pktmbuf_t, pktmbuf_mtod
 #include <cne_vect.h>                // for cne_xmm_t
 #include <net/cne_ether.h>           // for cne_ether_hdr
@@ -15,6 +15,8 @@
 #include <stdint.h>                  // for uint16_t, uint8_t, uint32_t, uint...
 #include <stdlib.h>                  // for calloc
 #include <string.h>                  // for memcpy, NULL
+#include <endian.h>                  // for be16toh
+#include <pktdev_api.h>              // for pktdev_get_mtu
 
 #include "node_ip4_api.h"                 // for cne_node_ip4_rewrite_add
 #include "ip4_rewrite_priv.h"             // for ip4_rewrite_nh_header, ip4_rewrit...
@@ -37,6 +39,16 @@ static struct ip4_rewrite_node_main *ip4_rewrite_nm;
 
 #define IP4_REWRITE_NODE_PRIV1_OFF(ctx) (((struct ip4_rewrite_node_ctx *)ctx)->mbuf_priv1_off)
 
+/* Packets larger than the MTU of the next hop port go to ip4_frag instead of the port */
+static __cne_always_inline uint16_t
+ip4_rewrite_next(const struct ip4_rewrite_nh_header *nh, const struct cne_ipv4_hdr *ip)
+{
+    if (unlikely(be16toh(ip->total_length) > nh->mtu))
+        return IP4_REWRITE_NEXT_IP4_FRAG;
+
+    return nh->tx_node;
+}
+
 static uint16_t
 ip4_rewrite_node_process(struct cne_graph *graph, struct cne_node *node, void **objs,
                          uint16_t nb_objs)
@@ -91,46 +103,40 @@ ip4_rewrite_node_process(struct cne_graph *graph, struct cne_node *node, void **
         priv23.u64[0] = node_mbuf_priv1(mbuf2, dyn)->u;
         priv23.u64[1] = node_mbuf_priv1(mbuf3, dyn)->u;
 
-        /* Increment checksum by one. */
-        priv01.u32[1] += htons(0x0100);
-        priv01.u32[3] += htons(0x0100);
-        priv23.u32[1] += htons(0x0100);
-        priv23.u32[3] += htons(0x0100);
-
         /* Update ttl,cksum rewrite ethernet hdr on mbuf0 */
         d0 = pktmbuf_mtod(mbuf0, void *);
         memcpy(d0, nh[priv01.u16[0]].rewrite_data, nh[priv01.u16[0]].rewrite_len);
 
-        next0             = nh[priv01.u16[0]].tx_node;
         ip0               = (struct cne_ipv4_hdr *)((uint8_t *)d0 + sizeof(struct cne_ether_hdr));
+        next0             = ip4_rewrite_next(&nh[priv01.u16[0]], ip0);
         ip0->time_to_live = priv01.u16[1] - 1;
-        ip0->hdr_checksum = priv01.u16[2] + priv01.u16[3];
+        ip0->hdr_checksum = cne_ipv4_cksum_ttl_dec(priv01.u16[2]);
 
         /* Update ttl,cksum rewrite ethernet hdr on mbuf1 */
         d1 = pktmbuf_mtod(mbuf1, void *);
         memcpy(d1, nh[priv01.u16[4]].rewrite_data, nh[priv01.u16[4]].rewrite_len);
 
-        next1             = nh[priv01.u16[4]].tx_node;
         ip1               = (struct cne_ipv4_hdr *)((uint8_t *)d1 + sizeof(struct cne_ether_hdr));
+        next1             = ip4_rewrite_next(&nh[priv01.u16[4]], ip1);
         ip1->time_to_live = priv01.u16[5] - 1;
-        ip1->hdr_checksum = priv01.u16[6] + priv01.u16[7];
+        ip1->hdr_checksum = cne_ipv4_cksum_ttl_dec(priv01.u16[6]);
 
         /* Update ttl,cksum rewrite ethernet hdr on mbuf2 */
         d2 = pktmbuf_mtod(mbuf2, void *);
         memcpy(d2, nh[priv23.u16[0]].rewrite_data, nh[priv23.u16[0]].rewrite_len);
-        next2             = nh[priv23.u16[0]].tx_node;
         ip2               = (struct cne_ipv4_hdr *)((uint8_t *)d2 + sizeof(struct cne_ether_hdr));
+        next2             = ip4_rewrite_next(&nh[priv23.u16[0]], ip2);
         ip2->time_to_live = priv23.u16[1] - 1;
-        ip2->hdr_checksum = priv23.u16[2] + priv23.u16[3];
+        ip2->hdr_checksum = cne_ipv4_cksum_ttl_dec(priv23.u16[2]);
 
         /* Update ttl,cksum rewrite ethernet hdr on mbuf3 */
         d3 = pktmbuf_mtod(mbuf3, void *);
         memcpy(d3, nh[priv23.u16[4]].rewrite_data, nh[priv23.u16[4]].rewrite_len);
 
-        next3             = nh[priv23.u16[4]].tx_node;
         ip3               = (struct cne_ipv4_hdr *)((uint8_t *)d3 + sizeof(struct cne_ether_hdr));
+        next3             = ip4_rewrite_next(&nh[priv23.u16[4]], ip3);
         ip3->time_to_live = priv23.u16[5] - 1;
-        ip3->hdr_checksum = priv23.u16[6] + priv23.u16[7];
+        ip3->hdr_checksum = cne_ipv4_cksum_ttl_dec(priv23.u16[6]);
 
         /* Enqueue four to next node */
         cne_edge_t fix_spec =
@@ -198,8 +204,6 @@ ip4_rewrite_node_process(struct cne_graph *graph, struct cne_node *node, void **
     }
 
     while (n_left_from > 0) {
-        uint16_t chksum;
-
         mbuf0 = pkts[0];
 
         pkts += 1;
@@ -209,11 +213,9 @@ ip4_rewrite_node_process(struct cne_graph *graph, struct cne_node *node, void **
         memcpy(d0, nh[node_mbuf_priv1(mbuf0, dyn)->nh].rewrite_data,
                nh[node_mbuf_priv1(mbuf0, dyn)->nh].rewrite_len);
 
-        next0  = nh[node_mbuf_priv1(mbuf0, dyn)->nh].tx_node;
-        ip0    = (struct cne_ipv4_hdr *)((uint8_t *)d0 + sizeof(struct cne_ether_hdr));
-        chksum = node_mbuf_priv1(mbuf0, dyn)->cksum + htons(0x0100);
-        chksum += chksum >= 0xffff;
-        ip0->hdr_checksum = chksum;
+        ip0               = (struct cne_ipv4_hdr *)((uint8_t *)d0 + sizeof(struct cne_ether_hdr));
+        next0             = ip4_rewrite_next(&nh[node_mbuf_priv1(mbuf0, dyn)->nh], ip0);
+        ip0->hdr_checksum = cne_ipv4_cksum_ttl_dec(node_mbuf_priv1(mbuf0, dyn)->cksum);
         ip0->time_to_live = node_mbuf_priv1(mbuf0, dyn)->ttl - 1;
 
         if (unlikely(next_index ^ next0)) {
@@ -278,11 +280,18 @@ ip4_rewrite_set_next(uint16_t port_id, uint16_t next_index)
     return 0;
 }
 
+struct ip4_rewrite_node_main *
+ip4_rewrite_node_data_get(void)
+{
+    return ip4_rewrite_nm;
+}
+
 int
 cne_node_ip4_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data, uint8_t rewrite_len,
                          uint16_t dst_port)
 {
     struct ip4_rewrite_nh_header *nh;
+    uint16_t mtu;
 
     if (next_hop >= CNE_GRAPH_IP4_REWRITE_MAX_NH)
         return -EINVAL;
@@ -303,22 +312,30 @@ cne_node_ip4_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data, uint8_t rewri
     /* Update next hop */
     nh = &ip4_rewrite_nm->nh[next_hop];
 
+    /* Without the MTU of the port the packets are sent as is */
+    if (pktdev_get_mtu(dst_port, &mtu) < 0)
+        mtu = UINT16_MAX;
+
     memcpy(nh->rewrite_data, rewrite_data, rewrite_len);
     nh->tx_node     = ip4_rewrite_nm->next_index[dst_port];
     nh->rewrite_len = rewrite_len;
+    nh->mtu         = mtu;
     nh->enabled     = true;
 
+    ip4_rewrite_nm->nh_port[next_hop] = dst_port;
+
     return 0;
 }
 
 static struct cne_node_register ip4_rewrite_node = {
     .process = ip4_rewrite_node_process,
     .name    = "ip4_rewrite",
-    /* Default edge i.e '0' is pkt drop */
-    .nb_edges = 1,
+    /* Default edge i.e '0' is pkt drop, the Tx nodes are added after ip4_frag */
+    .nb_edges = IP4_REWRITE_NEXT_MAX,
     .next_nodes =
         {
-            [0] = "pkt_drop",
+            [IP4_REWRITE_NEXT_PKT_DROP] = "pkt_drop",
+            [IP4_REWRITE_NEXT_IP4_FRAG] = "ip4_frag",
         },
     .init = ip4_rewrite_node_init,
 };
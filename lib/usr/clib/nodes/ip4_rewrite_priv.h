@@ -25,7 +25,7 @@ struct ip4_rewrite_nh_header {
     uint16_t rewrite_len; /**< Header rewrite length. */
     uint16_t tx_node;     /**< Tx node next index identifier. */
     uint16_t enabled;     /**< NH enable flag */
-    uint16_t rsvd;
+    uint16_t mtu;         /**< MTU of the port, larger packets are fragmented. */
     union {
         struct {
             struct ether_addr dst;
@@ -48,6 +48,19 @@ struct ip4_rewrite_node_main {
     /**< Array of next hop header data */
     uint16_t next_index[CNE_MAX_ETHPORTS];
     /**< Next index of each configured port. */
+    uint16_t nh_port[CNE_GRAPH_IP4_REWRITE_MAX_NH];
+    /**< Destination port of each next hop. */
+};
+
+/**
+ * @internal
+ *
+ * ip4_rewrite next nodes, the per port Tx nodes follow.
+ */
+enum ip4_rewrite_next_nodes {
+    IP4_REWRITE_NEXT_PKT_DROP,
+    IP4_REWRITE_NEXT_IP4_FRAG,
+    IP4_REWRITE_NEXT_MAX,
 };
 
 /**
@@ -72,6 +85,16 @@ struct cne_node_register *ip4_rewrite_node_get(void);
  */
 int ip4_rewrite_set_next(uint16_t port_id, uint16_t next_index);
 
+/**
+ * @internal
+ *
+ * Get the ipv4 rewrite node data.
+ *
+ * @return
+ *   Pointer to the ipv4 rewrite node data, NULL if no port or next hop is set.
+ */
+struct ip4_rewrite_node_main *ip4_rewrite_node_data_get(void);
+
 #ifdef __cplusplus
 }
 #endif
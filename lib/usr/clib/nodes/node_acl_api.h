@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef __INCLUDE_CNE_NODE_ACL_API_H__
+#define __INCLUDE_CNE_NODE_ACL_API_H__
+
+/**
+ * @file
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of the ip4_acl node.
+ *
+ * The ip4_acl node classifies the IPv4 packets of its burst on the protocol,
+ * the addresses and the TCP, UDP or SCTP ports with the ACL library, using the
+ * best classify method of the CPU. The userdata of the highest priority rule
+ * matching a packet selects the edge the packet is sent to, the packets not
+ * matching any rule go to the default edge.
+ *
+ * Edges beyond CNE_NODE_IP4_ACL_NEXT_MAX can be added to the node with
+ * cne_node_edge_update() before the graph is created, to send some flows to
+ * their own node.
+ */
+
+#include <stdint.h>         // for uint16_t, uint32_t
+#include <cne_common.h>
+#include <cne_acl.h>        // for CNE_ACL_RULE_DEF
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * IP4 ACL next nodes.
+ */
+enum cne_node_ip4_acl_next {
+    CNE_NODE_IP4_ACL_NEXT_PKT_DROP,
+    /**< Packet drop node, deny. */
+    CNE_NODE_IP4_ACL_NEXT_IP4_LOOKUP,
+    /**< Lookup node, permit. */
+    CNE_NODE_IP4_ACL_NEXT_MAX,
+    /**< Number of next nodes of the ACL node. */
+};
+
+/**
+ * Fields of an ip4_acl rule.
+ *
+ * The protocol is a value and mask, the addresses are a value and a prefix
+ * length and the ports are a low and high value, all in host byte order. The
+ * ports only match TCP, UDP and SCTP packets which are not a non-first fragment,
+ * the other packets have both ports set to 0.
+ */
+enum {
+    CNE_NODE_IP4_ACL_FIELD_PROTO,    /**< IPv4 protocol id */
+    CNE_NODE_IP4_ACL_FIELD_SRC,      /**< IPv4 source address */
+    CNE_NODE_IP4_ACL_FIELD_DST,      /**< IPv4 destination address */
+    CNE_NODE_IP4_ACL_FIELD_SRC_PORT, /**< L4 source port */
+    CNE_NODE_IP4_ACL_FIELD_DST_PORT, /**< L4 destination port */
+    CNE_NODE_IP4_ACL_FIELD_NUM,      /**< Number of fields */
+};
+
+/** Rule of the ip4_acl node */
+CNE_ACL_RULE_DEF(cne_node_ip4_acl_rule, CNE_NODE_IP4_ACL_FIELD_NUM);
+
+/** Rule userdata sending the matching packets to the edge @p next */
+#define CNE_NODE_IP4_ACL_USERDATA(next) ((uint32_t)(next) + 1)
+
+struct cne_rcu_qsbr;
+
+/**
+ * Replace the rules of the ACL node.
+ *
+ * A new ACL context is built from the rules and swapped with the current one in
+ * one step, the graph walks classify a burst either with the old or the new
+ * rules and never stop. With a QSBR variable added by cne_node_ip4_acl_qsbr_add()
+ * the call waits for the walkers to report a quiescent state before freeing the
+ * old context, otherwise the caller must make sure no graph is walking.
+ *
+ * The control functions must be serialized by the caller.
+ *
+ * @param rules
+ *   Array of rules, the userdata of a rule is CNE_NODE_IP4_ACL_USERDATA() of the
+ *   edge the matching packets go to and the category mask must include the
+ *   first category. Can be NULL when num is 0.
+ * @param num
+ *   Number of rules, 0 to send all the packets to the default edge.
+ *
+ * @return
+ *   0 on success, negative otherwise. On error the current rules are unchanged.
+ */
+int cne_node_ip4_acl_rules_set(const struct cne_node_ip4_acl_rule *rules, uint32_t num);
+
+/**
+ * Set the edge of the packets not matching any rule, the default is
+ * CNE_NODE_IP4_ACL_NEXT_IP4_LOOKUP.
+ *
+ * @param next
+ *   Edge of the ACL node.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int cne_node_ip4_acl_default_set(uint16_t next);
+
+/**
+ * Associate an RCU QSBR variable with the ACL node, the graphs running the
+ * node must report to it with cne_graph_qsbr_add().
+ *
+ * @param v
+ *   RCU QSBR variable, NULL to remove it.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int cne_node_ip4_acl_qsbr_add(struct cne_rcu_qsbr *v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_CNE_NODE_ACL_API_H__ */
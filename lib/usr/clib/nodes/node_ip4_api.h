@@ -16,6 +16,7 @@
  * like ip4_lookup, ip4_rewrite.
  */
 
+#include <stdbool.h>        // for bool
 #include <cne_common.h>
 
 #ifdef __cplusplus
@@ -52,6 +53,79 @@ enum cne_node_ip4_lookup_next {
 int cne_node_ip4_route_add(uint32_t ip, uint8_t depth, uint16_t next_hop,
                            enum cne_node_ip4_lookup_next next_node);
 
+/** Max number of nexthop groups of the lookup node */
+#define CNE_NODE_IP4_LOOKUP_NHG_MAX 256
+
+/**
+ * Add ipv4 route to lookup table, resolved by a nexthop group. The packets of a
+ * flow always take the same member of the group, see cne_fib_nhg.h.
+ *
+ * @param ip
+ *   IP address of route to be added.
+ * @param depth
+ *   Depth of the rule to be added.
+ * @param nhg_id
+ *   Nexthop group id, less than CNE_NODE_IP4_LOOKUP_NHG_MAX.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int cne_node_ip4_route_add_nhg(uint32_t ip, uint8_t depth, uint16_t nhg_id);
+
+/**
+ * Add a member to a nexthop group, or change its weight. The group is created
+ * on the first member added.
+ *
+ * @param nhg_id
+ *   Nexthop group id, less than CNE_NODE_IP4_LOOKUP_NHG_MAX.
+ * @param next_hop
+ *   Next hop id of the member.
+ * @param next_node
+ *   Next node of the member.
+ * @param weight
+ *   Relative weight of the member, greater than 0.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int cne_node_ip4_nhg_member_add(uint16_t nhg_id, uint16_t next_hop,
+                                enum cne_node_ip4_lookup_next next_node, uint32_t weight);
+
+/**
+ * Remove a member from a nexthop group.
+ *
+ * @param nhg_id
+ *   Nexthop group id.
+ * @param next_hop
+ *   Next hop id of the member.
+ * @param next_node
+ *   Next node of the member.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int cne_node_ip4_nhg_member_del(uint16_t nhg_id, uint16_t next_hop,
+                                enum cne_node_ip4_lookup_next next_node);
+
+/**
+ * Mark a member of a nexthop group up or down, the flows of the member move to
+ * the other members while it is down and the other flows keep their member.
+ *
+ * @param nhg_id
+ *   Nexthop group id.
+ * @param next_hop
+ *   Next hop id of the member.
+ * @param next_node
+ *   Next node of the member.
+ * @param up
+ *   True to mark the member up, false to mark it down.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int cne_node_ip4_nhg_member_set_state(uint16_t nhg_id, uint16_t next_hop,
+                                      enum cne_node_ip4_lookup_next next_node, bool up);
+
 /**
  * Add a next hop's rewrite data.
  *
@@ -12,6 +12,7 @@
 #include "pktdev_rx_priv.h"          // for pktdev_rx_node_elem_t, pktdev_rx_get_n...
 #include "pktdev_tx_priv.h"          // for pktdev_tx_node_data_get, pktdev_tx_nod...
 #include "ip4_rewrite_priv.h"        // for ip4_rewrite_node_get, ip4_rewrite_set_...
+#include "ip4_frag_priv.h"           // for ip4_frag_node_get, ip4_frag_set_next
 #include "node_private.h"            // for node_dbg
 #include "cne_log.h"                 // for CNE_LOG_DEBUG
 #include "pktdev_api.h"              // for pktdev_is_valid_port
@@ -20,6 +21,7 @@ int
 cne_node_eth_config(struct cne_node_pktdev_config *conf, uint16_t nb_confs)
 {
     struct cne_node_register *ip4_rewrite_node;
+    struct cne_node_register *ip4_frag_node;
     struct pktdev_tx_node_main *tx_node_data;
     uint16_t port_id;
     struct cne_node_register *tx_node;
@@ -29,6 +31,7 @@ cne_node_eth_config(struct cne_node_pktdev_config *conf, uint16_t nb_confs)
     uint32_t id;
 
     ip4_rewrite_node = ip4_rewrite_node_get();
+    ip4_frag_node    = ip4_frag_node_get();
     tx_node_data     = pktdev_tx_node_data_get();
     tx_node          = pktdev_tx_node_get();
     for (i = 0; i < nb_confs; i++) {
@@ -84,6 +87,13 @@ cne_node_eth_config(struct cne_node_pktdev_config *conf, uint16_t nb_confs)
         rc = ip4_rewrite_set_next(port_id, cne_node_edge_count(ip4_rewrite_node->id) - 1);
         if (rc < 0)
             return rc;
+
+        /* Add this tx port node as next to ip4_frag_node for the fragments */
+        cne_node_edge_update(ip4_frag_node->id, CNE_EDGE_ID_INVALID, &next_nodes, 1);
+
+        rc = ip4_frag_set_next(port_id, cne_node_edge_count(ip4_frag_node->id) - 1);
+        if (rc < 0)
+            return rc;
     }
 
     return 0;
@@ -3,11 +3,13 @@
  * Copyright (c) 2019-2023 Intel Corporation
  */
 
+#include <stdio.h>             // for snprintf
 #include <stdbool.h>           // for bool
 #include <stdint.h>            // for uint32_t, uint8_t, uint64_t
 #include <mempool.h>           // for mempool_cfg, mempool_destroy, mem...
 #include <cne_rwlock.h>        // for cne_rwlock_write_unlock, cne_rwlo...
 #include <cne_mmap.h>          // for mmap_free, mmap_addr, mmap_alloc
+#include <cne_rcu_qsbr.h>      // for cne_rcu_qsbr_dq_enqueue, cne_rcu_qsbr_dq_reclaim
 #include <cne_rib.h>
 #include <bsd/string.h>        // for strlcpy
 
@@ -22,6 +24,8 @@ static cne_rwlock_t __rib_lock;
 #define RIB_MAXDEPTH 32
 /* Maximum length of a RIB name. */
 #define CNE_RIB_NAMESIZE 64
+/* Max number of nodes freed on a defer queue reclaim */
+#define RIB_RCU_DQ_RECLAIM_MAX 16
 
 struct cne_rib_node {
     struct cne_rib_node *left;
@@ -42,6 +46,8 @@ struct cne_rib {
     uint32_t cur_nodes;
     uint32_t cur_routes;
     uint32_t max_nodes;
+    struct cne_rcu_qsbr *v;      /* RCU QSBR variable of the readers */
+    struct cne_rcu_qsbr_dq *dq;  /* Removed nodes waiting for the readers */
 };
 
 static inline bool
@@ -76,8 +82,13 @@ node_alloc(struct cne_rib *rib)
 {
     struct cne_rib_node *ent;
 
-    if (unlikely(mempool_get(rib->node_pool, (void *)&ent) < 0))
-        return NULL;
+    if (unlikely(mempool_get(rib->node_pool, (void *)&ent) < 0)) {
+        /* Removed nodes could be waiting for the readers, try to reclaim them */
+        if (rib->dq == NULL ||
+            cne_rcu_qsbr_dq_reclaim(rib->dq, RIB_RCU_DQ_RECLAIM_MAX, NULL, NULL, NULL) < 0 ||
+            mempool_get(rib->node_pool, (void *)&ent) < 0)
+            return NULL;
+    }
     ++rib->cur_nodes;
     return ent;
 }
@@ -86,9 +97,23 @@ static void
 node_free(struct cne_rib *rib, struct cne_rib_node *ent)
 {
     --rib->cur_nodes;
+
+    /* A reader walking the tree could still reference the node */
+    if (rib->dq != NULL && cne_rcu_qsbr_dq_enqueue(rib->dq, &ent) == 0)
+        return;
+    if (rib->v != NULL)
+        cne_rcu_qsbr_synchronize(rib->v, CNE_QSBR_THRID_INVALID);
     mempool_put(rib->node_pool, ent);
 }
 
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __cne_unused)
+{
+    struct cne_rib *rib = p;
+
+    mempool_put(rib->node_pool, *(struct cne_rib_node **)data);
+}
+
 struct cne_rib_node *
 cne_rib_lookup(struct cne_rib *rib, uint32_t ip)
 {
@@ -417,7 +442,43 @@ cne_rib_free(struct cne_rib *rib)
     while ((tmp = cne_rib_get_nxt(rib, 0, 0, tmp, CNE_RIB_GET_NXT_ALL)) != NULL)
         cne_rib_remove(rib, tmp->ip, tmp->depth);
 
+    /* Wait for the readers of the removed nodes before the mempool goes away */
+    cne_rcu_qsbr_dq_delete(rib->dq);
     mempool_destroy(rib->node_pool);
     mmap_free(rib->mm);
     free(rib);
 }
+
+int
+cne_rib_rcu_qsbr_add(struct cne_rib *rib, struct cne_rcu_qsbr *v, uint32_t dq_size)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    char rcu_dq_name[CNE_RCU_QSBR_NAMESIZE];
+
+    if (rib == NULL || v == NULL)
+        CNE_ERR_RET("Invalid RIB or RCU QSBR variable\n");
+
+    if (rib->v != NULL)
+        CNE_ERR_RET("RCU QSBR variable already added to RIB %s\n", rib->name);
+
+    snprintf(rcu_dq_name, sizeof(rcu_dq_name), "RIB_RCU_%s", rib->name);
+    params.name                  = rcu_dq_name;
+    params.size                  = dq_size ? dq_size : rib->max_nodes;
+    params.trigger_reclaim_limit = 0;
+    params.max_reclaim_size      = RIB_RCU_DQ_RECLAIM_MAX;
+    params.esize                 = sizeof(struct cne_rib_node *);
+    params.free_fn               = __rcu_qsbr_free_resource;
+    params.p                     = rib;
+    params.v                     = v;
+
+    /* RIB updates are serialized by the caller, no lock is needed */
+    params.flags = CNE_RCU_QSBR_DQ_MT_UNSAFE;
+
+    rib->dq = cne_rcu_qsbr_dq_create(&params);
+    if (rib->dq == NULL)
+        CNE_ERR_RET("RIB %s defer queue creation failed\n", rib->name);
+
+    rib->v = v;
+
+    return 0;
+}
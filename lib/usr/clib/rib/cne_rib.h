@@ -35,6 +35,7 @@ enum {
 
 struct cne_rib;
 struct cne_rib_node;
+struct cne_rcu_qsbr;
 
 /** RIB configuration structure */
 struct cne_rib_conf {
@@ -242,6 +243,22 @@ CNDP_API struct cne_rib *cne_rib_create(const char *name, const struct cne_rib_c
  */
 CNDP_API void cne_rib_free(struct cne_rib *rib);
 
+/**
+ * Associate an RCU QSBR variable with the RIB, for readers walking the tree
+ * without a lock. Nodes removed by cne_rib_remove() are returned to the node
+ * pool only after the readers reported a quiescent state.
+ *
+ * @param rib
+ *   RIB object handle
+ * @param v
+ *   RCU QSBR variable of the reader threads
+ * @param dq_size
+ *   Size of the defer queue, 0 to use the max number of nodes
+ * @return
+ *   0 on success or -1 on error.
+ */
+CNDP_API int cne_rib_rcu_qsbr_add(struct cne_rib *rib, struct cne_rcu_qsbr *v, uint32_t dq_size);
+
 #ifdef __cplusplus
 }
 #endif
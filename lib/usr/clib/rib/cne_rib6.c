@@ -10,7 +10,9 @@
 #include <cne_mmap.h>          // for mmap_free, mmap_addr, mmap_alloc
 #include <cne_rib6.h>
 #include <bsd/string.h>        // for strlcpy
-#include <stdlib.h>            // for NULL, calloc, free
+#include <stdlib.h>            // for NULL, calloc, free, qsort
+#include <string.h>            // for memcmp
+#include <errno.h>             // for EINVAL, ENOMEM, ENOSPC
 
 #include "cne_branch_prediction.h"        // for unlikely
 #include "cne_common.h"                   // for CNE_MIN
@@ -74,14 +76,11 @@ is_covered(const uint8_t ip1[CNE_RIB6_IPV6_ADDR_SIZE], const uint8_t ip2[CNE_RIB
 static inline int
 get_dir(const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE], uint8_t depth)
 {
-    int i = 0;
-    uint8_t p_depth, msk;
+    uint8_t msk;
 
-    for (p_depth = depth; p_depth >= 8; p_depth -= 8)
-        i++;
-
-    msk = 1 << (7 - p_depth);
-    return (ip[i] & msk) != 0;
+    /* depth 128 only reaches here for a host route, which has no children */
+    msk = 1 << (7 - (depth & 7));
+    return (ip[(depth & INT8_MAX) >> 3] & msk) != 0;
 }
 
 static inline struct cne_rib6_node *
@@ -245,30 +244,23 @@ cne_rib6_remove(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE],
     }
 }
 
-struct cne_rib6_node *
-cne_rib6_insert(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE], uint8_t depth)
+/*
+ * Insert a prefix already masked to its depth and known not to be in the RIB as
+ * a valid node.
+ */
+static struct cne_rib6_node *
+rib6_insert(struct cne_rib6 *rib, const uint8_t tmp_ip[CNE_RIB6_IPV6_ADDR_SIZE], uint8_t depth)
 {
     struct cne_rib6_node **tmp;
     struct cne_rib6_node *prev        = NULL;
     struct cne_rib6_node *new_node    = NULL;
     struct cne_rib6_node *common_node = NULL;
     uint8_t common_prefix[CNE_RIB6_IPV6_ADDR_SIZE];
-    uint8_t tmp_ip[CNE_RIB6_IPV6_ADDR_SIZE];
     int i, d;
     uint8_t common_depth, ip_xor;
 
-    if (unlikely((rib == NULL) || (ip == NULL) || (depth > RIB6_MAXDEPTH)))
-        return NULL;
-
     tmp = &rib->tree;
 
-    for (i = 0; i < CNE_RIB6_IPV6_ADDR_SIZE; i++)
-        tmp_ip[i] = ip[i] & get_msk_part(depth, i);
-
-    new_node = cne_rib6_lookup_exact(rib, tmp_ip, depth);
-    if (new_node != NULL)
-        return NULL;
-
     new_node = node_alloc(rib);
     if (new_node == NULL)
         return NULL;
@@ -361,6 +353,116 @@ cne_rib6_insert(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE],
     return new_node;
 }
 
+struct cne_rib6_node *
+cne_rib6_insert(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE], uint8_t depth)
+{
+    uint8_t tmp_ip[CNE_RIB6_IPV6_ADDR_SIZE];
+    int i;
+
+    if (unlikely((rib == NULL) || (ip == NULL) || (depth > RIB6_MAXDEPTH)))
+        return NULL;
+
+    for (i = 0; i < CNE_RIB6_IPV6_ADDR_SIZE; i++)
+        tmp_ip[i] = ip[i] & get_msk_part(depth, i);
+
+    if (cne_rib6_lookup_exact(rib, tmp_ip, depth) != NULL)
+        return NULL;
+
+    return rib6_insert(rib, tmp_ip, depth);
+}
+
+/* Route of a bulk insert, with what is needed to undo it */
+struct rib6_bulk_ent {
+    uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE]; /**< Prefix masked to its depth */
+    uint8_t depth;                       /**< Prefix length */
+    uint8_t added;                       /**< The prefix was not in the RIB */
+    uint32_t idx;                        /**< Index of the route in the caller array */
+    uint64_t old_nh;                     /**< Next hop before the update */
+};
+
+static int
+rib6_bulk_cmp(const void *p1, const void *p2)
+{
+    const struct rib6_bulk_ent *e1 = p1, *e2 = p2;
+    int ret;
+
+    ret = memcmp(e1->ip, e2->ip, CNE_RIB6_IPV6_ADDR_SIZE);
+    if (ret == 0)
+        ret = (int)e1->depth - (int)e2->depth;
+    if (ret == 0)
+        ret = (e1->idx < e2->idx) ? -1 : (e1->idx > e2->idx);
+    return ret;
+}
+
+int
+cne_rib6_insert_bulk(struct cne_rib6 *rib, const struct cne_rib6_route *routes, uint32_t n)
+{
+    struct rib6_bulk_ent *ents;
+    struct cne_rib6_node *node;
+    uint32_t i, done;
+    int j;
+
+    if (rib == NULL || (routes == NULL && n != 0))
+        return -EINVAL;
+
+    for (i = 0; i < n; i++)
+        if (routes[i].depth > RIB6_MAXDEPTH)
+            return -EINVAL;
+
+    if (n == 0)
+        return 0;
+
+    ents = calloc(n, sizeof(struct rib6_bulk_ent));
+    if (ents == NULL)
+        return -ENOMEM;
+
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < CNE_RIB6_IPV6_ADDR_SIZE; j++)
+            ents[i].ip[j] = routes[i].ip[j] & get_msk_part(routes[i].depth, j);
+        ents[i].depth = routes[i].depth;
+        ents[i].idx   = i;
+    }
+
+    /*
+     * In address order a prefix comes right before its more specifics and next
+     * to its neighbors, every insert walks down the path of the previous one.
+     * Same prefixes stay in array order, the last one wins.
+     */
+    qsort(ents, n, sizeof(struct rib6_bulk_ent), rib6_bulk_cmp);
+
+    for (done = 0; done < n; done++) {
+        struct rib6_bulk_ent *e = &ents[done];
+
+        node = cne_rib6_lookup_exact(rib, e->ip, e->depth);
+        if (node == NULL) {
+            node = rib6_insert(rib, e->ip, e->depth);
+            if (node == NULL)
+                break;
+            e->added = 1;
+        } else
+            e->old_nh = node->nh;
+        node->nh = routes[e->idx].next_hop;
+    }
+
+    if (done == n) {
+        free(ents);
+        return 0;
+    }
+
+    /* Out of nodes, undo the routes already applied in reverse order */
+    while (done-- > 0) {
+        struct rib6_bulk_ent *e = &ents[done];
+
+        if (e->added)
+            cne_rib6_remove(rib, e->ip, e->depth);
+        else
+            cne_rib6_set_nh(cne_rib6_lookup_exact(rib, e->ip, e->depth), e->old_nh);
+    }
+    free(ents);
+
+    return -ENOSPC;
+}
+
 int
 cne_rib6_get_ip(const struct cne_rib6_node *node, uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE])
 {
@@ -48,6 +48,13 @@ struct cne_rib6_conf {
     int max_nodes;
 };
 
+/** Route entry of cne_rib6_insert_bulk() */
+struct cne_rib6_route {
+    uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE]; /**< Prefix address, bits past depth are ignored */
+    uint8_t depth;                       /**< Prefix length */
+    uint64_t next_hop;                   /**< Next hop set in the node of the prefix */
+};
+
 /**
  * Copy IPv6 address from one location to another
  *
@@ -213,6 +220,28 @@ CNDP_API void cne_rib6_remove(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IP
 CNDP_API struct cne_rib6_node *
 cne_rib6_insert(struct cne_rib6 *rib, const uint8_t ip[CNE_RIB6_IPV6_ADDR_SIZE], uint8_t depth);
 
+/**
+ * Insert a set of prefixes into the RIB and set their next hop
+ *
+ * The prefixes are sorted by address first, so each insert follows the tree path
+ * of the previous one. Prefixes already in the RIB get their next hop updated,
+ * when a prefix is given more than once the last entry wins. The call inserts
+ * all the prefixes or none of them.
+ *
+ * @param rib
+ *  RIB object handle
+ * @param routes
+ *  Array of routes to insert
+ * @param n
+ *  Number of routes in the array
+ * @return
+ *  0 on success
+ *  -EINVAL on invalid parameters, -ENOMEM or -ENOSPC when out of memory or
+ *  out of RIB nodes, the RIB is left unchanged
+ */
+CNDP_API int cne_rib6_insert_bulk(struct cne_rib6 *rib, const struct cne_rib6_route *routes,
+                                  uint32_t n);
+
 /**
  * Get an ip from cne_rib6_node
  *
@@ -12,6 +12,7 @@
 #include <stddef.h>            // for offsetof
 #include <stdint.h>            // for uint32_t, uint16_t, uint8_t, UINT16_MAX
 #include <stdio.h>             // for printf, NULL, size_t, EOF
+#include <stdlib.h>            // for calloc, free, random, srandom
 #include <string.h>            // for memcpy, memset
 
 #include "acl_test.h"
@@ -19,6 +20,7 @@
 #include "cne_acl.h"              // for cne_acl_free, cne_acl_field_def, cne_acl_...
 #include "cne_common.h"           // for CNE_DIM, CNE_MIN, CNE_MAX, CNE_SET_USED, SOCK...
 #include "cne_log.h"              // for CNE_LOG, CNE_LOG_ERR
+#include "cne_rcu_qsbr.h"         // for cne_rcu_qsbr_create, cne_rcu_qsbr_destroy
 
 struct cne_acl_ctx;
 
@@ -1768,6 +1770,253 @@ test_u32_range(void)
     return rc;
 }
 
+/*
+ * Classify the test data with an updatable ACL, the results must be the ones
+ * of the test data when all the rules are present or no match at all.
+ */
+static int
+test_update_run(struct cne_acl_upd *upd, struct ipv4_7tuple test_data[], size_t dim, int match)
+{
+    uint32_t results[dim * CNE_ACL_MAX_CATEGORIES];
+    const uint8_t *data[dim];
+    uint32_t allow, deny;
+    int ret = 0;
+    size_t i;
+
+    bswap_test_data(test_data, dim, 1);
+
+    for (i = 0; i < dim; i++)
+        data[i] = (uint8_t *)&test_data[i];
+
+    ret = cne_acl_upd_classify(upd, data, results, dim, CNE_ACL_MAX_CATEGORIES);
+    if (ret != 0) {
+        tst_error("Line %i: classify failed!", __LINE__);
+        goto err;
+    }
+
+    for (i = 0; i < dim; i++) {
+        allow = results[i * CNE_ACL_MAX_CATEGORIES + ACL_ALLOW];
+        deny  = results[i * CNE_ACL_MAX_CATEGORIES + ACL_DENY];
+        if (allow != (match ? test_data[i].allow : 0) || deny != (match ? test_data[i].deny : 0)) {
+            tst_error("Line %i: Error in results at %zu (got %" PRIu32 "/%" PRIu32 ")!", __LINE__,
+                      i, allow, deny);
+            ret = -EINVAL;
+            goto err;
+        }
+    }
+
+err:
+    bswap_test_data(test_data, dim, 0);
+    return ret;
+}
+
+/*
+ * Test rule updates of an updatable ACL, from the overlay and after the
+ * background build.
+ */
+static int
+test_update(void)
+{
+    struct acl_ipv4vlan_rule rules[CNE_DIM(acl_test_rules)], dup[2];
+    uint32_t ids[CNE_DIM(acl_test_rules)];
+    struct cne_acl_upd_param prm = {0};
+    struct cne_acl_config cfg        = {0};
+    struct cne_acl_upd *upd          = NULL;
+    struct cne_rcu_qsbr *v;
+    uint32_t i, half = CNE_DIM(rules) / 2;
+    int ret = -1;
+
+    tst_info("%s(%s)", __func__, "Test incremental ACL rule updates");
+
+    v = cne_rcu_qsbr_create(1);
+    if (v == NULL) {
+        tst_error("Line %i: Error creating QSBR variable!", __LINE__);
+        return -1;
+    }
+
+    for (i = 0; i < CNE_DIM(rules); i++) {
+        acl_ipv4vlan_convert_rule(&acl_test_rules[i], &rules[i]);
+        ids[i] = rules[i].data.userdata;
+    }
+
+    acl_ipv4vlan_config(&cfg, ipv4_7tuple_layout, CNE_ACL_MAX_CATEGORIES);
+    prm.name         = "acl_upd";
+    prm.rule_size    = CNE_ACL_IPV4VLAN_RULE_SZ;
+    prm.max_rule_num = CNE_DIM(rules);
+    prm.cfg          = &cfg;
+    prm.v            = v;
+
+    upd = cne_acl_upd_create(&prm);
+    if (upd == NULL) {
+        tst_error("Line %i: Error creating updatable ACL!", __LINE__);
+        goto err;
+    }
+
+    /* Rules match from the overlay before the build is done */
+    if (cne_acl_update(upd, (struct cne_acl_rule *)rules, CNE_DIM(rules), NULL, 0) != 0 ||
+        test_update_run(upd, acl_test_data, CNE_DIM(acl_test_data), 1) != 0) {
+        tst_error("Line %i: Adding rules failed!", __LINE__);
+        goto err;
+    }
+
+    if (cne_acl_upd_sync(upd) != 0 ||
+        test_update_run(upd, acl_test_data, CNE_DIM(acl_test_data), 1) != 0) {
+        tst_error("Line %i: Build of the rules failed!", __LINE__);
+        goto err;
+    }
+
+    /* Invalid updates leave the rules unchanged */
+    dup[0] = dup[1] = rules[0];
+    if (cne_acl_update(upd, (struct cne_acl_rule *)rules, 1, NULL, 0) != -EEXIST ||
+        cne_acl_update(upd, (struct cne_acl_rule *)dup, 2, ids, 1) != -EEXIST ||
+        cne_acl_update(upd, NULL, 0, (uint32_t[]){ids[0], ids[0]}, 2) != -EINVAL ||
+        cne_acl_update(upd, NULL, 0, (uint32_t[]){UINT32_MAX}, 1) != -ENOENT ||
+        cne_acl_update(upd, NULL, 1, NULL, 0) != -EINVAL ||
+        test_update_run(upd, acl_test_data, CNE_DIM(acl_test_data), 1) != 0) {
+        tst_error("Line %i: Invalid update did not fail!", __LINE__);
+        goto err;
+    }
+
+    /* Replace a rule with itself */
+    if (cne_acl_update(upd, (struct cne_acl_rule *)rules, 1, ids, 1) != 0 ||
+        cne_acl_upd_sync(upd) != 0 ||
+        test_update_run(upd, acl_test_data, CNE_DIM(acl_test_data), 1) != 0) {
+        tst_error("Line %i: Replacing a rule failed!", __LINE__);
+        goto err;
+    }
+
+    if (cne_acl_update(upd, NULL, 0, ids, CNE_DIM(ids)) != 0 || cne_acl_upd_sync(upd) != 0 ||
+        test_update_run(upd, acl_test_data, CNE_DIM(acl_test_data), 0) != 0) {
+        tst_error("Line %i: Deleting rules failed!", __LINE__);
+        goto err;
+    }
+
+    /* Rules of the overlay and of the main context compete on priority */
+    if (cne_acl_update(upd, (struct cne_acl_rule *)rules, half, NULL, 0) != 0 ||
+        cne_acl_upd_sync(upd) != 0 ||
+        cne_acl_update(upd, (struct cne_acl_rule *)&rules[half], CNE_DIM(rules) - half, NULL, 0) !=
+            0 ||
+        test_update_run(upd, acl_test_data, CNE_DIM(acl_test_data), 1) != 0) {
+        tst_error("Line %i: Merging overlay results failed!", __LINE__);
+        goto err;
+    }
+
+    ret = 0;
+err:
+    cne_acl_upd_free(upd);
+    cne_rcu_qsbr_destroy(v);
+    return ret;
+}
+
+#define TEST_BUILD_RULES   0x1000
+#define TEST_BUILD_PACKETS 0x400
+
+/*
+ * Build the same random rules on the calling thread and on a pool of workers,
+ * the rules split over several tries and both contexts must classify alike.
+ */
+static int
+test_build_workers(void)
+{
+    static const uint32_t workers[]           = {0, 4};
+    struct cne_acl_ctx *acx[CNE_DIM(workers)] = {NULL};
+    uint32_t *results[CNE_DIM(workers)]       = {NULL};
+    struct cne_acl_param prm                  = acl_param;
+    struct cne_acl_ipv4vlan_rule *rules;
+    struct ipv4_7tuple *pkts;
+    const uint8_t **data;
+    struct cne_acl_config cfg;
+    uint32_t i, n;
+    int ret = -1;
+
+    tst_info("%s(%s)", __func__, "Test ACL build on worker threads");
+
+    rules = calloc(TEST_BUILD_RULES, sizeof(*rules));
+    pkts  = calloc(TEST_BUILD_PACKETS, sizeof(*pkts));
+    data  = calloc(TEST_BUILD_PACKETS, sizeof(*data));
+    if (rules == NULL || pkts == NULL || data == NULL) {
+        tst_error("Line %i: Error allocating rules!", __LINE__);
+        goto err;
+    }
+
+    srandom(TEST_BUILD_RULES);
+    for (i = 0; i < TEST_BUILD_RULES; i++) {
+        struct cne_acl_ipv4vlan_rule *r = &rules[i];
+        uint16_t sport                  = random();
+        uint16_t dport                  = random();
+
+        r->data.userdata      = i + 1;
+        r->data.category_mask = ACL_ALLOW_MASK;
+        r->data.priority      = 1 + random() % (CNE_ACL_MAX_PRIORITY - 1);
+        r->src_mask_len       = random() % 33;
+        r->dst_mask_len       = random() % 33;
+        r->src_addr           = random() & (uint32_t)(UINT64_MAX << (32 - r->src_mask_len));
+        r->dst_addr           = random() & (uint32_t)(UINT64_MAX << (32 - r->dst_mask_len));
+        r->src_port_low       = sport;
+        r->src_port_high      = sport + random() % (UINT16_MAX - sport + 1);
+        r->dst_port_low       = dport;
+        r->dst_port_high      = dport + random() % (UINT16_MAX - dport + 1);
+    }
+
+    /* Half of the packets hit a rule, the other half are random */
+    for (i = 0; i < TEST_BUILD_PACKETS; i++) {
+        const struct cne_acl_ipv4vlan_rule *r = &rules[random() % TEST_BUILD_RULES];
+
+        pkts[i].ip_src   = (i & 1) ? (uint32_t)random() : r->src_addr;
+        pkts[i].ip_dst   = (i & 1) ? (uint32_t)random() : r->dst_addr;
+        pkts[i].port_src = (i & 1) ? (uint16_t)random() : r->src_port_low;
+        pkts[i].port_dst = (i & 1) ? (uint16_t)random() : r->dst_port_low;
+        data[i]          = (uint8_t *)&pkts[i];
+    }
+    bswap_test_data(pkts, TEST_BUILD_PACKETS, 1);
+
+    for (n = 0; n < CNE_DIM(workers); n++) {
+        char name[CNE_ACL_NAMESIZE];
+
+        snprintf(name, sizeof(name), "acl_wrk%u", workers[n]);
+        prm.name   = name;
+        acx[n]     = cne_acl_create(&prm);
+        results[n] = calloc(TEST_BUILD_PACKETS, CNE_ACL_MAX_CATEGORIES * sizeof(uint32_t));
+        if (acx[n] == NULL || results[n] == NULL) {
+            tst_error("Line %i: Error creating ACL context!", __LINE__);
+            goto err;
+        }
+
+        memset(&cfg, 0, sizeof(cfg));
+        acl_ipv4vlan_config(&cfg, ipv4_7tuple_layout, CNE_ACL_MAX_CATEGORIES);
+        cfg.num_workers = workers[n];
+
+        if (cne_acl_ipv4vlan_add_rules(acx[n], rules, TEST_BUILD_RULES) != 0 ||
+            cne_acl_build(acx[n], &cfg) != 0) {
+            tst_error("Line %i: Error building ACL with %u workers!", __LINE__, workers[n]);
+            goto err;
+        }
+
+        if (cne_acl_classify(acx[n], data, results[n], TEST_BUILD_PACKETS,
+                             CNE_ACL_MAX_CATEGORIES) != 0) {
+            tst_error("Line %i: classify failed!", __LINE__);
+            goto err;
+        }
+    }
+
+    if (memcmp(results[0], results[1],
+               TEST_BUILD_PACKETS * CNE_ACL_MAX_CATEGORIES * sizeof(uint32_t)) != 0) {
+        tst_error("Line %i: Results differ with %u workers!", __LINE__, workers[1]);
+        goto err;
+    }
+
+    ret = 0;
+err:
+    for (n = 0; n < CNE_DIM(workers); n++) {
+        cne_acl_free(acx[n]);
+        free(results[n]);
+    }
+    free(rules);
+    free(pkts);
+    free(data);
+    return ret;
+}
+
 int
 acl_main(int argc, char **argv)
 {
@@ -1816,6 +2065,10 @@ acl_main(int argc, char **argv)
         goto err;
     if (test_u32_range() < 0)
         goto err;
+    if (test_update() < 0)
+        goto err;
+    if (test_build_workers() < 0)
+        goto err;
 
     tst_ok("All ACL tests passed");
     tst_end(tst, TST_PASSED);
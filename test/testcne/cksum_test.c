@@ -0,0 +1,221 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdlib.h>        // for rand
+#include <string.h>        // for memcpy, memset
+
+#include <cne_common.h>        // for __cne_unused, CNE_DIM
+#include <net/cne_ip.h>        // for cne_raw_cksum, cne_ipv4_cksum_bulk, cne_ipv4_ttl_dec
+#include <net/cne_tcp.h>       // for cne_tcp_hdr
+#include <net/cne_udp.h>       // for cne_udp_hdr
+#include <tst_info.h>          // for tst_start, tst_end, tst_error
+
+#include "cksum_test.h"
+
+#define CKSUM_BUF_SIZE  (CNE_IPV4_MAX_PKT_LEN + 64)
+#define CKSUM_NB_HDRS   64
+#define CKSUM_NB_ROUNDS 1000
+
+static uint8_t buf[CKSUM_BUF_SIZE];
+
+/* One word at a time reference for the raw checksum */
+static uint16_t
+ref_cksum(const uint8_t *p, size_t len)
+{
+    uint32_t sum = 0;
+    uint16_t w;
+
+    for (; len > 1; len -= 2, p += 2) {
+        memcpy(&w, p, sizeof(w));
+        sum += w;
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    if (len) {
+        w              = 0;
+        *(uint8_t *)&w = *p;
+        sum += w;
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+
+    return (uint16_t)sum;
+}
+
+static void
+fill_rand(void *p, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        ((uint8_t *)p)[i] = rand() & 0xFF;
+}
+
+/* Any length and alignment must give the result of the scalar reference, SIMD or not */
+static int
+test_raw(void)
+{
+    fill_rand(buf, sizeof(buf));
+
+    for (size_t len = 0; len <= 256; len++) {
+        for (size_t off = 0; off < 8; off++) {
+            if (cne_raw_cksum(&buf[off], len) != ref_cksum(&buf[off], len)) {
+                tst_error("raw checksum of %zu bytes at offset %zu\n", len, off);
+                return -1;
+            }
+        }
+    }
+
+    for (int i = 0; i < CKSUM_NB_ROUNDS; i++) {
+        size_t off = rand() % 64;
+        size_t len = rand() % (CNE_IPV4_MAX_PKT_LEN + 1);
+
+        if (cne_raw_cksum(&buf[off], len) != ref_cksum(&buf[off], len)) {
+            tst_error("raw checksum of %zu bytes at offset %zu\n", len, off);
+            return -1;
+        }
+    }
+
+    /* All ones data must not overflow the sums of the vector lanes */
+    memset(buf, 0xFF, sizeof(buf));
+    if (cne_raw_cksum(buf, CNE_IPV4_MAX_PKT_LEN) != ref_cksum(buf, CNE_IPV4_MAX_PKT_LEN)) {
+        tst_error("raw checksum of all ones data\n");
+        return -1;
+    }
+
+    memset(buf, 0, sizeof(buf));
+    if (cne_raw_cksum(buf, CNE_IPV4_MAX_PKT_LEN) != 0) {
+        tst_error("raw checksum of zero data is not zero\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/* The bulk checksum of headers with and without options is the one of cne_ipv4_cksum() */
+static int
+test_bulk(void)
+{
+    struct cne_ipv4_hdr *hdrs[CKSUM_NB_HDRS];
+    uint16_t cksums[CKSUM_NB_HDRS];
+
+    for (int i = 0; i < CKSUM_NB_ROUNDS; i++) {
+        int n = rand() % (CKSUM_NB_HDRS + 1);
+
+        for (int j = 0; j < n; j++) {
+            /* Unaligned headers of up to 24 bytes, some have options */
+            hdrs[j] = (struct cne_ipv4_hdr *)&buf[j * 32 + (rand() % 8)];
+            fill_rand(hdrs[j], 24);
+            hdrs[j]->version_ihl = (rand() % 8) ? CNE_IPV4_VHL_DEF : (CNE_IPV4_VHL_DEF + 1);
+
+            /* Half the headers have a valid checksum */
+            if (rand() & 1) {
+                hdrs[j]->hdr_checksum = 0;
+                hdrs[j]->hdr_checksum = cne_ipv4_cksum(hdrs[j]);
+            }
+        }
+
+        cne_ipv4_cksum_bulk(hdrs, cksums, n);
+
+        for (int j = 0; j < n; j++) {
+            if (cksums[j] != cne_ipv4_cksum(hdrs[j])) {
+                tst_error("bulk checksum %04x of header %d, expected %04x\n", cksums[j], j,
+                          cne_ipv4_cksum(hdrs[j]));
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* The incremental updates must give the checksums computed from scratch */
+static int
+test_incremental(void)
+{
+    struct {
+        struct cne_ipv4_hdr ip;
+        union {
+            struct cne_tcp_hdr tcp;
+            struct cne_udp_hdr udp;
+        };
+        uint8_t data[37];
+    } __cne_packed pkt;
+
+    for (int i = 0; i < CKSUM_NB_ROUNDS * 10; i++) {
+        bool udp = (i & 1);
+        cne_be16_t *l4_cksum, id;
+
+        fill_rand(&pkt, sizeof(pkt));
+        pkt.ip.version_ihl   = CNE_IPV4_VHL_DEF;
+        pkt.ip.total_length  = htobe16(sizeof(pkt));
+        pkt.ip.time_to_live  = (rand() % 254) + 2;
+        pkt.ip.next_proto_id = (udp) ? IPPROTO_UDP : IPPROTO_TCP;
+        pkt.ip.hdr_checksum  = 0;
+        pkt.ip.hdr_checksum  = cne_ipv4_cksum(&pkt.ip);
+
+        l4_cksum  = (udp) ? &pkt.udp.dgram_cksum : &pkt.tcp.cksum;
+        *l4_cksum = 0;
+        *l4_cksum = cne_ipv4_udptcp_cksum(&pkt.ip, &pkt.tcp);
+
+        cne_ipv4_ttl_dec(&pkt.ip);
+        if (cne_ipv4_cksum(&pkt.ip)) {
+            tst_error("IPv4 checksum is invalid after a TTL decrement\n");
+            return -1;
+        }
+
+        id                  = rand();
+        pkt.ip.hdr_checksum = cne_cksum_adjust16(pkt.ip.hdr_checksum, pkt.ip.packet_id, id);
+        pkt.ip.packet_id    = id;
+        if (cne_ipv4_cksum(&pkt.ip)) {
+            tst_error("IPv4 checksum is invalid after a packet ID update\n");
+            return -1;
+        }
+
+        cne_ipv4_addr_rewrite(&pkt.ip, l4_cksum, (rand() & 1), rand());
+        if (cne_ipv4_cksum(&pkt.ip)) {
+            tst_error("IPv4 checksum is invalid after an address rewrite\n");
+            return -1;
+        }
+        if ((udp && *l4_cksum == 0) || cne_ipv4_udptcp_cksum_verify(&pkt.ip, &pkt.tcp)) {
+            tst_error("%s checksum %04x is invalid after an address rewrite\n",
+                      (udp) ? "UDP" : "TCP", *l4_cksum);
+            return -1;
+        }
+    }
+
+    /* A UDP datagram without checksum keeps a zero checksum */
+    pkt.ip.next_proto_id = IPPROTO_UDP;
+    pkt.udp.dgram_cksum  = 0;
+    cne_ipv4_addr_rewrite(&pkt.ip, &pkt.udp.dgram_cksum, false, rand());
+    if (pkt.udp.dgram_cksum) {
+        tst_error("UDP checksum %04x set on a datagram without checksum\n", pkt.udp.dgram_cksum);
+        return -1;
+    }
+
+    return 0;
+}
+
+int
+cksum_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        int (*fn)(void);
+    } tsts[] = {
+        {"Checksum: raw", test_raw},
+        {"Checksum: IPv4 bulk", test_bulk},
+        {"Checksum: incremental", test_incremental},
+    };
+    // clang-format on
+    tst_info_t *tst;
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (tsts[i].fn()) {
+            tst_end(tst, TST_FAILED);
+            return -1;
+        }
+        tst_end(tst, TST_PASSED);
+    }
+
+    return 0;
+}
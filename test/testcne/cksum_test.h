@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _CKSUM_TEST_H_
+#define _CKSUM_TEST_H_
+
+int cksum_main(int argc, char **argv);
+
+#endif /* _CKSUM_TEST_H_ */
@@ -16,6 +16,7 @@
 #include "acl_test.h"                 // for acl_main
 #include "cne_register_test.h"        // for cne_register_main
 #include "cthread_test.h"             // for cthread_main
+#include "distributor_test.h"         // for distributor_main
 #include "dsa_test.h"                 // for dsa_main
 #include "jcfg_test.h"                // for jcfg_main
 #include "loop_test.h"                // for loop_main
@@ -25,7 +26,9 @@
 #include "mmap_test.h"                // for mmap_main
 #include "pktcpy_test.h"              // for pktcpy_main
 #include "cne_lport.h"                // for lport_stats_t
+#include "pcb_test.h"                 // for pcb_main
 #include "pkt_test.h"                 // for pkt_main
+#include "rcu_test.h"                 // for rcu_main
 #include "ring_test.h"                // for ring_main
 #include "ring_api.h"                 // for ring_api_main
 #include "ring_profile.h"             // for ring_profile
@@ -34,6 +37,15 @@
 #include "pktdev_test.h"              // for pktdev_main
 #include "kvargs_test.h"              // for kvargs_main
 #include "graph_test.h"               // for graph_main, graph_perf_main
+#include "gso_test.h"                 // for gso_main
+#include "cksum_test.h"               // for cksum_main
+#include "ip_frag_test.h"             // for ip_frag_main
+#include "tcp_cc_test.h"              // for tcp_cc_main
+#include "tcp_gro_test.h"             // for tcp_gro_main
+#include "tcp_reass_test.h"           // for tcp_reass_main
+#include "tcp_sack_test.h"            // for tcp_sack_main
+#include "tcp_snd_test.h"             // for tcp_snd_main
+#include "tcp_wheel_test.h"           // for tcp_wheel_main
 #include "hmap_test.h"                // for hmap_main
 #include "timer_test.h"               // for timer_main
 #include "xskdev_test.h"              // for xskdev_main
@@ -102,8 +114,10 @@ static int
 all_tests(int argc, char **argv)
 {
     acl_main(argc, argv);
+    cksum_main(argc, argv);
     cne_register_main(argc, argv);
     cthread_main(argc, argv);
+    distributor_main(argc, argv);
     dsa_main(argc, argv);
     fib_main(argc, argv);
     fib_perf_main(argc, argv);
@@ -111,6 +125,7 @@ all_tests(int argc, char **argv)
     fib6_perf_main(argc, argv);
     graph_main(argc, argv);
     graph_perf_main(argc, argv);
+    gso_main(argc, argv);
     hash_main(argc, argv);
     hash_perf_main(argc, argv);
     hmap_main(argc, argv);
@@ -118,6 +133,7 @@ all_tests(int argc, char **argv)
 #ifdef HAS_UINTR_SUPPORT
     ibroker_main(argc, argv);
 #endif
+    ip_frag_main(argc, argv);
     jcfg_main(argc, argv);
     kvargs_main(argc, argv);
     log_main(argc, argv);
@@ -127,15 +143,23 @@ all_tests(int argc, char **argv)
     mmap_main(argc, argv);
     meter_main(argc, argv);
     msgchan_main(argc, argv);
+    pcb_main(argc, argv);
     pkt_main(argc, argv);
     pktcpy_main(argc, argv);
     pktdev_main(argc, argv);
+    rcu_main(argc, argv);
     rib_main(argc, argv);
     rib6_main(argc, argv);
     ring_api_main(argc, argv);
     ring_main(argc, argv);
     ring_profile(argc, argv);
     tailqs_main(argc, argv);
+    tcp_cc_main(argc, argv);
+    tcp_gro_main(argc, argv);
+    tcp_reass_main(argc, argv);
+    tcp_sack_main(argc, argv);
+    tcp_snd_main(argc, argv);
+    tcp_wheel_main(argc, argv);
     thread_main(argc, argv);
     timer_main(argc, argv);
     uid_main(argc, argv);
@@ -151,8 +175,10 @@ static struct cli_tree default_tree[] = {
 
     c_cmd("acl", acl_main, "Run the ACL tests"),
     c_cmd("all", all_tests, "Run all tests"),
+    c_cmd("cksum", cksum_main, "Run the checksum test"),
     c_cmd("cne", cne_register_main, "Run the CNE registration tests"),
     c_cmd("cthread", cthread_main, "Run the cthread API test"),
+    c_cmd("distributor", distributor_main, "Run the flow distributor test"),
     c_cmd("dsa", dsa_main, "Run the dsa API test"),
     c_cmd("fib", fib_main, "Run the FIB test"),
     c_cmd("fib_perf", fib_perf_main, "Run the FIB Perf test"),
@@ -160,6 +186,7 @@ static struct cli_tree default_tree[] = {
     c_cmd("fib6_perf", fib6_perf_main, "Run the FIB6 Perf test"),
     c_cmd("graph_perf", graph_perf_main, "Run the graph perf test"),
     c_cmd("graph", graph_main, "Run the graph test"),
+    c_cmd("gso", gso_main, "Run the GSO test"),
     c_cmd("hash_perf", hash_perf_main, "Run the hash perf test"),
     c_cmd("hash", hash_main, "Run the hash test"),
     c_cmd("hmap", hmap_main, "Run the HashMap CFG file tests"),
@@ -167,6 +194,7 @@ static struct cli_tree default_tree[] = {
 #ifdef HAS_UINTR_SUPPORT
     c_cmd("ibroker", ibroker_main, "Run the ibroker tests"),
 #endif
+    c_cmd("ip_frag", ip_frag_main, "Run the IPv4 fragmentation test"),
     c_cmd("jcfg", jcfg_main, "Run the JSON CFG file tests"),
     c_cmd("kvargs", kvargs_main, "Run the KVARGS tests"),
     c_cmd("log", log_main, "Run log test"),
@@ -177,15 +205,23 @@ static struct cli_tree default_tree[] = {
     c_cmd("mmap", mmap_main, "Run MMAP test"),
     c_cmd("meter", meter_main, "Run Meter test"),
     c_cmd("msgchan", msgchan_main, "Run Message Channel test"),
+    c_cmd("pcb", pcb_main, "Run the PCB lookup test"),
     c_cmd("pkt", pkt_main, "Run PKT test"),
     c_cmd("pktcpy", pktcpy_main, "Run pktcpy test"),
     c_cmd("pktdev", pktdev_main, "Run the pktdev tests"),
+    c_cmd("rcu", rcu_main, "Run RCU QSBR test"),
     c_cmd("rib", rib_main, "Run RIB tests"),
     c_cmd("rib6", rib6_main, "Run RIB6 tests"),
     c_cmd("ring_api", ring_api_main, "Run RING api tests"),
     c_cmd("ring_profile", ring_profile, "Run RING profile test"),
     c_cmd("ring", ring_main, "Run RING test"),
     c_cmd("tailqs", tailqs_main, "Run TailQ test"),
+    c_cmd("tcp_cc", tcp_cc_main, "Run the TCP congestion control test"),
+    c_cmd("tcp_gro", tcp_gro_main, "Run the TCP receive offload test"),
+    c_cmd("tcp_reass", tcp_reass_main, "Run the TCP reassembly queue test"),
+    c_cmd("tcp_sack", tcp_sack_main, "Run the TCP SACK scoreboard test"),
+    c_cmd("tcp_snd", tcp_snd_main, "Run the TCP send buffer test"),
+    c_cmd("tcp_wheel", tcp_wheel_main, "Run the TCP timing wheel test"),
     c_cmd("sizeof", sizeof_cmd, "Size of structures"),
     c_cmd("thread", thread_main, "Run the Thread test"),
     c_cmd("timer", timer_main, "Run the Timer test"),
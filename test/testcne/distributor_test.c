@@ -0,0 +1,246 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>                 // for NULL, EOF
+#include <stdint.h>                // for uint16_t, uint32_t
+#include <string.h>                // for memset
+#include <getopt.h>                // for getopt_long, option
+#include <netinet/in.h>            // for IPPROTO_UDP
+#include <cne_common.h>            // for cne_countof
+#include <cne_mmap.h>              // for mmap_alloc, mmap_addr, mmap_free
+#include <pktmbuf.h>               // for pktmbuf_pool_create, pktmbuf_alloc_bulk
+#include <net/cne_ether.h>         // for cne_ether_hdr
+#include <net/cne_ip.h>            // for cne_ipv4_hdr
+#include <net/cne_udp.h>           // for cne_udp_hdr
+#include <cne_distributor.h>       // for cne_distributor_create, cne_distributor_process
+#include <tst_info.h>              // for tst_end, tst_start, TST_FAILED, TST_PASSED
+
+#include "distributor_test.h"
+
+#define DIST_TEST_WORKERS   4
+#define DIST_TEST_FLOWS     32
+#define DIST_TEST_PKTS      256
+#define DIST_TEST_RING_SIZE 512
+
+static pktmbuf_info_t *pi;
+static mmap_t *mm;
+
+static int
+alloc_pool(void)
+{
+    mm = mmap_alloc(DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), DEFAULT_MBUF_COUNT, DEFAULT_MBUF_SIZE, 0, NULL);
+    if (!pi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        mmap_free(mm);
+        mm = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+free_pool(void)
+{
+    if (pi)
+        pktmbuf_destroy(pi);
+    pi = NULL;
+
+    if (mm)
+        mmap_free(mm);
+    mm = NULL;
+}
+
+/* Build an Ethernet/IPv4/UDP packet for the given flow number */
+static void
+build_pkt(pktmbuf_t *m, uint32_t flow)
+{
+    struct cne_ether_hdr *eth;
+    struct cne_ipv4_hdr *ip;
+    struct cne_udp_hdr *udp;
+
+    eth = (struct cne_ether_hdr *)pktmbuf_append(
+        m, sizeof(*eth) + sizeof(*ip) + sizeof(*udp));
+    memset(eth, 0, sizeof(*eth) + sizeof(*ip) + sizeof(*udp));
+    eth->ether_type = htobe16(CNE_ETHER_TYPE_IPV4);
+
+    ip                = (struct cne_ipv4_hdr *)(eth + 1);
+    ip->version_ihl   = CNE_IPV4_VHL_DEF;
+    ip->next_proto_id = IPPROTO_UDP;
+    ip->src_addr      = htobe32(CNE_IPV4(198, 18, 0, 1) + flow);
+    ip->dst_addr      = htobe32(CNE_IPV4(198, 19, 0, 1));
+
+    udp            = (struct cne_udp_hdr *)(ip + 1);
+    udp->src_port  = htobe16(1024 + flow);
+    udp->dst_port  = htobe16(4789);
+}
+
+static int
+test_distributor_flows(void)
+{
+    struct cne_distributor_cfg cfg = {.name        = "dist-test",
+                                      .num_workers = DIST_TEST_WORKERS,
+                                      .ring_size   = DIST_TEST_RING_SIZE};
+    struct cne_distributor_stats stats;
+    struct cne_distributor *d;
+    pktmbuf_t *pkts[DIST_TEST_PKTS], *out[DIST_TEST_PKTS];
+    uint16_t flow_worker[DIST_TEST_FLOWS];
+    uint32_t total = 0;
+    uint16_t n;
+
+    d = cne_distributor_create(&cfg);
+    if (!d) {
+        tst_error("cne_distributor_create() failed\n");
+        return -1;
+    }
+
+    if (pktmbuf_alloc_bulk(pi, pkts, DIST_TEST_PKTS) != DIST_TEST_PKTS) {
+        tst_error("pktmbuf_alloc_bulk() failed\n");
+        goto err;
+    }
+    for (int i = 0; i < DIST_TEST_PKTS; i++) {
+        build_pkt(pkts[i], i % DIST_TEST_FLOWS);
+        pkts[i]->meta_index = i % DIST_TEST_FLOWS; /* remember the flow */
+    }
+
+    n = cne_distributor_process(d, pkts, DIST_TEST_PKTS);
+    if (n != DIST_TEST_PKTS) {
+        tst_error("cne_distributor_process() returned %u\n", n);
+        pktmbuf_free_bulk(&pkts[n], DIST_TEST_PKTS - n);
+        goto err;
+    }
+
+    /* Every packet of a flow must reach the same worker */
+    memset(flow_worker, 0xff, sizeof(flow_worker));
+    for (uint16_t w = 0; w < DIST_TEST_WORKERS; w++) {
+        n = cne_distributor_dequeue(d, w, out, DIST_TEST_PKTS);
+        for (uint16_t i = 0; i < n; i++) {
+            uint32_t flow = out[i]->meta_index;
+
+            if (cne_distributor_worker_get(d, pktmbuf_hash(out[i])) != w ||
+                (flow_worker[flow] != 0xffff && flow_worker[flow] != w)) {
+                tst_error("Flow %u delivered to worker %u\n", flow, w);
+                pktmbuf_free_bulk(out, n);
+                goto err;
+            }
+            flow_worker[flow] = w;
+        }
+        if (cne_distributor_stats_get(d, w, &stats) < 0 || stats.enqueued != n ||
+            stats.dequeued != n) {
+            tst_error("Worker %u stats do not match %u packets\n", w, n);
+            pktmbuf_free_bulk(out, n);
+            goto err;
+        }
+        total += n;
+        pktmbuf_free_bulk(out, n);
+    }
+
+    if (total != DIST_TEST_PKTS) {
+        tst_error("Dequeued %u packets expected %u\n", total, DIST_TEST_PKTS);
+        goto err;
+    }
+
+    cne_distributor_destroy(d);
+    return 0;
+err:
+    cne_distributor_destroy(d);
+    return -1;
+}
+
+static int
+test_distributor_full(void)
+{
+    struct cne_distributor_cfg cfg = {.name = "dist-full", .num_workers = 2, .ring_size = 64};
+    uint16_t reta[CNE_DISTRIBUTOR_RETA_SIZE];
+    struct cne_distributor *d;
+    pktmbuf_t *pkts[DIST_TEST_PKTS];
+    uint16_t n;
+
+    d = cne_distributor_create(&cfg);
+    if (!d) {
+        tst_error("cne_distributor_create() failed\n");
+        return -1;
+    }
+
+    /* Send everything to worker 1, the ring holds 63 entries */
+    for (int i = 0; i < CNE_DISTRIBUTOR_RETA_SIZE; i++)
+        reta[i] = 1;
+    if (cne_distributor_reta_update(d, reta) < 0) {
+        tst_error("cne_distributor_reta_update() failed\n");
+        goto err;
+    }
+    reta[0] = cfg.num_workers;
+    if (cne_distributor_reta_update(d, reta) == 0) {
+        tst_error("cne_distributor_reta_update() accepted an invalid worker\n");
+        goto err;
+    }
+
+    if (pktmbuf_alloc_bulk(pi, pkts, DIST_TEST_PKTS / 2) != DIST_TEST_PKTS / 2) {
+        tst_error("pktmbuf_alloc_bulk() failed\n");
+        goto err;
+    }
+    for (int i = 0; i < DIST_TEST_PKTS / 2; i++)
+        build_pkt(pkts[i], i);
+
+    n = cne_distributor_process(d, pkts, DIST_TEST_PKTS / 2);
+    pktmbuf_free_bulk(&pkts[n], (DIST_TEST_PKTS / 2) - n);
+    if (n != 63) {
+        tst_error("Enqueued %u packets into a 64 entry ring\n", n);
+        goto err;
+    }
+
+    /* The remaining packets are freed with the distributor */
+    cne_distributor_destroy(d);
+    return 0;
+err:
+    cne_distributor_destroy(d);
+    return -1;
+}
+
+int
+distributor_main(int argc, char **argv)
+{
+    tst_info_t *tst;
+    int opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    while ((opt = getopt_long(argc, argvopt, "v", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'v':
+            break;
+        default:
+            break;
+        }
+    }
+
+    tst = tst_start("Distributor");
+
+    if (alloc_pool() < 0)
+        goto leave;
+
+    if (test_distributor_flows() < 0)
+        goto leave;
+
+    if (test_distributor_full() < 0)
+        goto leave;
+
+    free_pool();
+    tst_end(tst, TST_PASSED);
+
+    return 0;
+leave:
+    free_pool();
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _DISTRIBUTOR_TEST_H_
+#define _DISTRIBUTOR_TEST_H_
+
+/**
+ * @file
+ * CNE Flow Distributor Test
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int distributor_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DISTRIBUTOR_TEST_H_ */
@@ -7,7 +7,8 @@
 #include <stdlib.h>              // for srand
 #include <string.h>              // for memcpy
 #include <getopt.h>              // for getopt_long, option
-#include <cne_cycles.h>          // for cne_rdtsc
+#include <cne_cycles.h>          // for cne_rdtsc, MS_PER_S
+#include <cne_system.h>          // for cne_get_timer_hz
 #include <private_fib6.h>        // for CNE_FIB6_TRIE
 #include <cne_fib6.h>            // for cne_fib6_conf, cne_fib6_conf::(anonymous...
 #include <tst_info.h>            // for tst_end, tst_start, TST_FAILED, TST_PASSED
@@ -65,18 +66,103 @@ get_max_nh(uint8_t nh_sz)
     return ((1ULL << (bits_in_nh(nh_sz) - 1)) - 1);
 }
 
+static const struct {
+    enum cne_fib6_lookup_type type;
+    const char *name;
+} lookup_types[] = {
+    {CNE_FIB6_LOOKUP_TRIE_SCALAR, "scalar"},
+    {CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX2, "avx2"},
+    {CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX512, "avx512"},
+    {CNE_FIB6_LOOKUP_DEFAULT, "default"},
+};
+
+static uint8_t ip_batch[NUM_IPS_ENTRIES][16];
+
+static void
+test_fib6_bulk_lookup_perf(struct cne_fib6 *fib, const char *name)
+{
+    uint64_t next_hops[NUM_IPS_ENTRIES];
+    uint64_t begin, total_time = 0;
+    int64_t count = 0;
+    unsigned int i, j;
+
+    for (i = 0; i < ITERATIONS; i++) {
+
+        /* Lookup per batch */
+        begin = cne_rdtsc();
+        cne_fib6_lookup_bulk(fib, ip_batch, next_hops, NUM_IPS_ENTRIES);
+        total_time += cne_rdtsc() - begin;
+
+        for (j = 0; j < NUM_IPS_ENTRIES; j++)
+            if (next_hops[j] == 0)
+                count++;
+    }
+    cne_printf("BULK FIB Lookup %-8s: %.1f cycles (fails = %.1f%%)\n", name,
+               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
+               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+}
+
+static double
+cycles_to_ms(uint64_t cycles)
+{
+    return ((double)cycles * MS_PER_S) / (double)cne_get_timer_hz();
+}
+
+/* Load the same routes with cne_fib6_add_bulk() and check both FIBs agree */
+static int
+test_fib6_bulk_perf(struct cne_fib6 *fib, struct cne_fib6_conf *conf, uint64_t add_time)
+{
+    static struct cne_fib6_route routes[NUM_ROUTE_ENTRIES];
+    static uint64_t nh1[NUM_IPS_ENTRIES], nh2[NUM_IPS_ENTRIES];
+    struct cne_fib6 *bulk_fib;
+    uint64_t begin, total_time;
+    unsigned int i;
+    int ret;
+
+    for (i = 0; i < NUM_ROUTE_ENTRIES; i++) {
+        memcpy(routes[i].ip, large_route_table[i].ip, 16);
+        routes[i].depth    = large_route_table[i].depth;
+        routes[i].next_hop = (i & ((1 << 14) - 1)) + 1;
+    }
+
+    bulk_fib = cne_fib6_create("test_fib6_bulk", conf);
+    TEST_FIB_ASSERT(bulk_fib != NULL);
+
+    begin      = cne_rdtsc();
+    ret        = cne_fib6_add_bulk(bulk_fib, routes, NUM_ROUTE_ENTRIES);
+    total_time = cne_rdtsc() - begin;
+    if (ret != 0) {
+        cne_fib6_free(bulk_fib);
+        TEST_FIB_ASSERT(0);
+    }
+
+    cne_printf("FIB6 startup per route add: %.1f ms\n", cycles_to_ms(add_time));
+    cne_printf("FIB6 startup bulk add     : %.1f ms (%g cycles per route)\n",
+               cycles_to_ms(total_time), (double)total_time / NUM_ROUTE_ENTRIES);
+
+    cne_fib6_lookup_bulk(fib, ip_batch, nh1, NUM_IPS_ENTRIES);
+    cne_fib6_lookup_bulk(bulk_fib, ip_batch, nh2, NUM_IPS_ENTRIES);
+    cne_fib6_free(bulk_fib);
+
+    for (i = 0; i < NUM_IPS_ENTRIES; i++) {
+        if (nh1[i] != nh2[i]) {
+            cne_printf("Bulk FIB6 mismatch at %u: %lu != %lu\n", i, nh1[i], nh2[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 static int
 test_fib6_perf(void)
 {
     struct cne_fib6 *fib = NULL;
     struct cne_fib6_conf conf;
     uint64_t begin, total_time;
-    unsigned int i, j;
+    unsigned int i;
     uint64_t next_hop_add;
-    int status    = 0;
-    int64_t count = 0;
-    uint8_t ip_batch[NUM_IPS_ENTRIES][16];
-    uint64_t next_hops[NUM_IPS_ENTRIES];
+    int status = 0;
 
     conf.type          = CNE_FIB6_TRIE;
     conf.default_nh    = 0;
@@ -113,27 +199,22 @@ test_fib6_perf(void)
     cne_printf("Unique added entries = %d\n", status);
     cne_printf("Average FIB Add: %g cycles\n", (double)total_time / NUM_ROUTE_ENTRIES);
 
-    /* Measure bulk Lookup */
-    total_time = 0;
-    count      = 0;
-
     for (i = 0; i < NUM_IPS_ENTRIES; i++)
         memcpy(ip_batch[i], large_ips_table[i].ip, 16);
 
-    for (i = 0; i < ITERATIONS; i++) {
-
-        /* Lookup per batch */
-        begin = cne_rdtsc();
-        cne_fib6_lookup_bulk(fib, ip_batch, next_hops, NUM_IPS_ENTRIES);
-        total_time += cne_rdtsc() - begin;
+    /* Measure bulk Lookup with every lookup implementation */
+    for (i = 0; i < CNE_DIM(lookup_types); i++) {
+        if (cne_fib6_select_lookup(fib, lookup_types[i].type) < 0) {
+            cne_printf("BULK FIB Lookup %-8s: not supported\n", lookup_types[i].name);
+            continue;
+        }
+        test_fib6_bulk_lookup_perf(fib, lookup_types[i].name);
+    }
 
-        for (j = 0; j < NUM_IPS_ENTRIES; j++)
-            if (next_hops[j] == 0)
-                count++;
+    if (test_fib6_bulk_perf(fib, &conf, total_time) < 0) {
+        cne_fib6_free(fib);
+        return -1;
     }
-    cne_printf("BULK FIB Lookup: %.1f cycles (fails = %.1f%%)\n",
-               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
-               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
 
     /* Delete */
     status = 0;
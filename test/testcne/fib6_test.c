@@ -26,6 +26,8 @@ static int32_t test_free_null(void);
 static int32_t test_add_del_invalid(void);
 static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
+static int32_t test_lookup_avx2(void);
+static int32_t test_add_bulk(void);
 
 #define MAX_ROUTES (1 << 16)
 /** Maximum number of tbl8 for 2-byte entries */
@@ -345,13 +347,108 @@ test_lookup(void)
     return TEST_SUCCESS;
 }
 
+/*
+ * Run the lookup checks with the AVX2 lookup function selected, skipped when the
+ * CPU or the build does not support it
+ */
+int32_t
+test_lookup_avx2(void)
+{
+    static const enum cne_fib_trie_nh_sz nh_sz[] = {CNE_FIB6_TRIE_2B, CNE_FIB6_TRIE_4B,
+                                                    CNE_FIB6_TRIE_8B};
+    struct cne_fib6 *fib = NULL;
+    struct cne_fib6_conf config;
+    int ret;
+
+    config.max_routes    = MAX_ROUTES;
+    config.default_nh    = 100;
+    config.type          = CNE_FIB6_TRIE;
+    config.trie.num_tbl8 = MAX_TBL8 - 1;
+
+    for (unsigned int i = 0; i < CNE_DIM(nh_sz); i++) {
+        config.trie.nh_sz = nh_sz[i];
+        fib               = cne_fib6_create(__func__, &config);
+        CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+        if (cne_fib6_select_lookup(fib, CNE_FIB6_LOOKUP_TRIE_VECTOR_AVX2) < 0) {
+            cne_fib6_free(fib);
+            return TEST_SKIPPED;
+        }
+
+        ret = check_fib(fib);
+        cne_fib6_free(fib);
+        CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Check_fib fails for AVX2 lookup, nh_sz %d\n",
+                        nh_sz[i]);
+    }
+
+    return TEST_SUCCESS;
+}
+
+/*
+ * Add the routes of one supernet with all possible depths in one call, with a
+ * stale next hop given first for every prefix, and check the lookups
+ */
+int32_t
+test_add_bulk(void)
+{
+    static const enum cne_fib6_type types[] = {CNE_FIB6_DUMMY, CNE_FIB6_TRIE};
+    struct cne_fib6_route routes[2 * CNE_FIB6_MAXDEPTH];
+    uint8_t ip_arr[CNE_FIB6_MAXDEPTH][CNE_FIB6_IPV6_ADDR_SIZE];
+    uint8_t ip_missing[1][CNE_FIB6_IPV6_ADDR_SIZE] = {{127}};
+    struct cne_fib6 *fib                           = NULL;
+    struct cne_fib6_conf config;
+    uint64_t def_nh = 100;
+    uint32_t i, j;
+    int ret;
+
+    for (i = 0; i < CNE_FIB6_MAXDEPTH; i++) {
+        struct cne_fib6_route *r = &routes[i + CNE_FIB6_MAXDEPTH];
+
+        /* host bits are set, they must be ignored */
+        for (j = 0; j < CNE_FIB6_IPV6_ADDR_SIZE; j++)
+            r->ip[j] = 0xff & ~get_msk_part(i + 1, j);
+        r->ip[0] |= 128;
+        r->depth    = i + 1;
+        r->next_hop = i + 1;
+
+        routes[i]          = *r;
+        routes[i].next_hop = def_nh + 1;
+
+        for (j = 0; j < CNE_FIB6_IPV6_ADDR_SIZE; j++)
+            ip_arr[i][j] = (j == 0 ? 128 : 0) | ~get_msk_part(CNE_FIB6_MAXDEPTH - i, j);
+    }
+
+    config.max_routes    = MAX_ROUTES;
+    config.default_nh    = def_nh;
+    config.trie.nh_sz    = CNE_FIB6_TRIE_4B;
+    config.trie.num_tbl8 = MAX_TBL8;
+
+    for (i = 0; i < CNE_DIM(types); i++) {
+        config.type = types[i];
+        fib         = cne_fib6_create(__func__, &config);
+        CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+        CNE_TEST_ASSERT(cne_fib6_add_bulk(fib, NULL, 1) < 0,
+                        "Call succeeded with invalid parameters\n");
+
+        ret = cne_fib6_add_bulk(fib, routes, CNE_DIM(routes));
+        if (ret == 0)
+            ret = lookup_and_check_asc(fib, ip_arr, ip_missing, def_nh, CNE_FIB6_MAXDEPTH);
+        cne_fib6_free(fib);
+        CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Bulk add fails for FIB type %d\n", types[i]);
+    }
+
+    return TEST_SUCCESS;
+}
+
 static struct unit_test_suite fib6_fast_tests = {
     .suite_name      = "fib6 autotest",
     .setup           = NULL,
     .teardown        = NULL,
     .unit_test_cases = {TEST_CASE(test_create_invalid), TEST_CASE(test_free_null),
                         TEST_CASE(test_add_del_invalid), TEST_CASE(test_get_invalid),
-                        TEST_CASE(test_lookup), TEST_CASES_END()}};
+                        TEST_CASE(test_lookup), TEST_CASE(test_lookup_avx2),
+                        TEST_CASE(test_add_bulk), TEST_CASES_END()}};
 
 static struct unit_test_suite fib6_slow_tests = {
     .suite_name      = "fib6 slow autotest",
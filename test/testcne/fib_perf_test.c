@@ -10,6 +10,7 @@
 #include <getopt.h>
 
 #include <cne_cycles.h>
+#include <cne_system.h>
 #include <cne_branch_prediction.h>
 #include <net/cne_ip.h>
 #include <cne_fib.h>
@@ -40,6 +41,7 @@ struct route_rule {
 };
 
 static struct route_rule large_route_table[MAX_RULE_NUM];
+static struct cne_fib_route bulk_route_table[MAX_RULE_NUM];
 
 static uint32_t num_route_entries;
 #define NUM_ROUTE_ENTRIES num_route_entries
@@ -322,6 +324,137 @@ print_route_distribution(const struct route_rule *table, uint32_t n)
     cne_printf("\n");
 }
 
+static const struct {
+    enum cne_fib_lookup_type type;
+    const char *name;
+} lookup_types[] = {
+    {CNE_FIB_LOOKUP_DIR24_8_SCALAR_MACRO, "scalar"},
+    {CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2, "avx2"},
+    {CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512, "avx512"},
+    {CNE_FIB_LOOKUP_DEFAULT, "default"},
+};
+
+static void
+test_fib_bulk_lookup_perf(struct cne_fib *fib, const char *name)
+{
+    uint64_t begin, total_time = 0;
+    int64_t count = 0;
+    unsigned int i, j;
+
+    for (i = 0; i < ITERATIONS; i++) {
+        static uint32_t ip_batch[BATCH_SIZE];
+        uint64_t next_hops[BULK_SIZE];
+
+        /* Create array of random IP addresses */
+        for (j = 0; j < BATCH_SIZE; j++)
+            ip_batch[j] = rand();
+
+        /* Lookup per batch */
+        begin = cne_rdtsc();
+        for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
+            uint32_t k;
+            cne_fib_lookup_bulk(fib, &ip_batch[j], next_hops, BULK_SIZE);
+            for (k = 0; k < BULK_SIZE; k++)
+                if (unlikely(!(next_hops[k] != 0)))
+                    count++;
+        }
+
+        total_time += cne_rdtsc() - begin;
+    }
+    cne_printf("BULK FIB Lookup %-8s: %.1f cycles (fails = %.1f%%)\n", name,
+               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
+               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
+}
+
+static double
+cycles_to_ms(uint64_t cycles)
+{
+    return ((double)cycles * MS_PER_S) / (double)cne_get_timer_hz();
+}
+
+/* Check both FIBs return the same next hop for random addresses */
+static int
+test_fib_compare(struct cne_fib *fib1, struct cne_fib *fib2)
+{
+    static uint32_t ip_batch[BATCH_SIZE];
+    static uint64_t nh1[BATCH_SIZE], nh2[BATCH_SIZE];
+    unsigned int i, j;
+
+    for (i = 0; i < 16; i++) {
+        for (j = 0; j < BATCH_SIZE; j++)
+            ip_batch[j] = rand();
+
+        cne_fib_lookup_bulk(fib1, ip_batch, nh1, BATCH_SIZE);
+        cne_fib_lookup_bulk(fib2, ip_batch, nh2, BATCH_SIZE);
+        for (j = 0; j < BATCH_SIZE; j++)
+            TEST_FIB_ASSERT(nh1[j] == nh2[j]);
+    }
+    return 0;
+}
+
+/*
+ * Measure the table load time with the bulk API against the per route add of
+ * the same table in fib, e.g. the startup time of a full internet table.
+ */
+static int
+test_fib_bulk_perf(struct cne_fib *fib, struct cne_fib_conf *config, uint64_t add_time)
+{
+    struct cne_fib *bulk_fib;
+    uint64_t begin, total_time;
+    unsigned int i;
+
+    for (i = 0; i < NUM_ROUTE_ENTRIES; i++) {
+        bulk_route_table[i].ip       = large_route_table[i].ip;
+        bulk_route_table[i].depth    = large_route_table[i].depth;
+        bulk_route_table[i].next_hop = 0xAA;
+    }
+
+    bulk_fib = cne_fib_create("test_fib_bulk", config);
+    TEST_FIB_ASSERT(bulk_fib != NULL);
+
+    begin = cne_rdtsc();
+    if (cne_fib_add_bulk(bulk_fib, bulk_route_table, NUM_ROUTE_ENTRIES) != 0) {
+        cne_fib_free(bulk_fib);
+        TEST_FIB_ASSERT(0);
+    }
+    total_time = cne_rdtsc() - begin;
+
+    cne_printf("FIB startup per route add: %.1f ms\n", cycles_to_ms(add_time));
+    cne_printf("FIB startup bulk add     : %.1f ms (%g cycles per route)\n",
+               cycles_to_ms(total_time), (double)total_time / NUM_ROUTE_ENTRIES);
+
+    if (test_fib_compare(fib, bulk_fib) < 0) {
+        cne_fib_free(bulk_fib);
+        return -1;
+    }
+
+    /* Swap in a new table with every route on another next hop */
+    for (i = 0; i < NUM_ROUTE_ENTRIES; i++)
+        bulk_route_table[i].next_hop = 0xBB;
+
+    begin = cne_rdtsc();
+    if (cne_fib_replace(bulk_fib, bulk_route_table, NUM_ROUTE_ENTRIES) != 0) {
+        cne_fib_free(bulk_fib);
+        TEST_FIB_ASSERT(0);
+    }
+    total_time = cne_rdtsc() - begin;
+
+    cne_printf("FIB replace              : %.1f ms\n", cycles_to_ms(total_time));
+
+    begin = cne_rdtsc();
+    if (cne_fib_delete_bulk(bulk_fib, bulk_route_table, NUM_ROUTE_ENTRIES) != 0) {
+        cne_fib_free(bulk_fib);
+        TEST_FIB_ASSERT(0);
+    }
+    total_time = cne_rdtsc() - begin;
+
+    cne_printf("Average FIB Bulk Delete: %g cycles\n", (double)total_time / NUM_ROUTE_ENTRIES);
+
+    cne_fib_free(bulk_fib);
+
+    return 0;
+}
+
 static int
 test_fib_perf(void)
 {
@@ -334,10 +467,9 @@ test_fib_perf(void)
     config.dir24_8.nh_sz    = CNE_FIB_DIR24_8_4B;
     config.dir24_8.num_tbl8 = 65535;
     uint64_t begin, total_time;
-    unsigned int i, j;
+    unsigned int i;
     uint32_t next_hop_add = 0xAA;
     int status            = 0;
-    int64_t count         = 0;
 
     srand(cne_rdtsc());
 
@@ -367,32 +499,19 @@ test_fib_perf(void)
 
     cne_printf("Average FIB Add: %g cycles\n", (double)total_time / NUM_ROUTE_ENTRIES);
 
-    /* Measure bulk Lookup */
-    total_time = 0;
-    count      = 0;
-    for (i = 0; i < ITERATIONS; i++) {
-        static uint32_t ip_batch[BATCH_SIZE];
-        uint64_t next_hops[BULK_SIZE];
-
-        /* Create array of random IP addresses */
-        for (j = 0; j < BATCH_SIZE; j++)
-            ip_batch[j] = rand();
+    if (test_fib_bulk_perf(fib, &config, total_time) < 0) {
+        cne_fib_free(fib);
+        return -1;
+    }
 
-        /* Lookup per batch */
-        begin = cne_rdtsc();
-        for (j = 0; j < BATCH_SIZE; j += BULK_SIZE) {
-            uint32_t k;
-            cne_fib_lookup_bulk(fib, &ip_batch[j], next_hops, BULK_SIZE);
-            for (k = 0; k < BULK_SIZE; k++)
-                if (unlikely(!(next_hops[k] != 0)))
-                    count++;
+    /* Measure bulk Lookup for each lookup implementation */
+    for (i = 0; i < CNE_DIM(lookup_types); i++) {
+        if (cne_fib_select_lookup(fib, lookup_types[i].type) < 0) {
+            cne_printf("BULK FIB Lookup %-8s: not supported\n", lookup_types[i].name);
+            continue;
         }
-
-        total_time += cne_rdtsc() - begin;
+        test_fib_bulk_lookup_perf(fib, lookup_types[i].name);
     }
-    cne_printf("BULK FIB Lookup: %.1f cycles (fails = %.1f%%)\n",
-               (double)total_time / ((double)ITERATIONS * BATCH_SIZE),
-               (count * 100.0) / (double)(ITERATIONS * BATCH_SIZE));
 
     /* Delete */
     status = 0;
@@ -402,7 +521,7 @@ test_fib_perf(void)
         status += cne_fib_delete(fib, large_route_table[i].ip, large_route_table[i].depth);
     }
 
-    total_time += cne_rdtsc() - begin;
+    total_time = cne_rdtsc() - begin;
 
     cne_printf("Average FIB Delete: %g cycles\n", (double)total_time / NUM_ROUTE_ENTRIES);
 
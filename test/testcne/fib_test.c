@@ -5,12 +5,17 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <getopt.h>
+#include <string.h>
+#include <errno.h>
 
 #include <net/cne_ip.h>
 #include <cne_log.h>
 #include <cne_fib.h>
+#include <cne_fib_nhg.h>
+#include <cne_rib.h>
 #include <tst_info.h>
 
 #include "test.h"
@@ -24,6 +29,12 @@ static int32_t test_free_null(void);
 static int32_t test_add_del_invalid(void);
 static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
+static int32_t test_lookup_avx2(void);
+static int32_t test_nhg(void);
+static int32_t test_bulk_add(void);
+static int32_t test_bulk_delete(void);
+static int32_t test_bulk_nospc(void);
+static int32_t test_replace(void);
 
 #define MAX_ROUTES (1 << 16)
 #define MAX_TBL8   (1 << 15)
@@ -341,6 +352,506 @@ test_lookup(void)
     return TEST_SUCCESS;
 }
 
+/*
+ * Run the lookup checks with the AVX2 lookup function selected for every next
+ * hop size, the test is skipped when AVX2 is not available.
+ */
+int32_t
+test_lookup_avx2(void)
+{
+    static const enum cne_fib_dir24_8_nh_sz nh_sz[] = {CNE_FIB_DIR24_8_1B, CNE_FIB_DIR24_8_2B,
+                                                       CNE_FIB_DIR24_8_4B, CNE_FIB_DIR24_8_8B};
+    /* The number of tbl8 groups is bounded by the max next hop of each size */
+    static const uint32_t num_tbl8[] = {127, MAX_TBL8 - 1, MAX_TBL8, MAX_TBL8};
+    struct cne_fib *fib = NULL;
+    struct cne_fib_conf config;
+    int ret;
+
+    config.max_routes = MAX_ROUTES;
+    config.default_nh = 100;
+    config.type       = CNE_FIB_DIR24_8;
+
+    for (unsigned int i = 0; i < CNE_DIM(nh_sz); i++) {
+        config.dir24_8.nh_sz    = nh_sz[i];
+        config.dir24_8.num_tbl8 = num_tbl8[i];
+        fib                     = cne_fib_create(__func__, &config);
+        CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+        if (cne_fib_select_lookup(fib, CNE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2) < 0) {
+            cne_fib_free(fib);
+            return TEST_SKIPPED;
+        }
+
+        ret = check_fib(fib);
+        cne_fib_free(fib);
+        CNE_TEST_ASSERT(ret == TEST_SUCCESS, "Check_fib fails for AVX2 lookup, nh_sz %d\n",
+                        nh_sz[i]);
+    }
+
+    return TEST_SUCCESS;
+}
+
+#define BULK_NH_SZ      CNE_FIB_DIR24_8_2B
+#define BULK_NUM_TBL8   1024
+#define BULK_NOSPC_TBL8 64
+#define BULK_DEF_NH     100
+#define BULK_MAX_PROBE  2048
+
+/* Routes nested above and below /24, not sorted, 10.1.3.0/24 and 10.2.3.4/30 are given twice */
+// clang-format off
+static const struct cne_fib_route bulk_routes[] = {
+    {CNE_IPV4(10, 1, 2, 200),  32, 6},
+    {CNE_IPV4(10, 0, 0, 0),    8,  1},
+    {CNE_IPV4(10, 1, 3, 0),    24, 7},
+    {CNE_IPV4(10, 1, 2, 128),  25, 4},
+    {CNE_IPV4(10, 1, 0, 0),    16, 2},
+    {CNE_IPV4(10, 2, 3, 4),    30, 12},
+    {CNE_IPV4(10, 1, 2, 0),    24, 3},
+    {CNE_IPV4(10, 1, 4, 64),   27, 9},
+    {CNE_IPV4(10, 1, 2, 192),  26, 5},
+    {CNE_IPV4(10, 1, 3, 0),    24, 8},
+    {CNE_IPV4(10, 1, 0, 0),    20, 10},
+    {CNE_IPV4(10, 2, 0, 0),    15, 11},
+    {CNE_IPV4(10, 2, 3, 7),    30, 13},
+    {CNE_IPV4(0, 0, 0, 0),     0,  14},
+    {CNE_IPV4(10, 1, 255, 0),  24, 15},
+    {CNE_IPV4(10, 1, 255, 1),  32, 16},
+};
+
+/* An update of the routes, with new next hops, new routes and a route given three times */
+static const struct cne_fib_route bulk_update[] = {
+    {CNE_IPV4(10, 1, 2, 128),  25, 20},
+    {CNE_IPV4(10, 1, 2, 0),    23, 21},
+    {CNE_IPV4(10, 1, 2, 0),    24, 22},
+    {CNE_IPV4(10, 1, 2, 0),    24, 3},
+    {CNE_IPV4(10, 1, 2, 0),    24, 23},
+    {CNE_IPV4(10, 3, 0, 0),    16, 24},
+    {CNE_IPV4(10, 3, 0, 1),    32, 25},
+    {CNE_IPV4(10, 0, 0, 0),    8,  1},
+};
+
+/* Routes to delete, nested ones with a parent left in the FIB and routes not in the FIB */
+static const struct cne_fib_route bulk_delete[] = {
+    {CNE_IPV4(10, 1, 2, 192),  26, 0},
+    {CNE_IPV4(10, 1, 2, 0),    24, 0},
+    {CNE_IPV4(10, 1, 0, 0),    20, 0},
+    {CNE_IPV4(10, 9, 0, 0),    16, 0},
+    {CNE_IPV4(10, 1, 255, 1),  32, 0},
+    {CNE_IPV4(10, 1, 2, 200),  31, 0},
+    {CNE_IPV4(0, 0, 0, 0),     0,  0},
+    {CNE_IPV4(10, 1, 2, 0),    24, 0},
+};
+// clang-format on
+
+static uint32_t bulk_probes[BULK_MAX_PROBE];
+static uint64_t bulk_nh[BULK_MAX_PROBE], bulk_ref_nh[BULK_MAX_PROBE];
+
+static struct cne_fib *
+bulk_fib_create(const char *name, uint32_t num_tbl8)
+{
+    struct cne_fib_conf config;
+
+    memset(&config, 0, sizeof(config));
+    config.max_routes       = MAX_ROUTES;
+    config.default_nh       = BULK_DEF_NH;
+    config.type             = CNE_FIB_DIR24_8;
+    config.dir24_8.nh_sz    = BULK_NH_SZ;
+    config.dir24_8.num_tbl8 = num_tbl8;
+
+    return cne_fib_create(name, &config);
+}
+
+/* Apply the routes one by one with the single route API, the last entry of a prefix wins */
+static int
+bulk_ref_add(struct cne_fib *ref, const struct cne_fib_route *routes, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        if (cne_fib_add(ref, routes[i].ip, routes[i].depth, routes[i].next_hop) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int
+bulk_ref_delete(struct cne_fib *ref, const struct cne_fib_route *routes, uint32_t n)
+{
+    int ret;
+
+    for (uint32_t i = 0; i < n; i++) {
+        ret = cne_fib_delete(ref, routes[i].ip, routes[i].depth);
+        if (ret != 0 && ret != -ENOENT)
+            return -1;
+    }
+    return 0;
+}
+
+/* The first, last and middle address of each route and the addresses around it */
+static uint32_t
+bulk_probe_routes(uint32_t nb, const struct cne_fib_route *routes, uint32_t n)
+{
+    for (uint32_t i = 0; i < n && nb + 5 <= BULK_MAX_PROBE; i++) {
+        uint32_t first = routes[i].ip & cne_rib_depth_to_mask(routes[i].depth);
+        uint32_t last  = first + (uint32_t)((1ULL << (32 - routes[i].depth)) - 1);
+
+        bulk_probes[nb++] = first;
+        bulk_probes[nb++] = last;
+        bulk_probes[nb++] = first + (last - first) / 2;
+        bulk_probes[nb++] = first - 1;
+        bulk_probes[nb++] = last + 1;
+    }
+    return nb;
+}
+
+/* Probe the addresses of all the test routes and every address of 10.1.2.0/24 and 10.2.3.0/24 */
+static uint32_t
+bulk_probe(void)
+{
+    uint32_t nb = 0;
+
+    nb = bulk_probe_routes(nb, bulk_routes, CNE_DIM(bulk_routes));
+    nb = bulk_probe_routes(nb, bulk_update, CNE_DIM(bulk_update));
+    nb = bulk_probe_routes(nb, bulk_delete, CNE_DIM(bulk_delete));
+    for (uint32_t i = 0; i < 256; i++) {
+        bulk_probes[nb++] = CNE_IPV4(10, 1, 2, 0) + i;
+        bulk_probes[nb++] = CNE_IPV4(10, 2, 3, 0) + i;
+    }
+    return nb;
+}
+
+/* The FIB programmed in bulk gives the same next hops as the one programmed route by route */
+static int
+bulk_check_probes(struct cne_fib *fib, struct cne_fib *ref, uint32_t nb)
+{
+    CNE_TEST_ASSERT(cne_fib_lookup_bulk(fib, bulk_probes, bulk_nh, nb) == 0, "Failed to lookup\n");
+    CNE_TEST_ASSERT(cne_fib_lookup_bulk(ref, bulk_probes, bulk_ref_nh, nb) == 0,
+                    "Failed to lookup\n");
+
+    for (uint32_t i = 0; i < nb; i++)
+        CNE_TEST_ASSERT(bulk_nh[i] == bulk_ref_nh[i],
+                        "Address %08x: next hop %" PRIu64 ", single route API gives %" PRIu64 "\n",
+                        bulk_probes[i], bulk_nh[i], bulk_ref_nh[i]);
+
+    return TEST_SUCCESS;
+}
+
+static int
+bulk_check(struct cne_fib *fib, struct cne_fib *ref)
+{
+    return bulk_check_probes(fib, ref, bulk_probe());
+}
+
+static uint64_t
+bulk_lookup(struct cne_fib *fib, uint32_t ip)
+{
+    uint64_t nh = 0;
+
+    cne_fib_lookup_bulk(fib, &ip, &nh, 1);
+    return nh;
+}
+
+/*
+ * Add nested routes above and below /24 in bulk, twice to a FIB already holding
+ * routes, and check the lookups against the single route API.
+ */
+int32_t
+test_bulk_add(void)
+{
+    struct cne_fib_route bad[] = {{CNE_IPV4(10, 4, 0, 0), 16, 1}, {CNE_IPV4(10, 5, 0, 0), 33, 1}};
+    struct cne_fib *fib, *ref;
+    int ret;
+
+    fib = bulk_fib_create("bulk_add", BULK_NUM_TBL8);
+    CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+    ref = bulk_fib_create("bulk_add_ref", BULK_NUM_TBL8);
+    CNE_TEST_ASSERT(ref != NULL, "Failed to create FIB\n");
+
+    ret = cne_fib_add_bulk(fib, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add routes in bulk\n");
+    ret = bulk_ref_add(ref, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Bulk add lookups differ\n");
+
+    /* The last entry of a prefix given more than once wins */
+    CNE_TEST_ASSERT(bulk_lookup(fib, CNE_IPV4(10, 1, 3, 1)) == 8 &&
+                        bulk_lookup(fib, CNE_IPV4(10, 2, 3, 4)) == 13,
+                    "Last entry of a duplicated prefix did not win\n");
+
+    ret = cne_fib_add_bulk(fib, bulk_update, CNE_DIM(bulk_update));
+    CNE_TEST_ASSERT(ret == 0, "Failed to update routes in bulk\n");
+    ret = bulk_ref_add(ref, bulk_update, CNE_DIM(bulk_update));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Bulk update lookups differ\n");
+    CNE_TEST_ASSERT(bulk_lookup(fib, CNE_IPV4(10, 1, 2, 1)) == 23,
+                    "Last entry of a prefix given three times did not win\n");
+
+    /* An empty set changes nothing and a bad route is refused before any change */
+    ret = cne_fib_add_bulk(fib, NULL, 0);
+    CNE_TEST_ASSERT(ret == 0, "Failed to add an empty set of routes\n");
+    ret = cne_fib_add_bulk(fib, bad, CNE_DIM(bad));
+    CNE_TEST_ASSERT(ret == -EINVAL, "Call succeeded with invalid parameters\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Invalid bulk add changed the FIB\n");
+
+    cne_fib_free(fib);
+    cne_fib_free(ref);
+
+    return TEST_SUCCESS;
+}
+
+/*
+ * Delete nested routes in bulk, the covering routes left in the FIB take over their
+ * range, routes not in the FIB are ignored.
+ */
+int32_t
+test_bulk_delete(void)
+{
+    struct cne_fib *fib, *ref;
+    uint32_t nb;
+    int ret;
+
+    fib = bulk_fib_create("bulk_del", BULK_NUM_TBL8);
+    CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+    ref = bulk_fib_create("bulk_del_ref", BULK_NUM_TBL8);
+    CNE_TEST_ASSERT(ref != NULL, "Failed to create FIB\n");
+
+    ret = cne_fib_add_bulk(fib, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add routes in bulk\n");
+    ret = bulk_ref_add(ref, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+
+    ret = cne_fib_delete_bulk(fib, bulk_delete, CNE_DIM(bulk_delete));
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete routes in bulk\n");
+    ret = bulk_ref_delete(ref, bulk_delete, CNE_DIM(bulk_delete));
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Bulk delete lookups differ\n");
+    CNE_TEST_ASSERT(bulk_lookup(fib, CNE_IPV4(10, 1, 2, 1)) == 2,
+                    "Covering route did not take over a deleted range\n");
+
+    /* Deleting all the routes leaves the default next hop everywhere */
+    ret = cne_fib_delete_bulk(fib, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete routes in bulk\n");
+    ret = bulk_ref_delete(ref, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Bulk delete lookups differ\n");
+
+    nb = bulk_probe();
+    for (uint32_t i = 0; i < nb; i++)
+        CNE_TEST_ASSERT(bulk_nh[i] == BULK_DEF_NH, "Address %08x still routed\n", bulk_probes[i]);
+
+    cne_fib_free(fib);
+    cne_fib_free(ref);
+
+    return TEST_SUCCESS;
+}
+
+/*
+ * Without a free tbl8 group the routes sorted before the first route needing one
+ * are applied and the following ones are not, the same as adding them one by one.
+ * The routes below /24 of 10.0.1.0 to 10.0.64.0 use the 64 tbl8 groups, the
+ * smallest number dir24_8 allocates, and 10.0.65.0/25 needs one more.
+ */
+int32_t
+test_bulk_nospc(void)
+{
+    struct cne_fib_route routes[BULK_NOSPC_TBL8 + 4];
+    struct cne_fib_route left[2];
+    struct cne_fib *fib, *ref;
+    struct cne_rib *rib;
+    uint32_t n = 0, nb;
+    int ret;
+
+    routes[n++] = (struct cne_fib_route){CNE_IPV4(10, 1, 0, 0), 16, 6};
+    routes[n++] = (struct cne_fib_route){CNE_IPV4(10, 0, 0, 0), 16, 1};
+    routes[n++] = (struct cne_fib_route){CNE_IPV4(10, 0, 5, 128), 25, 4};
+    for (uint32_t i = BULK_NOSPC_TBL8 + 1; i > 0; i--)
+        routes[n++] = (struct cne_fib_route){CNE_IPV4(10, 0, i, 0), 25, 10 + i};
+    left[0] = routes[0];
+    left[1] = routes[3];
+
+    fib = bulk_fib_create("bulk_nospc", BULK_NOSPC_TBL8);
+    CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+    ref = bulk_fib_create("bulk_nospc_ref", BULK_NOSPC_TBL8);
+    CNE_TEST_ASSERT(ref != NULL, "Failed to create FIB\n");
+
+    ret = cne_fib_add_bulk(fib, routes, n);
+    CNE_TEST_ASSERT(ret == -ENOSPC, "Bulk add without tbl8 groups returned %d\n", ret);
+
+    /* The reference gets the routes sorted before 10.0.65.0/25 */
+    ret = bulk_ref_add(ref, &routes[1], 2);
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    ret = bulk_ref_add(ref, &routes[4], n - 4);
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    ret = cne_fib_add(ref, left[1].ip, left[1].depth, left[1].next_hop);
+    CNE_TEST_ASSERT(ret == -ENOSPC, "Add without tbl8 groups returned %d\n", ret);
+
+    nb = bulk_probe_routes(bulk_probe(), routes, n);
+    CNE_TEST_ASSERT(bulk_check_probes(fib, ref, nb) == TEST_SUCCESS,
+                    "Partial bulk add lookups differ\n");
+
+    rib = cne_fib_get_rib(fib);
+    for (uint32_t i = 0; i < CNE_DIM(left); i++)
+        CNE_TEST_ASSERT(cne_rib_lookup_exact(rib, left[i].ip, left[i].depth) == NULL,
+                        "Route %08x/%u after the failure was added\n", left[i].ip, left[i].depth);
+    CNE_TEST_ASSERT(bulk_lookup(fib, CNE_IPV4(10, 0, 65, 1)) == 1 &&
+                        bulk_lookup(fib, CNE_IPV4(10, 1, 0, 1)) == BULK_DEF_NH,
+                    "Routes after the failure are used\n");
+
+    /* Deleting a route below /24 frees its tbl8 group for the routes not applied */
+    ret = cne_fib_delete_bulk(fib, &routes[n - 1], 1);
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete routes in bulk\n");
+    ret = cne_fib_add_bulk(fib, left, CNE_DIM(left));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add routes with a released tbl8 group\n");
+    ret = bulk_ref_delete(ref, &routes[n - 1], 1);
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+    ret = bulk_ref_add(ref, left, CNE_DIM(left));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    CNE_TEST_ASSERT(bulk_check_probes(fib, ref, nb) == TEST_SUCCESS, "Bulk add lookups differ\n");
+
+    cne_fib_free(fib);
+    cne_fib_free(ref);
+
+    return TEST_SUCCESS;
+}
+
+/* Replacing the routes gives the lookups of a FIB built from the new routes only */
+int32_t
+test_replace(void)
+{
+    struct cne_fib *fib, *ref, *dummy;
+    struct cne_fib_conf config;
+    struct cne_rib *rib;
+    int ret;
+
+    memset(&config, 0, sizeof(config));
+    config.max_routes = MAX_ROUTES;
+    config.default_nh = BULK_DEF_NH;
+    config.type       = CNE_FIB_DUMMY;
+
+    dummy = cne_fib_create("replace_dummy", &config);
+    CNE_TEST_ASSERT(dummy != NULL, "Failed to create FIB\n");
+    ret = cne_fib_replace(dummy, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == -EINVAL, "Replace succeeded on a DUMMY FIB\n");
+    cne_fib_free(dummy);
+
+    fib = bulk_fib_create("replace", BULK_NUM_TBL8);
+    CNE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+    ref = bulk_fib_create("replace_ref", BULK_NUM_TBL8);
+    CNE_TEST_ASSERT(ref != NULL, "Failed to create FIB\n");
+
+    ret = cne_fib_add_bulk(fib, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add routes in bulk\n");
+    ret = cne_fib_replace(fib, bulk_update, CNE_DIM(bulk_update));
+    CNE_TEST_ASSERT(ret == 0, "Failed to replace the routes\n");
+    ret = bulk_ref_add(ref, bulk_update, CNE_DIM(bulk_update));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Replace lookups differ\n");
+
+    /* The RIB holds the new routes only */
+    rib = cne_fib_get_rib(fib);
+    CNE_TEST_ASSERT(cne_rib_lookup_exact(rib, CNE_IPV4(10, 1, 3, 0), 24) == NULL,
+                    "Replaced route still in the RIB\n");
+    CNE_TEST_ASSERT(cne_rib_lookup_exact(rib, CNE_IPV4(10, 3, 0, 0), 16) != NULL,
+                    "New route not in the RIB\n");
+
+    /* The FIB can still be updated after a replace */
+    ret = cne_fib_add_bulk(fib, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add routes in bulk\n");
+    ret = bulk_ref_add(ref, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to add a route\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Bulk add after replace differs\n");
+
+    /* An empty set of routes clears the FIB */
+    ret = cne_fib_replace(fib, NULL, 0);
+    CNE_TEST_ASSERT(ret == 0, "Failed to replace the routes\n");
+    ret = bulk_ref_delete(ref, bulk_routes, CNE_DIM(bulk_routes));
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+    ret = bulk_ref_delete(ref, bulk_update, CNE_DIM(bulk_update));
+    CNE_TEST_ASSERT(ret == 0, "Failed to delete a route\n");
+    CNE_TEST_ASSERT(bulk_check(fib, ref) == TEST_SUCCESS, "Empty replace lookups differ\n");
+    CNE_TEST_ASSERT(bulk_lookup(fib, CNE_IPV4(10, 1, 2, 1)) == BULK_DEF_NH,
+                    "Empty replace left a route\n");
+
+    cne_fib_free(fib);
+    cne_fib_free(ref);
+
+    return TEST_SUCCESS;
+}
+
+#define NHG_BUCKETS 256
+
+/* Count the flows selecting each of the next hops 1 to 3, flow h has hash (h << shift) | low */
+static void
+nhg_count_shift(struct cne_fib_nhg *nhg, uint64_t *sel, uint32_t cnt[4], uint32_t shift,
+                uint32_t low)
+{
+    memset(cnt, 0, 4 * sizeof(uint32_t));
+    for (uint32_t h = 0; h < NHG_BUCKETS; h++) {
+        sel[h] = cne_fib_nhg_select(nhg, (h << shift) | low);
+        if (sel[h] < 4)
+            cnt[sel[h]]++;
+    }
+}
+
+static void
+nhg_count(struct cne_fib_nhg *nhg, uint64_t *sel, uint32_t cnt[4])
+{
+    nhg_count_shift(nhg, sel, cnt, 0, 0);
+}
+
+/*
+ * Check the buckets follow the member weights, a member going down only moves
+ * its own flows and the default next hop is used when no member is up.
+ */
+int32_t
+test_nhg(void)
+{
+    uint64_t before[NHG_BUCKETS], after[NHG_BUCKETS];
+    struct cne_fib_nhg *nhg;
+    uint32_t cnt[4];
+
+    CNE_TEST_ASSERT(cne_fib_nhg_create("nhg", 100, 0) == NULL, "Created group with 100 buckets\n");
+
+    nhg = cne_fib_nhg_create("nhg", NHG_BUCKETS, 0);
+    CNE_TEST_ASSERT(nhg != NULL, "Failed to create nexthop group\n");
+    CNE_TEST_ASSERT(cne_fib_nhg_select(nhg, 1) == 0, "Empty group did not return default\n");
+    CNE_TEST_ASSERT(cne_fib_nhg_member_add(nhg, 1, 0) < 0, "Added member with weight 0\n");
+    CNE_TEST_ASSERT(cne_fib_nhg_member_del(nhg, 1) == -ENOENT, "Deleted unknown member\n");
+
+    CNE_TEST_ASSERT(cne_fib_nhg_member_add(nhg, 1, 1) == 0, "Failed to add member 1\n");
+    CNE_TEST_ASSERT(cne_fib_nhg_member_add(nhg, 2, 1) == 0, "Failed to add member 2\n");
+    CNE_TEST_ASSERT(cne_fib_nhg_member_add(nhg, 3, 2) == 0, "Failed to add member 3\n");
+
+    nhg_count(nhg, before, cnt);
+    CNE_TEST_ASSERT(cnt[1] == 64 && cnt[2] == 64 && cnt[3] == 128,
+                    "Buckets do not follow the weights %u/%u/%u\n", cnt[1], cnt[2], cnt[3]);
+
+    /* The flows of one RX queue share the low bits of the hash and use all the members */
+    nhg_count_shift(nhg, after, cnt, 8, 5);
+    CNE_TEST_ASSERT(cnt[1] == 64 && cnt[2] == 64 && cnt[3] == 128,
+                    "Hash low bits polarize the buckets %u/%u/%u\n", cnt[1], cnt[2], cnt[3]);
+
+    CNE_TEST_ASSERT(cne_fib_nhg_member_set_state(nhg, 2, false) == 0, "Failed to set state\n");
+    nhg_count(nhg, after, cnt);
+    CNE_TEST_ASSERT(cnt[2] == 0 && (cnt[1] + cnt[3]) == NHG_BUCKETS,
+                    "Member down still selected\n");
+    for (uint32_t h = 0; h < NHG_BUCKETS; h++)
+        CNE_TEST_ASSERT(before[h] == 2 || before[h] == after[h], "Flow %u moved\n", h);
+
+    CNE_TEST_ASSERT(cne_fib_nhg_member_set_state(nhg, 2, true) == 0, "Failed to set state\n");
+    nhg_count(nhg, after, cnt);
+    CNE_TEST_ASSERT(cnt[1] == 64 && cnt[2] == 64 && cnt[3] == 128,
+                    "Buckets not rebalanced %u/%u/%u\n", cnt[1], cnt[2], cnt[3]);
+
+    CNE_TEST_ASSERT(cne_fib_nhg_member_del(nhg, 1) == 0, "Failed to delete member 1\n");
+    CNE_TEST_ASSERT(cne_fib_nhg_member_set_state(nhg, 2, false) == 0, "Failed to set state\n");
+    CNE_TEST_ASSERT(cne_fib_nhg_member_set_state(nhg, 3, false) == 0, "Failed to set state\n");
+    nhg_count(nhg, after, cnt);
+    CNE_TEST_ASSERT(cnt[0] == NHG_BUCKETS, "All members down did not return default\n");
+
+    cne_fib_nhg_free(nhg);
+
+    return TEST_SUCCESS;
+}
+
 // clang-format off
 static struct unit_test_suite fib_fast_tests = {
     .suite_name      = "fib autotest",
@@ -352,6 +863,12 @@ static struct unit_test_suite fib_fast_tests = {
         TEST_CASE(test_add_del_invalid),
 		TEST_CASE(test_get_invalid),
         TEST_CASE(test_lookup),
+        TEST_CASE(test_lookup_avx2),
+        TEST_CASE(test_nhg),
+        TEST_CASE(test_bulk_add),
+        TEST_CASE(test_bulk_delete),
+        TEST_CASE(test_bulk_nospc),
+        TEST_CASE(test_replace),
 		TEST_CASES_END()
 	}
 };
@@ -1,7 +1,7 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright (c) 2020 Marvell International Ltd.
  */
-#include <inttypes.h>                // for PRId64
+#include <inttypes.h>                // for PRId64, PRIu64
 #include <stdio.h>                   // for printf, NULL, EOF, stdout
 #include <string.h>                  // for strcmp, strncmp, memset
 #include <getopt.h>                  // for getopt_long, option
@@ -14,6 +14,7 @@
 #include <stdbool.h>                 // for bool
 #include <stdint.h>                  // for uint32_t, uint64_t, uint16_t, uint8_t
 #include <stdlib.h>                  // for free, rand, malloc
+#include <unistd.h>                  // for unlink
 
 #include "graph_test.h"
 #include "cne_common.h"        // for CNE_SET_USED, CNE_PRIORITY_LAST, SOCKE...
@@ -727,6 +728,279 @@ test_print_stats(void)
     return 0;
 }
 
+static const struct cne_graph_cluster_node_stats *
+stats_node_find(struct cne_graph_cluster_stats *stats, const char *name)
+{
+    const struct cne_graph_cluster_node_stats *st;
+
+    for (int i = 0; i < cne_graph_stats_node_count(stats); i++) {
+        st = cne_graph_stats_node_get(stats, i);
+        if (!strcmp(st->name, name))
+            return st;
+    }
+    return NULL;
+}
+
+static int
+test_stats_sample(void)
+{
+    struct cne_graph_cluster_stats_param s_param = {0};
+    const struct cne_graph_cluster_node_stats *st;
+    struct cne_graph *graph = cne_graph_lookup("worker0");
+    struct cne_graph_cluster_stats *stats;
+    const char *pattern = "worker0";
+    uint64_t calls, sampled, hist = 0;
+    int i, ret = -1;
+
+    s_param.graph_patterns    = &pattern;
+    s_param.nb_graph_patterns = 1;
+
+    stats = cne_graph_cluster_stats_create(&s_param);
+    if (!stats || !graph) {
+        tst_error("Unable to get stats");
+        goto out;
+    }
+    cne_graph_cluster_stats_get(stats, true);
+    st = stats_node_find(stats, "test_node_source1");
+    if (!st) {
+        tst_error("Source node stats not found");
+        goto out;
+    }
+    calls   = st->calls;
+    sampled = st->sampled_calls;
+
+    if (cne_graph_stats_sample_set(graph_id, 3) != -EINVAL) {
+        tst_error("Sampling period 3 accepted");
+        goto out;
+    }
+
+    /* Walk two sampling periods, the source node is called once per walk */
+    if (cne_graph_stats_sample_set(graph_id, 4) < 0) {
+        tst_error("Unable to set the sampling period");
+        goto out;
+    }
+    for (i = 0; i < 8; i++)
+        cne_graph_walk(graph);
+    cne_graph_stats_sample_set(graph_id, CNE_GRAPH_STATS_SAMPLE_PERIOD);
+
+    cne_graph_cluster_stats_get(stats, true);
+    if (st->calls - calls != 8 || st->sampled_calls - sampled != 2) {
+        tst_error("Sampled calls miss match, calls = %" PRIu64 " sampled = %" PRIu64,
+                  st->calls - calls, st->sampled_calls - sampled);
+        goto out;
+    }
+
+    for (i = 0; i < CNE_GRAPH_STATS_CPO_BUCKETS; i++)
+        hist += st->cpo_hist[i];
+    if (hist != st->sampled_calls || cne_graph_stats_cpo_percentile(st, 99) == 0) {
+        tst_error("Cycles per object histogram miss match");
+        goto out;
+    }
+    hist = 0;
+    for (i = 0; i < CNE_GRAPH_STATS_BURST_BUCKETS; i++)
+        hist += st->burst_hist[i];
+    if (hist != st->sampled_calls || st->burst_hist[CNE_GRAPH_BURST_SIZE_LOG2 + 1] != hist) {
+        tst_error("Burst size histogram miss match");
+        goto out;
+    }
+    ret = 0;
+out:
+    cne_graph_cluster_stats_destroy(stats);
+    return ret;
+}
+
+static bool
+trace_filter(void *obj, void *arg)
+{
+    return obj == arg;
+}
+
+static const void *
+trace_data(void *obj, uint32_t *len, void *arg)
+{
+    CNE_SET_USED(arg);
+
+    *len = sizeof(pktmbuf_t);
+    return obj;
+}
+
+static int
+test_graph_trace(void)
+{
+    struct cne_graph_trace_param prm = {0};
+    struct cne_graph *graph          = cne_graph_lookup("worker0");
+    const char *file                 = "/tmp/graph_trace_test.pcapng";
+    struct cne_graph_trace_rec recs[8];
+    const char *next;
+    int n, ret = -1;
+
+    /* Trace the first object of the source node */
+    prm.filter = trace_filter;
+    prm.data   = trace_data;
+    prm.arg    = &mbuf[0][0];
+    prm.sample = 1;
+
+    prm.nb_recs = 100;
+    if (cne_graph_trace_enable(graph_id, &prm) != -EINVAL) {
+        tst_error("Trace ring of 100 hops accepted");
+        return -1;
+    }
+    prm.nb_recs = 0;
+    if (!graph || cne_graph_trace_enable(graph_id, &prm) < 0) {
+        tst_error("Unable to enable the trace");
+        return -1;
+    }
+
+    cne_graph_walk(graph);
+
+    n = cne_graph_trace_get(graph_id, recs, CNE_DIM(recs));
+    if (n != 2 || recs[0].pkt != 1 || recs[1].pkt != 1) {
+        tst_error("Trace hops miss match, expected = 2 got = %d", n);
+        goto out;
+    }
+    if (recs[0].node != cne_node_from_name("test_node_source1") ||
+        recs[0].edge != CNE_EDGE_ID_INVALID || recs[1].edge > 1) {
+        tst_error("Trace source hop miss match");
+        goto out;
+    }
+    next = recs[1].edge == 0 ? "test_node00" : "test_node00-test_node11";
+    if (recs[1].node != cne_node_from_name(next) || recs[1].tsc < recs[0].tsc) {
+        tst_error("Trace hop miss match, expected node %s", next);
+        goto out;
+    }
+
+    /* Disabled trace records no more hops but is kept */
+    cne_graph_trace_disable(graph_id);
+    cne_graph_walk(graph);
+    if (cne_graph_trace_get(graph_id, recs, CNE_DIM(recs)) != 2) {
+        tst_error("Disabled trace recorded hops");
+        goto out;
+    }
+    if (cne_graph_trace_pcapng_save(graph_id, file) != 1) {
+        tst_error("Unable to save the trace in %s", file);
+        goto out;
+    }
+    unlink(file);
+
+    cne_graph_trace_dump(stdout, graph_id);
+
+    /* A restart traces in a new ring of the new size */
+    prm.nb_recs = 16;
+    if (cne_graph_trace_enable(graph_id, &prm) < 0 ||
+        cne_graph_trace_get(graph_id, recs, CNE_DIM(recs)) != 0) {
+        tst_error("Restarted trace kept the old hops");
+        goto out;
+    }
+    cne_graph_walk(graph);
+    if (cne_graph_trace_get(graph_id, recs, CNE_DIM(recs)) != 2) {
+        tst_error("Restarted trace did not record hops");
+        goto out;
+    }
+
+    ret = 0;
+out:
+    cne_graph_trace_disable(graph_id);
+    return ret;
+}
+
+static uint64_t dispatch_objs[2];
+
+static uint16_t
+test_dispatch_source(struct cne_graph *graph, struct cne_node *node, void **objs,
+                     uint16_t nb_objs)
+{
+    CNE_SET_USED(objs);
+    CNE_SET_USED(nb_objs);
+
+    /* Only the graph of worker 0 produces objects */
+    if (graph->worker != 0)
+        return 0;
+
+    cne_node_enqueue(graph, node, 0, mbuf_p[MAX_NODES], CNE_GRAPH_BURST_SIZE);
+    return CNE_GRAPH_BURST_SIZE;
+}
+
+static uint16_t
+test_dispatch_sink(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(node);
+    CNE_SET_USED(objs);
+
+    dispatch_objs[graph->worker] += nb_objs;
+    return nb_objs;
+}
+
+static struct cne_node_register test_dispatch_source_node = {
+    .name       = "test_dispatch_source",
+    .process    = test_dispatch_source,
+    .flags      = CNE_NODE_SOURCE_F,
+    .nb_edges   = 1,
+    .next_nodes = {"test_dispatch_sink"},
+};
+CNE_NODE_REGISTER(test_dispatch_source_node);
+
+static struct cne_node_register test_dispatch_sink_node = {
+    .name    = "test_dispatch_sink",
+    .process = test_dispatch_sink,
+};
+CNE_NODE_REGISTER(test_dispatch_sink_node);
+
+static int
+test_graph_dispatch(void)
+{
+    static const char *patterns[] = {"test_dispatch_source", "test_dispatch_sink", NULL};
+    cne_graph_t id[2];
+    struct cne_graph *graph[2];
+    int i, ret = -1;
+
+    id[0] = cne_graph_create("dispatch0", patterns);
+    id[1] = cne_graph_create("dispatch1", patterns);
+    if (id[0] == CNE_GRAPH_ID_INVALID || id[1] == CNE_GRAPH_ID_INVALID) {
+        tst_error("Dispatch graph creation failed with error = %d", errno);
+        goto out;
+    }
+    graph[0] = cne_graph_lookup("dispatch0");
+    graph[1] = cne_graph_lookup("dispatch1");
+
+    if (cne_graph_dispatch_node_affinity_set("test_dispatch_sink", 1) < 0 ||
+        cne_graph_dispatch_bind(id[0], 0) < 0 || cne_graph_dispatch_bind(id[1], 1) < 0) {
+        tst_error("Unable to setup the dispatch workers");
+        goto out;
+    }
+    if (cne_graph_dispatch_bind(id[1], 0) != -EEXIST) {
+        tst_error("Bound two graphs to the same worker");
+        goto out;
+    }
+
+    /* The sink objects of worker 0 are processed by the walks of worker 1 */
+    for (i = 0; i < 4; i++) {
+        cne_graph_walk(graph[0]);
+        cne_graph_walk(graph[1]);
+    }
+    if (dispatch_objs[0] != 0 || dispatch_objs[1] != 4 * CNE_GRAPH_BURST_SIZE) {
+        tst_error("Dispatch objects miss match, worker 0 = %" PRIu64 " worker 1 = %" PRIu64,
+                  dispatch_objs[0], dispatch_objs[1]);
+        goto out;
+    }
+
+    /* Without a worker 1 the sink runs on worker 0 again */
+    if (cne_graph_dispatch_unbind(id[1]) < 0) {
+        tst_error("Unable to unbind the dispatch graph");
+        goto out;
+    }
+    cne_graph_walk(graph[0]);
+    if (dispatch_objs[0] != CNE_GRAPH_BURST_SIZE) {
+        tst_error("Sink objects not processed on worker 0 after unbind");
+        goto out;
+    }
+    ret = 0;
+out:
+    cne_graph_dispatch_node_affinity_set("test_dispatch_sink", CNE_GRAPH_DISPATCH_ANY);
+    cne_graph_destroy(cne_graph_from_name("dispatch1"));
+    cne_graph_destroy(cne_graph_from_name("dispatch0"));
+    return ret;
+}
+
 static int
 graph_setup(void)
 {
@@ -755,6 +1029,392 @@ graph_teardown(void)
         tst_error("Graph Destroy failed");
 }
 
+static struct cne_graph_feature_arc *feature_arc;
+static uint64_t feature_objs[3];
+
+static uint16_t
+test_feature_source(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    bool enabled = cne_graph_feature_arc_enabled(feature_arc);
+    pktmbuf_t *m;
+
+    CNE_SET_USED(objs);
+    CNE_SET_USED(nb_objs);
+
+    /* Objects alternate between interface 0 and 1 */
+    for (int i = 0; i < CNE_GRAPH_BURST_SIZE; i++) {
+        m               = &mbuf[MAX_NODES][i];
+        pktmbuf_port(m) = i & 1;
+        cne_node_enqueue_x1(graph, node,
+                            enabled ? cne_graph_feature_next(feature_arc, CNE_GRAPH_FEATURE_START,
+                                                             pktmbuf_port(m))
+                                    : 0,
+                            m);
+    }
+    return CNE_GRAPH_BURST_SIZE;
+}
+
+static uint16_t
+test_feature_node(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    int f = cne_graph_feature_lookup(feature_arc, node->name);
+    pktmbuf_t *m;
+
+    feature_objs[f] += nb_objs;
+    for (int i = 0; i < nb_objs; i++) {
+        m = objs[i];
+        cne_node_enqueue_x1(graph, node, cne_graph_feature_next(feature_arc, f, pktmbuf_port(m)),
+                            m);
+    }
+    return nb_objs;
+}
+
+static uint16_t
+test_feature_sink(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(graph);
+    CNE_SET_USED(node);
+    CNE_SET_USED(objs);
+
+    feature_objs[2] += nb_objs;
+    return nb_objs;
+}
+
+static struct cne_node_register test_feature_source_node = {
+    .name       = "test_feature_source",
+    .process    = test_feature_source,
+    .flags      = CNE_NODE_SOURCE_F,
+    .nb_edges   = 1,
+    .next_nodes = {"test_feature_sink"},
+};
+CNE_NODE_REGISTER(test_feature_source_node);
+
+static struct cne_node_register test_feature_a_node = {
+    .name    = "test_feature_a",
+    .process = test_feature_node,
+};
+CNE_NODE_REGISTER(test_feature_a_node);
+
+static struct cne_node_register test_feature_b_node = {
+    .name    = "test_feature_b",
+    .process = test_feature_node,
+};
+CNE_NODE_REGISTER(test_feature_b_node);
+
+static struct cne_node_register test_feature_sink_node = {
+    .name    = "test_feature_sink",
+    .process = test_feature_sink,
+};
+CNE_NODE_REGISTER(test_feature_sink_node);
+
+static int
+test_graph_feature(void)
+{
+    static const char *patterns[] = {"test_feature_*", NULL};
+    struct cne_graph *graph;
+    cne_graph_t id = CNE_GRAPH_ID_INVALID;
+    int ret        = -1;
+
+    feature_arc =
+        cne_graph_feature_arc_create("test_arc", "test_feature_source", "test_feature_sink", 2);
+    if (!feature_arc || cne_graph_feature_arc_lookup("test_arc") != feature_arc) {
+        tst_error("Feature arc creation failed with error = %d", errno);
+        return -1;
+    }
+    if (cne_graph_feature_add(feature_arc, "test_feature_a") != 0 ||
+        cne_graph_feature_add(feature_arc, "test_feature_b") != 1) {
+        tst_error("Unable to add the features");
+        goto out;
+    }
+
+    id    = cne_graph_create("feature", patterns);
+    graph = cne_graph_lookup("feature");
+    if (!graph) {
+        tst_error("Feature graph creation failed with error = %d", errno);
+        goto out;
+    }
+
+    /* Feature a on interface 1, feature b on both interfaces */
+    if (cne_graph_feature_enable(feature_arc, "test_feature_a", 1) < 0 ||
+        cne_graph_feature_enable(feature_arc, "test_feature_b", 0) < 0 ||
+        cne_graph_feature_enable(feature_arc, "test_feature_b", 1) < 0 ||
+        cne_graph_feature_enable(feature_arc, "test_feature_b", 2) != -EINVAL) {
+        tst_error("Unable to enable the features");
+        goto out;
+    }
+    cne_graph_walk(graph);
+    if (feature_objs[0] != CNE_GRAPH_BURST_SIZE / 2 || feature_objs[1] != CNE_GRAPH_BURST_SIZE ||
+        feature_objs[2] != CNE_GRAPH_BURST_SIZE) {
+        tst_error("Feature objects miss match, a = %" PRIu64 " b = %" PRIu64 " sink = %" PRIu64,
+                  feature_objs[0], feature_objs[1], feature_objs[2]);
+        goto out;
+    }
+
+    /* Disabled features are skipped without changing the graph */
+    cne_graph_feature_disable(feature_arc, "test_feature_a", 1);
+    cne_graph_feature_disable(feature_arc, "test_feature_b", 0);
+    cne_graph_feature_disable(feature_arc, "test_feature_b", 1);
+    if (cne_graph_feature_arc_enabled(feature_arc)) {
+        tst_error("Feature arc still enabled");
+        goto out;
+    }
+    cne_graph_walk(graph);
+    if (feature_objs[0] != CNE_GRAPH_BURST_SIZE / 2 || feature_objs[1] != CNE_GRAPH_BURST_SIZE ||
+        feature_objs[2] != 2 * CNE_GRAPH_BURST_SIZE) {
+        tst_error("Disabled features processed objects");
+        goto out;
+    }
+    cne_graph_feature_arc_dump(stdout, feature_arc);
+
+    ret = 0;
+out:
+    cne_graph_destroy(id);
+    cne_graph_feature_arc_destroy(feature_arc);
+    return ret;
+}
+
+static uint64_t reconf_objs[2];
+static int reconf_inits;
+
+static uint16_t
+test_reconf_source(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    uint64_t *walks = (uint64_t *)node->ctx;
+
+    CNE_SET_USED(objs);
+    CNE_SET_USED(nb_objs);
+
+    /* The objects go to the last edge, the one added by the reconfiguration */
+    (*walks)++;
+    cne_node_enqueue(graph, node, node->nb_edges - 1, mbuf_p[MAX_NODES], CNE_GRAPH_BURST_SIZE);
+    return CNE_GRAPH_BURST_SIZE;
+}
+
+static uint16_t
+test_reconf_node(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    reconf_objs[0] += nb_objs;
+    cne_node_next_stream_move(graph, node, 0);
+    return nb_objs;
+}
+
+static int
+test_reconf_node_init(const struct cne_graph *graph, struct cne_node *node)
+{
+    CNE_SET_USED(graph);
+    CNE_SET_USED(node);
+
+    reconf_inits++;
+    return 0;
+}
+
+static uint16_t
+test_reconf_sink(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(graph);
+    CNE_SET_USED(node);
+    CNE_SET_USED(objs);
+
+    reconf_objs[1] += nb_objs;
+    return nb_objs;
+}
+
+static struct cne_node_register test_reconf_source_node = {
+    .name       = "test_reconf_source",
+    .process    = test_reconf_source,
+    .flags      = CNE_NODE_SOURCE_F,
+    .nb_edges   = 1,
+    .next_nodes = {"test_reconf_sink"},
+};
+CNE_NODE_REGISTER(test_reconf_source_node);
+
+static struct cne_node_register test_reconf_node_node = {
+    .name       = "test_reconf_node",
+    .process    = test_reconf_node,
+    .init       = test_reconf_node_init,
+    .nb_edges   = 1,
+    .next_nodes = {"test_reconf_sink"},
+};
+CNE_NODE_REGISTER(test_reconf_node_node);
+
+static struct cne_node_register test_reconf_sink_node = {
+    .name    = "test_reconf_sink",
+    .process = test_reconf_sink,
+};
+CNE_NODE_REGISTER(test_reconf_sink_node);
+
+static int
+test_graph_reconfigure(void)
+{
+    static const char *patterns[] = {"test_reconf_source", "test_reconf_sink", NULL};
+    static const char *added[]    = {"test_reconf_node", NULL};
+    struct cne_graph *graph;
+    struct cne_node *node;
+    cne_graph_t id;
+    int ret = -1;
+
+    for (int i = 0; i < CNE_GRAPH_BURST_SIZE; i++)
+        mbuf_p[MAX_NODES][i] = &mbuf[MAX_NODES][i];
+
+    id    = cne_graph_create("reconf", patterns);
+    graph = cne_graph_lookup("reconf");
+    if (!graph) {
+        tst_error("Reconfigure graph creation failed with error = %d", errno);
+        return -1;
+    }
+    cne_graph_walk(graph);
+
+    /* Add a node between the source and the sink of the running graph */
+    if (cne_node_edge_update(cne_node_from_name("test_reconf_source"), CNE_EDGE_ID_INVALID, added,
+                             1) != 2) {
+        tst_error("Unable to add the edge to the source node");
+        goto out;
+    }
+    if (cne_graph_reconfigure(id, added) != 0) {
+        tst_error("Graph reconfigure failed with error = %d", errno);
+        goto out;
+    }
+    if (reconf_inits != 1) {
+        tst_error("New node initialized %d times", reconf_inits);
+        goto out;
+    }
+
+    /* The old graph pointer walks the new reel with the node state moved */
+    cne_graph_walk(graph);
+    if (reconf_objs[0] != CNE_GRAPH_BURST_SIZE || reconf_objs[1] != 2 * CNE_GRAPH_BURST_SIZE) {
+        tst_error("Reconfigure objects miss match, node = %" PRIu64 " sink = %" PRIu64,
+                  reconf_objs[0], reconf_objs[1]);
+        goto out;
+    }
+    node = cne_graph_node_get(id, cne_node_from_name("test_reconf_source"));
+    if (!node || *(uint64_t *)node->ctx != 2) {
+        tst_error("Source node state not moved to the new reel");
+        goto out;
+    }
+
+    /* A second reconfiguration without patterns keeps the nodes */
+    if (cne_graph_reconfigure(id, NULL) != 0 || reconf_inits != 1) {
+        tst_error("Graph reconfigure without patterns failed");
+        goto out;
+    }
+    cne_graph_walk(graph);
+    node = cne_graph_node_get(id, cne_node_from_name("test_reconf_source"));
+    if (!node || *(uint64_t *)node->ctx != 3 || reconf_objs[0] != 2 * CNE_GRAPH_BURST_SIZE) {
+        tst_error("Graph walk failed after the second reconfiguration");
+        goto out;
+    }
+
+    ret = 0;
+out:
+    cne_graph_destroy(id);
+    return ret;
+}
+
+static uint64_t compile_objs[2];
+static uint64_t compile_calls;
+
+static uint16_t
+test_compile_source(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(objs);
+    CNE_SET_USED(nb_objs);
+
+    /* Half the objects skip test_compile_a, the edge to test_compile_b comes first */
+    cne_node_enqueue(graph, node, 0, mbuf_p[MAX_NODES], CNE_GRAPH_BURST_SIZE / 2);
+    cne_node_enqueue(graph, node, 1, &mbuf_p[MAX_NODES][CNE_GRAPH_BURST_SIZE / 2],
+                     CNE_GRAPH_BURST_SIZE / 2);
+    return CNE_GRAPH_BURST_SIZE;
+}
+
+static uint16_t
+test_compile_a(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    compile_objs[0] += nb_objs;
+    cne_node_enqueue(graph, node, 0, objs, nb_objs);
+    return nb_objs;
+}
+
+static uint16_t
+test_compile_b(struct cne_graph *graph, struct cne_node *node, void **objs, uint16_t nb_objs)
+{
+    CNE_SET_USED(graph);
+    CNE_SET_USED(node);
+    CNE_SET_USED(objs);
+
+    compile_calls++;
+    compile_objs[1] += nb_objs;
+    return nb_objs;
+}
+
+static struct cne_node_register test_compile_source_node = {
+    .name       = "test_compile_source",
+    .process    = test_compile_source,
+    .flags      = CNE_NODE_SOURCE_F,
+    .nb_edges   = 2,
+    .next_nodes = {"test_compile_b", "test_compile_a"},
+};
+CNE_NODE_REGISTER(test_compile_source_node);
+
+static struct cne_node_register test_compile_a_node = {
+    .name       = "test_compile_a",
+    .process    = test_compile_a,
+    .nb_edges   = 1,
+    .next_nodes = {"test_compile_b"},
+};
+CNE_NODE_REGISTER(test_compile_a_node);
+
+static struct cne_node_register test_compile_b_node = {
+    .name    = "test_compile_b",
+    .process = test_compile_b,
+};
+CNE_NODE_REGISTER(test_compile_b_node);
+
+static int
+test_graph_compile(void)
+{
+    static const char *patterns[] = {"test_compile_*", NULL};
+    struct cne_graph *graph;
+    cne_graph_t id;
+    int ret = -1;
+
+    for (int i = 0; i < CNE_GRAPH_BURST_SIZE; i++)
+        mbuf_p[MAX_NODES][i] = &mbuf[MAX_NODES][i];
+
+    id    = cne_graph_create("compile", patterns);
+    graph = cne_graph_lookup("compile");
+    if (!graph) {
+        tst_error("Compile graph creation failed with error = %d", errno);
+        return -1;
+    }
+
+    /* The reel walks test_compile_b before and after test_compile_a */
+    cne_graph_walk(graph);
+    if (compile_calls != 2 || compile_objs[1] != CNE_GRAPH_BURST_SIZE) {
+        tst_error("Generic walk miss match, calls = %" PRIu64 " objs = %" PRIu64, compile_calls,
+                  compile_objs[1]);
+        goto out;
+    }
+
+    if (cne_graph_compile(id) != 0 || !cne_graph_is_compiled(id)) {
+        tst_error("Graph compile failed");
+        goto out;
+    }
+
+    /* The compiled walk processes test_compile_b once with all the objects */
+    cne_graph_walk(graph);
+    if (compile_calls != 3 || compile_objs[0] != CNE_GRAPH_BURST_SIZE ||
+        compile_objs[1] != 2 * CNE_GRAPH_BURST_SIZE) {
+        tst_error("Compiled walk miss match, calls = %" PRIu64 " objs = %" PRIu64, compile_calls,
+                  compile_objs[1]);
+        goto out;
+    }
+
+    ret = 0;
+out:
+    cne_graph_destroy(id);
+    return ret;
+}
+
 // clang-format off
 static struct unit_test_suite graph_testsuite = {
     .suite_name = "Graph library test suite",
@@ -768,6 +1428,12 @@ static struct unit_test_suite graph_testsuite = {
             TEST_CASE(test_graph_lookup_functions),
             TEST_CASE(test_graph_walk),
             TEST_CASE(test_print_stats),
+            TEST_CASE(test_stats_sample),
+            TEST_CASE(test_graph_trace),
+            TEST_CASE(test_graph_dispatch),
+            TEST_CASE(test_graph_feature),
+            TEST_CASE(test_graph_reconfigure),
+            TEST_CASE(test_graph_compile),
             TEST_CASES_END(), /**< NULL terminate unit test array */
         },
 };
@@ -0,0 +1,317 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdlib.h>        // for rand
+#include <string.h>        // for memset
+
+#include <cne_common.h>        // for __cne_unused
+#include <cne_mmap.h>          // for mmap_alloc, mmap_addr, mmap_free
+#include <pktmbuf.h>           // for pktmbuf_t, pktmbuf_alloc, pktmbuf_free
+#include <net/cne_ether.h>     // for cne_ether_hdr
+#include <net/cne_ip.h>        // for cne_ipv4_hdr, cne_ipv4_cksum
+#include <net/cne_tcp.h>       // for cne_tcp_hdr, TCP_FIN_FLAG
+#include <net/cne_udp.h>       // for cne_udp_hdr
+#include <gso.h>               // for gso_segment, gso_ctx_t
+#include <tst_info.h>          // for tst_start, tst_end, tst_error
+
+#include "gso_test.h"
+
+#define GSO_MBUF_COUNT 256
+#define GSO_MBUF_SIZE  (16 * 1024)
+#define GSO_TEST_SEQ   0xFFFFF000 /* Wraps the sequence number in the segments */
+#define GSO_TEST_ID    0xFFFE     /* Wraps the IP packet ID in the segments */
+
+/* all tests use the same pktmbuf pool */
+static pktmbuf_info_t *pi;
+static mmap_t *mm;
+
+static int
+alloc_pool(void)
+{
+    mm = mmap_alloc(GSO_MBUF_COUNT, GSO_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), GSO_MBUF_COUNT, GSO_MBUF_SIZE, 0, NULL);
+    if (!pi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        mmap_free(mm);
+        mm = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+free_pool(void)
+{
+    if (pi)
+        pktmbuf_destroy(pi);
+    pi = NULL;
+
+    if (mm)
+        mmap_free(mm);
+    mm = NULL;
+}
+
+/* Build a large TCP or UDP over IPv4 packet with <len> bytes of payload */
+static pktmbuf_t *
+build_pkt(uint8_t proto, uint16_t len, uint16_t segsz, bool cksum)
+{
+    struct cne_ether_hdr *eth;
+    struct cne_ipv4_hdr *ip;
+    uint16_t l4_len;
+    pktmbuf_t *m;
+    char *p;
+
+    m = pktmbuf_alloc(pi);
+    if (!m)
+        return NULL;
+
+    l4_len = (proto == IPPROTO_TCP) ? sizeof(struct cne_tcp_hdr) : sizeof(struct cne_udp_hdr);
+
+    eth = pktmbuf_mtod(m, struct cne_ether_hdr *);
+    memset(eth, 0, sizeof(*eth) + sizeof(*ip) + l4_len);
+    eth->ether_type = htobe16(CNE_ETHER_TYPE_IPV4);
+
+    ip                = (struct cne_ipv4_hdr *)(eth + 1);
+    ip->version_ihl   = 0x45;
+    ip->time_to_live  = 64;
+    ip->next_proto_id = proto;
+    ip->total_length  = htobe16(sizeof(*ip) + l4_len + len);
+    ip->packet_id     = htobe16(GSO_TEST_ID);
+    ip->src_addr      = htobe32(CNE_IPV4(198, 18, 0, 1));
+    ip->dst_addr      = htobe32(CNE_IPV4(198, 18, 0, 2));
+    ip->hdr_checksum  = cne_ipv4_cksum(ip);
+
+    m->l2_len    = sizeof(*eth);
+    m->l3_len    = sizeof(*ip);
+    m->l4_len    = l4_len;
+    m->tso_segsz = segsz;
+
+    if (proto == IPPROTO_TCP) {
+        struct cne_tcp_hdr *tcp = (struct cne_tcp_hdr *)(ip + 1);
+
+        m->ol_flags    = CNE_MBUF_F_TX_TCP_SEG | CNE_MBUF_F_TX_IPV4;
+        tcp->sent_seq  = htobe32(GSO_TEST_SEQ);
+        tcp->data_off  = (sizeof(*tcp) >> 2) << 4;
+        tcp->tcp_flags = TCP_CWR_FLAG | TCP_ACK_FLAG | TCP_PSH_FLAG | TCP_FIN_FLAG;
+        tcp->cksum     = cne_ipv4_phdr_cksum(ip, m->ol_flags);
+    } else {
+        struct cne_udp_hdr *udp = (struct cne_udp_hdr *)(ip + 1);
+
+        m->ol_flags      = CNE_MBUF_F_TX_UDP_SEG | CNE_MBUF_F_TX_IPV4;
+        udp->dgram_len   = htobe16(l4_len + len);
+        udp->dgram_cksum = (cksum) ? cne_ipv4_phdr_cksum(ip, m->ol_flags) : 0;
+    }
+
+    p = pktmbuf_mtod_offset(m, char *, m->l2_len + m->l3_len + l4_len);
+    for (int i = 0; i < len; i++)
+        p[i] = rand() & 0xFF;
+
+    pktmbuf_data_len(m) = m->l2_len + m->l3_len + l4_len + len;
+
+    return m;
+}
+
+static int
+check_segs(pktmbuf_t **segs, int n, uint8_t proto, uint16_t len, uint16_t segsz, bool cksum)
+{
+    uint32_t total = 0;
+
+    for (int i = 0; i < n; i++) {
+        pktmbuf_t *m            = segs[i];
+        struct cne_ipv4_hdr *ip = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+        void *l4                = (char *)ip + m->l3_len;
+        uint16_t plen           = be16toh(ip->total_length) - m->l3_len - m->l4_len;
+
+        if (m->ol_flags & GSO_SEG_FLAGS) {
+            tst_error("segment %d still has a segmentation flag\n", i);
+            return -1;
+        }
+        if (pktmbuf_data_len(m) != (m->l2_len + m->l3_len + m->l4_len + plen)) {
+            tst_error("segment %d data length %u mismatch\n", i, pktmbuf_data_len(m));
+            return -1;
+        }
+        if (plen > segsz || (i < (n - 1) && plen != segsz)) {
+            tst_error("segment %d payload length %u with segsz %u\n", i, plen, segsz);
+            return -1;
+        }
+        if (cne_raw_cksum(ip, m->l3_len) != 0xFFFF) {
+            tst_error("segment %d IPv4 header checksum is invalid\n", i);
+            return -1;
+        }
+        if (be16toh(ip->packet_id) != (uint16_t)(GSO_TEST_ID + i)) {
+            tst_error("segment %d packet ID %04x\n", i, be16toh(ip->packet_id));
+            return -1;
+        }
+
+        if (proto == IPPROTO_TCP) {
+            struct cne_tcp_hdr *tcp = l4;
+            bool last               = (i == (n - 1));
+
+            if (be32toh(tcp->sent_seq) != (uint32_t)(GSO_TEST_SEQ + total)) {
+                tst_error("segment %d sequence number %u\n", i, be32toh(tcp->sent_seq));
+                return -1;
+            }
+            if (!!(tcp->tcp_flags & TCP_FIN_FLAG) != last ||
+                !!(tcp->tcp_flags & TCP_PSH_FLAG) != last ||
+                !!(tcp->tcp_flags & TCP_CWR_FLAG) != (i == 0)) {
+                tst_error("segment %d TCP flags %02x\n", i, tcp->tcp_flags);
+                return -1;
+            }
+            if (cne_ipv4_udptcp_cksum_verify(ip, tcp)) {
+                tst_error("segment %d TCP checksum is invalid\n", i);
+                return -1;
+            }
+        } else {
+            struct cne_udp_hdr *udp = l4;
+
+            if (be16toh(udp->dgram_len) != (m->l4_len + plen)) {
+                tst_error("segment %d UDP length %u\n", i, be16toh(udp->dgram_len));
+                return -1;
+            }
+            if ((cksum && cne_ipv4_udptcp_cksum_verify(ip, udp)) ||
+                (!cksum && udp->dgram_cksum)) {
+                tst_error("segment %d UDP checksum %04x\n", i, udp->dgram_cksum);
+                return -1;
+            }
+        }
+        total += plen;
+    }
+
+    if (total != len) {
+        tst_error("segments hold %u bytes, not %u\n", total, len);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int
+test_segment(uint8_t proto, uint16_t len, uint16_t segsz, bool cksum)
+{
+    gso_ctx_t ctx = {.pi = NULL, .gso_types = GSO_SEG_FLAGS};
+    pktmbuf_t *segs[GSO_MAX_SEGS];
+    int n, expect, ret = -1;
+    pktmbuf_t *m;
+
+    m = build_pkt(proto, len, segsz, cksum);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        return -1;
+    }
+
+    expect = CNE_MAX((len + segsz - 1) / segsz, 1);
+
+    n = gso_segment(&ctx, m, segs, GSO_MAX_SEGS);
+    if (n != expect) {
+        tst_error("gso_segment() returned %d, expected %d segments\n", n, expect);
+        if (n <= 0)
+            pktmbuf_free(m);
+        else
+            pktmbuf_free_bulk(segs, n);
+        return -1;
+    }
+
+    if (expect == 1 && segs[0] != m)
+        tst_error("one segment packet was not updated in place\n");
+    else
+        ret = check_segs(segs, n, proto, len, segsz, cksum);
+
+    pktmbuf_free_bulk(segs, n);
+
+    return ret;
+}
+
+static int
+test_errors(void)
+{
+    gso_ctx_t ctx = {.pi = NULL, .gso_types = CNE_MBUF_F_TX_UDP_SEG};
+    pktmbuf_t *segs[4];
+    pktmbuf_t *m;
+    int n, ret = -1;
+
+    m = build_pkt(IPPROTO_TCP, 8000, 1000, true);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        return -1;
+    }
+
+    /* TCP segmentation is not requested by the context */
+    if (gso_segment(&ctx, m, segs, CNE_DIM(segs)) != 0) {
+        tst_error("gso_segment() segmented a packet type not in gso_types\n");
+        goto leave;
+    }
+
+    /* More segments are needed than the segs array holds */
+    ctx.gso_types = GSO_SEG_FLAGS;
+    n             = gso_segment(&ctx, m, segs, CNE_DIM(segs));
+    if (n != -1) {
+        tst_error("gso_segment() did not fail with a short segs array\n");
+        if (n > 0) {
+            pktmbuf_free_bulk(segs, n);
+            m = NULL;
+        }
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    pktmbuf_free(m);
+    return ret;
+}
+
+int
+gso_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        uint8_t proto;
+        uint16_t len;
+        uint16_t segsz;
+        bool cksum;
+    } tsts[] = {
+        {"GSO: TCP segments", IPPROTO_TCP, 12000, 1448, true},
+        {"GSO: TCP max segments", IPPROTO_TCP, 64 * 200, 200, true},
+        {"GSO: TCP one segment", IPPROTO_TCP, 1000, 1448, true},
+        {"GSO: UDP datagrams", IPPROTO_UDP, 9001, 1472, true},
+        {"GSO: UDP datagrams no checksum", IPPROTO_UDP, 9001, 1000, false},
+    };
+    // clang-format on
+    tst_info_t *tst;
+
+    /* allocate the pktmbuf pool used by all tests */
+    if (alloc_pool()) {
+        /* dummy test, only used if pool alloc fails */
+        tst = tst_start("GSO: alloc pool");
+        tst_error("alloc_pool() failed\n");
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (test_segment(tsts[i].proto, tsts[i].len, tsts[i].segsz, tsts[i].cksum))
+            goto err;
+        tst_end(tst, TST_PASSED);
+    }
+
+    tst = tst_start("GSO: errors");
+    if (test_errors())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    free_pool();
+    return 0;
+
+err:
+    tst_end(tst, TST_FAILED);
+    free_pool();
+    return -1;
+}
@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _GSO_TEST_H_
+#define _GSO_TEST_H_
+
+int gso_main(int argc, char **argv);
+
+#endif /* _GSO_TEST_H_ */
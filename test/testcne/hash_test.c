@@ -24,6 +24,7 @@
 #include <cne_fbk_hash.h>
 #include <cne_jhash.h>
 #include <cne_hash_crc.h>
+#include <cne_thash.h>
 
 /*******************************************************************************
  * Hash function performance test configuration section. Each performance test
@@ -1648,6 +1649,87 @@ fail_jhash_3word:
 
 struct flow_key g_rand_keys[9];
 
+/* RSS key and IPv4 5-tuple vector from the Microsoft RSS verification suite */
+static const uint8_t thash_test_key[] = {
+    0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2, 0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3,
+    0x8f, 0xb0, 0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4, 0x77, 0xcb, 0x2d, 0xa3,
+    0x80, 0x30, 0xf2, 0x0c, 0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+/* 66.9.149.187:2794 -> 161.142.100.80:1766 */
+static const uint8_t thash_test_tuple[] = {
+    66, 9, 149, 187, 161, 142, 100, 80, 0x0a, 0xea, 0x06, 0xe6,
+};
+#define THASH_TEST_L4_HASH 0x51ccc178
+
+#define THASH_TEST_TUPLES 67 /* not a multiple of the vector width */
+
+/*
+ * Compare every available Toeplitz implementation, single and bulk, with the
+ * bit serial cne_softrss() for all tuple lengths of the IPv4 and IPv6 tuples.
+ */
+static int
+test_thash(void)
+{
+    enum cne_thash_impl impls[] = {CNE_THASH_IMPL_SCALAR, CNE_THASH_IMPL_AVX2,
+                                   CNE_THASH_IMPL_GFNI, CNE_THASH_IMPL_DEFAULT};
+    static uint32_t words[THASH_TEST_TUPLES][CNE_THASH_V6_L4_LEN];
+    static uint8_t bytes[THASH_TEST_TUPLES][CNE_THASH_V6_L4_LEN * 4];
+    const uint8_t *tuples[THASH_TEST_TUPLES];
+    uint32_t hashes[THASH_TEST_TUPLES];
+    struct cne_thash_ctx *ctx;
+
+    for (int i = 0; i < THASH_TEST_TUPLES; i++) {
+        for (uint32_t w = 0; w < CNE_THASH_V6_L4_LEN; w++) {
+            uint32_t be;
+
+            words[i][w] = (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+            be          = htobe32(words[i][w]);
+            memcpy(&bytes[i][w * 4], &be, sizeof(be));
+        }
+        tuples[i] = bytes[i];
+    }
+
+    if (cne_thash_create(thash_test_key, CNE_THASH_KEY_LEN_MAX + 1, CNE_THASH_IMPL_DEFAULT)) {
+        cne_printf("ERROR line %d: thash created with a too long key\n", __LINE__);
+        return -1;
+    }
+
+    for (int k = 0; k < (int)cne_countof(impls); k++) {
+        ctx = cne_thash_create(thash_test_key, sizeof(thash_test_key), impls[k]);
+        if (!ctx) {
+            /* The vector implementations depend on the CPU and compiler */
+            if (impls[k] == CNE_THASH_IMPL_SCALAR || impls[k] == CNE_THASH_IMPL_DEFAULT) {
+                cne_printf("ERROR line %d: thash create impl %d failed\n", __LINE__, impls[k]);
+                return -1;
+            }
+            continue;
+        }
+
+        if (cne_thash(ctx, thash_test_tuple, sizeof(thash_test_tuple)) != THASH_TEST_L4_HASH)
+            goto err;
+
+        for (uint32_t len = 1; len <= CNE_THASH_V6_L4_LEN; len++) {
+            cne_thash_bulk(ctx, tuples, len * 4, hashes, THASH_TEST_TUPLES);
+
+            for (int i = 0; i < THASH_TEST_TUPLES; i++) {
+                uint32_t ref = cne_softrss(words[i], len, thash_test_key);
+
+                if (hashes[i] != ref || cne_thash(ctx, tuples[i], len * 4) != ref)
+                    goto err;
+            }
+        }
+        cne_thash_free(ctx);
+    }
+
+    return 0;
+err:
+    cne_printf("ERROR line %d: thash impl %d does not match cne_softrss()\n", __LINE__,
+               cne_thash_impl_get(ctx));
+    cne_thash_free(ctx);
+    return -1;
+}
+
 /*
  * Do all unit and performance tests.
  */
@@ -1705,6 +1787,9 @@ test_hash(void)
     if (test_crc32_hash_alg_equiv() < 0)
         return -1;
 
+    if (test_thash() < 0)
+        return -1;
+
     return 0;
 }
 
@@ -0,0 +1,744 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <inttypes.h>        // for PRIu64
+#include <stdlib.h>          // for rand
+#include <string.h>          // for memset, memcpy, memcmp
+
+#include <cne_common.h>        // for __cne_unused
+#include <cne_mmap.h>          // for mmap_alloc, mmap_addr, mmap_free
+#include <cne_cycles.h>        // for cne_rdtsc
+#include <cne_system.h>        // for cne_get_timer_hz
+#include <pktmbuf.h>           // for pktmbuf_t, pktmbuf_alloc, pktmbuf_free
+#include <pktmbuf_ptype.h>     // for cne_get_ptype, cne_net_hdr_lens, CNE_PTYPE_L4_MASK
+#include <net/cne_ether.h>     // for cne_ether_hdr
+#include <net/cne_ip.h>        // for cne_ipv4_hdr, cne_ipv4_cksum
+#include <net/cne_udp.h>       // for cne_udp_hdr
+#include <ip_frag.h>           // for ip_frag_ipv4, ip_frag_reassemble
+#include <tst_info.h>          // for tst_start, tst_end, tst_error
+
+#include "ip_frag_test.h"
+
+#define FRAG_MBUF_COUNT 256
+#define FRAG_MBUF_SIZE  (16 * 1024)
+#define FRAG_TEST_ID    0x1234
+#define FRAG_TIMEOUT_MS 100
+
+/* Pool of the fragments received in buffers smaller than the datagram */
+#define FRAG_SMALL_COUNT 16
+#define FRAG_SMALL_SIZE  DEFAULT_MBUF_SIZE
+#define FRAG_META_BYTE   0xA5
+#define FRAG_FLOOD_MAX   8 /* Max fragments held by the table of the flood test */
+#define FRAG_FLOOD_DGRAM 10
+
+/* Router alert is copied into all fragments, record route only into the first one */
+static const uint8_t frag_opts[] = {0x94, 0x04, 0x00, 0x00, 0x07, 0x07,
+                                    0x04, 0x00, 0x00, 0x00, 0x00, 0x00};
+#define FRAG_COPIED_OPTS_LEN 4
+
+/* all tests use the same pktmbuf pool */
+static pktmbuf_info_t *pi;
+static mmap_t *mm;
+
+/* copy of the last packet built, the packet is freed when it is fragmented */
+static uint8_t orig[FRAG_MBUF_SIZE];
+
+static int
+alloc_pool(void)
+{
+    mm = mmap_alloc(FRAG_MBUF_COUNT, FRAG_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), FRAG_MBUF_COUNT, FRAG_MBUF_SIZE, 0, NULL);
+    if (!pi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        mmap_free(mm);
+        mm = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+free_pool(void)
+{
+    if (pi)
+        pktmbuf_destroy(pi);
+    pi = NULL;
+
+    if (mm)
+        mmap_free(mm);
+    mm = NULL;
+}
+
+/* Build a UDP over IPv4 packet with <len> bytes of payload, with or without IPv4 options */
+static pktmbuf_t *
+build_pkt(uint16_t id, uint16_t len, bool opts)
+{
+    struct cne_ether_hdr *eth;
+    struct cne_ipv4_hdr *ip;
+    struct cne_udp_hdr *udp;
+    uint16_t hlen;
+    pktmbuf_t *m;
+    char *p;
+
+    m = pktmbuf_alloc(pi);
+    if (!m)
+        return NULL;
+
+    hlen = sizeof(*ip) + ((opts) ? sizeof(frag_opts) : 0);
+
+    eth = pktmbuf_mtod(m, struct cne_ether_hdr *);
+    memset(eth, 0, sizeof(*eth) + hlen + sizeof(*udp));
+    eth->ether_type = htobe16(CNE_ETHER_TYPE_IPV4);
+
+    ip                = (struct cne_ipv4_hdr *)(eth + 1);
+    ip->version_ihl   = 0x40 | (hlen / 4);
+    ip->time_to_live  = 64;
+    ip->next_proto_id = IPPROTO_UDP;
+    ip->total_length  = htobe16(hlen + sizeof(*udp) + len);
+    ip->packet_id     = htobe16(id);
+    ip->src_addr      = htobe32(CNE_IPV4(198, 18, 0, 1));
+    ip->dst_addr      = htobe32(CNE_IPV4(198, 18, 0, 2));
+    if (opts)
+        memcpy(ip + 1, frag_opts, sizeof(frag_opts));
+    ip->hdr_checksum = cne_ipv4_cksum(ip);
+
+    udp            = (struct cne_udp_hdr *)((char *)ip + hlen);
+    udp->dgram_len = htobe16(sizeof(*udp) + len);
+
+    p = (char *)(udp + 1);
+    for (int i = 0; i < len; i++)
+        p[i] = rand() & 0xFF;
+
+    udp->dgram_cksum = cne_ipv4_udptcp_cksum(ip, udp);
+
+    m->l2_len           = sizeof(*eth);
+    m->l3_len           = hlen;
+    pktmbuf_data_len(m) = sizeof(*eth) + hlen + sizeof(*udp) + len;
+
+    memcpy(orig, eth, pktmbuf_data_len(m));
+
+    return m;
+}
+
+/* Build a packet and fragment it, returns the number of fragments or -1 on error */
+static int
+build_frags(uint16_t id, uint16_t len, uint16_t mtu, bool opts, pktmbuf_t **frags)
+{
+    pktmbuf_t *m;
+    int n;
+
+    m = build_pkt(id, len, opts);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        return -1;
+    }
+
+    n = ip_frag_ipv4(m, mtu, NULL, frags, IP_FRAG_MAX_OUT);
+    if (n <= 0) {
+        tst_error("ip_frag_ipv4() returned %d\n", n);
+        pktmbuf_free(m);
+        return -1;
+    }
+
+    return n;
+}
+
+static int
+check_frags(pktmbuf_t **frags, int n, uint16_t mtu, bool opts)
+{
+    struct cne_ipv4_hdr *oip = (struct cne_ipv4_hdr *)&orig[sizeof(struct cne_ether_hdr)];
+    uint16_t ohlen           = cne_ipv4_hdr_len(oip);
+    uint32_t total           = 0;
+
+    for (int i = 0; i < n; i++) {
+        pktmbuf_t *m            = frags[i];
+        struct cne_ipv4_hdr *ip = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+        uint16_t hlen           = cne_ipv4_hdr_len(ip);
+        uint16_t plen           = be16toh(ip->total_length) - hlen;
+        uint16_t fo             = be16toh(ip->fragment_offset);
+        bool last               = (i == (n - 1));
+
+        if (be16toh(ip->total_length) > mtu) {
+            tst_error("fragment %d total length %u is larger than the MTU\n", i,
+                      be16toh(ip->total_length));
+            return -1;
+        }
+        if (hlen != ((i == 0 || !opts) ? ohlen : sizeof(*ip) + FRAG_COPIED_OPTS_LEN)) {
+            tst_error("fragment %d header length %u\n", i, hlen);
+            return -1;
+        }
+        if (cne_ipv4_cksum(ip) != 0) {
+            tst_error("fragment %d IPv4 header checksum is invalid\n", i);
+            return -1;
+        }
+        if ((fo & CNE_IPV4_HDR_OFFSET_MASK) * CNE_IPV4_HDR_OFFSET_UNITS != total ||
+            !!(fo & CNE_IPV4_HDR_MF_FLAG) == last || (!last && (plen & 7))) {
+            tst_error("fragment %d offset and flags %04x with payload length %u\n", i, fo, plen);
+            return -1;
+        }
+        if (pktmbuf_data_len(m) != (m->l2_len + hlen + plen) || ip->packet_id != oip->packet_id) {
+            tst_error("fragment %d data length %u or packet ID mismatch\n", i,
+                      pktmbuf_data_len(m));
+            return -1;
+        }
+        if (memcmp((char *)ip + hlen, (char *)oip + ohlen + total, plen)) {
+            tst_error("fragment %d payload mismatch\n", i);
+            return -1;
+        }
+        total += plen;
+    }
+
+    if (total != (be16toh(oip->total_length) - ohlen)) {
+        tst_error("fragments hold %u bytes, not %u\n", total, be16toh(oip->total_length) - ohlen);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Set the packet type and header lengths of a received packet, as the eth_rx node does */
+static uint32_t
+set_ptype(pktmbuf_t *m)
+{
+    struct cne_net_hdr_lens hdr_lens = {0};
+
+    m->packet_type = cne_get_ptype(m, &hdr_lens, CNE_PTYPE_ALL_MASK);
+    m->l2_len      = hdr_lens.l2_len;
+    m->l3_len      = hdr_lens.l3_len;
+    m->l4_len      = hdr_lens.l4_len;
+
+    return m->packet_type;
+}
+
+/* Add a received fragment to the table, the IPv4 header follows the Ethernet header */
+static pktmbuf_t *
+reassemble(ip_frag_tbl_t *tbl, pktmbuf_t *m, uint64_t tsc)
+{
+    struct cne_ipv4_hdr *ip;
+
+    set_ptype(m);
+    ip = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+
+    return ip_frag_reassemble(tbl, m, ip, tsc);
+}
+
+static int
+test_fragment(uint16_t len, uint16_t mtu, bool opts)
+{
+    pktmbuf_t *frags[IP_FRAG_MAX_OUT];
+    struct ip_frag_stats stats;
+    struct cne_ipv4_hdr *ip;
+    ip_frag_tbl_t *tbl;
+    pktmbuf_t *m = NULL;
+    uint16_t tot_len, l3_len, l4_len;
+    uint32_t ptype;
+    int n, ret = -1;
+
+    n = build_frags(FRAG_TEST_ID, len, mtu, opts, frags);
+    if (n < 0)
+        return -1;
+
+    if (check_frags(frags, n, mtu, opts)) {
+        pktmbuf_free_bulk(frags, n);
+        return -1;
+    }
+
+    tbl = ip_frag_tbl_create(16, FRAG_TIMEOUT_MS, 0, NULL);
+    if (!tbl) {
+        tst_error("ip_frag_tbl_create() failed\n");
+        pktmbuf_free_bulk(frags, n);
+        return -1;
+    }
+
+    /* Add the fragments in reverse order, the first fragment completes the datagram */
+    for (int i = n - 1; i >= 0; i--) {
+        m = reassemble(tbl, frags[i], cne_rdtsc());
+        if (m && i) {
+            tst_error("datagram complete after fragment %d\n", i);
+            goto leave;
+        }
+    }
+    if (!m) {
+        tst_error("datagram not reassembled from %d fragments\n", n);
+        goto leave;
+    }
+
+    ip      = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+    tot_len = be16toh(ip->total_length);
+    if (pktmbuf_data_len(m) != (m->l2_len + tot_len) ||
+        memcmp(ip, &orig[sizeof(struct cne_ether_hdr)], tot_len)) {
+        tst_error("reassembled datagram does not match the packet\n");
+        goto leave;
+    }
+
+    /* The datagram has the L4 type and header lengths of the packet before fragmentation */
+    ptype  = m->packet_type;
+    l3_len = m->l3_len;
+    l4_len = m->l4_len;
+    if ((ptype & CNE_PTYPE_L4_MASK) != CNE_PTYPE_L4_UDP || ptype != set_ptype(m) ||
+        l3_len != cne_ipv4_hdr_len(ip) || l4_len != sizeof(struct cne_udp_hdr) ||
+        l4_len != m->l4_len) {
+        tst_error("reassembled datagram packet type %08x L3 length %u L4 length %u\n", ptype,
+                  l3_len, l4_len);
+        goto leave;
+    }
+
+    if (ip_frag_tbl_stats_get(tbl, &stats) || stats.reassembled != 1 || stats.invalid) {
+        tst_error("reassembly statistics mismatch\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    pktmbuf_free(m);
+    ip_frag_tbl_destroy(tbl);
+    return ret;
+}
+
+/* Copy a fragment to add it twice */
+static pktmbuf_t *
+dup_frag(pktmbuf_t *m)
+{
+    pktmbuf_t *d = pktmbuf_alloc(pi);
+
+    if (!d)
+        return NULL;
+
+    memcpy(pktmbuf_mtod(d, char *), pktmbuf_mtod(m, char *), pktmbuf_data_len(m));
+    pktmbuf_data_len(d) = pktmbuf_data_len(m);
+    d->tx_offload       = m->tx_offload;
+
+    return d;
+}
+
+static int
+test_fragment_errors(void)
+{
+    pktmbuf_t *frags[IP_FRAG_MAX_OUT];
+    struct cne_ipv4_hdr *ip;
+    pktmbuf_t *m;
+    int ret = -1;
+
+    m = build_pkt(FRAG_TEST_ID, 1000, false);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        return -1;
+    }
+
+    /* A packet fitting in the MTU is not fragmented */
+    if (ip_frag_ipv4(m, 1500, NULL, frags, IP_FRAG_MAX_OUT) != 0) {
+        tst_error("ip_frag_ipv4() fragmented a packet fitting in the MTU\n");
+        goto leave;
+    }
+
+    /* More fragments are needed than the frags array holds */
+    if (ip_frag_ipv4(m, 576, NULL, frags, 1) != -1) {
+        tst_error("ip_frag_ipv4() did not fail with a short frags array\n");
+        goto leave;
+    }
+
+    /* A packet with DF set can not be fragmented */
+    ip                  = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+    ip->fragment_offset = htobe16(CNE_IPV4_HDR_DF_FLAG);
+    if (ip_frag_ipv4(m, 576, NULL, frags, IP_FRAG_MAX_OUT) != -1) {
+        tst_error("ip_frag_ipv4() fragmented a packet with DF set\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    pktmbuf_free(m);
+    return ret;
+}
+
+static int
+test_reassemble_errors(void)
+{
+    pktmbuf_t *frags[IP_FRAG_MAX_OUT], *m;
+    struct ip_frag_stats stats;
+    struct cne_ipv4_hdr *ip;
+    uint64_t tsc, timeout;
+    ip_frag_tbl_t *tbl;
+    int n, ret = -1;
+
+    /* A table of one bucket, holding IP_FRAG_BUCKET_ENTRIES datagrams */
+    tbl = ip_frag_tbl_create(IP_FRAG_BUCKET_ENTRIES, FRAG_TIMEOUT_MS, 0, NULL);
+    if (!tbl) {
+        tst_error("ip_frag_tbl_create() failed\n");
+        return -1;
+    }
+    tsc     = cne_rdtsc();
+    timeout = (cne_get_timer_hz() / 1000) * FRAG_TIMEOUT_MS * 2;
+
+    /* A duplicate fragment is dropped and the datagram still reassembled */
+    n = build_frags(FRAG_TEST_ID, 3000, 1500, false, frags);
+    if (n != 3)
+        goto leave;
+    m = dup_frag(frags[0]);
+    if (reassemble(tbl, frags[0], tsc) || (m && reassemble(tbl, m, tsc)) ||
+        reassemble(tbl, frags[1], tsc)) {
+        tst_error("datagram complete before its last fragment\n");
+        pktmbuf_free(frags[2]);
+        goto leave;
+    }
+    m = reassemble(tbl, frags[2], tsc);
+    if (!m) {
+        tst_error("datagram with a duplicate fragment not reassembled\n");
+        goto leave;
+    }
+    pktmbuf_free(m);
+
+    /* An overlapping fragment drops the datagram */
+    n = build_frags(FRAG_TEST_ID + 1, 3000, 1500, false, frags);
+    if (n != 3)
+        goto leave;
+    ip                  = pktmbuf_mtod_offset(frags[1], struct cne_ipv4_hdr *, frags[1]->l2_len);
+    ip->fragment_offset = htobe16(CNE_IPV4_HDR_MF_FLAG | 8);
+    reassemble(tbl, frags[0], tsc);
+    reassemble(tbl, frags[1], tsc);
+    pktmbuf_free(frags[2]);
+
+    /* More than IP_FRAG_MAX_FRAGS fragments drop the datagram */
+    n = build_frags(FRAG_TEST_ID + 2, 3000, 300, false, frags);
+    if (n <= IP_FRAG_MAX_FRAGS) {
+        tst_error("%d fragments created, too few to test\n", n);
+        if (n > 0)
+            pktmbuf_free_bulk(frags, n);
+        goto leave;
+    }
+    for (int i = 0; i <= IP_FRAG_MAX_FRAGS; i++)
+        reassemble(tbl, frags[i], tsc);
+    pktmbuf_free_bulk(&frags[IP_FRAG_MAX_FRAGS + 1], n - IP_FRAG_MAX_FRAGS - 1);
+
+    /* Fill the bucket, a new datagram is dropped until the others time out */
+    for (int i = 0; i <= IP_FRAG_BUCKET_ENTRIES; i++) {
+        n = build_frags(FRAG_TEST_ID + 10 + i, 3000, 1500, false, frags);
+        if (n != 3)
+            goto leave;
+        reassemble(tbl, frags[0], tsc);
+        pktmbuf_free_bulk(&frags[1], n - 1);
+    }
+    if (ip_frag_tbl_expire(tbl, tsc, 1) != 0 ||
+        ip_frag_tbl_expire(tbl, tsc + timeout, 1) != IP_FRAG_BUCKET_ENTRIES) {
+        tst_error("ip_frag_tbl_expire() did not drop the timed out datagrams\n");
+        goto leave;
+    }
+
+    if (ip_frag_tbl_stats_get(tbl, &stats))
+        goto leave;
+    if (stats.reassembled != 1 || stats.invalid != 2 || stats.too_many != 1 ||
+        stats.table_full != 1 || stats.timeout != IP_FRAG_BUCKET_ENTRIES) {
+        tst_error("reassembled %" PRIu64 " invalid %" PRIu64 " too_many %" PRIu64
+                  " table_full %" PRIu64 " timeout %" PRIu64 "\n",
+                  stats.reassembled, stats.invalid, stats.too_many, stats.table_full,
+                  stats.timeout);
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    ip_frag_tbl_destroy(tbl);
+    return ret;
+}
+
+/* Fragment a datagram into the small pool, returns the number of fragments or -1 on error */
+static int
+build_small_frags(pktmbuf_info_t *spi, uint16_t id, uint16_t len, pktmbuf_t **frags)
+{
+    pktmbuf_t *m;
+    int n;
+
+    m = build_pkt(id, len, false);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        return -1;
+    }
+
+    n = ip_frag_ipv4(m, 1500, spi, frags, IP_FRAG_MAX_OUT);
+    if (n <= 0) {
+        tst_error("ip_frag_ipv4() returned %d\n", n);
+        pktmbuf_free(m);
+        return -1;
+    }
+
+    /* Mark the first fragment, the datagram gets its port, hash and metadata */
+    pktmbuf_port(frags[0]) = 3;
+    frags[0]->hash         = 0x12345678;
+    memset(pktmbuf_metadata(frags[0]), FRAG_META_BYTE, CNE_CACHE_LINE_SIZE);
+
+    return n;
+}
+
+/*
+ * A datagram larger than the 2 KB buffer of its first fragment is copied into a buffer of the
+ * reassembly pool, it is dropped by a table without a reassembly pool.
+ */
+static int
+test_reassemble_big(void)
+{
+    pktmbuf_t *frags[IP_FRAG_MAX_OUT], *m = NULL;
+    ip_frag_tbl_t *tbl = NULL, *tbl2 = NULL;
+    struct ip_frag_stats stats;
+    pktmbuf_info_t *spi = NULL;
+    struct cne_ipv4_hdr *ip;
+    uint16_t data_off;
+    uint8_t *meta;
+    mmap_t *smm;
+    int n, ret = -1;
+
+    smm = mmap_alloc(FRAG_SMALL_COUNT, FRAG_SMALL_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!smm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+    spi = pktmbuf_pool_create(mmap_addr(smm), FRAG_SMALL_COUNT, FRAG_SMALL_SIZE, 0, NULL);
+    if (!spi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        goto leave;
+    }
+
+    /* The pool of the tests has buffers large enough for the datagram */
+    tbl  = ip_frag_tbl_create(16, FRAG_TIMEOUT_MS, 0, pi);
+    tbl2 = ip_frag_tbl_create(16, FRAG_TIMEOUT_MS, 0, NULL);
+    if (!tbl || !tbl2) {
+        tst_error("ip_frag_tbl_create() failed\n");
+        goto leave;
+    }
+
+    n = build_small_frags(spi, FRAG_TEST_ID, 6000, frags);
+    if (n < 0)
+        goto leave;
+    data_off = pktmbuf_data_off(frags[0]);
+
+    for (int i = 0; i < n; i++) {
+        m = reassemble(tbl, frags[i], cne_rdtsc());
+        if (m && i != (n - 1)) {
+            tst_error("datagram complete after fragment %d\n", i);
+            goto leave;
+        }
+    }
+    if (!m) {
+        tst_error("datagram larger than the first fragment buffer not reassembled\n");
+        goto leave;
+    }
+
+    ip   = pktmbuf_mtod_offset(m, struct cne_ipv4_hdr *, m->l2_len);
+    meta = pktmbuf_metadata(m);
+    if (m->pooldata != pi || pktmbuf_data_off(m) != data_off ||
+        pktmbuf_data_len(m) != (m->l2_len + be16toh(ip->total_length)) ||
+        memcmp(pktmbuf_mtod(m, char *), orig, pktmbuf_data_len(m))) {
+        tst_error("reassembled datagram does not match the packet\n");
+        goto leave;
+    }
+    if (pktmbuf_port(m) != 3 || m->hash != 0x12345678 || meta[0] != FRAG_META_BYTE ||
+        meta[CNE_CACHE_LINE_SIZE - 1] != FRAG_META_BYTE ||
+        (m->packet_type & CNE_PTYPE_L4_MASK) != CNE_PTYPE_L4_UDP) {
+        tst_error("reassembled datagram does not have the port, hash, metadata or packet type "
+                  "of the first fragment\n");
+        goto leave;
+    }
+    pktmbuf_free(m);
+    m = NULL;
+
+    /* Without a reassembly pool the datagram is too big */
+    n = build_small_frags(spi, FRAG_TEST_ID, 6000, frags);
+    if (n < 0)
+        goto leave;
+    for (int i = 0; i < n; i++) {
+        if (reassemble(tbl2, frags[i], cne_rdtsc())) {
+            tst_error("datagram reassembled without a reassembly pool\n");
+            goto leave;
+        }
+    }
+
+    if (ip_frag_tbl_stats_get(tbl, &stats) || stats.reassembled != 1 || stats.too_big ||
+        ip_frag_tbl_stats_get(tbl2, &stats) || stats.reassembled || stats.too_big != 1) {
+        tst_error("reassembly statistics mismatch\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    pktmbuf_free(m);
+    ip_frag_tbl_destroy(tbl);
+    ip_frag_tbl_destroy(tbl2);
+    pktmbuf_destroy(spi);
+    mmap_free(smm);
+    return ret;
+}
+
+/*
+ * A table holding its max number of fragments drops the new fragments but the ones completing
+ * a datagram, the fragments held are freed by ip_frag_tbl_expire() without new fragments.
+ */
+static int
+test_reassemble_flood(void)
+{
+    pktmbuf_t *frags[IP_FRAG_MAX_OUT], *bufs[FRAG_SMALL_COUNT], *last = NULL, *m = NULL;
+    struct ip_frag_stats stats;
+    pktmbuf_info_t *spi = NULL;
+    ip_frag_tbl_t *tbl = NULL;
+    uint64_t tsc, timeout;
+    uint32_t nb;
+    mmap_t *smm;
+    int n, ret = -1;
+
+    smm = mmap_alloc(FRAG_SMALL_COUNT, FRAG_SMALL_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!smm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+    spi = pktmbuf_pool_create(mmap_addr(smm), FRAG_SMALL_COUNT, FRAG_SMALL_SIZE, 0, NULL);
+    if (!spi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        goto leave;
+    }
+
+    /* Enough buckets to not drop a datagram as its bucket is full */
+    tbl = ip_frag_tbl_create(1024, FRAG_TIMEOUT_MS, FRAG_FLOOD_MAX, NULL);
+    if (!tbl) {
+        tst_error("ip_frag_tbl_create() failed\n");
+        goto leave;
+    }
+    tsc     = cne_rdtsc();
+    timeout = (cne_get_timer_hz() / 1000) * FRAG_TIMEOUT_MS * 2;
+
+    /* Only add the first fragment of each datagram, keep the last fragment of the first one */
+    for (int i = 0; i < FRAG_FLOOD_DGRAM; i++) {
+        n = build_small_frags(spi, FRAG_TEST_ID + i, 1600, frags);
+        if (n != 2) {
+            tst_error("%d fragments created, expected 2\n", n);
+            if (n > 0)
+                pktmbuf_free_bulk(frags, n);
+            goto leave;
+        }
+        if (reassemble(tbl, frags[0], tsc)) {
+            tst_error("datagram %d complete after its first fragment\n", i);
+            pktmbuf_free(frags[1]);
+            goto leave;
+        }
+        if (i == 0)
+            last = frags[1];
+        else
+            pktmbuf_free(frags[1]);
+    }
+
+    nb = ip_frag_tbl_nb_frags(tbl);
+    if (nb != FRAG_FLOOD_MAX) {
+        tst_error("table holds %u fragments, expected %u\n", nb, FRAG_FLOOD_MAX);
+        goto leave;
+    }
+
+    /* The fragment completing a datagram is taken by a full table */
+    m    = reassemble(tbl, last, tsc);
+    last = NULL;
+    if (!m || ip_frag_tbl_nb_frags(tbl) != (FRAG_FLOOD_MAX - 1)) {
+        tst_error("datagram not reassembled by a full table\n");
+        goto leave;
+    }
+    pktmbuf_free(m);
+    m = NULL;
+
+    /* Without new fragments, the fragments held are freed once they time out */
+    if (ip_frag_tbl_expire(tbl, tsc, UINT32_MAX) != 0 ||
+        ip_frag_tbl_expire(tbl, tsc + timeout, UINT32_MAX) != (FRAG_FLOOD_MAX - 1) ||
+        ip_frag_tbl_nb_frags(tbl) != 0) {
+        tst_error("ip_frag_tbl_expire() did not free the timed out fragments\n");
+        goto leave;
+    }
+
+    /* All the mbufs of the pool are back */
+    if (pktmbuf_alloc_bulk(spi, bufs, FRAG_SMALL_COUNT) != FRAG_SMALL_COUNT) {
+        tst_error("fragments not returned to their pool\n");
+        goto leave;
+    }
+    pktmbuf_free_bulk(bufs, FRAG_SMALL_COUNT);
+
+    if (ip_frag_tbl_stats_get(tbl, &stats) || stats.reassembled != 1 ||
+        stats.frags_full != (FRAG_FLOOD_DGRAM - FRAG_FLOOD_MAX) ||
+        stats.timeout != (FRAG_FLOOD_MAX - 1) || stats.table_full) {
+        tst_error("reassembled %" PRIu64 " frags_full %" PRIu64 " timeout %" PRIu64
+                  " table_full %" PRIu64 "\n",
+                  stats.reassembled, stats.frags_full, stats.timeout, stats.table_full);
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    pktmbuf_free(last);
+    pktmbuf_free(m);
+    ip_frag_tbl_destroy(tbl);
+    pktmbuf_destroy(spi);
+    mmap_free(smm);
+    return ret;
+}
+
+int
+ip_frag_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        uint16_t len;
+        uint16_t mtu;
+        bool opts;
+    } tsts[] = {
+        {"IP_FRAG: three fragments", 4000, 1500, false},
+        {"IP_FRAG: eight fragments", 4000, 576, false},
+        {"IP_FRAG: fragments with options", 4000, 576, true},
+        {"IP_FRAG: last fragment of 8 bytes", 1480, 1500, false},
+    };
+    // clang-format on
+    tst_info_t *tst;
+
+    /* allocate the pktmbuf pool used by all tests */
+    if (alloc_pool()) {
+        /* dummy test, only used if pool alloc fails */
+        tst = tst_start("IP_FRAG: alloc pool");
+        tst_error("alloc_pool() failed\n");
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (test_fragment(tsts[i].len, tsts[i].mtu, tsts[i].opts))
+            goto err;
+        tst_end(tst, TST_PASSED);
+    }
+
+    tst = tst_start("IP_FRAG: fragment errors");
+    if (test_fragment_errors())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    tst = tst_start("IP_FRAG: reassemble errors");
+    if (test_reassemble_errors())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    tst = tst_start("IP_FRAG: reassemble into a larger buffer");
+    if (test_reassemble_big())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    tst = tst_start("IP_FRAG: fragment flood and timeout");
+    if (test_reassemble_flood())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    free_pool();
+    return 0;
+
+err:
+    tst_end(tst, TST_FAILED);
+    free_pool();
+    return -1;
+}
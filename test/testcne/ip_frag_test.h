@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _IP_FRAG_TEST_H_
+#define _IP_FRAG_TEST_H_
+
+int ip_frag_main(int argc, char **argv);
+
+#endif /* _IP_FRAG_TEST_H_ */
@@ -0,0 +1,432 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <endian.h>            // for htobe16, htobe32
+#include <netinet/in.h>        // for INADDR_ANY
+#include <stdint.h>            // for uint32_t, uint16_t
+#include <string.h>            // for memset
+
+#include <cne_common.h>          // for __cne_unused, CNE_DIM
+#include <cne_inet.h>            // for in_caddr_update
+#include <cne_mmap.h>            // for mmap_alloc, mmap_addr, mmap_free
+#include <pktmbuf.h>             // for pktmbuf_t, pktmbuf_alloc, pktmbuf_free
+#include <net/cne_ip.h>          // for CNE_IPV4
+#include <cnet_pcb.h>            // for pcb_entry, pcb_key, cnet_pcb_lookup, cnet_pcb_update
+#include <tcp_input_priv.h>      // for tcpip4_t, tcp_input_bulk_lookup, tcp_input_pcb
+#include <tst_info.h>            // for tst_start, tst_end, tst_error
+
+#include "pcb_test.h"
+
+#define PCB_ENTRIES    1024
+#define PCB_NB_CONN    64
+#define PCB_NB_KEYS    150
+#define PCB_MBUF_COUNT 16
+#define PCB_MBUF_SIZE  (2 * 1024)
+
+#define PCB_LADDR   CNE_IPV4(10, 0, 0, 1)
+#define PCB_LADDR2  CNE_IPV4(10, 0, 0, 2)
+#define PCB_FADDR   CNE_IPV4(10, 1, 0, 0)
+#define PCB_LPORT   80
+#define PCB_FPORT   1024
+#define PCB_NOLPORT 81
+
+static struct pcb_hd hd;
+
+/* The connected PCBs and the listeners on any address and on PCB_LADDR */
+static struct pcb_entry conns[PCB_NB_CONN];
+static struct pcb_entry any, lsn, extra;
+
+/* Set a key from host order addresses and ports, a zero address is a wildcard */
+static void
+pcb_key_set(struct pcb_key *key, uint32_t faddr, uint16_t fport, uint32_t laddr, uint16_t lport)
+{
+    memset(key, 0, sizeof(struct pcb_key));
+    in_caddr_update(&key->faddr, AF_INET, sizeof(struct in_addr), htobe16(fport));
+    key->faddr.cin_addr.s_addr = htobe32(faddr);
+    in_caddr_update(&key->laddr, AF_INET, sizeof(struct in_addr), htobe16(lport));
+    key->laddr.cin_addr.s_addr = htobe32(laddr);
+}
+
+/* Key of the connection <i> from PCB_FADDR + i to PCB_LADDR */
+static void
+pcb_conn_key(struct pcb_key *key, int i)
+{
+    pcb_key_set(key, PCB_FADDR + i + 1, PCB_FPORT + i, PCB_LADDR, PCB_LPORT);
+}
+
+/* Hash a PCB with the given key, the generation of the list must change */
+static int
+pcb_add(struct pcb_entry *pcb, struct pcb_key *key)
+{
+    uint32_t gen = hd.gen;
+
+    memset(pcb, 0, sizeof(struct pcb_entry));
+    pcb->hd  = &hd;
+    pcb->key = *key;
+
+    if (cnet_pcb_update(pcb) < 0) {
+        tst_error("cnet_pcb_update() failed\n");
+        return -1;
+    }
+    if (hd.gen == gen) {
+        tst_error("Generation not changed by hashing a PCB\n");
+        return -1;
+    }
+    return 0;
+}
+
+/* Create the list with the connections and the two listeners */
+static int
+pcb_setup(int nb_conns)
+{
+    struct pcb_key key;
+
+    memset(&hd, 0, sizeof(hd));
+    if (cnet_pcb_hd_create(&hd, "pcb_test", PCB_ENTRIES) < 0) {
+        tst_error("cnet_pcb_hd_create() failed\n");
+        return -1;
+    }
+
+    for (int i = 0; i < nb_conns; i++) {
+        pcb_conn_key(&key, i);
+        if (pcb_add(&conns[i], &key))
+            return -1;
+    }
+
+    pcb_key_set(&key, INADDR_ANY, 0, INADDR_ANY, PCB_LPORT);
+    if (pcb_add(&any, &key))
+        return -1;
+    pcb_key_set(&key, INADDR_ANY, 0, PCB_LADDR, PCB_LPORT);
+    return pcb_add(&lsn, &key);
+}
+
+static void
+pcb_cleanup(void)
+{
+    for (int i = 0; i < PCB_NB_CONN; i++)
+        cnet_pcb_unhash(&conns[i]);
+    cnet_pcb_unhash(&any);
+    cnet_pcb_unhash(&lsn);
+    cnet_pcb_unhash(&extra);
+    cnet_pcb_hd_destroy(&hd);
+}
+
+static int
+pcb_check(const char *msg, struct pcb_key *key, int32_t flag, struct pcb_entry *expect)
+{
+    struct pcb_entry *pcb = cnet_pcb_lookup(&hd, key, flag);
+
+    if (pcb != expect) {
+        tst_error("%s: found PCB %p, expected %p\n", msg, pcb, expect);
+        return -1;
+    }
+    return 0;
+}
+
+/* Connected PCBs are found by their 4-tuple and are gone once unhashed */
+static int
+test_hash(void)
+{
+    struct pcb_key key;
+    uint32_t gen;
+    int rc = -1;
+
+    if (pcb_setup(PCB_NB_CONN))
+        goto leave;
+    cnet_pcb_unhash(&any);
+    cnet_pcb_unhash(&lsn);
+
+    for (int i = 0; i < PCB_NB_CONN; i++) {
+        pcb_conn_key(&key, i);
+        if (pcb_check("Exact match", &key, EXACT_MATCH, &conns[i]) ||
+            pcb_check("Best match", &key, BEST_MATCH, &conns[i]))
+            goto leave;
+    }
+
+    /* A different foreign port, or local address, misses without listeners */
+    pcb_key_set(&key, PCB_FADDR + 1, PCB_FPORT + 1, PCB_LADDR, PCB_LPORT);
+    if (pcb_check("Foreign port", &key, EXACT_MATCH, NULL) ||
+        pcb_check("Foreign port", &key, BEST_MATCH, NULL))
+        goto leave;
+    pcb_key_set(&key, PCB_FADDR + 1, PCB_FPORT, PCB_LADDR2, PCB_LPORT);
+    if (pcb_check("Local address", &key, BEST_MATCH, NULL))
+        goto leave;
+
+    /* Unhashing changes the generation once */
+    gen = hd.gen;
+    cnet_pcb_unhash(&conns[0]);
+    cnet_pcb_unhash(&conns[0]);
+    if (hd.gen != gen + 1) {
+        tst_error("Generation %u after unhashing a PCB twice, expected %u\n", hd.gen, gen + 1);
+        goto leave;
+    }
+    pcb_conn_key(&key, 0);
+    if (pcb_check("Unhashed PCB", &key, BEST_MATCH, NULL))
+        goto leave;
+
+    /* A PCB updated with a new key is only found with the new key */
+    pcb_conn_key(&key, 1);
+    pcb_conn_key(&conns[1].key, 1000);
+    if (cnet_pcb_update(&conns[1]) < 0) {
+        tst_error("cnet_pcb_update() failed\n");
+        goto leave;
+    }
+    if (pcb_check("Old key", &key, BEST_MATCH, NULL) ||
+        pcb_check("New key", &conns[1].key, EXACT_MATCH, &conns[1]))
+        goto leave;
+
+    rc = 0;
+leave:
+    pcb_cleanup();
+    return rc;
+}
+
+/* Keys without a connected PCB fall back to the listener with the fewest wildcards */
+static int
+test_wildcard(void)
+{
+    struct pcb_key key;
+    int rc = -1;
+
+    if (pcb_setup(1))
+        goto leave;
+
+    pcb_conn_key(&key, 0);
+    if (pcb_check("Connected", &key, BEST_MATCH, &conns[0]) ||
+        pcb_check("IPv6 lookup", &key, BEST_MATCH | IPV6_TYPE, NULL))
+        goto leave;
+
+    /* A new connection to the local address goes to its listener, not to the any listener */
+    pcb_key_set(&key, PCB_FADDR + 100, PCB_FPORT, PCB_LADDR, PCB_LPORT);
+    if (pcb_check("Local address listener", &key, BEST_MATCH, &lsn) ||
+        pcb_check("Exact match of a listener", &key, EXACT_MATCH, NULL))
+        goto leave;
+
+    pcb_key_set(&key, PCB_FADDR + 100, PCB_FPORT, PCB_LADDR2, PCB_LPORT);
+    if (pcb_check("Any address listener", &key, BEST_MATCH, &any))
+        goto leave;
+
+    pcb_key_set(&key, PCB_FADDR + 100, PCB_FPORT, PCB_LADDR, PCB_NOLPORT);
+    if (pcb_check("Port without listener", &key, BEST_MATCH, NULL))
+        goto leave;
+
+    /* Bind keys have no foreign address and are compared to all the PCBs of the port */
+    pcb_key_set(&key, INADDR_ANY, 0, PCB_LADDR, PCB_LPORT);
+    if (pcb_check("Bind to the local address", &key, BEST_MATCH, &lsn))
+        goto leave;
+    pcb_key_set(&key, INADDR_ANY, 0, INADDR_ANY, PCB_LPORT);
+    if (pcb_check("Bind to any address", &key, EXACT_MATCH, &any))
+        goto leave;
+    pcb_key_set(&key, INADDR_ANY, 0, INADDR_ANY, PCB_NOLPORT);
+    if (pcb_check("Bind to a free port", &key, BEST_MATCH, NULL))
+        goto leave;
+
+    /* Without the local address listener the any listener gets the connection */
+    cnet_pcb_unhash(&lsn);
+    pcb_key_set(&key, PCB_FADDR + 100, PCB_FPORT, PCB_LADDR, PCB_LPORT);
+    if (pcb_check("Listener closed", &key, BEST_MATCH, &any))
+        goto leave;
+    pcb_key_set(&key, INADDR_ANY, 0, PCB_LADDR, PCB_LPORT);
+    if (pcb_check("Bind after listener closed", &key, BEST_MATCH, &any))
+        goto leave;
+
+    rc = 0;
+leave:
+    pcb_cleanup();
+    return rc;
+}
+
+/* A bulk lookup finds the same PCBs as a lookup of each key, over more than one hash burst */
+static int
+test_bulk(void)
+{
+    struct pcb_key keys[PCB_NB_KEYS], *kp[PCB_NB_KEYS];
+    struct pcb_entry *pcbs[PCB_NB_KEYS];
+    int found = 0, nb, rc = -1;
+
+    if (pcb_setup(PCB_NB_CONN))
+        goto leave;
+
+    for (int i = 0; i < PCB_NB_KEYS; i++) {
+        switch (i % 5) {
+        case 0:
+        case 1: /* Connected, the keys above PCB_NB_CONN go to the listener */
+            pcb_conn_key(&keys[i], i / 2);
+            break;
+        case 2: /* Local address listener */
+            pcb_key_set(&keys[i], PCB_FADDR + 200, PCB_FPORT + i, PCB_LADDR, PCB_LPORT);
+            break;
+        case 3: /* Any address listener */
+            pcb_key_set(&keys[i], PCB_FADDR + 200, PCB_FPORT + i, PCB_LADDR2, PCB_LPORT);
+            break;
+        default: /* No listener */
+            pcb_key_set(&keys[i], PCB_FADDR + 200, PCB_FPORT + i, PCB_LADDR, PCB_NOLPORT);
+            break;
+        }
+        kp[i] = &keys[i];
+    }
+
+    nb = cnet_pcb_lookup_bulk(&hd, kp, PCB_NB_KEYS, pcbs, 0);
+
+    for (int i = 0; i < PCB_NB_KEYS; i++) {
+        struct pcb_entry *pcb = cnet_pcb_lookup(&hd, &keys[i], BEST_MATCH);
+
+        if (pcbs[i] != pcb) {
+            tst_error("Key %d: bulk lookup found %p, lookup found %p\n", i, pcbs[i], pcb);
+            goto leave;
+        }
+        if (pcb)
+            found++;
+    }
+    if (nb != found || found != PCB_NB_KEYS - PCB_NB_KEYS / 5) {
+        tst_error("Bulk lookup found %d PCBs, expected %d\n", nb, found);
+        goto leave;
+    }
+
+    /* IPv6 keys find no PCB */
+    for (int i = 0; i < PCB_NB_KEYS; i++)
+        pcbs[i] = &any;
+    nb = cnet_pcb_lookup_bulk(&hd, kp, PCB_NB_KEYS, pcbs, IPV6_TYPE);
+    for (int i = 0; i < PCB_NB_KEYS; i++) {
+        if (pcbs[i]) {
+            tst_error("IPv6 bulk lookup found a PCB for key %d\n", i);
+            goto leave;
+        }
+    }
+    if (nb) {
+        tst_error("IPv6 bulk lookup found %d PCBs\n", nb);
+        goto leave;
+    }
+
+    rc = 0;
+leave:
+    pcb_cleanup();
+    return rc;
+}
+
+/* A TCP/IP packet from faddr:fport to laddr:lport */
+static pktmbuf_t *
+pcb_pkt(pktmbuf_info_t *pi, uint32_t faddr, uint16_t fport, uint32_t laddr, uint16_t lport)
+{
+    pktmbuf_t *m = pktmbuf_alloc(pi);
+    tcpip4_t *tip;
+
+    if (!m)
+        return NULL;
+
+    tip = (tcpip4_t *)pktmbuf_append(m, sizeof(tcpip4_t));
+    memset(tip, 0, sizeof(tcpip4_t));
+    tip->ip4.src_addr = htobe32(faddr);
+    tip->ip4.dst_addr = htobe32(laddr);
+    tip->tcp.src_port = htobe16(fport);
+    tip->tcp.dst_port = htobe16(lport);
+
+    return m;
+}
+
+/*
+ * The PCBs of a burst are looked up in bulk before the first segment is processed, a
+ * segment is looked up again when an earlier segment opened or closed a connection.
+ */
+static int
+test_gen(void)
+{
+    struct pcb_key keys[4];
+    struct pcb_entry *pcbs[4];
+    pktmbuf_t *pkts[4] = {0};
+    pktmbuf_info_t *pi = NULL;
+    mmap_t *mm;
+    uint32_t gen;
+    int rc = -1;
+
+    mm = mmap_alloc(PCB_MBUF_COUNT, PCB_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+    pi = pktmbuf_pool_create(mmap_addr(mm), PCB_MBUF_COUNT, PCB_MBUF_SIZE, 0, NULL);
+    if (!pi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        goto leave;
+    }
+
+    if (pcb_setup(1))
+        goto leave;
+
+    /* The first and last segments to the connection, a SYN and its retransmit to the listener */
+    pkts[0] = pcb_pkt(pi, PCB_FADDR + 1, PCB_FPORT, PCB_LADDR, PCB_LPORT);
+    pkts[1] = pcb_pkt(pi, PCB_FADDR + 200, PCB_FPORT, PCB_LADDR, PCB_LPORT);
+    pkts[2] = pcb_pkt(pi, PCB_FADDR + 200, PCB_FPORT, PCB_LADDR, PCB_LPORT);
+    pkts[3] = pcb_pkt(pi, PCB_FADDR + 1, PCB_FPORT, PCB_LADDR, PCB_LPORT);
+    if (!pkts[0] || !pkts[1] || !pkts[2] || !pkts[3]) {
+        tst_error("pktmbuf_alloc() failed\n");
+        goto leave;
+    }
+
+    gen = tcp_input_bulk_lookup(&hd, pkts, 4, keys, pcbs);
+    if (gen != hd.gen || pcbs[0] != &conns[0] || pcbs[1] != &lsn || pcbs[2] != &lsn ||
+        pcbs[3] != &conns[0]) {
+        tst_error("Bulk lookup of the burst found the wrong PCBs\n");
+        goto leave;
+    }
+
+    /* Nothing changed, the PCB of the bulk lookup is used */
+    if (tcp_input_pcb(&hd, &keys[0], pcbs[0], gen) != &conns[0]) {
+        tst_error("PCB of the first segment changed\n");
+        goto leave;
+    }
+
+    /* The SYN opened a connection, its retransmit goes to the new PCB */
+    if (pcb_add(&extra, &keys[1]))
+        goto leave;
+    if (tcp_input_pcb(&hd, &keys[2], pcbs[2], gen) != &extra) {
+        tst_error("Segment not looked up again after a connection opened\n");
+        goto leave;
+    }
+
+    /* The connection was closed by a segment, its next segment goes to the listener */
+    cnet_pcb_unhash(&conns[0]);
+    if (tcp_input_pcb(&hd, &keys[3], pcbs[3], gen) != &lsn) {
+        tst_error("Segment not looked up again after a connection closed\n");
+        goto leave;
+    }
+
+    rc = 0;
+leave:
+    for (int i = 0; i < (int)CNE_DIM(pkts); i++)
+        pktmbuf_free(pkts[i]);
+    pcb_cleanup();
+    if (pi)
+        pktmbuf_destroy(pi);
+    mmap_free(mm);
+    return rc;
+}
+
+int
+pcb_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        int (*func)(void);
+    } tsts[] = {
+        {"PCB: hash", test_hash},
+        {"PCB: wildcard and listener", test_wildcard},
+        {"PCB: bulk lookup", test_bulk},
+        {"PCB: burst generation", test_gen},
+    };
+    // clang-format on
+    tst_info_t *tst;
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (tsts[i].func()) {
+            tst_end(tst, TST_FAILED);
+            return -1;
+        }
+        tst_end(tst, TST_PASSED);
+    }
+
+    return 0;
+}
@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _PCB_TEST_H_
+#define _PCB_TEST_H_
+
+int pcb_main(int argc, char **argv);
+
+#endif /* _PCB_TEST_H_ */
@@ -0,0 +1,364 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdio.h>               // for NULL, EOF
+#include <stdint.h>              // for uint32_t, uint64_t
+#include <stdbool.h>             // for bool, true, false
+#include <pthread.h>             // for pthread_create, pthread_join
+#include <getopt.h>              // for getopt_long, option
+#include <cne_common.h>          // for cne_countof, __cne_unused
+#include <cne_pause.h>           // for cne_pause
+#include <cne_rcu_qsbr.h>        // for cne_rcu_qsbr_create, cne_rcu_qsbr_dq_create
+#include <cne_hash.h>            // for cne_hash_create, cne_hash_rcu_qsbr_add
+#include <cne_jhash.h>           // for cne_jhash
+#include <tst_info.h>            // for tst_end, tst_start, TST_FAILED, TST_PASSED
+
+#include "rcu_test.h"
+
+#define RCU_TEST_THREADS 4
+#define RCU_TEST_DQ_SIZE 8
+#define RCU_TEST_KEYS    8
+
+static uint32_t freed_cnt;
+
+static int
+test_rcu_qsbr_check(void)
+{
+    struct cne_rcu_qsbr *v;
+    uint64_t t;
+
+    v = cne_rcu_qsbr_create(RCU_TEST_THREADS);
+    if (!v) {
+        tst_error("cne_rcu_qsbr_create() failed\n");
+        return -1;
+    }
+
+    if (cne_rcu_qsbr_thread_register(v, RCU_TEST_THREADS) == 0) {
+        tst_error("Registered an out of range thread ID\n");
+        goto err;
+    }
+
+    if (cne_rcu_qsbr_thread_register(v, 0) < 0 || cne_rcu_qsbr_thread_register(v, 1) < 0) {
+        tst_error("cne_rcu_qsbr_thread_register() failed\n");
+        goto err;
+    }
+    cne_rcu_qsbr_thread_online(v, 0);
+
+    /* Thread 0 is online and did not report a quiescent state yet */
+    t = cne_rcu_qsbr_start(v);
+    if (cne_rcu_qsbr_check(v, t, false) != 0) {
+        tst_error("Grace period ended before the reader was quiescent\n");
+        goto err;
+    }
+
+    /* Thread 1 is offline and does not hold the grace period */
+    cne_rcu_qsbr_quiescent(v, 0);
+    if (cne_rcu_qsbr_check(v, t, false) != 1) {
+        tst_error("Grace period did not end after the reader was quiescent\n");
+        goto err;
+    }
+
+    /* An offline reader does not hold the grace period either */
+    t = cne_rcu_qsbr_start(v);
+    cne_rcu_qsbr_thread_offline(v, 0);
+    if (cne_rcu_qsbr_check(v, t, false) != 1) {
+        tst_error("Grace period held by an offline reader\n");
+        goto err;
+    }
+
+    if (cne_rcu_qsbr_thread_unregister(v, 0) < 0 || cne_rcu_qsbr_thread_unregister(v, 1) < 0) {
+        tst_error("cne_rcu_qsbr_thread_unregister() failed\n");
+        goto err;
+    }
+
+    cne_rcu_qsbr_destroy(v);
+    return 0;
+err:
+    cne_rcu_qsbr_destroy(v);
+    return -1;
+}
+
+struct reader_arg {
+    struct cne_rcu_qsbr *v;
+    uint32_t id;
+    volatile bool stop;
+};
+
+static void *
+reader_thread(void *arg)
+{
+    struct reader_arg *ra = arg;
+
+    cne_rcu_qsbr_thread_online(ra->v, ra->id);
+    while (!ra->stop) {
+        cne_rcu_qsbr_quiescent(ra->v, ra->id);
+        cne_pause();
+    }
+    cne_rcu_qsbr_thread_offline(ra->v, ra->id);
+
+    return NULL;
+}
+
+static int
+test_rcu_qsbr_synchronize(void)
+{
+    struct reader_arg ra[RCU_TEST_THREADS - 1] = {0};
+    pthread_t tid[RCU_TEST_THREADS - 1];
+    struct cne_rcu_qsbr *v;
+    int i, ret = 0;
+
+    v = cne_rcu_qsbr_create(RCU_TEST_THREADS);
+    if (!v) {
+        tst_error("cne_rcu_qsbr_create() failed\n");
+        return -1;
+    }
+
+    for (i = 0; i < (int)cne_countof(ra); i++) {
+        ra[i].v  = v;
+        ra[i].id = i + 1;
+        cne_rcu_qsbr_thread_register(v, ra[i].id);
+        if (pthread_create(&tid[i], NULL, reader_thread, &ra[i])) {
+            tst_error("pthread_create() failed\n");
+            ret = -1;
+            break;
+        }
+    }
+
+    /* The writer is also a reader, its own counter must not block it */
+    cne_rcu_qsbr_thread_register(v, 0);
+    cne_rcu_qsbr_thread_online(v, 0);
+    for (int k = 0; k < 1000 && ret == 0; k++)
+        cne_rcu_qsbr_synchronize(v, 0);
+    cne_rcu_qsbr_thread_offline(v, 0);
+
+    while (--i >= 0) {
+        ra[i].stop = true;
+        pthread_join(tid[i], NULL);
+    }
+
+    cne_rcu_qsbr_destroy(v);
+    return ret;
+}
+
+static void
+count_free(void *p __cne_unused, void *e __cne_unused, unsigned int n)
+{
+    freed_cnt += n;
+}
+
+static int
+test_rcu_qsbr_dq(void)
+{
+    struct cne_rcu_qsbr_dq_parameters params = {0};
+    struct cne_rcu_qsbr_dq *dq               = NULL;
+    unsigned int freed, pending, available;
+    struct cne_rcu_qsbr *v;
+    uint64_t e;
+
+    v = cne_rcu_qsbr_create(RCU_TEST_THREADS);
+    if (!v) {
+        tst_error("cne_rcu_qsbr_create() failed\n");
+        return -1;
+    }
+    cne_rcu_qsbr_thread_register(v, 0);
+    cne_rcu_qsbr_thread_online(v, 0);
+
+    params.name                  = "rcu-test";
+    params.size                  = RCU_TEST_DQ_SIZE;
+    params.esize                 = sizeof(uint64_t);
+    params.trigger_reclaim_limit = RCU_TEST_DQ_SIZE;
+    params.max_reclaim_size      = RCU_TEST_DQ_SIZE;
+    params.free_fn               = count_free;
+    params.v                     = v;
+
+    dq = cne_rcu_qsbr_dq_create(&params);
+    if (!dq) {
+        tst_error("cne_rcu_qsbr_dq_create() failed\n");
+        goto err;
+    }
+
+    freed_cnt = 0;
+    for (e = 0; e < RCU_TEST_DQ_SIZE / 2; e++) {
+        if (cne_rcu_qsbr_dq_enqueue(dq, &e) < 0) {
+            tst_error("cne_rcu_qsbr_dq_enqueue() failed\n");
+            goto err;
+        }
+    }
+
+    /* The reader did not report a quiescent state, nothing can be freed */
+    if (cne_rcu_qsbr_dq_reclaim(dq, RCU_TEST_DQ_SIZE, &freed, &pending, &available) < 0 ||
+        freed != 0 || pending != RCU_TEST_DQ_SIZE / 2 || freed_cnt != 0) {
+        tst_error("Elements freed during the grace period\n");
+        goto err;
+    }
+
+    cne_rcu_qsbr_quiescent(v, 0);
+    if (cne_rcu_qsbr_dq_reclaim(dq, RCU_TEST_DQ_SIZE, &freed, &pending, &available) < 0 ||
+        freed != RCU_TEST_DQ_SIZE / 2 || pending != 0 || freed_cnt != RCU_TEST_DQ_SIZE / 2 ||
+        available < RCU_TEST_DQ_SIZE) {
+        tst_error("Freed %u pending %u available %u elements\n", freed, pending, available);
+        goto err;
+    }
+
+    /* Fill the queue, the next enqueue fails while the reader holds the grace period */
+    for (e = 0; e < RCU_TEST_DQ_SIZE; e++)
+        cne_rcu_qsbr_dq_enqueue(dq, &e);
+    if (cne_rcu_qsbr_dq_enqueue(dq, &e) == 0) {
+        tst_error("Enqueued into a full defer queue\n");
+        goto err;
+    }
+
+    /* The queue is full and reclaims on enqueue once the reader is quiescent */
+    cne_rcu_qsbr_quiescent(v, 0);
+    if (cne_rcu_qsbr_dq_enqueue(dq, &e) < 0) {
+        tst_error("cne_rcu_qsbr_dq_enqueue() did not reclaim\n");
+        goto err;
+    }
+
+    /* Delete frees the elements still in their grace period once the reader is done */
+    if (cne_rcu_qsbr_dq_reclaim(dq, RCU_TEST_DQ_SIZE, &freed, &pending, &available) < 0 ||
+        pending == 0) {
+        tst_error("No element pending in the defer queue\n");
+        goto err;
+    }
+    freed_cnt = 0;
+    cne_rcu_qsbr_thread_offline(v, 0);
+    if (cne_rcu_qsbr_dq_delete(dq) < 0 || freed_cnt != pending) {
+        tst_error("cne_rcu_qsbr_dq_delete() freed %u of %u elements\n", freed_cnt, pending);
+        dq = NULL;
+        goto err;
+    }
+
+    cne_rcu_qsbr_destroy(v);
+    return 0;
+err:
+    cne_rcu_qsbr_thread_offline(v, 0);
+    cne_rcu_qsbr_dq_delete(dq);
+    cne_rcu_qsbr_destroy(v);
+    return -1;
+}
+
+static void
+count_key_data_free(void *p __cne_unused, void *key_data __cne_unused)
+{
+    freed_cnt++;
+}
+
+static int
+test_rcu_qsbr_hash(void)
+{
+    struct cne_hash_parameters hp = {
+        .name      = "rcu-hash",
+        .entries   = RCU_TEST_KEYS,
+        .key_len   = sizeof(uint32_t),
+        .hash_func = cne_jhash,
+    };
+    struct cne_hash_rcu_config cfg = {0};
+    struct cne_hash *h             = NULL;
+    struct cne_rcu_qsbr *v;
+    uint32_t key;
+
+    v = cne_rcu_qsbr_create(RCU_TEST_THREADS);
+    if (!v) {
+        tst_error("cne_rcu_qsbr_create() failed\n");
+        return -1;
+    }
+    cne_rcu_qsbr_thread_register(v, 0);
+    cne_rcu_qsbr_thread_online(v, 0);
+
+    h = cne_hash_create(&hp);
+    if (!h) {
+        tst_error("cne_hash_create() failed\n");
+        goto err;
+    }
+
+    /* Reclaim on every delete, the entries freed so far are counted */
+    cfg.v                  = v;
+    cfg.mode               = CNE_HASH_QSBR_MODE_DQ;
+    cfg.free_key_data_func = count_key_data_free;
+    if (cne_hash_rcu_qsbr_add(h, &cfg) < 0) {
+        tst_error("cne_hash_rcu_qsbr_add() failed\n");
+        goto err;
+    }
+    if (cne_hash_rcu_qsbr_add(h, &cfg) == 0) {
+        tst_error("cne_hash_rcu_qsbr_add() added twice\n");
+        goto err;
+    }
+
+    for (key = 0; key < 2; key++) {
+        if (cne_hash_add_key_data(h, &key, (void *)(uintptr_t)(key + 1)) < 0) {
+            tst_error("cne_hash_add_key_data() failed\n");
+            goto err;
+        }
+    }
+
+    freed_cnt = 0;
+    key       = 0;
+    if (cne_hash_del_key(h, &key) < 0 || freed_cnt != 0) {
+        tst_error("Deleted key freed during the grace period\n");
+        goto err;
+    }
+
+    /* The reader is done with key 0, deleting key 1 reclaims it */
+    cne_rcu_qsbr_quiescent(v, 0);
+    key = 1;
+    if (cne_hash_del_key(h, &key) < 0 || freed_cnt != 1) {
+        tst_error("Deleted key not freed after the grace period, freed %u\n", freed_cnt);
+        goto err;
+    }
+
+    /* Key 1 is freed with the hash once the reader is done with it */
+    cne_rcu_qsbr_quiescent(v, 0);
+    cne_hash_free(h);
+    cne_rcu_qsbr_thread_offline(v, 0);
+    cne_rcu_qsbr_destroy(v);
+    return 0;
+err:
+    cne_rcu_qsbr_thread_offline(v, 0);
+    cne_hash_free(h);
+    cne_rcu_qsbr_destroy(v);
+    return -1;
+}
+
+int
+rcu_main(int argc, char **argv)
+{
+    tst_info_t *tst;
+    int opt;
+    char **argvopt;
+    int option_index;
+    static const struct option lgopts[] = {{NULL, 0, 0, 0}};
+
+    argvopt = argv;
+
+    while ((opt = getopt_long(argc, argvopt, "v", lgopts, &option_index)) != EOF) {
+        switch (opt) {
+        case 'v':
+            break;
+        default:
+            break;
+        }
+    }
+
+    tst = tst_start("RCU QSBR");
+
+    if (test_rcu_qsbr_check() < 0)
+        goto leave;
+
+    if (test_rcu_qsbr_synchronize() < 0)
+        goto leave;
+
+    if (test_rcu_qsbr_dq() < 0)
+        goto leave;
+
+    if (test_rcu_qsbr_hash() < 0)
+        goto leave;
+
+    tst_end(tst, TST_PASSED);
+
+    return 0;
+leave:
+    tst_end(tst, TST_FAILED);
+    return -1;
+}
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _RCU_TEST_H_
+#define _RCU_TEST_H_
+
+/**
+ * @file
+ * CNE RCU QSBR Test
+ *
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int rcu_main(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RCU_TEST_H_ */
@@ -0,0 +1,308 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <inttypes.h>        // for PRIu64
+#include <stdint.h>          // for uint64_t, uint32_t
+#include <string.h>          // for memset
+
+#include <cne_common.h>          // for __cne_unused, CNE_DIM
+#include <cnet_tcp.h>            // for tcb_entry, tcp_cc_select, TCPS_ESTABLISHED
+#include <cnet_tcp_cc.h>         // for tcp_cc_find, tcp_cc_reno, tcp_cc_cubic
+#include <tcp_cubic_priv.h>      // for cubic, cubic_cbrt, cubic_k, cubic_w
+#include <tst_info.h>            // for tst_start, tst_end, tst_error
+
+#include "tcp_cc_test.h"
+
+#define CC_MSS 1000
+
+/* Difference of two values, the expected values of the RFC8312 formulas are not integers */
+static inline uint64_t
+cc_diff(uint64_t a, uint64_t b)
+{
+    return (a > b) ? a - b : b - a;
+}
+
+static void
+cc_tcb_init(struct tcb_entry *tcb, tcb_state_t state, uint32_t cwnd, uint32_t ssthresh)
+{
+    memset(tcb, 0, sizeof(*tcb));
+    tcb->state        = state;
+    tcb->max_mss      = CC_MSS;
+    tcb->snd_wnd      = TCP_MAXWIN;
+    tcb->snd_cwnd     = cwnd;
+    tcb->snd_ssthresh = ssthresh;
+}
+
+/* The cube root is the largest y with y^3 <= a */
+static int
+test_cbrt(void)
+{
+    // clang-format off
+    struct {
+        uint64_t a;
+        uint32_t root;
+    } tbl[] = {
+        {0, 0}, {1, 1}, {7, 1}, {8, 2}, {26, 2}, {27, 3}, {999, 9}, {1000, 10},
+        {999999, 99}, {1000000, 100}, {(1ULL << 63) - 1, 2097151}, {UINT64_MAX, 2642245},
+    };
+    // clang-format on
+
+    for (int i = 0; i < (int)CNE_DIM(tbl); i++) {
+        if (cubic_cbrt(tbl[i].a) != tbl[i].root) {
+            tst_error("cubic_cbrt(%" PRIu64 ") is %u, not %u\n", tbl[i].a, cubic_cbrt(tbl[i].a),
+                      tbl[i].root);
+            return -1;
+        }
+    }
+
+    for (uint64_t a = 1; a < (1ULL << 62); a = a * 3 + 1) {
+        uint64_t y = cubic_cbrt(a);
+
+        if ((y * y * y) > a || ((y + 1) * (y + 1) * (y + 1)) <= a) {
+            tst_error("cubic_cbrt(%" PRIu64 ") is %" PRIu64 "\n", a, y);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * RFC8312 equation 2, K = cubic_root(W_max * (1 - beta_cubic) / C) in seconds, with W_max in
+ * segments and cwnd reduced to W_max * beta_cubic.
+ */
+static int
+test_k(void)
+{
+    // clang-format off
+    struct {
+        uint32_t w_max; /* segments */
+        uint32_t k;     /* milli-seconds */
+    } tbl[] = {
+        {10, 1957}, {100, 4217}, {1000, 9085}, {10000, 19574},
+    };
+    // clang-format on
+
+    for (int i = 0; i < (int)CNE_DIM(tbl); i++) {
+        uint32_t w_max = tbl[i].w_max * CC_MSS;
+        uint32_t k     = cubic_k(w_max, (w_max / 10) * 7, CC_MSS);
+
+        if (cc_diff(k, tbl[i].k) > 1) {
+            tst_error("K of W_max %u is %u ms, not %u ms\n", tbl[i].w_max, k, tbl[i].k);
+            return -1;
+        }
+    }
+
+    /* A cwnd at W_max has no time to grow */
+    if (cubic_k(100 * CC_MSS, 100 * CC_MSS, CC_MSS) != 0) {
+        tst_error("K of a cwnd at W_max is not zero\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/* RFC8312 equation 1, W_cubic(t) = C * (t - K)^3 + W_max with W_max of 100 segments */
+static int
+test_w_cubic(void)
+{
+    // clang-format off
+    struct {
+        int32_t t_k;  /* t - K in milli-seconds */
+        uint32_t w;   /* bytes */
+    } tbl[] = {
+        {-4000, 74400}, {-2000, 96800}, {-1000, 99600}, {0, 100000},
+        {1000, 100400}, {2000, 103200}, {5000, 150000}, {10000, 500000},
+    };
+    // clang-format on
+    uint32_t w_max = 100 * CC_MSS;
+    uint32_t k     = cubic_k(w_max, (w_max / 10) * 7, CC_MSS);
+    uint64_t w;
+
+    /* The window starts the epoch at the reduced cwnd, within the K rounded to a milli-second */
+    w = cubic_w(w_max, k, 0, CC_MSS);
+    if (cc_diff(w, 70000) > 70) {
+        tst_error("W_cubic(0) is %" PRIu64 ", not 70000\n", w);
+        return -1;
+    }
+
+    for (int i = 0; i < (int)CNE_DIM(tbl); i++) {
+        w = cubic_w(w_max, k, (uint64_t)((int64_t)k + tbl[i].t_k), CC_MSS);
+
+        if (cc_diff(w, tbl[i].w) > 2) {
+            tst_error("W_cubic(K %+d ms) is %" PRIu64 ", not %u\n", tbl[i].t_k, w, tbl[i].w);
+            return -1;
+        }
+    }
+
+    /* W_cubic stops growing CUBIC_MAX_DELTA milli-seconds from K */
+    if (cubic_w(w_max, k, k + CUBIC_MAX_DELTA, CC_MSS) !=
+        cubic_w(w_max, k, k + 2 * CUBIC_MAX_DELTA, CC_MSS)) {
+        tst_error("W_cubic is not capped at CUBIC_MAX_DELTA\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * RFC8312 equation 4, W_est grows by alpha_aimd = 3 * (1 - beta_cubic) / (1 + beta_cubic)
+ * segments per window of segments acked.
+ */
+static int
+test_w_est(void)
+{
+    // clang-format off
+    struct {
+        uint32_t acked;
+        uint32_t cwnd;
+        uint32_t incr; /* alpha_aimd * acked * SMSS / cwnd */
+    } tbl[] = {
+        {1000, 10000, 53}, {1000, 100000, 5}, {10000, 10000, 529}, {100000, 100000, 529},
+        {2000, 50000, 21},
+    };
+    // clang-format on
+
+    for (int i = 0; i < (int)CNE_DIM(tbl); i++) {
+        uint32_t incr = cubic_w_est_incr(tbl[i].acked, CC_MSS, tbl[i].cwnd);
+
+        if (cc_diff(incr, tbl[i].incr) > 1) {
+            tst_error("W_est of %u acked with cwnd %u grows by %u, not %u\n", tbl[i].acked,
+                      tbl[i].cwnd, incr, tbl[i].incr);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* RFC8312 section 4.5 and 4.6, multiplicative decrease and fast convergence */
+static int
+test_loss(void)
+{
+    struct tcb_entry tcb;
+    struct cubic *cu = (struct cubic *)tcb.cc_priv;
+
+    cc_tcb_init(&tcb, TCPS_ESTABLISHED, 100000, 50000);
+    tcp_cc_select(&tcb, &tcp_cc_cubic);
+
+    /* ssthresh = cwnd * beta_cubic, W_max = cwnd */
+    tcb.cc->on_loss(&tcb);
+    if (cc_diff(tcb.snd_ssthresh, 70000) > 100 || cu->w_max != 100000 || cu->epoch != 0) {
+        tst_error("Loss at cwnd 100000 sets ssthresh %u and W_max %u\n", tcb.snd_ssthresh,
+                  cu->w_max);
+        return -1;
+    }
+
+    /* Below the last W_max, W_max = cwnd * (1 + beta_cubic) / 2 */
+    tcb.snd_cwnd = 80000;
+    tcb.cc->on_loss(&tcb);
+    if (cc_diff(cu->w_max, 68000) > 100 || cu->w_last_max != 80000 ||
+        cc_diff(tcb.snd_ssthresh, 56000) > 100) {
+        tst_error("Loss at cwnd 80000 sets ssthresh %u and W_max %u\n", tcb.snd_ssthresh,
+                  cu->w_max);
+        return -1;
+    }
+
+    /* ssthresh is at least 2 * SMSS and a timeout restarts from one segment */
+    tcb.snd_cwnd = 2 * CC_MSS;
+    tcb.cc->on_rto(&tcb);
+    if (tcb.snd_ssthresh != 2 * CC_MSS || tcb.snd_cwnd != CC_MSS) {
+        tst_error("Timeout sets ssthresh %u and cwnd %u\n", tcb.snd_ssthresh, tcb.snd_cwnd);
+        return -1;
+    }
+
+    /* Slow start below ssthresh grows as Reno */
+    tcb.cc->on_ack(&tcb, CC_MSS);
+    if (tcb.snd_cwnd != 2 * CC_MSS || cu->epoch != 0) {
+        tst_error("Slow start grows cwnd to %u\n", tcb.snd_cwnd);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* The algorithms are found by the name given to TCP_CONGESTION and switched per TCB */
+static int
+test_select(void)
+{
+    struct tcb_entry tcb;
+    uint64_t rate;
+
+    if (tcp_cc_find("reno") != &tcp_cc_reno || tcp_cc_find("cubic") != &tcp_cc_cubic ||
+        tcp_cc_find(TCP_CC_DEFAULT) != &tcp_cc_reno || tcp_cc_find("bbr") != NULL ||
+        tcp_cc_find("") != NULL || tcp_cc_find(NULL) != NULL) {
+        tst_error("tcp_cc_find() does not find the algorithms by name\n");
+        return -1;
+    }
+
+    /* A TCB not yet established starts with the initial window of the algorithm */
+    cc_tcb_init(&tcb, TCPS_CLOSED, 0, 0);
+    tcp_cc_select(&tcb, tcp_cc_find("cubic"));
+    if (tcb.cc != &tcp_cc_cubic || tcb.snd_cwnd != CC_MSS || tcb.snd_ssthresh != 2 * CC_MSS) {
+        tst_error("New TCB has cwnd %u and ssthresh %u\n", tcb.snd_cwnd, tcb.snd_ssthresh);
+        return -1;
+    }
+
+    /* An established TCB keeps its window and drops the state of the previous algorithm */
+    cc_tcb_init(&tcb, TCPS_ESTABLISHED, 100000, 50000);
+    tcp_cc_select(&tcb, &tcp_cc_cubic);
+    tcb.cc->on_loss(&tcb);
+    tcp_cc_select(&tcb, tcp_cc_find("reno"));
+    if (tcb.cc != &tcp_cc_reno || tcb.snd_cwnd != 100000 || ((struct cubic *)tcb.cc_priv)->w_max) {
+        tst_error("Switched TCB has cwnd %u\n", tcb.snd_cwnd);
+        return -1;
+    }
+
+    /* Pacing at 1.2 cwnd per RTT, 2 cwnd per RTT in slow start, srtt of 500 ms */
+    tcb.srtt = 1 << TCP_RTT_SHIFT;
+    rate     = tcb.cc->pacing_rate(&tcb);
+    if (rate != 240000) {
+        tst_error("Pacing rate is %" PRIu64 ", not 240000\n", rate);
+        return -1;
+    }
+    tcb.snd_ssthresh = 200000;
+    rate             = tcb.cc->pacing_rate(&tcb);
+    if (rate != 400000) {
+        tst_error("Slow start pacing rate is %" PRIu64 ", not 400000\n", rate);
+        return -1;
+    }
+    tcb.srtt = 0;
+    if (tcb.cc->pacing_rate(&tcb) != 0) {
+        tst_error("Pacing rate without an RTT is not zero\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int
+tcp_cc_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        int (*func)(void);
+    } tsts[] = {
+        {"TCP_CC: cubic root", test_cbrt},
+        {"TCP_CC: CUBIC K", test_k},
+        {"TCP_CC: CUBIC W_cubic", test_w_cubic},
+        {"TCP_CC: CUBIC W_est", test_w_est},
+        {"TCP_CC: CUBIC loss", test_loss},
+        {"TCP_CC: select algorithm", test_select},
+    };
+    // clang-format on
+    tst_info_t *tst;
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (tsts[i].func()) {
+            tst_end(tst, TST_FAILED);
+            return -1;
+        }
+        tst_end(tst, TST_PASSED);
+    }
+
+    return 0;
+}
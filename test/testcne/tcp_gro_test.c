@@ -0,0 +1,684 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <endian.h>            // for htobe16, htobe32, be32toh
+#include <netinet/in.h>        // for IPPROTO_TCP
+#include <stdint.h>            // for uint32_t, uint16_t, uint8_t
+#include <string.h>            // for memset, memcpy
+
+#include <cne_common.h>          // for __cne_unused, CNE_DIM
+#include <cne_mmap.h>            // for mmap_alloc, mmap_addr, mmap_free
+#include <cne_vec.h>             // for vec_alloc, vec_inc_len, vec_free
+#include <pktmbuf.h>             // for pktmbuf_t, pktmbuf_alloc, pktmbuf_free
+#include <net/cne_ip.h>          // for cne_ipv4_hdr, cne_ipv4_cksum, cne_ipv4_udptcp_cksum
+#include <net/cne_tcp.h>         // for cne_tcp_hdr, TCP_ACK_FLAG, TCP_PSH_FLAG
+#include <cnet_stk.h>            // for stk_t, this_stk
+#include <cnet_meta.h>           // for cnet_metadata
+#include <cnet_pcb.h>            // for pcb_entry
+#include <cnet_tcp.h>            // for tcb_entry, tcp_entry, tcp_stats_t, TCPS_ESTABLISHED
+#include <chnl_priv.h>           // for chnl
+#include <tcp_input_priv.h>      // for TCP_INPUT_CONSUMED, TCP_INPUT_NEXT_CHNL_RECV
+#include <tcp_gro_priv.h>        // for tcp_gro_merge, tcp_gro_flush, tcp_gro_split
+#include <tst_info.h>            // for tst_start, tst_end, tst_error
+
+#include "tcp_gro_test.h"
+
+#define GRO_MBUF_COUNT 128
+#define GRO_MBUF_SIZE  (2 * 1024)
+#define GRO_MSS        1400
+#define GRO_SEG_LEN    100
+#define GRO_MAX_SEGS   64
+#define GRO_ISS        0x10000000U
+
+/* all tests use the same pktmbuf pool */
+static pktmbuf_info_t *pi;
+static mmap_t *mm;
+
+static stk_t stk;
+static tcp_stats_t stats;
+static struct tcp_entry tcp;
+static struct tcb_entry tcb;
+static struct pcb_entry pcb;
+static struct chnl ch;
+
+/* Header fields of a test segment, a zero timestamp sends no timestamp option */
+struct gro_seg {
+    uint32_t seq;
+    uint16_t len;
+    uint8_t flags;
+    uint8_t ttl;
+    uint16_t win;
+    uint16_t sport;
+    uint32_t ack;
+    uint32_t tsval;
+};
+
+static int
+alloc_pool(void)
+{
+    mm = mmap_alloc(GRO_MBUF_COUNT, GRO_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), GRO_MBUF_COUNT, GRO_MBUF_SIZE, 0, NULL);
+    if (!pi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        mmap_free(mm);
+        mm = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+free_pool(void)
+{
+    if (pi)
+        pktmbuf_destroy(pi);
+    pi = NULL;
+
+    if (mm)
+        mmap_free(mm);
+    mm = NULL;
+}
+
+/* A segment of the default flow with <len> data bytes at <seq> */
+static inline struct gro_seg
+gro_seg(uint32_t seq, uint16_t len, uint8_t flags)
+{
+    struct gro_seg s = {.seq   = seq,
+                        .len   = len,
+                        .flags = flags,
+                        .ttl   = 64,
+                        .win   = 1024,
+                        .sport = 5000,
+                        .ack   = 1,
+                        .tsval = 100};
+
+    return s;
+}
+
+/* Build the IPv4 and TCP segment as received by the tcp_gro node, the data starts at IPv4 */
+static pktmbuf_t *
+gro_pkt(const struct gro_seg *s)
+{
+    uint16_t hlen = sizeof(struct cne_tcp_hdr) + (s->tsval ? 12 : 0);
+    struct cne_ipv4_hdr *ip;
+    struct cne_tcp_hdr *th;
+    pktmbuf_t *m;
+    uint8_t *p;
+
+    m = pktmbuf_alloc(pi);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        return NULL;
+    }
+    memset(pktmbuf_metadata(m), 0, sizeof(struct cnet_metadata));
+
+    ip = (struct cne_ipv4_hdr *)pktmbuf_append(m, sizeof(*ip) + hlen + s->len);
+    memset(ip, 0, sizeof(*ip) + hlen);
+    ip->version_ihl   = CNE_IPV4_VHL_DEF;
+    ip->total_length  = htobe16(sizeof(*ip) + hlen + s->len);
+    ip->time_to_live  = s->ttl;
+    ip->next_proto_id = IPPROTO_TCP;
+    ip->src_addr      = htobe32(0xC0A80001);
+    ip->dst_addr      = htobe32(0xC0A80002);
+    ip->hdr_checksum  = cne_ipv4_cksum(ip);
+
+    th            = (struct cne_tcp_hdr *)(ip + 1);
+    th->src_port  = htobe16(s->sport);
+    th->dst_port  = htobe16(80);
+    th->sent_seq  = htobe32(s->seq);
+    th->recv_ack  = htobe32(s->ack);
+    th->data_off  = (hlen / 4) << 4;
+    th->tcp_flags = s->flags;
+    th->rx_win    = htobe16(s->win);
+
+    p = (uint8_t *)(th + 1);
+    if (s->tsval) {
+        uint32_t tsval = htobe32(s->tsval);
+
+        p[0] = 1; /* NOP */
+        p[1] = 1; /* NOP */
+        p[2] = 8; /* Timestamp */
+        p[3] = 10;
+        memcpy(&p[4], &tsval, sizeof(tsval));
+        p += 12;
+    }
+    for (uint16_t i = 0; i < s->len; i++)
+        p[i] = (uint8_t)(s->seq + i);
+
+    th->cksum = cne_ipv4_udptcp_cksum(ip, th);
+    m->l3_len = sizeof(*ip);
+
+    return m;
+}
+
+static inline uint32_t
+gro_seq(pktmbuf_t *m)
+{
+    struct cne_tcp_hdr *th = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, m->l3_len);
+
+    return be32toh(th->sent_seq);
+}
+
+static inline pktmbuf_t *
+gro_next(pktmbuf_t *m)
+{
+    struct cnet_metadata *md = pktmbuf_metadata(m);
+
+    return md->gro_next;
+}
+
+/*
+ * Merge the segments like the tcp_gro node, the segments left in the burst are in <pkts>.
+ * Returns the number of segments left or -1 on error.
+ */
+static int
+gro_burst(const struct gro_seg *segs, int nb, pktmbuf_t **pkts)
+{
+    struct tcp_gro_flow flows[TCP_GRO_MAX_FLOWS];
+    uint16_t nb_flows = 0;
+    int n             = 0;
+
+    for (int i = 0; i < nb; i++) {
+        pktmbuf_t *m = gro_pkt(&segs[i]);
+
+        if (!m) {
+            while (nb_flows)
+                tcp_gro_flush(flows, &nb_flows, &flows[0]);
+            for (int j = 0; j < n; j++)
+                tcp_gro_free(pkts[j]);
+            return -1;
+        }
+        if (!tcp_gro_merge(flows, &nb_flows, m))
+            pkts[n++] = m;
+    }
+
+    while (nb_flows)
+        tcp_gro_flush(flows, &nb_flows, &flows[0]);
+
+    return n;
+}
+
+/*
+ * The segment <m> holds <nb_segs> segments merged from <seq> with <len> data bytes in all.
+ * The IPv4 header carries the merged length with a valid header checksum.
+ */
+static int
+gro_check(pktmbuf_t *m, uint32_t seq, uint32_t nb_segs, uint32_t len)
+{
+    struct cne_ipv4_hdr *ip = pktmbuf_mtod(m, struct cne_ipv4_hdr *);
+    struct cne_tcp_hdr *th  = (struct cne_tcp_hdr *)(ip + 1);
+    uint32_t hlen           = sizeof(*ip) + ((th->data_off & 0xF0) >> 2);
+    uint32_t n              = 0;
+
+    if (be16toh(ip->total_length) != hlen + len || cne_ipv4_cksum(ip) != 0) {
+        tst_error("Merged segment at %u has total length %u and checksum %04x, expected %u\n",
+                  seq - GRO_ISS, be16toh(ip->total_length), be16toh(ip->hdr_checksum), hlen + len);
+        return -1;
+    }
+
+    for (; m; m = gro_next(m), n++) {
+        th = pktmbuf_mtod_offset(m, struct cne_tcp_hdr *, m->l3_len);
+
+        if (gro_seq(m) != seq) {
+            tst_error("Segment %u of the merged segment is at %u, expected %u\n", n,
+                      gro_seq(m) - GRO_ISS, seq - GRO_ISS);
+            return -1;
+        }
+        seq += pktmbuf_data_len(m) - m->l3_len - ((th->data_off & 0xF0) >> 2);
+    }
+
+    if (n != nb_segs) {
+        tst_error("Merged segment holds %u segments, expected %u\n", n, nb_segs);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+gro_free(pktmbuf_t **pkts, int n)
+{
+    for (int i = 0; i < n; i++)
+        tcp_gro_free(pkts[i]);
+}
+
+/* In order segments are merged, a PSH ends the merged segment, out of order ones flush it */
+static int
+test_merge(void)
+{
+    pktmbuf_t *pkts[GRO_MAX_SEGS];
+    struct gro_seg segs[8];
+    int n;
+
+    /* Four in order segments are merged in the first one */
+    for (int i = 0; i < 4; i++)
+        segs[i] = gro_seg(GRO_ISS + i * GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+    stats.S_rx_gro = 0;
+    if ((n = gro_burst(segs, 4, pkts)) < 0)
+        return -1;
+    if (n != 1 || gro_check(pkts[0], GRO_ISS, 4, 4 * GRO_SEG_LEN) || stats.S_rx_gro != 3) {
+        tst_error("In order segments not merged, %d segments left\n", n);
+        gro_free(pkts, n);
+        return -1;
+    }
+    gro_free(pkts, n);
+
+    /* A PSH is merged and ends the merged segment, the next segment starts another one */
+    segs[1].flags |= TCP_PSH_FLAG;
+    if ((n = gro_burst(segs, 4, pkts)) < 0)
+        return -1;
+    if (n != 2 || gro_check(pkts[0], GRO_ISS, 2, 2 * GRO_SEG_LEN) ||
+        gro_check(pkts[1], GRO_ISS + 2 * GRO_SEG_LEN, 2, 2 * GRO_SEG_LEN)) {
+        tst_error("PSH does not end the merged segment, %d segments left\n", n);
+        gro_free(pkts, n);
+        return -1;
+    }
+    gro_free(pkts, n);
+
+    /* A gap or a retransmit flushes the merged segment and starts the next one */
+    segs[0] = gro_seg(GRO_ISS, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[1] = gro_seg(GRO_ISS + 2 * GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[2] = gro_seg(GRO_ISS + 3 * GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[3] = gro_seg(GRO_ISS, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[4] = gro_seg(GRO_ISS + GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+    if ((n = gro_burst(segs, 5, pkts)) < 0)
+        return -1;
+    if (n != 3 || gro_check(pkts[0], GRO_ISS, 1, GRO_SEG_LEN) ||
+        gro_check(pkts[1], GRO_ISS + 2 * GRO_SEG_LEN, 2, 2 * GRO_SEG_LEN) ||
+        gro_check(pkts[2], GRO_ISS, 2, 2 * GRO_SEG_LEN)) {
+        tst_error("Out of order segment does not flush the merged segment, %d left\n", n);
+        gro_free(pkts, n);
+        return -1;
+    }
+    gro_free(pkts, n);
+
+    /* Segments of other flows are merged apart, a FIN or a segment without data is not */
+    segs[0] = gro_seg(GRO_ISS, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[1] = gro_seg(GRO_ISS + 5000, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[2] = gro_seg(GRO_ISS + GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[3] = gro_seg(GRO_ISS + 5000 + GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+    segs[4] = gro_seg(GRO_ISS + 2 * GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG | TCP_FIN_FLAG);
+    segs[5] = gro_seg(GRO_ISS + 5000 + 2 * GRO_SEG_LEN, 0, TCP_ACK_FLAG);
+    segs[1].sport = segs[3].sport = segs[5].sport = 5001;
+    if ((n = gro_burst(segs, 6, pkts)) < 0)
+        return -1;
+    if (n != 4 || gro_check(pkts[0], GRO_ISS, 2, 2 * GRO_SEG_LEN) ||
+        gro_check(pkts[1], GRO_ISS + 5000, 2, 2 * GRO_SEG_LEN) ||
+        gro_check(pkts[2], GRO_ISS + 2 * GRO_SEG_LEN, 1, GRO_SEG_LEN) ||
+        gro_check(pkts[3], GRO_ISS + 5000 + 2 * GRO_SEG_LEN, 1, 0)) {
+        tst_error("Flows are not merged apart, %d segments left\n", n);
+        gro_free(pkts, n);
+        return -1;
+    }
+    gro_free(pkts, n);
+
+    return 0;
+}
+
+/* A segment with other headers or TCP options than the merged segment is not merged */
+static int
+test_mismatch(void)
+{
+    pktmbuf_t *pkts[GRO_MAX_SEGS];
+    struct gro_seg segs[2];
+    int n;
+
+    for (int i = 0; i < 5; i++) {
+        segs[0] = gro_seg(GRO_ISS, GRO_SEG_LEN, TCP_ACK_FLAG);
+        segs[1] = gro_seg(GRO_ISS + GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+
+        switch (i) {
+        case 0:
+            segs[1].ack++;
+            break;
+        case 1:
+            segs[1].win++;
+            break;
+        case 2:
+            segs[1].ttl--;
+            break;
+        case 3:
+            segs[1].tsval++;
+            break;
+        default:
+            segs[1].tsval = 0;
+            break;
+        }
+
+        if ((n = gro_burst(segs, 2, pkts)) < 0)
+            return -1;
+        if (n != 2 || gro_check(pkts[0], GRO_ISS, 1, GRO_SEG_LEN) ||
+            gro_check(pkts[1], GRO_ISS + GRO_SEG_LEN, 1, GRO_SEG_LEN)) {
+            tst_error("Segment with different headers %d is merged\n", i);
+            gro_free(pkts, n);
+            return -1;
+        }
+        gro_free(pkts, n);
+    }
+
+    return 0;
+}
+
+/* The IPv4 total length of a merged segment is at most TCP_GRO_MAX_LEN */
+static int
+test_max_len(void)
+{
+    struct gro_seg segs[GRO_MAX_SEGS];
+    pktmbuf_t *pkts[GRO_MAX_SEGS];
+    uint32_t hlen, max;
+    int n;
+
+    for (int i = 0; i < GRO_MAX_SEGS; i++)
+        segs[i] = gro_seg(GRO_ISS + i * GRO_MSS, GRO_MSS, TCP_ACK_FLAG);
+
+    /* Number of segments fitting in the first merged segment */
+    hlen = sizeof(struct cne_ipv4_hdr) + sizeof(struct cne_tcp_hdr) + 12;
+    max  = (TCP_GRO_MAX_LEN - hlen) / GRO_MSS;
+
+    if ((n = gro_burst(segs, GRO_MAX_SEGS, pkts)) < 0)
+        return -1;
+    if (n != 2 || gro_check(pkts[0], GRO_ISS, max, max * GRO_MSS) ||
+        gro_check(pkts[1], GRO_ISS + max * GRO_MSS, GRO_MAX_SEGS - max,
+                  (GRO_MAX_SEGS - max) * GRO_MSS)) {
+        tst_error("Merged segment is not limited to %u bytes, %d segments left\n",
+                  TCP_GRO_MAX_LEN, n);
+        gro_free(pkts, n);
+        return -1;
+    }
+    gro_free(pkts, n);
+
+    return 0;
+}
+
+/* Input of the segments split from a merged segment, scripted by the test */
+static struct {
+    int nb;                 /* Number of segments given to the input */
+    uint32_t seq[8];        /* Sequence number of each segment given */
+    int rc[8];              /* Value returned for each segment */
+    int close;              /* Segment closing the connection, -1 for none */
+    int handoff;            /* Segment the reassembled data is handed off with, -1 for none */
+    pktmbuf_t *reass;       /* Reassembled data handed off */
+    pktmbuf_t *queued[8];   /* Segments kept by the input */
+    int nb_queued;          /* Number of segments kept by the input */
+    int errors;             /* Number of segments given not split from the merged segment */
+} gi;
+
+static int
+gro_input(struct pcb_entry *p, pktmbuf_t *m)
+{
+    struct cne_ipv4_hdr *ip  = pktmbuf_mtod(m, struct cne_ipv4_hdr *);
+    struct cnet_metadata *md = pktmbuf_metadata(m);
+    int i                    = gi.nb++;
+
+    if (p != &pcb || m->userptr != &pcb || md->gro_next ||
+        be16toh(ip->total_length) != pktmbuf_data_len(m) || cne_ipv4_cksum(ip) != 0 ||
+        i >= (int)CNE_DIM(gi.rc)) {
+        tst_error("Segment %d is not split from the merged segment\n", i);
+        gi.errors++;
+        return TCP_INPUT_NEXT_PKT_DROP;
+    }
+    gi.seq[i] = gro_seq(m);
+
+    if (i == gi.close)
+        tcp.tcp_hd.gen++;
+    if (i == gi.handoff && gi.rc[i] == TCP_INPUT_NEXT_CHNL_RECV) {
+        md->gro_next = gi.reass;
+        gi.reass     = NULL;
+    }
+    if (gi.rc[i] == TCP_INPUT_CONSUMED)
+        gi.queued[gi.nb_queued++] = m;
+
+    return gi.rc[i];
+}
+
+/*
+ * Split a segment merged from four segments, the input returns <rcs> for them. The data for
+ * the channel must be the segments at <expect> in order, -1 ends the list and 4 is the
+ * reassembled data handed off.
+ */
+static int
+gro_split(const int *rcs, int close, int handoff, int expect_rc, const int *expect)
+{
+    struct gro_seg segs[5];
+    pktmbuf_t *pkts[GRO_MAX_SEGS], *m;
+    int n, rc, ret = -1;
+
+    for (int i = 0; i < 5; i++)
+        segs[i] = gro_seg(GRO_ISS + i * GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+
+    memset(&gi, 0, sizeof(gi));
+    memcpy(gi.rc, rcs, 4 * sizeof(int));
+    gi.close   = close;
+    gi.handoff = handoff;
+
+    if ((n = gro_burst(segs, 4, pkts)) < 0)
+        return -1;
+    if (n != 1) {
+        tst_error("Segments not merged\n");
+        gro_free(pkts, n);
+        return -1;
+    }
+    gi.reass = gro_pkt(&segs[4]);
+    if (!gi.reass) {
+        gro_free(pkts, n);
+        return -1;
+    }
+    gi.reass->l3_len = sizeof(struct cne_ipv4_hdr);
+
+    rc = tcp_gro_split(&pcb, pkts[0], gro_input);
+    if (gi.errors)
+        goto leave;
+    if (rc != expect_rc) {
+        tst_error("Split returned %d, expected %d\n", rc, expect_rc);
+        goto leave;
+    }
+
+    /* Each segment is given to the input in order, up to the one closing the connection */
+    for (int i = 0; i < gi.nb; i++) {
+        if (gi.seq[i] != segs[i].seq) {
+            tst_error("Segment %d given to the input is at %u\n", i, gi.seq[i] - GRO_ISS);
+            goto leave;
+        }
+    }
+    if (gi.nb != ((close >= 0) ? close + 1 : 4)) {
+        tst_error("%d segments given to the input\n", gi.nb);
+        goto leave;
+    }
+
+    if (rc == TCP_INPUT_NEXT_CHNL_RECV) {
+        int i = 0;
+
+        /* The head carries no data when its own data is not for the channel */
+        m = pkts[0];
+        if (rcs[0] != TCP_INPUT_NEXT_CHNL_RECV) {
+            if (pktmbuf_data_len(m)) {
+                tst_error("Head with no data for the channel is not trimmed\n");
+                goto leave;
+            }
+            m = gro_next(m);
+        }
+
+        for (; m; m = gro_next(m), i++) {
+            if (expect[i] < 0 || gro_seq(m) != segs[expect[i]].seq) {
+                tst_error("Data %d for the channel is at %u\n", i, gro_seq(m) - GRO_ISS);
+                goto leave;
+            }
+        }
+        if (expect[i] >= 0) {
+            tst_error("Only %d segments of data for the channel\n", i);
+            goto leave;
+        }
+    }
+
+    ret = 0;
+leave:
+    /* The caller drops the head unless it is queued or goes to the channel */
+    if (rc == TCP_INPUT_NEXT_CHNL_RECV)
+        tcp_gro_free(pkts[0]);
+    else if (rc != TCP_INPUT_CONSUMED)
+        pktmbuf_free(pkts[0]);
+    for (int i = 0; i < gi.nb_queued; i++)
+        pktmbuf_free(gi.queued[i]);
+    pktmbuf_free(gi.reass);
+    return ret;
+}
+
+/* A merged segment not taken whole is split and its data goes to the channel in order */
+static int
+test_split(void)
+{
+    const int chnl = TCP_INPUT_NEXT_CHNL_RECV, drop = TCP_INPUT_NEXT_PKT_DROP;
+    const int queue = TCP_INPUT_CONSUMED;
+    // clang-format off
+    struct {
+        const char *name;
+        int rc[4];
+        int close, handoff;
+        int expect_rc;
+        int expect[6];
+    } tbl[] = {
+        {"all in order",        {chnl, chnl, chnl, chnl},    -1, -1, chnl,  {0, 1, 2, 3, -1}},
+        {"head dropped",        {drop, chnl, chnl, chnl},    -1, -1, chnl,  {1, 2, 3, -1}},
+        {"middle dropped",      {chnl, drop, chnl, chnl},    -1, -1, chnl,  {0, 2, 3, -1}},
+        {"handoff",             {chnl, chnl, chnl, chnl},    -1, 1,  chnl,  {0, 1, 4, 2, 3, -1}},
+        {"all queued",          {queue, queue, queue, queue}, -1, -1, queue, {-1}},
+        {"head queued",         {queue, chnl, queue, queue}, -1, -1, queue, {-1}},
+        {"all dropped",         {drop, drop, drop, drop},    -1, -1, drop,  {-1}},
+        {"closed",              {chnl, drop, chnl, chnl},    1,  -1, chnl,  {0, -1}},
+    };
+    // clang-format on
+
+    for (int i = 0; i < (int)CNE_DIM(tbl); i++) {
+        if (gro_split(tbl[i].rc, tbl[i].close, tbl[i].handoff, tbl[i].expect_rc,
+                      tbl[i].expect)) {
+            tst_error("Split %s failed\n", tbl[i].name);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* A merged segment is only taken whole when all its data is in sequence and fits */
+static int
+test_whole(void)
+{
+    struct gro_seg segs[4];
+    pktmbuf_t *pkts[GRO_MAX_SEGS];
+    int n, ret = -1;
+
+    for (int i = 0; i < 4; i++)
+        segs[i] = gro_seg(GRO_ISS + i * GRO_SEG_LEN, GRO_SEG_LEN, TCP_ACK_FLAG);
+    if ((n = gro_burst(segs, 4, pkts)) < 0)
+        return -1;
+    if (n != 1) {
+        tst_error("Segments not merged\n");
+        goto leave;
+    }
+
+    tcb.rcv_nxt = GRO_ISS;
+    tcb.rcv_wnd = 4 * GRO_SEG_LEN;
+    if (!tcp_gro_whole(&pcb, pkts[0])) {
+        tst_error("Merged segment in sequence is not taken whole\n");
+        goto leave;
+    }
+
+    tcb.rcv_wnd--;
+    if (tcp_gro_whole(&pcb, pkts[0])) {
+        tst_error("Merged segment above the receive window is taken whole\n");
+        goto leave;
+    }
+    tcb.rcv_wnd++;
+
+    ch.ch_rcv.cb_cc = ch.ch_rcv.cb_hiwat - (4 * GRO_SEG_LEN - 1);
+    if (tcp_gro_whole(&pcb, pkts[0])) {
+        tst_error("Merged segment above the receive buffer space is taken whole\n");
+        goto leave;
+    }
+    ch.ch_rcv.cb_cc = 0;
+
+    tcb.rcv_nxt = GRO_ISS + 1;
+    if (tcp_gro_whole(&pcb, pkts[0])) {
+        tst_error("Merged segment out of sequence is taken whole\n");
+        goto leave;
+    }
+    tcb.rcv_nxt = GRO_ISS;
+
+    vec_inc_len(tcb.reassemble);
+    if (tcp_gro_whole(&pcb, pkts[0])) {
+        tst_error("Merged segment is taken whole with a reassembly queue\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    vec_set_len(tcb.reassemble, 0);
+    gro_free(pkts, n);
+    return ret;
+}
+
+int
+tcp_gro_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        int (*func)(void);
+    } tsts[] = {
+        {"TCP_GRO: merge", test_merge},
+        {"TCP_GRO: header mismatch", test_mismatch},
+        {"TCP_GRO: max length", test_max_len},
+        {"TCP_GRO: split", test_split},
+        {"TCP_GRO: whole", test_whole},
+    };
+    // clang-format on
+    stk_t *old_stk = this_stk;
+    tst_info_t *tst;
+    int ret = 0;
+
+    /* allocate the pktmbuf pool used by all tests */
+    if (alloc_pool()) {
+        /* dummy test, only used if pool alloc fails */
+        tst = tst_start("TCP_GRO: alloc pool");
+        tst_error("alloc_pool() failed\n");
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    /* An established connection with room for the segments */
+    memset(&ch, 0, sizeof(ch));
+    memset(&pcb, 0, sizeof(pcb));
+    memset(&tcb, 0, sizeof(tcb));
+    pcb.ch             = &ch;
+    pcb.tcb            = &tcb;
+    ch.ch_rcv.cb_hiwat = 64 * 1024;
+    tcb.state          = TCPS_ESTABLISHED;
+    tcb.reassemble     = vec_alloc(tcb.reassemble, 4);
+
+    /* The merge counts in the statistics and the split checks the PCBs of the stack */
+    stk.tcp_stats = &stats;
+    stk.tcp       = &tcp;
+    this_stk      = &stk;
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (!tcb.reassemble || tsts[i].func()) {
+            tst_end(tst, TST_FAILED);
+            ret = -1;
+            break;
+        }
+        tst_end(tst, TST_PASSED);
+    }
+
+    this_stk = old_stk;
+    vec_free(tcb.reassemble);
+    free_pool();
+    return ret;
+}
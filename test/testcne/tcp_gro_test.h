@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _TCP_GRO_TEST_H_
+#define _TCP_GRO_TEST_H_
+
+int tcp_gro_main(int argc, char **argv);
+
+#endif /* _TCP_GRO_TEST_H_ */
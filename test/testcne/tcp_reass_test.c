@@ -0,0 +1,440 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <inttypes.h>        // for PRIu64
+#include <stdint.h>          // for uint64_t, uint32_t, uint8_t
+#include <string.h>          // for memset
+
+#include <cne_common.h>          // for __cne_unused, CNE_DIM
+#include <cne_mmap.h>            // for mmap_alloc, mmap_addr, mmap_free
+#include <cne_vec.h>             // for vec_alloc, vec_len, vec_free
+#include <pktmbuf.h>             // for pktmbuf_t, pktmbuf_alloc, pktmbuf_free
+#include <cnet_stk.h>            // for stk_t, this_stk
+#include <cnet_meta.h>           // for cnet_metadata
+#include <cnet_pcb.h>            // for pcb_entry
+#include <cnet_tcp.h>            // for tcb_entry, seg_entry, tcp_reass, tcp_stats_t
+#include <chnl_priv.h>           // for chnl, chnl_buf
+#include <tcp_input_priv.h>      // for TCP_INPUT_CONSUMED, TCP_INPUT_NEXT_PKT_DROP
+#include <tcp_reass_priv.h>      // for tcp_reassemble, tcp_reass_handoff, tcp_reass_flush
+#include <tst_info.h>            // for tst_start, tst_end, tst_error
+
+#include "tcp_reass_test.h"
+
+#define REASS_MBUF_COUNT (2 * CNET_TCP_REASSEMBLE_COUNT)
+#define REASS_MBUF_SIZE  (8 * 1024)
+#define REASS_BASE       0xFFFFF800U /* Sequence numbers cross the wrap of the sequence space */
+
+/* all tests use the same pktmbuf pool */
+static pktmbuf_info_t *pi;
+static mmap_t *mm;
+
+static stk_t stk;
+static tcp_stats_t stats;
+static struct tcb_entry tcb;
+static struct pcb_entry pcb;
+static struct chnl ch;
+
+static int
+alloc_pool(void)
+{
+    mm = mmap_alloc(REASS_MBUF_COUNT, REASS_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), REASS_MBUF_COUNT, REASS_MBUF_SIZE, 0, NULL);
+    if (!pi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        mmap_free(mm);
+        mm = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+free_pool(void)
+{
+    if (pi)
+        pktmbuf_destroy(pi);
+    pi = NULL;
+
+    if (mm)
+        mmap_free(mm);
+    mm = NULL;
+}
+
+/* Data byte at the relative sequence number <off> */
+static inline uint8_t
+reass_byte(uint32_t off)
+{
+    return (uint8_t)(off ^ (off >> 8));
+}
+
+/* Start with an empty reassembly queue and RCV.NXT at <rcv_nxt> */
+static int
+reass_init(uint32_t rcv_nxt, uint32_t hiwat)
+{
+    memset(&tcb, 0, sizeof(tcb));
+    memset(&pcb, 0, sizeof(pcb));
+    memset(&ch, 0, sizeof(ch));
+    memset(&stats, 0, sizeof(stats));
+
+    pcb.ch             = &ch;
+    pcb.tcb            = &tcb;
+    ch.ch_rcv.cb_hiwat = hiwat;
+    tcb.state          = TCPS_ESTABLISHED;
+    tcb.rcv_nxt        = REASS_BASE + rcv_nxt;
+
+    tcb.reassemble = vec_alloc(tcb.reassemble, CNET_TCP_REASSEMBLE_COUNT);
+    if (!tcb.reassemble) {
+        tst_error("vec_alloc() failed\n");
+        return -1;
+    }
+    return 0;
+}
+
+static void
+reass_done(void)
+{
+    tcp_reass_flush(&tcb);
+    vec_free(tcb.reassemble);
+    tcb.reassemble = NULL;
+}
+
+/* Build the segment of <len> data bytes at the relative sequence number <off> */
+static int
+reass_seg(struct seg_entry *seg, uint32_t off, uint32_t len)
+{
+    pktmbuf_t *m;
+    uint8_t *p;
+
+    memset(seg, 0, sizeof(*seg));
+
+    m = pktmbuf_alloc(pi);
+    if (!m) {
+        tst_error("pktmbuf_alloc() failed\n");
+        return -1;
+    }
+    memset(pktmbuf_metadata(m), 0, sizeof(struct cnet_metadata));
+
+    p = (uint8_t *)pktmbuf_append(m, len);
+    for (uint32_t i = 0; i < len; i++)
+        p[i] = reass_byte(off + i);
+
+    seg->pcb  = &pcb;
+    seg->mbuf = m;
+    seg->seq  = REASS_BASE + off;
+    seg->len  = len;
+    return 0;
+}
+
+/* Queue the out of order segment, the mbuf of a dropped segment is freed */
+static int
+reass_queue(uint32_t off, uint32_t len)
+{
+    struct seg_entry seg;
+    int rc;
+
+    if (reass_seg(&seg, off, len))
+        return -1;
+
+    rc = tcp_reassemble(&seg, &tcb);
+    if ((rc == TCP_INPUT_CONSUMED) != (seg.mbuf == NULL)) {
+        tst_error("Segment [%u, %u) consumed %d with return %d\n", off, off + len,
+                  seg.mbuf == NULL, rc);
+        pktmbuf_free(seg.mbuf);
+        return -1;
+    }
+    pktmbuf_free(seg.mbuf);
+
+    return rc;
+}
+
+/* The data of <m> starts at the relative sequence number <off> */
+static int
+reass_data_check(pktmbuf_t *m, uint32_t off)
+{
+    uint8_t *p = pktmbuf_mtod(m, uint8_t *);
+
+    for (uint32_t i = 0; i < pktmbuf_data_len(m); i++) {
+        if (p[i] != reass_byte(off + i)) {
+            tst_error("Data at %u is not the data of the sequence number\n", off + i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* The reassembly queue holds exactly the segments of <segs>, given as pairs of start and length */
+static int
+reass_check(const char *msg, const uint32_t *segs, uint32_t nb, uint64_t dropped)
+{
+    uint32_t bytes = 0;
+
+    if (vec_len(tcb.reassemble) != nb) {
+        tst_error("%s: queue has %u segments, expected %u\n", msg, vec_len(tcb.reassemble), nb);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < nb; i++) {
+        struct tcp_reass *r = &tcb.reassemble[i];
+
+        if (r->seq != REASS_BASE + segs[2 * i] || r->len != segs[2 * i + 1] ||
+            pktmbuf_data_len(r->mbuf) != r->len) {
+            tst_error("%s: segment %u is [%u, +%u), expected [%u, +%u)\n", msg, i,
+                      r->seq - REASS_BASE, r->len, segs[2 * i], segs[2 * i + 1]);
+            return -1;
+        }
+        if (reass_data_check(r->mbuf, segs[2 * i]))
+            return -1;
+        bytes += r->len;
+    }
+
+    if (tcb.reass_bytes != bytes) {
+        tst_error("%s: queue holds %u bytes, expected %u\n", msg, tcb.reass_bytes, bytes);
+        return -1;
+    }
+    if (stats.S_ooo_dropped != dropped) {
+        tst_error("%s: %" PRIu64 " bytes dropped, expected %" PRIu64 "\n", msg,
+                  stats.S_ooo_dropped, dropped);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Data overlapping queued segments is trimmed from the front or the back, covered ones replaced */
+static int
+test_overlap(void)
+{
+    const uint32_t queued[] = {1000, 1000, 3000, 1000};
+    const uint32_t front[]  = {1000, 1000, 2000, 500, 3000, 1000};
+    const uint32_t back[]   = {1000, 1000, 2000, 500, 2800, 200, 3000, 1000};
+    const uint32_t full[]   = {500, 4000};
+    const uint32_t longer[] = {500, 4000, 4500, 500, 5000, 500};
+    int ret                 = -1;
+
+    if (reass_init(0, UINT32_MAX))
+        return -1;
+
+    if (reass_queue(3000, 1000) != TCP_INPUT_CONSUMED ||
+        reass_queue(1000, 1000) != TCP_INPUT_CONSUMED || reass_check("queue", queued, 2, 0))
+        goto leave;
+
+    /* The front of [1500, 2500) overlaps [1000, 2000) */
+    if (reass_queue(1500, 1000) != TCP_INPUT_CONSUMED || reass_check("front", front, 3, 500))
+        goto leave;
+
+    /* The back of [2800, 3200) overlaps [3000, 4000) */
+    if (reass_queue(2800, 400) != TCP_INPUT_CONSUMED || reass_check("back", back, 4, 700))
+        goto leave;
+
+    /* [500, 4500) covers all queued segments */
+    if (reass_queue(500, 4000) != TCP_INPUT_CONSUMED || reass_check("full", full, 1, 3400))
+        goto leave;
+
+    /* A longer segment starting with a queued one only queues the data following it */
+    if (reass_queue(4500, 500) != TCP_INPUT_CONSUMED ||
+        reass_queue(4500, 1000) != TCP_INPUT_CONSUMED || reass_check("same start", longer, 3, 3900))
+        goto leave;
+
+    ret = 0;
+leave:
+    reass_done();
+    return ret;
+}
+
+/* Data already received or queued is dropped and counted */
+static int
+test_duplicate(void)
+{
+    const uint32_t queued[] = {1000, 1000, 3000, 1000};
+    const uint32_t nxt[]    = {200, 600, 1000, 1000, 3000, 1000};
+    int ret                 = -1;
+
+    if (reass_init(200, UINT32_MAX))
+        return -1;
+
+    if (reass_queue(1000, 1000) != TCP_INPUT_CONSUMED ||
+        reass_queue(3000, 1000) != TCP_INPUT_CONSUMED)
+        goto leave;
+
+    /* Exact duplicates, a segment inside a queued one and a shorter one with the same start */
+    if (reass_queue(1000, 1000) != TCP_INPUT_NEXT_PKT_DROP ||
+        reass_queue(3200, 500) != TCP_INPUT_NEXT_PKT_DROP ||
+        reass_queue(3000, 300) != TCP_INPUT_NEXT_PKT_DROP ||
+        reass_check("duplicates", queued, 2, 1800))
+        goto leave;
+
+    /* Data below RCV.NXT is dropped, a segment holding RCV.NXT is trimmed */
+    if (reass_queue(0, 200) != TCP_INPUT_NEXT_PKT_DROP ||
+        reass_queue(100, 700) != TCP_INPUT_CONSUMED || reass_check("RCV.NXT", nxt, 3, 2100))
+        goto leave;
+
+    ret = 0;
+leave:
+    reass_done();
+    return ret;
+}
+
+/* The queue holds no more than CNET_TCP_REASSEMBLE_COUNT segments and the receive buffer space */
+static int
+test_limits(void)
+{
+    const uint32_t queued[] = {1000, 1000, 3000, 1000};
+    int ret                 = -1;
+
+    /* The receive buffer holds 1000 bytes and has room for 2000 more */
+    if (reass_init(0, 3000))
+        return -1;
+    ch.ch_rcv.cb_cc = 1000;
+
+    if (reass_queue(1000, 1000) != TCP_INPUT_CONSUMED ||
+        reass_queue(3000, 1000) != TCP_INPUT_CONSUMED ||
+        reass_queue(5000, 1) != TCP_INPUT_NEXT_PKT_DROP || reass_check("bytes", queued, 2, 1))
+        goto leave;
+    reass_done();
+
+    if (reass_init(0, UINT32_MAX))
+        return -1;
+
+    for (uint32_t i = 0; i < CNET_TCP_REASSEMBLE_COUNT; i++) {
+        if (reass_queue(100 + 20 * i, 10) != TCP_INPUT_CONSUMED)
+            goto leave;
+    }
+    if (reass_queue(10, 10) != TCP_INPUT_NEXT_PKT_DROP || stats.S_ooo_dropped != 10 ||
+        vec_len(tcb.reassemble) != CNET_TCP_REASSEMBLE_COUNT ||
+        tcb.reass_bytes != 10 * CNET_TCP_REASSEMBLE_COUNT) {
+        tst_error("Queue holds more than %u segments\n", CNET_TCP_REASSEMBLE_COUNT);
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    reass_done();
+    return ret;
+}
+
+/* Hand the segment at RCV.NXT and the queued segments now in sequence to the channel */
+static int
+reass_handoff(uint32_t off, uint32_t len, uint32_t rcv_nxt, uint32_t nb_segs)
+{
+    struct cnet_metadata *md;
+    struct seg_entry seg;
+    pktmbuf_t *m, *next;
+    uint32_t n = 0;
+    int ret    = 0;
+
+    if (reass_seg(&seg, off, len))
+        return -1;
+    m = seg.mbuf;
+
+    if (tcp_reass_handoff(&seg, &tcb) != TCP_INPUT_NEXT_CHNL_RECV || seg.mbuf) {
+        tst_error("Segment [%u, %u) at RCV.NXT not handed to the channel\n", off, off + len);
+        ret = -1;
+    }
+
+    /* The chain holds the data in sequence from <off> up to RCV.NXT */
+    for (; m; m = next) {
+        md   = pktmbuf_metadata(m);
+        next = md->gro_next;
+
+        if (!ret && reass_data_check(m, off))
+            ret = -1;
+        off += pktmbuf_data_len(m);
+        n++;
+        pktmbuf_free(m);
+    }
+
+    if (!ret && (n != nb_segs || off != rcv_nxt || tcb.rcv_nxt != REASS_BASE + rcv_nxt)) {
+        tst_error("Handed %u segments up to %u, RCV.NXT %u, expected %u segments up to %u\n", n,
+                  off, tcb.rcv_nxt - REASS_BASE, nb_segs, rcv_nxt);
+        ret = -1;
+    }
+
+    return ret;
+}
+
+/* Queued segments are handed to the channel once the hole in front of them is filled */
+static int
+test_handoff(void)
+{
+    const uint32_t first[]  = {2500, 500, 4000, 1000};
+    const uint32_t second[] = {4000, 1000};
+    int ret                 = -1;
+
+    if (reass_init(0, UINT32_MAX))
+        return -1;
+
+    if (reass_queue(1000, 1000) != TCP_INPUT_CONSUMED ||
+        reass_queue(2500, 500) != TCP_INPUT_CONSUMED ||
+        reass_queue(4000, 1000) != TCP_INPUT_CONSUMED)
+        goto leave;
+
+    /* [0, 1200) fills the first hole and overlaps the front of [1000, 2000) */
+    if (reass_handoff(0, 1200, 2000, 2) || reass_check("first hole", first, 2, 200))
+        goto leave;
+
+    /* [2000, 2500) fills the second hole */
+    if (reass_handoff(2000, 500, 3000, 2) || reass_check("second hole", second, 1, 200))
+        goto leave;
+
+    /* [3000, 5000) covers the last queued segment, which is dropped */
+    if (reass_handoff(3000, 2000, 5000, 1) || reass_check("covered", NULL, 0, 1200))
+        goto leave;
+
+    ret = 0;
+leave:
+    reass_done();
+    return ret;
+}
+
+int
+tcp_reass_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        int (*func)(void);
+    } tsts[] = {
+        {"TCP_REASS: overlap", test_overlap},
+        {"TCP_REASS: duplicate", test_duplicate},
+        {"TCP_REASS: limits", test_limits},
+        {"TCP_REASS: handoff", test_handoff},
+    };
+    // clang-format on
+    stk_t *old_stk = this_stk;
+    tst_info_t *tst;
+    int ret = 0;
+
+    /* allocate the pktmbuf pool used by all tests */
+    if (alloc_pool()) {
+        /* dummy test, only used if pool alloc fails */
+        tst = tst_start("TCP_REASS: alloc pool");
+        tst_error("alloc_pool() failed\n");
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    /* The queue counts the dropped data in the statistics of the stack of the thread */
+    stk.tcp_stats = &stats;
+    this_stk      = &stk;
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (tsts[i].func()) {
+            tst_end(tst, TST_FAILED);
+            ret = -1;
+            break;
+        }
+        tst_end(tst, TST_PASSED);
+    }
+
+    this_stk = old_stk;
+    free_pool();
+    return ret;
+}
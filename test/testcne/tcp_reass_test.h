@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#ifndef _TCP_REASS_TEST_H_
+#define _TCP_REASS_TEST_H_
+
+int tcp_reass_main(int argc, char **argv);
+
+#endif /* _TCP_REASS_TEST_H_ */
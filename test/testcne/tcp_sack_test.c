@@ -0,0 +1,325 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <stdint.h>        // for uint32_t
+#include <string.h>        // for memset, memmove
+
+#include <cne_common.h>          // for __cne_unused, CNE_DIM
+#include <cnet_tcp.h>            // for tcb_entry, seg_entry, tcp_sack_blk, TCP_SACK_BLKS
+#include <tcp_sack_priv.h>       // for tcp_sack_insert, tcp_sack_update, tcp_sack_pipe
+#include <tst_info.h>            // for tst_start, tst_end, tst_error
+
+#include "tcp_sack_test.h"
+
+/* Sequence numbers are relative to a base close to the wrap of the sequence space */
+#define SACK_BASE 0xFFFFF000U
+
+static struct tcb_entry tcb;
+
+static void
+sack_tcb_init(uint32_t una, uint32_t max)
+{
+    memset(&tcb, 0, sizeof(tcb));
+    tcb.snd_una       = SACK_BASE + una;
+    tcb.snd_nxt       = SACK_BASE + max;
+    tcb.snd_max       = SACK_BASE + max;
+    tcb.sack_high_rxt = SACK_BASE + una;
+}
+
+static void
+sack_insert(uint32_t start, uint32_t end)
+{
+    struct tcp_sack_blk blk = {.start = SACK_BASE + start, .end = SACK_BASE + end};
+
+    tcp_sack_insert(&tcb, &blk);
+}
+
+/* The scoreboard holds exactly the blocks of <blks>, given as pairs of start and end */
+static int
+sack_check(const char *msg, const uint32_t *blks, int nb)
+{
+    if (tcb.snd_numsacks != nb) {
+        tst_error("%s: scoreboard has %d blocks, expected %d\n", msg, tcb.snd_numsacks, nb);
+        return -1;
+    }
+
+    for (int i = 0; i < nb; i++) {
+        struct tcp_sack_blk *sb = &tcb.snd_sacks[i];
+
+        if (sb->start != SACK_BASE + blks[2 * i] || sb->end != SACK_BASE + blks[2 * i + 1]) {
+            tst_error("%s: block %d is [%u, %u), expected [%u, %u)\n", msg, i,
+                      sb->start - SACK_BASE, sb->end - SACK_BASE, blks[2 * i], blks[2 * i + 1]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Blocks are kept sorted and overlapping or adjacent blocks are merged */
+static int
+test_merge(void)
+{
+    const uint32_t sorted[]  = {1000, 2000, 3000, 4000, 5000, 6000};
+    const uint32_t touch[]   = {1000, 2000, 3000, 4500, 5000, 6000};
+    const uint32_t bridge[]  = {500, 6500};
+    const uint32_t overlap[] = {500, 7000, 8000, 9000};
+
+    sack_tcb_init(0, 10000);
+
+    sack_insert(3000, 4000);
+    sack_insert(5000, 6000);
+    sack_insert(1000, 2000);
+    if (sack_check("out of order blocks", sorted, 3))
+        return -1;
+
+    /* A block inside an existing block changes nothing */
+    sack_insert(1200, 1800);
+    sack_insert(3000, 4000);
+    if (sack_check("duplicate blocks", sorted, 3))
+        return -1;
+
+    /* A block touching the end of a block extends it */
+    sack_insert(4000, 4500);
+    if (sack_check("adjacent block", touch, 3))
+        return -1;
+
+    /* A block covering all blocks replaces them */
+    sack_insert(500, 6500);
+    if (sack_check("covering block", bridge, 1))
+        return -1;
+
+    /* A block overlapping the end of a block and a new one above */
+    sack_insert(8000, 9000);
+    sack_insert(6000, 7000);
+    if (sack_check("overlapping block", overlap, 2))
+        return -1;
+
+    return 0;
+}
+
+/* A full scoreboard forgets its highest block to keep the lower ones */
+static int
+test_evict(void)
+{
+    uint32_t blks[2 * TCP_SACK_BLKS];
+
+    sack_tcb_init(0, 100000);
+
+    /* Fill the scoreboard with blocks [1000 * (2i + 2), 1000 * (2i + 3)) */
+    for (int i = 0; i < TCP_SACK_BLKS; i++) {
+        blks[2 * i]     = 1000 * (2 * i + 2);
+        blks[2 * i + 1] = 1000 * (2 * i + 3);
+        sack_insert(blks[2 * i], blks[2 * i + 1]);
+    }
+    if (sack_check("full scoreboard", blks, TCP_SACK_BLKS))
+        return -1;
+
+    /* A new block above all blocks of a full scoreboard is not held */
+    sack_insert(90000, 91000);
+    if (sack_check("block above a full scoreboard", blks, TCP_SACK_BLKS))
+        return -1;
+
+    /* A new lower block evicts the highest block */
+    memmove(&blks[2], &blks[0], sizeof(blks) - 2 * sizeof(blks[0]));
+    blks[0] = 100;
+    blks[1] = 200;
+    sack_insert(100, 200);
+    if (sack_check("block below a full scoreboard", blks, TCP_SACK_BLKS))
+        return -1;
+
+    /* A block merging two blocks of a full scoreboard frees an entry */
+    sack_insert(2500, 4500);
+    blks[3] = 5000;
+    memmove(&blks[4], &blks[6], sizeof(blks) - 6 * sizeof(blks[0]));
+    if (sack_check("merge in a full scoreboard", blks, TCP_SACK_BLKS - 1))
+        return -1;
+
+    return 0;
+}
+
+/* The scoreboard is trimmed at the cumulative ACK and SACK blocks are clipped to the data sent */
+static int
+test_update(void)
+{
+    const uint32_t acked[]   = {2500, 3000, 4000, 5000};
+    const uint32_t sacked[]  = {2500, 3000, 4000, 5000, 6000, 7000};
+    const uint32_t wrapped[] = {4500, 5000, 6000, 7000};
+    struct seg_entry seg;
+
+    sack_tcb_init(0, 8000);
+    sack_insert(1000, 2000);
+    sack_insert(2200, 3000);
+    sack_insert(4000, 5000);
+
+    /* Drop the blocks below the ACK and trim the block holding it */
+    memset(&seg, 0, sizeof(seg));
+    seg.ack = SACK_BASE + 2500;
+    tcp_sack_update(&tcb, &seg);
+    if (sack_check("cumulative ACK", acked, 2))
+        return -1;
+    tcb.snd_una = seg.ack;
+
+    /* SACK blocks below the ACK or above snd_max are ignored, straddling blocks are trimmed */
+    seg.nb_sacks       = 4;
+    seg.sacks[0].start = SACK_BASE + 1000;
+    seg.sacks[0].end   = SACK_BASE + 2000;
+    seg.sacks[1].start = SACK_BASE + 2000;
+    seg.sacks[1].end   = SACK_BASE + 2600;
+    seg.sacks[2].start = SACK_BASE + 7500;
+    seg.sacks[2].end   = SACK_BASE + 9000;
+    seg.sacks[3].start = SACK_BASE + 6000;
+    seg.sacks[3].end   = SACK_BASE + 7000;
+    tcp_sack_update(&tcb, &seg);
+    if (sack_check("SACK blocks", sacked, 3))
+        return -1;
+
+    /* An old ACK below snd_una trims at snd_una and an ACK above snd_max is ignored */
+    seg.nb_sacks = 0;
+    seg.ack      = SACK_BASE + 1000;
+    tcp_sack_update(&tcb, &seg);
+    seg.ack = SACK_BASE + 9000;
+    tcp_sack_update(&tcb, &seg);
+    if (sack_check("out of window ACK", sacked, 3))
+        return -1;
+
+    /* The ACK crossing the wrap of the sequence space */
+    seg.ack = SACK_BASE + 4500;
+    tcp_sack_update(&tcb, &seg);
+    if (sack_check("ACK across the sequence wrap", wrapped, 2))
+        return -1;
+
+    return 0;
+}
+
+/* NextSeg retransmits the holes below SACKed blocks above the highest retransmitted data */
+static int
+test_nexthole(void)
+{
+    // clang-format off
+    struct {
+        uint32_t high_rxt;
+        int found;
+        uint32_t start, end;
+    } tbl[] = {
+        {0,    1, 0,    1000},
+        {500,  1, 500,  1000},
+        {1000, 1, 2000, 3000},
+        {1500, 1, 2000, 3000},
+        {2500, 1, 2500, 3000},
+        {3500, 0, 0,    0},
+        {4000, 0, 0,    0},
+        {6000, 0, 0,    0},
+    };
+    // clang-format on
+    seq_t start, end;
+
+    sack_tcb_init(0, 8000);
+    if (tcp_sack_nexthole(&tcb, &start, &end)) {
+        tst_error("Hole found in an empty scoreboard\n");
+        return -1;
+    }
+
+    sack_insert(1000, 2000);
+    sack_insert(3000, 4000);
+
+    for (int i = 0; i < (int)CNE_DIM(tbl); i++) {
+        int found;
+
+        tcb.sack_high_rxt = SACK_BASE + tbl[i].high_rxt;
+
+        found = tcp_sack_nexthole(&tcb, &start, &end);
+        if (found != tbl[i].found ||
+            (found && (start != SACK_BASE + tbl[i].start || end != SACK_BASE + tbl[i].end))) {
+            tst_error("High rxt %u: hole %d [%u, %u), expected %d [%u, %u)\n", tbl[i].high_rxt,
+                      found, start - SACK_BASE, end - SACK_BASE, tbl[i].found, tbl[i].start,
+                      tbl[i].end);
+            return -1;
+        }
+    }
+
+    /* A high rxt below snd_una starts at snd_una */
+    tcb.snd_una       = SACK_BASE + 200;
+    tcb.sack_high_rxt = SACK_BASE + 100;
+    if (!tcp_sack_nexthole(&tcb, &start, &end) || start != SACK_BASE + 200 ||
+        end != SACK_BASE + 1000) {
+        tst_error("Hole does not start at snd_una\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * SetPipe counts the data sent and not acked, less the SACKed data and the holes below a
+ * SACKed block not retransmitted yet.
+ */
+static int
+test_pipe(void)
+{
+    // clang-format off
+    struct {
+        uint32_t high_rxt;
+        uint32_t pipe;
+    } tbl[] = {
+        {0,    10000 - 2000 - 1000 - 1000},
+        {500,  10000 - 2000 - 500 - 1000},
+        {1000, 10000 - 2000 - 1000},
+        {2500, 10000 - 2000 - 500},
+        {3500, 10000 - 2000},
+        {9000, 10000 - 2000},
+    };
+    // clang-format on
+    uint32_t pipe;
+
+    sack_tcb_init(0, 10000);
+    if ((pipe = tcp_sack_pipe(&tcb)) != 10000) {
+        tst_error("Pipe %u without SACK blocks, expected 10000\n", pipe);
+        return -1;
+    }
+
+    sack_insert(1000, 2000);
+    sack_insert(3000, 4000);
+
+    for (int i = 0; i < (int)CNE_DIM(tbl); i++) {
+        tcb.sack_high_rxt = SACK_BASE + tbl[i].high_rxt;
+
+        pipe = tcp_sack_pipe(&tcb);
+        if (pipe != tbl[i].pipe) {
+            tst_error("High rxt %u: pipe %u, expected %u\n", tbl[i].high_rxt, pipe, tbl[i].pipe);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int
+tcp_sack_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        int (*func)(void);
+    } tsts[] = {
+        {"TCP_SACK: merge blocks", test_merge},
+        {"TCP_SACK: full scoreboard", test_evict},
+        {"TCP_SACK: update", test_update},
+        {"TCP_SACK: next hole", test_nexthole},
+        {"TCP_SACK: pipe", test_pipe},
+    };
+    // clang-format on
+    tst_info_t *tst;
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (tsts[i].func()) {
+            tst_end(tst, TST_FAILED);
+            return -1;
+        }
+        tst_end(tst, TST_PASSED);
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <string.h>        // for memset
+
+#include <cne_common.h>        // for __cne_unused
+#include <cne_mmap.h>          // for mmap_alloc, mmap_addr, mmap_free
+#include <cne_vec.h>           // for vec_alloc, vec_add, vec_free
+#include <pktmbuf.h>           // for pktmbuf_t, pktmbuf_alloc, pktmbuf_free
+#include <net/cne_ether.h>     // for cne_ether_hdr
+#include <net/cne_ip.h>        // for cne_ipv4_hdr
+#include <net/cne_tcp.h>       // for cne_tcp_hdr
+#include <cnet_meta.h>         // for cnet_metadata, CNET_META_ZCOPY
+#include <chnl_priv.h>         // for chnl_buf, chnl_validate_cb
+#include <tcp_snd_priv.h>      // for tcp_mbuf_ref, tcp_mbuf_copydata
+#include <tst_info.h>          // for tst_start, tst_end, tst_error
+
+#include "tcp_snd_test.h"
+
+#define SND_MBUF_COUNT 64
+#define SND_MBUF_SIZE  (2 * 1024)
+#define SND_DATA_LEN   1000
+#define SND_SEG_LEN    600
+#define SND_HDR_LEN \
+    (sizeof(struct cne_ether_hdr) + sizeof(struct cne_ipv4_hdr) + sizeof(struct cne_tcp_hdr))
+
+/* all tests use the same pktmbuf pool */
+static pktmbuf_info_t *pi;
+static mmap_t *mm;
+
+static int
+alloc_pool(void)
+{
+    mm = mmap_alloc(SND_MBUF_COUNT, SND_MBUF_SIZE, MMAP_HUGEPAGE_DEFAULT);
+    if (!mm) {
+        tst_error("mmap_alloc() failed\n");
+        return -1;
+    }
+
+    pi = pktmbuf_pool_create(mmap_addr(mm), SND_MBUF_COUNT, SND_MBUF_SIZE, 0, NULL);
+    if (!pi) {
+        tst_error("pktmbuf_pool_create() failed\n");
+        mmap_free(mm);
+        mm = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+free_pool(void)
+{
+    if (pi)
+        pktmbuf_destroy(pi);
+    pi = NULL;
+
+    if (mm)
+        mmap_free(mm);
+    mm = NULL;
+}
+
+/* Queue an mbuf of <len> data bytes to the send buffer, as tcp_output does */
+static pktmbuf_t *
+snd_enqueue(struct chnl_buf *cb, uint16_t len, uint16_t flags)
+{
+    struct cnet_metadata *md;
+    pktmbuf_t *m;
+    uint8_t *p;
+
+    m = pktmbuf_alloc(pi);
+    if (!m)
+        return NULL;
+
+    p = (uint8_t *)pktmbuf_append(m, len);
+    for (int i = 0; i < len; i++)
+        p[i] = (uint8_t)(i + vec_len(cb->cb_vec));
+
+    md          = pktmbuf_metadata(m);
+    md->flags   = flags;
+    md->snd_off = pktmbuf_data_off(m);
+    md->snd_len = pktmbuf_data_len(m);
+
+    vec_add(cb->cb_vec, m);
+    cb->cb_cc += pktmbuf_data_len(m);
+    pktmbuf_refcnt_update(m, 1);
+
+    return m;
+}
+
+/* Check the copy of <len> bytes of the send buffer at <off> */
+static int
+snd_copy_check(struct chnl_buf *cb, uint32_t off, uint32_t len)
+{
+    uint8_t buf[2 * SND_DATA_LEN];
+    uint32_t n;
+
+    memset(buf, 0, sizeof(buf));
+
+    n = tcp_mbuf_copydata(cb, off, len, (char *)buf);
+    if (n != len) {
+        tst_error("Copied %u bytes, expected %u\n", n, len);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < len; i++) {
+        uint32_t o = off + i;
+
+        if (buf[i] != (uint8_t)((o % SND_DATA_LEN) + (o / SND_DATA_LEN))) {
+            tst_error("Copied byte %u at offset %u is not the send buffer data\n", i, o);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * A segment sent in place holds a reference on its send buffer mbuf and owns the mbuf data
+ * offset and length until it is transmitted. A retransmit of the data meanwhile is copied.
+ */
+static int
+test_busy(void)
+{
+    struct chnl_buf cb = {0};
+    pktmbuf_t *m[2] = {0}, *s;
+    int32_t len;
+    int ret = -1;
+
+    cb.cb_vec = vec_alloc(cb.cb_vec, 4);
+    if (!cb.cb_vec) {
+        tst_error("vec_alloc() failed\n");
+        return -1;
+    }
+
+    m[0] = snd_enqueue(&cb, SND_DATA_LEN, CNET_META_ZCOPY);
+    m[1] = snd_enqueue(&cb, SND_DATA_LEN, 0);
+    if (!m[0] || !m[1]) {
+        tst_error("pktmbuf_alloc() failed\n");
+        goto leave;
+    }
+
+    len = SND_SEG_LEN;
+    s   = tcp_mbuf_ref(&cb, 0, &len, SND_HDR_LEN);
+    if (s != m[0] || len != SND_SEG_LEN || !tcp_snd_busy(m[0])) {
+        tst_error("Data of a zero copy mbuf is not sent in place\n");
+        goto leave;
+    }
+
+    /* Build the headers in the headroom of the segment like the TCP output */
+    memset(pktmbuf_prepend(s, SND_HDR_LEN), 0xFF, SND_HDR_LEN);
+
+    if (chnl_validate_cb("SND", &cb, true)) {
+        tst_error("Send buffer with a segment sent in place is not valid\n");
+        goto leave;
+    }
+
+    /* The retransmit of the busy mbuf falls back to a copy of the unacked data */
+    len = SND_SEG_LEN;
+    if (tcp_mbuf_ref(&cb, 0, &len, SND_HDR_LEN) != NULL) {
+        tst_error("Busy mbuf is sent in place again\n");
+        goto leave;
+    }
+    if (snd_copy_check(&cb, 0, SND_DATA_LEN + SND_SEG_LEN))
+        goto leave;
+
+    /* Data not at the start of a zero copy mbuf or in a copied mbuf is always copied */
+    len = SND_SEG_LEN;
+    if (tcp_mbuf_ref(&cb, 100, &len, SND_HDR_LEN) != NULL ||
+        tcp_mbuf_ref(&cb, SND_DATA_LEN, &len, SND_HDR_LEN) != NULL) {
+        tst_error("Data is sent in place from the middle or a copied mbuf\n");
+        goto leave;
+    }
+    if (snd_copy_check(&cb, 100, SND_DATA_LEN))
+        goto leave;
+
+    /* Once the segment is transmitted the mbuf is sent in place again */
+    pktmbuf_free(s);
+    len = SND_DATA_LEN;
+    s   = tcp_mbuf_ref(&cb, 0, &len, SND_HDR_LEN);
+    if (s != m[0] || len != SND_DATA_LEN) {
+        tst_error("Transmitted mbuf is not sent in place again\n");
+        goto leave;
+    }
+    pktmbuf_free(s);
+
+    if (chnl_validate_cb("SND", &cb, true)) {
+        tst_error("Send buffer is not valid\n");
+        goto leave;
+    }
+
+    ret = 0;
+leave:
+    for (int i = 0; i < (int)CNE_DIM(m); i++) {
+        if (m[i]) {
+            while (tcp_snd_busy(m[i]))
+                pktmbuf_free(m[i]);
+            pktmbuf_refcnt_update(m[i], -1);
+            pktmbuf_free(m[i]);
+        }
+    }
+    vec_free(cb.cb_vec);
+    return ret;
+}
+
+int
+tcp_snd_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    tst_info_t *tst;
+
+    /* allocate the pktmbuf pool used by all tests */
+    if (alloc_pool()) {
+        /* dummy test, only used if pool alloc fails */
+        tst = tst_start("TCP_SND: alloc pool");
+        tst_error("alloc_pool() failed\n");
+        tst_end(tst, TST_FAILED);
+        return -1;
+    }
+
+    tst = tst_start("TCP_SND: copy while sent in place");
+    if (test_busy())
+        goto err;
+    tst_end(tst, TST_PASSED);
+
+    free_pool();
+    return 0;
+
+err:
+    tst_end(tst, TST_FAILED);
+    free_pool();
+    return -1;
+}
@@ -0,0 +1,288 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2023 Intel Corporation
+ */
+
+#include <inttypes.h>        // for PRIu64
+#include <stdint.h>          // for uint64_t, uint32_t, uint16_t
+#include <string.h>          // for memset
+
+#include <cne_common.h>             // for __cne_unused, CNE_DIM
+#include <cnet_tcp_wheel.h>         // for tcp_wheel, tcp_tmr, tcp_wheel_add, tcp_wheel_tick
+#include <tst_info.h>               // for tst_start, tst_end, tst_error
+
+#include "tcp_wheel_test.h"
+
+#define WHEEL_NB_TMRS 512
+
+/* The wheel and timers are large, keep them out of the stack */
+static struct tcp_wheel wheel;
+static struct tcp_tmr tmrs[WHEEL_NB_TMRS];
+
+static struct {
+    uint64_t expect[WHEEL_NB_TMRS]; /* Tick each timer must expire on, zero if not armed */
+    uint64_t fired[WHEEL_NB_TMRS];  /* Tick each timer expired on */
+    uint64_t last;                  /* Tick of the last expired timer */
+    uint32_t count;                 /* Number of expired timers */
+    uint32_t errors;                /* Number of timers expired out of order or twice */
+    uint64_t period;                /* Ticks to re-arm timer zero with from its expire function */
+} ws;
+
+static void
+wheel_reset(void)
+{
+    tcp_wheel_init(&wheel);
+    memset(tmrs, 0, sizeof(tmrs));
+    memset(&ws, 0, sizeof(ws));
+}
+
+static void
+wheel_expire(struct tcp_tmr *tmr, void *arg, uint16_t id)
+{
+    if (arg != &ws || tmr != &tmrs[id] || tcp_wheel_pending(tmr) || wheel.now < ws.last ||
+        ws.fired[id]) {
+        tst_error("Timer %u expired on tick %" PRIu64 " out of order or twice\n", id, wheel.now);
+        ws.errors++;
+    }
+
+    ws.fired[id] = wheel.now;
+    ws.last      = wheel.now;
+    ws.count++;
+
+    if (id == 0 && ws.period) {
+        ws.fired[id]  = 0;
+        ws.expect[id] = wheel.now + ws.period;
+        tcp_wheel_add(&wheel, tmr, ws.period, &ws, id);
+    }
+}
+
+static void
+wheel_arm(uint16_t id, uint64_t ticks)
+{
+    uint64_t t = (ticks == 0) ? 1 : (ticks > TCP_WHEEL_MAX) ? TCP_WHEEL_MAX : ticks;
+
+    tcp_wheel_add(&wheel, &tmrs[id], ticks, &ws, id);
+    ws.expect[id] = wheel.now + t;
+    ws.fired[id]  = 0;
+}
+
+/* Turn the wheel until <tick>, stop on a timer expired out of order */
+static int
+wheel_run(uint64_t tick)
+{
+    while (wheel.now < tick) {
+        tcp_wheel_tick(&wheel, wheel_expire);
+        if (ws.errors)
+            return -1;
+    }
+    return 0;
+}
+
+/* Every armed timer expired exactly on its expire tick */
+static int
+wheel_check(uint32_t nb)
+{
+    for (uint32_t i = 0; i < nb; i++) {
+        if (ws.expect[i] && ws.fired[i] != ws.expect[i]) {
+            tst_error("Timer %u expired on tick %" PRIu64 ", expected %" PRIu64 "\n", i,
+                      ws.fired[i], ws.expect[i]);
+            return -1;
+        }
+    }
+    if (wheel.count) {
+        tst_error("%u timers are still armed\n", wheel.count);
+        return -1;
+    }
+    return 0;
+}
+
+/* Timers on both sides of each level boundary expire on their tick, from any starting tick */
+static int
+test_cascade(void)
+{
+    uint64_t starts[] = {0, 1, 63, 100, 4095, 262143, 1000000};
+
+    for (int s = 0; s < (int)CNE_DIM(starts); s++) {
+        uint16_t id = 0;
+
+        wheel_reset();
+        wheel.now = starts[s];
+
+        for (uint32_t level = 1; level < TCP_WHEEL_LEVELS; level++) {
+            uint64_t edge = 1ULL << (TCP_WHEEL_BITS * level);
+
+            wheel_arm(id++, edge - 1);
+            wheel_arm(id++, edge);
+            wheel_arm(id++, edge + 1);
+            /* Expire on the tick of the level boundary, whatever the starting tick */
+            wheel_arm(id++, edge - (wheel.now & (edge - 1)));
+        }
+
+        if (wheel.count != id) {
+            tst_error("Wheel holds %u timers, expected %u\n", wheel.count, id);
+            return -1;
+        }
+
+        if (wheel_run(wheel.now + (1ULL << (TCP_WHEEL_BITS * (TCP_WHEEL_LEVELS - 1))) + 1) ||
+            wheel_check(id))
+            return -1;
+        if (ws.count != id) {
+            tst_error("%u timers expired, expected %u\n", ws.count, id);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Timers with pseudo random timeouts expire in the order of their expire tick */
+static int
+test_order(void)
+{
+    uint32_t seed = 1;
+
+    wheel_reset();
+    wheel.now = 12345;
+
+    for (uint16_t i = 0; i < WHEEL_NB_TMRS; i++) {
+        seed = seed * 1103515245 + 12345;
+        /* Spread the timeouts over the levels, up to 2^20 ticks */
+        wheel_arm(i, (seed >> 12) >> ((seed & 3) * 6));
+    }
+
+    if (wheel_run(wheel.now + (1ULL << 20) + 1) || wheel_check(WHEEL_NB_TMRS))
+        return -1;
+    if (ws.count != WHEEL_NB_TMRS) {
+        tst_error("%u timers expired, expected %u\n", ws.count, WHEEL_NB_TMRS);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* A stopped timer never expires and a re-armed timer only expires on its new tick */
+static int
+test_cancel(void)
+{
+    wheel_reset();
+
+    wheel_arm(1, 10);
+    wheel_arm(2, 5000);
+    wheel_arm(3, 300000);
+    wheel_arm(4, 70);
+
+    /* Stop a timer on each level, stopping twice is harmless */
+    for (uint16_t i = 1; i <= 4; i++) {
+        tcp_wheel_del(&wheel, &tmrs[i]);
+        tcp_wheel_del(&wheel, &tmrs[i]);
+        ws.expect[i] = 0;
+        if (tcp_wheel_pending(&tmrs[i])) {
+            tst_error("Stopped timer %u is still pending\n", i);
+            return -1;
+        }
+    }
+    if (wheel.count) {
+        tst_error("Wheel holds %u timers after stopping all of them\n", wheel.count);
+        return -1;
+    }
+
+    /* Re-arm a pending timer earlier and later, and move it between levels */
+    wheel_arm(1, 5000);
+    wheel_arm(1, 20);
+    wheel_arm(2, 20);
+    wheel_arm(2, 300000);
+    wheel_arm(3, 64);
+    wheel_arm(3, 63);
+    if (wheel.count != 3) {
+        tst_error("Wheel holds %u timers after re-arming, expected 3\n", wheel.count);
+        return -1;
+    }
+
+    /* Stop a timer after it was cascaded down to level 0 */
+    wheel_arm(4, 4100);
+    if (wheel_run(4096))
+        return -1;
+    tcp_wheel_del(&wheel, &tmrs[4]);
+    ws.expect[4] = 0;
+
+    if (wheel_run(400000) || wheel_check(5))
+        return -1;
+    if (ws.count != 3 || ws.fired[4]) {
+        tst_error("%u timers expired, expected 3\n", ws.count);
+        return -1;
+    }
+
+    /* A timer re-armed from its expire function expires every period */
+    wheel_reset();
+    ws.period = 100;
+    wheel_arm(0, 100);
+    for (int i = 0; i < 50; i++) {
+        uint64_t next = ws.expect[0];
+
+        if (wheel_run(next))
+            return -1;
+        if (ws.last != next || ws.expect[0] != next + ws.period) {
+            tst_error("Periodic timer expired on tick %" PRIu64 ", expected %" PRIu64 "\n",
+                      ws.last, next);
+            return -1;
+        }
+    }
+    tcp_wheel_del(&wheel, &tmrs[0]);
+
+    return 0;
+}
+
+/* The largest timeout is TCP_WHEEL_MAX ticks, zero ticks expire on the next tick */
+static int
+test_max(void)
+{
+    wheel_reset();
+    wheel.now = 77;
+
+    wheel_arm(0, TCP_WHEEL_MAX);
+    wheel_arm(1, TCP_WHEEL_MAX + 1);
+    wheel_arm(2, UINT64_MAX);
+    wheel_arm(3, 0);
+    wheel_arm(4, TCP_WHEEL_MAX - 1);
+
+    if (tmrs[1].expire != wheel.now + TCP_WHEEL_MAX || tmrs[2].expire != tmrs[1].expire) {
+        tst_error("Timeout is not limited to %llu ticks\n", TCP_WHEEL_MAX);
+        return -1;
+    }
+
+    if (wheel_run(wheel.now + TCP_WHEEL_MAX + 1) || wheel_check(5))
+        return -1;
+    if (ws.count != 5) {
+        tst_error("%u timers expired, expected 5\n", ws.count);
+        return -1;
+    }
+
+    return 0;
+}
+
+int
+tcp_wheel_main(int argc __cne_unused, char **argv __cne_unused)
+{
+    // clang-format off
+    struct {
+        const char *name;
+        int (*func)(void);
+    } tsts[] = {
+        {"TCP_WHEEL: cascade", test_cascade},
+        {"TCP_WHEEL: expire order", test_order},
+        {"TCP_WHEEL: cancel and re-arm", test_cancel},
+        {"TCP_WHEEL: largest timeout", test_max},
+    };
+    // clang-format on
+    tst_info_t *tst;
+
+    for (int i = 0; i < (int)CNE_DIM(tsts); i++) {
+        tst = tst_start(tsts[i].name);
+        if (tsts[i].func()) {
+            tst_end(tst, TST_FAILED);
+            return -1;
+        }
+        tst_end(tst, TST_PASSED);
+    }
+
+    return 0;
+}